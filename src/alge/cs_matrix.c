@@ -5544,10 +5544,10 @@ cs_matrix_get_row(const cs_matrix_t     *matrix,
   case CS_MATRIX_MSR:
     {
       const cs_lnum_t _row_id = row_id / b_size;
-      const cs_matrix_struct_csr_t  *ms = matrix->structure;
+      const cs_matrix_struct_dist_t  *ms = matrix->structure;
       const cs_matrix_coeff_dist_t  *mc = matrix->coeffs;
-      const cs_lnum_t n_ed_cols =   ms->row_index[_row_id+1]
-                                  - ms->row_index[_row_id];
+      const cs_lnum_t n_ed_cols =   ms->e.row_index[_row_id+1]
+                                  - ms->e.row_index[_row_id];
       if (matrix->eb_size == 1)
         r->row_size = n_ed_cols + b_size;
       else
@@ -5560,9 +5560,9 @@ cs_matrix_get_row(const cs_matrix_t     *matrix,
         r->vals = r->_vals;
       }
       cs_lnum_t ii = 0, jj = 0;
-      const cs_lnum_t *restrict c_id = ms->col_id + ms->row_index[_row_id];
+      const cs_lnum_t *restrict c_id = ms->e.col_id + ms->e.row_index[_row_id];
       if (b_size == 1) {
-        const cs_real_t *m_row = mc->e_val + ms->row_index[_row_id];
+        const cs_real_t *m_row = mc->e_val + ms->e.row_index[_row_id];
         for (jj = 0; jj < n_ed_cols && c_id[jj] < _row_id; jj++) {
           r->_col_id[ii] = c_id[jj];
           r->_vals[ii++] = m_row[jj];
@@ -5578,7 +5578,7 @@ cs_matrix_get_row(const cs_matrix_t     *matrix,
         const cs_lnum_t _sub_id = row_id % b_size;
         const cs_lnum_t db_size = matrix->db_size;
         const cs_lnum_t db_size_2 = matrix->db_size*matrix->db_size;
-        const cs_real_t *m_row = mc->e_val + ms->row_index[_row_id];
+        const cs_real_t *m_row = mc->e_val + ms->e.row_index[_row_id];
         for (jj = 0; jj < n_ed_cols && c_id[jj] < _row_id; jj++) {
           r->_col_id[ii] = c_id[jj]*b_size + _sub_id;
           r->_vals[ii++] = m_row[jj];
@@ -5599,7 +5599,7 @@ cs_matrix_get_row(const cs_matrix_t     *matrix,
         const cs_lnum_t eb_size = matrix->db_size;
         const cs_lnum_t db_size_2 = matrix->db_size*matrix->db_size;
         const cs_lnum_t eb_size_2 = matrix->eb_size*matrix->eb_size;
-        const cs_real_t *m_row = mc->e_val + ms->row_index[_row_id]*eb_size_2;
+        const cs_real_t *m_row = mc->e_val + ms->e.row_index[_row_id]*eb_size_2;
         for (jj = 0; jj < n_ed_cols && c_id[jj] < _row_id; jj++) {
           for (cs_lnum_t kk = 0; kk < b_size; kk++) {
             r->_col_id[ii] = c_id[jj]*b_size + kk;
@@ -80,6 +80,7 @@
 #include "cs_ibm.h"
 #include "cs_join.h"
 #include "cs_lagr.h"
+#include "cs_lagr_benchmark.h"
 #include "cs_lagr_tracking.h"
 #include "cs_les_inflow.h"
 #include "cs_log.h"
@@ -93,6 +94,7 @@
 #include "cs_mesh_quality.h"
 #include "cs_mesh_quantities.h"
 #include "cs_mesh_bad_cells.h"
+#include "cs_mesh_cache.h"
 #include "cs_mesh_smoother.h"
 #include "cs_notebook.h"
 #include "cs_opts.h"
@@ -252,6 +254,9 @@ _run(void)
   cs_boundary_zone_initialize();
   cs_volume_zone_initialize();
 
+  if (opts.benchmark_lagr)
+    cs_lagr_benchmark_define_mesh(opts.lagr_bm_n_cells);
+
   cs_preprocess_mesh_define();
 
   cs_turbomachinery_define();
@@ -416,7 +421,14 @@ _run(void)
 
   if (opts.benchmark > 0) {
     int mpi_trace_mode = (opts.benchmark == 2) ? 1 : 0;
-    cs_benchmark(mpi_trace_mode);
+    if (opts.benchmark_lagr)
+      cs_lagr_benchmark(mpi_trace_mode,
+                        opts.lagr_bm_n_per_cell,
+                        opts.lagr_bm_cfl,
+                        (opts.lagr_bm_soa) ?
+                          CS_LAGR_PARTICLE_SOA : CS_LAGR_PARTICLE_AOS);
+    else
+      cs_benchmark(mpi_trace_mode);
   }
 
   if (opts.preprocess == false && opts.benchmark <= 0) {
@@ -643,6 +655,7 @@ _run(void)
   cs_mesh_location_finalize();
   cs_mesh_quantities_destroy(cs_glob_mesh_quantities);
   cs_mesh_destroy(cs_glob_mesh);
+  cs_mesh_cache_finalize();
 
   /* Free parameters tree info */
 
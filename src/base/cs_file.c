@@ -179,6 +179,14 @@ BEGIN_C_DECLS
 /* MPI tag for file operations */
 #define CS_FILE_MPI_TAG  (int)('C'+'S'+'_'+'F'+'I'+'L'+'E')
 
+/* Nonblocking MPI-IO reads (MPI_File_iread_at_all requires MPI 3.1) */
+
+#if defined(HAVE_MPI_IO)
+#  if (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+#    define _CS_FILE_MPI_IREAD
+#  endif
+#endif
+
 /*============================================================================
  * Type definitions
  *============================================================================*/
@@ -217,6 +225,23 @@ struct _cs_file_t {
 
 };
 
+/* Pending block read request */
+
+struct _cs_file_read_request_t {
+
+  cs_file_t         *f;            /* Associated file */
+  void              *buf;          /* Receiving buffer */
+  size_t             size;         /* Size of each item of data in bytes */
+  size_t             n_read;       /* Number of items read */
+
+#if defined(HAVE_MPI_IO)
+  MPI_Request        request;      /* Associated MPI request
+                                      (MPI_REQUEST_NULL if complete) */
+  MPI_Datatype       ent_type;     /* Associated MPI datatype */
+#endif
+
+};
+
 /* Associated typedef documentation (for cs_file.h) */
 
 /*!
@@ -224,6 +249,11 @@ struct _cs_file_t {
  * \brief Pointer to opaque file descriptor
  */
 
+/*!
+ * \typedef cs_file_read_request_t
+ * \brief Pointer to opaque pending block read request
+ */
+
 #if defined(HAVE_MPI)
 
 /* Helper structure for IO serialization */
@@ -3098,6 +3128,187 @@ cs_file_read_block(cs_file_t  *f,
   return retval;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Start reading data to a buffer, distributing a contiguous part of
+ * it to each process associated with a file.
+ *
+ * This function behaves as \ref cs_file_read_block, except that when
+ * supported by the access method (MPI-IO using explicit offsets without
+ * rank stepping), the read is nonblocking, so that it may overlap other
+ * operations. With collective access, this function is collective, and
+ * uses a nonblocking collective read on the file's handle. The file
+ * position is updated immediately, so other sections of the file may be
+ * read before the request is completed. Otherwise, the data is read
+ * before returning.
+ *
+ * In any case, the contents of the buffer are undefined until the request
+ * is completed by \ref cs_file_read_block_wait, which must be called
+ * before the file is closed.
+ *
+ * \param[in]  f                 cs_file_t descriptor
+ * \param[out] buf               pointer to location receiving data
+ * \param[in]  size              size of each item of data in bytes
+ * \param[in]  stride            number of (interlaced) values per block item
+ * \param[in]  global_num_start  global number of first block item
+ *                               (1 to n numbering)
+ * \param[in]  global_num_end    global number of past-the end block item
+ *                               (1 to n numbering)
+ *
+ * \return pointer to associated read request
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_file_read_request_t *
+cs_file_read_block_start(cs_file_t  *f,
+                         void       *buf,
+                         size_t      size,
+                         size_t      stride,
+                         cs_gnum_t   global_num_start,
+                         cs_gnum_t   global_num_end)
+{
+  cs_file_read_request_t *r = NULL;
+  BFT_MALLOC(r, 1, cs_file_read_request_t);
+
+  r->f = f;
+  r->buf = buf;
+  r->size = size;
+  r->n_read = 0;
+
+#if defined(HAVE_MPI_IO)
+  r->request = MPI_REQUEST_NULL;
+  r->ent_type = MPI_BYTE;
+#endif
+
+  bool nonblocking = false;
+
+#if defined(_CS_FILE_MPI_IREAD)
+  if (   f->rank_step <= 1
+      && _mpi_io_positioning == CS_FILE_MPI_EXPLICIT_OFFSETS
+      && (   f->method == CS_FILE_MPI_INDEPENDENT
+          || f->method == CS_FILE_MPI_NON_COLLECTIVE
+          || f->method == CS_FILE_MPI_COLLECTIVE))
+    nonblocking = true;
+#endif
+
+  if (nonblocking == false) {
+    r->n_read = cs_file_read_block(f,
+                                   buf,
+                                   size,
+                                   stride,
+                                   global_num_start,
+                                   global_num_end);
+    return r;
+  }
+
+#if defined(_CS_FILE_MPI_IREAD)
+
+  assert(global_num_end >= global_num_start);
+
+  cs_gnum_t global_num_end_last = global_num_end;
+
+  cs_gnum_t _global_num_start = (global_num_start-1)*stride + 1;
+  cs_gnum_t _global_num_end = (global_num_end-1)*stride + 1;
+
+  if (_global_num_end < _global_num_start)
+    _global_num_end = _global_num_start;
+
+  cs_gnum_t gcount = (_global_num_end - _global_num_start)*size;
+  MPI_Offset disp = f->offset + ((_global_num_start - 1) * size);
+  int errcode = MPI_SUCCESS, count = gcount;
+
+  if (gcount > INT_MAX) {
+    MPI_Type_contiguous(size, MPI_BYTE, &(r->ent_type));
+    MPI_Type_commit(&(r->ent_type));
+    count = _global_num_end - _global_num_start;
+  }
+
+  /* With collective access, all ranks of the file's communicator
+     take part in the read, even with an empty block. */
+
+  if (f->method == CS_FILE_MPI_COLLECTIVE)
+    errcode = MPI_File_iread_at_all(f->fh, disp, buf, count, r->ent_type,
+                                    &(r->request));
+
+  else if (gcount > 0) {
+    errcode = _mpi_file_ensure_isopen(f);
+    if (errcode == MPI_SUCCESS)
+      errcode = MPI_File_iread_at(f->fh, disp, buf, count, r->ent_type,
+                                  &(r->request));
+  }
+
+  if (errcode != MPI_SUCCESS)
+    _mpi_io_error_message(f->name, errcode);
+
+  /* Update offset */
+
+  assert(f->rank > 0 || global_num_start == 1);
+
+  if (f->n_ranks > 1)
+    MPI_Bcast(&global_num_end_last, 1, CS_MPI_GNUM, f->n_ranks-1, f->comm);
+
+  f->offset += ((global_num_end_last - 1) * size * stride);
+
+#endif /* defined(_CS_FILE_MPI_IREAD) */
+
+  return r;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Complete a block read started by \ref cs_file_read_block_start.
+ *
+ * \param[in, out]  request  pointer to associated read request pointer;
+ *                           the request is freed, and set to NULL.
+ *
+ * \return the (local) number of items (not bytes) sucessfully read;
+ *         currently, errors are fatal.
+ */
+/*----------------------------------------------------------------------------*/
+
+size_t
+cs_file_read_block_wait(cs_file_read_request_t  **request)
+{
+  cs_file_read_request_t *r = *request;
+
+  if (r == NULL)
+    return 0;
+
+#if defined(HAVE_MPI_IO)
+
+  if (r->request != MPI_REQUEST_NULL) {
+
+    MPI_Status status;
+    int count = 0;
+
+    int errcode = MPI_Wait(&(r->request), &status);
+    if (errcode != MPI_SUCCESS)
+      _mpi_io_error_message(r->f->name, errcode);
+
+    MPI_Get_count(&status, r->ent_type, &count);
+
+    if (r->ent_type != MPI_BYTE)
+      r->n_read = count;
+    else
+      r->n_read = count / r->size;
+
+    if (r->f->swap_endian == true && r->size > 1)
+      _swap_endian(r->buf, r->buf, r->size, r->n_read);
+
+  }
+
+  if (r->ent_type != MPI_BYTE)
+    MPI_Type_free(&(r->ent_type));
+
+#endif /* defined(HAVE_MPI_IO) */
+
+  size_t retval = r->n_read;
+
+  BFT_FREE(*request);
+
+  return retval;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Write data to a file, each associated process providing a
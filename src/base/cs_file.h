@@ -53,6 +53,10 @@ BEGIN_C_DECLS
 
 typedef struct _cs_file_t  cs_file_t;
 
+/* Pending block read request */
+
+typedef struct _cs_file_read_request_t  cs_file_read_request_t;
+
 /* Helper structure for IO serialization */
 
 #if defined(HAVE_MPI)
@@ -347,6 +351,59 @@ cs_file_read_block(cs_file_t  *f,
                    cs_gnum_t   global_num_start,
                    cs_gnum_t   global_num_end);
 
+/*----------------------------------------------------------------------------
+ * Start reading data to a buffer, distributing a contiguous part of it to
+ * each process associated with a file.
+ *
+ * This function behaves as cs_file_read_block(), except that when
+ * supported by the access method (MPI-IO using explicit offsets without
+ * rank stepping), the read is nonblocking, so that it may overlap other
+ * operations. With collective access, this function is collective, and
+ * uses a nonblocking collective read on the file's handle. The file
+ * position is updated immediately, so other sections of the file may be
+ * read before the request is completed. Otherwise, the data is read
+ * before returning.
+ *
+ * In any case, the contents of the buffer are undefined until the request
+ * is completed by cs_file_read_block_wait(), which must be called before
+ * the file is closed.
+ *
+ * parameters:
+ *   f                <-- cs_file_t descriptor
+ *   buf              --> pointer to location receiving data
+ *   size             <-- size of each item of data in bytes
+ *   stride           <-- number of (interlaced) values per block item
+ *   global_num_start <-- global number of first block item (1 to n numbering)
+ *   global_num_end   <-- global number of past-the end block item
+ *                        (1 to n numbering)
+ *
+ * returns:
+ *   pointer to associated read request
+ *----------------------------------------------------------------------------*/
+
+cs_file_read_request_t *
+cs_file_read_block_start(cs_file_t  *f,
+                         void       *buf,
+                         size_t      size,
+                         size_t      stride,
+                         cs_gnum_t   global_num_start,
+                         cs_gnum_t   global_num_end);
+
+/*----------------------------------------------------------------------------
+ * Complete a block read started by cs_file_read_block_start().
+ *
+ * parameters:
+ *   request <-> pointer to associated read request pointer; the request
+ *               is freed, and set to NULL.
+ *
+ * returns:
+ *   the (local) number of items (not bytes) sucessfully read; currently,
+ *   errors are fatal.
+ *----------------------------------------------------------------------------*/
+
+size_t
+cs_file_read_block_wait(cs_file_read_request_t  **request);
+
 /*----------------------------------------------------------------------------
  * Write data to a file, each associated process providing a contiguous part
  * of this data.
@@ -759,6 +759,91 @@ cs_halo_create_from_ref(const cs_halo_t  *ref)
   return halo;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create a halo structure from existing send and receive lists.
+ *
+ * This is mainly used to restore a previously built halo (such as one
+ * read from a cached mesh image), so the associated element numbering
+ * must be unchanged. Periodicity is not handled.
+ *
+ * \param[in]  n_c_domains    number of communicating domains
+ * \param[in]  c_domain_rank  list of communicating ranks (size: n_c_domains)
+ * \param[in]  n_local_elts   number of local elements
+ * \param[in]  send_index     index on send list (size: 2*n_c_domains + 1)
+ * \param[in]  send_list      list of local elements in distant halos
+ *                            (size: send_index[2*n_c_domains])
+ * \param[in]  index          index on halo sections
+ *                            (size: 2*n_c_domains + 1)
+ *
+ * \return  pointer to created cs_halo_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_halo_t *
+cs_halo_create_from_lists(int              n_c_domains,
+                          const int        c_domain_rank[],
+                          cs_lnum_t        n_local_elts,
+                          const cs_lnum_t  send_index[],
+                          const cs_lnum_t  send_list[],
+                          const cs_lnum_t  index[])
+{
+  cs_halo_t  *halo = NULL;
+
+  BFT_MALLOC(halo, 1, cs_halo_t);
+
+  halo->n_c_domains = n_c_domains;
+  halo->n_transforms = 0;
+
+  halo->periodicity = NULL;
+  halo->n_rotations = 0;
+
+  halo->n_local_elts = n_local_elts;
+
+  BFT_MALLOC(halo->c_domain_rank, n_c_domains, int);
+  memcpy(halo->c_domain_rank, c_domain_rank, n_c_domains*sizeof(int));
+
+  const cs_lnum_t n_send = send_index[2*n_c_domains];
+
+  CS_MALLOC_HD(halo->send_index, 2*n_c_domains + 1, cs_lnum_t,
+               _halo_buffer_alloc_mode);
+  CS_MALLOC_HD(halo->send_list, n_send, cs_lnum_t,
+               _halo_buffer_alloc_mode);
+  BFT_MALLOC(halo->index, 2*n_c_domains + 1, cs_lnum_t);
+
+  memcpy(halo->send_index, send_index, (2*n_c_domains + 1)*sizeof(cs_lnum_t));
+  memcpy(halo->send_list, send_list, n_send*sizeof(cs_lnum_t));
+  memcpy(halo->index, index, (2*n_c_domains + 1)*sizeof(cs_lnum_t));
+
+  halo->send_perio_lst = NULL;
+  halo->perio_lst = NULL;
+
+  /* Element counts for standard and extended halos */
+
+  for (int i = 0; i < CS_HALO_N_TYPES; i++) {
+    halo->n_send_elts[i] = 0;
+    halo->n_elts[i] = 0;
+  }
+
+  for (int i = 0; i < n_c_domains; i++) {
+    halo->n_send_elts[CS_HALO_STANDARD] += send_index[2*i+1] - send_index[2*i];
+    halo->n_elts[CS_HALO_STANDARD] += index[2*i+1] - index[2*i];
+  }
+  halo->n_send_elts[CS_HALO_EXTENDED] = n_send;
+  halo->n_elts[CS_HALO_EXTENDED] = index[2*n_c_domains];
+
+#if defined(HAVE_MPI)
+  halo->c_domain_group = MPI_GROUP_NULL;
+  halo->c_domain_s_shift = NULL;
+#endif
+
+  _n_halos += 1;
+
+  cs_halo_create_complete(halo);
+
+  return halo;
+}
+
 #if defined(HAVE_MPI)
 
 /*----------------------------------------------------------------------------*/
@@ -226,6 +226,35 @@ cs_halo_create_complete(cs_halo_t  *halo);
 cs_halo_t *
 cs_halo_create_from_ref(const cs_halo_t  *ref);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create a halo structure from existing send and receive lists.
+ *
+ * This is mainly used to restore a previously built halo (such as one
+ * read from a cached mesh image), so the associated element numbering
+ * must be unchanged. Periodicity is not handled.
+ *
+ * \param[in]  n_c_domains    number of communicating domains
+ * \param[in]  c_domain_rank  list of communicating ranks (size: n_c_domains)
+ * \param[in]  n_local_elts   number of local elements
+ * \param[in]  send_index     index on send list (size: 2*n_c_domains + 1)
+ * \param[in]  send_list      list of local elements in distant halos
+ *                            (size: send_index[2*n_c_domains])
+ * \param[in]  index          index on halo sections
+ *                            (size: 2*n_c_domains + 1)
+ *
+ * \return  pointer to created cs_halo_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_halo_t *
+cs_halo_create_from_lists(int              n_c_domains,
+                          const int        c_domain_rank[],
+                          cs_lnum_t        n_local_elts,
+                          const cs_lnum_t  send_index[],
+                          const cs_lnum_t  send_list[],
+                          const cs_lnum_t  index[]);
+
 #if defined(HAVE_MPI)
 
 /*----------------------------------------------------------------------------*/
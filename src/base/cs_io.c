@@ -2588,6 +2588,96 @@ cs_io_read_block(const cs_io_sec_header_t  *header,
                           cs_io);
 }
 
+/*----------------------------------------------------------------------------
+ * Start reading a section body, assigning a different block to each
+ * processor.
+ *
+ * This function behaves as cs_io_read_block(), except that the read may be
+ * nonblocking (see cs_file_read_block_start()), in which case the
+ * associated request is returned, and the data must not be accessed
+ * before the request is completed using cs_file_read_block_wait().
+ * Following sections may be read in the meantime, but the kernel IO
+ * structure must not be finalized before completion.
+ *
+ * Data requiring type conversion, embedded in the header, or echoed is
+ * read immediately, and NULL is returned.
+ *
+ * parameters:
+ *   header           <-- header structure
+ *   global_num_start <-- global number of first block item (1 to n numbering)
+ *   global_num_end   <-- global number of past-the end block item
+ *                        (1 to n numbering)
+ *   elts             <-> pointer to data array (allocated)
+ *   cs_io            --> kernel IO structure
+ *
+ * returns:
+ *   pointer to pending read request, or NULL if data was already read
+ *----------------------------------------------------------------------------*/
+
+cs_file_read_request_t *
+cs_io_read_block_start(const cs_io_sec_header_t  *header,
+                       cs_gnum_t                  global_num_start,
+                       cs_gnum_t                  global_num_end,
+                       void                      *elts,
+                       cs_io_t                   *cs_io)
+{
+  assert(global_num_start > 0);
+  assert(global_num_end >= global_num_start);
+
+  /* The choice of a blocking read must be the same on all ranks, as it
+     may be collective; empty blocks (elts may then be NULL) are handled
+     by the nonblocking variant. */
+
+  if (   cs_io->data != NULL
+      || (elts == NULL && global_num_end > global_num_start)
+      || header->elt_type != header->type_read
+      || (header->n_vals != 0 && cs_io->echo > CS_IO_ECHO_HEADERS)) {
+    _cs_io_read_body(header,
+                     global_num_start,
+                     global_num_end,
+                     elts,
+                     cs_io);
+    return NULL;
+  }
+
+  double t_start = 0.;
+  cs_io_log_t  *log = NULL;
+  size_t stride = 1;
+
+  if (cs_io->log_id > -1) {
+    log = _cs_io_log[cs_io->mode] + cs_io->log_id;
+    t_start = cs_timer_wtime();
+  }
+
+  if (header->n_location_vals > 1)
+    stride = header->n_location_vals;
+
+  size_t type_size = cs_datatype_size[header->type_read];
+
+  /* Position read pointer if necessary */
+
+  if (cs_io->body_align > 0) {
+    cs_file_off_t offset = cs_file_tell(cs_io->f);
+    size_t ba = cs_io->body_align;
+    offset += (ba - (offset % ba)) % ba;
+    cs_file_seek(cs_io->f, offset, CS_FILE_SEEK_SET);
+  }
+
+  cs_file_read_request_t *r = cs_file_read_block_start(cs_io->f,
+                                                       elts,
+                                                       type_size,
+                                                       stride,
+                                                       global_num_start,
+                                                       global_num_end);
+
+  if (log != NULL) {
+    log->data_size[1] += (global_num_end - global_num_start)*type_size;
+    log->wtimes[1] += cs_timer_wtime() - t_start;
+  }
+
+  return r;
+}
+
 /*----------------------------------------------------------------------------
  * Read a section body, assigning a different block to each processor,
  * when the body corresponds to an index.
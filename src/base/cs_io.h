@@ -404,6 +404,39 @@ cs_io_read_block(const cs_io_sec_header_t  *header,
                  void                      *elts,
                  cs_io_t                   *pp_io);
 
+/*----------------------------------------------------------------------------
+ * Start reading a section body, assigning a different block to each
+ * processor.
+ *
+ * This function behaves as cs_io_read_block(), except that the read may be
+ * nonblocking (see cs_file_read_block_start()), in which case the
+ * associated request is returned, and the data must not be accessed
+ * before the request is completed using cs_file_read_block_wait().
+ * Following sections may be read in the meantime, but the kernel IO
+ * structure must not be finalized before completion.
+ *
+ * Data requiring type conversion, embedded in the header, or echoed is
+ * read immediately, and NULL is returned.
+ *
+ * parameters:
+ *   header           <-- header structure
+ *   global_num_start <-- global number of first block item (1 to n numbering)
+ *   global_num_end   <-- global number of past-the end block item
+ *                        (1 to n numbering)
+ *   elts             <-> pointer to data array (allocated)
+ *   pp_io            --> kernel IO structure
+ *
+ * returns:
+ *   pointer to pending read request, or NULL if data was already read
+ *----------------------------------------------------------------------------*/
+
+cs_file_read_request_t *
+cs_io_read_block_start(const cs_io_sec_header_t  *header,
+                       cs_gnum_t                  global_num_start,
+                       cs_gnum_t                  global_num_end,
+                       void                      *elts,
+                       cs_io_t                   *pp_io);
+
 /*----------------------------------------------------------------------------
  * Read a message body, assigning a different block to each processor,
  * when the body corresponds to an index.
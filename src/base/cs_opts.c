@@ -118,6 +118,20 @@ _arg_env_help(const char  *name)
     (e, _(" --benchmark       elementary operations performance\n"
           "                   [--mpitrace] operations done only once\n"
           "                                for light MPI traces\n"));
+  fprintf
+    (e, _(" --benchmark-lagr  Lagrangian particle stages performance\n"
+          "                   [--mpitrace] operations done only once\n"
+          "                                for light MPI traces\n"
+          "                   [--mesh-cells <n>] cells in each direction\n"
+          "                                of default mesh (default: 32)\n"
+          "                   [--particles-per-cell <n>] mean number of\n"
+          "                                particles per cell (default: 8)\n"
+          "                   [--cfl <x>]  mean particle displacement per\n"
+          "                                time step relative to mean\n"
+          "                                cell size (default: 0.5)\n"
+          "                   [--layout <aos|soa>] particle data layout\n"
+          "                                for integration and statistics\n"
+          "                                (default: aos)\n"));
   fprintf
     (e, _(" -h, --help        this help message\n\n"));
 
@@ -206,6 +220,11 @@ cs_opts_define(int         argc,
   opts->preprocess = false;
   opts->verif = false;
   opts->benchmark = 0;
+  opts->benchmark_lagr = false;
+  opts->lagr_bm_n_cells = 32;
+  opts->lagr_bm_n_per_cell = 8;
+  opts->lagr_bm_cfl = 0.5;
+  opts->lagr_bm_soa = false;
 
   /* Parse command line arguments */
 
@@ -221,14 +240,49 @@ cs_opts_define(int         argc,
       }
     }
 
-    else if (strcmp(s, "--benchmark") == 0) {
+    else if (   strcmp(s, "--benchmark") == 0
+             || strcmp(s, "--benchmark-lagr") == 0) {
       opts->benchmark = 1;
+      if (strcmp(s, "--benchmark-lagr") == 0)
+        opts->benchmark_lagr = true;
       if (arg_id + 1 < argc) {
         if (strcmp(argv[arg_id + 1], "--mpitrace") == 0) {
           opts->benchmark = 2;
           arg_id++;
         }
       }
+      /* Lagrangian benchmark settings (option and value pairs) */
+      while (   opts->benchmark_lagr && argerr == 0
+             && arg_id + 2 < argc) {
+        const char *s_opt = argv[arg_id + 1];
+        const char *s_val = argv[arg_id + 2];
+        if (strcmp(s_opt, "--mesh-cells") == 0) {
+          opts->lagr_bm_n_cells = atoi(s_val);
+          if (opts->lagr_bm_n_cells < 1)
+            argerr = 1;
+        }
+        else if (strcmp(s_opt, "--particles-per-cell") == 0) {
+          opts->lagr_bm_n_per_cell = atoi(s_val);
+          if (opts->lagr_bm_n_per_cell < 1)
+            argerr = 1;
+        }
+        else if (strcmp(s_opt, "--cfl") == 0) {
+          opts->lagr_bm_cfl = atof(s_val);
+          if (opts->lagr_bm_cfl <= 0.)
+            argerr = 1;
+        }
+        else if (strcmp(s_opt, "--layout") == 0) {
+          if (strcmp(s_val, "aos") == 0)
+            opts->lagr_bm_soa = false;
+          else if (strcmp(s_val, "soa") == 0)
+            opts->lagr_bm_soa = true;
+          else
+            argerr = 1;
+        }
+        else
+          break;
+        arg_id += 2;
+      }
     }
 
 #if defined(HAVE_UNISTD_H)
@@ -72,6 +72,15 @@ typedef struct {
                                    0: not used;
                                    1: timing (CPU + Walltime) mode
                                    2: MPI trace-friendly mode */
+  bool           benchmark_lagr; /* Benchmark Lagrangian particle stages
+                                    instead of elementary operations */
+  int            lagr_bm_n_cells;      /* Lagrangian benchmark cells in each
+                                          direction of the default mesh */
+  int            lagr_bm_n_per_cell;   /* Lagrangian benchmark mean number
+                                          of particles per cell */
+  double         lagr_bm_cfl;          /* Lagrangian benchmark particle CFL */
+  bool           lagr_bm_soa;          /* Lagrangian benchmark integration and
+                                          statistics with SoA layout */
 
 } cs_opts_t;
 
@@ -189,7 +189,8 @@ cs_param_schur_approx_name[CS_PARAM_N_SCHUR_APPROX][CS_BASE_STRING_LEN] =
     N_("Lumped inverse"),
     N_("Scaled mass matrix"),
     N_("Based on the diagonal + mass scaling"),
-    N_("Lumped inverse + mass scaling") };
+    N_("Lumped inverse + mass scaling"),
+    N_("Sparse approximate inverse") };
 
 static const char
 cs_param_dotprod_name[CS_PARAM_N_DOTPROD_TYPES][CS_BASE_STRING_LEN] =
@@ -742,6 +743,7 @@ cs_param_get_schur_approx_name(cs_param_schur_approx_t   type)
   case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
   case CS_PARAM_SCHUR_LUMPED_INVERSE:
   case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+  case CS_PARAM_SCHUR_SPAI_INVERSE:
     return cs_param_schur_approx_name[type];
 
   default:
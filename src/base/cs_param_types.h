@@ -747,6 +747,17 @@ typedef enum {
  *  where \f$ M_{22} \f$ is the mass matrix related to the (2,2) block and where
  *  \f$x=lumped(A^{-1})\f$ results from \f$A.x = \bf{1}\f$ (\f$\bf{1}\f$
  *  is the array fills with 1 in each entry)
+ *
+ *  \var CS_PARAM_SCHUR_SPAI_INVERSE
+ *  The Schur complement approximation is defined as
+ * \f[ S \approx -B \cdot spai(A) \cdot B^t \f]
+ *  where \f$spai(A)\f$ is the sparse approximate inverse of \f$A\f$ with
+ *  the sparsity pattern of \f$A\f$ minimizing
+ *  \f$\|I - spai(A) \cdot A\|_F\f$ (one small least-squares problem per
+ *  row). The approximation keeps the sparsity pattern of the other Schur
+ *  approximations: couplings between cells which are not face neighbours are
+ *  discarded. In parallel, \f$spai(A)\f$ is restricted to the DoFs owned by
+ *  each rank.
  */
 
 typedef enum {
@@ -759,6 +770,7 @@ typedef enum {
   CS_PARAM_SCHUR_MASS_SCALED,
   CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE,
   CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE,
+  CS_PARAM_SCHUR_SPAI_INVERSE,
 
   CS_PARAM_N_SCHUR_APPROX
 
@@ -412,6 +412,8 @@ static cs_equation_param_t _equation_param_default
    .space_scheme = CS_SPACE_SCHEME_LEGACY,
    .dof_reduction = CS_PARAM_REDUCTION_AVERAGE,
    .space_poly_degree = 0,
+   .cache_cw_operators = false,
+   .matrix_free = false,
 
    .iconv  = 1,
    .istat  = 1,
@@ -238,6 +238,9 @@ typedef void
  * - \c \b MEDCoupling (in-memory structure, to be used from other code)
  * - \c \b plot (comma or whitespace separated 2d plot files)
  * - \c \b time_plot (comma or whitespace separated time plot files)
+ * - \c \b reduced (lossy, error-bounded compressed field values, without
+ *      mesh; see \c \b abs_error=, \c \b rel_error= and \c \b sample_step=
+ *      options)
  *
  * The format name is case-sensitive, so \c \b ensight or \c \b cgns are also valid.
  *
@@ -266,6 +269,9 @@ typedef void
  *         pyramids), so that any post-processing tool can recognize them.
  * - \c \b separate_meshes to multiple meshes and associated fields to
  *         separate outputs.
+ * - \c \b rank_files to have each rank write its own case, referenced by
+ *         a master (server of servers) file, avoiding data redistribution
+ *         (for \c \b EnSight).
  *
  * Note that the white-spaces in the beginning or in the end of the
  * character strings given as arguments here are suppressed automatically.
@@ -54,6 +54,7 @@
 #include "cs_log.h"
 #include "cs_map.h"
 #include "cs_mesh.h"
+#include "cs_mesh_cache.h"
 #include "cs_mesh_cartesian.h"
 #include "cs_mesh_from_builder.h"
 #include "cs_mesh_location.h"
@@ -259,103 +260,145 @@ cs_preprocess_mesh(cs_halo_type_t   halo_type)
     cs_user_partition();
   }
 
-  /* Read Preprocessor output */
+  /* Read mesh cached by a previous run with the same mesh input,
+     preprocessing settings and number of ranks if available,
+     or read Preprocessor output */
 
-  cs_preprocessor_data_read_mesh(m,
-                                 cs_glob_mesh_builder,
-                                 false);
+  uint64_t mesh_checksum = 0;
+  bool mesh_from_cache = false;
 
-  if (allow_modify) {
+  if (cs_mesh_cache_get_path() != NULL && m->n_init_perio == 0) {
+    mesh_checksum = cs_preprocessor_data_checksum();
+    mesh_from_cache = cs_mesh_cache_load(m, halo_type, mesh_checksum);
+  }
 
-    /* Join meshes / build periodicity links if necessary */
+  if (mesh_from_cache) {
+
+    cs_preprocessor_data_discard_input();
+
+    /* The cached mesh already includes the effects of these steps,
+       but not their side effects (such as postprocessing of free faces) */
+
+    cs_log_printf(CS_LOG_DEFAULT,
+                  _("\n Mesh read from cache in \"%s\";\n"
+                    " bypassed preprocessing steps:\n"
+                    "   reading of mesh input\n"),
+                  cs_mesh_cache_get_path());
+    if (allow_modify)
+      cs_log_printf(CS_LOG_DEFAULT,
+                    _("   joining and periodicity\n"
+                      "   boundary insertion and internal coupling\n"
+                      "   extrusion and user mesh modification\n"
+                      "   free faces postprocessing and removal\n"
+                      "   smoothing and warped faces cutting\n"
+                      "   save of modified mesh\n"));
+    cs_log_printf(CS_LOG_DEFAULT,
+                  _("   partitioning\n"
+                    "   renumbering\n"));
 
-    cs_join_all(true);
+  }
 
-    /* Insert boundaries if necessary */
+  else {
 
-    cs_gui_mesh_boundary(m);
-    cs_user_mesh_boundary(m);
+    /* Read Preprocessor output */
 
-    cs_internal_coupling_preprocess(m);
+    cs_preprocessor_data_read_mesh(m,
+                                   cs_glob_mesh_builder,
+                                   false);
 
-  }
+    if (allow_modify) {
 
-  /* Initialize extended connectivity, ghost cells and other remaining
-     parallelism-related structures */
+      /* Join meshes / build periodicity links if necessary */
 
-  cs_mesh_init_halo(m, cs_glob_mesh_builder, halo_type, m->verbosity, true);
-  cs_mesh_update_auxiliary(m);
+      cs_join_all(true);
 
-  if (allow_modify) {
+      /* Insert boundaries if necessary */
 
-    /* Possible geometry modification */
+      cs_gui_mesh_boundary(m);
+      cs_user_mesh_boundary(m);
 
-    cs_gui_mesh_extrude(m);
-    cs_user_mesh_modify(m);
+      cs_internal_coupling_preprocess(m);
 
-    /* Discard isolated faces if present */
+    }
+
+    /* Initialize extended connectivity, ghost cells and other remaining
+       parallelism-related structures */
 
-    cs_post_add_free_faces();
-    cs_mesh_discard_free_faces(m);
+    cs_mesh_init_halo(m, cs_glob_mesh_builder, halo_type, m->verbosity, true);
+    cs_mesh_update_auxiliary(m);
 
-    /* Smoothe mesh if required */
+    if (allow_modify) {
 
-    cs_gui_mesh_smoothe(m);
-    cs_user_mesh_smoothe(m);
+      /* Possible geometry modification */
 
-    /* Triangulate warped faces if necessary */
+      cs_gui_mesh_extrude(m);
+      cs_user_mesh_modify(m);
 
-    {
-      double  cwf_threshold = -1.0;
-      int  cwf_post = 0;
+      /* Discard isolated faces if present */
 
-      cs_mesh_warping_get_defaults(&cwf_threshold, &cwf_post);
+      cs_post_add_free_faces();
+      cs_mesh_discard_free_faces(m);
 
-      if (cwf_threshold >= 0.0) {
+      /* Smoothe mesh if required */
 
-        t1 = cs_timer_wtime();
-        cs_mesh_warping_cut_faces(m, cwf_threshold, cwf_post);
-        t2 = cs_timer_wtime();
+      cs_gui_mesh_smoothe(m);
+      cs_user_mesh_smoothe(m);
 
-        bft_printf(_("\n Cutting warped boundary faces (%.3g s)\n"), t2-t1);
+      /* Triangulate warped faces if necessary */
 
+      {
+        double  cwf_threshold = -1.0;
+        int  cwf_post = 0;
+
+        cs_mesh_warping_get_defaults(&cwf_threshold, &cwf_post);
+
+        if (cwf_threshold >= 0.0) {
+
+          t1 = cs_timer_wtime();
+          cs_mesh_warping_cut_faces(m, cwf_threshold, cwf_post);
+          t2 = cs_timer_wtime();
+
+          bft_printf(_("\n Cutting warped boundary faces (%.3g s)\n"), t2-t1);
+
+        }
       }
-    }
 
-    /* Now that mesh modification is finished, save mesh if modified */
+      /* Now that mesh modification is finished, save mesh if modified */
 
-    cs_gui_mesh_save_if_modified(m);
-    cs_user_mesh_save(m); /* Disable or force */
-  }
+      cs_gui_mesh_save_if_modified(m);
+      cs_user_mesh_save(m); /* Disable or force */
+    }
+
+    bool need_partition = cs_partition_get_preprocess();
+    if (m->modified & CS_MESH_MODIFIED_BALANCE)
+      need_partition = true;
 
-  bool need_partition = cs_partition_get_preprocess();
-  if (m->modified & CS_MESH_MODIFIED_BALANCE)
-    need_partition = true;
+    bool need_save = false;
+    if (   (m->modified > 0 && m->save_if_modified > 0)
+        || m->save_if_modified > 1)
+      need_save = true;
 
-  bool need_save = false;
-  if (   (m->modified > 0 && m->save_if_modified > 0)
-      || m->save_if_modified > 1)
-    need_save = true;
+    if (need_partition) {
+      if (need_save) {
+        cs_mesh_save(m, cs_glob_mesh_builder, NULL, "mesh_output.csm");
+        need_save = false;
+      }
+      else
+        cs_mesh_to_builder(m, cs_glob_mesh_builder, true, NULL);
 
-  if (need_partition) {
-    if (need_save) {
-      cs_mesh_save(m, cs_glob_mesh_builder, NULL, "mesh_output.csm");
-      need_save = false;
+      cs_partition(m, cs_glob_mesh_builder, CS_PARTITION_MAIN);
+      cs_mesh_from_builder(m, cs_glob_mesh_builder);
+      cs_mesh_init_halo(m, cs_glob_mesh_builder, halo_type, m->verbosity, true);
+      cs_mesh_update_auxiliary(m);
     }
-    else
-      cs_mesh_to_builder(m, cs_glob_mesh_builder, true, NULL);
 
-    cs_partition(m, cs_glob_mesh_builder, CS_PARTITION_MAIN);
-    cs_mesh_from_builder(m, cs_glob_mesh_builder);
-    cs_mesh_init_halo(m, cs_glob_mesh_builder, halo_type, m->verbosity, true);
-    cs_mesh_update_auxiliary(m);
-  }
+    else if (need_save)
+      cs_mesh_save(m, NULL, NULL, "mesh_output.csm");
 
-  else if (need_save)
-    cs_mesh_save(m, NULL, NULL, "mesh_output.csm");
+    m->n_b_faces_all = m->n_b_faces;
+    m->n_g_b_faces_all = m->n_g_b_faces;
 
-  m->n_b_faces_all = m->n_b_faces;
-  m->n_g_b_faces_all = m->n_g_b_faces;
+  }
 
   /* Destroy the temporary structure used to build the main mesh */
 
@@ -364,11 +407,20 @@ cs_preprocess_mesh(cs_halo_type_t   halo_type)
   /* Destroy cartesian mesh builder if necessary */
   cs_mesh_cartesian_params_destroy();
 
-  /* Renumber mesh based on code options */
+  /* Renumber mesh based on code options (user numbering options
+     are also set for a cached mesh, as they may be used later) */
 
   cs_user_numbering();
 
-  cs_renumber_mesh(m);
+  if (! mesh_from_cache) {
+
+    cs_renumber_mesh(m);
+
+    /* Save partitioned mesh for future runs if required */
+
+    cs_mesh_cache_save(m, mesh_checksum);
+
+  }
 
   /* Initialize group classes */
 
@@ -37,6 +37,11 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(HAVE_SYS_TYPES_H) && defined(HAVE_SYS_STAT_H)
+# include <sys/stat.h>
+# include <sys/types.h>
+#endif
+
 #if defined(HAVE_MPI)
 #include <mpi.h>
 #endif
@@ -99,6 +104,25 @@ typedef struct {
 
 } _mesh_file_info_t;
 
+/* Pending (nonblocking) section read */
+/* ----------------------------------- */
+
+typedef struct {
+
+  int                      file_id;     /* Associated file id */
+  void                    *data;        /* Associated mesh builder array */
+  cs_lnum_t                val_offset;  /* Offset of values read in array */
+  cs_lnum_t                n_vals;      /* Number of values read */
+
+  cs_gnum_t                num_shift;   /* Global number shift for appended
+                                           data (connectivity) */
+  const double            *matrix;      /* Coordinate transformation matrix
+                                           (coordinates), or NULL */
+
+  cs_file_read_request_t  *request;     /* Associated read request */
+
+} _pending_read_t;
+
 /* Structure used for building mesh structure */
 /* ------------------------------------------ */
 
@@ -124,6 +148,16 @@ typedef struct {
   cs_gnum_t    n_g_faces_connect_read;
   cs_gnum_t    n_g_vertices_read;
 
+  /* Pending reads, whose completion is deferred so as to overlap
+     partitioning and redistribution of other sections */
+
+  bool              defer_reads;   /* Allow deferred completion ? */
+  int               n_pending;     /* Number of pending reads */
+  _pending_read_t  *pending;       /* Pending reads */
+  cs_io_t         **pending_io;    /* Inputs kept open for pending reads,
+                                      until the reader is destroyed
+                                      (size: n_files) */
+
 } _mesh_reader_t;
 
 /*============================================================================
@@ -350,6 +384,13 @@ _mesh_reader_create(int                 *n_mesh_files,
   mr->n_g_faces_read = 0;
   mr->n_g_faces_connect_read = 0;
 
+  mr->defer_reads = false;
+  mr->n_pending = 0;
+  mr->pending = NULL;
+  BFT_MALLOC(mr->pending_io, mr->n_files, cs_io_t *);
+  for (i = 0; i < mr->n_files; i++)
+    mr->pending_io[i] = NULL;
+
   return mr;
 }
 
@@ -369,6 +410,15 @@ _mesh_reader_destroy(_mesh_reader_t  **mr)
   int i;
   _mesh_reader_t *_mr = *mr;
 
+  assert(_mr->n_pending == 0);
+
+  for (i = 0; i < _mr->n_files; i++) {
+    if (_mr->pending_io[i] != NULL)
+      cs_io_finalize(&(_mr->pending_io[i]));
+  }
+  BFT_FREE(_mr->pending_io);
+  BFT_FREE(_mr->pending);
+
   for (i = 0; i < _mr->n_files; i++) {
     _mesh_file_info_t  *f = _mr->file_info + i;
     BFT_FREE(f->data);
@@ -380,6 +430,73 @@ _mesh_reader_destroy(_mesh_reader_t  **mr)
   BFT_FREE(*mr);
 }
 
+/*----------------------------------------------------------------------------
+ * Update a 64-bit FNV-1a hash with a given byte array.
+ *
+ * parameters:
+ *   h    <-- initial hash value
+ *   data <-- data to hash
+ *   size <-- data size, in bytes
+ *
+ * returns:
+ *   updated hash value
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_fnv1a_update(uint64_t     h,
+              const void  *data,
+              size_t       size)
+{
+  const unsigned char *p = data;
+
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+
+  return h;
+}
+
+/*----------------------------------------------------------------------------
+ * Update a checksum with a file's name, size and modification time.
+ *
+ * Those values are determined on rank 0 and broadcast to other ranks,
+ * so the checksum does not depend on the number of ranks.
+ *
+ * parameters:
+ *   filename <-- name of file
+ *   h        <-- initial hash value
+ *
+ * returns:
+ *   updated hash value
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_file_checksum(const char  *filename,
+               uint64_t     h)
+{
+  uint64_t file_info[2] = {0, 0};
+
+  if (cs_glob_rank_id < 1) {
+#if defined(HAVE_SYS_STAT_H)
+    struct stat st;
+    if (stat(filename, &st) == 0) {
+      file_info[0] = st.st_size;
+      file_info[1] = st.st_mtime;
+    }
+#else
+    file_info[0] = cs_file_size(filename);
+#endif
+  }
+
+  cs_parall_bcast(0, 2, CS_UINT64, file_info);
+
+  h = _fnv1a_update(h, filename, strlen(filename) + 1);
+  h = _fnv1a_update(h, file_info, 2*sizeof(uint64_t));
+
+  return h;
+}
+
 /*----------------------------------------------------------------------------
  * Add a periodicity to mesh->periodicities (fvm_periodicity_t *) structure.
  *
@@ -1389,6 +1506,146 @@ _transform_coords(size_t         n_coords,
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Shift referenced global numbers in case of appended data.
+ *
+ * parameters:
+ *   n_vals    <-- number of values
+ *   num_shift <-- global number shift
+ *   vals      <-> global numbers (0 for none)
+ *----------------------------------------------------------------------------*/
+
+static void
+_shift_gnum(cs_lnum_t   n_vals,
+            cs_gnum_t   num_shift,
+            cs_gnum_t   vals[])
+{
+  if (num_shift > 0) {
+    for (cs_lnum_t ii = 0; ii < n_vals; ii++) {
+      if (vals[ii] != 0)
+        vals[ii] += num_shift;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Complete pending reads and post-process the associated data.
+ *
+ * This function matches the cs_mesh_builder_input_wait_t prototype.
+ *
+ * parameters:
+ *   input <-> pointer to mesh reader
+ *   data  <-- mesh builder array whose reads must be complete,
+ *             or NULL for all
+ *----------------------------------------------------------------------------*/
+
+static void
+_complete_pending_reads(void        *input,
+                        const void  *data)
+{
+  _mesh_reader_t  *mr = input;
+
+  if (mr == NULL)
+    return;
+
+  int j = 0;
+
+  for (int i = 0; i < mr->n_pending; i++) {
+
+    _pending_read_t  *pr = mr->pending + i;
+
+    if (data != NULL && pr->data != data) {
+      mr->pending[j++] = *pr;
+      continue;
+    }
+
+    cs_file_read_block_wait(&(pr->request));
+
+    if (pr->matrix != NULL) {
+      cs_real_t *coords = (cs_real_t *)(pr->data) + pr->val_offset;
+      _transform_coords(pr->n_vals / 3, coords, pr->matrix);
+    }
+    else {
+      cs_gnum_t *vals = (cs_gnum_t *)(pr->data) + pr->val_offset;
+      _shift_gnum(pr->n_vals, pr->num_shift, vals);
+    }
+
+  }
+
+  mr->n_pending = j;
+
+  /* Inputs are not closed here, but when the reader is destroyed:
+     closing is collective, and a NULL data argument may only mean that
+     the local array is empty, so it does not indicate the same point
+     in the reading process on all ranks. */
+}
+
+/*----------------------------------------------------------------------------
+ * Read a section's data block, deferring its completion if possible.
+ *
+ * If the read is deferred, post-processing (global number shift or
+ * coordinates transformation) is done upon completion; otherwise,
+ * it is done immediately.
+ *
+ * parameters:
+ *   header     <-- section header
+ *   file_id    <-- id of file handled by mesh builder
+ *   gnum_start <-- global number of first block item (1 to n numbering)
+ *   gnum_end   <-- global number of past-the end block item
+ *   data       <-> associated mesh builder array
+ *   val_offset <-- offset of values read in array
+ *   n_vals     <-- number of values read
+ *   num_shift  <-- global number shift for appended data (connectivity)
+ *   matrix     <-- coordinate transformation matrix (coordinates), or NULL
+ *   mr         <-> pointer to mesh reader structure
+ *   pp_in      <-> pointer to associated input
+ *----------------------------------------------------------------------------*/
+
+static void
+_read_block_deferred(cs_io_sec_header_t  *header,
+                     int                  file_id,
+                     cs_gnum_t            gnum_start,
+                     cs_gnum_t            gnum_end,
+                     void                *data,
+                     cs_lnum_t            val_offset,
+                     cs_lnum_t            n_vals,
+                     cs_gnum_t            num_shift,
+                     const double        *matrix,
+                     _mesh_reader_t      *mr,
+                     cs_io_t             *pp_in)
+{
+  size_t type_size = (matrix != NULL) ? sizeof(cs_real_t) : sizeof(cs_gnum_t);
+  void *elts_cur = NULL;
+  if (data != NULL)
+    elts_cur = (unsigned char *)data + val_offset*type_size;
+
+  cs_file_read_request_t *r = NULL;
+
+  if (mr->defer_reads)
+    r = cs_io_read_block_start(header, gnum_start, gnum_end, elts_cur, pp_in);
+  else
+    cs_io_read_block(header, gnum_start, gnum_end, elts_cur, pp_in);
+
+  if (r != NULL) {
+    BFT_REALLOC(mr->pending, mr->n_pending + 1, _pending_read_t);
+    _pending_read_t  *pr = mr->pending + mr->n_pending;
+    pr->file_id = file_id;
+    pr->data = data;
+    pr->val_offset = val_offset;
+    pr->n_vals = n_vals;
+    pr->num_shift = num_shift;
+    pr->matrix = matrix;
+    pr->request = r;
+    mr->n_pending += 1;
+  }
+
+  else if (matrix != NULL)
+    _transform_coords(n_vals / 3, elts_cur, matrix);
+
+  else
+    _shift_gnum(n_vals, num_shift, elts_cur);
+}
+
 /*----------------------------------------------------------------------------
  * Invert a homogeneous transformation matrix.
  *
@@ -1646,6 +1903,7 @@ _read_data(int                 file_id,
 
     if (strncmp(header.sec_name, "EOF", CS_IO_NAME_LEN)
         == 0) {
+      _complete_pending_reads(mr, NULL);
       cs_io_finalize(&pp_in);
       pp_in = NULL;
     }
@@ -1941,27 +2199,25 @@ _read_data(int                 file_id,
         /* Reallocate for each read, as size of indexed array
            cannot be determined before reading the previous section
            (and is thus not yet known for future files). */
+        _complete_pending_reads(mr, mb->face_vertices);
         BFT_REALLOC(mb->face_vertices,
                     mr->n_faces_connect_read + n_vals_cur,
                     cs_gnum_t);
 
-        /* Read data */
+        /* Read data (completion may be deferred); shift referenced
+           vertex numbers in case of appended data */
         cs_io_set_cs_gnum(&header, pp_in);
-        if (mb->face_vertices != NULL)
-          elts_cur = mb->face_vertices + val_offset_cur;
-        else
-          elts_cur = NULL;
-        cs_io_read_block(&header, face_vtx_range[0], face_vtx_range[1],
-                         elts_cur, pp_in);
-
-        /* Shift referenced vertex numbers in case of appended data */
-        if (mr->n_g_vertices_read > 0) {
-          cs_lnum_t ii;
-          for (ii = 0; ii < n_vals_cur; ii++) {
-            if (mb->face_vertices[val_offset_cur + ii] != 0)
-              mb->face_vertices[val_offset_cur + ii] += mr->n_g_vertices_read;
-          }
-        }
+        _read_block_deferred(&header,
+                             file_id,
+                             face_vtx_range[0],
+                             face_vtx_range[1],
+                             mb->face_vertices,
+                             val_offset_cur,
+                             n_vals_cur,
+                             mr->n_g_vertices_read,
+                             NULL,
+                             mr,
+                             pp_in);
 
         mr->n_faces_connect_read += n_vals_cur;
       }
@@ -1989,24 +2245,23 @@ _read_data(int                 file_id,
         if (mb->vertex_coords == NULL)
           BFT_MALLOC(mb->vertex_coords, n_vals, cs_real_t);
 
-        /* Read data */
+        /* Read data (completion may be deferred);
+           transform coordinates if necessary */
         cs_io_assert_cs_real(&header, pp_in);
-        if (mb->vertex_coords != NULL)
-          elts_cur = mb->vertex_coords + val_offset_cur;
-        else
-          elts_cur = NULL;
-        cs_io_read_block(&header, gnum_range_cur[0], gnum_range_cur[1],
-                         elts_cur, pp_in);
-
-        /* Transform coordinates if necessary */
-
-        if (f->matrix != NULL) {
-          cs_gnum_t range_size = gnum_range_cur[1] - gnum_range_cur[0];
-          _transform_coords(range_size,
-                            mb->vertex_coords + val_offset_cur,
-                            f->matrix);
+        _read_block_deferred(&header,
+                             file_id,
+                             gnum_range_cur[0],
+                             gnum_range_cur[1],
+                             mb->vertex_coords,
+                             val_offset_cur,
+                             n_vals_cur,
+                             0,
+                             f->matrix,
+                             mr,
+                             pp_in);
+
+        if (f->matrix != NULL)
           mesh->modified |= CS_MESH_MODIFIED;
-        }
       }
 
       else if (strncmp(header.sec_name, "vertex_refinement_generation",
@@ -2146,7 +2401,14 @@ _read_data(int                 file_id,
   /*------------------------------*/
 
   f->offset = 0;
-  cs_io_finalize(&pp_in);
+
+  /* Keep input open if reads may be pending (the decision must not depend
+     on local pending reads, as it must be the same on all ranks) */
+
+  if (mr->defer_reads && pp_in != NULL)
+    mr->pending_io[file_id] = pp_in;
+  else
+    cs_io_finalize(&pp_in);
 }
 
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
@@ -2529,6 +2791,16 @@ cs_preprocessor_data_read_mesh(cs_mesh_t          *mesh,
     mesh->modified |= CS_MESH_MODIFIED;
   }
   else {
+
+    /* Completion of reads of face -> vertices connectivity and vertex
+       coordinates may be deferred until those arrays are needed, so as
+       to overlap partitioning and redistribution of face -> cells
+       connectivity and families */
+
+    mr->defer_reads = true;
+    mesh_builder->input = mr;
+    mesh_builder->input_wait = _complete_pending_reads;
+
     for (file_id = 0; file_id < mr->n_files; file_id++)
       _read_data(file_id, mesh, mesh_builder, mr, echo);
 
@@ -2548,6 +2820,10 @@ cs_preprocessor_data_read_mesh(cs_mesh_t          *mesh,
 
   cs_mesh_from_builder(mesh, mesh_builder);
 
+  _complete_pending_reads(mr, NULL);
+  mesh_builder->input = NULL;
+  mesh_builder->input_wait = NULL;
+
   /* Free temporary memory */
 
   if (mr != NULL)
@@ -2559,6 +2835,73 @@ cs_preprocessor_data_read_mesh(cs_mesh_t          *mesh,
   cs_mesh_clean_families(mesh);
 }
 
+/*----------------------------------------------------------------------------
+ * Compute a checksum of the mesh input defined for reading.
+ *
+ * The checksum is based on the names, sizes and modification times of
+ * all mesh input files (so as not to read the files twice), and the
+ * associated transformation and group renaming options. It does not
+ * depend on the number of ranks used. This function must be called
+ * after cs_preprocessor_data_read_headers() and before
+ * cs_preprocessor_data_read_mesh().
+ *
+ * returns:
+ *   checksum of mesh input, or 0 if not available (such as for
+ *   internally generated cartesian meshes)
+ *----------------------------------------------------------------------------*/
+
+uint64_t
+cs_preprocessor_data_checksum(void)
+{
+  const _mesh_reader_t *mr = _cs_glob_mesh_reader;
+
+  if (mr == NULL)
+    return 0;
+
+  uint64_t h = 14695981039346656037ULL;
+
+  h = _fnv1a_update(h, &(mr->n_files), sizeof(int));
+
+  for (int i = 0; i < mr->n_files; i++) {
+
+    const _mesh_file_info_t *f = mr->file_info + i;
+
+    h = _file_checksum(f->filename, h);
+
+    if (f->matrix != NULL)
+      h = _fnv1a_update(h, f->matrix, 12*sizeof(double));
+
+    for (size_t j = 0; j < f->n_group_renames; j++) {
+      const char *o_name = f->old_group_names[j];
+      const char *n_name = f->new_group_names[j];
+      h = _fnv1a_update(h, o_name, strlen(o_name) + 1);
+      if (n_name != NULL)
+        h = _fnv1a_update(h, n_name, strlen(n_name) + 1);
+    }
+
+  }
+
+  if (h == 0)
+    h = 1;
+
+  return h;
+}
+
+/*----------------------------------------------------------------------------
+ * Discard mesh input defined for reading.
+ *
+ * This may be used instead of cs_preprocessor_data_read_mesh() when the
+ * mesh is obtained by other means (such as a cached mesh image) after
+ * cs_preprocessor_data_read_headers() has been called.
+ *----------------------------------------------------------------------------*/
+
+void
+cs_preprocessor_data_discard_input(void)
+{
+  if (_cs_glob_mesh_reader != NULL)
+    _mesh_reader_destroy(&_cs_glob_mesh_reader);
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -182,6 +182,35 @@ cs_preprocessor_data_read_mesh(cs_mesh_t          *mesh,
                                cs_mesh_builder_t  *mesh_builder,
                                bool                ignore_cartesian);
 
+/*----------------------------------------------------------------------------
+ * Compute a checksum of the mesh input defined for reading.
+ *
+ * The checksum is based on the names, sizes and modification times of
+ * all mesh input files (so as not to read the files twice), and the
+ * associated transformation and group renaming options. It does not
+ * depend on the number of ranks used. This function must be called
+ * after cs_preprocessor_data_read_headers() and before
+ * cs_preprocessor_data_read_mesh().
+ *
+ * returns:
+ *   checksum of mesh input, or 0 if not available (such as for
+ *   internally generated cartesian meshes)
+ *----------------------------------------------------------------------------*/
+
+uint64_t
+cs_preprocessor_data_checksum(void);
+
+/*----------------------------------------------------------------------------
+ * Discard mesh input defined for reading.
+ *
+ * This may be used instead of cs_preprocessor_data_read_mesh() when the
+ * mesh is obtained by other means (such as a cached mesh image) after
+ * cs_preprocessor_data_read_headers() has been called.
+ *----------------------------------------------------------------------------*/
+
+void
+cs_preprocessor_data_discard_input(void);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -60,6 +60,12 @@ BEGIN_C_DECLS
   Based on the uniform, gaussian, and poisson random number generation code
   from netlib.org: lagged (-273,-607) Fibonacci; Box-Muller;
   by W.P. Petersen, IPS, ETH Zuerich.
+
+  Counter-based generators are also provided, using the Philox4x32-10
+  algorithm from J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw,
+  "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11. As they have no
+  internal state, they may be called concurrently, and the values produced
+  for a given key and counter do not depend on the calling thread.
 */
 
 /*! \cond DOXYGEN_SHOULD_SKIP_THIS */
@@ -68,6 +74,17 @@ BEGIN_C_DECLS
  * Macro definitions
  *============================================================================*/
 
+/* Philox4x32 multipliers and Weyl sequence key increments */
+
+#define _PHILOX_M0  0xD2511F53U
+#define _PHILOX_M1  0xCD9E8D57U
+#define _PHILOX_W0  0x9E3779B9U
+#define _PHILOX_W1  0xBB67AE85U
+
+/* Number of Philox blocks generated per batch (2 doubles per block) */
+
+#define _PHILOX_BATCH_SIZE  64
+
 /*============================================================================
  * Type definitions
  *============================================================================*/
@@ -171,6 +188,67 @@ _normal00(void)
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Generate a batch of uniform values with the Philox4x32-10 algorithm.
+ *
+ * Each 128-bit output block is converted to 2 double precision values
+ * in [0, 1), using 53 random bits for each.
+ *
+ * \param[in]   key        generator key
+ * \param[in]   counter    upper 64 bits of counter
+ * \param[in]   block_id   id of first block (lower 64 bits of counter)
+ * \param[in]   n_blocks   number of blocks (<= _PHILOX_BATCH_SIZE)
+ * \param[out]  a          generated values (size: 2*n_blocks)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_philox_uniform_batch(uint64_t   key,
+                      uint64_t   counter,
+                      uint64_t   block_id,
+                      int        n_blocks,
+                      double     a[])
+{
+  const double r53 = 1.0 / 9007199254740992.0; /* 2^-53 */
+
+  const uint32_t c2 = (uint32_t)counter;
+  const uint32_t c3 = (uint32_t)(counter >> 32);
+
+# pragma omp simd
+  for (int i = 0; i < n_blocks; i++) {
+
+    uint64_t b_id = block_id + (uint64_t)i;
+
+    uint32_t x0 = (uint32_t)b_id;
+    uint32_t x1 = (uint32_t)(b_id >> 32);
+    uint32_t x2 = c2;
+    uint32_t x3 = c3;
+
+    uint32_t k0 = (uint32_t)key;
+    uint32_t k1 = (uint32_t)(key >> 32);
+
+    for (int r = 0; r < 10; r++) {
+      uint64_t p0 = (uint64_t)_PHILOX_M0 * x0;
+      uint64_t p1 = (uint64_t)_PHILOX_M1 * x2;
+      x0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+      x1 = (uint32_t)p1;
+      x2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+      x3 = (uint32_t)p0;
+      k0 += _PHILOX_W0;
+      k1 += _PHILOX_W1;
+    }
+
+    /* Shifted values fit in signed integers, for faster conversion */
+
+    a[2*i]   = (  (double)((int32_t)(x0 >> 5)) * 67108864.0
+                + (double)((int32_t)(x1 >> 6))) * r53;
+    a[2*i+1] = (  (double)((int32_t)(x2 >> 5)) * 67108864.0
+                + (double)((int32_t)(x3 >> 6))) * r53;
+
+  }
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*=============================================================================
@@ -585,6 +663,102 @@ cs_random_restore(cs_real_t  save_block[1634])
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Counter-based uniform distribution random number generator.
+ *
+ * Values are generated using the Philox4x32-10 algorithm, and depend
+ * only on the key, the counter, and their position in the output array,
+ * so that independent, reproducible streams may be obtained in threaded
+ * or parallel code by using a different key or counter for each stream
+ * (for example a particle or thread id as the key, and a time step
+ * number as the counter).
+ *
+ * This function has no internal state, so it is thread-safe.
+ *
+ * \param[in]   key      stream key
+ * \param[in]   counter  stream counter
+ * \param[in]   n        number of values to compute
+ * \param[out]  a        pseudo-random numbers following uniform
+ *                       distribution in [0, 1)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_counter_uniform(uint64_t   key,
+                          uint64_t   counter,
+                          cs_lnum_t  n,
+                          cs_real_t  a[])
+{
+  double buf[_PHILOX_BATCH_SIZE*2];
+
+  uint64_t block_id = 0;
+
+  for (cs_lnum_t s_id = 0; s_id < n; s_id += _PHILOX_BATCH_SIZE*2) {
+
+    cs_lnum_t n_vals = CS_MIN(n - s_id, _PHILOX_BATCH_SIZE*2);
+    int n_blocks = (n_vals + 1) / 2;
+
+    _philox_uniform_batch(key, counter, block_id, n_blocks, buf);
+    block_id += n_blocks;
+
+    for (cs_lnum_t i = 0; i < n_vals; i++)
+      a[s_id + i] = buf[i];
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Counter-based normal distribution random number generator.
+ *
+ * Box-Muller method applied to values generated by
+ * \ref cs_random_counter_uniform, with the same key and counter
+ * semantics.
+ *
+ * This function has no internal state, so it is thread-safe.
+ *
+ * \param[in]   key      stream key
+ * \param[in]   counter  stream counter
+ * \param[in]   n        number of values to compute
+ * \param[out]  x        pseudo-random numbers following normal distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_counter_normal(uint64_t   key,
+                         uint64_t   counter,
+                         cs_lnum_t  n,
+                         cs_real_t  x[])
+{
+  const double twopi = 6.2831853071795862;
+
+  double buf[_PHILOX_BATCH_SIZE*2];
+
+  uint64_t block_id = 0;
+
+  for (cs_lnum_t s_id = 0; s_id < n; s_id += _PHILOX_BATCH_SIZE*2) {
+
+    cs_lnum_t n_vals = CS_MIN(n - s_id, _PHILOX_BATCH_SIZE*2);
+    int n_blocks = (n_vals + 1) / 2;
+
+    _philox_uniform_batch(key, counter, block_id, n_blocks, buf);
+    block_id += n_blocks;
+
+#   pragma omp simd
+    for (int i = 0; i < n_blocks; i++) {
+      double r1 = twopi * buf[2*i];
+      double r2 = sqrt(-2.*(log(1. - buf[2*i+1])));
+      buf[2*i]   = cos(r1) * r2;
+      buf[2*i+1] = sin(r1) * r2;
+    }
+
+    for (cs_lnum_t i = 0; i < n_vals; i++)
+      x[s_id + i] = buf[i];
+
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -142,6 +142,56 @@ cs_random_save(cs_real_t  save_block[1634]);
 void
 cs_random_restore(cs_real_t  save_block[1634]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Counter-based uniform distribution random number generator.
+ *
+ * Values are generated using the Philox4x32-10 algorithm, and depend
+ * only on the key, the counter, and their position in the output array,
+ * so that independent, reproducible streams may be obtained in threaded
+ * or parallel code by using a different key or counter for each stream
+ * (for example a particle or thread id as the key, and a time step
+ * number as the counter).
+ *
+ * This function has no internal state, so it is thread-safe.
+ *
+ * \param[in]   key      stream key
+ * \param[in]   counter  stream counter
+ * \param[in]   n        number of values to compute
+ * \param[out]  a        pseudo-random numbers following uniform
+ *                       distribution in [0, 1)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_counter_uniform(uint64_t   key,
+                          uint64_t   counter,
+                          cs_lnum_t  n,
+                          cs_real_t  a[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Counter-based normal distribution random number generator.
+ *
+ * Box-Muller method applied to values generated by
+ * \ref cs_random_counter_uniform, with the same key and counter
+ * semantics.
+ *
+ * This function has no internal state, so it is thread-safe.
+ *
+ * \param[in]   key      stream key
+ * \param[in]   counter  stream counter
+ * \param[in]   n        number of values to compute
+ * \param[out]  x        pseudo-random numbers following normal distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_counter_normal(uint64_t   key,
+                         uint64_t   counter,
+                         cs_lnum_t  n,
+                         cs_real_t  x[]);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
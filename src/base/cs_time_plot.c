@@ -64,6 +64,11 @@ BEGIN_C_DECLS
  * Local Macro Definitions
  *============================================================================*/
 
+/* Default number of buffered time steps for binary output
+   (used when no buffering is requested) */
+
+#define _CS_TIME_PLOT_BIN_BUFFER_STEPS 100
+
 /*=============================================================================
  * Local Structure Definitions
  *============================================================================*/
@@ -97,6 +102,9 @@ struct _cs_time_plot_t {
                                  * 1: current number of time steps in
                                  *    output buffer */
 
+  int         n_cols;           /* Number of value columns
+                                   (used for binary format) */
+
   size_t      buffer_size;      /* Buffer size if required */
   size_t      buffer_end;       /* Current buffer end */
   char       *buffer;           /* Associated buffer if required */
@@ -562,6 +570,259 @@ _write_struct_header_csv(cs_time_plot_t  *p,
     p->f = _f;
 }
 
+/*----------------------------------------------------------------------------
+ * Write a string to a binary time plot file.
+ *
+ * The string is written as its 32-bit length, followed by its characters
+ * (without the terminating null character).
+ *
+ * parameters:
+ *   f <-- pointer to associated file
+ *   s <-- string to write
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_string_bin(FILE        *f,
+                  const char  *s)
+{
+  int32_t l = strlen(s);
+
+  fwrite(&l, sizeof(int32_t), 1, f);
+  fwrite(s, 1, l, f);
+}
+
+/*----------------------------------------------------------------------------
+ * Open a binary file and write the common part of its header.
+ *
+ * Binary time plot files are written in native byte order, with the
+ * following layout:
+ *
+ *   char[32]    "code_saturne time plot binary" (null-padded)
+ *   int32       1 (allows detection of byte order)
+ *   int32       plot type (0: probes, 1: structures)
+ *   int32       first column type (0: physical time, 1: time step number)
+ *   int32       number of value columns n_cols
+ *   string      plot name (int32 length, followed by characters)
+ *
+ * followed by type-specific data (see the associated functions), then
+ * by any number of data blocks, each of which contains:
+ *
+ *   int32                 number of rows n_rows in block
+ *   double[n_rows]        time or time step column
+ *   double[n_rows*n_cols] values, column by column
+ *
+ * parameters:
+ *   p         <-> time plot values file handler
+ *   plot_type <-- 0 for probes, 1 for structures
+ *   n_cols    <-- number of value columns
+ *
+ * returns:
+ *   pointer to file, or NULL in case of error
+ *----------------------------------------------------------------------------*/
+
+static FILE *
+_write_header_start_bin(cs_time_plot_t  *p,
+                        int              plot_type,
+                        int              n_cols)
+{
+  FILE *_f = p->f;
+
+  if (_f != NULL) {
+    fclose(_f);
+    p->f = NULL;
+  }
+
+  p->n_cols = n_cols;
+
+  _f = fopen(p->file_name, "wb");
+  if (_f == NULL) {
+    bft_error(__FILE__, __LINE__, errno,
+              _("Error opening file: \"%s\""), p->file_name);
+    return NULL;
+  }
+
+  char magic[32];
+  memset(magic, 0, 32);
+  strncpy(magic, "code_saturne time plot binary", 31);
+
+  int32_t h[4] = {1, plot_type, (p->use_iteration) ? 1 : 0, n_cols};
+
+  fwrite(magic, 1, 32, _f);
+  fwrite(h, sizeof(int32_t), 4, _f);
+  _write_string_bin(_f, p->plot_name);
+
+  return _f;
+}
+
+/*----------------------------------------------------------------------------
+ * Close binary file after header output, or assign it to handler,
+ * depending on options.
+ *
+ * parameters:
+ *   p  <-> time plot values file handler
+ *   _f <-- pointer to file
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_header_end_bin(cs_time_plot_t  *p,
+                      FILE            *_f)
+{
+  if (ferror(_f))
+    bft_error(__FILE__, __LINE__, ferror(_f),
+              _("Error writing file: \"%s\""), p->file_name);
+
+  if (p->buffer_steps[0] > 0) {
+    if (fclose(_f) != 0)
+      bft_error(__FILE__, __LINE__, errno,
+                _("Error closing file: \"%s\""), p->file_name);
+  }
+  else
+    p->f = _f;
+}
+
+/*----------------------------------------------------------------------------
+ * Write file header for binary files
+ *
+ * Following the common header part, the file contains:
+ *
+ *   int32                 1 if coordinates are present, 0 otherwise
+ *   double[n_cols*3]      probe coordinates (if present)
+ *   string[n_cols]        probe names
+ *
+ * parameters:
+ *   p                <-> time plot values file handler
+ *   n_probes         <-- number of probes associated with this variable ?
+ *   probe_list       <-- numbers (1 to n) of probes if filtered, or NULL
+ *   probe_coords     <-- probe coordinates
+ *   probe_names      <-- probe names, or NULL
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_probe_header_bin(cs_time_plot_t    *p,
+                        int                n_probes,
+                        const int         *probe_list,
+                        const cs_real_t    probe_coords[],
+                        const char        *probe_names[])
+{
+  int i, probe_id;
+
+  FILE *_f = _write_header_start_bin(p, 0, n_probes);
+  if (_f == NULL)
+    return;
+
+  int32_t has_coords = (probe_coords != NULL) ? 1 : 0;
+  fwrite(&has_coords, sizeof(int32_t), 1, _f);
+
+  if (probe_coords != NULL) {
+    for (i = 0; i < n_probes; i++) {
+      double coords[3];
+      probe_id = i;
+      if (probe_list != NULL)
+        probe_id = probe_list[i] - 1;
+      for (int j = 0; j < 3; j++)
+        coords[j] = probe_coords[probe_id*3 + j];
+      fwrite(coords, sizeof(double), 3, _f);
+    }
+  }
+
+  for (i = 0; i < n_probes; i++) {
+    if (probe_names != NULL)
+      _write_string_bin(_f, probe_names[i]);
+    else {
+      char name[32];
+      probe_id = i;
+      if (probe_list != NULL)
+        probe_id = probe_list[i] - 1;
+      snprintf(name, 32, "%d", probe_id + 1);
+      _write_string_bin(_f, name);
+    }
+  }
+
+  _write_header_end_bin(p, _f);
+}
+
+/*----------------------------------------------------------------------------
+ * Write file header for binary files
+ *
+ * Following the common header part, the file contains:
+ *
+ *   double[n_cols*9]      mass matrix coefficients
+ *   double[n_cols*9]      damping matrix coefficients
+ *   double[n_cols*9]      stiffness matrix coefficients
+ *
+ * parameters:
+ *   p                  <-> time plot values file handler
+ *   n_structures       <-- number of structures associated with this plot
+ *   mass_matrixes      <-- mass matrix coefficients (3x3 blocks)
+ *   damping_matrixes   <-- damping matrix coefficients (3x3 blocks)
+ *   stiffness_matrixes <-- stiffness matrix coefficients (3x3 blocks)
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_struct_header_bin(cs_time_plot_t    *p,
+                         int                n_structures,
+                         const cs_real_t    mass_matrixes[],
+                         const cs_real_t    damping_matrixes[],
+                         const cs_real_t    stiffness_matrixes[])
+{
+  FILE *_f = _write_header_start_bin(p, 1, n_structures);
+  if (_f == NULL)
+    return;
+
+  const cs_real_t *m[3] = {mass_matrixes,
+                           damping_matrixes,
+                           stiffness_matrixes};
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < n_structures*9; j++) {
+      double v = m[i][j];
+      fwrite(&v, sizeof(double), 1, _f);
+    }
+  }
+
+  _write_header_end_bin(p, _f);
+}
+
+/*----------------------------------------------------------------------------
+ * Write buffered rows to a binary file as a block of columns.
+ *
+ * The buffer contains rows of (n_cols + 1) doubles, which are transposed
+ * so that each column is contiguous in the file.
+ *
+ * parameters:
+ *   p <-> time plot values file handler
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_block_bin(cs_time_plot_t  *p)
+{
+  const size_t stride = p->n_cols + 1;
+  const size_t n_rows = p->buffer_end / (stride*sizeof(double));
+
+  if (n_rows == 0)
+    return;
+
+  const double *rows = (const double *)(p->buffer);
+  double *cols;
+  BFT_MALLOC(cols, n_rows*stride, double);
+
+  for (size_t i = 0; i < n_rows; i++) {
+    for (size_t j = 0; j < stride; j++)
+      cols[j*n_rows + i] = rows[i*stride + j];
+  }
+
+  int32_t _n_rows = n_rows;
+  size_t n_written = fwrite(&_n_rows, sizeof(int32_t), 1, p->f);
+  if (n_written == 1)
+    n_written = fwrite(cols, sizeof(double), n_rows*stride, p->f);
+
+  if (n_written < n_rows*stride)
+    bft_error(__FILE__, __LINE__, ferror(p->f),
+              _("Error writing file: \"%s\""), p->file_name);
+
+  BFT_FREE(cols);
+}
+
 /*----------------------------------------------------------------------------
  * Add a time plot to the global time plots array.
  *----------------------------------------------------------------------------*/
@@ -645,6 +906,9 @@ _plot_file_create(const char             *plot_name,
   case CS_TIME_PLOT_CSV:
     sprintf(p->file_name, "%s%s.csv", file_prefix, plot_name);
     break;
+  case CS_TIME_PLOT_BIN:
+    sprintf(p->file_name, "%s%s.bin", file_prefix, plot_name);
+    break;
   default:
     break;
   }
@@ -665,6 +929,14 @@ _plot_file_create(const char             *plot_name,
   p->buffer_steps[0] = n_buffer_steps;
   p->buffer_steps[1] = 0;
 
+  /* Binary output is always buffered, so as to write blocks of columns
+     (the flush interval is still honored) */
+
+  if (format == CS_TIME_PLOT_BIN && n_buffer_steps < 1)
+    p->buffer_steps[0] = _CS_TIME_PLOT_BIN_BUFFER_STEPS;
+
+  p->n_cols = 0;
+
   p->buffer_size = 256;
   p->buffer_end = 0;
 
@@ -692,7 +964,13 @@ _plot_file_check_or_write(cs_time_plot_t  *p)
   if (   p->buffer_steps[0] > 0
       && p->buffer_steps[1] < p->buffer_steps[0]) {
     p->buffer_steps[1] += 1;
+    if (p->format != CS_TIME_PLOT_BIN || p->flush_times[0] <= 0)
+      return;
+    double cur_time = cs_timer_wtime();
+    if ((cur_time - p->flush_times[1]) <= p->flush_times[0])
       return;
+    p->flush_times[1] = cur_time;
+    p->buffer_steps[1] = p->buffer_steps[0];
   }
 
   /* Ensure file is open */
@@ -708,11 +986,17 @@ _plot_file_check_or_write(cs_time_plot_t  *p)
   }
 
   /* Write buffer contents */
-  n_written = fwrite(p->buffer, 1, p->buffer_end, p->f);
 
-  if (n_written < p->buffer_end)
-    bft_error(__FILE__, __LINE__, ferror(p->f),
-              _("Error writing file: \"%s\""), p->file_name);
+  if (p->format == CS_TIME_PLOT_BIN)
+    _write_block_bin(p);
+
+  else {
+    n_written = fwrite(p->buffer, 1, p->buffer_end, p->f);
+
+    if (n_written < p->buffer_end)
+      bft_error(__FILE__, __LINE__, ferror(p->f),
+                _("Error writing file: \"%s\""), p->file_name);
+  }
 
   p->buffer_end = 0;
 
@@ -799,6 +1083,9 @@ cs_time_plot_init_probe(const char             *plot_name,
                             probe_coords);
     _write_probe_header_csv(p, n_probes, probe_list, probe_coords, probe_names);
     break;
+  case CS_TIME_PLOT_BIN:
+    _write_probe_header_bin(p, n_probes, probe_list, probe_coords, probe_names);
+    break;
   default:
     break;
   }
@@ -861,6 +1148,12 @@ cs_time_plot_init_struct(const char             *plot_name,
   case CS_TIME_PLOT_CSV:
     _write_struct_header_csv(p, n_structures);
   break;
+  case CS_TIME_PLOT_BIN:
+    _write_struct_header_bin(p, n_structures,
+                             mass_matrixes,
+                             damping_matrixes,
+                             stiffness_matrixes);
+    break;
   default:
     break;
   }
@@ -970,6 +1263,29 @@ cs_time_plot_vals_write(cs_time_plot_t  *p,
 
     break;
 
+  case CS_TIME_PLOT_BIN:
+
+    /* Rows are buffered as is, and transposed on output */
+
+    if (n_vals != p->n_cols)
+      bft_error(__FILE__, __LINE__, 0,
+                _("Time plot \"%s\": %d values written for %d columns."),
+                p->plot_name, n_vals, p->n_cols);
+
+    {
+      size_t row_size = (n_vals + 1) * sizeof(double);
+      _ensure_buffer_size(p, p->buffer_end + row_size);
+
+      double *row = (double *)(p->buffer + p->buffer_end);
+      row[0] = (p->use_iteration) ? tn : t;
+      for (i = 0; i < n_vals; i++)
+        row[i+1] = vals[i];
+
+      p->buffer_end += row_size;
+    }
+
+    break;
+
   default:
     break;
   }
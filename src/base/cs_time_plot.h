@@ -55,7 +55,9 @@ typedef struct _cs_time_plot_t  cs_time_plot_t;
 
 typedef enum {
   CS_TIME_PLOT_DAT,  /* .dat file (usable by Qtplot or Grace) */
-  CS_TIME_PLOT_CSV   /* .csv file (readable by ParaView or spreadsheat) */
+  CS_TIME_PLOT_CSV,  /* .csv file (readable by ParaView or spreadsheat) */
+  CS_TIME_PLOT_BIN   /* .bin file (binary, blocks of columns, always
+                        buffered) */
 } cs_time_plot_format_t;
 
 /*============================================================================
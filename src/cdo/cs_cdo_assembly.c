@@ -94,6 +94,10 @@ BEGIN_C_DECLS
 
 static cs_cdo_assembly_t  **cs_cdo_assembly = NULL;
 
+/* Threaded assembly relying on a coloring of cells (requested or not) */
+
+static bool  cs_cdo_assembly_cell_coloring = false;
+
 /*=============================================================================
  * Local function pointer definitions
  *============================================================================*/
@@ -1218,6 +1222,177 @@ cs_cdo_assembly_setup_log(void)
                 "\n## Assembly settings\n");
   cs_log_printf(CS_LOG_SETUP, " * Default assembly buffer size:  %9d\n",
                 CS_CDO_ASSEMBLY_BUFSIZE);
+  cs_log_printf(CS_LOG_SETUP, " * Threaded assembly by colors:   %9s\n",
+                cs_base_strtf(cs_cdo_assembly_cell_coloring));
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or not a threaded assembly relying on a coloring of cells:
+ *        two cells of the same color do not share any DoF so that they can be
+ *        assembled concurrently without atomic or critical sections.
+ *        Cells are also gathered by type inside each color so that cells
+ *        with the same topology are built in a row (this is the only effect
+ *        without OpenMP threading since only one color is used).
+ *        This setting has to be done before the initialization of the CDO
+ *        connectivities. It is also available with the equation key
+ *        CS_EQKEY_OMP_ASSEMBLY_STRATEGY.
+ *
+ * \param[in] status    true to activate the colored assembly
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cdo_assembly_set_cell_coloring(bool    status)
+{
+  cs_cdo_assembly_cell_coloring = status;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check if a threaded assembly relying on a coloring of cells has been
+ *        requested
+ *
+ * \return true or false
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_cdo_assembly_has_cell_coloring(void)
+{
+  return cs_cdo_assembly_cell_coloring;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build a coloring of cells such that two cells sharing a DoF (an
+ *        entity in the c2x adjacency) have not the same color. A greedy
+ *        algorithm is used so that the number of colors is at most the max.
+ *        number of neighbors of a cell plus one. If x2c is NULL, all cells
+ *        get the same color (single-threaded case).
+ *        Inside a color, cells are gathered by type (if cell_type is not
+ *        NULL) so that cells with the same topology are built in a row.
+ *        Then cells are sorted by increasing id.
+ *        Scalar-valued CDO-Fb schemes build consecutive cells with the
+ *        same number of faces by batch of CS_CDO_CELL_BATCH_SIZE cells
+ *        (the static condensation is performed for the whole batch).
+ *
+ * \param[in] c2x        cell --> entities (DoFs) adjacency
+ * \param[in] x2c        entity --> cells adjacency (transposed of c2x) or NULL
+ * \param[in] cell_type  type of each cell or NULL
+ *
+ * \return a pointer to a new color --> cells adjacency
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_adjacency_t *
+cs_cdo_assembly_build_cell_coloring(const cs_adjacency_t   *c2x,
+                                    const cs_adjacency_t   *x2c,
+                                    const fvm_element_t    *cell_type)
+{
+  assert(c2x != NULL);
+
+  const cs_lnum_t  n_cells = c2x->n_elts;
+
+  int  n_colors = 0;
+  int  *c_color = NULL;
+
+  BFT_MALLOC(c_color, n_cells, int);
+
+  if (x2c == NULL) {
+
+    n_colors = (n_cells > 0) ? 1 : 0;
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+      c_color[c_id] = 0;
+
+  }
+  else {
+
+    int  n_max_colors = 16;
+    cs_lnum_t  *color_mark = NULL;
+
+    BFT_MALLOC(color_mark, n_max_colors, cs_lnum_t);
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+      c_color[c_id] = -1;
+    for (int k = 0; k < n_max_colors; k++)
+      color_mark[k] = -1;
+
+    /* Greedy coloring: the first color which is not used by a cell sharing a
+       DoF with the current cell is selected */
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+
+      for (cs_lnum_t j = c2x->idx[c_id]; j < c2x->idx[c_id+1]; j++) {
+
+        const cs_lnum_t  x_id = c2x->ids[j];
+        for (cs_lnum_t k = x2c->idx[x_id]; k < x2c->idx[x_id+1]; k++) {
+
+          const int  color = c_color[x2c->ids[k]];
+          if (color > -1)
+            color_mark[color] = c_id;
+
+        }
+
+      } /* Loop on DoFs of the current cell */
+
+      int  c_col = 0;
+      while (c_col < n_colors && color_mark[c_col] == c_id)
+        c_col++;
+
+      if (c_col == n_colors) { /* Add a new color */
+
+        if (n_colors == n_max_colors) {
+          n_max_colors *= 2;
+          BFT_REALLOC(color_mark, n_max_colors, cs_lnum_t);
+          for (int k = n_colors; k < n_max_colors; k++)
+            color_mark[k] = -1;
+        }
+        n_colors++;
+
+      }
+
+      c_color[c_id] = c_col;
+
+    } /* Loop on cells */
+
+    BFT_FREE(color_mark);
+
+  }
+
+  /* Build the color --> cells adjacency. Use a counting sort on the key
+     (color, cell type) which keeps cells sorted by id in each bucket. */
+
+  const int  n_types = (cell_type == NULL) ? 1 : FVM_N_ELEMENT_TYPES;
+  const int  n_buckets = n_colors*n_types;
+
+  cs_lnum_t  *shift = NULL;
+  BFT_MALLOC(shift, n_buckets + 1, cs_lnum_t);
+  for (int k = 0; k < n_buckets + 1; k++)
+    shift[k] = 0;
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    if (cell_type != NULL)
+      c_color[c_id] = c_color[c_id]*n_types + cell_type[c_id];
+    shift[c_color[c_id]+1] += 1;
+  }
+  for (int k = 0; k < n_buckets; k++)
+    shift[k+1] += shift[k];
+
+  cs_adjacency_t  *colors = cs_adjacency_create(0, -1, n_colors);
+
+  for (int k = 0; k < n_colors + 1; k++)
+    colors->idx[k] = shift[k*n_types];
+
+  BFT_MALLOC(colors->ids, n_cells, cs_lnum_t);
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    colors->ids[shift[c_color[c_id]]++] = c_id;
+
+  BFT_FREE(shift);
+  BFT_FREE(c_color);
+
+  return colors;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -2692,7 +2867,11 @@ cs_cdo_assembly_eblock_matrix_seqs(const cs_sdm_t                *m,
   assert(asb->edim == asb->ddim);
   assert(row->expval != NULL);
 
-  const int  dim = asb->ddim;
+  /* Buffers are sized with the largest block among all systems. The size of
+     the blocks of the current system may be smaller. */
+
+  const int  dim = bd->blocks[0].n_rows;
+  assert(dim <= asb->ddim);
 
   /* Expand the values for a bundle of rows */
 
@@ -2775,7 +2954,11 @@ cs_cdo_assembly_eblock_matrix_seqt(const cs_sdm_t                *m,
   assert(asb->edim == asb->ddim);
   assert(row->expval != NULL);
 
-  const int  dim = asb->ddim;
+  /* Buffers are sized with the largest block among all systems. The size of
+     the blocks of the current system may be smaller. */
+
+  const int  dim = bd->blocks[0].n_rows;
+  assert(dim <= asb->ddim);
 
   /* Expand the values for a bundle of rows */
 
@@ -2864,7 +3047,11 @@ cs_cdo_assembly_eblock_matrix_mpis(const cs_sdm_t                *m,
   assert(asb->edim == asb->ddim);
   assert(row->expval != NULL);
 
-  const int  dim = asb->ddim;
+  /* Buffers are sized with the largest block among all systems. The size of
+     the blocks of the current system may be smaller. */
+
+  const int  dim = bd->blocks[0].n_rows;
+  assert(dim <= asb->ddim);
 
   /* Expand the values for a bundle of rows */
 
@@ -2956,7 +3143,11 @@ cs_cdo_assembly_eblock_matrix_mpit(const cs_sdm_t                *m,
   assert(asb->edim == asb->ddim);
   assert(row->expval != NULL);
 
-  const int  dim = asb->ddim;
+  /* Buffers are sized with the largest block among all systems. The size of
+     the blocks of the current system may be smaller. */
+
+  const int  dim = bd->blocks[0].n_rows;
+  assert(dim <= asb->ddim);
 
   /* Expand the values for a bundle of rows */
 
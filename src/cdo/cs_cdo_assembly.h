@@ -31,8 +31,11 @@
  *  Local headers
  *----------------------------------------------------------------------------*/
 
+#include "fvm_defs.h"
+
 #include "cs_matrix.h"
 #include "cs_matrix_assembler.h"
+#include "cs_mesh_adjacencies.h"
 #include "cs_param_types.h"
 #include "cs_range_set.h"
 #include "cs_sdm.h"
@@ -94,6 +97,64 @@ typedef void
 void
 cs_cdo_assembly_setup_log(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or not a threaded assembly relying on a coloring of cells:
+ *        two cells of the same color do not share any DoF so that they can be
+ *        assembled concurrently without atomic or critical sections.
+ *        Cells are also gathered by type inside each color so that cells
+ *        with the same topology are built in a row (this is the only effect
+ *        without OpenMP threading since only one color is used).
+ *        This setting has to be done before the initialization of the CDO
+ *        connectivities. It is also available with the equation key
+ *        CS_EQKEY_OMP_ASSEMBLY_STRATEGY.
+ *
+ * \param[in] status    true to activate the colored assembly
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cdo_assembly_set_cell_coloring(bool    status);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check if a threaded assembly relying on a coloring of cells has been
+ *        requested
+ *
+ * \return true or false
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_cdo_assembly_has_cell_coloring(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build a coloring of cells such that two cells sharing a DoF (an
+ *        entity in the c2x adjacency) have not the same color. A greedy
+ *        algorithm is used so that the number of colors is at most the max.
+ *        number of neighbors of a cell plus one. If x2c is NULL, all cells
+ *        get the same color (single-threaded case).
+ *        Inside a color, cells are gathered by type (if cell_type is not
+ *        NULL) so that cells with the same topology are built in a row.
+ *        Then cells are sorted by increasing id.
+ *        Scalar-valued CDO-Fb schemes build consecutive cells with the
+ *        same number of faces by batch of CS_CDO_CELL_BATCH_SIZE cells
+ *        (the static condensation is performed for the whole batch).
+ *
+ * \param[in] c2x        cell --> entities (DoFs) adjacency
+ * \param[in] x2c        entity --> cells adjacency (transposed of c2x) or NULL
+ * \param[in] cell_type  type of each cell or NULL
+ *
+ * \return a pointer to a new color --> cells adjacency
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_adjacency_t *
+cs_cdo_assembly_build_cell_coloring(const cs_adjacency_t   *c2x,
+                                    const cs_adjacency_t   *x2c,
+                                    const fvm_element_t    *cell_type);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Get a pointer to a cs_cdo_assembly_t structure related to a given
@@ -44,6 +44,7 @@
 #include "fvm_io_num.h"
 
 #include "cs_array.h"
+#include "cs_cdo_assembly.h"
 #include "cs_flag.h"
 #include "cs_log.h"
 #include "cs_mesh_adjacencies.h"
@@ -355,6 +356,70 @@ _build_e2e_through_cell(const cs_cdo_connect_t     *connect)
   return e2e;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Build a small hash table (open addressing with linear probing)
+ *         giving the position of a vertex in the list of vertices of a cell
+ *
+ * \param[in]      n_vc      number of vertices in the cell
+ * \param[in]      c2v_ids   list of vertex ids of the cell
+ * \param[in]      h_mask    size of the hash table minus one (power of 2)
+ * \param[in, out] h_keys    vertex ids stored in the hash table
+ * \param[in, out] h_pos     position in the cell related to each key
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_build_vtx_hash(int                n_vc,
+                const cs_lnum_t   *c2v_ids,
+                int                h_mask,
+                cs_lnum_t         *h_keys,
+                short int         *h_pos)
+{
+  for (int h = 0; h < h_mask + 1; h++)
+    h_keys[h] = -1;
+
+  for (short int v = 0; v < n_vc; v++) {
+
+    int  h = (int)((2654435761U*(unsigned)c2v_ids[v]) & (unsigned)h_mask);
+    while (h_keys[h] > -1)
+      h = (h + 1) & h_mask;
+
+    h_keys[h] = c2v_ids[v];
+    h_pos[h] = v;
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the position of a vertex in the list of vertices of a cell
+ *         using the hash table built by \ref _build_vtx_hash
+ *
+ * \param[in]  v_id      vertex id
+ * \param[in]  h_mask    size of the hash table minus one (power of 2)
+ * \param[in]  h_keys    vertex ids stored in the hash table
+ * \param[in]  h_pos     position in the cell related to each key
+ *
+ * \return the position of the vertex in the list
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline short int
+_get_vtx_position(cs_lnum_t          v_id,
+                  int                h_mask,
+                  const cs_lnum_t   *h_keys,
+                  const short int   *h_pos)
+{
+  int  h = (int)((2654435761U*(unsigned)v_id) & (unsigned)h_mask);
+  while (h_keys[h] != v_id) {
+    assert(h_keys[h] > -1);
+    h = (h + 1) & h_mask;
+  }
+
+  return h_pos[h];
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Compute max number of entities by cell and the max range between
@@ -374,12 +439,6 @@ _compute_max_ent(const cs_mesh_t      *m,
   assert(connect->f2e != NULL);
 
   const cs_lnum_t  n_vertices = connect->n_vertices;
-
-  short int  *v_count = NULL;
-  BFT_MALLOC(v_count, n_vertices, short int);
-# pragma omp parallel for if (n_vertices > CS_THR_MIN)
-  for (cs_lnum_t i = 0; i < n_vertices; i++) v_count[i] = 0;
-
   const cs_lnum_t  n_cells = connect->n_cells;
   const cs_lnum_t  n_edges = connect->n_edges;
   const cs_adjacency_t  *c2v = connect->c2v;
@@ -391,113 +450,131 @@ _compute_max_ent(const cs_mesh_t      *m,
 
   int  n_max_vc = 0, n_max_ec = 0, n_max_fc = 0;
   int  n_max_v2ec = 0, n_max_v2fc = 0, n_max_vf = 0;
+  cs_lnum_t  e_max_range = 0, v_max_range = 0;
+
+  /* Vertices are counted using their position in the cell --> vertices
+     list so that each thread only needs a small local buffer. This position
+     is retrieved thanks to a small hash table (at least twice as large as
+     the number of vertices in the cell). */
+
+# pragma omp parallel if (n_cells > CS_THR_MIN)                        \
+  reduction(max:n_max_vc, n_max_ec, n_max_fc, n_max_v2ec, n_max_v2fc)   \
+  reduction(max:n_max_vf, e_max_range, v_max_range)
+  {
+    int  v_count_size = 0, h_size = 0;
+    short int  *v_count = NULL, *h_pos = NULL;
+    cs_lnum_t  *h_keys = NULL;
+
+#   pragma omp for
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
 
-  connect->e_max_cell_range = 0;
-  connect->v_max_cell_range = 0;
-
-  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      /* Vertices */
 
-    /* Vertices */
+      const cs_lnum_t  *c2v_idx = c2v->idx + c_id;
+      const cs_lnum_t  *c2v_ids = c2v->ids + c2v_idx[0];
+      const int n_vc = c2v_idx[1] - c2v_idx[0];
 
-    const cs_lnum_t  *c2v_idx = c2v->idx + c_id;
-    const cs_lnum_t  *c2v_ids = c2v->ids + c2v_idx[0];
-    const int n_vc = c2v_idx[1] - c2v_idx[0];
+      if (n_vc > v_count_size) {
+        v_count_size = CS_MAX(2*v_count_size, n_vc);
+        BFT_REALLOC(v_count, v_count_size, short int);
+      }
 
-    cs_lnum_t  min_id = n_vertices, max_id = 0;
-    for (short int v = 0; v < n_vc; v++) {
-      if (c2v_ids[v] < min_id) min_id = c2v_ids[v];
-      if (c2v_ids[v] > max_id) max_id = c2v_ids[v];
-    }
-    cs_lnum_t  _range = max_id - min_id;
+      int  h_mask = 7;
+      while (h_mask + 1 < 2*n_vc)
+        h_mask = 2*h_mask + 1;
 
-    if (n_vc > n_max_vc) n_max_vc = n_vc;
-    if (connect->v_max_cell_range < _range)
-      connect->v_max_cell_range = _range;
+      if (h_mask + 1 > h_size) {
+        h_size = h_mask + 1;
+        BFT_REALLOC(h_keys, h_size, cs_lnum_t);
+        BFT_REALLOC(h_pos, h_size, short int);
+      }
 
-    /* Edges */
+      _build_vtx_hash(n_vc, c2v_ids, h_mask, h_keys, h_pos);
 
-    const cs_lnum_t  *c2e_idx = c2e->idx + c_id;
-    const cs_lnum_t  *c2e_ids = c2e->ids + c2e_idx[0];
-    const int n_ec = c2e_idx[1] - c2e_idx[0];
+      cs_lnum_t  min_id = n_vertices, max_id = 0;
+      for (short int v = 0; v < n_vc; v++) {
+        if (c2v_ids[v] < min_id) min_id = c2v_ids[v];
+        if (c2v_ids[v] > max_id) max_id = c2v_ids[v];
+        v_count[v] = 0;
+      }
+      cs_lnum_t  _range = max_id - min_id;
 
-    min_id = n_edges, max_id = 0;
-    for (short int e = 0; e < n_ec; e++) {
-      if (c2e_ids[e] < min_id) min_id = c2e_ids[e];
-      if (c2e_ids[e] > max_id) max_id = c2e_ids[e];
-    }
-    _range = max_id - min_id;
+      if (n_vc > n_max_vc) n_max_vc = n_vc;
+      if (v_max_range < _range) v_max_range = _range;
 
-    if (n_ec > n_max_ec) n_max_ec = n_ec;
-    if (connect->e_max_cell_range < _range)
-      connect->e_max_cell_range = _range;
+      /* Edges */
 
-    for (short int e = 0; e < n_ec; e++) {
+      const cs_lnum_t  *c2e_idx = c2e->idx + c_id;
+      const cs_lnum_t  *c2e_ids = c2e->ids + c2e_idx[0];
+      const int n_ec = c2e_idx[1] - c2e_idx[0];
 
-      const cs_lnum_t  *e2v_ids = e2v->ids + 2*c2e_ids[e];
+      min_id = n_edges, max_id = 0;
+      for (short int e = 0; e < n_ec; e++) {
+        if (c2e_ids[e] < min_id) min_id = c2e_ids[e];
+        if (c2e_ids[e] > max_id) max_id = c2e_ids[e];
+      }
+      _range = max_id - min_id;
 
-      v_count[e2v_ids[0]] += 1;
-      v_count[e2v_ids[1]] += 1;
+      if (n_ec > n_max_ec) n_max_ec = n_ec;
+      if (e_max_range < _range) e_max_range = _range;
 
-    }
+      for (short int e = 0; e < n_ec; e++) {
 
-    /* Update n_max_v2ec and reset v_count */
+        const cs_lnum_t  *e2v_ids = e2v->ids + 2*c2e_ids[e];
 
-    for (short int v = 0; v < n_vc; v++) {
+        v_count[_get_vtx_position(e2v_ids[0], h_mask, h_keys, h_pos)] += 1;
+        v_count[_get_vtx_position(e2v_ids[1], h_mask, h_keys, h_pos)] += 1;
 
-      const cs_lnum_t  v_id = c2v_ids[v];
-      if (v_count[v_id] > n_max_v2ec) n_max_v2ec = v_count[v_id];
-      v_count[v_id] = 0; /* reset */
+      }
 
-    }
+      /* Update n_max_v2ec and reset v_count */
 
-    const cs_lnum_t  *c2f_idx = connect->c2f->idx + c_id;
-    const cs_lnum_t  *c2f_ids = connect->c2f->ids + c2f_idx[0];
-    const int  n_fc = c2f_idx[1] - c2f_idx[0];
+      for (short int v = 0; v < n_vc; v++) {
+        if (v_count[v] > n_max_v2ec) n_max_v2ec = v_count[v];
+        v_count[v] = 0; /* reset */
+      }
 
-    if (n_fc > n_max_fc) n_max_fc = n_fc;
+      const cs_lnum_t  *c2f_idx = connect->c2f->idx + c_id;
+      const cs_lnum_t  *c2f_ids = connect->c2f->ids + c2f_idx[0];
+      const int  n_fc = c2f_idx[1] - c2f_idx[0];
 
-    for (short int f = 0; f < n_fc; f++) {
+      if (n_fc > n_max_fc) n_max_fc = n_fc;
 
-      const cs_lnum_t  f_id = c2f_ids[f];
-      if (f_id < m->n_i_faces) { /* Interior face */
+      for (short int f = 0; f < n_fc; f++) {
 
-        const cs_lnum_t  *f2v_idx = m->i_face_vtx_idx + f_id;
-        const cs_lnum_t  *f2v_ids = m->i_face_vtx_lst + f2v_idx[0];
-        const int  n_vf = f2v_idx[1] - f2v_idx[0];
-
-        if (n_vf > n_max_vf) n_max_vf = n_vf;
-        for (short int v = 0; v < n_vf; v++)
-          v_count[f2v_ids[v]] += 1;
+        const cs_lnum_t  f_id = c2f_ids[f];
 
-      }
-      else { /* Border face */
+        const cs_lnum_t  *f2v_idx = NULL, *f2v_lst = NULL;
+        if (f_id < m->n_i_faces) { /* Interior face */
+          f2v_idx = m->i_face_vtx_idx + f_id;
+          f2v_lst = m->i_face_vtx_lst;
+        }
+        else { /* Border face */
+          f2v_idx = m->b_face_vtx_idx + f_id - m->n_i_faces;
+          f2v_lst = m->b_face_vtx_lst;
+        }
 
-        const cs_lnum_t  *f2v_idx =
-          m->b_face_vtx_idx + f_id - m->n_i_faces;
-        const cs_lnum_t  *f2v_ids = m->b_face_vtx_lst + f2v_idx[0];
+        const cs_lnum_t  *f2v_ids = f2v_lst + f2v_idx[0];
         const int  n_vf = f2v_idx[1] - f2v_idx[0];
 
         if (n_vf > n_max_vf) n_max_vf = n_vf;
         for (short int v = 0; v < n_vf; v++)
-          v_count[f2v_ids[v]] += 1;
-
-      }
-
-    } /* Loop on cell faces */
+          v_count[_get_vtx_position(f2v_ids[v], h_mask, h_keys, h_pos)] += 1;
 
-    /* Update n_max_v2fc and reset v_count */
+      } /* Loop on cell faces */
 
-    for (short int v = 0; v < n_vc; v++) {
+      /* Update n_max_v2fc */
 
-      const cs_lnum_t  v_id = c2v_ids[v];
-      if (v_count[v_id] > n_max_v2fc) n_max_v2fc = v_count[v_id];
-      v_count[v_id] = 0; /* reset */
+      for (short int v = 0; v < n_vc; v++)
+        if (v_count[v] > n_max_v2fc) n_max_v2fc = v_count[v];
 
-    }
+    } /* Loop on cells */
 
-  } /* Loop on cells */
+    BFT_FREE(v_count);
+    BFT_FREE(h_keys);
+    BFT_FREE(h_pos);
 
-  BFT_FREE(v_count);
+  } /* OpenMP block */
 
   /* Store computed values */
 
@@ -507,6 +584,9 @@ _compute_max_ent(const cs_mesh_t      *m,
   connect->n_max_v2ec = n_max_v2ec;
   connect->n_max_v2fc = n_max_v2fc;
   connect->n_max_vbyf = n_max_vf;   /* Max number of vertices in a face */
+
+  connect->e_max_cell_range = e_max_range;
+  connect->v_max_cell_range = v_max_range;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -661,6 +741,7 @@ _build_cell_flag(cs_cdo_connect_t   *connect,
                            is_border_vtx);
 
     const cs_adjacency_t  *c2v = connect->c2v;
+#   pragma omp parallel for if (n_cells > CS_THR_MIN)
     for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
       for (cs_lnum_t j = c2v->idx[c_id]; j < c2v->idx[c_id+1]; j++) {
         if (is_border_vtx[c2v->ids[j]] > 0)
@@ -698,6 +779,7 @@ _build_cell_flag(cs_cdo_connect_t   *connect,
                            is_border_edge);
 
     const cs_adjacency_t  *c2e = connect->c2e;
+#   pragma omp parallel for if (n_cells > CS_THR_MIN)
     for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
       for (cs_lnum_t j = c2e->idx[c_id]; j < c2e->idx[c_id+1]; j++) {
         if (is_border_edge[c2e->ids[j]] > 0)
@@ -1146,7 +1228,7 @@ cs_cdo_connect_init(cs_mesh_t      *mesh,
   /* Build the cell type for each cell */
 
   BFT_MALLOC(connect->cell_type, n_cells, fvm_element_t);
-# pragma omp parallel if (n_cells > CS_THR_MIN)
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
   for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
     connect->cell_type[c_id] = _get_cell_type(c_id, connect);
 
@@ -1154,6 +1236,18 @@ cs_cdo_connect_init(cs_mesh_t      *mesh,
 
   _build_cell_flag(connect, eb_scheme_flag, vb_scheme_flag, vcb_scheme_flag);
 
+  /* Coloring of cells to assemble face-based systems with several threads
+     without any synchronization. Cells of the same type are gathered inside
+     each color. Only one color is needed without OpenMP threading. */
+
+  connect->f_colors = NULL;
+  if (cs_cdo_assembly_has_cell_coloring() && fb_scheme_flag > 0)
+    connect->f_colors =
+      cs_cdo_assembly_build_cell_coloring(connect->c2f,
+                                          (cs_glob_n_threads > 1) ?
+                                          connect->f2c : NULL,
+                                          connect->cell_type);
+
   /* Monitoring */
 
   cs_timer_t  t1 = cs_timer_time();
@@ -1195,6 +1289,7 @@ cs_cdo_connect_free(const cs_mesh_t    *mesh,
   cs_adjacency_destroy(&(connect->v2v));
   cs_adjacency_destroy(&(connect->f2f));
   cs_adjacency_destroy(&(connect->e2e));
+  cs_adjacency_destroy(&(connect->f_colors));
 
   BFT_FREE(connect->cell_type);
   BFT_FREE(connect->cell_flag);
@@ -1339,6 +1434,17 @@ cs_cdo_connect_summary(const cs_cdo_connect_t  *connect,
                 " --dim-- max. edge range for a cell:      %ld\n",
                 (long)n_max_entbyc[4]);
 
+  if (connect->f_colors != NULL) {
+
+    int  n_colors = connect->f_colors->n_elts;
+    cs_parall_max(1, CS_INT_TYPE, &n_colors);
+
+    cs_log_printf(CS_LOG_DEFAULT,
+                  " --dim-- max. number of cell colors (faces): %d\n",
+                  n_colors);
+
+  }
+
   /* Information about special case where vertices are lying on the boundary
      but not a face (for instance a tetrahedron) */
 
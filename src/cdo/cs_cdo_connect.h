@@ -138,6 +138,13 @@ typedef struct {
   cs_adjacency_t        *f2f;    /* face to faces through cells */
   cs_adjacency_t        *e2e;    /* edge to edges through cells */
 
+  /* Coloring of cells such that two cells of the same color do not share any
+     face (color --> cells). Inside a color, cells of the same type are
+     consecutive. Allocated only if an assembly by colors is requested for
+     face-based schemes */
+
+  cs_adjacency_t        *f_colors;
+
 } cs_cdo_connect_t;
 
 /*============================================================================
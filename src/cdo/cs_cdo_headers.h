@@ -78,6 +78,7 @@
 #include "cs_hho_stokes.h"
 #include "cs_hho_vecteq.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 #include "cs_iter_algo.h"
 #include "cs_maxwell.h"
 #include "cs_mesh_deform.h"
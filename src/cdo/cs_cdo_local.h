@@ -45,6 +45,11 @@ BEGIN_C_DECLS
  * Macro definitions
  *============================================================================*/
 
+/* Max. number of cells sharing the same topology which are built together
+   (one lane per cell) when a cellwise process is performed by batch */
+
+#define CS_CDO_CELL_BATCH_SIZE  8
+
 /*============================================================================
  * Type definitions
  *============================================================================*/
@@ -485,6 +485,11 @@ _solve_domain(cs_domain_t  *domain)
 
   cs_user_physical_properties(domain);
 
+  /* Refresh the cached evaluations of properties (if requested) at the end
+     of the time step (time used by implicit time schemes) */
+
+  cs_property_update_cached_values(ts->t_cur + ts->dt[0]);
+
   /* Solve predefined systems */
 
   if (cs_solidification_is_activated()) {
@@ -323,6 +323,67 @@ _assign_assembly_func(const cs_cdo_system_block_info_t   bi)
     return _set_block_assembly_func();
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set the assembly function associated to a block according to the
+ *        metadata of the block when cells are assembled by colors. Since two
+ *        cells of the same color never update the same row, the variants
+ *        without synchronization can be used even with several threads.
+ *
+ * \param[in] bi         block info structure to consider
+ *
+ * \return a pointer to a function or NULL if useless
+ */
+/*----------------------------------------------------------------------------*/
+
+static cs_cdo_assembly_func_t *
+_assign_colored_assembly_func(const cs_cdo_system_block_info_t   bi)
+{
+  /* Generic functions (used with HYPRE matrices) can be called in any
+     context */
+
+  if (bi.matrix_class == CS_CDO_SYSTEM_MATRIX_HYPRE)
+    return _assign_assembly_func(bi);
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {  /* Parallel */
+
+    if (bi.stride == 1)
+      return cs_cdo_assembly_matrix_mpis;
+    else if (bi.stride == 3) {
+
+      if (bi.unrolled)
+        return cs_cdo_assembly_eblock33_matrix_mpis;
+      else
+        return cs_cdo_assembly_block33_matrix_mpis;
+
+    }
+    else
+      return cs_cdo_assembly_eblock_matrix_mpis;
+
+  }
+#endif /* defined(HAVE_MPI) */
+
+  if (cs_glob_n_ranks <= 1) {  /* Sequential */
+
+    if (bi.stride == 1)
+      return cs_cdo_assembly_matrix_seqs;
+    else if (bi.stride == 3) {
+
+      if (bi.unrolled)
+        return cs_cdo_assembly_eblock33_matrix_seqs;
+      else
+        return cs_cdo_assembly_block33_matrix_seqs;
+
+    }
+    else
+      return cs_cdo_assembly_eblock_matrix_seqs;
+
+  }
+
+  return NULL; /* Case not handled */
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Set (and sometimes build) a cs_range_set_t structure and a
@@ -628,11 +689,21 @@ _build_no_interlaced_ma(int                      stride,
   cs_matrix_assembler_t  *ma = cs_matrix_assembler_create(rs->l_range,
                                                           sep_diag);
 
-  /* First loop to count the max. size of the temporary buffers */
+  /* First loop to count the max. size of the temporary buffers. Several
+     rows are gathered in the same buffer before being added. The buffer has
+     to hold at least one row (stride*stride*(n_entries+1) couples) */
 
   const cs_lnum_t  n_x = x2x->n_elts;
-  const cs_lnum_t  max_size = 512;
-  cs_gnum_t  grows[512], gcols[512];
+  cs_lnum_t  max_row_size = 0;
+  for (cs_lnum_t i = 0; i < n_x; i++)
+    max_row_size = CS_MAX(max_row_size, x2x->idx[i+1] - x2x->idx[i]);
+
+  const cs_lnum_t  max_size = CS_MAX(512,
+                                     stride*stride*(max_row_size + 1) + 1);
+
+  cs_gnum_t  *grows = NULL, *gcols = NULL;
+  BFT_MALLOC(grows, max_size, cs_gnum_t);
+  BFT_MALLOC(gcols, max_size, cs_gnum_t);
 
   if (stride == 1)  { /* Simplified version (equivalent to the interlaced
                          version) */
@@ -753,6 +824,11 @@ _build_no_interlaced_ma(int                      stride,
 
   cs_matrix_assembler_compute(ma);
 
+  /* Free temporary buffers */
+
+  BFT_FREE(grows);
+  BFT_FREE(gcols);
+
   return ma;
 }
 
@@ -1228,6 +1304,7 @@ cs_cdo_system_add_dblock(cs_cdo_system_helper_t       *sh,
     db->mav = NULL;
     db->assembly_func = _assign_assembly_func(b->info);
     db->slave_assembly_func = _assign_slave_assembly_func(b->info);
+    db->colored_assembly_func = _assign_colored_assembly_func(b->info);
 
     if (db->assembly_func == NULL && db->slave_assembly_func == NULL)
       bft_error(__FILE__, __LINE__, 0,
@@ -1669,6 +1746,46 @@ cs_cdo_system_get_matrix(const cs_cdo_system_helper_t  *sh,
   return m;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Detach the matrix associated to the block with id equal to block_id
+ *        from the system helper. The ownership of the matrix is transferred
+ *        to the caller which has to free it. Only default blocks are handled.
+ *        This is useful when the matrix is kept after the resolution (the
+ *        matrix structure of a default block may be shared with other
+ *        systems).
+ *
+ * \param[in, out] sh          pointer to the system helper structure
+ * \param[in]      block_id    id of the block to consider
+ *
+ * \return a pointer to a cs_matrix_t structure or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_matrix_t *
+cs_cdo_system_detach_matrix(cs_cdo_system_helper_t  *sh,
+                            int                      block_id)
+{
+  if (sh == NULL)
+    return NULL;
+  if (block_id < 0 || block_id >= sh->n_blocks)
+    return NULL;
+
+  cs_cdo_system_block_t  *b = sh->blocks[block_id];
+
+  if (b->type != CS_CDO_SYSTEM_BLOCK_DEFAULT)
+    bft_error(__FILE__, __LINE__, 0,
+              "%s: Only the case of a default block is handled.\n",
+              __func__);
+
+  cs_cdo_system_dblock_t  *db = b->block_pointer;
+  cs_matrix_t  *m = db->matrix;
+
+  db->matrix = NULL;
+
+  return m;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Retrieve the (sub-)matrix associated to a split block with id equal
@@ -1796,9 +1913,11 @@ cs_cdo_system_build_block(cs_cdo_system_helper_t  *sh,
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Allocate and initialize the matrix, rhs and the matrix assembler
- *        values. If p_rhs is NULL then one allocates the rhs inside this
- *        function. The ownership is transfered to this structure in that case.
+ * \brief Allocate and initialize only the rhs. This is useful when the
+ *        matrix is not assembled (for instance, when the matrix of another
+ *        system is used). If p_rhs is NULL then one allocates the rhs inside
+ *        this function. The ownership is transfered to this structure in that
+ *        case.
  *
  * \param[in, out] sh       pointer to a system helper structure
  * \param[in, out] p_rhs    double pointer to the RHS array to initialize
@@ -1806,14 +1925,12 @@ cs_cdo_system_build_block(cs_cdo_system_helper_t  *sh,
 /*----------------------------------------------------------------------------*/
 
 void
-cs_cdo_system_helper_init_system(cs_cdo_system_helper_t    *sh,
-                                 cs_real_t                **p_rhs)
+cs_cdo_system_helper_init_rhs(cs_cdo_system_helper_t    *sh,
+                              cs_real_t                **p_rhs)
 {
   if (sh == NULL)
     return;
 
-  /* Right-hand side */
-
   cs_real_t *rhs = *p_rhs;
   if (rhs == NULL) {
 
@@ -1839,6 +1956,29 @@ cs_cdo_system_helper_init_system(cs_cdo_system_helper_t    *sh,
     sh->rhs = rhs;
 
   cs_array_real_fill_zero(sh->full_rhs_size, sh->rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate and initialize the matrix, rhs and the matrix assembler
+ *        values. If p_rhs is NULL then one allocates the rhs inside this
+ *        function. The ownership is transfered to this structure in that case.
+ *
+ * \param[in, out] sh       pointer to a system helper structure
+ * \param[in, out] p_rhs    double pointer to the RHS array to initialize
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cdo_system_helper_init_system(cs_cdo_system_helper_t    *sh,
+                                 cs_real_t                **p_rhs)
+{
+  if (sh == NULL)
+    return;
+
+  /* Right-hand side */
+
+  cs_cdo_system_helper_init_rhs(sh, p_rhs);
 
   /* Initialize structures */
 
@@ -2061,8 +2201,10 @@ cs_cdo_system_helper_reset(cs_cdo_system_helper_t    *sh)
       {
         cs_cdo_system_dblock_t  *db = b->block_pointer;
 
-        cs_matrix_release_coefficients(db->matrix);
-        cs_matrix_destroy(&(db->matrix));
+        if (db->matrix != NULL) { /* May have been detached */
+          cs_matrix_release_coefficients(db->matrix);
+          cs_matrix_destroy(&(db->matrix));
+        }
       }
       break;
 
@@ -190,12 +190,18 @@ typedef struct {
    *      function pointer to operate the assembly stage when the system helper
    *      is declared as slave (this is the same for all matrices). Useful for
    *      coupled systems.
+   *
+   * \var colored_assembly_func
+   *      function pointer to operate the assembly stage when cells are
+   *      processed by colors, i.e. two threads never update the same row.
+   *      No synchronization is performed by this function.
    */
 
   cs_matrix_t                    *matrix;
   cs_matrix_assembler_values_t   *mav;
   cs_cdo_assembly_func_t         *assembly_func;
   cs_cdo_assembly_func_t         *slave_assembly_func;
+  cs_cdo_assembly_func_t         *colored_assembly_func;
 
   /* The following structures can be shared if the same block configuration
      is requested */
@@ -635,6 +641,26 @@ cs_matrix_t *
 cs_cdo_system_get_matrix(const cs_cdo_system_helper_t  *sh,
                          int                            block_id);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Detach the matrix associated to the block with id equal to block_id
+ *        from the system helper. The ownership of the matrix is transferred
+ *        to the caller which has to free it. Only default blocks are handled.
+ *        This is useful when the matrix is kept after the resolution (the
+ *        matrix structure of a default block may be shared with other
+ *        systems).
+ *
+ * \param[in, out] sh          pointer to the system helper structure
+ * \param[in]      block_id    id of the block to consider
+ *
+ * \return a pointer to a cs_matrix_t structure or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_matrix_t *
+cs_cdo_system_detach_matrix(cs_cdo_system_helper_t  *sh,
+                            int                      block_id);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Retrieve the (sub-)matrix associated to a split block with id equal
@@ -670,6 +696,23 @@ void
 cs_cdo_system_build_block(cs_cdo_system_helper_t  *sh,
                           int                      block_id);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate and initialize only the rhs. This is useful when the
+ *        matrix is not assembled (for instance, when the matrix of another
+ *        system is used). If p_rhs is NULL then one allocates the rhs inside
+ *        this function. The ownership is transfered to this structure in that
+ *        case.
+ *
+ * \param[in, out] sh       pointer to a system helper structure
+ * \param[in, out] p_rhs    double pointer to the RHS array to initialize
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cdo_system_helper_init_rhs(cs_cdo_system_helper_t    *sh,
+                              cs_real_t                **p_rhs);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Allocate and initialize the matrix, rhs and the matrix assembler
@@ -67,6 +67,9 @@
 #include "cs_navsto_sles.h"
 #include "cs_parall.h"
 #include "cs_saddle_itsol.h"
+#include "cs_sdm.h"
+#include "cs_search.h"
+#include "cs_sort.h"
 #include "cs_timer.h"
 
 #if defined(DEBUG) && !defined(NDEBUG)
@@ -998,26 +1001,23 @@ _invlumped_schur_approximation(const cs_navsto_param_t     *nsp,
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Define the matrix for an approximation of the Schur complement based
- *        on the inverse of the sum of the absolute values of the velocity
- *        block
+ * \brief Add the contribution of B.D.Bt to a matrix stored in a native format
+ *        (diagonal and extra-diagonal parts). D is a diagonal approximation
+ *        of the inverse of the velocity block given in a scatter view.
  *
- * \param[in]      nsp     pointer to a cs_navsto_param_t structure
- * \param[in]      ssys    pointer to a saddle-point system structure
- * \param[in, out] sbp     pointer to a cs_saddle_block_precond_t structure
+ * \param[in]      m11_inv     diagonal approximation of the inverse of m11
+ * \param[in, out] diag_smat   diagonal part of the matrix
+ * \param[in, out] xtra_smat   extra-diagonal part of the matrix
  */
 /*----------------------------------------------------------------------------*/
 
 static void
-_diag_schur_sbp(const cs_navsto_param_t       *nsp,
-                const cs_saddle_system_t      *ssys,
-                cs_saddle_block_precond_t     *sbp)
+_add_schur_diag_contrib(const cs_real_t      *m11_inv,
+                        cs_real_t            *diag_smat,
+                        cs_real_t            *xtra_smat)
 {
-  CS_NO_WARN_IF_UNUSED(nsp);
-
   const cs_cdo_quantities_t  *quant = cs_shared_quant;
   const cs_mesh_t  *mesh = cs_shared_mesh;
-  const cs_lnum_t  n_cells_ext = mesh->n_cells_with_ghosts;
   const cs_lnum_t  n_i_faces = mesh->n_i_faces;
   const cs_lnum_t  n_b_faces = mesh->n_b_faces;
   const cs_lnum_2_t *restrict i_face_cells
@@ -1025,43 +1025,11 @@ _diag_schur_sbp(const cs_navsto_param_t       *nsp,
   const cs_lnum_t *restrict b_face_cells
     = (const cs_lnum_t *restrict)mesh->b_face_cells;
 
-  const cs_lnum_t  b11_size = ssys->x1_size;
-
-  /* Synchronize the diagonal values for the block m11 */
-
-  const cs_matrix_t  *m11 = ssys->m11_matrices[0];
-  const cs_lnum_t  n_rows = cs_matrix_get_n_rows(m11);
-  const cs_real_t  *diag_m11 = cs_matrix_get_diagonal(m11);
-
-  cs_real_t  *inv_diag = NULL;
-  BFT_MALLOC(inv_diag, CS_MAX(b11_size, n_rows), cs_real_t);
-
-  /*  Operation in gather view (the default view for a matrix) */
-
-  for (cs_lnum_t i1 = 0; i1 < n_rows; i1++)
-    inv_diag[i1] = 1./diag_m11[i1];
-
-  cs_range_set_scatter(ssys->rset,
-                       CS_REAL_TYPE, 1, /* treated as scalar-valued up to now */
-                       inv_diag,        /* gathered view */
-                       inv_diag);       /* scatter view */
-
-  /* Native format for the Schur approximation matrix */
-
-  cs_real_t   *diag_smat = NULL;
-  cs_real_t   *xtra_smat = NULL;
-
-  BFT_MALLOC(diag_smat, n_cells_ext, cs_real_t);
-  BFT_MALLOC(xtra_smat, 2*n_i_faces, cs_real_t);
-
-  cs_array_real_fill_zero(n_cells_ext, diag_smat);
-  cs_array_real_fill_zero(2*n_i_faces, xtra_smat);
-
   /* Add diagonal and extra-diagonal contributions from interior faces */
 
   for (cs_lnum_t f_id = 0; f_id < n_i_faces; f_id++) {
 
-    const cs_real_t  *ia_ff = inv_diag + 3*f_id;
+    const cs_real_t  *ia_ff = m11_inv + 3*f_id;
     const cs_nvec3_t  nvf = cs_quant_set_face_nvec(f_id, quant);
 
     double  contrib = 0;
@@ -1073,7 +1041,8 @@ _diag_schur_sbp(const cs_navsto_param_t       *nsp,
        adjacency */
 
     cs_real_t  *_xtra_smat = xtra_smat + 2*f_id;
-    _xtra_smat[0] = _xtra_smat[1] = contrib;
+    _xtra_smat[0] += contrib;
+    _xtra_smat[1] += contrib;
 
     /* Diagonal contributions */
 
@@ -1087,7 +1056,7 @@ _diag_schur_sbp(const cs_navsto_param_t       *nsp,
 
   /* Add diagonal contributions from border faces*/
 
-  const cs_real_t  *diag_shift = inv_diag + 3*n_i_faces;
+  const cs_real_t  *diag_shift = m11_inv + 3*n_i_faces;
   for (cs_lnum_t f_id = 0; f_id < n_b_faces; f_id++) {
 
     const cs_real_t  *ia_ff = diag_shift + 3*f_id;
@@ -1105,8 +1074,30 @@ _diag_schur_sbp(const cs_navsto_param_t       *nsp,
     diag_smat[b_face_cells[f_id]] += contrib;
 
   } /* Loop on border faces */
+}
 
-  /* Return the associated matrix */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define the matrix used as an approximation of the Schur complement
+ *        in a block preconditioner from its native representation. The
+ *        arrays are kept in the cs_saddle_block_precond_t structure.
+ *
+ * \param[in]      nsp         pointer to a cs_navsto_param_t structure
+ * \param[in]      diag_smat   diagonal part of the matrix
+ * \param[in]      xtra_smat   extra-diagonal part of the matrix
+ * \param[in, out] sbp         pointer to a cs_saddle_block_precond_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_set_schur_matrix(const cs_navsto_param_t       *nsp,
+                  cs_real_t                     *diag_smat,
+                  cs_real_t                     *xtra_smat,
+                  cs_saddle_block_precond_t     *sbp)
+{
+  const cs_mesh_t  *mesh = cs_shared_mesh;
+  const cs_lnum_2_t *restrict i_face_cells
+    = (const cs_lnum_2_t *restrict)mesh->i_face_cells;
 
   /* One assumes a non-symmetric matrix even if in most (all?) cases the matrix
      should be symmetric */
@@ -1122,13 +1113,96 @@ _diag_schur_sbp(const cs_navsto_param_t       *nsp,
 
   cs_matrix_set_coefficients(sbp->schur_matrix, false, /* symmetry */
                              1, 1,
-                             n_i_faces, i_face_cells,
+                             mesh->n_i_faces, i_face_cells,
                              diag_smat, xtra_smat);
 
   /* Return arrays (to be freed when the algorithm is converged) */
 
   sbp->schur_diag = diag_smat;
   sbp->schur_xtra = xtra_smat;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build the matrix B.D.Bt used as an approximation of the Schur
+ *        complement in a block preconditioner. D is a diagonal approximation
+ *        of the inverse of the velocity block given in a scatter view.
+ *
+ * \param[in]      nsp       pointer to a cs_navsto_param_t structure
+ * \param[in]      m11_inv   diagonal approximation of the inverse of m11
+ * \param[in, out] sbp       pointer to a cs_saddle_block_precond_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_set_schur_sbp_matrix(const cs_navsto_param_t       *nsp,
+                      const cs_real_t               *m11_inv,
+                      cs_saddle_block_precond_t     *sbp)
+{
+  const cs_mesh_t  *mesh = cs_shared_mesh;
+  const cs_lnum_t  n_cells_ext = mesh->n_cells_with_ghosts;
+  const cs_lnum_t  n_i_faces = mesh->n_i_faces;
+
+  /* Native format for the Schur approximation matrix */
+
+  cs_real_t   *diag_smat = NULL;
+  cs_real_t   *xtra_smat = NULL;
+
+  BFT_MALLOC(diag_smat, n_cells_ext, cs_real_t);
+  BFT_MALLOC(xtra_smat, 2*n_i_faces, cs_real_t);
+
+  cs_array_real_fill_zero(n_cells_ext, diag_smat);
+  cs_array_real_fill_zero(2*n_i_faces, xtra_smat);
+
+  _add_schur_diag_contrib(m11_inv, diag_smat, xtra_smat);
+
+  /* Return the associated matrix */
+
+  _set_schur_matrix(nsp, diag_smat, xtra_smat, sbp);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define the matrix for an approximation of the Schur complement based
+ *        on the inverse of the sum of the absolute values of the velocity
+ *        block
+ *
+ * \param[in]      nsp     pointer to a cs_navsto_param_t structure
+ * \param[in]      ssys    pointer to a saddle-point system structure
+ * \param[in, out] sbp     pointer to a cs_saddle_block_precond_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_diag_schur_sbp(const cs_navsto_param_t       *nsp,
+                const cs_saddle_system_t      *ssys,
+                cs_saddle_block_precond_t     *sbp)
+{
+  const cs_lnum_t  b11_size = ssys->x1_size;
+
+  /* Synchronize the diagonal values for the block m11 */
+
+  const cs_matrix_t  *m11 = ssys->m11_matrices[0];
+  const cs_lnum_t  n_rows = cs_matrix_get_n_rows(m11);
+  const cs_real_t  *diag_m11 = cs_matrix_get_diagonal(m11);
+
+  cs_real_t  *inv_diag = NULL;
+  BFT_MALLOC(inv_diag, CS_MAX(b11_size, n_rows), cs_real_t);
+
+  /*  Operation in gather view (the default view for a matrix) */
+
+  for (cs_lnum_t i1 = 0; i1 < n_rows; i1++)
+    inv_diag[i1] = 1./diag_m11[i1];
+
+  cs_range_set_scatter(ssys->rset,
+                       CS_REAL_TYPE, 1, /* treated as scalar-valued up to now */
+                       inv_diag,        /* gathered view */
+                       inv_diag);       /* scatter view */
+
+  /* Build the Schur approximation matrix */
+
+  _set_schur_sbp_matrix(nsp, inv_diag, sbp);
+
   sbp->m11_inv_diag = inv_diag;
 }
 
@@ -1201,16 +1275,6 @@ _invlumped_schur_sbp(const cs_navsto_param_t       *nsp,
                      const cs_saddle_system_t      *ssys,
                      cs_saddle_block_precond_t     *sbp)
 {
-  const cs_cdo_quantities_t  *quant = cs_shared_quant;
-  const cs_mesh_t  *mesh = cs_shared_mesh;
-  const cs_lnum_t  n_cells_ext = mesh->n_cells_with_ghosts;
-  const cs_lnum_t  n_i_faces = mesh->n_i_faces;
-  const cs_lnum_t  n_b_faces = mesh->n_b_faces;
-  const cs_lnum_2_t *restrict i_face_cells
-    = (const cs_lnum_2_t *restrict)mesh->i_face_cells;
-  const cs_lnum_t *restrict b_face_cells
-    = (const cs_lnum_t *restrict)mesh->b_face_cells;
-
   const cs_lnum_t  b11_size = ssys->x1_size;
 
   /* Compute m11^-1 lumped */
@@ -1246,91 +1310,467 @@ _invlumped_schur_sbp(const cs_navsto_param_t       *nsp,
   BFT_FREE(rhs);
   cs_param_sles_free(&slesp0);
 
-  /* Native format for the Schur approximation matrix */
+  /* Build the Schur approximation matrix */
 
-  cs_real_t   *diag_smat = NULL;
-  cs_real_t   *xtra_smat = NULL;
+  _set_schur_sbp_matrix(nsp, inv_lumped, sbp);
 
-  BFT_MALLOC(diag_smat, n_cells_ext, cs_real_t);
-  BFT_MALLOC(xtra_smat, 2*n_i_faces, cs_real_t);
+  sbp->m11_inv_diag = inv_lumped;
+}
 
-  cs_array_real_fill_zero(n_cells_ext, diag_smat);
-  cs_array_real_fill_zero(2*n_i_faces, xtra_smat);
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Retrieve the cells sharing a face and the coefficients of the
+ *        divergence operator related to this face (i.e. |f|.n_f). The first
+ *        cell is associated to a positive sign and the second one (if any) to
+ *        a negative sign.
+ *
+ * \param[in]  f_id     face id (interior faces first, then border faces)
+ * \param[out] c_ids    ids of the adjacent cells (-1 if not relevant)
+ * \param[out] w        coefficients of the divergence operator
+ */
+/*----------------------------------------------------------------------------*/
 
-  /* Add diagonal and extra-diagonal contributions from interior faces */
+static inline void
+_get_face_div_coefs(cs_lnum_t      f_id,
+                    cs_lnum_t      c_ids[2],
+                    cs_real_t      w[3])
+{
+  const cs_mesh_t  *mesh = cs_shared_mesh;
+  const cs_nvec3_t  nvf = cs_quant_set_face_nvec(f_id, cs_shared_quant);
 
-  for (cs_lnum_t f_id = 0; f_id < n_i_faces; f_id++) {
+  for (int k = 0; k < 3; k++)
+    w[k] = nvf.meas*nvf.unitv[k];
 
-    const cs_real_t  *a_ff = inv_lumped + 3*f_id;
-    const cs_nvec3_t  nvf = cs_quant_set_face_nvec(f_id, quant);
+  if (f_id < mesh->n_i_faces) {
+    c_ids[0] = mesh->i_face_cells[f_id][0];
+    c_ids[1] = mesh->i_face_cells[f_id][1];
+  }
+  else {
+    c_ids[0] = mesh->b_face_cells[f_id - mesh->n_i_faces];
+    c_ids[1] = -1;
+  }
+}
 
-    double  contrib = 0;
-    for (int k = 0; k < 3; k++)
-      contrib += a_ff[k]*nvf.unitv[k]*nvf.unitv[k];
-    contrib *= -nvf.meas*nvf.meas;
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the dot product of two sparse rows. Column ids are sorted in
+ *        increasing order.
+ *
+ * \param[in] na      number of entries in the first row
+ * \param[in] a_ids   column ids of the first row
+ * \param[in] a_vals  values of the first row
+ * \param[in] nb      number of entries in the second row
+ * \param[in] b_ids   column ids of the second row
+ * \param[in] b_vals  values of the second row
+ *
+ * \return the value of the dot product
+ */
+/*----------------------------------------------------------------------------*/
 
-    /* Extra-diagonal contribution. This is scanned by the i_face_cells mesh
-       adjacency */
+static inline double
+_sparse_row_dot(cs_lnum_t          na,
+                const cs_lnum_t   *a_ids,
+                const cs_real_t   *a_vals,
+                cs_lnum_t          nb,
+                const cs_lnum_t   *b_ids,
+                const cs_real_t   *b_vals)
+{
+  double  dp = 0;
+  cs_lnum_t  ia = 0, ib = 0;
+
+  while (ia < na && ib < nb) {
+    if (a_ids[ia] < b_ids[ib])
+      ia++;
+    else if (a_ids[ia] > b_ids[ib])
+      ib++;
+    else {
+      dp += a_vals[ia]*b_vals[ib];
+      ia++, ib++;
+    }
+  }
 
-    cs_real_t  *_xtra_smat = xtra_smat + 2*f_id;
-    _xtra_smat[0] = _xtra_smat[1] = contrib;
+  return dp;
+}
 
-    /* Diagonal contributions */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute a sparse approximate inverse (SPAI) M of a matrix A in a
+ *        gather view. Row i of M has the sparsity pattern J_i of row i of A
+ *        restricted to the columns owned by the local rank and minimizes
+ *        ||e_i - A^t.m_i||_2, so that M.A is close to the identity. This
+ *        amounts to solving the small SPD system (A_J.A_J^t).m_i = A_J.e_i
+ *        where A_J gathers the rows of A related to J_i.
+ *
+ * \param[in]  a        pointer to the matrix to approximate
+ * \param[out] p_idx    index of the rows of M
+ * \param[out] p_ids    column ids of M (gather view, sorted by row)
+ * \param[out] p_vals   values of M
+ */
+/*----------------------------------------------------------------------------*/
 
-    cs_lnum_t cell_i = i_face_cells[f_id][0];
-    cs_lnum_t cell_j = i_face_cells[f_id][1];
+static void
+_compute_spai(const cs_matrix_t     *a,
+              cs_lnum_t            **p_idx,
+              cs_lnum_t            **p_ids,
+              cs_real_t            **p_vals)
+{
+  const cs_lnum_t  n_rows = cs_matrix_get_n_rows(a);
 
-    diag_smat[cell_i] -= contrib;
-    diag_smat[cell_j] -= contrib;
+  /* Local copy of the rows of A with column ids sorted in increasing order.
+     Each row owned by the local rank is complete so that no synchronization
+     is needed. */
 
-  } /* Loop on interior faces */
+  cs_lnum_t  *a_idx = NULL, *m_idx = NULL;
+  BFT_MALLOC(a_idx, n_rows + 1, cs_lnum_t);
+  BFT_MALLOC(m_idx, n_rows + 1, cs_lnum_t);
 
-  /* Add diagonal contributions from border faces*/
+  a_idx[0] = m_idx[0] = 0;
 
-  cs_real_t  *diag_shift = inv_lumped + 3*n_i_faces;
-  for (cs_lnum_t f_id = 0; f_id < n_b_faces; f_id++) {
+# pragma omp parallel if (n_rows > CS_THR_MIN)
+  {
+    cs_matrix_row_info_t  r;
+    cs_matrix_row_init(&r);
 
-    const cs_real_t  *a_ff = diag_shift + 3*f_id;
+#   pragma omp for
+    for (cs_lnum_t i = 0; i < n_rows; i++) {
 
-    cs_nvec3_t  nvf;
-    cs_nvec3(quant->b_face_normal + 3*f_id, &nvf);
+      cs_matrix_get_row(a, i, &r);
 
-    double  contrib = 0;
-    for (int k = 0; k < 3; k++)
-      contrib += a_ff[k]*nvf.unitv[k]*nvf.unitv[k];
-    contrib *= nvf.meas*nvf.meas;
+      cs_lnum_t  n_owned = 0;
+      for (cs_lnum_t j = 0; j < r.row_size; j++)
+        if (r.col_id[j] < n_rows)
+          n_owned++;
 
-    /* Diagonal contributions */
+      a_idx[i+1] = r.row_size;
+      m_idx[i+1] = n_owned;
 
-    diag_smat[b_face_cells[f_id]] += contrib;
+    } /* Loop on rows */
 
-  } /* Loop on border faces */
+    cs_matrix_row_finalize(&r);
+  }
 
-  /* Return the associated matrix */
+  int  n_max_ent = 0;
+  for (cs_lnum_t i = 0; i < n_rows; i++) {
+    n_max_ent = CS_MAX(n_max_ent, m_idx[i+1]);
+    a_idx[i+1] += a_idx[i];
+    m_idx[i+1] += m_idx[i];
+  }
 
-  /* One assumes a non-symmetric matrix even if in most (all?) cases the matrix
-     should be symmetric */
+  cs_lnum_t  *a_ids = NULL, *m_ids = NULL;
+  cs_real_t  *a_vals = NULL, *m_vals = NULL;
 
-  if (nsp->sles_param->schur_sles_param->solver_class ==
-      CS_PARAM_SLES_CLASS_HYPRE)
-    sbp->schur_matrix = cs_matrix_external("HYPRE_ParCSR",
-                                           false, /* symmetry */
-                                           1, 1);
-  else
-    sbp->schur_matrix = cs_matrix_msr(false, /* symmetry */
-                                      1, 1);
+  BFT_MALLOC(a_ids, a_idx[n_rows], cs_lnum_t);
+  BFT_MALLOC(a_vals, a_idx[n_rows], cs_real_t);
+  BFT_MALLOC(m_ids, m_idx[n_rows], cs_lnum_t);
+  BFT_MALLOC(m_vals, m_idx[n_rows], cs_real_t);
 
-  cs_matrix_set_coefficients(sbp->schur_matrix, false, /* symmetry */
-                             1, 1,
-                             n_i_faces, i_face_cells,
-                             diag_smat, xtra_smat);
+# pragma omp parallel if (n_rows > CS_THR_MIN)
+  {
+    cs_matrix_row_info_t  r;
+    cs_matrix_row_init(&r);
 
-  /* Return arrays (to be freed when the algorithm is converged) */
+#   pragma omp for
+    for (cs_lnum_t i = 0; i < n_rows; i++) {
 
-  sbp->schur_diag = diag_smat;
-  sbp->schur_xtra = xtra_smat;
+      cs_matrix_get_row(a, i, &r);
 
-  sbp->m11_inv_diag = inv_lumped;
+      cs_lnum_t  *_a_ids = a_ids + a_idx[i];
+      cs_real_t  *_a_vals = a_vals + a_idx[i];
+
+      memcpy(_a_ids, r.col_id, r.row_size*sizeof(cs_lnum_t));
+      memcpy(_a_vals, r.vals, r.row_size*sizeof(cs_real_t));
+
+      cs_sort_dcoupled_shell(0, r.row_size, _a_ids, _a_vals);
+
+      cs_lnum_t  shift = m_idx[i];
+      for (cs_lnum_t j = 0; j < r.row_size; j++)
+        if (_a_ids[j] < n_rows)
+          m_ids[shift++] = _a_ids[j];
+
+    } /* Loop on rows */
+
+    cs_matrix_row_finalize(&r);
+  }
+
+  /* Solve the normal equations related to each row of M */
+
+# pragma omp parallel if (n_rows > CS_THR_MIN)
+  {
+    cs_sdm_t  *g = cs_sdm_square_create(n_max_ent);
+    cs_real_t  *facto = NULL, *rhs = NULL, *dkk = NULL;
+
+    BFT_MALLOC(facto, n_max_ent*(n_max_ent + 1)/2, cs_real_t);
+    BFT_MALLOC(rhs, 2*n_max_ent, cs_real_t);
+    dkk = rhs + n_max_ent;
+
+#   pragma omp for
+    for (cs_lnum_t i = 0; i < n_rows; i++) {
+
+      const cs_lnum_t  n_ent = m_idx[i+1] - m_idx[i];
+      const cs_lnum_t  *j_ids = m_ids + m_idx[i];
+
+      cs_sdm_square_init(n_ent, g);
+
+      for (cs_lnum_t ka = 0; ka < n_ent; ka++) {
+
+        const cs_lnum_t  ra = j_ids[ka];
+        const cs_lnum_t  na = a_idx[ra+1] - a_idx[ra];
+        const cs_lnum_t  *ra_ids = a_ids + a_idx[ra];
+        const cs_real_t  *ra_vals = a_vals + a_idx[ra];
+
+        /* Right-hand side: entry (ra, i) of A */
+
+        int  k_i = cs_search_binary(na, i, ra_ids);
+        rhs[ka] = (k_i > -1) ? ra_vals[k_i] : 0.;
+
+        /* Gram matrix (symmetric) */
+
+        cs_real_t  *g_a = g->val + ka*n_ent;
+
+        g_a[ka] = 0;
+        for (cs_lnum_t k = 0; k < na; k++)
+          g_a[ka] += ra_vals[k]*ra_vals[k];
+
+        for (cs_lnum_t kb = ka + 1; kb < n_ent; kb++) {
+
+          const cs_lnum_t  rb = j_ids[kb];
+
+          g_a[kb] = _sparse_row_dot(na, ra_ids, ra_vals,
+                                    a_idx[rb+1] - a_idx[rb],
+                                    a_ids + a_idx[rb],
+                                    a_vals + a_idx[rb]);
+          g->val[kb*n_ent + ka] = g_a[kb];
+
+        }
+
+      } /* Loop on the entries of the row of M */
+
+      /* Scale the system to avoid any issue with the threshold used to
+         detect a small pivot */
+
+      double  g_max = 0;
+      for (cs_lnum_t ka = 0; ka < n_ent; ka++)
+        g_max = CS_MAX(g_max, g->val[ka*(n_ent + 1)]);
+
+      assert(g_max > 0);
+      const double  inv_g_max = 1./g_max;
+      for (cs_lnum_t ka = 0; ka < n_ent*n_ent; ka++)
+        g->val[ka] *= inv_g_max;
+      for (cs_lnum_t ka = 0; ka < n_ent; ka++)
+        rhs[ka] *= inv_g_max;
+
+      cs_sdm_ldlt_compute(g, facto, dkk);
+      cs_sdm_ldlt_solve(n_ent, facto, rhs, m_vals + m_idx[i]);
+
+    } /* Loop on rows */
+
+    BFT_FREE(facto);
+    BFT_FREE(rhs);
+    g = cs_sdm_free(g);
+  }
+
+  BFT_FREE(a_idx);
+  BFT_FREE(a_ids);
+  BFT_FREE(a_vals);
+
+  /* Return pointers */
+
+  *p_idx = m_idx;
+  *p_ids = m_ids;
+  *p_vals = m_vals;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Add the contribution of the extra-diagonal entries of M to the
+ *        matrix B.M.Bt stored in a native format (diagonal and extra-diagonal
+ *        parts). M is given row by row in a gather view. An entry coupling two
+ *        cells which are not face neighbours does not fit this pattern and is
+ *        discarded.
+ *
+ * \param[in]      rset        pointer to a range set structure
+ * \param[in]      n_rows      number of rows of M
+ * \param[in]      m_idx       index of the rows of M
+ * \param[in]      m_ids       column ids of M
+ * \param[in]      m_vals      values of M
+ * \param[in, out] diag_smat   diagonal part of the matrix
+ * \param[in, out] xtra_smat   extra-diagonal part of the matrix
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_add_schur_xtra_contrib(const cs_range_set_t    *rset,
+                        cs_lnum_t                n_rows,
+                        const cs_lnum_t         *m_idx,
+                        const cs_lnum_t         *m_ids,
+                        const cs_real_t         *m_vals,
+                        cs_real_t               *diag_smat,
+                        cs_real_t               *xtra_smat)
+{
+  const cs_mesh_t  *mesh = cs_shared_mesh;
+  const cs_lnum_t  n_i_faces = mesh->n_i_faces;
+  const cs_lnum_2_t *restrict i_face_cells
+    = (const cs_lnum_2_t *restrict)mesh->i_face_cells;
+
+  /* Build the mapping from the gather view to the scatter view. A DoF is
+     located by its face id (s/3) and its component (s%3). */
+
+  cs_lnum_t  *g2s = NULL;
+  BFT_MALLOC(g2s, n_rows, cs_lnum_t);
+
+  if (rset == NULL) {
+    for (cs_lnum_t i = 0; i < n_rows; i++)
+      g2s[i] = i;
+  }
+  else {
+    for (cs_lnum_t i = 0; i < n_rows; i++)
+      g2s[i] = -1;
+
+    for (cs_lnum_t i = 0; i < rset->n_elts[1]; i++) {
+      const cs_gnum_t  g_id = rset->g_id[i];
+      if (g_id >= rset->l_range[0] && g_id < rset->l_range[1]) {
+        const cs_lnum_t  r_id = g_id - rset->l_range[0];
+        if (g2s[r_id] < 0)
+          g2s[r_id] = i;
+      }
+    }
+  }
+
+  for (cs_lnum_t i = 0; i < n_rows; i++) {
+
+    assert(g2s[i] > -1);
+    const cs_lnum_t  f_i = g2s[i]/3, k_i = g2s[i]%3;
+
+    cs_lnum_t  c_i[2];
+    cs_real_t  w_i[3];
+
+    _get_face_div_coefs(f_i, c_i, w_i);
+
+    for (cs_lnum_t j = m_idx[i]; j < m_idx[i+1]; j++) {
+
+      if (m_ids[j] == i)
+        continue; /* Already taken into account with the diagonal part */
+
+      const cs_lnum_t  f_j = g2s[m_ids[j]]/3, k_j = g2s[m_ids[j]]%3;
+
+      cs_lnum_t  c_j[2];
+      cs_real_t  w_j[3];
+
+      _get_face_div_coefs(f_j, c_j, w_j);
+
+      const double  t = w_i[k_i]*m_vals[j]*w_j[k_j];
+
+      for (int a = 0; a < 2 && c_i[a] > -1; a++) {
+        for (int b = 0; b < 2 && c_j[b] > -1; b++) {
+
+          const cs_lnum_t  c1 = c_i[a], c2 = c_j[b];
+          const double  val = (a == b) ? t : -t;
+
+          if (c1 == c2) {
+            diag_smat[c1] += val;
+            continue;
+          }
+
+          /* Look for a face shared by c1 and c2 among f_i and f_j */
+
+          cs_lnum_t  e_id = -1;
+          if (f_i < n_i_faces && (c_i[1-a] == c2))
+            e_id = f_i;
+          else if (f_j < n_i_faces && (c_j[1-b] == c1))
+            e_id = f_j;
+
+          if (e_id < 0) /* Not a face neighbour: entry is discarded */
+            continue;
+
+          if (i_face_cells[e_id][0] == c1)
+            xtra_smat[2*e_id] += val;
+          else
+            xtra_smat[2*e_id + 1] += val;
+
+        } /* Cells sharing f_j */
+      } /* Cells sharing f_i */
+
+    } /* Loop on the entries of the row */
+
+  } /* Loop on rows */
+
+  BFT_FREE(g2s);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define the matrix for an approximation of the Schur complement based
+ *        on a sparse approximate inverse (SPAI) M of the velocity block with
+ *        the sparsity pattern of the velocity block (see \ref _compute_spai).
+ *        The matrix B.M.Bt is assembled with the face-neighbour pattern of
+ *        the other Schur approximations. Couplings between cells which are
+ *        not face neighbours are discarded. Rows and columns of M are
+ *        restricted to the DoFs owned by the local rank.
+ *
+ * \param[in]      nsp     pointer to a cs_navsto_param_t structure
+ * \param[in]      ssys    pointer to a saddle-point system structure
+ * \param[in, out] sbp     pointer to a cs_saddle_block_precond_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_spai_schur_sbp(const cs_navsto_param_t       *nsp,
+                const cs_saddle_system_t      *ssys,
+                cs_saddle_block_precond_t     *sbp)
+{
+  const cs_mesh_t  *mesh = cs_shared_mesh;
+  const cs_lnum_t  n_cells_ext = mesh->n_cells_with_ghosts;
+  const cs_lnum_t  n_i_faces = mesh->n_i_faces;
+  const cs_lnum_t  b11_size = ssys->x1_size;
+  const cs_matrix_t  *m11 = ssys->m11_matrices[0];
+  const cs_lnum_t  n_rows = cs_matrix_get_n_rows(m11);
+
+  cs_lnum_t  *m_idx = NULL, *m_ids = NULL;
+  cs_real_t  *m_vals = NULL;
+
+  _compute_spai(m11, &m_idx, &m_ids, &m_vals);
+
+  /* Diagonal of M in a scatter view. Faces which are not owned by the local
+     rank get the diagonal entry computed by their owner. */
+
+  cs_real_t  *spai_diag = NULL;
+  BFT_MALLOC(spai_diag, CS_MAX(b11_size, n_rows), cs_real_t);
+
+# pragma omp parallel for if (n_rows > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n_rows; i++) {
+    const cs_lnum_t  n_ent = m_idx[i+1] - m_idx[i];
+    int  k_i = cs_search_binary(n_ent, i, m_ids + m_idx[i]);
+    assert(k_i > -1);
+    spai_diag[i] = m_vals[m_idx[i] + k_i];
+  }
+
+  cs_range_set_scatter(ssys->rset,
+                       CS_REAL_TYPE, 1, /* treated as scalar-valued up to now */
+                       spai_diag,       /* gathered view */
+                       spai_diag);      /* scatter view */
+
+  /* Build the Schur approximation matrix */
+
+  cs_real_t   *diag_smat = NULL;
+  cs_real_t   *xtra_smat = NULL;
+
+  BFT_MALLOC(diag_smat, n_cells_ext, cs_real_t);
+  BFT_MALLOC(xtra_smat, 2*n_i_faces, cs_real_t);
+
+  cs_array_real_fill_zero(n_cells_ext, diag_smat);
+  cs_array_real_fill_zero(2*n_i_faces, xtra_smat);
+
+  _add_schur_diag_contrib(spai_diag, diag_smat, xtra_smat);
+  _add_schur_xtra_contrib(ssys->rset, n_rows, m_idx, m_ids, m_vals,
+                          diag_smat, xtra_smat);
+
+  _set_schur_matrix(nsp, diag_smat, xtra_smat, sbp);
+
+  sbp->m11_inv_diag = spai_diag;
+
+  BFT_FREE(m_idx);
+  BFT_FREE(m_ids);
+  BFT_FREE(m_vals);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1384,6 +1824,9 @@ _schur_approximation(const cs_navsto_param_t       *nsp,
     _scaled_mass_sbp(nsp, ssys, sbp);
     _invlumped_schur_sbp(nsp, ssys, sbp);
     break;
+  case CS_PARAM_SCHUR_SPAI_INVERSE:
+    _spai_schur_sbp(nsp, ssys, sbp);
+    break;
 
   default:
     bft_error(__FILE__, __LINE__, 0,
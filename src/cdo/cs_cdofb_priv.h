@@ -33,6 +33,7 @@
 #include "cs_equation_bc.h"
 #include "cs_equation_builder.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 
 /*----------------------------------------------------------------------------*/
 
@@ -82,6 +83,7 @@ struct  _cs_cdofb_t {
 
   cs_hodge_t               **diffusion_hodge;
   cs_hodge_compute_t        *get_stiffness_matrix;
+  cs_hodge_cache_t          *stiffness_cache;   /* NULL if not used */
   cs_cdo_enforce_bc_t       *enforce_dirichlet;
   cs_cdo_enforce_bc_t       *enforce_robin_bc;
   cs_cdo_enforce_bc_t       *enforce_sliding;
@@ -103,6 +105,7 @@ struct  _cs_cdofb_t {
   cs_hodge_param_t           mass_hodgep;
   cs_hodge_t               **mass_hodge;
   cs_hodge_compute_t        *get_mass_matrix;
+  cs_hodge_cache_t          *mass_cache;        /* NULL if not used */
 
 };
 
@@ -53,6 +53,7 @@
 #include "cs_equation_builder.h"
 #include "cs_evaluate.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 #include "cs_log.h"
 #include "cs_math.h"
 #include "cs_mesh_location.h"
@@ -103,6 +104,14 @@ BEGIN_C_DECLS
 static cs_cell_sys_t      **cs_cdofb_cell_sys = NULL;
 static cs_cell_builder_t  **cs_cdofb_cell_bld = NULL;
 
+/* Additional cellwise views of the mesh and of the system used to build a
+   batch of cells before their static condensation. Lane 0 relies on the
+   structures of the thread so that the size is
+   n_threads * (CS_CDO_CELL_BATCH_SIZE - 1) */
+
+static cs_cell_mesh_t     **cs_cdofb_batch_cm = NULL;
+static cs_cell_sys_t      **cs_cdofb_batch_sys = NULL;
+
 /* Pointer to shared structures */
 
 static const cs_cdo_quantities_t    *cs_shared_quant;
@@ -292,7 +301,8 @@ _sfb_conv_diff_reac(const cs_equation_param_t     *eqp,
 
     /* Build the mass matrix and store it in mass_hodge->matrix */
 
-    eqc->get_mass_matrix(cm, mass_hodge, cb);
+    cs_hodge_cache_compute(eqc->mass_cache, eqc->get_mass_matrix,
+                           cm, mass_hodge, cb, mass_hodge->matrix);
 
 #if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
     if (cs_dbg_cw_test(eqp, cm, csys)) {
@@ -314,9 +324,10 @@ _sfb_conv_diff_reac(const cs_equation_param_t     *eqp,
                                      diff_hodge);
 
     /* Define the local stiffness matrix: local matrix owned by the cellwise
-       builder (store in cb->loc) */
+       builder (store in cb->loc). Retrieved from the cache if possible */
 
-    eqc->get_stiffness_matrix(cm, diff_hodge, cb);
+    cs_hodge_cache_compute(eqc->stiffness_cache, eqc->get_stiffness_matrix,
+                           cm, diff_hodge, cb, cb->loc);
 
     /* Add the local diffusion operator to the local system */
 
@@ -607,17 +618,33 @@ _sfb_assemble(const cs_cell_sys_t         *csys,
   assert(block->type == CS_CDO_SYSTEM_BLOCK_DEFAULT);
   cs_cdo_system_dblock_t  *db = block->block_pointer;
 
-  /* Matrix assembly */
+  if (cs_shared_connect->f_colors != NULL) {
 
-  db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
+    /* Cells are processed by colors: two threads never update the same row
+       so that there is no need for a synchronization */
 
-  /* RHS assembly (only on faces since a static condensation has been performed
-     to reduce the size) so that n_dofs = n_fc */
+    db->colored_assembly_func(csys->mat, csys->dof_ids, db->range_set, asb,
+                              db->mav);
 
-# pragma omp critical
-  {
     for (short int f = 0; f < csys->n_dofs; f++)
       rhs[csys->dof_ids[f]] += csys->rhs[f];
+
+  }
+  else {
+
+    /* Matrix assembly */
+
+    db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
+
+    /* RHS assembly (only on faces since a static condensation has been
+       performed to reduce the size) so that n_dofs = n_fc */
+
+#   pragma omp critical
+    {
+      for (short int f = 0; f < csys->n_dofs; f++)
+        rhs[csys->dof_ids[f]] += csys->rhs[f];
+    }
+
   }
 
   if (eqc->source_terms != NULL) { /* Source term */
@@ -651,20 +678,750 @@ _update_cell_fields(cs_timer_counter_t      *tce,
 
   /* Copy current field values to previous values */
 
-  if (cur2prev)
-    cs_field_current_to_previous(fld);
+  if (cur2prev)
+    cs_field_current_to_previous(fld);
+
+  /* Compute values at cells pc from values at faces pf
+     pc = acc^-1*(RHS - Acf*pf) */
+
+  cs_static_condensation_recover_scalar(cs_shared_connect->c2f,
+                                        eqc->rc_tilda,
+                                        eqc->acf_tilda,
+                                        eqc->face_values,
+                                        fld->val);
+
+  cs_timer_t  t1 = cs_timer_time();
+  cs_timer_counter_add_diff(tce, &t0, &t1);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Retrieve the cellwise views of the mesh and of the system related
+ *          to each lane of a batch of cells for the current thread
+ *
+ * \param[in]      t_id    id of the current thread
+ * \param[in, out] b_cm    cellwise views of the mesh (one by lane)
+ * \param[in, out] b_sys   cellwise views of the system (one by lane)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_sfb_get_batch_views(int                 t_id,
+                     cs_cell_mesh_t     *b_cm[],
+                     cs_cell_sys_t      *b_sys[])
+{
+  const int  n_extra = CS_CDO_CELL_BATCH_SIZE - 1;
+
+  b_cm[0] = cs_cdo_local_get_cell_mesh(t_id);
+  b_sys[0] = cs_cdofb_cell_sys[t_id];
+
+  for (int l = 1; l < CS_CDO_CELL_BATCH_SIZE; l++) {
+    b_cm[l] = cs_cdofb_batch_cm[t_id*n_extra + l-1];
+    b_sys[l] = cs_cdofb_batch_sys[t_id*n_extra + l-1];
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Define the end of a batch of cells starting at the position s in
+ *          the list of cells to build. A batch gathers at most
+ *          CS_CDO_CELL_BATCH_SIZE consecutive cells with the same number of
+ *          faces. Cells of the same type are consecutive inside a color so
+ *          that batches are full in most cases.
+ *
+ * \param[in]  c2f      cell --> faces adjacency
+ * \param[in]  colors   list of cells by color or NULL (cell ids)
+ * \param[in]  s        position of the first cell of the batch
+ * \param[in]  e        position after the last cell which can be used
+ *
+ * \return the position after the last cell of the batch
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline cs_lnum_t
+_sfb_batch_end(const cs_adjacency_t   *c2f,
+               const cs_adjacency_t   *colors,
+               cs_lnum_t               s,
+               cs_lnum_t               e)
+{
+  const cs_lnum_t  be = CS_MIN(s + CS_CDO_CELL_BATCH_SIZE, e);
+  const cs_lnum_t  c_id = (colors == NULL) ? s : colors->ids[s];
+  const cs_lnum_t  n_fc = c2f->idx[c_id+1] - c2f->idx[c_id];
+
+  cs_lnum_t  i = s + 1;
+  for (; i < be; i++) {
+    const cs_lnum_t  _c_id = (colors == NULL) ? i : colors->ids[i];
+    if (c2f->idx[_c_id+1] - c2f->idx[_c_id] != n_fc)
+      break;
+  }
+
+  return i;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Perform the static condensation of a batch of local systems
+ *          related to cells with the same number of faces. The condensation
+ *          is performed for all the cells of the batch at once. Then, apply
+ *          the remaining part of the boundary conditions and assemble each
+ *          local system.
+ *
+ * \param[in]      n_lanes     number of cells in the batch
+ * \param[in]      eqp         pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb         pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc         context for this kind of discretization
+ * \param[in, out] diff_hodge  pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm          pointer to a facewise view of the mesh
+ * \param[in]      b_cm        cellwise views of the mesh (one by lane)
+ * \param[in, out] b_sys       cellwise views of the system (one by lane)
+ * \param[in, out] cb          pointer to a cellwise builder
+ * \param[in, out] asb         pointer to a cs_cdo_assembly_t structure
+ * \param[in, out] rhs         right-hand side array
+ *
+ * \return the contribution of the cells to the normalization of the RHS
+ */
+/*----------------------------------------------------------------------------*/
+
+static double
+_sfb_condense_and_assemble(int                         n_lanes,
+                           const cs_equation_param_t  *eqp,
+                           cs_equation_builder_t      *eqb,
+                           cs_cdofb_scaleq_t          *eqc,
+                           cs_hodge_t                 *diff_hodge,
+                           cs_face_mesh_t             *fm,
+                           cs_cell_mesh_t             *b_cm[],
+                           cs_cell_sys_t              *b_sys[],
+                           cs_cell_builder_t          *cb,
+                           cs_cdo_assembly_t          *asb,
+                           cs_real_t                  *rhs)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  cs_cdo_system_helper_t  *sh = eqb->system_helper;
+
+  /* STATIC CONDENSATION
+   * ===================
+   * Static condensation of the local system matrices of size n_fc + 1 into
+   * matrices of size n_fc.
+   * Store data in rc_tilda and acf_tilda to compute the values at cell
+   * centers after solving the system */
+
+  cs_static_condensation_scalar_eq_batch(connect->c2f,
+                                         eqc->rc_tilda, eqc->acf_tilda,
+                                         n_lanes, cb, b_sys);
+
+  double  rhs_norm = 0.;
+
+  for (int l = 0; l < n_lanes; l++) {
+
+    const cs_cell_mesh_t  *cm = b_cm[l];
+    cs_cell_sys_t  *csys = b_sys[l];
+
+    /* The cellwise builder is shared by the lanes */
+
+    cb->cell_flag = connect->cell_flag[cm->c_id];
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
+    if (cs_dbg_cw_test(eqp, cm, csys))
+      cs_cell_sys_dump(">> Cell system matrix after static condensation",
+                       csys);
+#endif
+
+    /* Remaining part of BOUNDARY CONDITIONS
+     * ===================================== */
+
+    _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
+    if (cs_dbg_cw_test(eqp, cm, csys))
+      cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
+#endif
+
+    /* Compute a cellwise norm of the RHS for the normalization of the
+       residual during the resolution of the linear system */
+
+    rhs_norm +=
+      _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type, cm, csys);
+
+    /* ASSEMBLY PROCESS
+     * ================ */
+
+    _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+
+  } /* Loop on lanes */
+
+  return rhs_norm;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell and assemble it when one
+ *          interpolates a given cell-based array.
+ *
+ * \param[in]      c_id         id of the cell to process
+ * \param[in]      eqp          pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb          pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc          context for this kind of discretization
+ * \param[in]      cell_values  array of values to interpolate
+ * \param[in]      val_f_pre    face values used as the previous state
+ * \param[in]      val_c_pre    cell values used as the previous state
+ * \param[in, out] mass_hodge   pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge   pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm           pointer to a facewise view of the mesh
+ * \param[in, out] cm           pointer to a cellwise view of the mesh
+ * \param[in, out] csys         pointer to a cellwise view of the system
+ * \param[in, out] cb           pointer to a cellwise builder
+ * \param[in, out] asb          pointer to a cs_cdo_assembly_t structure
+ * \param[in, out] rhs          right-hand side array
+ *
+ * \return the contribution of the cell to the normalization of the RHS
+ */
+/*----------------------------------------------------------------------------*/
+
+static double
+_sfb_interpolate_cw_build(cs_lnum_t                   c_id,
+                          const cs_equation_param_t  *eqp,
+                          cs_equation_builder_t      *eqb,
+                          cs_cdofb_scaleq_t          *eqc,
+                          const cs_real_t            *cell_values,
+                          const cs_real_t            *val_f_pre,
+                          const cs_real_t            *val_c_pre,
+                          cs_hodge_t                 *mass_hodge,
+                          cs_hodge_t                 *diff_hodge,
+                          cs_face_mesh_t             *fm,
+                          cs_cell_mesh_t             *cm,
+                          cs_cell_sys_t              *csys,
+                          cs_cell_builder_t          *cb,
+                          cs_cdo_assembly_t          *asb,
+                          cs_real_t                  *rhs)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+  cs_cdo_system_helper_t  *sh = eqb->system_helper;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
+                        csys, cb);
+
+  /* Build and add the diffusion/advection/reaction term to the local
+     system. */
+
+  _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
+
+  if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
+                                                * =========== */
+
+    /* Reset the local contribution */
+
+    memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
+
+    /* Source term contribution to the algebraic system
+       If the equation is steady, the source term has already been computed
+       and is added to the right-hand side during its initialization. */
+
+    cs_source_term_compute_cellwise(eqp->n_source_terms,
+                (cs_xdef_t *const *)eqp->source_terms,
+                                    cm,
+                                    eqb->source_mask,
+                                    eqb->compute_source,
+                                    cb->t_st_eval,
+                                    mass_hodge,
+                                    cb,
+                                    csys->source);
+
+    csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
+
+  } /* End of term source */
+
+  /* BOUNDARY CONDITIONS + CONDENSATION
+   * ================================== */
+
+  /* Apply a part of BC before the condensation */
+
+  _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+  { /* Reduce the system size since one has the knowledge of the cell
+       value */
+
+    /* Reshape the local system */
+
+    for (short int i = 0; i < cm->n_fc; i++) {
+
+      double  *old_i = csys->mat->val + csys->n_dofs*i;   /* Old "i" row  */
+      double  *new_i = csys->mat->val + cm->n_fc*i;       /* New "i" row */
+
+      for (short int j = 0; j < cm->n_fc; j++)
+        new_i[j] = old_i[j];
+
+      /* Update RHS: RHS = RHS - Afc*pc */
+
+      csys->rhs[i] -= cell_values[csys->c_id] * old_i[cm->n_fc];
+
+    }
+
+    csys->n_dofs = cm->n_fc;
+    csys->mat->n_rows = csys->mat->n_cols = cm->n_fc;
+
+  }
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> Cell system matrix after condensation",
+                     csys);
+#endif
+
+  /* Remaining part of boundary conditions */
+
+  _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
+#endif
+
+  /* Compute a cellwise norm of the RHS for the normalization of the
+     residual during the resolution of the linear system */
+
+  const double  rhs_norm =
+    _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type, cm, csys);
+
+  /* ASSEMBLY PROCESS
+   * ================ */
+
+  _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+
+  return rhs_norm;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell for a steady-state equation.
+ *          One stops before the static condensation which is performed
+ *          by batch of cells in _sfb_condense_and_assemble()
+ *
+ * \param[in]      c_id        id of the cell to process
+ * \param[in]      eqp         pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb         pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc         context for this kind of discretization
+ * \param[in]      val_f_pre   face values used as the previous state
+ * \param[in]      val_c_pre   cell values used as the previous state
+ * \param[in, out] mass_hodge  pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge  pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm          pointer to a facewise view of the mesh
+ * \param[in, out] cm          pointer to a cellwise view of the mesh
+ * \param[in, out] csys        pointer to a cellwise view of the system
+ * \param[in, out] cb          pointer to a cellwise builder
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_sfb_steady_cw_build(cs_lnum_t                   c_id,
+                     const cs_equation_param_t  *eqp,
+                     cs_equation_builder_t      *eqb,
+                     cs_cdofb_scaleq_t          *eqc,
+                     const cs_real_t            *val_f_pre,
+                     const cs_real_t            *val_c_pre,
+                     cs_hodge_t                 *mass_hodge,
+                     cs_hodge_t                 *diff_hodge,
+                     cs_face_mesh_t             *fm,
+                     cs_cell_mesh_t             *cm,
+                     cs_cell_sys_t              *csys,
+                     cs_cell_builder_t          *cb)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
+                        csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
+
+  if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
+                                                * =========== */
+
+    /* Reset the local contribution */
+
+    memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
+
+    /* Source term contribution to the algebraic system
+       If the equation is steady, the source term has already been computed
+       and is added to the right-hand side during its initialization. */
+
+    cs_source_term_compute_cellwise(eqp->n_source_terms,
+                (cs_xdef_t *const *)eqp->source_terms,
+                                    cm,
+                                    eqb->source_mask,
+                                    eqb->compute_source,
+                                    cb->t_st_eval,
+                                    mass_hodge,
+                                    cb,
+                                    csys->source);
+
+    csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
+
+  } /* End of term source */
+
+  /* BOUNDARY CONDITIONS
+   * =================== */
+
+  /* Apply a part of BC before the static condensation */
+
+  _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell for an unsteady equation with
+ *          an implicit Euler time scheme. One stops before the static
+ *          condensation which is performed by batch of cells in
+ *          _sfb_condense_and_assemble()
+ *
+ * \param[in]      c_id        id of the cell to process
+ * \param[in]      eqp         pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb         pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc         context for this kind of discretization
+ * \param[in]      val_f_pre   face values used as the previous state
+ * \param[in]      val_c_pre   cell values used as the previous state
+ * \param[in]      time_eval   time at which one evaluates quantities
+ * \param[in]      inv_dtcur   inverse of the current time step
+ * \param[in, out] mass_hodge  pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge  pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm          pointer to a facewise view of the mesh
+ * \param[in, out] cm          pointer to a cellwise view of the mesh
+ * \param[in, out] csys        pointer to a cellwise view of the system
+ * \param[in, out] cb          pointer to a cellwise builder
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_sfb_implicit_cw_build(cs_lnum_t                   c_id,
+                       const cs_equation_param_t  *eqp,
+                       cs_equation_builder_t      *eqb,
+                       cs_cdofb_scaleq_t          *eqc,
+                       const cs_real_t            *val_f_pre,
+                       const cs_real_t            *val_c_pre,
+                       cs_real_t                   time_eval,
+                       cs_real_t                   inv_dtcur,
+                       cs_hodge_t                 *mass_hodge,
+                       cs_hodge_t                 *diff_hodge,
+                       cs_face_mesh_t             *fm,
+                       cs_cell_mesh_t             *cm,
+                       cs_cell_sys_t              *csys,
+                       cs_cell_builder_t          *cb)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
+                        csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
+
+  if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
+                                                * =========== */
+
+    /* Reset the local contribution */
+
+    memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
+
+    /* Source term contribution to the algebraic system
+       If the equation is steady, the source term has already been computed
+       and is added to the right-hand side during its initialization. */
+
+    cs_source_term_compute_cellwise(eqp->n_source_terms,
+                (cs_xdef_t *const *)eqp->source_terms,
+                                    cm,
+                                    eqb->source_mask,
+                                    eqb->compute_source,
+                                    time_eval,
+                                    mass_hodge,
+                                    cb,
+                                    csys->source);
+
+    csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
+
+  } /* End of term source */
+
+  /* First part of the BOUNDARY CONDITIONS
+   *                   ===================
+   * Apply a part of BC before the time scheme */
+
+  _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+  /* UNSTEADY TERM + TIME SCHEME
+   * =========================== */
+
+  if (!(eqb->time_pty_uniform))
+    cb->tpty_val = cs_property_value_in_cell(cm,
+                                             eqp->time_property,
+                                             time_eval);
+
+  if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping
+                                                  or Hodge-Voronoi */
+
+    const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+
+    /* Simply add an entry in mat[cell, cell] */
+
+    csys->rhs[cm->n_fc] += ptyc * csys->val_n[cm->n_fc];
+    csys->mat->val[cm->n_fc*csys->n_dofs + cm->n_fc] += ptyc;
+
+  }
+  else { /* Use the mass matrix */
+
+    const double  tpty_coef = cb->tpty_val * inv_dtcur;
+    const cs_sdm_t  *mass_mat = mass_hodge->matrix;
+
+    /* STEPS >> Compute the time contribution to the RHS: Mtime*pn
+     *       >> Update the cellwise system with the time matrix */
+
+    /* Update rhs with csys->mat*p^n */
+
+    double  *time_pn = cb->values;
+    cs_sdm_square_matvec(mass_mat, csys->val_n, time_pn);
+    for (short int i = 0; i < csys->n_dofs; i++)
+      csys->rhs[i] += tpty_coef*time_pn[i];
+
+    /* Update the cellwise system with the time matrix */
+
+    cs_sdm_add_mult(csys->mat, tpty_coef, mass_mat);
+
+  }
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> Cell system matrix after time treatment",
+                     csys);
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell for an unsteady equation with
+ *          a theta time scheme. One stops before the static condensation
+ *          which is performed by batch of cells in
+ *          _sfb_condense_and_assemble()
+ *
+ * \param[in]      c_id         id of the cell to process
+ * \param[in]      eqp          pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb          pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc          context for this kind of discretization
+ * \param[in]      val_f_pre    face values used as the previous state
+ * \param[in]      val_c_pre    cell values used as the previous state
+ * \param[in]      init_source  true if the source term at t^n is computed
+ * \param[in]      t_cur        current physical time
+ * \param[in]      tcoef        weight of the previous state (1 - theta)
+ * \param[in]      inv_dtcur    inverse of the current time step
+ * \param[in, out] mass_hodge   pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge   pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm           pointer to a facewise view of the mesh
+ * \param[in, out] cm           pointer to a cellwise view of the mesh
+ * \param[in, out] csys         pointer to a cellwise view of the system
+ * \param[in, out] cb           pointer to a cellwise builder
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_sfb_theta_cw_build(cs_lnum_t                   c_id,
+                    const cs_equation_param_t  *eqp,
+                    cs_equation_builder_t      *eqb,
+                    cs_cdofb_scaleq_t          *eqc,
+                    const cs_real_t            *val_f_pre,
+                    const cs_real_t            *val_c_pre,
+                    bool                        init_source,
+                    cs_real_t                   t_cur,
+                    double                      tcoef,
+                    cs_real_t                   inv_dtcur,
+                    cs_hodge_t                 *mass_hodge,
+                    cs_hodge_t                 *diff_hodge,
+                    cs_face_mesh_t             *fm,
+                    cs_cell_mesh_t             *cm,
+                    cs_cell_sys_t              *csys,
+                    cs_cell_builder_t          *cb)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
+                        csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
+
+  if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
+                                                * =========== */
+    if (init_source) { /* First time step */
+
+      /* Reset the local contribution */
+
+      memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
+
+      cs_source_term_compute_cellwise(eqp->n_source_terms,
+                  (cs_xdef_t *const *)eqp->source_terms,
+                                      cm,
+                                      eqb->source_mask,
+                                      eqb->compute_source,
+                                      t_cur,
+                                      mass_hodge,
+                                      cb,
+                                      csys->source);
+
+      csys->rhs[cm->n_fc] += tcoef * csys->source[cm->n_fc];
+
+    }
+    else { /* Add the contribution of the previous time step */
+
+      csys->rhs[cm->n_fc] += tcoef * eqc->source_terms[cm->c_id];
+
+    }
+
+    /* Reset the local contribution */
+
+    memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
+
+    /* Source term contribution to the algebraic system
+       If the equation is steady, the source term has already been computed
+       and is added to the right-hand side during its initialization. */
+
+    cs_source_term_compute_cellwise(eqp->n_source_terms,
+                (cs_xdef_t *const *)eqp->source_terms,
+                                    cm,
+                                    eqb->source_mask,
+                                    eqb->compute_source,
+                                    cb->t_st_eval,
+                                    mass_hodge,
+                                    cb,
+                                    csys->source);
+
+    csys->rhs[cm->n_fc] += eqp->theta * csys->source[cm->n_fc];
+
+  } /* End of term source */
+
+   /* First part of BOUNDARY CONDITIONS
+    *               ===================
+    * Apply a part of BC before time (csys->mat is going to be multiplied
+    * by theta when applying the time scheme) */
+
+  _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+  /* UNSTEADY TERM + TIME SCHEME
+   * =========================== */
+
+  /* STEP.1 >> Compute the contribution of the "adr" to the RHS:
+   *           tcoef*adr_pn where adr_pn = csys->mat * p_n */
+
+  double  *adr_pn = cb->values;
+  cs_sdm_square_matvec(csys->mat, csys->val_n, adr_pn);
+  for (short int i = 0; i < csys->n_dofs; i++) /* n_dofs = n_vc */
+    csys->rhs[i] -= tcoef * adr_pn[i];
+
+  /* STEP.2 >> Multiply csys->mat by theta */
+
+  for (int i = 0; i < csys->n_dofs*csys->n_dofs; i++)
+    csys->mat->val[i] *= eqp->theta;
+
+  /* STEP.3 >> Handle the mass matrix
+   * Two contributions for the mass matrix
+   *  a) add to csys->mat
+   *  b) add to rhs mass_mat * p_n */
+
+  if (!(eqb->time_pty_uniform))
+    cb->tpty_val = cs_property_value_in_cell(cm,
+                                             eqp->time_property,
+                                             cb->t_pty_eval);
+
+  if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping */
+
+    const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+
+    /* Only the cell row is involved in the time evolution */
+
+    csys->rhs[cm->n_fc] += ptyc*csys->val_n[cm->n_fc];
+
+    /* Simply add an entry in mat[cell, cell] */
+
+    csys->mat->val[cm->n_fc*(csys->n_dofs + 1)] += ptyc;
+
+  }
+  else { /* Use the mass matrix */
+
+    const double  tpty_coef = cb->tpty_val * inv_dtcur;
+    const cs_sdm_t  *mass_mat = mass_hodge->matrix;
+
+    /* STEPS >> Compute the time contribution to the RHS: Mtime*pn
+       >> Update the cellwise system with the time matrix */
+
+    /* Update rhs with mass_mat*p^n */
+
+    double  *time_pn = cb->values;
+    cs_sdm_square_matvec(mass_mat, csys->val_n, time_pn);
+    for (short int i = 0; i < csys->n_dofs; i++)
+      csys->rhs[i] += tpty_coef*time_pn[i];
+
+    /* Update the cellwise system with the time matrix */
 
-  /* Compute values at cells pc from values at faces pf
-     pc = acc^-1*(RHS - Acf*pf) */
+    cs_sdm_add_mult(csys->mat, tpty_coef, mass_mat);
 
-  cs_static_condensation_recover_scalar(cs_shared_connect->c2f,
-                                        eqc->rc_tilda,
-                                        eqc->acf_tilda,
-                                        eqc->face_values,
-                                        fld->val);
+  }
 
-  cs_timer_t  t1 = cs_timer_time();
-  cs_timer_counter_add_diff(tce, &t0, &t1);
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump("\n>> Cell system after adding time", csys);
+#endif
 }
 
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
@@ -724,6 +1481,13 @@ cs_cdofb_scaleq_init_sharing(const cs_cdo_quantities_t     *quant,
     cs_cdofb_cell_bld[i] = NULL;
   }
 
+  /* Additional lanes to build cells by batch */
+
+  const int  n_extra = CS_CDO_CELL_BATCH_SIZE - 1;
+
+  BFT_MALLOC(cs_cdofb_batch_cm, cs_glob_n_threads*n_extra, cs_cell_mesh_t *);
+  BFT_MALLOC(cs_cdofb_batch_sys, cs_glob_n_threads*n_extra, cs_cell_sys_t *);
+
 #if defined(HAVE_OPENMP) /* Determine default number of OpenMP threads */
 #pragma omp parallel
   {
@@ -734,6 +1498,14 @@ cs_cdofb_scaleq_init_sharing(const cs_cdo_quantities_t     *quant,
                                                  connect->n_max_fbyc,
                                                  1, NULL);
     cs_cdofb_cell_bld[t_id] = _cell_builder_create(connect);
+
+    for (int l = 0; l < n_extra; l++) {
+      cs_cdofb_batch_cm[t_id*n_extra + l] = cs_cell_mesh_create(connect);
+      cs_cdofb_batch_sys[t_id*n_extra + l] =
+        cs_cell_sys_create(connect->n_max_fbyc + 1,
+                           connect->n_max_fbyc,
+                           1, NULL);
+    }
   }
 #else
   assert(cs_glob_n_threads == 1);
@@ -741,6 +1513,13 @@ cs_cdofb_scaleq_init_sharing(const cs_cdo_quantities_t     *quant,
                                             connect->n_max_fbyc,
                                             1, NULL);
   cs_cdofb_cell_bld[0] = _cell_builder_create(connect);
+
+  for (int l = 0; l < n_extra; l++) {
+    cs_cdofb_batch_cm[l] = cs_cell_mesh_create(connect);
+    cs_cdofb_batch_sys[l] = cs_cell_sys_create(connect->n_max_fbyc + 1,
+                                               connect->n_max_fbyc,
+                                               1, NULL);
+  }
 #endif /* openMP */
 }
 
@@ -773,21 +1552,35 @@ cs_cdofb_scaleq_get(cs_cell_sys_t       **csys,
 void
 cs_cdofb_scaleq_finalize_sharing(void)
 {
+  const int  n_extra = CS_CDO_CELL_BATCH_SIZE - 1;
+
 #if defined(HAVE_OPENMP) /* Determine default number of OpenMP threads */
 #pragma omp parallel
   {
     int t_id = omp_get_thread_num();
     cs_cell_sys_free(&(cs_cdofb_cell_sys[t_id]));
     cs_cell_builder_free(&(cs_cdofb_cell_bld[t_id]));
+
+    for (int l = 0; l < n_extra; l++) {
+      cs_cell_mesh_free(&(cs_cdofb_batch_cm[t_id*n_extra + l]));
+      cs_cell_sys_free(&(cs_cdofb_batch_sys[t_id*n_extra + l]));
+    }
   }
 #else
   assert(cs_glob_n_threads == 1);
   cs_cell_sys_free(&(cs_cdofb_cell_sys[0]));
   cs_cell_builder_free(&(cs_cdofb_cell_bld[0]));
+
+  for (int l = 0; l < n_extra; l++) {
+    cs_cell_mesh_free(&(cs_cdofb_batch_cm[l]));
+    cs_cell_sys_free(&(cs_cdofb_batch_sys[l]));
+  }
 #endif /* openMP */
 
   BFT_FREE(cs_cdofb_cell_sys);
   BFT_FREE(cs_cdofb_cell_bld);
+  BFT_FREE(cs_cdofb_batch_cm);
+  BFT_FREE(cs_cdofb_batch_sys);
   cs_cdofb_cell_bld = NULL;
   cs_cdofb_cell_sys = NULL;
 }
@@ -875,6 +1668,7 @@ cs_cdofb_scaleq_init_context(const cs_equation_param_t   *eqp,
   /* Diffusion term */
 
   eqc->get_stiffness_matrix = NULL;
+  eqc->stiffness_cache = NULL;
   eqc->diffusion_hodge = NULL;
 
   if (cs_equation_param_has_diffusion(eqp)) {
@@ -915,6 +1709,20 @@ cs_cdofb_scaleq_init_context(const cs_equation_param_t   *eqp,
       eqb->msh_flag |= cs_quadrature_get_flag(diff_def->qtype,
                                               cs_flag_primal_cell);
 
+    /* Local stiffness matrices are kept from one build to another */
+
+    if (cs_hodge_cache_is_allowed(eqp, eqp->diffusion_property)) {
+
+      cs_property_type_t  pty_type =
+        cs_property_get_type(eqp->diffusion_property);
+
+      eqc->stiffness_cache =
+        cs_hodge_cache_create(connect->c2f,
+                              1,                              /* cell DoF */
+                              !(pty_type & CS_PROPERTY_ANISO)); /* sym. ? */
+
+    }
+
   } /* Diffusion */
 
   eqc->enforce_robin_bc = cs_cdo_diffusion_sfb_cost_robin;
@@ -1002,6 +1810,7 @@ cs_cdofb_scaleq_init_context(const cs_equation_param_t   *eqp,
   eqc->mass_hodgep.coef = cs_math_1ov3;
 
   eqc->get_mass_matrix = NULL;
+  eqc->mass_cache = NULL;
   eqc->mass_hodge = NULL;
 
   if (eqb->sys_flag & CS_FLAG_SYS_MASS_MATRIX) {
@@ -1013,6 +1822,11 @@ cs_cdofb_scaleq_init_context(const cs_equation_param_t   *eqp,
                                             false,  /* tensor ? */
                                             false); /* eigen ? */
 
+    /* The mass matrix only depends on the mesh */
+
+    if (eqp->cache_cw_operators)
+      eqc->mass_cache = cs_hodge_cache_create(connect->c2f, 1, true);
+
     if (eqp->verbosity > 1) {
       cs_log_printf(CS_LOG_SETUP,
                     "#### Parameters of the mass matrix of the equation %s\n",
@@ -1109,6 +1923,9 @@ cs_cdofb_scaleq_free_context(void   *data)
   cs_hodge_free_context(&(eqc->diffusion_hodge));
   cs_hodge_free_context(&(eqc->mass_hodge));
 
+  cs_hodge_cache_free(&(eqc->stiffness_cache));
+  cs_hodge_cache_free(&(eqc->mass_cache));
+
   /* Free temporary buffers */
 
   BFT_FREE(eqc->source_terms);
@@ -1349,112 +2166,32 @@ cs_cdofb_scaleq_interpolate(const cs_mesh_t            *mesh,
      * Main loop on cells to build the linear system
      * --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
-
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
-
-      /* Set the local (i.e. cellwise) structures for the current cell */
-
-      _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
-                            csys, cb);
-
-      /* Build and add the diffusion/advection/reaction term to the local
-         system. */
-
-      _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
-
-      if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
-                                                    * =========== */
-
-        /* Reset the local contribution */
-
-        memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
-
-        /* Source term contribution to the algebraic system
-           If the equation is steady, the source term has already been computed
-           and is added to the right-hand side during its initialization. */
-
-        cs_source_term_compute_cellwise(eqp->n_source_terms,
-                    (cs_xdef_t *const *)eqp->source_terms,
-                                        cm,
-                                        eqb->source_mask,
-                                        eqb->compute_source,
-                                        cb->t_st_eval,
-                                        mass_hodge,
-                                        cb,
-                                        csys->source);
-
-        csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
-
-      } /* End of term source */
-
-      /* BOUNDARY CONDITIONS + CONDENSATION
-       * ================================== */
-
-      /* Apply a part of BC before the condensation */
-
-      _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-      { /* Reduce the system size since one has the knowledge of the cell
-           value */
-
-        /* Reshape the local system */
-
-        for (short int i = 0; i < cm->n_fc; i++) {
-
-          double  *old_i = csys->mat->val + csys->n_dofs*i;   /* Old "i" row  */
-          double  *new_i = csys->mat->val + cm->n_fc*i;       /* New "i" row */
-
-          for (short int j = 0; j < cm->n_fc; j++)
-            new_i[j] = old_i[j];
-
-          /* Update RHS: RHS = RHS - Afc*pc */
-
-          csys->rhs[i] -= cell_values[csys->c_id] * old_i[cm->n_fc];
-
-        }
-
-        csys->n_dofs = cm->n_fc;
-        csys->mat->n_rows = csys->mat->n_cols = cm->n_fc;
-
-      }
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive. */
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after condensation",
-                         csys);
-#endif
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-      /* Remaining part of boundary conditions */
+    for (int color = 0; color < n_colors; color++) {
 
-      _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-      /* Compute a cellwise norm of the RHS for the normalization of the
-         residual during the resolution of the linear system */
+#     pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
+      for (cs_lnum_t i = s; i < e; i++) {
 
-      rhs_norm += _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type,
-                                            cm, csys);
+        const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      /* ASSEMBLY PROCESS
-       * ================ */
+        rhs_norm += _sfb_interpolate_cw_build(c_id, eqp, eqb, eqc, cell_values,
+                                              val_f_pre, val_c_pre, mass_hodge,
+                                              diff_hodge, fm, cm, csys, cb, asb,
+                                              rhs);
 
-      _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -1558,8 +2295,6 @@ cs_cdofb_scaleq_solve_steady_state(bool                        cur2prev,
        Get the cell-wise view of the mesh and the algebraic system */
 
     cs_face_mesh_t  *fm = cs_cdo_local_get_face_mesh(t_id);
-    cs_cell_mesh_t  *cm = cs_cdo_local_get_cell_mesh(t_id);
-    cs_cell_sys_t  *csys = cs_cdofb_cell_sys[t_id];
     cs_cell_builder_t  *cb = cs_cdofb_cell_bld[t_id];
     cs_cdo_assembly_t  *asb = cs_cdo_assembly_get(t_id);
     cs_hodge_t  *diff_hodge =
@@ -1567,6 +2302,11 @@ cs_cdofb_scaleq_solve_steady_state(bool                        cur2prev,
     cs_hodge_t  *mass_hodge =
       (eqc->mass_hodge == NULL) ? NULL : eqc->mass_hodge[t_id];
 
+    cs_cell_mesh_t  *b_cm[CS_CDO_CELL_BATCH_SIZE];
+    cs_cell_sys_t  *b_sys[CS_CDO_CELL_BATCH_SIZE];
+
+    _sfb_get_batch_views(t_id, b_cm, b_sys);
+
     /* Set times at which one evaluates quantities when needed */
 
     cb->t_pty_eval = time_eval;
@@ -1586,98 +2326,56 @@ cs_cdofb_scaleq_solve_steady_state(bool                        cur2prev,
      * Main loop on cells to build the linear system
      * --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive so that they are built by batch. */
 
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
-
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
-
-      /* Set the local (i.e. cellwise) structures for the current cell */
-
-      _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
-                            csys, cb);
-
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
-
-      _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
-
-      if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
-                                                    * =========== */
-
-        /* Reset the local contribution */
-
-        memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
-
-        /* Source term contribution to the algebraic system
-           If the equation is steady, the source term has already been computed
-           and is added to the right-hand side during its initialization. */
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-        cs_source_term_compute_cellwise(eqp->n_source_terms,
-                    (cs_xdef_t *const *)eqp->source_terms,
-                                        cm,
-                                        eqb->source_mask,
-                                        eqb->compute_source,
-                                        cb->t_st_eval,
-                                        mass_hodge,
-                                        cb,
-                                        csys->source);
+    for (int color = 0; color < n_colors; color++) {
 
-        csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-      } /* End of term source */
+      const cs_lnum_t  n_chunks =
+        (e - s + CS_CDO_CELL_BATCH_SIZE - 1) / CS_CDO_CELL_BATCH_SIZE;
 
-      /* BOUNDARY CONDITIONS + STATIC CONDENSATION
-       * ========================================= */
+#     pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
+      for (cs_lnum_t k = 0; k < n_chunks; k++) {
 
-      /* Apply a part of BC before the static condensation */
+        /* Cells of a chunk are built by batches of cells with the same
+           number of faces (a single batch in most cases) */
 
-      _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+        const cs_lnum_t  ke = CS_MIN(s + (k+1)*CS_CDO_CELL_BATCH_SIZE, e);
 
-      /* STATIC CONDENSATION
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
+        cs_lnum_t  bs = s + k*CS_CDO_CELL_BATCH_SIZE;
+        while (bs < ke) {
 
-      cs_static_condensation_scalar_eq(connect->c2f,
-                                       eqc->rc_tilda, eqc->acf_tilda,
-                                       cb, csys);
+          const cs_lnum_t  be = _sfb_batch_end(connect->c2f, colors, bs, ke);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
+          for (cs_lnum_t i = bs; i < be; i++) {
 
-      /* Remaining part of boundary conditions */
+            const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
+            _sfb_steady_cw_build(c_id, eqp, eqb, eqc, val_f_pre, val_c_pre,
+                                 mass_hodge, diff_hodge, fm,
+                                 b_cm[i-bs], b_sys[i-bs], cb);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
+          }
 
-      /* Compute a cellwise norm of the RHS for the normalization of the
-         residual during the resolution of the linear system */
+          rhs_norm += _sfb_condense_and_assemble(be - bs, eqp, eqb, eqc,
+                                                 diff_hodge, fm, b_cm, b_sys,
+                                                 cb, asb, rhs);
 
-      rhs_norm += _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type,
-                                            cm, csys);
+          bs = be;
 
-      /* ASSEMBLY PROCESS
-       * ================ */
+        } /* Loop on batches */
 
-      _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -1788,8 +2486,6 @@ cs_cdofb_scaleq_solve_implicit(bool                        cur2prev,
        Get the cell-wise view of the mesh and the algebraic system */
 
     cs_face_mesh_t  *fm = cs_cdo_local_get_face_mesh(t_id);
-    cs_cell_mesh_t  *cm = cs_cdo_local_get_cell_mesh(t_id);
-    cs_cell_sys_t  *csys = cs_cdofb_cell_sys[t_id];
     cs_cell_builder_t  *cb = cs_cdofb_cell_bld[t_id];
     cs_cdo_assembly_t  *asb = cs_cdo_assembly_get(t_id);
     cs_hodge_t  *diff_hodge =
@@ -1797,6 +2493,11 @@ cs_cdofb_scaleq_solve_implicit(bool                        cur2prev,
     cs_hodge_t  *mass_hodge =
       (eqc->mass_hodge == NULL) ? NULL : eqc->mass_hodge[t_id];
 
+    cs_cell_mesh_t  *b_cm[CS_CDO_CELL_BATCH_SIZE];
+    cs_cell_sys_t  *b_sys[CS_CDO_CELL_BATCH_SIZE];
+
+    _sfb_get_batch_views(t_id, b_cm, b_sys);
+
     const cs_real_t  t_cur = ts->t_cur;
     const cs_real_t  dt_cur = ts->dt[0];
     const cs_real_t  time_eval = t_cur + dt_cur;
@@ -1824,146 +2525,56 @@ cs_cdofb_scaleq_solve_implicit(bool                        cur2prev,
     /* Main loop on cells to build the linear system */
     /* --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
-
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
-
-      /* Set the local (i.e. cellwise) structures for the current cell */
-
-      _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
-                            csys, cb);
-
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
-
-      _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
-
-      if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
-                                                    * =========== */
-
-        /* Reset the local contribution */
-
-        memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
-
-        /* Source term contribution to the algebraic system
-           If the equation is steady, the source term has already been computed
-           and is added to the right-hand side during its initialization. */
-
-        cs_source_term_compute_cellwise(eqp->n_source_terms,
-                    (cs_xdef_t *const *)eqp->source_terms,
-                                        cm,
-                                        eqb->source_mask,
-                                        eqb->compute_source,
-                                        time_eval,
-                                        mass_hodge,
-                                        cb,
-                                        csys->source);
-
-        csys->rhs[cm->n_fc] += csys->source[cm->n_fc];
-
-      } /* End of term source */
-
-      /* First part of the BOUNDARY CONDITIONS
-       *                   ===================
-       * Apply a part of BC before the time scheme */
-
-      _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-      /* UNSTEADY TERM + TIME SCHEME
-       * =========================== */
-
-      if (!(eqb->time_pty_uniform))
-        cb->tpty_val = cs_property_value_in_cell(cm,
-                                                 eqp->time_property,
-                                                 time_eval);
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive so that they are built by batch. */
 
-      if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping
-                                                      or Hodge-Voronoi */
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-        const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+    for (int color = 0; color < n_colors; color++) {
 
-        /* Simply add an entry in mat[cell, cell] */
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-        csys->rhs[cm->n_fc] += ptyc * csys->val_n[cm->n_fc];
-        csys->mat->val[cm->n_fc*csys->n_dofs + cm->n_fc] += ptyc;
+      const cs_lnum_t  n_chunks =
+        (e - s + CS_CDO_CELL_BATCH_SIZE - 1) / CS_CDO_CELL_BATCH_SIZE;
 
-      }
-      else { /* Use the mass matrix */
-
-        const double  tpty_coef = cb->tpty_val * inv_dtcur;
-        const cs_sdm_t  *mass_mat = mass_hodge->matrix;
-
-        /* STEPS >> Compute the time contribution to the RHS: Mtime*pn
-         *       >> Update the cellwise system with the time matrix */
-
-        /* Update rhs with csys->mat*p^n */
+#     pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
+      for (cs_lnum_t k = 0; k < n_chunks; k++) {
 
-        double  *time_pn = cb->values;
-        cs_sdm_square_matvec(mass_mat, csys->val_n, time_pn);
-        for (short int i = 0; i < csys->n_dofs; i++)
-          csys->rhs[i] += tpty_coef*time_pn[i];
-
-        /* Update the cellwise system with the time matrix */
-
-        cs_sdm_add_mult(csys->mat, tpty_coef, mass_mat);
-
-      }
+        /* Cells of a chunk are built by batches of cells with the same
+           number of faces (a single batch in most cases) */
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after time treatment",
-                         csys);
-#endif
+        const cs_lnum_t  ke = CS_MIN(s + (k+1)*CS_CDO_CELL_BATCH_SIZE, e);
 
-      /* STATIC CONDENSATION
-       * ===================
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
+        cs_lnum_t  bs = s + k*CS_CDO_CELL_BATCH_SIZE;
+        while (bs < ke) {
 
-      cs_static_condensation_scalar_eq(connect->c2f,
-                                       eqc->rc_tilda,
-                                       eqc->acf_tilda,
-                                       cb, csys);
+          const cs_lnum_t  be = _sfb_batch_end(connect->c2f, colors, bs, ke);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
+          for (cs_lnum_t i = bs; i < be; i++) {
 
-      /* Remaining part of BOUNDARY CONDITIONS
-       * =================================== */
+            const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
+            _sfb_implicit_cw_build(c_id, eqp, eqb, eqc, val_f_pre, val_c_pre,
+                                   time_eval, inv_dtcur, mass_hodge, diff_hodge,
+                                   fm, b_cm[i-bs], b_sys[i-bs], cb);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
+          }
 
-      /* Compute a cellwise norm of the RHS for the normalization of the
-         residual during the resolution of the linear system */
+          rhs_norm += _sfb_condense_and_assemble(be - bs, eqp, eqb, eqc,
+                                                 diff_hodge, fm, b_cm, b_sys,
+                                                 cb, asb, rhs);
 
-      rhs_norm += _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type,
-                                            cm, csys);
+          bs = be;
 
-      /* ASSEMBLY PROCESS
-       * ================ */
+        } /* Loop on batches */
 
-      _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -2087,8 +2698,6 @@ cs_cdofb_scaleq_solve_theta(bool                        cur2prev,
        Get the cell-wise view of the mesh and the algebraic system */
 
     cs_face_mesh_t  *fm = cs_cdo_local_get_face_mesh(t_id);
-    cs_cell_mesh_t  *cm = cs_cdo_local_get_cell_mesh(t_id);
-    cs_cell_sys_t  *csys = cs_cdofb_cell_sys[t_id];
     cs_cell_builder_t  *cb = cs_cdofb_cell_bld[t_id];
     cs_cdo_assembly_t  *asb = cs_cdo_assembly_get(t_id);
     cs_hodge_t  *diff_hodge =
@@ -2096,6 +2705,11 @@ cs_cdofb_scaleq_solve_theta(bool                        cur2prev,
     cs_hodge_t  *mass_hodge =
       (eqc->mass_hodge == NULL) ? NULL : eqc->mass_hodge[t_id];
 
+    cs_cell_mesh_t  *b_cm[CS_CDO_CELL_BATCH_SIZE];
+    cs_cell_sys_t  *b_sys[CS_CDO_CELL_BATCH_SIZE];
+
+    _sfb_get_batch_views(t_id, b_cm, b_sys);
+
     const cs_real_t  t_cur = ts->t_cur;
     const cs_real_t  dt_cur = ts->dt[0];
     const cs_real_t  inv_dtcur = 1./dt_cur;
@@ -2126,189 +2740,57 @@ cs_cdofb_scaleq_solve_theta(bool                        cur2prev,
     /* Main loop on cells to build the linear system */
     /* --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
-
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
-
-      /* Set the local (i.e. cellwise) structures for the current cell */
-
-      _sfb_init_cell_system(cm, eqp, eqb, val_f_pre, val_c_pre,
-                            csys, cb);
-
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
-
-      _sfb_conv_diff_reac(eqp, eqb, eqc, cm, mass_hodge, diff_hodge, csys, cb);
-
-      if (cs_equation_param_has_sourceterm(eqp)) { /* SOURCE TERM
-                                                    * =========== */
-        if (compute_initial_source) { /* First time step */
-
-          /* Reset the local contribution */
-
-          memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
-
-          cs_source_term_compute_cellwise(eqp->n_source_terms,
-                      (cs_xdef_t *const *)eqp->source_terms,
-                                          cm,
-                                          eqb->source_mask,
-                                          eqb->compute_source,
-                                          t_cur,
-                                          mass_hodge,
-                                          cb,
-                                          csys->source);
-
-          csys->rhs[cm->n_fc] += tcoef * csys->source[cm->n_fc];
-
-        }
-        else { /* Add the contribution of the previous time step */
-
-          csys->rhs[cm->n_fc] += tcoef * eqc->source_terms[cm->c_id];
-
-        }
-
-        /* Reset the local contribution */
-
-        memset(csys->source, 0, csys->n_dofs*sizeof(cs_real_t));
-
-        /* Source term contribution to the algebraic system
-           If the equation is steady, the source term has already been computed
-           and is added to the right-hand side during its initialization. */
-
-        cs_source_term_compute_cellwise(eqp->n_source_terms,
-                    (cs_xdef_t *const *)eqp->source_terms,
-                                        cm,
-                                        eqb->source_mask,
-                                        eqb->compute_source,
-                                        cb->t_st_eval,
-                                        mass_hodge,
-                                        cb,
-                                        csys->source);
-
-        csys->rhs[cm->n_fc] += eqp->theta * csys->source[cm->n_fc];
-
-      } /* End of term source */
-
-       /* First part of BOUNDARY CONDITIONS
-        *               ===================
-        * Apply a part of BC before time (csys->mat is going to be multiplied
-        * by theta when applying the time scheme) */
-
-      _sfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-      /* UNSTEADY TERM + TIME SCHEME
-       * =========================== */
-
-      /* STEP.1 >> Compute the contribution of the "adr" to the RHS:
-       *           tcoef*adr_pn where adr_pn = csys->mat * p_n */
-
-      double  *adr_pn = cb->values;
-      cs_sdm_square_matvec(csys->mat, csys->val_n, adr_pn);
-      for (short int i = 0; i < csys->n_dofs; i++) /* n_dofs = n_vc */
-        csys->rhs[i] -= tcoef * adr_pn[i];
-
-      /* STEP.2 >> Multiply csys->mat by theta */
-
-      for (int i = 0; i < csys->n_dofs*csys->n_dofs; i++)
-        csys->mat->val[i] *= eqp->theta;
-
-      /* STEP.3 >> Handle the mass matrix
-       * Two contributions for the mass matrix
-       *  a) add to csys->mat
-       *  b) add to rhs mass_mat * p_n */
-
-      if (!(eqb->time_pty_uniform))
-        cb->tpty_val = cs_property_value_in_cell(cm,
-                                                 eqp->time_property,
-                                                 cb->t_pty_eval);
-
-      if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping */
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive so that they are built by batch. */
 
-        const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-        /* Only the cell row is involved in the time evolution */
+    for (int color = 0; color < n_colors; color++) {
 
-        csys->rhs[cm->n_fc] += ptyc*csys->val_n[cm->n_fc];
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-        /* Simply add an entry in mat[cell, cell] */
+      const cs_lnum_t  n_chunks =
+        (e - s + CS_CDO_CELL_BATCH_SIZE - 1) / CS_CDO_CELL_BATCH_SIZE;
 
-        csys->mat->val[cm->n_fc*(csys->n_dofs + 1)] += ptyc;
+#     pragma omp for CS_CDO_OMP_SCHEDULE reduction(+:rhs_norm)
+      for (cs_lnum_t k = 0; k < n_chunks; k++) {
 
-      }
-      else { /* Use the mass matrix */
-
-        const double  tpty_coef = cb->tpty_val * inv_dtcur;
-        const cs_sdm_t  *mass_mat = mass_hodge->matrix;
-
-        /* STEPS >> Compute the time contribution to the RHS: Mtime*pn
-           >> Update the cellwise system with the time matrix */
-
-        /* Update rhs with mass_mat*p^n */
-
-        double  *time_pn = cb->values;
-        cs_sdm_square_matvec(mass_mat, csys->val_n, time_pn);
-        for (short int i = 0; i < csys->n_dofs; i++)
-          csys->rhs[i] += tpty_coef*time_pn[i];
-
-        /* Update the cellwise system with the time matrix */
-
-        cs_sdm_add_mult(csys->mat, tpty_coef, mass_mat);
-
-      }
+        /* Cells of a chunk are built by batches of cells with the same
+           number of faces (a single batch in most cases) */
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump("\n>> Cell system after adding time", csys);
-#endif
+        const cs_lnum_t  ke = CS_MIN(s + (k+1)*CS_CDO_CELL_BATCH_SIZE, e);
 
-      /* STATIC CONDENSATION
-       * ===================
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
+        cs_lnum_t  bs = s + k*CS_CDO_CELL_BATCH_SIZE;
+        while (bs < ke) {
 
-      cs_static_condensation_scalar_eq(connect->c2f,
-                                       eqc->rc_tilda, eqc->acf_tilda,
-                                       cb, csys);
+          const cs_lnum_t  be = _sfb_batch_end(connect->c2f, colors, bs, ke);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
+          for (cs_lnum_t i = bs; i < be; i++) {
 
-      /* Remaining part of BOUNDARY CONDITIONS
-       * ===================================== */
+            const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      _sfb_apply_remaining_bc(eqp, eqb, eqc, cm, fm, diff_hodge, csys, cb);
+            _sfb_theta_cw_build(c_id, eqp, eqb, eqc, val_f_pre, val_c_pre,
+                                compute_initial_source, t_cur, tcoef, inv_dtcur,
+                                mass_hodge, diff_hodge, fm,
+                                b_cm[i-bs], b_sys[i-bs], cb);
 
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_SCALEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
+          }
 
-      /* Compute a cellwise norm of the RHS for the normalization of the
-         residual during the resolution of the linear system */
+          rhs_norm += _sfb_condense_and_assemble(be - bs, eqp, eqb, eqc,
+                                                 diff_hodge, fm, b_cm, b_sys,
+                                                 cb, asb, rhs);
 
-      rhs_norm += _sfb_cw_rhs_normalization(eqp->sles_param->resnorm_type,
-                                            cm, csys);
+          bs = be;
 
-      /* ASSEMBLY PROCESS
-       * ================ */
+        } /* Loop on batches */
 
-      _sfb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -266,6 +266,515 @@ _vfb_apply_remaining_bc(const cs_equation_param_t     *eqp,
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Perform the assembly stage for a vector-valued system obtained
+ *         with CDO-Fb scheme. If colored is true, cells are processed by
+ *         colors so that no synchronization between threads is needed.
+ *
+ * \param[in]      csys         pointer to a cs_cell_sys_t structure
+ * \param[in]      colored      true if cells are processed by colors
+ * \param[in, out] block        pointer to a block structure
+ * \param[in, out] rhs          array of values for the rhs
+ * \param[in, out] eqc          context structure for a vector-valued Fb
+ * \param[in, out] asb          pointer to cs_cdo_assembly_t
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_vfb_assemble(const cs_cell_sys_t            *csys,
+              bool                            colored,
+              cs_cdo_system_block_t          *block,
+              cs_real_t                      *rhs,
+              cs_cdofb_vecteq_t              *eqc,
+              cs_cdo_assembly_t              *asb)
+{
+  assert(asb != NULL && block != NULL); /* Sanity check */
+  assert(block->type == CS_CDO_SYSTEM_BLOCK_DEFAULT);
+  cs_cdo_system_dblock_t  *db = block->block_pointer;
+
+  /* Matrix and RHS assembly (only on faces since a static condensation has
+     been performed to reduce the size) so that n_dofs = 3*n_fc */
+
+  if (colored) {
+
+    db->colored_assembly_func(csys->mat, csys->dof_ids, db->range_set, asb,
+                              db->mav);
+
+    for (short int f = 0; f < csys->n_dofs; f++)
+      rhs[csys->dof_ids[f]] += csys->rhs[f];
+
+  }
+  else {
+
+    db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
+
+#   pragma omp critical
+    {
+      for (short int f = 0; f < csys->n_dofs; f++)
+        rhs[csys->dof_ids[f]] += csys->rhs[f];
+    }
+
+  }
+
+  /* Reset the value of the source term for the cell DoF
+     Source term is only hold by the cell DoF in face-based schemes */
+
+  if (eqc->source_terms != NULL) {
+
+    const cs_real_t  *_st = csys->source + csys->n_dofs;
+    cs_real_t  *cell_st = eqc->source_terms + 3*csys->c_id;
+    for (int k = 0; k < 3; k++)
+      cell_st[k] = _st[k];
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell and assemble it for a
+ *          steady-state equation.
+ *
+ * \param[in]      c_id        id of the cell to process
+ * \param[in]      eqp         pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb         pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc         context for this kind of discretization
+ * \param[in]      val_c       current cell values
+ * \param[in]      time_eval   time at which one evaluates quantities
+ * \param[in, out] mass_hodge  pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge  pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm          pointer to a facewise view of the mesh
+ * \param[in, out] cm          pointer to a cellwise view of the mesh
+ * \param[in, out] csys        pointer to a cellwise view of the system
+ * \param[in, out] cb          pointer to a cellwise builder
+ * \param[in, out] asb         pointer to a cs_cdo_assembly_t structure
+ * \param[in, out] rhs         right-hand side array
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_vfb_steady_cw_build(cs_lnum_t                   c_id,
+                     const cs_equation_param_t  *eqp,
+                     cs_equation_builder_t      *eqb,
+                     cs_cdofb_vecteq_t          *eqc,
+                     const cs_real_t            *val_c,
+                     cs_real_t                   time_eval,
+                     cs_hodge_t                 *mass_hodge,
+                     cs_hodge_t                 *diff_hodge,
+                     cs_face_mesh_t             *fm,
+                     cs_cell_mesh_t             *cm,
+                     cs_cell_sys_t              *csys,
+                     cs_cell_builder_t          *cb,
+                     cs_cdo_assembly_t          *asb,
+                     cs_real_t                  *rhs)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+  cs_cdo_system_helper_t  *sh = eqb->system_helper;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
+                                   eqc->face_values, val_c,
+                                   NULL, NULL, /* no n-1 state is given */
+                                   csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
+                                 mass_hodge, diff_hodge,
+                                 csys, cb);
+
+  if (cs_equation_param_has_sourceterm(eqp)) /* SOURCE TERM */
+    cs_cdofb_vecteq_sourceterm(cm, eqp, time_eval, 1., /* time scaling */
+                               mass_hodge,
+                               cb, eqb, csys);
+
+
+  /* First part of the BOUNDARY CONDITIONS
+   *                   ===================
+   * Apply a part of BC before the time scheme */
+
+  _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+
+  /* STATIC CONDENSATION
+   * ===================
+   * Static condensation of the local system matrix of size n_fc + 1 into
+   * a matrix of size n_fc.
+   * Store data in rc_tilda and acf_tilda to compute the values at cell
+   * centers after solving the system */
+
+  cs_static_condensation_vector_eq(connect->c2f,
+                                   eqc->rc_tilda,
+                                   eqc->acf_tilda,
+                                   cb, csys);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> Cell system matrix after static condensation",
+                     csys);
+#endif
+
+  /* Remaining part of BOUNDARY CONDITIONS
+   * ===================================== */
+
+  _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
+#endif
+
+  /* ASSEMBLY PROCESS */
+  /* ================ */
+
+  _vfb_assemble(csys, (connect->f_colors != NULL), sh->blocks[0], rhs, eqc,
+                asb);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell and assemble it for an
+ *          unsteady equation with an implicit Euler time scheme.
+ *
+ * \param[in]      c_id        id of the cell to process
+ * \param[in]      eqp         pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb         pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc         context for this kind of discretization
+ * \param[in]      val_c       current cell values
+ * \param[in]      inv_dtcur   inverse of the current time step
+ * \param[in, out] mass_hodge  pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge  pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm          pointer to a facewise view of the mesh
+ * \param[in, out] cm          pointer to a cellwise view of the mesh
+ * \param[in, out] csys        pointer to a cellwise view of the system
+ * \param[in, out] cb          pointer to a cellwise builder
+ * \param[in, out] asb         pointer to a cs_cdo_assembly_t structure
+ * \param[in, out] rhs         right-hand side array
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_vfb_implicit_cw_build(cs_lnum_t                   c_id,
+                       const cs_equation_param_t  *eqp,
+                       cs_equation_builder_t      *eqb,
+                       cs_cdofb_vecteq_t          *eqc,
+                       const cs_real_t            *val_c,
+                       cs_real_t                   inv_dtcur,
+                       cs_hodge_t                 *mass_hodge,
+                       cs_hodge_t                 *diff_hodge,
+                       cs_face_mesh_t             *fm,
+                       cs_cell_mesh_t             *cm,
+                       cs_cell_sys_t              *csys,
+                       cs_cell_builder_t          *cb,
+                       cs_cdo_assembly_t          *asb,
+                       cs_real_t                  *rhs)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+  cs_cdo_system_helper_t  *sh = eqb->system_helper;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
+                                   eqc->face_values, val_c,
+                                   NULL, NULL, /* no n-1 state is given */
+                                   csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
+                                 mass_hodge, diff_hodge,
+                                 csys, cb);
+
+  const short int  n_f = cm->n_fc;
+  const bool has_sourceterm = cs_equation_param_has_sourceterm(eqp);
+
+  if (has_sourceterm) /* SOURCE TERM */
+    cs_cdofb_vecteq_sourceterm(cm, eqp,
+                               cb->t_st_eval, 1., /* time, scaling */
+                               mass_hodge,
+                               cb, eqb, csys);
+
+  /* First part of the BOUNDARY CONDITIONS
+   *                   ===================
+   * Apply a part of BC before the time scheme */
+
+  _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+  /* UNSTEADY TERM + TIME SCHEME
+   * =========================== */
+
+  if (!(eqb->time_pty_uniform))
+    cb->tpty_val = cs_property_value_in_cell(cm, eqp->time_property,
+                                             cb->t_pty_eval);
+
+  if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) {
+
+    /* Mass lumping or Hodge-Voronoi */
+
+    const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+
+    /* Get cell-cell block */
+
+    cs_sdm_t *acc = cs_sdm_get_block(csys->mat, n_f, n_f);
+
+    for (short int k = 0; k < 3; k++) {
+
+      csys->rhs[3*n_f + k] += ptyc * csys->val_n[3*n_f+k];
+
+      /* Simply add an entry in mat[cell, cell] */
+      acc->val[4*k] += ptyc;
+
+    }
+
+  }
+  else
+    bft_error(__FILE__, __LINE__, 0,
+              "Only diagonal time treatment available so far.");
+
+  /* STATIC CONDENSATION
+   * ===================
+   * Static condensation of the local system matrix of size n_fc + 1 into
+   * a matrix of size n_fc.
+   * Store data in rc_tilda and acf_tilda to compute the values at cell
+   * centers after solving the system */
+
+  cs_static_condensation_vector_eq(connect->c2f,
+                                   eqc->rc_tilda, eqc->acf_tilda,
+                                   cb, csys);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> Cell system matrix after static condensation",
+                     csys);
+#endif
+
+  /* Remaining part of BOUNDARY CONDITIONS
+   * ===================================== */
+
+  _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
+#endif
+
+  /* ASSEMBLY PROCESS */
+  /* ================ */
+
+  _vfb_assemble(csys, (connect->f_colors != NULL), sh->blocks[0], rhs, eqc,
+                asb);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Build the local system of a cell and assemble it for an
+ *          unsteady equation with a theta time scheme.
+ *
+ * \param[in]      c_id         id of the cell to process
+ * \param[in]      eqp          pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb          pointer to a cs_equation_builder_t structure
+ * \param[in, out] eqc          context for this kind of discretization
+ * \param[in]      val_c        current cell values
+ * \param[in]      init_source  true if the source term at t^n is computed
+ * \param[in]      t_cur        current physical time
+ * \param[in]      tcoef        weight of the previous state (1 - theta)
+ * \param[in]      inv_dtcur    inverse of the current time step
+ * \param[in, out] mass_hodge   pointer to a cs_hodge_t structure (mass matrix)
+ * \param[in, out] diff_hodge   pointer to a cs_hodge_t structure (diffusion)
+ * \param[in, out] fm           pointer to a facewise view of the mesh
+ * \param[in, out] cm           pointer to a cellwise view of the mesh
+ * \param[in, out] csys         pointer to a cellwise view of the system
+ * \param[in, out] cb           pointer to a cellwise builder
+ * \param[in, out] asb          pointer to a cs_cdo_assembly_t structure
+ * \param[in, out] rhs          right-hand side array
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_vfb_theta_cw_build(cs_lnum_t                   c_id,
+                    const cs_equation_param_t  *eqp,
+                    cs_equation_builder_t      *eqb,
+                    cs_cdofb_vecteq_t          *eqc,
+                    const cs_real_t            *val_c,
+                    bool                        init_source,
+                    cs_real_t                   t_cur,
+                    double                      tcoef,
+                    cs_real_t                   inv_dtcur,
+                    cs_hodge_t                 *mass_hodge,
+                    cs_hodge_t                 *diff_hodge,
+                    cs_face_mesh_t             *fm,
+                    cs_cell_mesh_t             *cm,
+                    cs_cell_sys_t              *csys,
+                    cs_cell_builder_t          *cb,
+                    cs_cdo_assembly_t          *asb,
+                    cs_real_t                  *rhs)
+{
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+  cs_cdo_system_helper_t  *sh = eqb->system_helper;
+
+  /* Set the current cell flag */
+
+  cb->cell_flag = connect->cell_flag[c_id];
+
+  /* Set the local mesh structure for the current cell */
+
+  cs_cell_mesh_build(c_id,
+                     cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                     connect, quant, cm);
+
+  /* Set the local (i.e. cellwise) structures for the current cell */
+
+  cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
+                                   eqc->face_values, val_c,
+                                   NULL, NULL, /* no n-1 state is given */
+                                   csys, cb);
+
+  /* Build and add the diffusion/advection/reaction terms to the local
+     system. Mass matrix is computed inside if needed during the building */
+
+  cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
+                                 mass_hodge, diff_hodge,
+                                 csys, cb);
+
+  const short int  n_f = cm->n_fc;
+  const bool  has_sourceterm = cs_equation_param_has_sourceterm(eqp);
+
+  if (has_sourceterm) { /* SOURCE TERM
+                         * =========== */
+
+    if (init_source) { /* First time step */
+
+      cs_cdofb_vecteq_sourceterm(cm, eqp, t_cur, tcoef,  /* time scaling */
+                                 mass_hodge,
+                                 cb, eqb, csys);
+
+    }
+    else { /* Add the contribution of the previous time step */
+
+      for (short int k = 0; k < 3; k++)
+        csys->rhs[3*n_f + k] += tcoef * eqc->source_terms[3*c_id + k];
+
+    }
+
+    cs_cdofb_vecteq_sourceterm(cm, eqp,
+                               cb->t_st_eval, eqp->theta, /* time scaling */
+                               mass_hodge,
+                               cb, eqb, csys);
+
+  } /* End of term source */
+
+  /* First part of the BOUNDARY CONDITIONS
+   *                   ===================
+   * Apply a part of BC before the time scheme */
+
+  _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
+
+  /* UNSTEADY TERM + TIME SCHEME
+   * =========================== */
+
+  /* STEP.1 >> Compute the contribution of the "adr" to the RHS:
+   *           tcoef*adr_pn where adr_pn = csys->mat * p_n */
+
+  double  *adr_pn = cb->values;
+  cs_sdm_block_matvec(csys->mat, csys->val_n, adr_pn);
+  for (short int i = 0; i < csys->n_dofs; i++) /* n_dofs = n_vc */
+    csys->rhs[i] -= tcoef * adr_pn[i];
+
+  /* STEP.2 >> Multiply csys->mat by theta */
+
+  for (int i = 0; i < csys->n_dofs*csys->n_dofs; i++)
+    csys->mat->val[i] *= eqp->theta;
+
+  /* STEP.3 >> Handle the mass matrix
+   * Two contributions for the mass matrix
+   *  a) add to csys->mat
+   *  b) add to rhs mass_mat * p_n */
+
+  if (!(eqb->time_pty_uniform))
+    cb->tpty_val = cs_property_value_in_cell(cm, eqp->time_property,
+                                             cb->t_pty_eval);
+
+  if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping */
+
+    const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+
+    /* Get cell-cell block */
+    cs_sdm_t *acc = cs_sdm_get_block(csys->mat, n_f, n_f);
+
+    for (short int k = 0; k < 3; k++) {
+
+      csys->rhs[3*n_f + k] += ptyc * csys->val_n[3*n_f+k];
+
+      /* Simply add an entry in mat[cell, cell] */
+      acc->val[4*k] += ptyc;
+
+    }
+
+  }
+  else
+    bft_error(__FILE__, __LINE__, 0,
+              "Only diagonal time treatment available so far.");
+
+  /* STATIC CONDENSATION
+   * ===================
+   * Static condensation of the local system matrix of size n_fc + 1 into
+   * a matrix of size n_fc.
+   * Store data in rc_tilda and acf_tilda to compute the values at cell
+   * centers after solving the system */
+
+  cs_static_condensation_vector_eq(connect->c2f,
+                                   eqc->rc_tilda, eqc->acf_tilda,
+                                   cb, csys);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> Cell system matrix after static condensation",
+                     csys);
+#endif
+
+  /* Remaining part of BOUNDARY CONDITIONS
+   * ===================================== */
+
+  _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
+
+#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
+  if (cs_dbg_cw_test(eqp, cm, csys))
+    cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
+#endif
+
+  /* ASSEMBLY PROCESS */
+  /* ================ */
+
+  _vfb_assemble(csys, (connect->f_colors != NULL), sh->blocks[0], rhs, eqc,
+                asb);
+}
+
 /*! \endcond DOXYGEN_SHOULD_SKIP_THIS */
 
 /*============================================================================
@@ -671,34 +1180,7 @@ cs_cdofb_vecteq_assembly(const cs_cell_sys_t            *csys,
                          cs_cdofb_vecteq_t              *eqc,
                          cs_cdo_assembly_t              *asb)
 {
-  assert(asb != NULL && block != NULL); /* Sanity check */
-  assert(block->type == CS_CDO_SYSTEM_BLOCK_DEFAULT);
-  cs_cdo_system_dblock_t  *db = block->block_pointer;
-
-  /* Matrix assembly */
-
-  db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
-
-  /* RHS assembly (only on faces since a static condensation has been performed
-     to reduce the size) so that n_dofs = 3*n_fc */
-
-# pragma omp critical
-  {
-    for (short int f = 0; f < csys->n_dofs; f++)
-      rhs[csys->dof_ids[f]] += csys->rhs[f];
-  }
-
-  /* Reset the value of the source term for the cell DoF
-     Source term is only hold by the cell DoF in face-based schemes */
-
-  if (eqc->source_terms != NULL) {
-
-    const cs_real_t  *_st = csys->source + csys->n_dofs;
-    cs_real_t  *cell_st = eqc->source_terms + 3*csys->c_id;
-    for (int k = 0; k < 3; k++)
-      cell_st[k] = _st[k];
-
-  }
+  _vfb_assemble(csys, false, block, rhs, eqc, asb);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -816,80 +1298,31 @@ cs_cdofb_vecteq_solve_steady_state(bool                        cur2prev,
     /* Main loop on cells to build the linear system */
     /* --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive. */
 
-      /* Set the local mesh structure for the current cell */
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
+    for (int color = 0; color < n_colors; color++) {
 
-      /* Set the local (i.e. cellwise) structures for the current cell */
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-      cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
-                                       eqc->face_values, fld->val,
-                                       NULL, NULL, /* no n-1 state is given */
-                                       csys, cb);
+#     pragma omp for CS_CDO_OMP_SCHEDULE
+      for (cs_lnum_t i = s; i < e; i++) {
 
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
+        const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
-                                     mass_hodge, diff_hodge,
-                                     csys, cb);
-
-      if (cs_equation_param_has_sourceterm(eqp)) /* SOURCE TERM */
-        cs_cdofb_vecteq_sourceterm(cm, eqp, time_eval, 1., /* time scaling */
-                                   mass_hodge,
-                                   cb, eqb, csys);
-
-
-      /* First part of the BOUNDARY CONDITIONS
-       *                   ===================
-       * Apply a part of BC before the time scheme */
-
-      _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-
-      /* STATIC CONDENSATION
-       * ===================
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
-
-      cs_static_condensation_vector_eq(connect->c2f,
-                                       eqc->rc_tilda,
-                                       eqc->acf_tilda,
-                                       cb, csys);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
-
-      /* Remaining part of BOUNDARY CONDITIONS
-       * ===================================== */
-
-      _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
-
-      /* ASSEMBLY PROCESS */
-      /* ================ */
+        _vfb_steady_cw_build(c_id, eqp, eqb, eqc, fld->val, time_eval,
+                             mass_hodge, diff_hodge, fm, cm, csys, cb, asb,
+                             rhs);
 
-      cs_cdofb_vecteq_assembly(csys, sh->blocks[0], sh->rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OpenMP Block */
 
@@ -1019,112 +1452,31 @@ cs_cdofb_vecteq_solve_implicit(bool                        cur2prev,
     /* Main loop on cells to build the linear system */
     /* --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
-
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
-
-      /* Set the local (i.e. cellwise) structures for the current cell */
-
-      cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
-                                       eqc->face_values, fld->val,
-                                       NULL, NULL, /* no n-1 state is given */
-                                       csys, cb);
-
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
-
-      cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
-                                     mass_hodge, diff_hodge,
-                                     csys, cb);
-
-      const short int  n_f = cm->n_fc;
-      const bool has_sourceterm = cs_equation_param_has_sourceterm(eqp);
-
-      if (has_sourceterm) /* SOURCE TERM */
-        cs_cdofb_vecteq_sourceterm(cm, eqp,
-                                   cb->t_st_eval, 1., /* time, scaling */
-                                   mass_hodge,
-                                   cb, eqb, csys);
-
-      /* First part of the BOUNDARY CONDITIONS
-       *                   ===================
-       * Apply a part of BC before the time scheme */
-
-      _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-      /* UNSTEADY TERM + TIME SCHEME
-       * =========================== */
-
-      if (!(eqb->time_pty_uniform))
-        cb->tpty_val = cs_property_value_in_cell(cm, eqp->time_property,
-                                                 cb->t_pty_eval);
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive. */
 
-      if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) {
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-        /* Mass lumping or Hodge-Voronoi */
+    for (int color = 0; color < n_colors; color++) {
 
-        const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-        /* Get cell-cell block */
+#     pragma omp for CS_CDO_OMP_SCHEDULE
+      for (cs_lnum_t i = s; i < e; i++) {
 
-        cs_sdm_t *acc = cs_sdm_get_block(csys->mat, n_f, n_f);
+        const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-        for (short int k = 0; k < 3; k++) {
+        _vfb_implicit_cw_build(c_id, eqp, eqb, eqc, fld->val, inv_dtcur,
+                               mass_hodge, diff_hodge, fm, cm, csys, cb, asb,
+                               rhs);
 
-          csys->rhs[3*n_f + k] += ptyc * csys->val_n[3*n_f+k];
+      } /* Main loop on cells */
 
-          /* Simply add an entry in mat[cell, cell] */
-          acc->val[4*k] += ptyc;
-
-        }
-
-      }
-      else
-        bft_error(__FILE__, __LINE__, 0,
-                  "Only diagonal time treatment available so far.");
-
-      /* STATIC CONDENSATION
-       * ===================
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
-
-      cs_static_condensation_vector_eq(connect->c2f,
-                                       eqc->rc_tilda, eqc->acf_tilda,
-                                       cb, csys);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
-
-      /* Remaining part of BOUNDARY CONDITIONS
-       * ===================================== */
-
-      _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
-
-      /* ASSEMBLY PROCESS */
-      /* ================ */
-
-      cs_cdofb_vecteq_assembly(csys, sh->blocks[0], rhs, eqc, asb);
-
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -1268,145 +1620,31 @@ cs_cdofb_vecteq_solve_theta(bool                        cur2prev,
     /* Main loop on cells to build the linear system */
     /* --------------------------------------------- */
 
-#   pragma omp for CS_CDO_OMP_SCHEDULE
-    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
-
-      /* Set the current cell flag */
-
-      cb->cell_flag = connect->cell_flag[c_id];
-
-      /* Set the local mesh structure for the current cell */
+    /* Cells are processed by colors (one color if no coloring is
+       available). Inside a color, cells share no DoF and cells with the same
+       type are consecutive. */
 
-      cs_cell_mesh_build(c_id,
-                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
-                         connect, quant, cm);
+    const cs_adjacency_t  *colors = connect->f_colors;
+    const int  n_colors = (colors == NULL) ? 1 : colors->n_elts;
 
-      /* Set the local (i.e. cellwise) structures for the current cell */
+    for (int color = 0; color < n_colors; color++) {
 
-      cs_cdofb_vecteq_init_cell_system(cm, eqp, eqb,
-                                       eqc->face_values, fld->val,
-                                       NULL, NULL, /* no n-1 state is given */
-                                       csys, cb);
+      const cs_lnum_t  s = (colors == NULL) ? 0 : colors->idx[color];
+      const cs_lnum_t  e = (colors == NULL) ?
+        quant->n_cells : colors->idx[color+1];
 
-      /* Build and add the diffusion/advection/reaction terms to the local
-         system. Mass matrix is computed inside if needed during the building */
+#     pragma omp for CS_CDO_OMP_SCHEDULE
+      for (cs_lnum_t i = s; i < e; i++) {
 
-      cs_cdofb_vecteq_conv_diff_reac(eqp, eqb, eqc, cm,
-                                     mass_hodge, diff_hodge,
-                                     csys, cb);
-
-      const short int  n_f = cm->n_fc;
-      const bool  has_sourceterm = cs_equation_param_has_sourceterm(eqp);
-
-      if (has_sourceterm) { /* SOURCE TERM
-                             * =========== */
-
-        if (compute_initial_source) { /* First time step */
-
-          cs_cdofb_vecteq_sourceterm(cm, eqp, t_cur, tcoef,  /* time scaling */
-                                     mass_hodge,
-                                     cb, eqb, csys);
-
-        }
-        else { /* Add the contribution of the previous time step */
-
-          for (short int k = 0; k < 3; k++)
-            csys->rhs[3*n_f + k] += tcoef * eqc->source_terms[3*c_id + k];
-
-        }
-
-        cs_cdofb_vecteq_sourceterm(cm, eqp,
-                                   cb->t_st_eval, eqp->theta, /* time scaling */
-                                   mass_hodge,
-                                   cb, eqb, csys);
-
-      } /* End of term source */
-
-      /* First part of the BOUNDARY CONDITIONS
-       *                   ===================
-       * Apply a part of BC before the time scheme */
-
-      _vfb_apply_bc_partly(eqp, eqc, cm, fm, diff_hodge, csys, cb);
-
-      /* UNSTEADY TERM + TIME SCHEME
-       * =========================== */
-
-      /* STEP.1 >> Compute the contribution of the "adr" to the RHS:
-       *           tcoef*adr_pn where adr_pn = csys->mat * p_n */
-
-      double  *adr_pn = cb->values;
-      cs_sdm_block_matvec(csys->mat, csys->val_n, adr_pn);
-      for (short int i = 0; i < csys->n_dofs; i++) /* n_dofs = n_vc */
-        csys->rhs[i] -= tcoef * adr_pn[i];
-
-      /* STEP.2 >> Multiply csys->mat by theta */
-
-      for (int i = 0; i < csys->n_dofs*csys->n_dofs; i++)
-        csys->mat->val[i] *= eqp->theta;
-
-      /* STEP.3 >> Handle the mass matrix
-       * Two contributions for the mass matrix
-       *  a) add to csys->mat
-       *  b) add to rhs mass_mat * p_n */
-
-      if (!(eqb->time_pty_uniform))
-        cb->tpty_val = cs_property_value_in_cell(cm, eqp->time_property,
-                                                 cb->t_pty_eval);
-
-      if (eqb->sys_flag & CS_FLAG_SYS_TIME_DIAG) { /* Mass lumping */
-
-        const double  ptyc = cb->tpty_val * cm->vol_c * inv_dtcur;
-
-        /* Get cell-cell block */
-        cs_sdm_t *acc = cs_sdm_get_block(csys->mat, n_f, n_f);
-
-        for (short int k = 0; k < 3; k++) {
-
-          csys->rhs[3*n_f + k] += ptyc * csys->val_n[3*n_f+k];
-
-          /* Simply add an entry in mat[cell, cell] */
-          acc->val[4*k] += ptyc;
-
-        }
-
-      }
-      else
-        bft_error(__FILE__, __LINE__, 0,
-                  "Only diagonal time treatment available so far.");
-
-      /* STATIC CONDENSATION
-       * ===================
-       * Static condensation of the local system matrix of size n_fc + 1 into
-       * a matrix of size n_fc.
-       * Store data in rc_tilda and acf_tilda to compute the values at cell
-       * centers after solving the system */
-
-      cs_static_condensation_vector_eq(connect->c2f,
-                                       eqc->rc_tilda, eqc->acf_tilda,
-                                       cb, csys);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 1
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> Cell system matrix after static condensation",
-                         csys);
-#endif
-
-      /* Remaining part of BOUNDARY CONDITIONS
-       * ===================================== */
-
-      _vfb_apply_remaining_bc(eqp, eqc, eqb, cm, fm, diff_hodge, csys, cb);
-
-#if defined(DEBUG) && !defined(NDEBUG) && CS_CDOFB_VECTEQ_DBG > 0
-      if (cs_dbg_cw_test(eqp, cm, csys))
-        cs_cell_sys_dump(">> (FINAL) Cell system matrix", csys);
-#endif
+        const cs_lnum_t  c_id = (colors == NULL) ? i : colors->ids[i];
 
-      /* ASSEMBLY PROCESS */
-      /* ================ */
+        _vfb_theta_cw_build(c_id, eqp, eqb, eqc, fld->val,
+                            compute_initial_source, t_cur, tcoef, inv_dtcur,
+                            mass_hodge, diff_hodge, fm, cm, csys, cb, asb, rhs);
 
-      cs_cdofb_vecteq_assembly(csys, sh->blocks[0], rhs, eqc, asb);
+      } /* Main loop on cells */
 
-    } /* Main loop on cells */
+    } /* Loop on colors */
 
   } /* OPENMP Block */
 
@@ -1669,6 +1907,7 @@ cs_cdofb_vecteq_init_context(const cs_equation_param_t   *eqp,
   /* Diffusion term */
 
   eqc->get_stiffness_matrix = NULL;
+  eqc->stiffness_cache = NULL;  /* Not used for vector-valued eq. */
   eqc->diffusion_hodge = NULL;
   eqc->enforce_robin_bc = NULL;
 
@@ -1812,6 +2051,7 @@ cs_cdofb_vecteq_init_context(const cs_equation_param_t   *eqp,
   eqc->mass_hodgep.coef = cs_math_1ov3;
 
   eqc->get_mass_matrix = NULL;
+  eqc->mass_cache = NULL;  /* Not used for vector-valued eq. */
   eqc->mass_hodge = NULL;
 
   if (eqb->sys_flag & CS_FLAG_SYS_MASS_MATRIX) {
@@ -31,6 +31,7 @@
 
 #include "cs_defs.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 #include "cs_cdo_advection.h"
 #include "cs_equation_bc.h"
 #include "cs_equation_builder.h"
@@ -138,6 +139,7 @@ struct _cs_cdovb_t {
 
   cs_hodge_t              **diffusion_hodge;
   cs_hodge_compute_t       *get_stiffness_matrix;
+  cs_hodge_cache_t         *stiffness_cache;   /* NULL if not used */
 
   /* Pointer of function to build the advection term */
 
@@ -158,6 +160,7 @@ struct _cs_cdovb_t {
   cs_hodge_param_t          mass_hodgep;
   cs_hodge_t              **mass_hodge;
   cs_hodge_compute_t       *get_mass_matrix;
+  cs_hodge_cache_t         *mass_cache;        /* NULL if not used */
 
 };
 
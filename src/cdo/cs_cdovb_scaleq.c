@@ -56,6 +56,7 @@
 #include "cs_equation_bc.h"
 #include "cs_evaluate.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 #include "cs_log.h"
 #include "cs_math.h"
 #include "cs_mesh_location.h"
@@ -425,7 +426,8 @@ _svb_conv_diff_reac(const cs_equation_param_t     *eqp,
 
     /* Build the mass matrix and store it in mass_hodge->matrix */
 
-    eqc->get_mass_matrix(cm, mass_hodge, cb);
+    cs_hodge_cache_compute(eqc->mass_cache, eqc->get_mass_matrix,
+                           cm, mass_hodge, cb, mass_hodge->matrix);
 
 #if defined(DEBUG) && !defined(NDEBUG) && CS_CDOVB_SCALEQ_DBG > 1
     if (cs_dbg_cw_test(eqp, cm, csys)) {
@@ -447,9 +449,11 @@ _svb_conv_diff_reac(const cs_equation_param_t     *eqp,
                                      diff_hodge);
 
     /* Define the local stiffness matrix: local matrix owned by the cellwise
-       builder (store in cb->loc) */
+       builder (store in cb->loc). Retrieved from the cache if possible */
 
-    bool  computed = eqc->get_stiffness_matrix(cm, diff_hodge, cb);
+    bool  computed = cs_hodge_cache_compute(eqc->stiffness_cache,
+                                            eqc->get_stiffness_matrix,
+                                            cm, diff_hodge, cb, cb->loc);
 
     /* Add the local diffusion operator to the local system */
 
@@ -1136,8 +1140,11 @@ _svb_cw_rhs_normalization(cs_param_resnorm_type_t     type,
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief   Perform the assembly step for scalar-valued CDO Vb schemes
+ *          The matrix is not assembled when the matrix of another equation
+ *          is used.
  *
  * \param[in]      csys   pointer to a cellwise view of the system
+ * \param[in]      eqb    pointer to a cs_equation_builder_t structure
  * \param[in, out] block  pointer to a block structure
  * \param[in, out] rhs    right-hand side array
  * \param[in, out] eqc    context for this kind of discretization
@@ -1146,11 +1153,12 @@ _svb_cw_rhs_normalization(cs_param_resnorm_type_t     type,
 /*----------------------------------------------------------------------------*/
 
 static void
-_svb_assemble(const cs_cell_sys_t        *csys,
-              cs_cdo_system_block_t      *block,
-              cs_real_t                  *rhs,
-              cs_cdovb_scaleq_t          *eqc,
-              cs_cdo_assembly_t          *asb)
+_svb_assemble(const cs_cell_sys_t          *csys,
+              const cs_equation_builder_t  *eqb,
+              cs_cdo_system_block_t        *block,
+              cs_real_t                    *rhs,
+              cs_cdovb_scaleq_t            *eqc,
+              cs_cdo_assembly_t            *asb)
 {
   assert(block != NULL && rhs != NULL);
   assert(block->type == CS_CDO_SYSTEM_BLOCK_DEFAULT);
@@ -1158,7 +1166,8 @@ _svb_assemble(const cs_cell_sys_t        *csys,
 
   /* Matrix assembly */
 
-  db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
+  if (eqb->matrix_owner == NULL)
+    db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
 
   /* RHS assembly */
 
@@ -1210,6 +1219,101 @@ _svb_assemble(const cs_cell_sys_t        *csys,
 #endif
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Initialize the algebraic system. Only the rhs is initialized when
+ *          the matrix of another equation is used.
+ *
+ * \param[in, out] eqb     pointer to a cs_equation_builder_t structure
+ * \param[in, out] p_rhs   double pointer to the rhs array
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_svb_init_system(cs_equation_builder_t    *eqb,
+                 cs_real_t               **p_rhs)
+{
+  if (eqb->matrix_owner == NULL)
+    cs_cdo_system_helper_init_system(eqb->system_helper, p_rhs);
+  else
+    cs_cdo_system_helper_init_rhs(eqb->system_helper, p_rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Finalize the assembly of the algebraic system
+ *
+ * \param[in, out] eqb     pointer to a cs_equation_builder_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_svb_finalize_assembly(cs_equation_builder_t    *eqb)
+{
+  if (eqb->matrix_owner == NULL)
+    cs_cdo_system_helper_finalize_assembly(eqb->system_helper);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Retrieve the matrix and the linear solver to use. When the matrix
+ *          is shared with other equations, the setup of the linear solver is
+ *          shared as well. Thus, the setup related to the previous matrix is
+ *          freed only when a new matrix has been built.
+ *
+ * \param[in]      eqp      pointer to a cs_equation_param_t structure
+ * \param[in, out] eqb      pointer to a cs_equation_builder_t structure
+ * \param[out]     p_sles   pointer to the linear solver to use
+ *
+ * \return a pointer to the matrix to use
+ */
+/*----------------------------------------------------------------------------*/
+
+static const cs_matrix_t *
+_svb_get_matrix(const cs_equation_param_t    *eqp,
+                cs_equation_builder_t        *eqb,
+                cs_sles_t                   **p_sles)
+{
+  if (eqb->matrix_owner != NULL) {
+
+    *p_sles = cs_sles_find_or_add(eqb->owner_sles_id, NULL);
+
+    return cs_equation_builder_get_shared_matrix(eqp, eqb);
+
+  }
+
+  cs_sles_t  *sles = cs_sles_find_or_add(eqp->sles_param->field_id, NULL);
+
+  if (eqb->keep_matrix)
+    cs_sles_free(sles);
+
+  *p_sles = sles;
+
+  return cs_cdo_system_get_matrix(eqb->system_helper, 0);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Free the algebraic system after the resolution. The matrix and the
+ *          setup of the linear solver are kept if other equations use them.
+ *
+ * \param[in, out] eqb      pointer to a cs_equation_builder_t structure
+ * \param[in, out] sles     pointer to the linear solver used
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_svb_free_system(cs_equation_builder_t    *eqb,
+                 cs_sles_t                *sles)
+{
+  if (eqb->keep_matrix)
+    cs_equation_builder_keep_matrix(eqb);
+  else if (eqb->matrix_owner == NULL)
+    cs_sles_free(sles);
+
+  cs_cdo_system_helper_reset(eqb->system_helper); /* free rhs and matrix */
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -1395,6 +1499,7 @@ cs_cdovb_scaleq_init_context(const cs_equation_param_t   *eqp,
 
   eqc->diffusion_hodge = NULL;
   eqc->get_stiffness_matrix = NULL;
+  eqc->stiffness_cache = NULL;
 
   if (cs_equation_param_has_diffusion(eqp)) {
 
@@ -1444,6 +1549,20 @@ cs_cdovb_scaleq_init_context(const cs_equation_param_t   *eqp,
 
     } /* Switch on Hodge algo. */
 
+    /* Local stiffness matrices are kept from one build to another */
+
+    if (cs_hodge_cache_is_allowed(eqp, eqp->diffusion_property)) {
+
+      cs_property_type_t  pty_type =
+        cs_property_get_type(eqp->diffusion_property);
+
+      eqc->stiffness_cache =
+        cs_hodge_cache_create(connect->c2v,
+                              0,                              /* extra DoFs */
+                              !(pty_type & CS_PROPERTY_ANISO)); /* sym. ? */
+
+    }
+
   } /* Diffusion term is requested */
 
   /* Boundary conditions */
@@ -1922,6 +2041,12 @@ cs_cdovb_scaleq_init_context(const cs_equation_param_t   *eqp,
 
   eqc->get_mass_matrix = cs_hodge_get_func(__func__, eqc->mass_hodgep);
 
+  /* The mass matrix only depends on the mesh */
+
+  eqc->mass_cache = NULL;
+  if (eqp->cache_cw_operators && eqb->sys_flag & CS_FLAG_SYS_MASS_MATRIX)
+    eqc->mass_cache = cs_hodge_cache_create(connect->c2v, 0, true);
+
   if (eqp->incremental_algo_type == CS_PARAM_NL_ALGO_ANDERSON)
     eqb->incremental_algo->context =
       cs_iter_algo_aa_create(eqp->incremental_anderson_param, n_vertices);
@@ -2009,6 +2134,9 @@ cs_cdovb_scaleq_free_context(void   *scheme_context)
   cs_hodge_free_context(&(eqc->diffusion_hodge));
   cs_hodge_free_context(&(eqc->mass_hodge));
 
+  cs_hodge_cache_free(&(eqc->stiffness_cache));
+  cs_hodge_cache_free(&(eqc->mass_cache));
+
   /* Last free */
 
   BFT_FREE(eqc);
@@ -2486,7 +2614,7 @@ cs_cdovb_scaleq_solve_steady_state(bool                        cur2prev,
   double  rhs_norm = 0.;
   cs_real_t  *rhs = NULL;
 
-  cs_cdo_system_helper_init_system(sh, &rhs);
+  _svb_init_system(eqb, &rhs);
 
   /* ------------------------- */
   /* Main OpenMP block on cell */
@@ -2600,7 +2728,7 @@ cs_cdovb_scaleq_solve_steady_state(bool                        cur2prev,
       /* Assembly process
        * ================ */
 
-      _svb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      _svb_assemble(csys, eqb, sh->blocks[0], rhs, eqc, asb);
 
     } /* Main loop on cells */
 
@@ -2608,7 +2736,7 @@ cs_cdovb_scaleq_solve_steady_state(bool                        cur2prev,
 
   /* Free temporary buffers and structures */
 
-  cs_cdo_system_helper_finalize_assembly(sh);
+  _svb_finalize_assembly(eqb);
   cs_equation_builder_reset(eqb);
 
   /* End of the system building */
@@ -2632,8 +2760,8 @@ cs_cdovb_scaleq_solve_steady_state(bool                        cur2prev,
                              rhs,
                              &rhs_norm);
 
-  cs_sles_t  *sles = cs_sles_find_or_add(eqp->sles_param->field_id, NULL);
-  cs_matrix_t  *matrix = cs_cdo_system_get_matrix(sh, 0);
+  cs_sles_t  *sles = NULL;
+  const cs_matrix_t  *matrix = _svb_get_matrix(eqp, eqb, &sles);
   cs_range_set_t  *range_set = cs_cdo_system_get_range_set(sh, 0);
 
   cs_cdo_solve_scalar_system(eqc->n_dofs,
@@ -2649,8 +2777,7 @@ cs_cdovb_scaleq_solve_steady_state(bool                        cur2prev,
   cs_timer_t  t2 = cs_timer_time();
   cs_timer_counter_add_diff(&(eqb->tcs), &t1, &t2);
 
-  cs_sles_free(sles);
-  cs_cdo_system_helper_reset(sh);      /* free rhs and matrix */
+  _svb_free_system(eqb, sles);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -2844,7 +2971,7 @@ cs_cdovb_scaleq_solve_steady_state_incr(bool                        cur2prev,
       /* Assembly process
        * ================ */
 
-      _svb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      _svb_assemble(csys, eqb, sh->blocks[0], rhs, eqc, asb);
 
     } /* Main loop on cells */
 
@@ -2965,7 +3092,7 @@ cs_cdovb_scaleq_solve_implicit(bool                        cur2prev,
   double  rhs_norm = 0.;
   cs_real_t  *rhs = NULL;
 
-  cs_cdo_system_helper_init_system(sh, &rhs);
+  _svb_init_system(eqb, &rhs);
 
   /* ------------------------- */
   /* Main OpenMP block on cell */
@@ -3090,7 +3217,7 @@ cs_cdovb_scaleq_solve_implicit(bool                        cur2prev,
       /* Assembly process
        * ================ */
 
-      _svb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      _svb_assemble(csys, eqb, sh->blocks[0], rhs, eqc, asb);
 
     } /* Main loop on cells */
 
@@ -3098,7 +3225,7 @@ cs_cdovb_scaleq_solve_implicit(bool                        cur2prev,
 
   /* Free temporary buffers and structures */
 
-  cs_cdo_system_helper_finalize_assembly(sh);
+  _svb_finalize_assembly(eqb);
   cs_equation_builder_reset(eqb);
 
   /* Copy current field values to previous values */
@@ -3122,8 +3249,8 @@ cs_cdovb_scaleq_solve_implicit(bool                        cur2prev,
                              rhs,
                              &rhs_norm);
 
-  cs_sles_t  *sles = cs_sles_find_or_add(eqp->sles_param->field_id, NULL);
-  cs_matrix_t  *matrix = cs_cdo_system_get_matrix(sh, 0);
+  cs_sles_t  *sles = NULL;
+  const cs_matrix_t  *matrix = _svb_get_matrix(eqp, eqb, &sles);
   cs_range_set_t  *range_set = cs_cdo_system_get_range_set(sh, 0);
 
   cs_cdo_solve_scalar_system(eqc->n_dofs,
@@ -3139,8 +3266,7 @@ cs_cdovb_scaleq_solve_implicit(bool                        cur2prev,
   cs_timer_t  t2 = cs_timer_time();
   cs_timer_counter_add_diff(&(eqb->tcs), &t1, &t2);
 
-  cs_sles_free(sles);
-  cs_cdo_system_helper_reset(sh);      /* free rhs and matrix */
+  _svb_free_system(eqb, sles);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -3360,7 +3486,7 @@ cs_cdovb_scaleq_solve_implicit_incr(bool                        cur2prev,
       /* Assembly process
        * ================ */
 
-      _svb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      _svb_assemble(csys, eqb, sh->blocks[0], rhs, eqc, asb);
 
     } /* Main loop on cells */
 
@@ -3479,7 +3605,7 @@ cs_cdovb_scaleq_solve_theta(bool                        cur2prev,
   double  rhs_norm = 0.;
   cs_real_t  *rhs = NULL;  /* Since it is NULL, sh get sthe ownership */
 
-  cs_cdo_system_helper_init_system(sh, &rhs);
+  _svb_init_system(eqb, &rhs);
 
   const double  tcoef = 1 - eqp->theta;
 
@@ -3664,7 +3790,7 @@ cs_cdovb_scaleq_solve_theta(bool                        cur2prev,
       /* Assembly process
        * ================ */
 
-      _svb_assemble(csys, sh->blocks[0], rhs, eqc, asb);
+      _svb_assemble(csys, eqb, sh->blocks[0], rhs, eqc, asb);
 
     } /* Main loop on cells */
 
@@ -3672,7 +3798,7 @@ cs_cdovb_scaleq_solve_theta(bool                        cur2prev,
 
   /* Free temporary buffers and structures */
 
-  cs_cdo_system_helper_finalize_assembly(sh);
+  _svb_finalize_assembly(eqb);
   cs_equation_builder_reset(eqb);
 
   /* Copy current field values to previous values */
@@ -3696,8 +3822,8 @@ cs_cdovb_scaleq_solve_theta(bool                        cur2prev,
                              rhs,
                              &rhs_norm);
 
-  cs_sles_t  *sles = cs_sles_find_or_add(eqp->sles_param->field_id, NULL);
-  cs_matrix_t  *matrix = cs_cdo_system_get_matrix(sh, 0);
+  cs_sles_t  *sles = NULL;
+  const cs_matrix_t  *matrix = _svb_get_matrix(eqp, eqb, &sles);
   cs_range_set_t  *range_set = cs_cdo_system_get_range_set(sh, 0);
 
   cs_cdo_solve_scalar_system(eqc->n_dofs,
@@ -3713,8 +3839,7 @@ cs_cdovb_scaleq_solve_theta(bool                        cur2prev,
   cs_timer_t  t2 = cs_timer_time();
   cs_timer_counter_add_diff(&(eqb->tcs), &t1, &t2);
 
-  cs_sles_free(sles);
-  cs_cdo_system_helper_reset(sh);      /* free rhs and matrix */
+  _svb_free_system(eqb, sles);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -881,7 +881,7 @@ cs_cdovb_vecteq_init_context(const cs_equation_param_t   *eqp,
   /* Diffusion term */
 
   eqc->get_stiffness_matrix = NULL;
-  eqc->get_stiffness_matrix = NULL;
+  eqc->stiffness_cache = NULL;  /* Not used for vector-valued eq. */
 
   if (cs_equation_param_has_diffusion(eqp)) {
 
@@ -1118,6 +1118,7 @@ cs_cdovb_vecteq_init_context(const cs_equation_param_t   *eqp,
   /* Set the function pointer */
 
   eqc->get_mass_matrix = cs_hodge_get_func(__func__, eqc->mass_hodgep);
+  eqc->mass_cache = NULL;  /* Not used for vector-valued eq. */
 
   /* Helper structures (range set, interface set, matrix structure and all the
      assembly process) */
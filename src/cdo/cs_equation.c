@@ -179,20 +179,24 @@ _prepare_fb_solving(void              *eq_to_cast,
                     cs_real_t         *p_x[])
 {
   cs_equation_t  *eq = (cs_equation_t  *)eq_to_cast;
-  cs_equation_param_t  *eqp = eq->param;
   cs_equation_builder_t  *eqb = eq->builder;
 
   const cs_range_set_t  *rset = cs_equation_builder_get_range_set(eqb, 0);
   const cs_matrix_t *matrix = cs_equation_builder_get_matrix(eqb, 0);
-  const cs_lnum_t  n_dofs = eqp->dim * rset->n_elts[1];
+  const cs_lnum_t  n_dofs = rset->n_elts[1];
   const cs_real_t  *f_values = eq->get_face_values(eq->scheme_context, false);
   const int  stride = 1;  /* Since the global numbering is adapted in each
                              case (scalar-, vector-valued equations) */
 
   assert(f_values != NULL);
 
+  /* No matrix in the matrix-free mode (HHO schemes) */
+
+  const cs_lnum_t  x_size =
+    (matrix == NULL) ? n_dofs : CS_MAX(n_dofs, cs_matrix_get_n_columns(matrix));
+
   cs_real_t  *x = NULL;
-  BFT_MALLOC(x, CS_MAX(n_dofs, cs_matrix_get_n_columns(matrix)), cs_real_t);
+  BFT_MALLOC(x, x_size, cs_real_t);
 
   /* x and the right-hand side are a "gathered" view of field->val and the
    * right-hand side respectively through the range set operation.
@@ -437,6 +441,42 @@ _add_field(int               n_previous,
     cs_timer_stats_stop(eq->main_ts_id);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check if two sets of parameters lead to the same linear solver
+ *        (same solver, preconditioner and stopping criteria). The name, the
+ *        field id and the verbosity are not compared.
+ *
+ * \param[in] a      first set of parameters related to a linear solver
+ * \param[in] b      second set of parameters related to a linear solver
+ *
+ * \return true if the two sets lead to the same linear solver
+ */
+/*----------------------------------------------------------------------------*/
+
+static bool
+_same_sles_param(const cs_param_sles_t    *a,
+                 const cs_param_sles_t    *b)
+{
+  if (a->solver_class != b->solver_class ||
+      a->precond != b->precond ||
+      a->solver != b->solver ||
+      a->flexible != b->flexible ||
+      a->restart != b->restart ||
+      a->amg_type != b->amg_type ||
+      a->pcd_block_type != b->pcd_block_type ||
+      a->resnorm_type != b->resnorm_type)
+    return false;
+
+  const cs_param_sles_cvg_t  ca = a->cvg_param, cb = b->cvg_param;
+
+  if (fabs(ca.atol - cb.atol) > 0 || fabs(ca.rtol - cb.rtol) > 0 ||
+      fabs(ca.dtol - cb.dtol) > 0 || ca.n_max_iter != cb.n_max_iter)
+    return false;
+
+  return true;
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -1355,6 +1395,101 @@ cs_equation_add_build_hook(cs_equation_t               *eq,
                 eqp->name);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Share the matrix of the equation "owner" with the equation "eq".
+ *        Both equations have to lead to exactly the same matrix (same
+ *        discretization, same properties, same boundary conditions and same
+ *        enforcement). This is not checked. Only the right-hand side of eq is
+ *        then assembled and the linear solver of owner and its setup (for
+ *        instance a multigrid hierarchy) are reused. Thus, the settings of
+ *        the linear solver have to be the same for both equations (this is
+ *        checked). The equation owner has to be solved before eq at each
+ *        resolution.
+ *        Only for an advanced usage. Only scalar-valued CDO-Vb schemes without
+ *        incremental resolution are handled up to now.
+ *
+ * \param[in, out] eq        pointer to the cs_equation_t stucture to update
+ * \param[in, out] owner     pointer to the equation owning the matrix
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_equation_share_matrix(cs_equation_t               *eq,
+                         cs_equation_t               *owner)
+{
+  if (eq == NULL || owner == NULL)
+    bft_error(__FILE__, __LINE__, 0, _err_empty_eq, __func__);
+  if (eq == owner)
+    return;
+
+  cs_equation_param_t  *eqp = eq->param;
+  const cs_equation_param_t  *own_eqp = owner->param;
+  assert(eqp != NULL && own_eqp != NULL);
+
+  if (eq->builder == NULL || owner->builder == NULL)
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Initialization of equations %s and %s has not been done"
+              " yet.\n Please call this operation later in"
+              " cs_user_extra_operations_initialize() for instance.",
+              __func__, eqp->name, own_eqp->name);
+
+  const cs_equation_param_t  *eqp_list[2] = {eqp, own_eqp};
+
+  for (int i = 0; i < 2; i++) {
+
+    const cs_equation_param_t  *_eqp = eqp_list[i];
+
+    if (_eqp->space_scheme != CS_SPACE_SCHEME_CDOVB || _eqp->dim != 1)
+      bft_error(__FILE__, __LINE__, 0,
+                " %s: Eq. %s. Only scalar-valued CDO-Vb schemes are handled.",
+                __func__, _eqp->name);
+
+    if (_eqp->incremental_algo_type != CS_PARAM_NL_ALGO_NONE ||
+        _eqp->flag & CS_EQUATION_INSIDE_SYSTEM)
+      bft_error(__FILE__, __LINE__, 0,
+                " %s: Eq. %s. Case not handled (incremental resolution or"
+                " equation inside a system).", __func__, _eqp->name);
+
+  }
+
+  if (eqp->time_scheme != own_eqp->time_scheme)
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Equations %s and %s have a different time scheme.",
+              __func__, eqp->name, own_eqp->name);
+
+  /* The linear solver of owner is used to solve eq. */
+
+  if (!_same_sles_param(eqp->sles_param, own_eqp->sles_param))
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Equations %s and %s have different settings for the"
+              " linear solver.\n The linear solver of %s would be used for"
+              " both equations.\n Please use the same settings.",
+              __func__, eqp->name, own_eqp->name, own_eqp->name);
+
+  cs_equation_builder_t  *eqb = eq->builder;
+  cs_equation_builder_t  *own_eqb = owner->builder;
+
+  if (eqb->keep_matrix || eqb->matrix_owner != NULL ||
+      own_eqb->matrix_owner != NULL)
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Equation %s already shares a matrix or equation %s uses"
+              " the matrix of another equation.",
+              __func__, eqp->name, own_eqp->name);
+
+  own_eqb->keep_matrix = true;
+
+  eqb->matrix_owner = own_eqb;
+  eqb->owner_sles_id = own_eqp->sles_param->field_id;
+  eqb->owner_matrix_state = own_eqb->matrix_state;
+
+  /* Add an entry in the setup log file (this is done after the main setup
+   * log but one needs to initialize equations before calling this function) */
+
+  cs_log_printf(CS_LOG_SETUP, " Equation %s: Use the matrix of equation %s\n",
+                eqp->name, own_eqp->name);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Return true is the given equation is steady otherwise false
@@ -1859,6 +1994,32 @@ cs_equation_set_sles(void)
     if (eqp->type != CS_EQUATION_TYPE_NAVSTO)
       cs_equation_param_set_sles(eqp);
 
+    /* In the matrix-free mode, HHO schemes rely on a specific linear solver
+       which replaces the previous definition */
+
+    if (eqp->matrix_free) {
+
+      switch (eqp->space_scheme) {
+
+      case CS_SPACE_SCHEME_HHO_P0:
+      case CS_SPACE_SCHEME_HHO_P1:
+      case CS_SPACE_SCHEME_HHO_P2:
+        if (eqp->dim == 1)
+          cs_hho_scaleq_set_sles(eqp, eq->builder, eq->scheme_context);
+        else if (eqp->dim == 3)
+          cs_hho_vecteq_set_sles(eqp, eq->builder, eq->scheme_context);
+        break;
+
+      default:
+        bft_error(__FILE__, __LINE__, 0,
+                  " %s: Equation \"%s\". The matrix-free mode is only"
+                  " available with HHO schemes.\n", __func__, eqp->name);
+        break;
+
+      }
+
+    }
+
     if (eq->main_ts_id > -1)
       cs_timer_stats_stop(eq->main_ts_id);
 
@@ -2829,6 +2990,17 @@ cs_equation_solve_deprecated(cs_equation_t   *eq)
 
   const cs_matrix_t  *matrix = cs_cdo_system_get_matrix(sh, 0);
 
+  /* In the matrix-free mode, there is no matrix. Options of the linear solver
+     relying on the matrix can not be used */
+
+  if (eqp->matrix_free &&
+      (cs_sles_get_allow_no_op(sles) || cs_sles_get_post_output(sles) != 0))
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Equation \"%s\" is solved in a matrix-free way.\n"
+              " The options \"allow_no_op\" and the post-processing of the"
+              " residual of the linear solver are not compatible.\n",
+              __func__, eqp->name);
+
   cs_sles_convergence_state_t code = cs_sles_solve(sles,
                                                    matrix,
                                                    slesp->cvg_param.rtol,
@@ -351,6 +351,29 @@ cs_equation_add_build_hook(cs_equation_t               *eq,
                            void                        *context,
                            cs_equation_build_hook_t    *func);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Share the matrix of the equation "owner" with the equation "eq".
+ *        Both equations have to lead to exactly the same matrix (same
+ *        discretization, same properties, same boundary conditions and same
+ *        enforcement). This is not checked. Only the right-hand side of eq is
+ *        then assembled and the linear solver of owner and its setup (for
+ *        instance a multigrid hierarchy) are reused. Thus, the settings of
+ *        the linear solver have to be the same for both equations (this is
+ *        checked). The equation owner has to be solved before eq at each
+ *        resolution.
+ *        Only for an advanced usage. Only scalar-valued CDO-Vb schemes without
+ *        incremental resolution are handled up to now.
+ *
+ * \param[in, out] eq        pointer to the cs_equation_t stucture to update
+ * \param[in, out] owner     pointer to the equation owning the matrix
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_equation_share_matrix(cs_equation_t               *eq,
+                         cs_equation_t               *owner);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Return the cs_equation_builder_t structure associated to a
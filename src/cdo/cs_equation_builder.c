@@ -195,6 +195,16 @@ cs_equation_builder_create(const cs_equation_param_t   *eqp,
                                        eqp->bc_defs,
                                        mesh->n_b_faces);
 
+  /* Matrix shared with other equations */
+
+  eqb->keep_matrix = false;
+  eqb->shared_matrix = NULL;
+  eqb->matrix_state = 0;
+
+  eqb->matrix_owner = NULL;
+  eqb->owner_sles_id = -1;
+  eqb->owner_matrix_state = 0;
+
   /* User hook function */
 
   eqb->hook_context = NULL;
@@ -273,6 +283,68 @@ cs_equation_builder_get_range_set(const cs_equation_builder_t  *builder,
   return cs_cdo_system_get_range_set(sh, block_id);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Keep the matrix of the first block of the system helper after the
+ *        resolution so that other equations can use it. The matrix kept at a
+ *        previous call is freed.
+ *
+ * \param[in, out]  eqb      pointer to a cs_equation_builder_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_equation_builder_keep_matrix(cs_equation_builder_t  *eqb)
+{
+  if (eqb == NULL)
+    return;
+
+  assert(eqb->keep_matrix);
+
+  if (eqb->shared_matrix != NULL) {
+    cs_matrix_release_coefficients(eqb->shared_matrix);
+    cs_matrix_destroy(&(eqb->shared_matrix));
+  }
+
+  eqb->shared_matrix = cs_cdo_system_detach_matrix(eqb->system_helper, 0);
+  eqb->matrix_state += 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Retrieve the matrix of the owner equation when the matrix is shared.
+ *        The owner equation has to be solved before each resolution of the
+ *        equations sharing its matrix. An error is raised otherwise.
+ *
+ * \param[in]       eqp      pointer to a cs_equation_param_t structure
+ * \param[in, out]  eqb      pointer to a cs_equation_builder_t structure
+ *
+ * \return a pointer to a cs_matrix_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_matrix_t *
+cs_equation_builder_get_shared_matrix(const cs_equation_param_t  *eqp,
+                                      cs_equation_builder_t      *eqb)
+{
+  if (eqb == NULL)
+    return NULL;
+
+  const cs_equation_builder_t  *owner = eqb->matrix_owner;
+  assert(owner != NULL);
+
+  if (owner->shared_matrix == NULL ||
+      owner->matrix_state == eqb->owner_matrix_state)
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Equation \"%s\" shares the matrix of another equation.\n"
+              " The matrix of this equation is not up to date. The owner"
+              " equation has to be solved first.\n", __func__, eqp->name);
+
+  eqb->owner_matrix_state = owner->matrix_state;
+
+  return owner->shared_matrix;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Free a cs_equation_builder_t structure
@@ -297,6 +369,13 @@ cs_equation_builder_free(cs_equation_builder_t  **p_builder)
   if (eqb->source_mask != NULL)
     BFT_FREE(eqb->source_mask);
 
+  /* Matrix kept for other equations (may be NULL) */
+
+  if (eqb->shared_matrix != NULL) {
+    cs_matrix_release_coefficients(eqb->shared_matrix);
+    cs_matrix_destroy(&(eqb->shared_matrix));
+  }
+
   cs_cdo_system_helper_free(&eqb->system_helper);
 
   /* Quantities related to the incremental resolution (may be NULL) */
@@ -150,6 +150,41 @@ struct _equation_builder_t {
 
   cs_cdo_system_helper_t     *system_helper;
 
+  /*!
+   * @}
+   * @name Matrix shared with other equations
+   * @{
+   *
+   * \var keep_matrix
+   * true if other equations rely on the matrix of this equation. The matrix
+   * and the setup of the linear solver are then kept after the resolution.
+   *
+   * \var shared_matrix
+   * Matrix kept after the last resolution (only if keep_matrix is true)
+   *
+   * \var matrix_state
+   * Counter incremented each time a new matrix is kept
+   *
+   * \var matrix_owner
+   * Builder of the equation whose matrix is used (NULL if the matrix is
+   * assembled as usual). Only the right-hand side is assembled otherwise.
+   *
+   * \var owner_sles_id
+   * Id of the linear solver related to the owner equation. The setup of the
+   * linear solver is shared as well.
+   *
+   * \var owner_matrix_state
+   * Value of matrix_state for the owner at the last use of its matrix
+   */
+
+  bool                          keep_matrix;
+  cs_matrix_t                  *shared_matrix;
+  int                           matrix_state;
+
+  const cs_equation_builder_t  *matrix_owner;
+  int                           owner_sles_id;
+  int                           owner_matrix_state;
+
   /*!
    * @}
    * @name Enforcement of degrees of freedom (DoFs)
@@ -321,6 +356,37 @@ cs_equation_builder_get_matrix(const cs_equation_builder_t  *builder,
 const cs_range_set_t *
 cs_equation_builder_get_range_set(const cs_equation_builder_t  *builder,
                                   int                           block_id);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Keep the matrix of the first block of the system helper after the
+ *        resolution so that other equations can use it. The matrix kept at a
+ *        previous call is freed.
+ *
+ * \param[in, out]  eqb      pointer to a cs_equation_builder_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_equation_builder_keep_matrix(cs_equation_builder_t  *eqb);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Retrieve the matrix of the owner equation when the matrix is shared.
+ *        The owner equation has to be solved before each resolution of the
+ *        equations sharing its matrix. An error is raised otherwise.
+ *
+ * \param[in]       eqp      pointer to a cs_equation_param_t structure
+ * \param[in, out]  eqb      pointer to a cs_equation_builder_t structure
+ *
+ * \return a pointer to a cs_matrix_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_matrix_t *
+cs_equation_builder_get_shared_matrix(const cs_equation_param_t  *eqp,
+                                      cs_equation_builder_t      *eqb);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Free a cs_equation_builder_t structure
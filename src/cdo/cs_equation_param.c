@@ -46,6 +46,7 @@
 
 #include "cs_boundary_zone.h"
 #include "cs_cdo_advection.h"
+#include "cs_cdo_assembly.h"
 #include "cs_cdo_bc.h"
 #include "cs_hodge.h"
 #include "cs_log.h"
@@ -410,6 +411,13 @@ _set_key(cs_equation_param_t   *eqp,
                 __func__, eqp->weak_pena_bc_coeff, eqname);
     break;
 
+  case CS_EQKEY_CACHE_CW_OPERATORS:
+    if (strcmp(keyval, "true") == 0 || strcmp(keyval, "1") == 0)
+      eqp->cache_cw_operators = true;
+    else
+      eqp->cache_cw_operators = false;
+    break;
+
   case CS_EQKEY_DO_LUMPING:
     if (strcmp(keyval, "true") == 0 || strcmp(keyval, "1") == 0)
       eqp->do_lumping = true;
@@ -677,6 +685,26 @@ _set_key(cs_equation_param_t   *eqp,
     eqp->sles_param->restart = atoi(keyval);
     break;
 
+  case CS_EQKEY_MATRIX_FREE:
+    if (strcmp(keyval, "true") == 0 || strcmp(keyval, "1") == 0)
+      eqp->matrix_free = true;
+    else
+      eqp->matrix_free = false;
+    break;
+
+  case CS_EQKEY_OMP_ASSEMBLY_STRATEGY:
+    if (strcmp(keyval, "critical") == 0)
+      cs_cdo_assembly_set_cell_coloring(false);
+    else if (strcmp(keyval, "coloring") == 0)
+      cs_cdo_assembly_set_cell_coloring(true);
+    else {
+      const char *_val = keyval;
+      bft_error(__FILE__, __LINE__, 0,
+                emsg, __func__, eqname, _val,
+                "CS_EQKEY_OMP_ASSEMBLY_STRATEGY");
+    }
+    break;
+
   case CS_EQKEY_PRECOND:
     if (strcmp(keyval, "none") == 0) {
       eqp->sles_param->precond = CS_PARAM_PRECOND_NONE;
@@ -1308,6 +1336,8 @@ cs_equation_param_create(const char            *name,
   eqp->space_scheme = CS_SPACE_SCHEME_CDOVB;
   eqp->dof_reduction = CS_PARAM_REDUCTION_DERHAM;
   eqp->space_poly_degree = 0;
+  eqp->cache_cw_operators = false;
+  eqp->matrix_free = false;
 
   /* Default initialization for the legacy var_col_opt structure which is now
    * shared inside the cs_equation_param_t structure The default value used
@@ -1491,6 +1521,8 @@ cs_equation_param_copy_from(const cs_equation_param_t   *ref,
   dst->space_scheme = ref->space_scheme;
   dst->dof_reduction = ref->dof_reduction;
   dst->space_poly_degree = ref->space_poly_degree;
+  dst->cache_cw_operators = ref->cache_cw_operators;
+  dst->matrix_free = ref->matrix_free;
 
   /* Members originally located in the cs_var_cal_opt_t structure */
 
@@ -1988,6 +2020,12 @@ cs_equation_param_log(const cs_equation_param_t   *eqp)
 
   cs_log_printf(CS_LOG_SETUP, "  * %s | Space poly degree:  %d\n",
                 eqname, eqp->space_poly_degree);
+  if (eqp->cache_cw_operators)
+    cs_log_printf(CS_LOG_SETUP, "  * %s | Cellwise op. cache: %s\n",
+                  eqname, cs_base_strtf(eqp->cache_cw_operators));
+  if (eqp->matrix_free)
+    cs_log_printf(CS_LOG_SETUP, "  * %s | Matrix-free:        %s\n",
+                  eqname, cs_base_strtf(eqp->matrix_free));
   cs_log_printf(CS_LOG_SETUP, "  * %s | Verbosity:          %d\n",
                 eqname, eqp->verbosity);
 
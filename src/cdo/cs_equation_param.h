@@ -238,6 +238,21 @@ typedef struct {
 
   int                         space_poly_degree;
 
+  /*! \var cache_cw_operators
+   * Keep the cellwise operators (mass matrix and stiffness matrix) from one
+   * build of the system to another when they do not depend on time. This
+   * trades memory for a faster build of the system.
+   */
+
+  bool                        cache_cw_operators;
+
+  /*! \var matrix_free
+   * Apply the operator cellwise inside the iterative solver instead of
+   * assembling the global matrix. Only available with HHO schemes.
+   */
+
+  bool                        matrix_free;
+
   /*!
    * @}
    * @name Legacy Settings
@@ -901,6 +916,13 @@ typedef struct {
  * cf. \ref CS_PARAM_BC_ENFORCE_WEAK_NITSCHE
  * or  \ref CS_PARAM_BC_ENFORCE_WEAK_SYM
  *
+ * \var CS_EQKEY_CACHE_CW_OPERATORS
+ * Set to "true" or "false" (default). If "true", the cellwise mass matrices
+ * and the cellwise stiffness matrices are computed once and stored in memory.
+ * Stiffness matrices are stored only if the diffusion property is steady.
+ * Only available with CDO vertex-based and CDO face-based schemes for
+ * scalar-valued equations.
+ *
  * \var CS_EQKEY_DOF_REDUCTION
  * Set how is defined each degree of freedom (DoF).
  * - "de_rham" (default): Evaluation at vertices for potentials, integral
@@ -1064,6 +1086,25 @@ typedef struct {
  * iterative resolution of a linear system related to an equation.\n
  * - Example: "1e-10"
  *
+ * \var CS_EQKEY_MATRIX_FREE
+ * Set to "true" or "false" (default). If "true", the global matrix is not
+ * assembled: the cellwise operators are recomputed at each matrix-vector
+ * product. The linear system is solved with a conjugate gradient using a
+ * Jacobi preconditioner. The settings related to the solver and the
+ * preconditioner are thus not used (only the tolerance and the max. number of
+ * iterations are considered). Only available with HHO schemes.
+ *
+ * \var CS_EQKEY_OMP_ASSEMBLY_STRATEGY
+ * Set the strategy used to assemble cellwise systems when several OpenMP
+ * threads are used. Only CDO face-based schemes are concerned.
+ * - "critical" (default): threads update the global system inside atomic or
+ *   critical sections
+ * - "coloring": cells are colored so that two cells of the same color share
+ *   no face. Cells of a color are assembled without synchronization. The
+ *   coloring is shared by all the CDO face-based equations so that it is
+ *   activated for all of them. This has to be set in cs_user_parameters()
+ *   (see \ref cs_cdo_assembly_set_cell_coloring).
+ *
  * \var CS_EQKEY_PRECOND
  * Specify the preconditioner associated to an iterative solver. Be careful
  * some options are only available with a given solver class. Be sure that your
@@ -1217,6 +1258,7 @@ typedef enum {
   CS_EQKEY_BC_QUADRATURE,
   CS_EQKEY_BC_STRONG_PENA_COEFF,
   CS_EQKEY_BC_WEAK_PENA_COEFF,
+  CS_EQKEY_CACHE_CW_OPERATORS,
   CS_EQKEY_DO_LUMPING,
   CS_EQKEY_DOF_REDUCTION,
   CS_EQKEY_EXTRA_OP,
@@ -1232,6 +1274,7 @@ typedef enum {
   CS_EQKEY_ITSOL_RESNORM_TYPE,
   CS_EQKEY_ITSOL_RESTART,
   CS_EQKEY_ITSOL_RTOL,
+  CS_EQKEY_MATRIX_FREE,
   CS_EQKEY_OMP_ASSEMBLY_STRATEGY,
   CS_EQKEY_PRECOND,
   CS_EQKEY_PRECOND_BLOCK_TYPE,
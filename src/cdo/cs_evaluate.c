@@ -76,6 +76,11 @@ BEGIN_C_DECLS
 
 #define CS_CL  (CS_CL_SIZE/8)
 
+/* Number of elements whose quadrature points are gathered before calling an
+   analytic function */
+
+#define CS_EVALUATE_BATCH_SIZE 128
+
 /*=============================================================================
  * Local static variables
  *============================================================================*/
@@ -686,28 +691,34 @@ _dcvd_by_analytic(cs_real_t                        time_eval,
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief  Compute the integral over primal cells of a scalar-valued density
+ * \brief  Compute the integral (or the average) over primal cells of a density
  *         field defined by an analytical function on a selection of (primal)
- *         cells
+ *         cells. Cells are split into tetrahedra. The quadrature points of a
+ *         batch of cells are gathered so that the analytic function is called
+ *         only once per batch.
  *
- * \param[in]      time_eval     physical time at which one evaluates the term
- * \param[in]      ana               pointer to the analytic function
- * \param[in]      input             NULL or pointer cast on-the-fly
- * \param[in]      n_elts            number of elements to consider
- * \param[in]      elt_ids           pointer to the list of selected ids
- * \param[in]      compute_integral  function pointer
- * \param[in, out] values            pointer to the computed values
+ * \param[in]      time_eval    physical time at which one evaluates the term
+ * \param[in]      ana          pointer to the analytic function
+ * \param[in]      input        NULL or pointer cast on-the-fly
+ * \param[in]      dim          dimension of the function to integrate
+ * \param[in]      qtype        type of quadrature
+ * \param[in]      n_elts       number of elements to consider
+ * \param[in]      elt_ids      pointer to the list of selected ids
+ * \param[in]      average      true: divide the integral by the cell volume
+ * \param[in, out] values       pointer to the computed values
  */
 /*----------------------------------------------------------------------------*/
 
 static void
-_pcsd_by_analytic(cs_real_t                        time_eval,
-                  cs_analytic_func_t              *ana,
-                  void                            *input,
-                  const cs_lnum_t                  n_elts,
-                  const cs_lnum_t                 *elt_ids,
-                  cs_quadrature_tetra_integral_t  *compute_integral,
-                  cs_real_t                        values[])
+_pc_by_analytic(cs_real_t                  time_eval,
+                cs_analytic_func_t        *ana,
+                void                      *input,
+                int                        dim,
+                cs_quadrature_type_t       qtype,
+                const cs_lnum_t            n_elts,
+                const cs_lnum_t           *elt_ids,
+                bool                       average,
+                cs_real_t                  values[])
 {
   const cs_cdo_quantities_t  *quant = cs_cdo_quant;
   const cs_real_t  *xv = quant->vtx_coord;
@@ -715,345 +726,150 @@ _pcsd_by_analytic(cs_real_t                        time_eval,
   const cs_adjacency_t  *c2f = connect->c2f;
   const cs_adjacency_t  *f2e = connect->f2e;
 
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t id = 0; id < n_elts; id++) {
-
-    const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
-    if (connect->cell_type[c_id] == FVM_CELL_TETRA) {
-
-      const cs_lnum_t  *v = connect->c2v->ids + connect->c2v->idx[c_id];
-
-      compute_integral(time_eval,
-                       xv+3*v[0], xv+3*v[1], xv+3*v[2], xv+3*v[3],
-                       quant->cell_vol[c_id],
-                       ana, input, values + c_id);
-
-    }
-    else {
-
-      const cs_real_t  *xc = quant->cell_centers + 3*c_id;
+  int  n_qp = 0;
+  cs_quadrature_tet_t  *qrule = cs_quadrature_get_tetra_rule(qtype, &n_qp);
 
-      for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
+  const cs_lnum_t  n_batches =
+    (n_elts + CS_EVALUATE_BATCH_SIZE - 1) / CS_EVALUATE_BATCH_SIZE;
 
-        const cs_lnum_t  f_id = c2f->ids[i];
-        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
-        const double  hfco =
-          cs_math_1ov3 * cs_math_3_dot_product(pfq.unitv,
-                                               quant->dedge_vector+3*i);
-        const cs_lnum_t  start = f2e->idx[f_id], end = f2e->idx[f_id+1];
-
-        if (end - start == 3) {
-
-          cs_lnum_t v0, v1, v2;
-          cs_connect_get_next_3_vertices(connect->f2e->ids, connect->e2v->ids,
-                                         start, &v0, &v1, &v2);
-          compute_integral(time_eval, xv + 3*v0, xv + 3*v1, xv + 3*v2, xc,
-                           hfco * pfq.meas,
-                           ana, input, values + c_id);
-        }
-        else {
-
-          for (cs_lnum_t j = start; j < end; j++) {
+# pragma omp parallel if (n_elts > CS_THR_MIN)
+  {
+    /* Buffers local to a thread (resized on demand) */
 
-            const cs_lnum_t  _2e = 2*f2e->ids[j];
-            const cs_lnum_t  v1 = connect->e2v->ids[_2e];
-            const cs_lnum_t  v2 = connect->e2v->ids[_2e+1];
+    cs_lnum_t  max_n_pts = 0;
+    cs_lnum_t  *pt2c = NULL;
+    cs_real_t  *gpts = NULL, *w = NULL, *evals = NULL;
 
-            compute_integral(time_eval, xv + 3*v1, xv + 3*v2, pfq.center, xc,
-                             hfco*cs_math_surftri(xv+3*v1, xv+3*v2, pfq.center),
-                             ana, input, values + c_id);
+#   pragma omp for
+    for (cs_lnum_t b = 0; b < n_batches; b++) {
 
-          } /* Loop on edges */
+      const cs_lnum_t  s = b*CS_EVALUATE_BATCH_SIZE;
+      const cs_lnum_t  e = CS_MIN(n_elts, s + CS_EVALUATE_BATCH_SIZE);
 
-        } /* Current face is triangle or not ? */
+      /* Count the number of quadrature points in this batch */
 
-      } /* Loop on faces */
+      cs_lnum_t  n_pts = 0;
+      for (cs_lnum_t id = s; id < e; id++) {
 
-    } /* Not a tetrahedron */
+        const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
 
-  } /* Loop on cells */
-}
-
-/*----------------------------------------------------------------------------*/
-/*!
- * \brief  Compute the integral over primal cells of a vector-valued density
- *         field defined by an analytical function on a selection of (primal)
- *         cells
- *
- * \param[in]      time_eval     physical time at which one evaluates the term
- * \param[in]      ana               pointer to the analytic function
- * \param[in]      input             NULL or pointer cast on-the-fly
- * \param[in]      n_elts            number of elements to consider
- * \param[in]      elt_ids           pointer to the list of selected ids
- * \param[in]      compute_integral  function pointer
- * \param[in, out] values            pointer to the computed values
- */
-/*----------------------------------------------------------------------------*/
-
-static void
-_pcvd_by_analytic(cs_real_t                        time_eval,
-                  cs_analytic_func_t              *ana,
-                  void                            *input,
-                  const cs_lnum_t                  n_elts,
-                  const cs_lnum_t                 *elt_ids,
-                  cs_quadrature_tetra_integral_t  *compute_integral,
-                  cs_real_t                        values[])
-{
-  const cs_cdo_quantities_t  *quant = cs_cdo_quant;
-  const cs_real_t  *xv = quant->vtx_coord;
-  const cs_cdo_connect_t  *connect = cs_cdo_connect;
-  const cs_adjacency_t  *c2f = connect->c2f;
-  const cs_adjacency_t  *f2e = connect->f2e;
-  const int  dim = 3;
-
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t  id = 0; id < n_elts; id++) {
-
-    const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
-    if (connect->cell_type[c_id] == FVM_CELL_TETRA) {
-
-      const cs_lnum_t  *v = connect->c2v->ids + connect->c2v->idx[c_id];
-
-      compute_integral(time_eval,
-                       xv+3*v[0], xv+3*v[1], xv+3*v[2], xv+3*v[3],
-                       quant->cell_vol[c_id],
-                       ana, input, values + dim*c_id);
-
-    }
-    else {
-
-      const cs_real_t  *xc = quant->cell_centers + 3*c_id;
-
-      for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
-
-        const cs_lnum_t  f_id = c2f->ids[i];
-        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
-        const double hfc = cs_math_1ov3 *
-                cs_math_3_dot_product(pfq.unitv, quant->dedge_vector+3*i);
-        const cs_lnum_t start = f2e->idx[f_id], end = f2e->idx[f_id+1];
-
-        if (end - start == 3) {
-
-          cs_lnum_t v0, v1, v2;
-          cs_connect_get_next_3_vertices(connect->f2e->ids, connect->e2v->ids,
-                                         start, &v0, &v1, &v2);
-          compute_integral(time_eval,xv + 3*v0, xv + 3*v1, xv + 3*v2, xc,
-                           hfc * pfq.meas,
-                           ana, input, values + 3*c_id);
-        }
+        if (connect->cell_type[c_id] == FVM_CELL_TETRA)
+          n_pts += n_qp;
         else {
+          for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
+            const cs_lnum_t  f_id = c2f->ids[i];
+            const cs_lnum_t  n_ef = f2e->idx[f_id+1] - f2e->idx[f_id];
+            n_pts += (n_ef == 3) ? n_qp : n_ef*n_qp;
+          }
+        }
 
-          for (cs_lnum_t j = start; j < end; j++) {
-
-            const cs_lnum_t  _2e = 2*f2e->ids[j];
-            const cs_lnum_t  v1 = connect->e2v->ids[_2e];
-            const cs_lnum_t  v2 = connect->e2v->ids[_2e+1];
-
-            compute_integral(time_eval, xv + 3*v1, xv + 3*v2, pfq.center, xc,
-                             hfc*cs_math_surftri(xv+3*v1, xv+3*v2, pfq.center),
-                             ana, input, values + 3*c_id);
-
-          } /* Loop on edges */
-
-        } /* Current face is triangle or not ? */
-
-      } /* Loop on faces */
-
-    } /* Not a tetrahedron */
-
-  } /* Loop on cells */
-}
-
-/*----------------------------------------------------------------------------*/
-/*!
- * \brief  Compute the average over primal cells of a scalar field defined
- *         by an analytical function on a selection of (primal) cells
- *
- * \param[in]      time_eval      physical time at which one evaluates the term
- * \param[in]      ana               pointer to the analytic function
- * \param[in]      input             NULL or pointer cast on-the-fly
- * \param[in]      n_loc_elts        number of elements to consider
- * \param[in]      elt_ids           pointer to the list of selected ids
- * \param[in]      compute_integral  function pointer
- * \param[in, out] values            pointer to the computed values
- */
-/*----------------------------------------------------------------------------*/
-
-static void
-_pcsa_by_analytic(cs_real_t                        time_eval,
-                  cs_analytic_func_t              *ana,
-                  void                            *input,
-                  const cs_lnum_t                  n_elts,
-                  const cs_lnum_t                 *elt_ids,
-                  cs_quadrature_tetra_integral_t  *compute_integral,
-                  cs_real_t                        values[])
-{
-  const cs_cdo_quantities_t  *quant = cs_cdo_quant;
-  const cs_real_t  *xv = quant->vtx_coord;
-  const cs_cdo_connect_t  *connect = cs_cdo_connect;
-  const cs_adjacency_t  *c2f = connect->c2f;
-  const cs_adjacency_t  *f2e = connect->f2e;
-
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t id = 0; id < n_elts; id++) {
-
-    const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
-    if (connect->cell_type[c_id] == FVM_CELL_TETRA) {
+      } /* Loop on cells of the batch */
 
-      const cs_lnum_t  *v = connect->c2v->ids + connect->c2v->idx[c_id];
+      if (n_pts > max_n_pts) {
+        max_n_pts = n_pts;
+        BFT_REALLOC(pt2c, max_n_pts, cs_lnum_t);
+        BFT_REALLOC(gpts, 3*max_n_pts, cs_real_t);
+        BFT_REALLOC(w, max_n_pts, cs_real_t);
+        BFT_REALLOC(evals, dim*max_n_pts, cs_real_t);
+      }
 
-      compute_integral(time_eval,
-                       xv+3*v[0], xv+3*v[1], xv+3*v[2], xv+3*v[3],
-                       quant->cell_vol[c_id],
-                       ana, input, values + c_id);
+      /* Define the quadrature points and their weights */
 
-    }
-    else {
+      cs_lnum_t  shift = 0;
+      for (cs_lnum_t id = s; id < e; id++) {
 
-      const cs_real_t  *xc = quant->cell_centers + 3*c_id;
+        const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
+        const cs_lnum_t  c_shift = shift;
 
-      for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
+        if (connect->cell_type[c_id] == FVM_CELL_TETRA) {
 
-        const cs_lnum_t  f_id = c2f->ids[i];
-        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
-        const double  hfco =
-          cs_math_1ov3 * cs_math_3_dot_product(pfq.unitv,
-                                                   quant->dedge_vector+3*i);
-        const cs_lnum_t  start = f2e->idx[f_id], end = f2e->idx[f_id+1];
+          const cs_lnum_t  *v = connect->c2v->ids + connect->c2v->idx[c_id];
 
-        if (end - start == 3) {
+          qrule(xv+3*v[0], xv+3*v[1], xv+3*v[2], xv+3*v[3],
+                quant->cell_vol[c_id],
+                (cs_real_3_t *)(gpts + 3*shift), w + shift);
+          shift += n_qp;
 
-          cs_lnum_t v0, v1, v2;
-          cs_connect_get_next_3_vertices(connect->f2e->ids, connect->e2v->ids,
-                                         start, &v0, &v1, &v2);
-          compute_integral(time_eval, xv + 3*v0, xv + 3*v1, xv + 3*v2, xc,
-                           hfco * pfq.meas,
-                           ana, input, values + c_id);
         }
         else {
 
-          for (cs_lnum_t j = start; j < end; j++) {
-
-            const cs_lnum_t  _2e = 2*f2e->ids[j];
-            const cs_lnum_t  v1 = connect->e2v->ids[_2e];
-            const cs_lnum_t  v2 = connect->e2v->ids[_2e+1];
-
-            compute_integral(time_eval, xv + 3*v1, xv + 3*v2, pfq.center, xc,
-                             hfco*cs_math_surftri(xv+3*v1, xv+3*v2, pfq.center),
-                             ana, input, values + c_id);
-
-          } /* Loop on edges */
-
-        } /* Current face is triangle or not ? */
+          const cs_real_t  *xc = quant->cell_centers + 3*c_id;
 
-      } /* Loop on faces */
+          for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
 
-    } /* Not a tetrahedron */
-
-    /* Average */
+            const cs_lnum_t  f_id = c2f->ids[i];
+            const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
+            const double  hfco =
+              cs_math_1ov3 * cs_math_3_dot_product(pfq.unitv,
+                                                   quant->dedge_vector+3*i);
+            const cs_lnum_t  start = f2e->idx[f_id], end = f2e->idx[f_id+1];
 
-    values[c_id] /= quant->cell_vol[c_id];
+            if (end - start == 3) {
 
-  } /* Loop on cells */
-}
+              cs_lnum_t v0, v1, v2;
+              cs_connect_get_next_3_vertices(f2e->ids, connect->e2v->ids,
+                                             start, &v0, &v1, &v2);
+              qrule(xv + 3*v0, xv + 3*v1, xv + 3*v2, xc,
+                    hfco * pfq.meas,
+                    (cs_real_3_t *)(gpts + 3*shift), w + shift);
+              shift += n_qp;
 
-/*----------------------------------------------------------------------------*/
-/*!
- * \brief  Compute the average over primal cells of a vector field defined
- *         by an analytical function on a selection of (primal) cells
- *
- * \param[in]      time_eval     physical time at which one evaluates the term
- * \param[in]      ana               pointer to the analytic function
- * \param[in]      input             NULL or pointer cast on-the-fly
- * \param[in]      n_loc_elts        number of elements to consider
- * \param[in]      elt_ids           pointer to the list of selected ids
- * \param[in]      compute_integral  function pointer
- * \param[in, out] values            pointer to the computed values
- */
-/*----------------------------------------------------------------------------*/
+            }
+            else {
 
-/* Note: the only difference from the scalar version is that there's 3*c_id in
- * the values. Consider merging the two
- */
+              for (cs_lnum_t j = start; j < end; j++) {
 
-static void
-_pcva_by_analytic(cs_real_t                        time_eval,
-                  cs_analytic_func_t              *ana,
-                  void                            *input,
-                  const cs_lnum_t                  n_elts,
-                  const cs_lnum_t                 *elt_ids,
-                  cs_quadrature_tetra_integral_t  *compute_integral,
-                  cs_real_t                        values[])
-{
-  const cs_cdo_quantities_t  *quant = cs_cdo_quant;
-  const cs_real_t  *xv = quant->vtx_coord;
-  const cs_cdo_connect_t  *connect = cs_cdo_connect;
-  const cs_adjacency_t  *c2f = connect->c2f;
-  const cs_adjacency_t  *f2e = connect->f2e;
+                const cs_lnum_t  _2e = 2*f2e->ids[j];
+                const cs_lnum_t  v1 = connect->e2v->ids[_2e];
+                const cs_lnum_t  v2 = connect->e2v->ids[_2e+1];
 
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t id = 0; id < n_elts; id++) {
+                qrule(xv + 3*v1, xv + 3*v2, pfq.center, xc,
+                      hfco*cs_math_surftri(xv+3*v1, xv+3*v2, pfq.center),
+                      (cs_real_3_t *)(gpts + 3*shift), w + shift);
+                shift += n_qp;
 
-    const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
-    cs_real_t *val_i = values + 3*c_id;
+              } /* Loop on edges */
 
-    if (connect->cell_type[c_id] == FVM_CELL_TETRA) {
+            } /* Current face is triangle or not ? */
 
-      const cs_lnum_t  *v = connect->c2v->ids + connect->c2v->idx[c_id];
+          } /* Loop on faces */
 
-      compute_integral(time_eval,
-                       xv+3*v[0], xv+3*v[1], xv+3*v[2], xv+3*v[3],
-                       quant->cell_vol[c_id],
-                       ana, input, val_i);
+        } /* Not a tetrahedron */
 
-    }
-    else {
+        for (cs_lnum_t p = c_shift; p < shift; p++)
+          pt2c[p] = c_id;
 
-      const cs_real_t  *xc = quant->cell_centers + 3*c_id;
+      } /* Loop on cells of the batch */
 
-      for (cs_lnum_t i = c2f->idx[c_id]; i < c2f->idx[c_id+1]; i++) {
+      assert(shift == n_pts);
 
-        const cs_lnum_t  f_id = c2f->ids[i];
-        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
-        const double  hfco =
-          cs_math_1ov3 * cs_math_3_dot_product(pfq.unitv,
-                                               quant->dedge_vector+3*i);
-        const cs_lnum_t  start = f2e->idx[f_id], end = f2e->idx[f_id+1];
+      /* Only one call to the analytic function for the whole batch */
 
-        if (end - start == 3) {
+      ana(time_eval, n_pts, NULL, gpts, true, input, evals);
 
-          cs_lnum_t v0, v1, v2;
-          cs_connect_get_next_3_vertices(connect->f2e->ids, connect->e2v->ids,
-                                         start, &v0, &v1, &v2);
-          compute_integral(time_eval, xv + 3*v0, xv + 3*v1, xv + 3*v2, xc,
-                           hfco * pfq.meas,
-                           ana, input, val_i);
+      for (cs_lnum_t p = 0; p < n_pts; p++) {
+        cs_real_t  *_val = values + dim*pt2c[p];
+        for (int k = 0; k < dim; k++)
+          _val[k] += w[p]*evals[dim*p+k];
+      }
 
+      if (average) {
+        for (cs_lnum_t id = s; id < e; id++) {
+          const cs_lnum_t  c_id = (elt_ids == NULL) ? id : elt_ids[id];
+          const double  inv_vol = 1./quant->cell_vol[c_id];
+          for (int k = 0; k < dim; k++)
+            values[dim*c_id+k] *= inv_vol;
         }
-        else {
-
-          for (cs_lnum_t j = start; j < end; j++) {
-
-            const cs_lnum_t  _2e = 2*f2e->ids[j];
-            const cs_lnum_t  v1 = connect->e2v->ids[_2e];
-            const cs_lnum_t  v2 = connect->e2v->ids[_2e+1];
-
-            compute_integral(time_eval, xv + 3*v1, xv + 3*v2, pfq.center, xc,
-                             hfco*cs_math_surftri(xv+3*v1, xv+3*v2, pfq.center),
-                             ana, input, val_i);
-
-          } /* Loop on edges */
-
-        } /* Current face is triangle or not ? */
-
-      } /* Loop on faces */
+      }
 
-    } /* Not a tetrahedron */
+    } /* Loop on batches */
 
-    const double _overvol = 1./quant->cell_vol[c_id];
-    for (int k = 0; k < 3; k++) val_i[k] *= _overvol;
+    BFT_FREE(pt2c);
+    BFT_FREE(gpts);
+    BFT_FREE(w);
+    BFT_FREE(evals);
 
-  } /* Loop on cells */
+  } /* OpenMP block */
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1152,152 +968,150 @@ _dcvd_by_value(const cs_real_t    const_vec[3],
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief  Get the average at each primal faces for a scalar potential
- *         defined by an analytical function on a selection of (primal) cells
+ * \brief  Get the average at each primal faces of a potential defined by an
+ *         analytical function on a selection of (primal) faces. Faces are
+ *         split into triangles. The quadrature points of a batch of faces are
+ *         gathered so that the analytic function is called only once per
+ *         batch.
  *
- * \param[in]      time_eval      physical time at which one evaluates the term
- * \param[in]      ana               pointer to the analytic function
- * \param[in]      input             NULL or pointer cast on-the-fly
- * \param[in]      n_loc_elts        number of elements to consider
- * \param[in]      elt_ids           pointer to the list of selected ids
- * \param[in]      compute_integral  function pointer
- * \param[in, out] values            pointer to the computed values
+ * \param[in]      time_eval    physical time at which one evaluates the term
+ * \param[in]      ana          pointer to the analytic function
+ * \param[in]      input        NULL or pointer cast on-the-fly
+ * \param[in]      dim          dimension of the function to integrate
+ * \param[in]      qtype        type of quadrature
+ * \param[in]      n_elts       number of elements to consider
+ * \param[in]      elt_ids      pointer to the list of selected ids
+ * \param[in, out] values       pointer to the computed values
  */
 /*----------------------------------------------------------------------------*/
 
 static void
-_pfsa_by_analytic(cs_real_t                        time_eval,
-                  cs_analytic_func_t              *ana,
-                  void                            *input,
-                  const cs_lnum_t                  n_elts,
-                  const cs_lnum_t                 *elt_ids,
-                  cs_quadrature_tria_integral_t   *compute_integral,
-                  cs_real_t                        values[])
+_pfa_by_analytic(cs_real_t                  time_eval,
+                 cs_analytic_func_t        *ana,
+                 void                      *input,
+                 int                        dim,
+                 cs_quadrature_type_t       qtype,
+                 const cs_lnum_t            n_elts,
+                 const cs_lnum_t           *elt_ids,
+                 cs_real_t                  values[])
 {
   const cs_cdo_quantities_t  *quant = cs_cdo_quant;
   const cs_adjacency_t  *f2e = cs_cdo_connect->f2e;
   const cs_adjacency_t  *e2v = cs_cdo_connect->e2v;
   const cs_real_t  *xv = quant->vtx_coord;
 
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t f = 0; f < n_elts; f++) {
+  int  n_qp = 0;
+  cs_quadrature_tria_t  *qrule = cs_quadrature_get_tria_rule(qtype, &n_qp);
+
+  const cs_lnum_t  n_batches =
+    (n_elts + CS_EVALUATE_BATCH_SIZE - 1) / CS_EVALUATE_BATCH_SIZE;
+
+# pragma omp parallel if (n_elts > CS_THR_MIN)
+  {
+    /* Buffers local to a thread (resized on demand) */
 
-    const cs_lnum_t  f_id = (elt_ids == NULL) ? f : elt_ids[f];
-    const cs_quant_t pfq = cs_quant_set_face(f_id, quant);
-    const cs_lnum_t  start_idx = f2e->idx[f_id], end_idx = f2e->idx[f_id+1];
-    cs_real_t *val_i = values + f_id;
+    cs_lnum_t  max_n_pts = 0;
+    cs_lnum_t  *pt2f = NULL;
+    cs_real_t  *gpts = NULL, *w = NULL, *evals = NULL;
 
-    switch (end_idx - start_idx) {
+#   pragma omp for
+    for (cs_lnum_t b = 0; b < n_batches; b++) {
 
-    case CS_TRIANGLE_CASE: /* Triangle: one-shot computation */
-      {
-        cs_lnum_t  v1, v2, v3;
+      const cs_lnum_t  s = b*CS_EVALUATE_BATCH_SIZE;
+      const cs_lnum_t  e = CS_MIN(n_elts, s + CS_EVALUATE_BATCH_SIZE);
 
-        cs_connect_get_next_3_vertices(f2e->ids, e2v->ids, start_idx,
-                                       &v1, &v2, &v3);
-        compute_integral(time_eval,
-                         xv + 3*v1, xv + 3*v2, xv + 3*v3, pfq.meas,
-                         ana, input, val_i);
+      /* Count the number of quadrature points in this batch */
+
+      cs_lnum_t  n_pts = 0;
+      for (cs_lnum_t id = s; id < e; id++) {
+        const cs_lnum_t  f_id = (elt_ids == NULL) ? id : elt_ids[id];
+        const cs_lnum_t  n_ef = f2e->idx[f_id+1] - f2e->idx[f_id];
+        n_pts += (n_ef == CS_TRIANGLE_CASE) ? n_qp : n_ef*n_qp;
       }
-      break;
 
-    default:
-      for (cs_lnum_t j = start_idx; j < end_idx; j++) {
+      if (n_pts > max_n_pts) {
+        max_n_pts = n_pts;
+        BFT_REALLOC(pt2f, max_n_pts, cs_lnum_t);
+        BFT_REALLOC(gpts, 3*max_n_pts, cs_real_t);
+        BFT_REALLOC(w, max_n_pts, cs_real_t);
+        BFT_REALLOC(evals, dim*max_n_pts, cs_real_t);
+      }
 
-        const cs_lnum_t  *_v = e2v->ids + 2*f2e->ids[j];
-        const cs_real_t  *xv1 = xv + 3*_v[0], *xv2 = xv + 3*_v[1];
+      /* Define the quadrature points and their weights */
 
-        compute_integral(time_eval,
-                         xv1, xv2, pfq.center,
-                         cs_math_surftri(xv1, xv2, pfq.center),
-                         ana, input, val_i);
+      cs_lnum_t  shift = 0;
+      for (cs_lnum_t id = s; id < e; id++) {
 
-      } /* Loop on edges */
-      break;
+        const cs_lnum_t  f_id = (elt_ids == NULL) ? id : elt_ids[id];
+        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
+        const cs_lnum_t  start_idx = f2e->idx[f_id];
+        const cs_lnum_t  end_idx = f2e->idx[f_id+1];
+        const cs_lnum_t  f_shift = shift;
 
-    } /* End of switch */
+        switch (end_idx - start_idx) {
 
-    /* Average */
+        case CS_TRIANGLE_CASE: /* Triangle: one-shot computation */
+          {
+            cs_lnum_t  v1, v2, v3;
 
-    val_i[0] /= pfq.meas;
+            cs_connect_get_next_3_vertices(f2e->ids, e2v->ids, start_idx,
+                                           &v1, &v2, &v3);
+            qrule(xv + 3*v1, xv + 3*v2, xv + 3*v3, pfq.meas,
+                  (cs_real_3_t *)(gpts + 3*shift), w + shift);
+            shift += n_qp;
+          }
+          break;
 
-  } /* Loop on faces */
-}
+        default:
+          for (cs_lnum_t j = start_idx; j < end_idx; j++) {
 
-/*----------------------------------------------------------------------------*/
-/*!
- * \brief  Get the average at each primal faces for a vector potential
- *         defined by an analytical function on a selection of (primal) cells
- *
- * \param[in]      time_eval  physical time at which one evaluates the term
- * \param[in]      ana                 pointer to the analytic function
- * \param[in]      input               NULL or pointer cast on-the-fly
- * \param[in]      n_loc_elts          number of elements to consider
- * \param[in]      elt_ids             pointer to the list of selected ids
- * \param[in]      compute_integral    function pointer
- * \param[in, out] values              pointer to the computed values
- */
-/*----------------------------------------------------------------------------*/
+            const cs_lnum_t  *_v = e2v->ids + 2*f2e->ids[j];
+            const cs_real_t  *xv1 = xv + 3*_v[0], *xv2 = xv + 3*_v[1];
 
-static void
-_pfva_by_analytic(cs_real_t                       time_eval,
-                  cs_analytic_func_t             *ana,
-                  void                           *input,
-                  const cs_lnum_t                 n_elts,
-                  const cs_lnum_t                *elt_ids,
-                  cs_quadrature_tria_integral_t  *compute_integral,
-                  cs_real_t                       values[])
-{
-  const cs_cdo_quantities_t  *quant = cs_cdo_quant;
-  const cs_adjacency_t  *f2e = cs_cdo_connect->f2e;
-  const cs_adjacency_t  *e2v = cs_cdo_connect->e2v;
-  const cs_real_t  *xv = quant->vtx_coord;
+            qrule(xv1, xv2, pfq.center, cs_math_surftri(xv1, xv2, pfq.center),
+                  (cs_real_3_t *)(gpts + 3*shift), w + shift);
+            shift += n_qp;
 
-# pragma omp parallel for if (n_elts > CS_THR_MIN)
-  for (cs_lnum_t f = 0; f < n_elts; f++) {
+          } /* Loop on edges */
+          break;
 
-    const cs_lnum_t  f_id = (elt_ids == NULL) ? f : elt_ids[f];
-    const cs_quant_t pfq = cs_quant_set_face(f_id, quant);
-    const cs_lnum_t  start_idx = f2e->idx[f_id], end_idx = f2e->idx[f_id+1];
-    cs_real_t *val_i = values + 3*f_id;
+        } /* End of switch */
 
-    switch (end_idx - start_idx) {
+        for (cs_lnum_t p = f_shift; p < shift; p++)
+          pt2f[p] = f_id;
 
-    case CS_TRIANGLE_CASE: /* Triangle: one-shot computation */
-      {
-        cs_lnum_t  v1, v2, v3;
+      } /* Loop on faces of the batch */
 
-        cs_connect_get_next_3_vertices(f2e->ids, e2v->ids, start_idx,
-                                       &v1, &v2, &v3);
-        compute_integral(time_eval,
-                         xv + 3*v1, xv + 3*v2, xv + 3*v3, pfq.meas,
-                         ana, input, val_i);
-      }
-      break;
+      assert(shift == n_pts);
 
-    default:
-      for (cs_lnum_t j = start_idx; j < end_idx; j++) {
+      /* Only one call to the analytic function for the whole batch */
 
-        const cs_lnum_t  *_v = e2v->ids + 2*f2e->ids[j];
-        const cs_real_t  *xv1 = xv + 3*_v[0], *xv2 = xv + 3*_v[1];
+      ana(time_eval, n_pts, NULL, gpts, true, input, evals);
 
-        compute_integral(time_eval,
-                         xv1, xv2, pfq.center,
-                         cs_math_surftri(xv1, xv2, pfq.center),
-                         ana, input, val_i);
+      for (cs_lnum_t p = 0; p < n_pts; p++) {
+        cs_real_t  *_val = values + dim*pt2f[p];
+        for (int k = 0; k < dim; k++)
+          _val[k] += w[p]*evals[dim*p+k];
+      }
 
-      } /* Loop on edges */
-      break;
+      /* Average */
 
-    } /* End of switch */
+      for (cs_lnum_t id = s; id < e; id++) {
+        const cs_lnum_t  f_id = (elt_ids == NULL) ? id : elt_ids[id];
+        const cs_quant_t  pfq = cs_quant_set_face(f_id, quant);
+        const double  inv_surf = 1./pfq.meas;
+        for (int k = 0; k < dim; k++)
+          values[dim*f_id+k] *= inv_surf;
+      }
 
-    /* Average */
+    } /* Loop on batches */
 
-    const double _oversurf = 1./pfq.meas;
-    for (short int xyz = 0; xyz < 3; xyz++)
-      val_i[xyz] *= _oversurf;
+    BFT_FREE(pt2f);
+    BFT_FREE(gpts);
+    BFT_FREE(w);
+    BFT_FREE(evals);
 
-  } /* Loop on faces */
+  } /* OpenMP block */
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1590,9 +1404,10 @@ cs_evaluate_density_by_analytic(cs_flag_t           dof_flag,
   if (dof_flag & CS_FLAG_SCALAR) { /* DoF is scalar-valued */
 
     if (cs_flag_test(dof_flag, cs_flag_primal_cell))
-      _pcsd_by_analytic(time_eval, ac->func, ac->input,
-                        z->n_elts, elt_ids, qfunc,
-                        retval);
+      _pc_by_analytic(time_eval, ac->func, ac->input, 1, def->qtype,
+                      z->n_elts, elt_ids,
+                      false, /* average ? */
+                      retval);
     else if (cs_flag_test(dof_flag, cs_flag_dual_cell))
       _dcsd_by_analytic(time_eval, ac->func, ac->input,
                         z->n_elts, elt_ids, qfunc,
@@ -1604,9 +1419,10 @@ cs_evaluate_density_by_analytic(cs_flag_t           dof_flag,
   else if (dof_flag & CS_FLAG_VECTOR) { /* DoF is vector-valued */
 
     if (cs_flag_test(dof_flag, cs_flag_primal_cell))
-      _pcvd_by_analytic(time_eval, ac->func, ac->input,
-                        z->n_elts, elt_ids, qfunc,
-                        retval);
+      _pc_by_analytic(time_eval, ac->func, ac->input, 3, def->qtype,
+                      z->n_elts, elt_ids,
+                      false, /* average ? */
+                      retval);
     else if (cs_flag_test(dof_flag, cs_flag_dual_cell))
       _dcvd_by_analytic(time_eval, ac->func, ac->input,
                         z->n_elts, elt_ids, qfunc,
@@ -2431,26 +2247,16 @@ cs_evaluate_average_on_faces_by_analytic(const cs_xdef_t    *def,
   assert(def->support == CS_XDEF_SUPPORT_VOLUME);
   assert(def->type == CS_XDEF_BY_ANALYTIC_FUNCTION);
 
-  cs_quadrature_tria_integral_t
-    *qfunc = cs_quadrature_get_tria_integral(def->dim, def->qtype);
   cs_xdef_analytic_context_t *ac = (cs_xdef_analytic_context_t *)def->context;
 
   switch (def->dim) {
 
   case 1: /* Scalar-valued */
-    _pfsa_by_analytic(time_eval,
-                      ac->func, ac->input,
-                      n_f_selected, selected_lst,
-                      qfunc,
-                      retval);
-    break;
-
   case 3: /* Vector-valued */
-    _pfva_by_analytic(time_eval,
-                      ac->func, ac->input,
-                      n_f_selected, selected_lst,
-                      qfunc,
-                      retval);
+    _pfa_by_analytic(time_eval,
+                     ac->func, ac->input, def->dim, def->qtype,
+                     n_f_selected, selected_lst,
+                     retval);
     break;
 
   default:
@@ -2610,8 +2416,6 @@ cs_evaluate_average_on_cells_by_analytic(const cs_xdef_t   *def,
   const cs_zone_t  *z = cs_volume_zone_by_id(def->z_id);
   const cs_lnum_t  *elt_ids = (n_cells == z->n_elts) ? NULL : z->elt_ids;
 
-  cs_quadrature_tetra_integral_t
-    *qfunc = cs_quadrature_get_tetra_integral(def->dim, def->qtype);
   cs_xdef_analytic_context_t *ac = (cs_xdef_analytic_context_t *)def->context;
 
   switch (def->dim) {
@@ -2622,9 +2426,10 @@ cs_evaluate_average_on_cells_by_analytic(const cs_xdef_t   *def,
     else
       cs_array_real_set_scalar_on_subset(z->n_elts, elt_ids, 0., retval);
 
-    _pcsa_by_analytic(time_eval,
-                      ac->func, ac->input, z->n_elts, elt_ids, qfunc,
-                      retval);
+    _pc_by_analytic(time_eval, ac->func, ac->input, 1, def->qtype,
+                    z->n_elts, elt_ids,
+                    true, /* average ? */
+                    retval);
     break;
 
   case 3: /* Vector-valued */
@@ -2635,9 +2440,10 @@ cs_evaluate_average_on_cells_by_analytic(const cs_xdef_t   *def,
       cs_array_real_set_vector_on_subset(z->n_elts, elt_ids, zero, retval);
     }
 
-    _pcva_by_analytic(time_eval,
-                      ac->func, ac->input, z->n_elts, elt_ids, qfunc,
-                      retval);
+    _pc_by_analytic(time_eval, ac->func, ac->input, 3, def->qtype,
+                    z->n_elts, elt_ids,
+                    true, /* average ? */
+                    retval);
     break;
 
   default:
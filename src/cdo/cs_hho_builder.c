@@ -33,6 +33,7 @@
  *----------------------------------------------------------------------------*/
 
 #include <assert.h>
+#include <string.h>
 
 /*----------------------------------------------------------------------------
  * Local headers
@@ -40,9 +41,16 @@
 
 #include "bft_error.h"
 #include "bft_mem.h"
+#include "bft_printf.h"
 
+#include "cs_array.h"
+#include "cs_blas.h"
+#include "cs_iter_algo.h"
 #include "cs_log.h"
+#include "cs_parall.h"
+#include "cs_sles.h"
 #include "cs_time_step.h"
+#include "cs_timer.h"
 
 /*----------------------------------------------------------------------------
  * Header for the current file
@@ -63,6 +71,34 @@ BEGIN_C_DECLS
 
 #define CS_HHO_BUILDER_DBG  0
 
+/* Context of the linear solver used in the matrix-free mode. Vectors handled
+   by the Krylov solver are in a gather view (size = rset->n_elts[0]). The
+   operator is applied in a scatter view (size = rset->n_elts[1]). */
+
+typedef struct {
+
+  const cs_range_set_t      *rset;
+  const cs_real_t           *diag;     /* Shared. Scatter view */
+
+  cs_hho_builder_matvec_t   *matvec;
+  void                      *input;    /* Owned by this structure */
+
+  int                        n_max_iter;
+  cs_real_t                 *inv_diag; /* Gather view (set during the setup) */
+
+  /* Monitoring */
+
+  int                        n_setups;
+  int                        n_solves;
+  int                        n_iterations_min;
+  int                        n_iterations_max;
+  unsigned long long         n_iterations_tot;
+
+  cs_timer_counter_t         t_setup;
+  cs_timer_counter_t         t_solve;
+
+} cs_hho_mf_sles_t;
+
 /*============================================================================
  * Private variables
  *============================================================================*/
@@ -732,10 +768,465 @@ _compute_mcg(const cs_cell_mesh_t    *cm,
   return mcg;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Compute y = A.x in the matrix-free mode. x and y are in a gather
+ *         view. xs and ys are work arrays in a scatter view.
+ *
+ * \param[in]      c       pointer to the matrix-free solver context
+ * \param[in]      x       array to multiply (gather view)
+ * \param[in, out] xs      work array (scatter view)
+ * \param[in, out] ys      work array (scatter view)
+ * \param[in, out] y       resulting array (gather view)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_mf_matvec(cs_hho_mf_sles_t     *c,
+           const cs_real_t      *x,
+           cs_real_t            *xs,
+           cs_real_t            *ys,
+           cs_real_t            *y)
+{
+  const cs_range_set_t  *rset = c->rset;
+  const cs_lnum_t  n_scatter = rset->n_elts[1];
+
+  cs_range_set_scatter(rset, CS_REAL_TYPE, 1, x, xs);
+
+  cs_array_real_fill_zero(n_scatter, ys);
+
+  c->matvec(c->input, xs, ys);
+
+  if (rset->ifs != NULL)
+    cs_interface_set_sum(rset->ifs, n_scatter, 1, false, CS_REAL_TYPE, ys);
+
+  cs_range_set_gather(rset, CS_REAL_TYPE, 1, ys, y);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Compute the canonical dot product between two arrays in a gather
+ *         view. The synchronization is performed inside.
+ *
+ * \param[in] n     size of arrays (gather view)
+ * \param[in] x     first array
+ * \param[in] y     second array
+ *
+ * \return the value of the dot product (x,y)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline double
+_mf_dot(cs_lnum_t           n,
+        const cs_real_t    *x,
+        const cs_real_t    *y)
+{
+  double  dp = cs_dot(n, x, y);
+
+  cs_parall_sum(1, CS_DOUBLE, &dp);
+
+  return dp;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Setup the matrix-free solver: compute the inverse of the diagonal
+ *         used as preconditioner. Function of type cs_sles_setup_t.
+ *
+ * \param[in, out] context    pointer to a cs_hho_mf_sles_t structure
+ * \param[in]      name       name of the linear system
+ * \param[in]      a          matrix (not used: NULL)
+ * \param[in]      verbosity  associated verbosity
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_mf_sles_setup(void               *context,
+               const char         *name,
+               const cs_matrix_t  *a,
+               int                 verbosity)
+{
+  CS_UNUSED(name);
+  CS_UNUSED(a);
+  CS_UNUSED(verbosity);
+
+  cs_timer_t  t0 = cs_timer_time();
+
+  cs_hho_mf_sles_t  *c = context;
+
+  const cs_range_set_t  *rset = c->rset;
+  const cs_lnum_t  n_scatter = rset->n_elts[1];
+
+  cs_real_t  *d = NULL;
+  BFT_MALLOC(d, n_scatter, cs_real_t);
+  cs_array_real_copy(n_scatter, c->diag, d);
+
+  if (rset->ifs != NULL)
+    cs_interface_set_sum(rset->ifs, n_scatter, 1, false, CS_REAL_TYPE, d);
+
+  cs_range_set_gather(rset, CS_REAL_TYPE, 1, d, d);
+
+  const cs_lnum_t  n = rset->n_elts[0];
+
+  BFT_REALLOC(c->inv_diag, n, cs_real_t);
+
+# pragma omp parallel for if (n > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n; i++)
+    c->inv_diag[i] = (fabs(d[i]) > 0) ? 1./d[i] : 1.;
+
+  BFT_FREE(d);
+
+  c->n_setups += 1;
+
+  cs_timer_t  t1 = cs_timer_time();
+  cs_timer_counter_add_diff(&(c->t_setup), &t0, &t1);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Solve the linear system with a conjugate gradient preconditioned
+ *         by a Jacobi algorithm. The operator is applied thanks to the
+ *         matvec function (no matrix). Function of type cs_sles_solve_t.
+ *
+ * \param[in, out] context      pointer to a cs_hho_mf_sles_t structure
+ * \param[in]      name         name of the linear system
+ * \param[in]      a            matrix (not used: NULL)
+ * \param[in]      verbosity    associated verbosity
+ * \param[in]      precision    solver precision
+ * \param[in]      r_norm       residual normalization
+ * \param[out]     n_iter       number of "equivalent" iterations
+ * \param[out]     residual     residual
+ * \param[in]      rhs          right hand side (gather view)
+ * \param[in, out] vx           system solution (gather view)
+ * \param[in]      aux_size     not used
+ * \param[in]      aux_vectors  not used
+ *
+ * \return the convergence state
+ */
+/*----------------------------------------------------------------------------*/
+
+static cs_sles_convergence_state_t
+_mf_sles_solve(void                *context,
+               const char          *name,
+               const cs_matrix_t   *a,
+               int                  verbosity,
+               double               precision,
+               double               r_norm,
+               int                 *n_iter,
+               double              *residual,
+               const cs_real_t     *rhs,
+               cs_real_t           *vx,
+               size_t               aux_size,
+               void                *aux_vectors)
+{
+  CS_UNUSED(aux_size);
+  CS_UNUSED(aux_vectors);
+
+  cs_hho_mf_sles_t  *c = context;
+
+  if (c->inv_diag == NULL)
+    _mf_sles_setup(context, name, a, verbosity);
+
+  cs_timer_t  t0 = cs_timer_time();
+
+  const cs_lnum_t  n = c->rset->n_elts[0];
+  const cs_lnum_t  n_scatter = c->rset->n_elts[1];
+
+  /* Workspace: r, z, p, q (gather view) and xs, ys (scatter view) */
+
+  cs_real_t  *wsp = NULL;
+  BFT_MALLOC(wsp, 4*n + 2*n_scatter, cs_real_t);
+
+  cs_real_t  *r = wsp, *z = wsp + n, *p = wsp + 2*n, *q = wsp + 3*n;
+  cs_real_t  *xs = wsp + 4*n, *ys = xs + n_scatter;
+
+  /* Same convergence criterion as the other iterative solvers:
+     ||r|| < precision * r_norm */
+
+  cs_param_sles_cvg_t  cvgp = {.n_max_iter = c->n_max_iter,
+                               .atol = 0.,
+                               .rtol = precision,
+                               .dtol = 1e3};
+
+  cs_iter_algo_t  *algo = cs_iter_algo_create(verbosity - 1, cvgp);
+
+  algo->normalization = r_norm;
+  algo->tol = precision*r_norm;
+
+  /* r = b - A.x */
+
+  _mf_matvec(c, vx, xs, ys, q);
+
+# pragma omp parallel for if (n > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n; i++)
+    r[i] = rhs[i] - q[i];
+
+  algo->res0 = sqrt(_mf_dot(n, r, r));
+  algo->res = algo->res0;
+
+  if (algo->res <= algo->tol) /* Also handle the case of a null residual */
+    algo->cvg_status = CS_SLES_CONVERGED;
+
+  double  rz_old = 1.;
+
+  while (algo->cvg_status == CS_SLES_ITERATING) {
+
+    /* Preconditioning: z = D^-1.r */
+
+#   pragma omp parallel for if (n > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n; i++)
+      z[i] = c->inv_diag[i] * r[i];
+
+    const double  rz = _mf_dot(n, r, z);
+
+    /* New descent direction */
+
+    if (algo->n_algo_iter == 0)
+      cs_array_real_copy(n, z, p);
+
+    else {
+
+      const double  beta = rz/rz_old;
+
+#     pragma omp parallel for if (n > CS_THR_MIN)
+      for (cs_lnum_t i = 0; i < n; i++)
+        p[i] = z[i] + beta*p[i];
+
+    }
+
+    rz_old = rz;
+
+    /* q = A.p (operators are computed on-the-fly) */
+
+    _mf_matvec(c, p, xs, ys, q);
+
+    const double  alpha = rz/_mf_dot(n, p, q);
+
+#   pragma omp parallel for if (n > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n; i++) {
+      vx[i] += alpha*p[i];
+      r[i] -= alpha*q[i];
+    }
+
+    algo->prev_res = algo->res;
+    algo->res = sqrt(_mf_dot(n, r, r));
+
+    cs_iter_algo_update_cvg(algo);
+
+    if (verbosity > 2)
+      cs_log_printf(CS_LOG_DEFAULT,
+                    "  [%s] matrix-free PCG It.%4d residual %10.4e\n",
+                    name, algo->n_algo_iter, algo->res);
+
+  } /* Main loop */
+
+  if (verbosity > 1)
+    cs_log_printf(CS_LOG_DEFAULT,
+                  "  [%s] matrix-free PCG: n_iter %d residual %10.4e"
+                  " (cvg %d)\n",
+                  name, algo->n_algo_iter, algo->res, algo->cvg_status);
+
+  cs_iter_algo_post_check(__func__, name, "Matrix-free PCG", algo);
+
+  *n_iter = algo->n_algo_iter;
+  *residual = algo->res;
+
+  cs_sles_convergence_state_t  cvg_status = algo->cvg_status;
+
+  /* Monitoring */
+
+  c->n_solves += 1;
+  if (c->n_iterations_min < 0 || c->n_iterations_min > *n_iter)
+    c->n_iterations_min = *n_iter;
+  if (c->n_iterations_max < *n_iter)
+    c->n_iterations_max = *n_iter;
+  c->n_iterations_tot += *n_iter;
+
+  BFT_FREE(algo);
+  BFT_FREE(wsp);
+
+  cs_timer_t  t1 = cs_timer_time();
+  cs_timer_counter_add_diff(&(c->t_solve), &t0, &t1);
+
+  return cvg_status;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Free the data related to a setup of the matrix-free solver.
+ *         Function of type cs_sles_free_t.
+ *
+ * \param[in, out] context    pointer to a cs_hho_mf_sles_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_mf_sles_free(void  *context)
+{
+  cs_hho_mf_sles_t  *c = context;
+
+  BFT_FREE(c->inv_diag);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Log the setup and the performance of the matrix-free solver.
+ *         Function of type cs_sles_log_t.
+ *
+ * \param[in] context    pointer to a cs_hho_mf_sles_t structure
+ * \param[in] log_type   log type
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_mf_sles_log(const void  *context,
+             cs_log_t     log_type)
+{
+  const cs_hho_mf_sles_t  *c = context;
+
+  if (log_type == CS_LOG_SETUP) {
+
+    cs_log_printf(log_type,
+                  "  Solver type:                       %s\n"
+                  "  Preconditioning:                   %s\n"
+                  "  Maximum number of iterations:      %d\n",
+                  "Matrix-free conjugate gradient", "Jacobi", c->n_max_iter);
+
+  }
+  else if (log_type == CS_LOG_PERFORMANCE) {
+
+    int  n_it_min = CS_MAX(c->n_iterations_min, 0);
+    int  n_it_mean = 0;
+    if (c->n_solves > 0)
+      n_it_mean = (int)(c->n_iterations_tot/((unsigned long long)c->n_solves));
+
+    cs_log_printf(log_type,
+                  "\n"
+                  "  Solver type:                   %s\n"
+                  "  Number of setups:              %12d\n"
+                  "  Number of calls:               %12d\n"
+                  "  Minimum number of iterations:  %12d\n"
+                  "  Maximum number of iterations:  %12d\n"
+                  "  Mean number of iterations:     %12d\n"
+                  "  Total setup time:              %12.3f\n"
+                  "  Total solution time:           %12.3f\n",
+                  "Matrix-free conjugate gradient (Jacobi)",
+                  c->n_setups, c->n_solves, n_it_min, c->n_iterations_max,
+                  n_it_mean, c->t_setup.nsec*1e-9, c->t_solve.nsec*1e-9);
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Destroy the context of the matrix-free solver.
+ *         Function of type cs_sles_destroy_t.
+ *
+ * \param[in, out] context    pointer of pointer to a cs_hho_mf_sles_t struct.
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_mf_sles_destroy(void  **context)
+{
+  cs_hho_mf_sles_t  *c = *context;
+
+  if (c == NULL)
+    return;
+
+  BFT_FREE(c->inv_diag);
+  BFT_FREE(c->input);
+  BFT_FREE(c);
+
+  *context = NULL;
+}
+
 /*============================================================================
  * Public function prototypes
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Define the linear solver used in the matrix-free mode. The related
+ *         cs_sles_t structure is associated to the field id (or the name) set
+ *         in the SLES parameters. This replaces the previous definition.
+ *         The linear system is solved with a conjugate gradient using a Jacobi
+ *         preconditioner. Only the tolerance and the max. number of iterations
+ *         set in the SLES parameters are used.
+ *
+ * \param[in]      slesp    set of parameters for the linear algebra
+ * \param[in]      rset     pointer to the range set related to the face DoFs
+ * \param[in]      diag     diagonal of the operator (scatter view, shared)
+ * \param[in]      matvec   function applying the operator
+ * \param[in, out] input    structure used by matvec (owned by the solver)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hho_builder_set_mf_sles(const cs_param_sles_t     *slesp,
+                           const cs_range_set_t      *rset,
+                           const cs_real_t           *diag,
+                           cs_hho_builder_matvec_t   *matvec,
+                           void                      *input)
+{
+  assert(slesp != NULL && rset != NULL && matvec != NULL);
+
+  cs_hho_mf_sles_t  *c = NULL;
+  BFT_MALLOC(c, 1, cs_hho_mf_sles_t);
+
+  c->rset = rset;
+  c->diag = diag;
+  c->matvec = matvec;
+  c->input = input;
+
+  c->n_max_iter = slesp->cvg_param.n_max_iter;
+  c->inv_diag = NULL;
+
+  c->n_setups = 0;
+  c->n_solves = 0;
+  c->n_iterations_min = -1;
+  c->n_iterations_max = 0;
+  c->n_iterations_tot = 0;
+
+  CS_TIMER_COUNTER_INIT(c->t_setup);
+  CS_TIMER_COUNTER_INIT(c->t_solve);
+
+  const int  f_id = (slesp->field_id > -1) ? slesp->field_id : -1;
+  const char  *name = (f_id > -1) ? NULL : slesp->name;
+
+  cs_sles_t  *sles = cs_sles_define(f_id, name,
+                                    c,
+                                    "cs_hho_mf_sles_t",
+                                    _mf_sles_setup,
+                                    _mf_sles_solve,
+                                    _mf_sles_free,
+                                    _mf_sles_log,
+                                    NULL,  /* copy */
+                                    _mf_sles_destroy);
+
+  /* The error handler of the previous definition (if any) is not compatible
+     with this context. Errors are handled inside the solve function. */
+
+  cs_sles_set_error_handler(sles, NULL);
+  cs_sles_set_verbosity(sles, slesp->verbosity);
+
+  /* The settings of the solver and of the preconditioner are not used */
+
+  if (slesp->solver != CS_PARAM_ITSOL_CG ||
+      slesp->precond != CS_PARAM_PRECOND_DIAG) {
+
+    cs_base_warn(__FILE__, __LINE__);
+    bft_printf(" %s: System \"%s\" is solved in a matrix-free way.\n"
+               " %s: The settings \"%s\" (solver) and \"%s\""
+               " (preconditioner) are replaced by a conjugate gradient"
+               " with a Jacobi preconditioner.\n",
+               __func__, slesp->name, __func__,
+               cs_param_get_solver_name(slesp->solver),
+               cs_param_get_precond_name(slesp->precond));
+
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Allocate  a cs_hho_builder_t structure
@@ -34,7 +34,9 @@
 #include "cs_base.h"
 #include "cs_basis_func.h"
 #include "cs_cdo_connect.h"
+#include "cs_param_sles.h"
 #include "cs_property.h"
+#include "cs_range_set.h"
 #include "cs_sdm.h"
 #include "cs_xdef.h"
 
@@ -72,10 +74,54 @@ typedef struct {
 
 } cs_hho_builder_t;
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Apply the operator of a HHO system (i.e. after the static
+ *         condensation and the enforcement of the boundary conditions)
+ *         without assembling it: y = A.x
+ *         x and y are in a scatter view (size = number of face DoFs). y has
+ *         been set to zero before the call. Contributions of DoFs shared with
+ *         other ranks are summed afterwards by the calling function.
+ *
+ * \param[in]      input   pointer to a structure cast on-the-fly
+ * \param[in]      x       array of values to multiply by the operator
+ * \param[in, out] y       resulting array
+ */
+/*----------------------------------------------------------------------------*/
+
+typedef void
+(cs_hho_builder_matvec_t)(void              *input,
+                          const cs_real_t   *x,
+                          cs_real_t         *y);
+
 /*============================================================================
  * Public function prototypes
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Define the linear solver used in the matrix-free mode. The related
+ *         cs_sles_t structure is associated to the field id (or the name) set
+ *         in the SLES parameters. This replaces the previous definition.
+ *         The linear system is solved with a conjugate gradient using a Jacobi
+ *         preconditioner. Only the tolerance and the max. number of iterations
+ *         set in the SLES parameters are used.
+ *
+ * \param[in]      slesp    set of parameters for the linear algebra
+ * \param[in]      rset     pointer to the range set related to the face DoFs
+ * \param[in]      diag     diagonal of the operator (scatter view, shared)
+ * \param[in]      matvec   function applying the operator
+ * \param[in, out] input    structure used by matvec (owned by the solver)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hho_builder_set_mf_sles(const cs_param_sles_t     *slesp,
+                           const cs_range_set_t      *rset,
+                           const cs_real_t           *diag,
+                           cs_hho_builder_matvec_t   *matvec,
+                           void                      *input);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Allocate  a cs_hho_builder_t structure
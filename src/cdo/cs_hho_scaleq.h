@@ -205,6 +205,24 @@ cs_hho_scaleq_build_system(const cs_mesh_t            *mesh,
                            cs_equation_builder_t      *eqb,
                            void                       *context);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Define the linear solver used when the matrix-free mode is
+ *         activated. The global matrix is never assembled: the scalar-valued
+ *         HHO operator is applied cellwise inside the iterative solver.
+ *         Nothing is done if the matrix-free mode is not activated.
+ *
+ * \param[in]      eqp        pointer to a cs_equation_param_t structure
+ * \param[in]      eqb        pointer to a cs_equation_builder_t structure
+ * \param[in]      context    pointer to cs_hho_scaleq_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hho_scaleq_set_sles(const cs_equation_param_t     *eqp,
+                      const cs_equation_builder_t   *eqb,
+                      void                          *context);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Store solution(s) of the linear system into a field structure
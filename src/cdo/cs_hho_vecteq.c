@@ -44,6 +44,7 @@
 
 #include <bft_mem.h>
 
+#include "cs_array.h"
 #include "cs_boundary_zone.h"
 #include "cs_cdo_advection.h"
 #include "cs_cdo_assembly.h"
@@ -127,8 +128,22 @@ struct _cs_hho_vecteq_t {
      usage */
   cs_sdm_t                      *acf_tilda;
 
+  /* Matrix-free mode: diagonal of the (unassembled) global matrix. Only
+     allocated if the matrix-free mode is activated */
+  cs_real_t                     *mf_diag;
+
 };
 
+/* Set of structures needed to apply the operator in the matrix-free mode */
+
+typedef struct {
+
+  const cs_equation_param_t     *eqp;
+  const cs_equation_builder_t   *eqb;
+  const cs_hho_vecteq_t         *eqc;
+
+} cs_hho_vecteq_mf_input_t;
+
 /*============================================================================
  * Private variables
  *============================================================================*/
@@ -420,6 +435,120 @@ _vhho_init_cell_system(const cs_cell_mesh_t         *cm,
 
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Add the scalar-valued local diffusion operator to each component
+ *          of the vector-valued local system (block diagonal w.r.t. the
+ *          components)
+ *
+ * \param[in]      loc       local scalar-valued diffusion operator
+ * \param[in, out] mat       local matrix of the vector-valued system
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_add_vector_diffusion(const cs_sdm_t    *loc,
+                      cs_sdm_t          *mat)
+{
+  const int n_blocks = loc->block_desc->n_col_blocks;
+
+  for (int bi = 0; bi < n_blocks ; bi++) {
+    for (int bj = 0; bj < n_blocks ; bj++) {
+
+      /* Retrieve the scalar & vector diffusion matrix */
+      /* Both have the same block structures, what is different are the
+         sizes on each block*/
+      const cs_sdm_t  *scalar_bij = cs_sdm_get_block(loc, bi, bj);
+      cs_sdm_t  *vector_bij = cs_sdm_get_block(mat, bi, bj);
+
+      const int  sc_n_rows = scalar_bij->n_rows;
+      const int  sc_n_cols = scalar_bij->n_cols;
+      const int  vec_n_cols = vector_bij->n_cols;
+
+      for (int row_k = 0; row_k < sc_n_rows ; row_k++) {
+        for (int col_l = 0; col_l < sc_n_cols ; col_l++) {
+          const cs_real_t val_ = scalar_bij->val[sc_n_cols*row_k + col_l];
+          /* Make it Block Diagonal */
+          vector_bij->val[vec_n_cols*row_k + col_l] += val_;
+          vector_bij->val[vec_n_cols*(row_k+sc_n_rows)
+                          + (col_l +   sc_n_cols)]  += val_;
+          vector_bij->val[vec_n_cols*(row_k+2*sc_n_rows)
+                          + (col_l + 2*sc_n_cols)]  += val_;
+
+        } /* row_k */
+      } /* col_l */
+
+    } /* for bj */
+  } /* for bi */
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Static condensation of the local system matrix of n_fc + 1 blocks
+ *          into a matrix of n_fc blocks using the blocks acf_tilda already
+ *          computed and stored in the scheme context.
+ *          Compute m_FF = m_FF - m_FC * m_CC_inv * m_CF
+ *
+ * \param[in]      c2f       pointer to a cs_adjacency_t structure
+ * \param[in]      eqc       pointer to a cs_hho_vecteq_t structure
+ * \param[in, out] cb        pointer to a cs_cell_builder_t structure
+ * \param[in, out] csys      pointer to a cs_cell_sys_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_condense_matrix(const cs_adjacency_t    *c2f,
+                 const cs_hho_vecteq_t   *eqc,
+                 cs_cell_builder_t       *cb,
+                 cs_cell_sys_t           *csys)
+{
+  cs_sdm_t  *m = csys->mat;
+  cs_sdm_block_t  *bd = m->block_desc;
+
+  const int  n_fc = bd->n_row_blocks - 1;
+  const int  _f_offset = eqc->n_face_dofs*n_fc;
+  const cs_lnum_t  c2f_shift = c2f->idx[csys->c_id];
+
+  cs_sdm_t  *_aff = cb->aux;
+
+  for (int fi = 0; fi < n_fc; fi++) {
+
+    /* Initial block to update */
+    const cs_sdm_t  *m_fc = cs_sdm_get_block(m, fi, n_fc);
+
+    for (int fj = 0; fj < n_fc; fj++) {
+
+      cs_sdm_t  *mFF = cs_sdm_get_block(m, fi, fj);
+      cs_sdm_t  *_acf = cs_sdm_get_block(eqc->acf_tilda, c2f_shift + fj, 0);
+
+      cs_sdm_init(eqc->n_face_dofs, eqc->n_face_dofs, _aff);
+      cs_sdm_multiply_rowrow(m_fc, _acf, _aff);
+      cs_sdm_add_mult(mFF, -1, _aff);
+
+    } /* fj */
+  } /* fi */
+
+  /* Reshape matrix */
+  int  shift = n_fc;
+  for (short int bfi = 1; bfi < n_fc; bfi++) {
+    for (short int bfj = 0; bfj < n_fc; bfj++) {
+
+      cs_sdm_t  *mFF_old = cs_sdm_get_block(m, bfi, bfj);
+
+      /* Set the block (i,j) */
+      cs_sdm_t  *mFF = bd->blocks + shift;
+      cs_sdm_map_array(eqc->n_face_dofs, eqc->n_face_dofs, mFF, mFF_old->val);
+      shift++;
+
+    }
+  }
+
+  csys->n_dofs = _f_offset;
+  m->n_rows = m->n_cols = _f_offset;
+  bd->n_row_blocks = n_fc;      /* instead of n_fc + 1 */
+  bd->n_col_blocks = n_fc;      /* instead of n_fc + 1 */
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief   Proceed to a static condensation of the local system and keep
@@ -523,57 +652,137 @@ _condense_and_store(const cs_adjacency_t    *c2f,
     break;
   }
 
-  /* Update csys:
-     Compute m_FF = m_FF - m_FC * m_CC_inv * m_CF */
+  /* Update RHS: RHS_f = RHS_f - Afc*Acc^-1*s_c */
   cs_real_t  *bf_tilda = cb->values;
-  cs_sdm_t  *_aff = cb->aux;
 
   for (int fi = 0; fi < n_fc; fi++) {
 
-    /* Initial block to update */
-    cs_sdm_t  *m_fc = cs_sdm_get_block(m, fi, n_fc);
+    const cs_sdm_t  *m_fc = cs_sdm_get_block(m, fi, n_fc);
 
     cs_sdm_matvec(m_fc, eqc->rc_tilda + c_offset, bf_tilda);
 
-    /* Update RHS: RHS_f = RHS_f - Afc*Acc^-1*s_c */
     for (int k = 0; k < eqc->n_face_dofs; k++)
       csys->rhs[eqc->n_face_dofs*fi + k] -= bf_tilda[k];
 
-    for (int fj = 0; fj < n_fc; fj++) {
+  } /* fi */
 
-      cs_sdm_t  *mFF = cs_sdm_get_block(m, fi, fj);
-      cs_sdm_t  *_acf = cs_sdm_get_block(eqc->acf_tilda, c2f_shift + fj, 0);
+  _condense_matrix(c2f, eqc, cb, csys);
+}
 
-      cs_sdm_init(eqc->n_face_dofs, eqc->n_face_dofs, _aff);
-      cs_sdm_multiply_rowrow(m_fc, _acf, _aff);
-      cs_sdm_add_mult(mFF, -1, _aff);
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Apply the global operator without assembling it (matrix-free
+ *          mode): y = A.x where A is the matrix resulting from the static
+ *          condensation and the enforcement of the Dirichlet BCs. The cellwise
+ *          gradient reconstruction and stabilization operators are recomputed
+ *          on-the-fly. Function of type cs_hho_builder_matvec_t.
+ *
+ * \param[in]      input   pointer to a cs_hho_vecteq_mf_input_t structure
+ * \param[in]      x       array of values to multiply (scatter view)
+ * \param[in, out] y       resulting array (scatter view)
+ */
+/*----------------------------------------------------------------------------*/
 
-    } /* fj */
-  } /* fi */
+static void
+_mf_matvec(void              *input,
+           const cs_real_t   *x,
+           cs_real_t         *y)
+{
+  const cs_hho_vecteq_mf_input_t  *mfi = input;
+  const cs_equation_param_t  *eqp = mfi->eqp;
+  const cs_equation_builder_t  *eqb = mfi->eqb;
+  const cs_hho_vecteq_t  *eqc = mfi->eqc;
 
-  /* Reshape matrix */
-  int  shift = n_fc;
-  for (short int bfi = 1; bfi < n_fc; bfi++) {
-    for (short int bfj = 0; bfj < n_fc; bfj++) {
+  const cs_cdo_quantities_t  *quant = cs_shared_quant;
+  const cs_cdo_connect_t  *connect = cs_shared_connect;
+  const cs_time_step_t  *ts = cs_shared_time_step;
+  const cs_real_t  t_cur = ts->t_cur;
+  const cs_real_t  dt_cur = ts->dt[0];
 
-      cs_sdm_t  *mFF_old = cs_sdm_get_block(m, bfi, bfj);
+  if (!cs_equation_param_has_diffusion(eqp))
+    return;
 
-      /* Set the block (i,j) */
-      cs_sdm_t  *mFF = bd->blocks + shift;
-      cs_sdm_map_array(eqc->n_face_dofs, eqc->n_face_dofs, mFF, mFF_old->val);
-      shift++;
+# pragma omp parallel if (quant->n_cells > CS_THR_MIN)
+  {
+    const int  t_id = cs_get_thread_id();
 
-    }
-  }
+    cs_cell_mesh_t  *cm = cs_cdo_local_get_cell_mesh(t_id);
+    cs_cell_sys_t  *csys = cs_hho_cell_sys[t_id];
+    cs_cell_builder_t  *cb = cs_hho_cell_bld[t_id];
+    cs_hho_builder_t  *hhob = cs_hho_builders[t_id];
 
-  csys->n_dofs = _f_offset;
-  m->n_rows = m->n_cols = _f_offset;
-  bd->n_row_blocks = n_fc;      /* instead of n_fc + 1 */
-  bd->n_col_blocks = n_fc;      /* instead of n_fc + 1 */
-}
+    cb->t_pty_eval = t_cur + eqp->theta*dt_cur;
+    cb->t_bc_eval = t_cur + dt_cur;
+
+    cs_property_data_t  *diff_pty = NULL;
+    BFT_MALLOC(diff_pty, 1, cs_property_data_t);
+    cs_property_data_init(true, true, eqp->diffusion_property, diff_pty);
+
+    cs_equation_builder_init_properties(eqp, eqb, NULL, cb);
+
+    cs_property_get_cell_tensor(0,
+                                cb->t_pty_eval,
+                                eqp->diffusion_property,
+                                eqp->diffusion_hodgep.inv_pty,
+                                diff_pty->tensor);
 
+    if (diff_pty->is_iso)
+      diff_pty->value = diff_pty->tensor[0][0];
 
+#   pragma omp for CS_CDO_OMP_SCHEDULE
+    for (cs_lnum_t c_id = 0; c_id < quant->n_cells; c_id++) {
+
+      cb->cell_flag = connect->cell_flag[c_id];
+
+      cs_cell_mesh_build(c_id,
+                         cs_equation_builder_cell_mesh_flag(cb->cell_flag, eqb),
+                         connect, quant, cm);
+
+      cs_hho_builder_cellwise_setup(cm, cb, hhob);
+
+      _vhho_init_cell_system(cm, eqp, eqb, eqc, hhob, csys, cb);
+
+      if (!(eqb->diff_pty_uniform)) {
 
+        cs_property_tensor_in_cell(cm,
+                                   eqp->diffusion_property,
+                                   cb->t_pty_eval,
+                                   eqp->diffusion_hodgep.inv_pty,
+                                   diff_pty->tensor);
+
+        if (diff_pty->is_iso)
+          diff_pty->value = diff_pty->tensor[0][0];
+
+      }
+
+      /* Same local operator as the one built in cs_hho_vecteq_build_system */
+      cs_hho_builder_compute_grad_reco(cm, diff_pty, cb, hhob);
+      cs_hho_builder_diffusion(cm, diff_pty, cb, hhob);
+      _add_vector_diffusion(cb->loc, csys->mat);
+
+      _condense_matrix(connect->c2f, eqc, cb, csys);
+
+      if (cb->cell_flag & CS_FLAG_BOUNDARY_CELL_BY_FACE)
+        cs_cdo_diffusion_pena_block_dirichlet(eqp, cm, NULL, NULL, cb, csys);
+
+      /* Local matrix-vector product. The local rhs and source term arrays
+         are not used in this context and serve as buffers */
+      for (short int i = 0; i < csys->n_dofs; i++)
+        csys->rhs[i] = x[csys->dof_ids[i]];
+
+      cs_sdm_block_matvec(csys->mat, csys->rhs, csys->source);
+
+      for (short int i = 0; i < csys->n_dofs; i++) {
+#       pragma omp atomic
+        y[csys->dof_ids[i]] += csys->source[i];
+      }
+
+    } /* Main loop on cells */
+
+    BFT_FREE(diff_pty);
+
+  } /* OPENMP Block */
+}
 
 /*============================================================================
  * Public function prototypes
@@ -841,13 +1050,32 @@ cs_hho_vecteq_init_context(const cs_equation_param_t   *eqp,
 
   }
 
-  cs_cdo_system_add_dblock(sh, 0,
-                           matclass,
-                           cs_flag_primal_face,
-                           n_faces,
-                           eqc->n_face_dofs, /* stride */
-                           false,            /* interlaced */
-                           true);            /* unrolled */
+  eqc->mf_diag = NULL;
+
+  if (eqp->matrix_free) {
+
+    /* Only the range set and the interface set are needed. The operator is
+       applied cellwise on-the-fly */
+
+    cs_cdo_system_add_ublock(sh, 0,
+                             connect->f2f,
+                             cs_flag_primal_face,
+                             n_faces,
+                             eqc->n_face_dofs, /* stride */
+                             true);            /* interlaced */
+
+    BFT_MALLOC(eqc->mf_diag, eqc->n_dofs, cs_real_t);
+    cs_array_real_fill_zero(eqc->n_dofs, eqc->mf_diag);
+
+  }
+  else
+    cs_cdo_system_add_dblock(sh, 0,
+                             matclass,
+                             cs_flag_primal_face,
+                             n_faces,
+                             eqc->n_face_dofs, /* stride */
+                             true,             /* interlaced */
+                             true);            /* unrolled */
 
   cs_cdo_system_build_block(sh, 0); /* build/set structures */
 
@@ -941,6 +1169,7 @@ cs_hho_vecteq_free_context(void   *data)
   BFT_FREE(eqc->rc_tilda);
   BFT_FREE(eqc->source_terms);
   BFT_FREE(eqc->bf2def_ids);
+  BFT_FREE(eqc->mf_diag);
 
   cs_sdm_free(eqc->acf_tilda);
 
@@ -1142,6 +1371,9 @@ cs_hho_vecteq_build_system(const cs_mesh_t            *mesh,
 
   cs_cdo_system_helper_init_system(sh, &rhs);
 
+  if (eqc->mf_diag != NULL)
+    cs_array_real_fill_zero(eqc->n_dofs, eqc->mf_diag);
+
 # pragma omp parallel if (quant->n_cells > CS_THR_MIN)
   {
     const int  t_id = cs_get_thread_id();
@@ -1229,36 +1461,7 @@ cs_hho_vecteq_build_system(const cs_mesh_t            *mesh,
         cs_hho_builder_diffusion(cm, diff_pty, cb, hhob);
 
         /* Add the local diffusion operator to the local system */
-        int n_blocks = cb->loc->block_desc->n_col_blocks;
-
-        for (int bi = 0; bi < n_blocks ; bi++) {
-          for (int bj = 0; bj < n_blocks ; bj++) {
-
-            /* Retrieve the scalar & vector diffusion matrix */
-            /* Both have the same block structures, what is different are the
-               sizes on each block*/
-            const cs_sdm_t  *scalar_bij = cs_sdm_get_block(cb->loc, bi, bj);
-            cs_sdm_t  *vector_bij = cs_sdm_get_block(csys->mat, bi, bj);
-
-            const int  sc_n_rows = scalar_bij->n_rows;
-            const int  sc_n_cols = scalar_bij->n_cols;
-            const int  vec_n_cols = vector_bij->n_cols;
-
-            for (int row_k = 0; row_k < sc_n_rows ; row_k++) {
-              for (int col_l = 0; col_l < sc_n_cols ; col_l++) {
-                const cs_real_t val_ = scalar_bij->val[sc_n_cols*row_k + col_l];
-                /* Make it Block Diagonal */
-                vector_bij->val[vec_n_cols*row_k + col_l] += val_;
-                vector_bij->val[vec_n_cols*(row_k+sc_n_rows)
-                                + (col_l +   sc_n_cols)]  += val_;
-                vector_bij->val[vec_n_cols*(row_k+2*sc_n_rows)
-                                + (col_l + 2*sc_n_cols)]  += val_;
-
-              } /* row_k */
-            } /* col_l */
-
-          } /* for bj */
-        } /* for bi */
+        _add_vector_diffusion(cb->loc, csys->mat);
 
 #if defined(DEBUG) && !defined(NDEBUG) && CS_HHO_VECTEQ_DBG > 1
         if (_test_debug_cellwise(cm))
@@ -1341,12 +1544,34 @@ cs_hho_vecteq_build_system(const cs_mesh_t            *mesh,
       /* ASSEMBLY */
       /* ======== */
 
-      cs_cdo_system_block_t  *block = sh->blocks[0];
-      cs_cdo_system_dblock_t  *db = block->block_pointer;
+      if (eqc->mf_diag != NULL) {
 
-      /* Matrix assembly */
+        /* Matrix-free mode: only the diagonal is kept (preconditioning) */
 
-      db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb, db->mav);
+        for (short int f = 0; f < cm->n_fc; f++) {
+
+          const cs_sdm_t  *mFF = cs_sdm_get_block(csys->mat, f, f);
+          const cs_lnum_t  *_dof_ids = csys->dof_ids + f*eqc->n_face_dofs;
+
+          for (int k = 0; k < eqc->n_face_dofs; k++) {
+#           pragma omp atomic
+            eqc->mf_diag[_dof_ids[k]] += mFF->val[k*(eqc->n_face_dofs + 1)];
+          }
+
+        }
+
+      }
+      else {
+
+        cs_cdo_system_block_t  *block = sh->blocks[0];
+        cs_cdo_system_dblock_t  *db = block->block_pointer;
+
+        /* Matrix assembly */
+
+        db->assembly_func(csys->mat, csys->dof_ids, db->range_set, asb,
+                          db->mav);
+
+      }
 
       /* RHS assembly */
 
@@ -1376,6 +1601,47 @@ cs_hho_vecteq_build_system(const cs_mesh_t            *mesh,
   cs_timer_counter_add_diff(&(eqb->tcb), &t0, &t1);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Define the linear solver used when the matrix-free mode is
+ *         activated. The global matrix is never assembled: the vector-valued
+ *         HHO operator is applied cellwise inside the iterative solver.
+ *         Nothing is done if the matrix-free mode is not activated.
+ *
+ * \param[in]      eqp        pointer to a cs_equation_param_t structure
+ * \param[in]      eqb        pointer to a cs_equation_builder_t structure
+ * \param[in]      context    pointer to cs_hho_vecteq_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hho_vecteq_set_sles(const cs_equation_param_t     *eqp,
+                      const cs_equation_builder_t   *eqb,
+                      void                          *context)
+{
+  if (!eqp->matrix_free)
+    return;
+
+  assert(eqb != NULL && context != NULL);
+
+  cs_hho_vecteq_t  *eqc = (cs_hho_vecteq_t *)context;
+
+  cs_hho_vecteq_mf_input_t  *mfi = NULL;
+  BFT_MALLOC(mfi, 1, cs_hho_vecteq_mf_input_t);
+
+  mfi->eqp = eqp;
+  mfi->eqb = eqb;
+  mfi->eqc = eqc;
+
+  /* The ownership of mfi is transferred to the linear solver */
+
+  cs_hho_builder_set_mf_sles(eqp->sles_param,
+                             cs_equation_builder_get_range_set(eqb, 0),
+                             eqc->mf_diag,
+                             _mf_matvec,
+                             mfi);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Store solution(s) of the linear system into a field structure
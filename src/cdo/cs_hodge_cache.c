@@ -0,0 +1,367 @@
+/*============================================================================
+ * Cache of cellwise discrete Hodge operators and related operators
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <string.h>
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include <bft_mem.h>
+
+/*----------------------------------------------------------------------------
+ * Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_hodge_cache.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_hodge_cache.c
+
+  \brief Store cellwise operators (discrete Hodge operators, stiffness
+         matrices...) so that they are computed only once when they do not
+         depend on time.
+
+  The cache is filled during the first build of the linear system. Each cell
+  is handled by only one thread so that no synchronization is needed.
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*============================================================================
+ * Private function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Copy a local square matrix into its packed storage
+ *
+ * parameters:
+ *   symmetric <-- true if only the upper part is stored
+ *   m         <-- local matrix to copy
+ *   packed    --> packed values
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_pack(bool             symmetric,
+      const cs_sdm_t  *m,
+      cs_real_t       *packed)
+{
+  const int  n = m->n_rows;
+
+  if (symmetric) {
+
+    cs_real_t  *_p = packed;
+    for (int i = 0; i < n; i++) {
+      const cs_real_t  *m_i = m->val + i*n;
+      for (int j = i; j < n; j++, _p++)
+        *_p = m_i[j];
+    }
+
+  }
+  else
+    memcpy(packed, m->val, n*n*sizeof(cs_real_t));
+}
+
+/*----------------------------------------------------------------------------
+ * Set a local square matrix of size n from its packed storage
+ *
+ * parameters:
+ *   symmetric <-- true if only the upper part is stored
+ *   n         <-- size of the local matrix
+ *   packed    <-- packed values
+ *   m         --> local matrix to set
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_unpack(bool              symmetric,
+        int               n,
+        const cs_real_t  *packed,
+        cs_sdm_t         *m)
+{
+  assert(n <= m->n_max_rows && n <= m->n_max_cols);
+
+  m->n_rows = m->n_cols = n;
+
+  if (symmetric) {
+
+    const cs_real_t  *_p = packed;
+    for (int i = 0; i < n; i++) {
+      cs_real_t  *m_i = m->val + i*n;
+      m_i[i] = *_p++;
+      for (int j = i + 1; j < n; j++, _p++) {
+        m_i[j] = *_p;
+        m->val[j*n + i] = *_p;
+      }
+    }
+
+  }
+  else
+    memcpy(m->val, packed, n*n*sizeof(cs_real_t));
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Check if the local stiffness matrix related to a diffusion property
+ *         can be kept from one time step to another: the equation requests
+ *         it and the property is steady.
+ *
+ *         Properties defined by arrays are not considered since array values
+ *         may be updated in place (e.g. in the groundwater flow module).
+ *
+ * \param[in]  eqp       pointer to a cs_equation_param_t structure
+ * \param[in]  pty       pointer to the diffusion property
+ *
+ * \return true or false
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_hodge_cache_is_allowed(const cs_equation_param_t   *eqp,
+                          const cs_property_t         *pty)
+{
+  if (eqp == NULL)
+    return false;
+  if (!eqp->cache_cw_operators)
+    return false;
+
+  return cs_property_is_steady(pty);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Create a cache of cellwise operators. The number of DoFs in a cell
+ *         is the number of entities related to this cell in the adjacency
+ *         c2x plus n_extra_dofs (e.g. 1 for the cell DoF in CDO-Fb schemes)
+ *
+ * \param[in]  c2x           cell --> entities adjacency
+ * \param[in]  n_extra_dofs  number of additional DoFs in each cell
+ * \param[in]  symmetric     true if the cached operator is symmetric
+ *
+ * \return a pointer to a new allocated cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_hodge_cache_t *
+cs_hodge_cache_create(const cs_adjacency_t   *c2x,
+                      int                     n_extra_dofs,
+                      bool                    symmetric)
+{
+  assert(c2x != NULL);
+
+  cs_hodge_cache_t  *cache = NULL;
+
+  BFT_MALLOC(cache, 1, cs_hodge_cache_t);
+
+  cache->n_cells = c2x->n_elts;
+  cache->symmetric = symmetric;
+
+  BFT_MALLOC(cache->idx, cache->n_cells + 1, cs_lnum_t);
+  BFT_MALLOC(cache->n_dofs, cache->n_cells, short int);
+  BFT_MALLOC(cache->state, cache->n_cells, char);
+
+  cache->idx[0] = 0;
+  for (cs_lnum_t c_id = 0; c_id < cache->n_cells; c_id++) {
+
+    const cs_lnum_t  n = c2x->idx[c_id+1] - c2x->idx[c_id] + n_extra_dofs;
+    const cs_lnum_t  size = (symmetric) ? n*(n+1)/2 : n*n;
+
+    cache->n_dofs[c_id] = n;
+    cache->idx[c_id+1] = cache->idx[c_id] + size;
+
+  }
+
+  BFT_MALLOC(cache->val, cache->idx[cache->n_cells], cs_real_t);
+
+  cs_hodge_cache_reset(cache);
+
+  return cache;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Invalidate all the cached operators (for instance if the mesh or
+ *         the property has been modified)
+ *
+ * \param[in, out]  cache     pointer to a cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hodge_cache_reset(cs_hodge_cache_t   *cache)
+{
+  if (cache == NULL)
+    return;
+
+  memset(cache->state, CS_HODGE_CACHE_EMPTY, cache->n_cells*sizeof(char));
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Free a cs_hodge_cache_t structure
+ *
+ * \param[in, out]  p_cache   double pointer to a cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hodge_cache_free(cs_hodge_cache_t   **p_cache)
+{
+  cs_hodge_cache_t  *cache = *p_cache;
+
+  if (cache == NULL)
+    return;
+
+  BFT_FREE(cache->idx);
+  BFT_FREE(cache->n_dofs);
+  BFT_FREE(cache->state);
+  BFT_FREE(cache->val);
+
+  BFT_FREE(cache);
+  *p_cache = NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the local operator of the current cell from the cache or
+ *         compute it with the given function and store it in the cache.
+ *         If cache is NULL, this is equivalent to a call to compute.
+ *
+ * \param[in, out] cache     pointer to a cs_hodge_cache_t structure or NULL
+ * \param[in]      compute   function computing the local operator
+ * \param[in]      cm        pointer to a cs_cell_mesh_t structure
+ * \param[in, out] hodge     pointer to a cs_hodge_t structure
+ * \param[in, out] cb        pointer to a cs_cell_builder_t structure
+ * \param[in, out] op        local matrix in which compute stores the operator
+ *                           (cb->loc or hodge->matrix for instance)
+ *
+ * \return true if something has been computed or false otherwise.
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_hodge_cache_compute(cs_hodge_cache_t          *cache,
+                       cs_hodge_compute_t        *compute,
+                       const cs_cell_mesh_t      *cm,
+                       cs_hodge_t                *hodge,
+                       cs_cell_builder_t         *cb,
+                       cs_sdm_t                  *op)
+{
+  if (cache == NULL)
+    return compute(cm, hodge, cb);
+
+  const cs_lnum_t  c_id = cm->c_id;
+  const cs_lnum_t  s = cache->idx[c_id];
+
+  switch (cache->state[c_id]) {
+
+  case CS_HODGE_CACHE_SET:
+    _unpack(cache->symmetric, cache->n_dofs[c_id], cache->val + s, op);
+    return true;
+
+  case CS_HODGE_CACHE_SKIPPED:
+    return false;
+
+  default:
+    break;
+
+  }
+
+  /* First computation in this cell */
+
+  if (compute(cm, hodge, cb)) {
+
+    const int  n = op->n_rows;
+    assert(op->n_cols == n && n == cache->n_dofs[c_id]);
+
+    _pack(cache->symmetric, op, cache->val + s);
+    cache->state[c_id] = CS_HODGE_CACHE_SET;
+
+    /* Use the stored values so that the same operator is used at each time
+       step (symmetrization may introduce round-off differences) */
+
+    if (cache->symmetric)
+      _unpack(true, n, cache->val + s, op);
+
+    return true;
+
+  }
+  else {
+
+    cache->state[c_id] = CS_HODGE_CACHE_SKIPPED;
+    return false;
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Return the memory size (in bytes) used by a cache
+ *
+ * \param[in]  cache     pointer to a cs_hodge_cache_t structure or NULL
+ *
+ * \return the size in bytes
+ */
+/*----------------------------------------------------------------------------*/
+
+size_t
+cs_hodge_cache_memory_size(const cs_hodge_cache_t   *cache)
+{
+  if (cache == NULL)
+    return 0;
+
+  size_t  size = sizeof(cs_hodge_cache_t);
+
+  size += (cache->n_cells + 1)*sizeof(cs_lnum_t);
+  size += cache->n_cells*(sizeof(short int) + sizeof(char));
+  size += cache->idx[cache->n_cells]*sizeof(cs_real_t);
+
+  return size;
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -0,0 +1,186 @@
+#ifndef __CS_HODGE_CACHE_H__
+#define __CS_HODGE_CACHE_H__
+
+/*============================================================================
+ * Cache of cellwise discrete Hodge operators and related operators
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_cdo_local.h"
+#include "cs_equation_param.h"
+#include "cs_hodge.h"
+#include "cs_mesh_adjacencies.h"
+#include "cs_sdm.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/* State of the cached operator in a cell */
+
+#define CS_HODGE_CACHE_EMPTY      0  /* Not computed yet */
+#define CS_HODGE_CACHE_SET        1  /* Operator values are stored */
+#define CS_HODGE_CACHE_SKIPPED    2  /* Nothing to compute in this cell */
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*! \struct cs_hodge_cache_t
+ *  \brief Store the cellwise operators built by a \ref cs_hodge_compute_t
+ *         function so that they can be reused from one time step to another
+ *
+ *  The local operator related to a cell with n DoFs is a square matrix of
+ *  size n. If the operator is symmetric, only its upper triangular part is
+ *  stored (packed storage by row).
+ */
+
+typedef struct {
+
+  cs_lnum_t      n_cells;    /*!< Number of cells */
+  bool           symmetric;  /*!< Only the upper part is stored */
+
+  cs_lnum_t     *idx;        /*!< Index on values (size n_cells + 1) */
+  short int     *n_dofs;     /*!< Number of DoFs in each cell */
+  char          *state;      /*!< State of each cell (size n_cells) */
+  cs_real_t     *val;        /*!< Packed operator values */
+
+} cs_hodge_cache_t;
+
+/*============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Check if the local stiffness matrix related to a diffusion property
+ *         can be kept from one time step to another: the equation requests
+ *         it and the property is steady.
+ *
+ *         Properties defined by arrays are not considered since array values
+ *         may be updated in place (e.g. in the groundwater flow module).
+ *
+ * \param[in]  eqp       pointer to a cs_equation_param_t structure
+ * \param[in]  pty       pointer to the diffusion property
+ *
+ * \return true or false
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_hodge_cache_is_allowed(const cs_equation_param_t   *eqp,
+                          const cs_property_t         *pty);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Create a cache of cellwise operators. The number of DoFs in a cell
+ *         is the number of entities related to this cell in the adjacency
+ *         c2x plus n_extra_dofs (e.g. 1 for the cell DoF in CDO-Fb schemes)
+ *
+ * \param[in]  c2x           cell --> entities adjacency
+ * \param[in]  n_extra_dofs  number of additional DoFs in each cell
+ * \param[in]  symmetric     true if the cached operator is symmetric
+ *
+ * \return a pointer to a new allocated cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_hodge_cache_t *
+cs_hodge_cache_create(const cs_adjacency_t   *c2x,
+                      int                     n_extra_dofs,
+                      bool                    symmetric);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Invalidate all the cached operators (for instance if the mesh or
+ *         the property has been modified)
+ *
+ * \param[in, out]  cache     pointer to a cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hodge_cache_reset(cs_hodge_cache_t   *cache);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Free a cs_hodge_cache_t structure
+ *
+ * \param[in, out]  p_cache   double pointer to a cs_hodge_cache_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_hodge_cache_free(cs_hodge_cache_t   **p_cache);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the local operator of the current cell from the cache or
+ *         compute it with the given function and store it in the cache.
+ *         If cache is NULL, this is equivalent to a call to compute.
+ *
+ * \param[in, out] cache     pointer to a cs_hodge_cache_t structure or NULL
+ * \param[in]      compute   function computing the local operator
+ * \param[in]      cm        pointer to a cs_cell_mesh_t structure
+ * \param[in, out] hodge     pointer to a cs_hodge_t structure
+ * \param[in, out] cb        pointer to a cs_cell_builder_t structure
+ * \param[in, out] op        local matrix in which compute stores the operator
+ *                           (cb->loc or hodge->matrix for instance)
+ *
+ * \return true if something has been computed or false otherwise.
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_hodge_cache_compute(cs_hodge_cache_t          *cache,
+                       cs_hodge_compute_t        *compute,
+                       const cs_cell_mesh_t      *cm,
+                       cs_hodge_t                *hodge,
+                       cs_cell_builder_t         *cb,
+                       cs_sdm_t                  *op);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Return the memory size (in bytes) used by a cache
+ *
+ * \param[in]  cache     pointer to a cs_hodge_cache_t structure or NULL
+ *
+ * \return the size in bytes
+ */
+/*----------------------------------------------------------------------------*/
+
+size_t
+cs_hodge_cache_memory_size(const cs_hodge_cache_t   *cache);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_HODGE_CACHE_H__ */
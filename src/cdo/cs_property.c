@@ -155,6 +155,11 @@ _add_new_def(cs_property_t     *pty)
   BFT_REALLOC(pty->get_eval_at_cell_cw, pty->n_definitions,
               cs_xdef_cw_eval_t *);
 
+  /* The cache of cell values (if any) is no more consistent */
+
+  pty->cache_t_eval = -DBL_MAX;
+  BFT_FREE(pty->cache_val);
+
   return new_id;
 }
 
@@ -206,6 +211,138 @@ _get_def_id(cs_lnum_t                c_id,
     return 0;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Check if the evaluation of a property at cell centers can be kept
+ *         from one call to another as long as the time of evaluation does not
+ *         change. This is possible when the evaluation relies on analytic
+ *         functions (possibly with constant values on other zones) which do
+ *         not use an input structure.
+ *         Definitions by array or by field are not cached since their
+ *         evaluation amounts to a copy and their values can be modified in
+ *         place at any time. Subcell properties are evaluated at other points
+ *         than the cell center (cf. \ref cs_property_c2v_values) and are not
+ *         cached either.
+ *
+ * \param[in]  pty       pointer to a cs_property_t structure
+ *
+ * \return true or false
+ */
+/*----------------------------------------------------------------------------*/
+
+static bool
+_cache_is_allowed(const cs_property_t     *pty)
+{
+  if (pty->type & CS_PROPERTY_BY_PRODUCT)
+    return false;
+  if (cs_property_is_subcell(pty))
+    return false;
+
+  bool  has_analytic = false;
+
+  for (int i = 0; i < pty->n_definitions; i++) {
+
+    const cs_xdef_t  *def = pty->defs[i];
+
+    switch (def->type) {
+
+    case CS_XDEF_BY_VALUE:
+      break;
+
+    case CS_XDEF_BY_ANALYTIC_FUNCTION:
+      {
+        const cs_xdef_analytic_context_t  *cx = def->context;
+        if (cx->input != NULL || pty->get_eval_at_cell[i] == NULL)
+          return false;
+        has_analytic = true;
+      }
+      break;
+
+    case CS_XDEF_BY_TIME_FUNCTION:
+      {
+        const cs_xdef_time_func_context_t  *cx = def->context;
+        if (cx->input != NULL || pty->get_eval_at_cell[i] == NULL)
+          return false;
+      }
+      break;
+
+    default:
+      return false;
+
+    }
+
+  } /* Loop on definitions */
+
+  return has_analytic;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the evaluation of a property at the cell center from the
+ *         cache. The cache is only read: its values are refreshed for all the
+ *         cells at once by \ref cs_property_update_cached_values.
+ *
+ * \param[in]  c_id      id of the current cell
+ * \param[in]  t_eval    physical time at which one evaluates the term
+ * \param[in]  pty       pointer to a cs_property_t structure
+ *
+ * \return a pointer to the cached values for the given cell or NULL if there
+ *         is no cache or if the cache is not up to date
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline const cs_real_t *
+_get_cached_eval(cs_lnum_t               c_id,
+                 cs_real_t               t_eval,
+                 const cs_property_t    *pty)
+{
+  if (pty->cache_val == NULL || fabs(pty->cache_t_eval - t_eval) > 0)
+    return NULL;
+
+  return pty->cache_val + cs_property_get_dim(pty)*c_id;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Set a 3x3 tensor from the evaluation of a property at a cell
+ *
+ * \param[in]      type      type of property
+ * \param[in]      eval      values of the evaluation
+ * \param[in, out] tensor    3x3 matrix
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_tensor_from_eval(cs_property_type_t     type,
+                  const cs_real_t        eval[],
+                  cs_real_t              tensor[3][3])
+{
+  if (type & CS_PROPERTY_ISO)
+    tensor[0][0] = tensor[1][1] = tensor[2][2] = eval[0];
+
+  else if (type & CS_PROPERTY_ORTHO) {
+    for (int k = 0; k < 3; k++)
+      tensor[k][k] = eval[k];
+  }
+  else if (type & CS_PROPERTY_ANISO_SYM) {
+
+    tensor[0][0] = eval[0];
+    tensor[1][1] = eval[1];
+    tensor[2][2] = eval[2];
+
+    tensor[0][1] = tensor[1][0] = eval[3];
+    tensor[0][2] = tensor[2][0] = eval[4];
+    tensor[1][2] = tensor[2][1] = eval[5];
+
+  }
+  else {
+    assert(type & CS_PROPERTY_ANISO);
+    for (int k = 0; k < 3; k++)
+      for (int l = 0; l < 3; l++)
+        tensor[k][l] = eval[3*k+l];
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Compute the value of a property at the cell center
@@ -223,6 +360,10 @@ _get_cell_value(cs_lnum_t              c_id,
                 cs_real_t              t_eval,
                 const cs_property_t   *pty)
 {
+  const cs_real_t  *c_eval = _get_cached_eval(c_id, t_eval, pty);
+  if (c_eval != NULL)
+    return c_eval[0];
+
   int  def_id = _get_def_id(c_id, pty);
 
   assert(pty->get_eval_at_cell[def_id] != NULL);
@@ -259,6 +400,10 @@ _value_in_cell(const cs_cell_mesh_t   *cm,
                const cs_property_t    *pty,
                cs_real_t               t_eval)
 {
+  const cs_real_t  *c_eval = _get_cached_eval(cm->c_id, t_eval, pty);
+  if (c_eval != NULL)
+    return c_eval[0];
+
   cs_real_t  result = 0;
   int  def_id = _get_def_id(cm->c_id, pty);
   cs_xdef_t  *def = pty->defs[def_id];
@@ -333,6 +478,12 @@ _get_cell_tensor(cs_lnum_t               c_id,
                  const cs_property_t    *pty,
                  cs_real_t               tensor[3][3])
 {
+  const cs_real_t  *c_eval = _get_cached_eval(c_id, t_eval, pty);
+  if (c_eval != NULL) {
+    _tensor_from_eval(pty->type, c_eval, tensor);
+    return;
+  }
+
   int  def_id = _get_def_id(c_id, pty);
   cs_xdef_t  *def = pty->defs[def_id];
 
@@ -471,6 +622,12 @@ _tensor_in_cell(const cs_cell_mesh_t   *cm,
                 cs_real_t               t_eval,
                 cs_real_t               tensor[3][3])
 {
+  const cs_real_t  *c_eval = _get_cached_eval(cm->c_id, t_eval, pty);
+  if (c_eval != NULL) {
+    _tensor_from_eval(pty->type, c_eval, tensor);
+    return;
+  }
+
   int  def_id = _get_def_id(cm->c_id, pty);
   cs_xdef_t  *def = pty->defs[def_id];
 
@@ -896,6 +1053,9 @@ _create_property(const char           *name,
   pty->b_defs = NULL;
   pty->b_def_ids = NULL;
 
+  pty->cache_t_eval = -DBL_MAX;
+  pty->cache_val = NULL;
+
   return pty;
 }
 
@@ -1143,6 +1303,10 @@ cs_property_set_option(cs_property_t       *pty,
     pty->process_flag |= CS_PROPERTY_POST_FOURIER;
     break;
 
+  case CS_PTYKEY_CACHE_CELL_VALUES:
+    pty->process_flag |= CS_PROPERTY_CACHE_CELL_VALUES;
+    break;
+
   default:
     bft_error(__FILE__, __LINE__, 0,
               _(" Key not implemented for setting a property."));
@@ -1200,6 +1364,7 @@ cs_property_destroy_all(void)
     BFT_FREE(pty->defs);
     BFT_FREE(pty->get_eval_at_cell);
     BFT_FREE(pty->get_eval_at_cell_cw);
+    BFT_FREE(pty->cache_val);
 
     if (pty->n_related_properties > 0)
       BFT_FREE(pty->related_properties);
@@ -1382,6 +1547,31 @@ cs_property_finalize_setup(void)
 
     }
 
+    /* Cache of the evaluation at cell centers (only if requested) */
+
+    if (pty->process_flag & CS_PROPERTY_CACHE_CELL_VALUES) {
+
+      if (_cache_is_allowed(pty)) {
+
+        const cs_lnum_t  n_cells = cs_cdo_quant->n_cells;
+
+        BFT_MALLOC(pty->cache_val, cs_property_get_dim(pty)*n_cells,
+                   cs_real_t);
+        pty->cache_t_eval = -DBL_MAX;
+
+      }
+      else {
+
+        cs_base_warn(__FILE__, __LINE__);
+        cs_log_printf(CS_LOG_DEFAULT,
+                      "\n The property \"%s\" can not be cached. Only"
+                      " analytic definitions without input are handled.\n",
+                      pty->name);
+
+      }
+
+    }
+
   } /* Loop on properties */
 
   for (int i = 0; i < _n_properties; i++) {
@@ -3007,6 +3197,9 @@ cs_property_eval_at_cells(cs_real_t               t_eval,
     if ((pty->type & CS_PROPERTY_ISO) && cs_property_is_constant(pty))
       cs_array_real_set_scalar(n_cells, pty->ref_value, array);
 
+    else if (_get_cached_eval(0, t_eval, pty) != NULL)
+      cs_array_real_copy(cs_property_get_dim(pty)*n_cells, pty->cache_val,
+                         array);
     else {
 
       for (int def_id = 0; def_id < pty->n_definitions; def_id++)
@@ -3021,6 +3214,42 @@ cs_property_eval_at_cells(cs_real_t               t_eval,
   } /* Not defined as the product of two existing properties */
 }
 
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Refresh the cache of the evaluation at cell centers for all the
+ *         properties which have requested one (key
+ *         CS_PTYKEY_CACHE_CELL_VALUES). This function has to be called
+ *         outside any OpenMP parallel section.
+ *
+ * \param[in]  t_eval   physical time at which one evaluates the properties
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_property_update_cached_values(cs_real_t     t_eval)
+{
+  for (int i = 0; i < _n_properties; i++) {
+
+    cs_property_t  *pty = _properties[i];
+
+    if (pty->cache_val == NULL)
+      continue;
+    if (_get_cached_eval(0, t_eval, pty) != NULL)
+      continue; /* Already up to date */
+
+    for (int def_id = 0; def_id < pty->n_definitions; def_id++)
+      cs_property_evaluate_def(pty,
+                               def_id,
+                               false, /* dense output */
+                               t_eval,
+                               pty->cache_val);
+
+    pty->cache_t_eval = t_eval;
+
+  } /* Loop on properties */
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Evaluate the value of the property at each boundary face. Store the
@@ -3724,6 +3953,8 @@ cs_property_log_setup(void)
 
     cs_log_printf(CS_LOG_SETUP, "  * %s | Subcell definition %s\n",
                   pty->name, cs_base_strtf(cs_property_is_subcell(pty)));
+    cs_log_printf(CS_LOG_SETUP, "  * %s | Cache of cell values %s\n",
+                  pty->name, cs_base_strtf(pty->cache_val != NULL));
 
     cs_log_printf(CS_LOG_SETUP, "  * %s | Number of definitions: %d\n\n",
                   pty->name, pty->n_definitions);
@@ -60,6 +60,11 @@ BEGIN_C_DECLS
 
 #define CS_PROPERTY_POST_FOURIER  (1 << 0)
 
+/*!  2: Keep the evaluation at cell centers in a cache which is refreshed once
+ *   per time step (see \ref cs_property_update_cached_values) */
+
+#define CS_PROPERTY_CACHE_CELL_VALUES  (1 << 1)
+
 /*! @} */
 
 /*!
@@ -121,11 +126,18 @@ typedef cs_flag_t cs_property_type_t;
  *
  * \var CS_PTYKEY_POST_FOURIER
  * Perform the computation (and post-processing) of the Fourier number
+ *
+ * \var CS_PTYKEY_CACHE_CELL_VALUES
+ * Keep the evaluation at cell centers from one call to another during a time
+ * step. Only relevant for a property defined by analytic functions (without
+ * input structure) which only depend on the time and on the position, i.e.
+ * which do not read a field or an array modified during the time step.
  */
 
 typedef enum {
 
   CS_PTYKEY_POST_FOURIER,
+  CS_PTYKEY_CACHE_CELL_VALUES,
   CS_PTYKEY_N_KEYS
 
 } cs_property_key_t;
@@ -199,6 +211,15 @@ struct _cs_property_t {
 
   short int              *b_def_ids;
 
+  /* Optional: Cache of the evaluation at cell centers. It is only allocated
+     if requested with the key CS_PTYKEY_CACHE_CELL_VALUES. The cached values
+     are refreshed for all cells at once outside any parallel section (see
+     cs_property_update_cached_values) and are only read afterwards. They are
+     used when the time of evaluation is equal to the time stamp. */
+
+  cs_real_t               cache_t_eval;  /* Time stamp of the cached values */
+  cs_real_t              *cache_val;     /* Cached values (size dim*n_cells) */
+
 };
 
 
@@ -1072,6 +1093,20 @@ cs_property_eval_at_cells(cs_real_t               t_eval,
                           const cs_property_t    *pty,
                           cs_real_t              *array);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Refresh the cache of the evaluation at cell centers for all the
+ *         properties which have requested one (key
+ *         CS_PTYKEY_CACHE_CELL_VALUES). This function has to be called
+ *         outside any OpenMP parallel section.
+ *
+ * \param[in]  t_eval   physical time at which one evaluates the properties
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_property_update_cached_values(cs_real_t     t_eval);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Evaluate the value of the property at each boundary face. Store the
@@ -1851,6 +1851,87 @@ cs_quadrature_get_tetra_integral(int                   dim,
   return NULL;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the function computing the quadrature points and weights
+ *         in a triangle according to the quadrature type. This is the rule
+ *         used by the function returned by \ref cs_quadrature_get_tria_integral
+ *
+ * \param[in]  qtype     quadrature type
+ * \param[out] n_pts     number of quadrature points in a triangle
+ *
+ * \return a pointer to the function computing the quadrature points
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline cs_quadrature_tria_t *
+cs_quadrature_get_tria_rule(cs_quadrature_type_t   qtype,
+                            int                   *n_pts)
+{
+  switch (qtype) {
+
+  case CS_QUADRATURE_BARY:
+  case CS_QUADRATURE_BARY_SUBDIV:
+    *n_pts = 1;
+    return cs_quadrature_tria_1pt;
+  case CS_QUADRATURE_HIGHER:
+    *n_pts = 4;
+    return cs_quadrature_tria_4pts;
+  case CS_QUADRATURE_HIGHEST:
+    *n_pts = 7;
+    return cs_quadrature_tria_7pts;
+
+  default:
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Invalid quadrature type\n", __func__);
+  }
+
+  /* Avoid no return warning */
+  *n_pts = 0;
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Retrieve the function computing the quadrature points and weights
+ *         in a tetrahedron according to the quadrature type. This is the rule
+ *         used by the function returned by
+ *         \ref cs_quadrature_get_tetra_integral
+ *
+ * \param[in]  qtype     quadrature type
+ * \param[out] n_pts     number of quadrature points in a tetrahedron
+ *
+ * \return a pointer to the function computing the quadrature points
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline cs_quadrature_tet_t *
+cs_quadrature_get_tetra_rule(cs_quadrature_type_t   qtype,
+                             int                   *n_pts)
+{
+  switch (qtype) {
+
+  case CS_QUADRATURE_BARY:
+  case CS_QUADRATURE_BARY_SUBDIV:
+    *n_pts = 1;
+    return cs_quadrature_tet_1pt;
+  case CS_QUADRATURE_HIGHER:
+    *n_pts = 4;
+    return cs_quadrature_tet_4pts;
+  case CS_QUADRATURE_HIGHEST:
+    *n_pts = 5;
+    return cs_quadrature_tet_5pts;
+
+  default:
+    bft_error(__FILE__, __LINE__, 0,
+              " %s: Invalid quadrature type\n", __func__);
+  }
+
+  /* Avoid no return warning */
+  *n_pts = 0;
+  return NULL;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Get the flags adapted to the given quadrature type \p qtype and the
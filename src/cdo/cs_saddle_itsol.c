@@ -1254,6 +1254,7 @@ _set_pc(const cs_saddle_system_t          *ssys,
       case CS_PARAM_SCHUR_MASS_SCALED:
       case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
       case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+      case CS_PARAM_SCHUR_SPAI_INVERSE:
         return _diag_schur_pc_apply;
 
       default:
@@ -1272,6 +1273,7 @@ _set_pc(const cs_saddle_system_t          *ssys,
       case CS_PARAM_SCHUR_MASS_SCALED:
       case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
       case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+      case CS_PARAM_SCHUR_SPAI_INVERSE:
         *wsp_size = ssys->max_x2_size;
         BFT_MALLOC(*p_wsp, *wsp_size, cs_real_t);
         return _lower_schur_pc_apply;
@@ -1292,6 +1294,7 @@ _set_pc(const cs_saddle_system_t          *ssys,
       case CS_PARAM_SCHUR_MASS_SCALED:
       case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
       case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+      case CS_PARAM_SCHUR_SPAI_INVERSE:
         *wsp_size = 2*ssys->max_x1_size;
         BFT_MALLOC(*p_wsp, *wsp_size, cs_real_t);
         return _sgs_schur_pc_apply;
@@ -1312,6 +1315,7 @@ _set_pc(const cs_saddle_system_t          *ssys,
       case CS_PARAM_SCHUR_MASS_SCALED:
       case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
       case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+      case CS_PARAM_SCHUR_SPAI_INVERSE:
         *wsp_size = ssys->max_x1_size;
         BFT_MALLOC(*p_wsp, *wsp_size, cs_real_t);
         return  _upper_schur_pc_apply;
@@ -1332,6 +1336,7 @@ _set_pc(const cs_saddle_system_t          *ssys,
       case CS_PARAM_SCHUR_MASS_SCALED:
       case CS_PARAM_SCHUR_MASS_SCALED_DIAG_INVERSE:
       case CS_PARAM_SCHUR_MASS_SCALED_LUMPED_INVERSE:
+      case CS_PARAM_SCHUR_SPAI_INVERSE:
         *wsp_size = 2*(ssys->max_x1_size + ssys->max_x2_size);
         BFT_MALLOC(*p_wsp, *wsp_size, cs_real_t);
         return  _uza_schur_pc_apply;
@@ -116,6 +116,258 @@ _create_sdm(cs_flag_t   flag,
   return mat;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Compute the row-row product c += a.b^T when a and b have n_k
+ *         columns. When called with a constant n_k, the inner loop is fully
+ *         unrolled by the compiler.
+ *
+ * \param[in]      n_k    number of columns of a and b
+ * \param[in]      a      first local matrix
+ * \param[in]      b      second local matrix
+ * \param[in, out] c      result of the local matrix-product (updated)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_multiply_rowrow_k(const int          n_k,
+                   const cs_sdm_t    *a,
+                   const cs_sdm_t    *b,
+                   cs_sdm_t          *c)
+{
+  for (short int i = 0; i < a->n_rows; i++) {
+
+    const cs_real_t  *av_i = a->val + i*n_k;
+
+    cs_real_t  *cv_i = c->val + i*b->n_rows;
+
+    for (short int j = 0; j < b->n_rows; j++) {
+
+      const cs_real_t  *bv_j = b->val + j*n_k;
+
+      cs_real_t  dp = 0;
+      for (short int k = 0; k < n_k; k++)
+        dp += av_i[k] * bv_j[k];
+      cv_i[j] += dp;
+
+    } /* Loop on b rows */
+  } /* Loop on a rows */
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Compute the matrix-vector product mv = m.v for a square matrix of
+ *         size n. When called with a constant n, loops are fully unrolled by
+ *         the compiler.
+ *
+ * \param[in]      n      size of the square matrix
+ * \param[in]      m      values of the local matrix (row-major)
+ * \param[in]      v      local vector to use
+ * \param[out]     mv     result of the local matrix-vector product
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_square_matvec_n(const int           n,
+                 const cs_real_t    *m,
+                 const cs_real_t    *v,
+                 cs_real_t          *mv)
+{
+  /* Initialize mv */
+
+  const cs_real_t  v0 = v[0];
+  for (short int i = 0; i < n; i++)
+    mv[i] = v0*m[i*n];
+
+  /* Increment mv */
+
+  for (short int i = 0; i < n; i++) {
+    const cs_real_t *m_i = m + i*n;
+    for (short int j = 1; j < n; j++)
+      mv[i] += m_i[j] * v[j];
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  LDL^T factorization of a SPD matrix of size n (n > 1). When
+ *         called with a constant n, loops are unrolled by the compiler.
+ *         See \ref cs_sdm_ldlt_compute for more details.
+ *
+ * \param[in]      n      size of the square matrix
+ * \param[in]      m      values of the local matrix (row-major)
+ * \param[out]     facto  coefficients of the decomposition
+ * \param[out]     dkk    diagonal of the decomposition (temporary storage)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_ldlt_compute_n(const int           n,
+                const cs_real_t    *m,
+                cs_real_t          *facto,
+                cs_real_t          *dkk)
+{
+  int  rowj_idx = 0;
+
+  /* Factorization (column-major algorithm) */
+
+  for (short int j = 0; j < n; j++) {
+
+    rowj_idx += j;
+    const int  djj_idx = rowj_idx + j;
+
+    switch (j) {
+
+    case 0:  /* Optimization for the first colum */
+      {
+        dkk[0] = m[0]; /* d00 */
+
+        if (fabs(dkk[0]) < cs_math_zero_threshold)
+          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
+        const cs_real_t  inv_d00 = facto[0] = 1. / dkk[0];
+
+        /* l_i0 = a_i0 / d_00 */
+        short int rowi_idx = rowj_idx;
+        const cs_real_t  *a_0 = m;  /* a_ij = a_ji */
+        for (short int i = j+1; i < n; i++) { /* Loop on rows */
+
+          rowi_idx += i;
+          cs_real_t  *l_i = facto + rowi_idx;
+          l_i[0] = a_0[i] * inv_d00;
+
+        }
+
+      }
+      break;
+
+    case 1:  /* Optimization for the second colum */
+      {
+        /* d_11 = a_11 - l_10^2 * d_00 */
+        cs_real_t  *l_1 = facto + rowj_idx;
+
+        const cs_real_t  d11 = dkk[1] = m[n+1] - l_1[0]*l_1[0]*dkk[0];
+        if (fabs(d11) < cs_math_zero_threshold)
+          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
+
+        const cs_real_t  inv_d11 = facto[djj_idx] = 1. / d11;
+
+        /* l_i1 = (a_i1 - l_i0 * d_00 * l_10 ) / d_11 */
+
+        short int rowi_idx = rowj_idx;
+        const cs_real_t  *a_1 = m + n;  /* a_i1 = a_1i */
+        for (short int i = 2; i < n; i++) { /* Loop on rows */
+
+          rowi_idx += i;
+          cs_real_t  *l_i = facto + rowi_idx;
+          l_i[1] = (a_1[i] - l_i[0] *  dkk[0] * l_1[0]) * inv_d11;
+
+        }
+
+      }
+      break;
+
+    default:
+      {
+        /* d_jj = a_jj - \sum_{k=0}^{j-1} l_jk^2 * d_kk */
+
+        cs_real_t  *l_j = facto + rowj_idx;
+
+        cs_real_t  sum = 0.;
+        for (short int k = 0; k < j; k++)
+          sum += l_j[k]*l_j[k] * dkk[k];
+        const cs_real_t  djj = dkk[j] = m[j*n+j] - sum;
+
+        if (fabs(djj) < cs_math_zero_threshold)
+          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
+
+        const cs_real_t  inv_djj = facto[djj_idx] = 1. / djj;
+
+        /* l_ij = (a_ij - \sum_{k=1}^{j-1} l_ik * d_kk * l_jk ) / d_jj */
+
+        short int rowi_idx = rowj_idx;
+        const cs_real_t  *a_j = m + j*n;  /* a_ij = a_ji */
+        for (short int i = j+1; i < n; i++) { /* Loop on rows */
+
+          rowi_idx += i;
+          cs_real_t  *l_i = facto + rowi_idx;
+          sum = 0.;
+          for (short int k = 0; k < j; k++)
+            sum += l_i[k] *  dkk[k] * l_j[k];
+          l_i[j] = (a_j[i] - sum) * inv_djj;
+
+        }
+      }
+      break;
+    } /* End of switch */
+
+  } /* Loop on column j */
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Solve a SPD system of size n (n > 1) with a L.D.L^T decomposition.
+ *         When called with a constant n, loops are unrolled by the compiler.
+ *         See \ref cs_sdm_ldlt_solve for more details.
+ *
+ * \param[in]      n      size of the system
+ * \param[in]      facto  coefficients of the decomposition
+ * \param[in]      rhs    right-hand side
+ * \param[out]     sol    solution
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_ldlt_solve_n(const int           n,
+              const cs_real_t    *facto,
+              const cs_real_t    *rhs,
+              cs_real_t          *sol)
+{
+  /* 1 - Solving Lz = b with forward substitution :
+   *     z_i = b_i - \sum_{k=0}^{i-1} l_ik * z_k
+   */
+
+  sol[0] = rhs[0]; /* case i = 0 */
+
+  short int rowi_idx = 0;
+  for (short int i = 1; i < n; i++){
+
+    rowi_idx += i;
+
+    const cs_real_t  *l_i = facto + rowi_idx;
+    cs_real_t  sum = 0.;
+    for (short int k = 0; k < i; k++)
+      sum += sol[k] * l_i[k];
+    sol[i] = rhs[i] - sum;
+
+  } /* forward substitution */
+
+  /* 2 - Solving Dy = z and facto^Tx=y with backwards substitution
+   *     x_i = z_i/d_ii - \sum_{k=i+1}^{n} l_ki * x_k
+   */
+
+  const short int  last_row_id = n - 1;
+  const int  shift = n*(last_row_id)/2;        /* idx with n - 1 */
+  int  diagi_idx = shift + last_row_id;        /* last entry of the facto. */
+  sol[last_row_id] *= facto[diagi_idx];        /* 1 / d_nn */
+
+  for (short int i = last_row_id - 1; i >= 0; i--) {
+
+    diagi_idx -= (i+2);
+    sol[i] *= facto[diagi_idx];
+
+    short int  rowk_idx = shift;
+    cs_real_t  sum = 0.0;
+    for (short int k = last_row_id; k > i; k--) {
+      /*sol[i] -= facto[k*(k+1)/2+i] * sol[k];*/
+      const cs_real_t  *l_k = facto + rowk_idx;
+      sum += l_k[i] * sol[k];
+      rowk_idx -= k;
+    }
+    sol[i] -= sum;
+
+  } /* backward substitution */
+}
+
 /*============================================================================
  * Public function prototypes
  *============================================================================*/
@@ -630,23 +882,31 @@ cs_sdm_multiply_rowrow(const cs_sdm_t   *a,
          a->n_rows == c->n_rows &&
          c->n_cols == b->n_rows);
 
-  for (short int i = 0; i < a->n_rows; i++) {
-
-    const cs_real_t  *av_i = a->val + i*a->n_cols;
+  /* Specialized versions for the most common sizes (unrolled inner loop) */
+
+  switch (a->n_cols) {
+
+  case 3:
+    _multiply_rowrow_k(3, a, b, c);
+    break;
+  case 4:
+    _multiply_rowrow_k(4, a, b, c);
+    break;
+  case 6:
+    _multiply_rowrow_k(6, a, b, c);
+    break;
+  case 8:
+    _multiply_rowrow_k(8, a, b, c);
+    break;
+  case 12:
+    _multiply_rowrow_k(12, a, b, c);
+    break;
+
+  default:
+    _multiply_rowrow_k(a->n_cols, a, b, c);
+    break;
 
-    cs_real_t  *cv_i = c->val + i*b->n_rows;
-
-    for (short int j = 0; j < b->n_rows; j++) {
-
-      const cs_real_t  *bv_j = b->val + j * b->n_cols;
-
-      cs_real_t  dp = 0;
-      for (short int k = 0; k < a->n_cols; k++)
-        dp += av_i[k] * bv_j[k];
-      cv_i[j] += dp;
-
-    } /* Loop on b rows */
-  } /* Loop on a rows */
+  }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -827,20 +1087,33 @@ cs_sdm_square_matvec(const cs_sdm_t    *mat,
   assert(mat != NULL && vec != NULL && mv != NULL);
   assert(mat->n_rows == mat->n_cols);
 
-  const int  n = mat->n_rows;
-
-  /* Initialize mv */
-
-  const cs_real_t  v = vec[0];
-  for (short int i = 0; i < n; i++)
-    mv[i] = v*mat->val[i*n];
+  /* Specialized versions for the most common sizes (unrolled loops) */
+
+  switch (mat->n_rows) {
+
+  case 4:
+    _square_matvec_n(4, mat->val, vec, mv);
+    break;
+  case 5:
+    _square_matvec_n(5, mat->val, vec, mv);
+    break;
+  case 6:
+    _square_matvec_n(6, mat->val, vec, mv);
+    break;
+  case 7:
+    _square_matvec_n(7, mat->val, vec, mv);
+    break;
+  case 8:
+    _square_matvec_n(8, mat->val, vec, mv);
+    break;
+  case 12:
+    _square_matvec_n(12, mat->val, vec, mv);
+    break;
+
+  default:
+    _square_matvec_n(mat->n_rows, mat->val, vec, mv);
+    break;
 
-  /* Increment mv */
-
-  for (short int i = 0; i < n; i++) {
-    const cs_real_t *m_i = mat->val + i*n;
-    for (short int j = 1; j < n; j++)
-      mv[i] += m_i[j] * vec[j];
   }
 }
 
@@ -1698,9 +1971,9 @@ cs_sdm_66_ldlt_compute(const cs_sdm_t   *m,
   const cs_real_t  l32 = facto[ 8] =
     (m->val[15] - l30*d0l20 - l31*d1l21) * facto[5];
   const cs_real_t  l42 = facto[12] =
-    (m->val[16] - l30*d0l20 - l31*d1l21) * facto[5];
+    (m->val[16] - l40*d0l20 - l41*d1l21) * facto[5];
   const cs_real_t  l52 = facto[17] =
-    (m->val[17] - l30*d0l20 - l31*d1l21) * facto[5];
+    (m->val[17] - l50*d0l20 - l51*d1l21) * facto[5];
 
   /* j=3: row 4 */
 
@@ -1760,105 +2033,31 @@ cs_sdm_ldlt_compute(const cs_sdm_t     *m,
 
   const short int n = m->n_cols;
 
-  if (n == 1) {
-    facto[0] = 1. / m->val[0];
-    return;
-  }
-
-  int  rowj_idx = 0;
-
-  /* Factorization (column-major algorithm) */
-
-  for (short int j = 0; j < n; j++) {
-
-    rowj_idx += j;
-    const int  djj_idx = rowj_idx + j;
-
-    switch (j) {
-
-    case 0:  /* Optimization for the first colum */
-      {
-        dkk[0] = m->val[0]; /* d00 */
-
-        if (fabs(dkk[0]) < cs_math_zero_threshold)
-          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
-        const cs_real_t  inv_d00 = facto[0] = 1. / dkk[0];
-
-        /* l_i0 = a_i0 / d_00 */
-        short int rowi_idx = rowj_idx;
-        const cs_real_t  *a_0 = m->val;  /* a_ij = a_ji */
-        for (short int i = j+1; i < n; i++) { /* Loop on rows */
-
-          rowi_idx += i;
-          cs_real_t  *l_i = facto + rowi_idx;
-          l_i[0] = a_0[i] * inv_d00;
-
-        }
-
-      }
-      break;
-
-    case 1:  /* Optimization for the second colum */
-      {
-        /* d_11 = a_11 - l_10^2 * d_00 */
-        cs_real_t  *l_1 = facto + rowj_idx;
-
-        const cs_real_t  d11 = dkk[1] = m->val[n+1] - l_1[0]*l_1[0]*dkk[0];
-        if (fabs(d11) < cs_math_zero_threshold)
-          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
-
-        const cs_real_t  inv_d11 = facto[djj_idx] = 1. / d11;
-
-        /* l_i1 = (a_i1 - l_i0 * d_00 * l_10 ) / d_11 */
-
-        short int rowi_idx = rowj_idx;
-        const cs_real_t  *a_1 = m->val + n;  /* a_i1 = a_1i */
-        for (short int i = 2; i < n; i++) { /* Loop on rows */
-
-          rowi_idx += i;
-          cs_real_t  *l_i = facto + rowi_idx;
-          l_i[1] = (a_1[i] - l_i[0] *  dkk[0] * l_1[0]) * inv_d11;
-
-        }
-
-      }
-      break;
-
-    default:
-      {
-        /* d_jj = a_jj - \sum_{k=0}^{j-1} l_jk^2 * d_kk */
-
-        cs_real_t  *l_j = facto + rowj_idx;
+  /* Specialized versions for the most common sizes (unrolled loops) */
 
-        cs_real_t  sum = 0.;
-        for (short int k = 0; k < j; k++)
-          sum += l_j[k]*l_j[k] * dkk[k];
-        const cs_real_t  djj = dkk[j] = m->val[j*n+j] - sum;
+  switch (n) {
 
-        if (fabs(djj) < cs_math_zero_threshold)
-          bft_error(__FILE__, __LINE__, 0, _msg_small_p, __func__);
-
-        const cs_real_t  inv_djj = facto[djj_idx] = 1. / djj;
-
-        /* l_ij = (a_ij - \sum_{k=1}^{j-1} l_ik * d_kk * l_jk ) / d_jj */
-
-        short int rowi_idx = rowj_idx;
-        const cs_real_t  *a_j = m->val + j*n;  /* a_ij = a_ji */
-        for (short int i = j+1; i < n; i++) { /* Loop on rows */
-
-          rowi_idx += i;
-          cs_real_t  *l_i = facto + rowi_idx;
-          sum = 0.;
-          for (short int k = 0; k < j; k++)
-            sum += l_i[k] *  dkk[k] * l_j[k];
-          l_i[j] = (a_j[i] - sum) * inv_djj;
-
-        }
-      }
-      break;
-    } /* End of switch */
+  case 1:
+    facto[0] = 1. / m->val[0];
+    break;
+  case 4:
+    _ldlt_compute_n(4, m->val, facto, dkk);
+    break;
+  case 6:
+    _ldlt_compute_n(6, m->val, facto, dkk);
+    break;
+  case 8:
+    _ldlt_compute_n(8, m->val, facto, dkk);
+    break;
+  case 12:
+    _ldlt_compute_n(12, m->val, facto, dkk);
+    break;
+
+  default:
+    _ldlt_compute_n(n, m->val, facto, dkk);
+    break;
 
-  } /* Loop on column j */
+  }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1974,55 +2173,31 @@ cs_sdm_ldlt_solve(int                n_rows,
 {
   assert(facto != NULL && rhs != NULL && sol != NULL);
 
-  if (n_rows == 1) {
-    sol[0] = rhs[0] * facto[0];
-    return;
-  }
-
-  /* 1 - Solving Lz = b with forward substitution :
-   *     z_i = b_i - \sum_{k=0}^{i-1} l_ik * z_k
-   */
-
-  sol[0] = rhs[0]; /* case i = 0 */
-
-  short int rowi_idx = 0;
-  for (short int i = 1; i < n_rows; i++){
-
-    rowi_idx += i;
+  /* Specialized versions for the most common sizes (unrolled loops) */
 
-    const cs_real_t  *l_i = facto + rowi_idx;
-    cs_real_t  sum = 0.;
-    for (short int k = 0; k < i; k++)
-      sum += sol[k] * l_i[k];
-    sol[i] = rhs[i] - sum;
+  switch (n_rows) {
 
-  } /* forward substitution */
-
-  /* 2 - Solving Dy = z and facto^Tx=y with backwards substitution
-   *     x_i = z_i/d_ii - \sum_{k=i+1}^{n} l_ki * x_k
-   */
-
-  const short int  last_row_id = n_rows - 1;
-  const int  shift = n_rows*(last_row_id)/2;   /* idx with n_rows - 1 */
-  int  diagi_idx = shift + last_row_id;        /* last entry of the facto. */
-  sol[last_row_id] *= facto[diagi_idx];        /* 1 / d_nn */
-
-  for (short int i = last_row_id - 1; i >= 0; i--) {
-
-    diagi_idx -= (i+2);
-    sol[i] *= facto[diagi_idx];
-
-    short int  rowk_idx = shift;
-    cs_real_t  sum = 0.0;
-    for (short int k = last_row_id; k > i; k--) {
-      /*sol[i] -= facto[k*(k+1)/2+i] * sol[k];*/
-      const cs_real_t  *l_k = facto + rowk_idx;
-      sum += l_k[i] * sol[k];
-      rowk_idx -= k;
-    }
-    sol[i] -= sum;
+  case 1:
+    sol[0] = rhs[0] * facto[0];
+    break;
+  case 4:
+    _ldlt_solve_n(4, facto, rhs, sol);
+    break;
+  case 6:
+    _ldlt_solve_n(6, facto, rhs, sol);
+    break;
+  case 8:
+    _ldlt_solve_n(8, facto, rhs, sol);
+    break;
+  case 12:
+    _ldlt_solve_n(12, facto, rhs, sol);
+    break;
+
+  default:
+    _ldlt_solve_n(n_rows, facto, rhs, sol);
+    break;
 
-  } /* backward substitution */
+  }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -48,6 +48,7 @@
 #include "cs_math.h"
 #include "cs_scheme_geometry.h"
 #include "cs_volume_zone.h"
+#include "cs_xdef_cw_eval.h"
 
 /*----------------------------------------------------------------------------
  * Header for the current file
@@ -2459,88 +2460,14 @@ cs_source_term_fcb_pcsd_by_analytic(const cs_xdef_t           *source,
 
   else {
 
-    const cs_real_t *xv = cm->xv;
-
-    double  cell_values  = 0.0;
-
-    cs_quadrature_tetra_integral_t  *qfunc =
-      cs_quadrature_get_tetra_integral(1, source->qtype);
+    double  cell_values = 0.0;
 
     cs_xdef_analytic_context_t *ac =
       (cs_xdef_analytic_context_t *)source->context;
 
-    /* Switch according to the cell type: optimised version for tetra */
-
-    switch (cm->type) {
-
-    case FVM_CELL_TETRA:
-      {
-        assert(cm->n_fc == 4 && cm->n_vc == 4);
-        qfunc(time_eval, xv, xv+3, xv+6, xv+9, cm->vol_c, ac->func, ac->input,
-              &cell_values);
-      }
-      break;
-
-    case FVM_CELL_PYRAM:
-    case FVM_CELL_PRISM:
-    case FVM_CELL_HEXA:
-    case FVM_CELL_POLY:
-    {
-      for (short int f = 0; f < cm->n_fc; f++) {
-
-        const cs_quant_t  pfq = cm->face[f];
-        const double  hf_coef = cs_math_1ov3 * cm->hfc[f];
-        const int  start = cm->f2e_idx[f];
-        const int  end = cm->f2e_idx[f+1];
-        const short int  n_vf = end - start;  /* #vertices (=#edges) */
-        const short int  *f2e_ids = cm->f2e_ids + start;
-
-        assert(n_vf > 2);
-        switch(n_vf){
-
-        case 3: /* triangle (optimized version, no subdivision) */
-          {
-            short int  v0, v1, v2;
-            cs_cell_mesh_get_next_3_vertices(f2e_ids, cm->e2v_ids,
-                                             &v0, &v1, &v2);
-
-            qfunc(time_eval, cm->xc, xv+3*v0, xv+3*v1, xv+3*v2,
-                  hf_coef*pfq.meas,
-                  ac->func, ac->input,
-                  &cell_values);
-          }
-          break;
-
-        default:
-          {
-            const double  *tef = cm->tef + start;
-
-            for (short int e = 0; e < n_vf; e++) { /* Loop on face edges */
-
-              /* Edge-related variables */
-
-              const short int e0  = f2e_ids[e];
-              const double  *xv0 = xv + 3*cm->e2v_ids[2*e0];
-              const double  *xv1 = xv + 3*cm->e2v_ids[2*e0+1];
-
-              qfunc(time_eval, cm->xc, pfq.center, xv0, xv1,
-                    hf_coef*tef[e], ac->func, ac->input, &cell_values);
-
-            }
-          }
-          break;
-
-        } /* End of switch */
-
-      } /* End of loop on faces */
-    }
-    break;
-
-    default:
-      bft_error(__FILE__, __LINE__, 0, "%s: Unknown cell-type.\n", __func__);
-      break;
-
-    } /* End of switch on the cell-type */
+    cs_xdef_cw_eval_c_int_by_analytic_batch(cm, time_eval,
+                                            ac->func, ac->input,
+                                            1, source->qtype, &cell_values);
 
     values[cm->n_fc] += cell_values;
 
@@ -2680,91 +2607,14 @@ cs_source_term_fb_pcvd_by_analytic(const cs_xdef_t           *source,
 
   else {
 
-    const cs_real_t *xv = cm->xv;
-
     cs_real_3_t  cell_values = {0.0, 0.0, 0.0};
 
-    cs_quadrature_tetra_integral_t  *qfunc =
-      cs_quadrature_get_tetra_integral(3, source->qtype);
-
     cs_xdef_analytic_context_t  *ac =
       (cs_xdef_analytic_context_t *)source->context;
 
-    /* Switch according to the cell type: optimized version for tetra */
-
-    switch (cm->type) {
-
-    case FVM_CELL_TETRA:
-      {
-        assert(cm->n_fc == 4 && cm->n_vc == 4);
-        qfunc(time_eval, xv, xv+3, xv+6, xv+9, cm->vol_c,
-              ac->func, ac->input,
-              cell_values);
-      }
-      break;
-
-    case FVM_CELL_PYRAM:
-    case FVM_CELL_PRISM:
-    case FVM_CELL_HEXA:
-    case FVM_CELL_POLY:
-    {
-      for (short int f = 0; f < cm->n_fc; f++) {
-
-        const cs_quant_t  pfq = cm->face[f];
-        const double  hf_coef = cs_math_1ov3 * cm->hfc[f];
-        const int  start = cm->f2e_idx[f];
-        const int  end = cm->f2e_idx[f+1];
-        const short int  n_vf = end - start; // #vertices (=#edges)
-        const short int  *f2e_ids = cm->f2e_ids + start;
-
-        assert(n_vf > 2);
-        switch(n_vf){
-
-        case 3: /* triangle (optimized version, no subdivision) */
-          {
-            short int  v0, v1, v2;
-            cs_cell_mesh_get_next_3_vertices(f2e_ids, cm->e2v_ids,
-                                             &v0, &v1, &v2);
-
-            qfunc(time_eval, cm->xc, xv+3*v0, xv+3*v1, xv+3*v2,
-                  hf_coef*pfq.meas,
-                  ac->func, ac->input,
-                  cell_values);
-          }
-          break;
-
-        default:
-          {
-            const double  *tef = cm->tef + start;
-
-            for (short int e = 0; e < n_vf; e++) { /* Loop on face edges */
-
-              /* Edge-related variables */
-
-              const short int e0  = f2e_ids[e];
-              const double  *xv0 = xv + 3*cm->e2v_ids[2*e0];
-              const double  *xv1 = xv + 3*cm->e2v_ids[2*e0+1];
-
-              qfunc(time_eval, cm->xc, pfq.center, xv0, xv1,
-                    hf_coef*tef[e],
-                    ac->func, ac->input,
-                    cell_values);
-            }
-          }
-          break;
-
-        } /* End of switch */
-
-      } /* End of loop on faces */
-
-    }
-    break;
-
-    default:
-      bft_error(__FILE__, __LINE__, 0, "%s: Unknown cell-type.\n", __func__);
-      break;
-
-    } /* End of switch on the cell-type */
+    cs_xdef_cw_eval_c_int_by_analytic_batch(cm, time_eval,
+                                            ac->func, ac->input,
+                                            3, source->qtype, cell_values);
 
     cs_real_t *c_val = values + 3*cm->n_fc;
     c_val[0] += cell_values[0];
@@ -59,6 +59,12 @@ BEGIN_C_DECLS
 
 #define CS_STATIC_CONDENSATION_DBG  0
 
+/* Max. number of DoFs kept in a cell system condensed by batch. Larger
+   systems (polyhedra) are condensed lane by lane. */
+
+#define CS_STATIC_CONDENSATION_BATCH_MAX_XC  6
+#define _BATCH_MAX_DOFS  (CS_STATIC_CONDENSATION_BATCH_MAX_XC + 1)
+
 /*============================================================================
  * Local private variables
  *============================================================================*/
@@ -69,6 +75,105 @@ BEGIN_C_DECLS
  * Private function prototypes
  *============================================================================*/
 
+/*----------------------------------------------------------------------------
+ * Condensate the local matrix Axx --> Axx - Axc.Acc^-1.Acx and update the
+ * RHS_x --> RHS_x - Axc.Acc^-1.RHS_c. The condensed matrix of size n_xc is
+ * stored in place (row-major) in the local matrix of size n_xc + 1.
+ * When called with a constant n_xc, loops are unrolled by the compiler.
+ *
+ * parameters:
+ *   n_xc   <-- number of DoFs which are kept
+ *   acx    <-- Acc^-1.Acx (size n_xc)
+ *   axc    <-- Axc (size n_xc)
+ *   rc     <-- Acc^-1.RHS_c
+ *   mval   <-> values of the local matrix
+ *   rhs    <-> values of the local right-hand side
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_condense_scalar_n(const int           n_xc,
+                   const double       *acx,
+                   const double       *axc,
+                   const double        rc,
+                   double             *mval,
+                   double             *rhs)
+{
+  const int  n_dofs = n_xc + 1;
+
+  for (short int i = 0; i < n_xc; i++) {
+
+    double  *old_i = mval + n_dofs*i; /* Old "i" row  */
+    double  *new_i = mval + n_xc*i;   /* New "i" row */
+
+    /* Condensate the local matrix Axx:
+       Axx --> Axx - Axc.Acc^-1.Acx */
+
+    for (short int j = 0; j < n_xc; j++)
+      new_i[j] = old_i[j] - axc[i]*acx[j];
+
+    /* Update RHS_x: RHS_x = RHS_x - Axc*Acc^-1*RHS_c */
+
+    rhs[i] -= rc * axc[i];
+
+  } /* Loop on vi cell entities */
+}
+
+/*----------------------------------------------------------------------------
+ * Condensate a batch of local matrices with the same size. Values are
+ * interlaced by lane (the lane id is the fastest index) so that each
+ * operation is performed for all lanes at once.
+ *
+ * parameters:
+ *   n_xc    <-- number of DoFs which are kept
+ *   n_lanes <-- number of lanes (cells) in the batch
+ *   acx     <-- Acc^-1.Acx (size n_xc*CS_CDO_CELL_BATCH_SIZE)
+ *   axc     <-- Axc (size n_xc*CS_CDO_CELL_BATCH_SIZE)
+ *   rc      <-- Acc^-1.RHS_c (size CS_CDO_CELL_BATCH_SIZE)
+ *   mval    <-- values of the local matrices of size n_xc + 1
+ *   cval    --> values of the condensed matrices of size n_xc
+ *   rhs     <-> values of the local right-hand sides
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_condense_scalar_batch(const int           n_xc,
+                       const int           n_lanes,
+                       const double       *acx,
+                       const double       *axc,
+                       const double       *rc,
+                       const double       *mval,
+                       double             *cval,
+                       double             *rhs)
+{
+  const int  n_dofs = n_xc + 1;
+  const int  nb = CS_CDO_CELL_BATCH_SIZE;
+
+  for (short int i = 0; i < n_xc; i++) {
+
+    const double  *old_i = mval + nb*n_dofs*i;
+    const double  *axc_i = axc + nb*i;
+    double  *new_i = cval + nb*n_xc*i;
+
+    for (short int j = 0; j < n_xc; j++) {
+
+      const double  *acx_j = acx + nb*j;
+
+#     if defined(HAVE_OPENMP_SIMD)
+#       pragma omp simd
+#     endif
+      for (int l = 0; l < n_lanes; l++)
+        new_i[nb*j + l] = old_i[nb*j + l] - axc_i[l]*acx_j[l];
+
+    }
+
+#   if defined(HAVE_OPENMP_SIMD)
+#     pragma omp simd
+#   endif
+    for (int l = 0; l < n_lanes; l++)
+      rhs[nb*i + l] -= rc[l] * axc_i[l];
+
+  } /* Loop on vi cell entities */
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -124,22 +229,123 @@ cs_static_condensation_scalar_eq(const cs_adjacency_t    *c2x,
   csys->n_dofs = n_xc;
   csys->mat->n_rows = csys->mat->n_cols = n_xc;
 
-  for (short int i = 0; i < n_xc; i++) {
+  /* Specialized versions for the most common number of faces (tetrahedra,
+     pyramids, prisms and hexahedra) */
 
-    double  *old_i = csys->mat->val + n_dofs*i; /* Old "i" row  */
-    double  *new_i = csys->mat->val + n_xc*i;   /* New "i" row */
+  const double  rc = rc_tilda[csys->c_id];
 
-    /* Condensate the local matrix Axx:
-       Axx --> Axx - Axc.Acc^-1.Acx */
+  switch (n_xc) {
 
-    for (short int j = 0; j < n_xc; j++)
-      new_i[j] = old_i[j] - axc[i]*acx[j];
+  case 4:
+    _condense_scalar_n(4, acx, axc, rc, csys->mat->val, csys->rhs);
+    break;
+  case 5:
+    _condense_scalar_n(5, acx, axc, rc, csys->mat->val, csys->rhs);
+    break;
+  case 6:
+    _condense_scalar_n(6, acx, axc, rc, csys->mat->val, csys->rhs);
+    break;
 
-    /* Update RHS_x: RHS_x = RHS_x - Axc*Acc^-1*RHS_c */
+  default:
+    _condense_scalar_n(n_xc, acx, axc, rc, csys->mat->val, csys->rhs);
+    break;
 
-    csys->rhs[i] -= rc_tilda[csys->c_id] * axc[i];
+  }
+}
 
-  } /* Loop on vi cell entities */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Same as \ref cs_static_condensation_scalar_eq but for a batch of
+ *          local systems of the same size (cells with the same number of
+ *          faces for instance). Local systems are gathered lane by lane so
+ *          that the condensation is performed for all the lanes at once.
+ *          Case of scalar-valued CDO equations
+ *
+ * \param[in]      c2x         pointer to a cs_adjacency_t structure
+ * \param[in, out] rc_tilda    pointer to the rhs related to cell DoFs (Acc-1
+ * \param[in, out] acx_tilda   pointer to an unrolled matrix Acc^-1 * Acx
+ * \param[in]      n_lanes     number of local systems in the batch
+ * \param[in, out] cb          pointer to a cs_cell_builder_t structure
+ * \param[in, out] csys        array of pointers to the local systems
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_static_condensation_scalar_eq_batch(const cs_adjacency_t    *c2x,
+                                       cs_real_t               *rc_tilda,
+                                       cs_real_t               *acx_tilda,
+                                       int                      n_lanes,
+                                       cs_cell_builder_t       *cb,
+                                       cs_cell_sys_t           *csys[])
+{
+  assert(n_lanes > 0 && n_lanes <= CS_CDO_CELL_BATCH_SIZE);
+
+  const int  n_dofs = csys[0]->n_dofs;
+  const int  n_xc = n_dofs - 1;
+
+  if (n_lanes == 1 || n_xc > CS_STATIC_CONDENSATION_BATCH_MAX_XC) {
+    for (int l = 0; l < n_lanes; l++)
+      cs_static_condensation_scalar_eq(c2x, rc_tilda, acx_tilda, cb, csys[l]);
+    return;
+  }
+
+  const int  nb = CS_CDO_CELL_BATCH_SIZE;
+
+  /* Work arrays interlaced by lane */
+
+  double  mval[_BATCH_MAX_DOFS*_BATCH_MAX_DOFS*CS_CDO_CELL_BATCH_SIZE];
+  double  cval[_BATCH_MAX_DOFS*_BATCH_MAX_DOFS*CS_CDO_CELL_BATCH_SIZE];
+  double  rhs[_BATCH_MAX_DOFS*CS_CDO_CELL_BATCH_SIZE];
+  double  acx[_BATCH_MAX_DOFS*CS_CDO_CELL_BATCH_SIZE];
+  double  axc[_BATCH_MAX_DOFS*CS_CDO_CELL_BATCH_SIZE];
+  double  rc[CS_CDO_CELL_BATCH_SIZE];
+
+  /* Gather the local systems and compute the quantities related to the
+     cell DoF (stored to recover the cell values after the resolution) */
+
+  for (int l = 0; l < n_lanes; l++) {
+
+    cs_cell_sys_t  *_csys = csys[l];
+    assert(_csys->n_dofs == n_dofs);
+
+    const double  *_mval = _csys->mat->val;
+    const double  *row_c = _mval + n_dofs*n_xc;
+    assert(fabs(row_c[n_xc]) > cs_math_zero_threshold);
+    const double  inv_acc = 1./row_c[n_xc];
+
+    rc[l] = inv_acc * _csys->rhs[n_xc];
+    rc_tilda[_csys->c_id] = rc[l];
+
+    double  *_acx = acx_tilda + c2x->idx[_csys->c_id];
+    for (int i = 0; i < n_xc; i++) {
+      _acx[i] = inv_acc * row_c[i];
+      acx[nb*i + l] = _acx[i];
+      axc[nb*i + l] = _mval[n_dofs*i + n_xc];
+      rhs[nb*i + l] = _csys->rhs[i];
+    }
+
+    for (int k = 0; k < n_dofs*n_xc; k++)
+      mval[nb*k + l] = _mval[k];
+
+  } /* Loop on lanes */
+
+  _condense_scalar_batch(n_xc, n_lanes, acx, axc, rc, mval, cval, rhs);
+
+  /* Scatter the condensed systems */
+
+  for (int l = 0; l < n_lanes; l++) {
+
+    cs_cell_sys_t  *_csys = csys[l];
+
+    _csys->n_dofs = n_xc;
+    _csys->mat->n_rows = _csys->mat->n_cols = n_xc;
+
+    for (int k = 0; k < n_xc*n_xc; k++)
+      _csys->mat->val[k] = cval[nb*k + l];
+    for (int i = 0; i < n_xc; i++)
+      _csys->rhs[i] = rhs[nb*i + l];
+
+  } /* Loop on lanes */
 }
 
 /*----------------------------------------------------------------------------*/
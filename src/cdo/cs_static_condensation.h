@@ -71,6 +71,31 @@ cs_static_condensation_scalar_eq(const cs_adjacency_t    *c2x,
                                  cs_cell_builder_t       *cb,
                                  cs_cell_sys_t           *csys);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief   Same as \ref cs_static_condensation_scalar_eq but for a batch of
+ *          local systems of the same size (cells with the same number of
+ *          faces for instance). Local systems are gathered lane by lane so
+ *          that the condensation is performed for all the lanes at once.
+ *          Case of scalar-valued CDO equations
+ *
+ * \param[in]      c2x         pointer to a cs_adjacency_t structure
+ * \param[in, out] rc_tilda    pointer to the rhs related to cell DoFs (Acc-1
+ * \param[in, out] acx_tilda   pointer to an unrolled matrix Acc^-1 * Acx
+ * \param[in]      n_lanes     number of local systems in the batch
+ * \param[in, out] cb          pointer to a cs_cell_builder_t structure
+ * \param[in, out] csys        array of pointers to the local systems
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_static_condensation_scalar_eq_batch(const cs_adjacency_t    *c2x,
+                                       cs_real_t               *rc_tilda,
+                                       cs_real_t               *acx_tilda,
+                                       int                      n_lanes,
+                                       cs_cell_builder_t       *cb,
+                                       cs_cell_sys_t           *csys[]);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief   Opposite process of the static condensation.
@@ -68,6 +68,11 @@ BEGIN_C_DECLS
 
 #define _dp3  cs_math_3_dot_product
 
+/* Max. number of quadrature points gathered before calling an analytic
+   function */
+
+#define CS_XDEF_CW_EVAL_N_MAX_QPTS  120
+
 /*=============================================================================
  * Local variables
  *============================================================================*/
@@ -80,6 +85,46 @@ static const char _err_empty_array[] =
  * Private function prototypes
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Evaluate an analytic function at a set of quadrature points in one
+ *         call and add the weighted values to \p eval
+ *
+ * \param[in]      t_eval   time at which the function is evaluated
+ * \param[in]      ana      analytic function to integrate
+ * \param[in]      input    pointer to an input structure
+ * \param[in]      dim      dimension of the function (1, 3 or 9)
+ * \param[in]      n_pts    number of quadrature points
+ * \param[in]      gpts     coordinates of the quadrature points
+ * \param[in]      w        weights related to the quadrature points
+ * \param[in, out] eval     integral to update (size = dim)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_add_qpts_contrib(double                  t_eval,
+                  cs_analytic_func_t     *ana,
+                  void                   *input,
+                  int                     dim,
+                  int                     n_pts,
+                  const cs_real_t         gpts[],
+                  const cs_real_t         w[],
+                  cs_real_t              *eval)
+{
+  cs_real_t  evals[9*CS_XDEF_CW_EVAL_N_MAX_QPTS];
+
+  assert(dim <= 9 && n_pts <= CS_XDEF_CW_EVAL_N_MAX_QPTS);
+
+  if (n_pts == 0)
+    return;
+
+  ana(t_eval, n_pts, NULL, gpts, true, input, evals);
+
+  for (int p = 0; p < n_pts; p++)
+    for (int k = 0; k < dim; k++)
+      eval[k] += w[p]*evals[dim*p+k];
+}
+
 /*! \endcond DOXYGEN_SHOULD_SKIP_THIS */
 
 /*============================================================================
@@ -234,6 +279,205 @@ cs_xdef_cw_eval_c_int_by_analytic(const cs_cell_mesh_t            *cm,
   } /* End of switch on the cell-type */
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Integrate an analytic function over a face. The quadrature points
+ *         of all the sub-triangles are gathered so that the analytic function
+ *         is called once for the face (or once per set of
+ *         CS_XDEF_CW_EVAL_N_MAX_QPTS points).
+ *
+ * \param[in]      cm       pointer to a \ref cs_cell_mesh_t structure
+ * \param[in]      t_eval   time at which the function is evaluated
+ * \param[in]      f        face id in the local cell numbering
+ * \param[in]      ana      analytic function to integrate
+ * \param[in]      input    pointer to an input structure
+ * \param[in]      dim      dimension of the function (1, 3 or 9)
+ * \param[in]      qtype    quadrature type
+ * \param[in, out] eval     result of the evaluation
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_xdef_cw_eval_f_int_by_analytic_batch(const cs_cell_mesh_t   *cm,
+                                        double                  t_eval,
+                                        short int               f,
+                                        cs_analytic_func_t     *ana,
+                                        void                   *input,
+                                        int                     dim,
+                                        cs_quadrature_type_t    qtype,
+                                        cs_real_t              *eval)
+{
+  const cs_quant_t  pfq = cm->face[f];
+  const int  start = cm->f2e_idx[f];
+  const int  end = cm->f2e_idx[f+1];
+  const short int n_vf = end - start;  /* #vertices (=#edges) */
+  const short int *f2e_ids = cm->f2e_ids + start;
+
+  int  n_qp = 0;
+  cs_quadrature_tria_t  *qrule = cs_quadrature_get_tria_rule(qtype, &n_qp);
+
+  int  n_pts = 0;
+  cs_real_t  gpts[3*CS_XDEF_CW_EVAL_N_MAX_QPTS];
+  cs_real_t  w[CS_XDEF_CW_EVAL_N_MAX_QPTS];
+
+  switch (n_vf) {
+  case CS_TRIANGLE_CASE:
+    {
+      short int  v0, v1, v2;
+      cs_cell_mesh_get_next_3_vertices(f2e_ids, cm->e2v_ids, &v0, &v1, &v2);
+
+      qrule(cm->xv+3*v0, cm->xv+3*v1, cm->xv+3*v2, pfq.meas,
+            (cs_real_3_t *)gpts, w);
+      n_pts = n_qp;
+    }
+    break;
+
+  default:
+    {
+      const double *tef = cm->tef + start;
+      for (short int e = 0; e < n_vf; e++) { /* Loop on face edges */
+
+        const short int  *e2v = cm->e2v_ids + 2*f2e_ids[e];
+        const double  *xv0 = cm->xv + 3*e2v[0];
+        const double  *xv1 = cm->xv + 3*e2v[1];
+
+        if (n_pts + n_qp > CS_XDEF_CW_EVAL_N_MAX_QPTS) {
+          _add_qpts_contrib(t_eval, ana, input, dim, n_pts, gpts, w, eval);
+          n_pts = 0;
+        }
+
+        qrule(xv0, xv1, pfq.center, tef[e],
+              (cs_real_3_t *)(gpts + 3*n_pts), w + n_pts);
+        n_pts += n_qp;
+
+      }
+    }
+  } /* Switch */
+
+  /* Remaining quadrature points */
+
+  _add_qpts_contrib(t_eval, ana, input, dim, n_pts, gpts, w, eval);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Integrate an analytic function over a cell. The cell is split into
+ *         tetrahedra and the quadrature points of all the tetrahedra are
+ *         gathered so that the analytic function is called once per cell (or
+ *         once per set of CS_XDEF_CW_EVAL_N_MAX_QPTS points).
+ *
+ * \param[in]      cm       pointer to a \ref cs_cell_mesh_t structure
+ * \param[in]      t_eval   time at which the function is evaluated
+ * \param[in]      ana      analytic function to integrate
+ * \param[in]      input    pointer to an input structure
+ * \param[in]      dim      dimension of the function (1, 3 or 9)
+ * \param[in]      qtype    quadrature type
+ * \param[in, out] eval     result of the evaluation
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_xdef_cw_eval_c_int_by_analytic_batch(const cs_cell_mesh_t   *cm,
+                                        double                  t_eval,
+                                        cs_analytic_func_t     *ana,
+                                        void                   *input,
+                                        int                     dim,
+                                        cs_quadrature_type_t    qtype,
+                                        cs_real_t              *eval)
+{
+  const cs_real_t  *xv = cm->xv;
+
+  int  n_qp = 0;
+  cs_quadrature_tet_t  *qrule = cs_quadrature_get_tetra_rule(qtype, &n_qp);
+
+  int  n_pts = 0;
+  cs_real_t  gpts[3*CS_XDEF_CW_EVAL_N_MAX_QPTS];
+  cs_real_t  w[CS_XDEF_CW_EVAL_N_MAX_QPTS];
+
+  switch (cm->type) {
+
+  case FVM_CELL_TETRA:
+    {
+      assert(cm->n_fc == 4 && cm->n_vc == 4);
+      qrule(xv, xv+3, xv+6, xv+9, cm->vol_c, (cs_real_3_t *)gpts, w);
+      n_pts = n_qp;
+    }
+    break;
+
+  case FVM_CELL_PYRAM:
+  case FVM_CELL_PRISM:
+  case FVM_CELL_HEXA:
+  case FVM_CELL_POLY:
+    {
+      for (short int f = 0; f < cm->n_fc; ++f) {
+
+        const cs_quant_t  pfq = cm->face[f];
+        const double  hf_coef = cs_math_1ov3 * cm->hfc[f];
+        const int  start = cm->f2e_idx[f];
+        const int  end = cm->f2e_idx[f+1];
+        const short int  n_vf = end - start; /* #vertices (=#edges) */
+        const short int  *f2e_ids = cm->f2e_ids + start;
+
+        assert(n_vf > 2);
+        switch(n_vf){
+
+        case CS_TRIANGLE_CASE: /* Optimized version, no subdivision */
+          {
+            short int  v0, v1, v2;
+            cs_cell_mesh_get_next_3_vertices(f2e_ids, cm->e2v_ids,
+                                             &v0, &v1, &v2);
+
+            if (n_pts + n_qp > CS_XDEF_CW_EVAL_N_MAX_QPTS) {
+              _add_qpts_contrib(t_eval, ana, input, dim, n_pts, gpts, w,
+                                eval);
+              n_pts = 0;
+            }
+
+            qrule(xv+3*v0, xv+3*v1, xv+3*v2, cm->xc, hf_coef * pfq.meas,
+                  (cs_real_3_t *)(gpts + 3*n_pts), w + n_pts);
+            n_pts += n_qp;
+          }
+          break;
+
+        default:
+          {
+            const double  *tef = cm->tef + start;
+
+            for (short int e = 0; e < n_vf; e++) { /* Loop on face edges */
+
+              const short int  *e2v = cm->e2v_ids + 2*f2e_ids[e];
+
+              if (n_pts + n_qp > CS_XDEF_CW_EVAL_N_MAX_QPTS) {
+                _add_qpts_contrib(t_eval, ana, input, dim, n_pts, gpts, w,
+                                  eval);
+                n_pts = 0;
+              }
+
+              qrule(xv+3*e2v[0], xv+3*e2v[1], pfq.center, cm->xc,
+                    hf_coef * tef[e],
+                    (cs_real_3_t *)(gpts + 3*n_pts), w + n_pts);
+              n_pts += n_qp;
+            }
+          }
+          break;
+
+        } /* End of switch */
+      } /* End of loop on faces */
+
+    }
+    break;
+
+  default:
+    bft_error(__FILE__, __LINE__, 0,  _(" Unknown cell-type.\n"));
+    break;
+
+  } /* End of switch on the cell-type */
+
+  /* Remaining quadrature points */
+
+  _add_qpts_contrib(t_eval, ana, input, dim, n_pts, gpts, w, eval);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Routine to integrate an analytic function over a cell and its faces
@@ -382,12 +626,10 @@ cs_xdef_cw_eval_scalar_face_avg_by_analytic(const cs_cell_mesh_t   *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tria_integral_t
-    *qfunc = cs_quadrature_get_tria_integral(1, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_f_int_by_analytic(cm, time_eval, f,
-                                    ac->func, ac->input, qfunc, eval);
+  cs_xdef_cw_eval_f_int_by_analytic_batch(cm, time_eval, f, ac->func, ac->input,
+                                          1, qtype, eval);
 
   /* Average */
 
@@ -425,12 +667,10 @@ cs_xdef_cw_eval_vector_face_avg_by_analytic(const cs_cell_mesh_t    *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tria_integral_t
-    *qfunc = cs_quadrature_get_tria_integral(3, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_f_int_by_analytic(cm, t_eval, f,
-                                    ac->func, ac->input, qfunc, eval);
+  cs_xdef_cw_eval_f_int_by_analytic_batch(cm, t_eval, f, ac->func, ac->input,
+                                          3, qtype, eval);
 
   /* Average */
 
@@ -470,12 +710,10 @@ cs_xdef_cw_eval_tensor_face_avg_by_analytic(const cs_cell_mesh_t    *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tria_integral_t
-    *qfunc = cs_quadrature_get_tria_integral(9, qtype);;
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_f_int_by_analytic(cm, t_eval, f,
-                                    ac->func, ac->input, qfunc, eval);
+  cs_xdef_cw_eval_f_int_by_analytic_batch(cm, t_eval, f, ac->func, ac->input,
+                                          9, qtype, eval);
 
   /* Average */
 
@@ -514,13 +752,10 @@ cs_xdef_cw_eval_scalar_avg_by_analytic(const cs_cell_mesh_t     *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tetra_integral_t
-    *qfunc = cs_quadrature_get_tetra_integral(1, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_c_int_by_analytic(cm, t_eval,
-                                    ac->func, ac->input, qfunc,
-                                    eval);
+  cs_xdef_cw_eval_c_int_by_analytic_batch(cm, t_eval, ac->func, ac->input,
+                                          1, qtype, eval);
 
   /* Average */
 
@@ -558,13 +793,10 @@ cs_xdef_cw_eval_vector_avg_by_analytic(const cs_cell_mesh_t     *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tetra_integral_t
-    *qfunc = cs_quadrature_get_tetra_integral(3, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_c_int_by_analytic(cm, t_eval,
-                                    ac->func, ac->input,
-                                    qfunc, eval);
+  cs_xdef_cw_eval_c_int_by_analytic_batch(cm, t_eval, ac->func, ac->input,
+                                          3, qtype, eval);
 
   /* Average */
 
@@ -604,13 +836,10 @@ cs_xdef_cw_eval_tensor_avg_by_analytic(const cs_cell_mesh_t     *cm,
                        CS_FLAG_COMP_PEQ | CS_FLAG_COMP_PFQ | CS_FLAG_COMP_FE |
                        CS_FLAG_COMP_FEQ | CS_FLAG_COMP_EV));
 
-  cs_quadrature_tetra_integral_t
-    *qfunc = cs_quadrature_get_tetra_integral(9, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
 
-  cs_xdef_cw_eval_c_int_by_analytic(cm, t_eval,
-                                    ac->func, ac->input, qfunc,
-                                    eval);
+  cs_xdef_cw_eval_c_int_by_analytic_batch(cm, t_eval, ac->func, ac->input,
+                                          9, qtype, eval);
 
   /* Average */
 
@@ -2308,18 +2537,16 @@ cs_xdef_cw_eval_scal_avg_reduction_by_analytic(const cs_cell_mesh_t    *cm,
   const int dim = 1;
   const short int nf = cm->n_fc;
 
-  cs_quadrature_tetra_integral_t
-    *q_tet = cs_quadrature_get_tetra_integral(dim, qtype);
-  cs_quadrature_tria_integral_t
-    *q_tri = cs_quadrature_get_tria_integral(dim, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
   cs_real_t *c_eval = eval + nf;
 
-  cs_xdef_cw_eval_fc_int_by_analytic(cm, t_eval,
-                                     ac->func, ac->input,
-                                     dim,
-                                     q_tet, q_tri,
-                                     c_eval, eval);
+  for (short int f = 0; f < nf; f++)
+    cs_xdef_cw_eval_f_int_by_analytic_batch(cm, t_eval, f,
+                                            ac->func, ac->input,
+                                            dim, qtype, eval + dim*f);
+
+  cs_xdef_cw_eval_c_int_by_analytic_batch(cm, t_eval, ac->func, ac->input,
+                                          dim, qtype, c_eval);
 
   /* Compute the averages */
 
@@ -2363,18 +2590,16 @@ cs_xdef_cw_eval_vect_avg_reduction_by_analytic(const cs_cell_mesh_t    *cm,
   const int  dim = 3;
   const short int nf = cm->n_fc;
 
-  cs_quadrature_tetra_integral_t
-    *q_tet = cs_quadrature_get_tetra_integral(3, qtype);
-  cs_quadrature_tria_integral_t
-    *q_tri = cs_quadrature_get_tria_integral(3, qtype);
   cs_xdef_analytic_context_t  *ac = (cs_xdef_analytic_context_t *)context;
   cs_real_t *c_eval = eval + dim*nf;
 
-  cs_xdef_cw_eval_fc_int_by_analytic(cm, t_eval,
-                                     ac->func, ac->input,
-                                     dim,
-                                     q_tet, q_tri,
-                                     c_eval, eval);
+  for (short int f = 0; f < nf; f++)
+    cs_xdef_cw_eval_f_int_by_analytic_batch(cm, t_eval, f,
+                                            ac->func, ac->input,
+                                            dim, qtype, eval + dim*f);
+
+  cs_xdef_cw_eval_c_int_by_analytic_batch(cm, t_eval, ac->func, ac->input,
+                                          dim, qtype, c_eval);
 
   /* Compute the averages */
 
@@ -2391,5 +2616,6 @@ cs_xdef_cw_eval_vect_avg_reduction_by_analytic(const cs_cell_mesh_t    *cm,
 /*----------------------------------------------------------------------------*/
 
 #undef _dp3
+#undef CS_XDEF_CW_EVAL_N_MAX_QPTS
 
 END_C_DECLS
@@ -654,6 +654,60 @@ cs_xdef_cw_eval_c_int_by_analytic(const cs_cell_mesh_t            *cm,
                                   cs_quadrature_tetra_integral_t  *qfunc,
                                   cs_real_t                       *eval);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Integrate an analytic function over a face. The quadrature points
+ *         of all the sub-triangles are gathered so that the analytic function
+ *         is called once for the face (or once per set of
+ *         CS_XDEF_CW_EVAL_N_MAX_QPTS points).
+ *
+ * \param[in]      cm       pointer to a \ref cs_cell_mesh_t structure
+ * \param[in]      t_eval   time at which the function is evaluated
+ * \param[in]      f        face id in the local cell numbering
+ * \param[in]      ana      analytic function to integrate
+ * \param[in]      input    pointer to an input structure
+ * \param[in]      dim      dimension of the function (1, 3 or 9)
+ * \param[in]      qtype    quadrature type
+ * \param[in, out] eval     result of the evaluation
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_xdef_cw_eval_f_int_by_analytic_batch(const cs_cell_mesh_t   *cm,
+                                        double                  t_eval,
+                                        short int               f,
+                                        cs_analytic_func_t     *ana,
+                                        void                   *input,
+                                        int                     dim,
+                                        cs_quadrature_type_t    qtype,
+                                        cs_real_t              *eval);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Integrate an analytic function over a cell. The cell is split into
+ *         tetrahedra and the quadrature points of all the tetrahedra are
+ *         gathered so that the analytic function is called once per cell (or
+ *         once per set of CS_XDEF_CW_EVAL_N_MAX_QPTS points).
+ *
+ * \param[in]      cm       pointer to a \ref cs_cell_mesh_t structure
+ * \param[in]      t_eval   time at which the function is evaluated
+ * \param[in]      ana      analytic function to integrate
+ * \param[in]      input    pointer to an input structure
+ * \param[in]      dim      dimension of the function (1, 3 or 9)
+ * \param[in]      qtype    quadrature type
+ * \param[in, out] eval     result of the evaluation
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_xdef_cw_eval_c_int_by_analytic_batch(const cs_cell_mesh_t   *cm,
+                                        double                  t_eval,
+                                        cs_analytic_func_t     *ana,
+                                        void                   *input,
+                                        int                     dim,
+                                        cs_quadrature_type_t    qtype,
+                                        cs_real_t              *eval);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Routine to integrate an analytic function over a cell and its faces
@@ -32,6 +32,7 @@
  *----------------------------------------------------------------------------*/
 
 #include <assert.h>
+#include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -2513,6 +2514,121 @@ _export_field_values_el(const fvm_writer_section_t      *export_section,
   return current_section;
 }
 
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Write an EnSight "server of servers" master file referencing the
+ * independent cases written by each rank.
+ *
+ * parameters:
+ *   name    <-- base output case name.
+ *   path    <-- optional directory name for output
+ *   n_cases <-- number of independent cases
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_sos_file(const char  *name,
+                const char  *path,
+                int          n_cases)
+{
+  size_t  i;
+  FILE   *f;
+  char   *file_name = NULL, *case_name = NULL;
+
+  const size_t name_len = strlen(name);
+  const size_t prefix_len = (path != NULL) ? strlen(path) : 0;
+
+  BFT_MALLOC(case_name, name_len + 1, char);
+  for (i = 0; i < name_len; i++)
+    case_name[i] = toupper(name[i]);
+  case_name[name_len] = '\0';
+
+  BFT_MALLOC(file_name, prefix_len + name_len + 5, char);
+  if (path != NULL)
+    strcpy(file_name, path);
+  else
+    file_name[0] = '\0';
+  strcat(file_name, case_name);
+  strcat(file_name, ".sos");
+
+  f = fopen(file_name, "w");
+
+  if (f == NULL)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Error opening file \"%s\":\n\n"
+                "  %s"), file_name, strerror(errno));
+
+  fprintf(f,
+          "FORMAT\n"
+          "type: master_server gold\n"
+          "\n"
+          "SERVERS\n"
+          "number of servers: %d\n",
+          n_cases);
+
+  for (int c_id = 0; c_id < n_cases; c_id++)
+    fprintf(f,
+            "\n"
+            "#Server %d\n"
+            "machine id: localhost\n"
+            "executable: ensight_server\n"
+            "casefile: %s.%05d.case\n",
+            c_id + 1, case_name, c_id);
+
+  if (fclose(f) != 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Error closing file \"%s\":\n\n"
+                "  %s"), file_name, strerror(errno));
+
+  BFT_FREE(case_name);
+  BFT_FREE(file_name);
+}
+
+/*----------------------------------------------------------------------------
+ * Switch a writer to independent output by rank.
+ *
+ * Each rank writes its own EnSight case using the serial output path, so
+ * that no part to block redistribution of meshes and fields occurs, and
+ * element and vertex counts are local to the rank. A master file allows
+ * reading all cases together.
+ *
+ * Groups of ranks sharing a case are not handled, as this would require
+ * a group-local numbering of vertices and elements.
+ *
+ * parameters:
+ *   w     <-> pointer to Ensight Gold writer structure
+ *   name  <-- base output case name.
+ *   path  <-- optional directory name for output
+ *
+ * returns:
+ *   newly allocated case name for the current rank
+ *----------------------------------------------------------------------------*/
+
+static char *
+_init_rank_files(fvm_to_ensight_writer_t  *w,
+                 const char               *name,
+                 const char               *path)
+{
+  char *case_name = NULL;
+
+  const int case_id = w->rank;
+
+  if (w->rank == 0)
+    _write_sos_file(name, path, w->n_ranks);
+
+  w->rank = 0;
+  w->n_ranks = 1;
+  w->comm = MPI_COMM_NULL;
+  w->block_comm = MPI_COMM_NULL;
+
+  BFT_MALLOC(case_name, strlen(name) + 12, char);
+  sprintf(case_name, "%s.%05d", name, case_id);
+
+  return case_name;
+}
+
+#endif /* defined(HAVE_MPI) */
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -2531,6 +2647,8 @@ _export_field_values_el(const fvm_writer_section_t      *export_section,
  *   divide_polygons     tesselate polygons with triangles
  *   divide_polyhedra    tesselate polyhedra with tetrahedra and pyramids
  *                       (adding a vertex near each polyhedron's center)
+ *   rank_files          each rank writes its own case, referenced by a
+ *                       "server of servers" master file (no redistribution)
  *
  * parameters:
  *   name           <-- base output case name.
@@ -2602,6 +2720,8 @@ fvm_to_ensight_init_writer(const char             *name,
   }
 #endif /* defined(HAVE_MPI) */
 
+  bool rank_files = false;
+
   /* Parse options */
 
   if (options != NULL) {
@@ -2644,15 +2764,31 @@ fvm_to_ensight_init_writer(const char             *name,
                && (strncmp(options + i1, "divide_polyhedra", l_opt) == 0))
         this_writer->divide_polyhedra = true;
 
+      else if (   (l_opt == 10)
+               && (strncmp(options + i1, "rank_files", l_opt) == 0))
+        rank_files = true;
+
       for (i1 = i2 + 1; i1 < l_tot && options[i1] == ' '; i1++);
 
     }
 
   }
 
-  this_writer->case_info = fvm_to_ensight_case_create(name,
-                                                      path,
-                                                      time_dependency);
+  /* Independent output by rank */
+
+  char *case_name = NULL;
+
+#if defined(HAVE_MPI)
+  if (rank_files && this_writer->n_ranks > 1)
+    case_name = _init_rank_files(this_writer, name, path);
+#endif
+
+  this_writer->case_info
+    = fvm_to_ensight_case_create((case_name != NULL) ? case_name : name,
+                                 path,
+                                 time_dependency);
+
+  BFT_FREE(case_name);
 
   /* Return writer */
 
@@ -2870,14 +3006,28 @@ fvm_to_ensight_export_nodal(void               *this_writer_p,
       cs_gnum_t n_g_elements = 0;
       const fvm_writer_section_t  *next_section = export_section;
 
+      /* In serial mode, use local counts, which differ from global
+         counts when each rank writes its own case */
+
       do {
 
-        if (next_section->section->type == export_section->type)
-          n_g_elements += fvm_nodal_section_n_g_elements(next_section->section);
+        const fvm_nodal_section_t  *n_section = next_section->section;
+
+        if (n_section->type == export_section->type) {
+          if (n_ranks == 1)
+            n_g_elements += n_section->n_elements;
+          else
+            n_g_elements += fvm_nodal_section_n_g_elements(n_section);
+        }
+
+        else if (n_ranks == 1)
+          n_g_elements
+            += fvm_tesselation_n_sub_elements(n_section->tesselation,
+                                              next_section->type);
 
         else {
           cs_gnum_t n_g_sub_elements = 0;
-          fvm_tesselation_get_global_size(next_section->section->tesselation,
+          fvm_tesselation_get_global_size(n_section->tesselation,
                                           next_section->type,
                                           &n_g_sub_elements,
                                           NULL);
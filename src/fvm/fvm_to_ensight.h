@@ -66,6 +66,8 @@ BEGIN_C_DECLS
  *   divide_polygons     tesselate polygons with triangles
  *   divide_polyhedra    tesselate polyhedra with tetrahedra and pyramids
  *                       (adding a vertex near each polyhedron's center)
+ *   rank_files          each rank writes its own case, referenced by a
+ *                       "server of servers" master file (no redistribution)
  *
  * parameters:
  *   name           <-- base output case name.
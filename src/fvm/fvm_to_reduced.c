@@ -0,0 +1,1107 @@
+/*============================================================================
+ * Write variables associated with a nodal mesh to compressed files
+ * (lossy, error-bounded data reduction)
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "fvm_defs.h"
+#include "fvm_io_num.h"
+#include "fvm_nodal.h"
+#include "fvm_nodal_priv.h"
+#include "fvm_writer_helper.h"
+#include "fvm_writer_priv.h"
+
+#include "cs_file.h"
+#include "cs_parall.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "fvm_to_reduced.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*----------------------------------------------------------------------------
+ * File layout
+ *
+ * Each field is written to a separate binary file (in native byte order)
+ * per time step, named <name>_<field>_<time_step>.red, with:
+ *
+ *   char[80]    "code_saturne reduced field 1.1"
+ *   char[80]    field name
+ *   int32[5]    output dimension, location (0: elements, 1: vertices),
+ *               time step, sampling step, relative error flag
+ *   double[2]   time value, error bound
+ *
+ * followed by a series of self-contained chunks, each containing
+ * values of a given component for a contiguous range of the global
+ * vertex numbering, or of the global element numbering of a given mesh
+ * section, in increasing order:
+ *
+ *   int32       component id
+ *   int32       section id (position in the mesh's section list for
+ *               elements, -1 for vertices)
+ *   int32       Rice coding parameter k
+ *   uint64      global number of the first value (1 to n)
+ *   uint64      number of values n
+ *   uint64      number of payload bytes
+ *   double      v_min
+ *   double      quantization step dq
+ *   uint8[]     payload
+ *
+ * With a sampling step s, values are those with global numbers
+ * g = start, start + s, ..., (where (g - 1) is a multiple of s).
+ *
+ * A relative error bound applies to the range of values of each
+ * component over the whole output mesh (all sections and ranks).
+ *
+ * Values are quantized as q_i = round((v_i - v_min) / dq), so that
+ * |v_i - (v_min + q_i.dq)| <= dq/2 (the error bound). Differences
+ * d_i = q_i - q_{i-1} (with q_{-1} = 0) are mapped to unsigned integers
+ * u_i = 2d_i if d_i >= 0 or -2d_i - 1 otherwise, and Rice-coded
+ * (most significant bit first): the quotient u_i >> k in unary (ones
+ * terminated by a zero), followed by the k lower bits of u_i. When the
+ * quotient reaches 24, 24 ones are followed by the 64 bits of u_i.
+ *----------------------------------------------------------------------------*/
+
+/*============================================================================
+ * Local Macro Definitions
+ *============================================================================*/
+
+#define _RICE_ESCAPE 24
+
+/*============================================================================
+ * Local Type Definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Reduced writer structure
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+
+  char        *name;               /* Writer name */
+  char        *path;               /* Path prefix */
+
+  int          rank;               /* Rank of current process in communicator */
+  int          n_ranks;            /* Number of processes in communicator */
+
+  double       abs_error;          /* Absolute error bound, or < 0 */
+  double       rel_error;          /* Error bound relative to the global
+                                      range of each component */
+  int          sample_step;        /* Output one value out of sample_step */
+
+  int          nt;                 /* Time step */
+  double       t;                  /* Time value */
+
+#if defined(HAVE_MPI)
+  int          min_block_size;     /* Minimum block buffer size */
+  MPI_Comm     block_comm;         /* Associated MPI block communicator */
+  MPI_Comm     comm;               /* Associated MPI communicator */
+#endif
+
+} fvm_to_reduced_writer_t;
+
+/*----------------------------------------------------------------------------
+ * Bit stream buffer
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+
+  size_t          size;            /* Allocated size, in bytes */
+  size_t          n_bits;          /* Number of bits written */
+  unsigned char  *buf;             /* Associated buffer */
+
+} _bit_buffer_t;
+
+/*----------------------------------------------------------------------------
+ * Context structure for fvm_writer_field_helper_output_* functions.
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+
+  fvm_to_reduced_writer_t  *writer;      /* Pointer to writer structure */
+  cs_file_t                *f;           /* Associated file */
+
+  int                       section_id;  /* Current mesh section id,
+                                            or -1 for vertices */
+  double                   *range;       /* Min and max values of each
+                                            component (size: 2*dim) */
+
+} _reduced_context_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static const size_t _chunk_header_size = 3*4 + 3*8 + 2*8;
+
+/* Warn only once when the error bound can not be met */
+
+static bool _dq_warned = false;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Append bits to a bit buffer (most significant bit first).
+ *
+ * parameters:
+ *   b      <-> pointer to bit buffer
+ *   v      <-- value whose n_bits lower bits are appended
+ *   n_bits <-- number of bits to append
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_put_bits(_bit_buffer_t  *b,
+          uint64_t        v,
+          int             n_bits)
+{
+  size_t n_bytes_min = (b->n_bits + n_bits + 7) / 8;
+
+  if (n_bytes_min > b->size) {
+    size_t old_size = b->size;
+    while (b->size < n_bytes_min)
+      b->size = (b->size > 0) ? b->size*2 : 64;
+    BFT_REALLOC(b->buf, b->size, unsigned char);
+    memset(b->buf + old_size, 0, b->size - old_size);
+  }
+
+  for (int i = n_bits - 1; i >= 0; i--) {
+    if ((v >> i) & 1)
+      b->buf[b->n_bits >> 3] |= (unsigned char)(0x80 >> (b->n_bits & 7));
+    b->n_bits++;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Read bits from a bit stream (most significant bit first).
+ *
+ * parameters:
+ *   buf    <-- bit stream
+ *   pos    <-> position in the stream, in bits
+ *   n_bits <-- number of bits to read (at most 64)
+ *
+ * returns:
+ *   value read
+ *----------------------------------------------------------------------------*/
+
+static inline uint64_t
+_get_bits(const unsigned char  *buf,
+          size_t               *pos,
+          int                   n_bits)
+{
+  uint64_t v = 0;
+
+  for (int i = 0; i < n_bits; i++) {
+    size_t p = *pos + i;
+    v = (v << 1) | ((buf[p >> 3] >> (7 - (p & 7))) & 1);
+  }
+  *pos += n_bits;
+
+  return v;
+}
+
+/*----------------------------------------------------------------------------
+ * Output function updating the range of field values.
+ *
+ * This function is passed to fvm_writer_field_helper_output_* functions.
+ *
+ * parameters:
+ *   context      <-> pointer to writer and field context
+ *   datatype     <-- output datatype
+ *   dimension    <-- output field dimension
+ *   component_id <-- output component id (if non-interleaved)
+ *   block_start  <-- start global number of element for current block
+ *   block_end    <-- past-the-end global number of element for current block
+ *   buffer       <-> associated output buffer
+ *----------------------------------------------------------------------------*/
+
+static void
+_field_range(void           *context,
+             cs_datatype_t   datatype,
+             int             dimension,
+             int             component_id,
+             cs_gnum_t       block_start,
+             cs_gnum_t       block_end,
+             void           *buffer)
+{
+  CS_UNUSED(datatype);
+  CS_UNUSED(dimension);
+
+  _reduced_context_t *c = (_reduced_context_t *)context;
+
+  const double *vals = (const double *)buffer;
+  const size_t n_vals = (block_end > block_start) ? block_end - block_start : 0;
+
+  double *range = c->range + 2*component_id;
+
+  for (size_t i = 0; i < n_vals; i++) {
+    if (vals[i] < range[0])
+      range[0] = vals[i];
+    if (vals[i] > range[1])
+      range[1] = vals[i];
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Output function for field values.
+ *
+ * This function is passed to fvm_writer_field_helper_output_* functions.
+ *
+ * parameters:
+ *   context      <-> pointer to writer and field context
+ *   datatype     <-- output datatype
+ *   dimension    <-- output field dimension
+ *   component_id <-- output component id (if non-interleaved)
+ *   block_start  <-- start global number of element for current block
+ *   block_end    <-- past-the-end global number of element for current block
+ *   buffer       <-> associated output buffer
+ *----------------------------------------------------------------------------*/
+
+static void
+_field_output(void           *context,
+              cs_datatype_t   datatype,
+              int             dimension,
+              int             component_id,
+              cs_gnum_t       block_start,
+              cs_gnum_t       block_end,
+              void           *buffer)
+{
+  CS_UNUSED(datatype);
+  CS_UNUSED(dimension);
+
+  _reduced_context_t *c = (_reduced_context_t *)context;
+
+  fvm_to_reduced_writer_t  *w = c->writer;
+
+  double *vals = (double *)buffer;
+
+  size_t n_vals = (block_end > block_start) ? block_end - block_start : 0;
+
+  cs_gnum_t start_num = block_start;
+
+  /* Sub-sampling (in place, as the buffer is refilled for each component) */
+
+  if (w->sample_step > 1) {
+    const cs_gnum_t step = w->sample_step;
+    start_num = ((block_start - 1 + step - 1) / step) * step + 1;
+    size_t j = 0;
+    for (size_t i = 0; i < n_vals; i++) {
+      if ((block_start + i - 1) % step == 0)
+        vals[j++] = vals[i];
+    }
+    n_vals = j;
+  }
+
+  /* The relative error bound is based on the global value range */
+
+  const double *range = c->range + 2*component_id;
+  double dq = fvm_to_reduced_quantization_step(w->abs_error,
+                                               w->rel_error,
+                                               range[0],
+                                               range[1]);
+
+  unsigned char *chunk = NULL;
+  size_t n_bytes = fvm_to_reduced_encode_chunk(component_id,
+                                               c->section_id,
+                                               start_num,
+                                               dq,
+                                               n_vals,
+                                               vals,
+                                               &chunk);
+
+  /* Compressed sizes vary, so write ranges are based on a prefix sum */
+
+  cs_gnum_t byte_range[2] = {1, n_bytes + 1};
+
+#if defined(HAVE_MPI)
+  if (w->n_ranks > 1) {
+    cs_gnum_t l_bytes = n_bytes, s_bytes = 0;
+    MPI_Scan(&l_bytes, &s_bytes, 1, CS_MPI_GNUM, MPI_SUM, w->comm);
+    byte_range[0] = s_bytes - l_bytes + 1;
+    byte_range[1] = s_bytes + 1;
+  }
+#endif
+
+  cs_file_write_block_buffer(c->f,
+                             chunk,
+                             1,
+                             1,
+                             byte_range[0],
+                             byte_range[1]);
+
+  BFT_FREE(chunk);
+}
+
+/*----------------------------------------------------------------------------
+ * Output field values through a given output function.
+ *
+ * parameters:
+ *   helper           <-> pointer to field helper structure
+ *   c                <-> pointer to writer and field context
+ *   mesh             <-- pointer to associated nodal mesh structure
+ *   export_list      <-- list of exported sections
+ *   location         <-- variable definition location (nodes or elements)
+ *   dimension        <-- variable dimension
+ *   interlace        <-- indicates if variable in memory is interlaced
+ *   n_parent_lists   <-- number of parent lists
+ *   parent_num_shift <-- parent number to value array index shifts
+ *   datatype         <-- data type of (source) field values
+ *   field_values     <-- array of associated field value arrays
+ *   output_func      <-- pointer to output function
+ *----------------------------------------------------------------------------*/
+
+static void
+_output_field(fvm_writer_field_helper_t   *helper,
+              _reduced_context_t          *c,
+              const fvm_nodal_t           *mesh,
+              const fvm_writer_section_t  *export_list,
+              fvm_writer_var_loc_t         location,
+              int                          dimension,
+              cs_interlace_t               interlace,
+              int                          n_parent_lists,
+              const cs_lnum_t              parent_num_shift[],
+              cs_datatype_t                datatype,
+              const void            *const field_values[],
+              fvm_writer_field_output_t   *output_func)
+{
+  if (location == FVM_WRITER_PER_NODE) {
+
+    c->section_id = -1;
+
+    fvm_writer_field_helper_output_n(helper,
+                                     c,
+                                     mesh,
+                                     dimension,
+                                     interlace,
+                                     NULL,
+                                     n_parent_lists,
+                                     parent_num_shift,
+                                     datatype,
+                                     field_values,
+                                     output_func);
+
+  }
+
+  else if (location == FVM_WRITER_PER_ELEMENT) {
+
+    const fvm_writer_section_t  *export_section = export_list;
+
+    while (export_section != NULL) {
+
+      c->section_id = -1;
+      for (int i = 0; i < mesh->n_sections; i++) {
+        if (mesh->sections[i] == export_section->section) {
+          c->section_id = i;
+          break;
+        }
+      }
+
+      export_section = fvm_writer_field_helper_output_e(helper,
+                                                        c,
+                                                        export_section,
+                                                        dimension,
+                                                        interlace,
+                                                        NULL,
+                                                        n_parent_lists,
+                                                        parent_num_shift,
+                                                        datatype,
+                                                        field_values,
+                                                        output_func);
+
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Open a reduced field file and write its header.
+ *
+ * parameters:
+ *   w          <-- pointer to writer structure
+ *   name       <-- field name
+ *   dimension  <-- field dimension
+ *   location   <-- variable definition location (nodes or elements)
+ *
+ * returns:
+ *   pointer to file structure
+ *----------------------------------------------------------------------------*/
+
+static cs_file_t *
+_open_field_file(fvm_to_reduced_writer_t  *w,
+                 const char               *name,
+                 int                       dimension,
+                 fvm_writer_var_loc_t      location)
+{
+  cs_file_t *f = NULL;
+
+  /* File name */
+
+  char t_stamp[16];
+  if (w->nt < 0)
+    t_stamp[0] = '\0';
+  else
+    sprintf(t_stamp, "_%.4i", w->nt);
+
+  size_t l_name = strlen(name);
+  size_t l =   strlen(w->path) + strlen(w->name) + 1 + l_name
+             + strlen(t_stamp) + 4 + 1;
+
+  char *file_name;
+  BFT_MALLOC(file_name, l, char);
+  sprintf(file_name, "%s%s_%s%s.red", w->path, w->name, name, t_stamp);
+
+  for (size_t i = strlen(w->path); i < l - 1; i++) {
+    if (file_name[i] == ' ' || file_name[i] == '\t')
+      file_name[i] = '_';
+  }
+
+  cs_file_access_t method;
+
+#if defined(HAVE_MPI)
+
+  MPI_Info hints;
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method, &hints);
+  f = cs_file_open(file_name,
+                   CS_FILE_MODE_WRITE,
+                   method,
+                   hints,
+                   w->block_comm,
+                   w->comm);
+
+#else
+
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method);
+  f = cs_file_open(file_name, CS_FILE_MODE_WRITE, method);
+
+#endif
+
+  BFT_FREE(file_name);
+
+  /* Header */
+
+  char buf[81];
+
+  memset(buf, 0, 81);
+  strncpy(buf, "code_saturne reduced field 1.1", 80);
+  cs_file_write_global(f, buf, 1, 80);
+
+  memset(buf, 0, 81);
+  strncpy(buf, name, 80);
+  cs_file_write_global(f, buf, 1, 80);
+
+  int32_t header_i[5] = {dimension,
+                         (location == FVM_WRITER_PER_NODE) ? 1 : 0,
+                         w->nt,
+                         w->sample_step,
+                         (w->abs_error > 0) ? 0 : 1};
+  double header_d[2] = {w->t,
+                        (w->abs_error > 0) ? w->abs_error : w->rel_error};
+
+  cs_file_write_global(f, header_i, 4, 5);
+  cs_file_write_global(f, header_d, 8, 2);
+
+  return f;
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Semi-private function definitions (prototypes in fvm_to_reduced.h)
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Return the quantization step associated with an error bound.
+ *
+ * parameters:
+ *   abs_error <-- absolute error bound, or <= 0 for a relative bound
+ *   rel_error <-- error bound relative to the range [v_min, v_max]
+ *   v_min     <-- minimum value of the component (over the whole mesh)
+ *   v_max     <-- maximum value of the component (over the whole mesh)
+ *
+ * returns:
+ *   quantization step (twice the error bound)
+ *----------------------------------------------------------------------------*/
+
+double
+fvm_to_reduced_quantization_step(double  abs_error,
+                                 double  rel_error,
+                                 double  v_min,
+                                 double  v_max)
+{
+  if (abs_error > 0)
+    return 2*abs_error;
+  else
+    return 2*rel_error*(v_max - v_min);
+}
+
+/*----------------------------------------------------------------------------
+ * Compress a block of values of a given component into a chunk.
+ *
+ * If the range of values is too large for the requested quantization step
+ * (quantized values must fit in the mantissa of a double), the step is
+ * increased and a warning is printed (once).
+ *
+ * parameters:
+ *   component_id <-- component id
+ *   section_id   <-- mesh section id, or -1 for vertices
+ *   start_num    <-- global number of first value
+ *   dq           <-- quantization step (twice the error bound)
+ *   n_vals       <-- number of values
+ *   vals         <-- values
+ *   chunk        --> pointer to allocated chunk (header and payload),
+ *                    or NULL if n_vals = 0
+ *
+ * returns:
+ *   size of chunk, in bytes
+ *----------------------------------------------------------------------------*/
+
+size_t
+fvm_to_reduced_encode_chunk(int              component_id,
+                            int              section_id,
+                            cs_gnum_t        start_num,
+                            double           dq,
+                            size_t           n_vals,
+                            const double     vals[],
+                            unsigned char  **chunk)
+{
+  *chunk = NULL;
+
+  if (n_vals == 0)
+    return 0;
+
+  /* Quantization */
+
+  double v_min = vals[0], v_max = vals[0];
+  for (size_t i = 1; i < n_vals; i++) {
+    if (vals[i] < v_min)
+      v_min = vals[i];
+    else if (vals[i] > v_max)
+      v_max = vals[i];
+  }
+
+  /* Ensure quantized values fit in the double mantissa */
+
+  const double q_max = 9007199254740992.; /* 2^53 */
+  if ((v_max - v_min) > dq*q_max) {
+    double dq_min = (v_max - v_min) / q_max;
+    if (dq > 0 && _dq_warned == false) {
+      bft_printf(_("\nWarning: reduced writer output\n"
+                   "  the error bound %g is too small for the value range\n"
+                   "  [%g, %g]; it is increased to %g.\n"
+                   "  (further occurences are not reported)\n"),
+                 dq*0.5, v_min, v_max, dq_min*0.5);
+      _dq_warned = true;
+    }
+    dq = dq_min;
+  }
+  if (!(dq > 0))
+    dq = 1.;
+
+  uint64_t *u;
+  BFT_MALLOC(u, n_vals, uint64_t);
+
+  int64_t q_prev = 0;
+  double u_sum = 0;
+
+  for (size_t i = 0; i < n_vals; i++) {
+    int64_t q = (int64_t)((vals[i] - v_min)/dq + 0.5);
+    int64_t d = q - q_prev;
+    u[i] = (d >= 0) ? (uint64_t)d*2 : (uint64_t)(-d)*2 - 1;
+    u_sum += (double)u[i];
+    q_prev = q;
+  }
+
+  /* Rice parameter (close to log2 of mean) */
+
+  int k = 0;
+  const double u_mean = u_sum / n_vals;
+  while (k < 62 && (double)((uint64_t)1 << (k+1)) <= u_mean)
+    k++;
+
+  /* Rice coding */
+
+  _bit_buffer_t b = {.size = 0, .n_bits = 0, .buf = NULL};
+
+  const uint64_t k_mask = ((uint64_t)1 << k) - 1;
+
+  for (size_t i = 0; i < n_vals; i++) {
+    uint64_t r_q = u[i] >> k;
+    if (r_q < _RICE_ESCAPE) {
+      _put_bits(&b, (((uint64_t)1 << r_q) - 1) << 1, r_q + 1);
+      if (k > 0)
+        _put_bits(&b, u[i] & k_mask, k);
+    }
+    else {
+      _put_bits(&b, ((uint64_t)1 << _RICE_ESCAPE) - 1, _RICE_ESCAPE);
+      _put_bits(&b, u[i], 64);
+    }
+  }
+
+  BFT_FREE(u);
+
+  /* Assemble chunk */
+
+  const size_t n_payload_bytes = (b.n_bits + 7) / 8;
+  const size_t n_bytes = _chunk_header_size + n_payload_bytes;
+
+  unsigned char *_chunk;
+  BFT_MALLOC(_chunk, n_bytes, unsigned char);
+
+  int32_t header_i[3] = {component_id, section_id, k};
+  uint64_t header_u[3] = {start_num, n_vals, n_payload_bytes};
+  double header_d[2] = {v_min, dq};
+
+  memcpy(_chunk, header_i, 3*4);
+  memcpy(_chunk + 3*4, header_u, 3*8);
+  memcpy(_chunk + 3*4 + 3*8, header_d, 2*8);
+  if (n_payload_bytes > 0)
+    memcpy(_chunk + _chunk_header_size, b.buf, n_payload_bytes);
+
+  BFT_FREE(b.buf);
+
+  *chunk = _chunk;
+
+  return n_bytes;
+}
+
+/*----------------------------------------------------------------------------
+ * Decode a chunk built by fvm_to_reduced_encode_chunk.
+ *
+ * Decoded values v' are such that |v - v'| <= dq/2 for the original
+ * values v (up to rounding of the final multiply-add).
+ *
+ * parameters:
+ *   chunk        <-- pointer to chunk (header and payload)
+ *   component_id --> component id
+ *   section_id   --> mesh section id, or -1 for vertices
+ *   start_num    --> global number of first value
+ *   n_vals       --> number of values
+ *   vals         --> pointer to decoded values (allocated here, to be
+ *                    freed by the caller)
+ *
+ * returns:
+ *   size of chunk, in bytes
+ *----------------------------------------------------------------------------*/
+
+size_t
+fvm_to_reduced_decode_chunk(const unsigned char   *chunk,
+                            int                   *component_id,
+                            int                   *section_id,
+                            cs_gnum_t             *start_num,
+                            size_t                *n_vals,
+                            double               **vals)
+{
+  int32_t header_i[3];
+  uint64_t header_u[3];
+  double header_d[2];
+
+  memcpy(header_i, chunk, 3*4);
+  memcpy(header_u, chunk + 3*4, 3*8);
+  memcpy(header_d, chunk + 3*4 + 3*8, 2*8);
+
+  const int k = header_i[2];
+  const size_t n = header_u[1];
+  const double v_min = header_d[0], dq = header_d[1];
+
+  *component_id = header_i[0];
+  *section_id = header_i[1];
+  *start_num = header_u[0];
+  *n_vals = n;
+
+  double *_vals;
+  BFT_MALLOC(_vals, n, double);
+
+  const unsigned char *payload = chunk + _chunk_header_size;
+  size_t pos = 0;
+  int64_t q = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    uint64_t r_q = 0;
+    while (r_q < _RICE_ESCAPE && _get_bits(payload, &pos, 1) == 1)
+      r_q++;
+    uint64_t u;
+    if (r_q < _RICE_ESCAPE)
+      u = (r_q << k) | ((k > 0) ? _get_bits(payload, &pos, k) : 0);
+    else
+      u = _get_bits(payload, &pos, 64);
+    int64_t d = (u & 1) ? -(int64_t)((u + 1) >> 1) : (int64_t)(u >> 1);
+    q += d;
+    _vals[i] = v_min + (double)q*dq;
+  }
+
+  *vals = _vals;
+
+  return _chunk_header_size + header_u[2];
+}
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Initialize FVM to reduced (compressed) file writer.
+ *
+ * Options are:
+ *   abs_error=<e>       maximum absolute error on output values
+ *   rel_error=<e>       maximum error relative to the value range of each
+ *                       field component over the mesh (default: 1e-4)
+ *   sample_step=<n>     only output one value out of n (based on the
+ *                       global element or vertex numbering)
+ *
+ * parameters:
+ *   name           <-- base output case name.
+ *   options        <-- whitespace separated, lowercase options list
+ *   time_dependecy <-- indicates if and how meshes will change with time
+ *   comm           <-- associated MPI communicator.
+ *
+ * returns:
+ *   pointer to opaque reduced writer structure.
+ *----------------------------------------------------------------------------*/
+
+#if defined(HAVE_MPI)
+void *
+fvm_to_reduced_init_writer(const char             *name,
+                           const char             *path,
+                           const char             *options,
+                           fvm_writer_time_dep_t   time_dependency,
+                           MPI_Comm                comm)
+#else
+void *
+fvm_to_reduced_init_writer(const char             *name,
+                           const char             *path,
+                           const char             *options,
+                           fvm_writer_time_dep_t   time_dependency)
+#endif
+{
+  CS_UNUSED(time_dependency);
+
+  fvm_to_reduced_writer_t  *w = NULL;
+
+  /* Initialize writer */
+
+  BFT_MALLOC(w, 1, fvm_to_reduced_writer_t);
+
+  BFT_MALLOC(w->name, strlen(name) + 1, char);
+  strcpy(w->name, name);
+
+  if (path != NULL) {
+    BFT_MALLOC(w->path, strlen(path) + 1, char);
+    strcpy(w->path, path);
+  }
+  else {
+    BFT_MALLOC(w->path, 1, char);
+    w->path[0] = '\0';
+  }
+
+  w->rank = 0;
+  w->n_ranks = 1;
+
+#if defined(HAVE_MPI)
+  {
+    int mpi_flag, rank, n_ranks;
+    MPI_Comm w_block_comm, w_comm;
+    w->min_block_size = 0;
+    w->block_comm = MPI_COMM_NULL;
+    w->comm = MPI_COMM_NULL;
+    MPI_Initialized(&mpi_flag);
+    if (mpi_flag && comm != MPI_COMM_NULL) {
+      w->comm = comm;
+      MPI_Comm_rank(w->comm, &rank);
+      MPI_Comm_size(w->comm, &n_ranks);
+      w->rank = rank;
+      w->n_ranks = n_ranks;
+      cs_file_get_default_comm(NULL, &w_block_comm, &w_comm);
+      if (comm == w_comm) {
+        w->min_block_size = cs_parall_get_min_coll_buf_size();
+        w->block_comm = w_block_comm;
+      }
+    }
+  }
+#endif /* defined(HAVE_MPI) */
+
+  /* Defaults */
+
+  w->abs_error = -1;
+  w->rel_error = 1e-4;
+  w->sample_step = 1;
+
+  w->nt = -1;
+  w->t = -1;
+
+  /* Parse options */
+
+  if (options != NULL) {
+
+    int i1, i2;
+    int l_tot = strlen(options);
+
+    i1 = 0; i2 = 0;
+    while (i1 < l_tot) {
+
+      for (i2 = i1; i2 < l_tot && options[i2] != ' '; i2++);
+
+      if (strncmp(options + i1, "abs_error=", 10) == 0) {
+        const char *s = options + i1 + 10;
+        double e;
+        if (sscanf(s, "%lg", &e) == 1 && e > 0)
+          w->abs_error = e;
+      }
+      else if (strncmp(options + i1, "rel_error=", 10) == 0) {
+        const char *s = options + i1 + 10;
+        double e;
+        if (sscanf(s, "%lg", &e) == 1 && e >= 0) {
+          w->rel_error = e;
+          w->abs_error = -1;
+        }
+      }
+      else if (strncmp(options + i1, "sample_step=", 12) == 0) {
+        const char *s = options + i1 + 12;
+        int n;
+        if (sscanf(s, "%d", &n) == 1 && n > 0)
+          w->sample_step = n;
+      }
+
+      for (i1 = i2 + 1 ; i1 < l_tot && options[i1] == ' ' ; i1++);
+
+    }
+
+  }
+
+  /* Return writer */
+
+  return w;
+}
+
+/*----------------------------------------------------------------------------
+ * Finalize FVM to reduced file writer.
+ *
+ * parameters:
+ *   writer <-- pointer to opaque reduced writer structure.
+ *
+ * returns:
+ *   NULL pointer
+ *----------------------------------------------------------------------------*/
+
+void *
+fvm_to_reduced_finalize_writer(void  *writer)
+{
+  fvm_to_reduced_writer_t  *w
+    = (fvm_to_reduced_writer_t *)writer;
+
+  BFT_FREE(w->name);
+  BFT_FREE(w->path);
+
+  BFT_FREE(w);
+
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Associate new time step with a reduced writer.
+ *
+ * parameters:
+ *   writer     <-- pointer to associated writer
+ *   time_step  <-- time step number
+ *   time_value <-- time_value number
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_to_reduced_set_mesh_time(void    *writer,
+                             int      time_step,
+                             double   time_value)
+{
+  fvm_to_reduced_writer_t  *w = (fvm_to_reduced_writer_t *)writer;
+
+  w->nt = time_step;
+  w->t = time_value;
+}
+
+/*----------------------------------------------------------------------------
+ * Write field associated with a nodal mesh to a reduced file.
+ *
+ * Assigning a negative value to the time step indicates a time-independent
+ * field (in which case the time_value argument is unused).
+ *
+ * parameters:
+ *   writer           <-- pointer to associated writer
+ *   mesh             <-- pointer to associated nodal mesh structure
+ *   name             <-- variable name
+ *   location         <-- variable definition location (nodes or elements)
+ *   dimension        <-- variable dimension (0: constant, 1: scalar,
+ *                        3: vector, 6: sym. tensor, 9: asym. tensor)
+ *   interlace        <-- indicates if variable in memory is interlaced
+ *   n_parent_lists   <-- indicates if variable values are to be obtained
+ *                        directly through the local entity index (when 0) or
+ *                        through the parent entity numbers (when 1 or more)
+ *   parent_num_shift <-- parent number to value array index shifts;
+ *                        size: n_parent_lists
+ *   datatype         <-- indicates the data type of (source) field values
+ *   time_step        <-- number of the current time step
+ *   time_value       <-- associated time value
+ *   field_values     <-- array of associated field value arrays
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_to_reduced_export_field(void                  *writer,
+                            const fvm_nodal_t     *mesh,
+                            const char            *name,
+                            fvm_writer_var_loc_t   location,
+                            int                    dimension,
+                            cs_interlace_t         interlace,
+                            int                    n_parent_lists,
+                            const cs_lnum_t        parent_num_shift[],
+                            cs_datatype_t          datatype,
+                            int                    time_step,
+                            double                 time_value,
+                            const void      *const field_values[])
+{
+  fvm_to_reduced_writer_t  *w = (fvm_to_reduced_writer_t *)writer;
+
+  /* If time step changes, update it */
+
+  if (time_step != w->nt)
+    fvm_to_reduced_set_mesh_time(writer,
+                                 time_step,
+                                 time_value);
+
+  /* Build list of sections that are used here, in order of output;
+     sections are not grouped, so that each chunk refers to the global
+     element numbering of a given section */
+
+  int export_dim = fvm_nodal_get_max_entity_dim(mesh);
+
+  fvm_writer_section_t  *export_list
+    = fvm_writer_export_list(mesh,
+                             export_dim,
+                             export_dim,
+                             -1,
+                             false,
+                             false,
+                             false,
+                             false,
+                             false,
+                             false);
+
+  /* Initialize writer helper */
+
+  fvm_writer_field_helper_t  *helper
+    = fvm_writer_field_helper_create(mesh,
+                                     export_list,
+                                     dimension,
+                                     CS_NO_INTERLACE,
+                                     CS_DOUBLE,
+                                     location);
+
+#if defined(HAVE_MPI)
+
+  if (w->n_ranks > 1)
+    fvm_writer_field_helper_init_g(helper,
+                                   1,
+                                   w->min_block_size,
+                                   w->comm);
+
+#endif
+
+  _reduced_context_t c = {.writer = w, .f = NULL,
+                          .section_id = -1, .range = NULL};
+
+  BFT_MALLOC(c.range, 2*dimension, double);
+  for (int i = 0; i < dimension; i++) {
+    c.range[2*i] = HUGE_VAL;
+    c.range[2*i + 1] = -HUGE_VAL;
+  }
+
+  /* With a relative error bound, a first pass determines the global
+     range of each component */
+
+  if (w->abs_error <= 0) {
+
+    _output_field(helper, &c, mesh, export_list, location, dimension,
+                  interlace, n_parent_lists, parent_num_shift, datatype,
+                  field_values, _field_range);
+
+#if defined(HAVE_MPI)
+    if (w->n_ranks > 1) {
+      for (int i = 0; i < dimension; i++) {
+        c.range[2*i + 1] = -c.range[2*i + 1];
+      }
+      MPI_Allreduce(MPI_IN_PLACE, c.range, 2*dimension, MPI_DOUBLE, MPI_MIN,
+                    w->comm);
+      for (int i = 0; i < dimension; i++) {
+        c.range[2*i + 1] = -c.range[2*i + 1];
+      }
+    }
+#endif
+
+  }
+
+  c.f = _open_field_file(w, name, dimension, location);
+
+  _output_field(helper, &c, mesh, export_list, location, dimension,
+                interlace, n_parent_lists, parent_num_shift, datatype,
+                field_values, _field_output);
+
+  c.f = cs_file_free(c.f);
+
+  BFT_FREE(c.range);
+
+  /* Free helper structures */
+
+  fvm_writer_field_helper_destroy(&helper);
+
+  BFT_FREE(export_list);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -0,0 +1,242 @@
+#ifndef __FVM_TO_REDUCED_H__
+#define __FVM_TO_REDUCED_H__
+
+/*============================================================================
+ * Write variables associated with a nodal mesh to compressed files
+ * (lossy, error-bounded data reduction)
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "fvm_defs.h"
+#include "fvm_nodal.h"
+#include "fvm_writer.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*=============================================================================
+ * Semi-private function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Return the quantization step associated with an error bound.
+ *
+ * parameters:
+ *   abs_error <-- absolute error bound, or <= 0 for a relative bound
+ *   rel_error <-- error bound relative to the range [v_min, v_max]
+ *   v_min     <-- minimum value of the component (over the whole mesh)
+ *   v_max     <-- maximum value of the component (over the whole mesh)
+ *
+ * returns:
+ *   quantization step (twice the error bound)
+ *----------------------------------------------------------------------------*/
+
+double
+fvm_to_reduced_quantization_step(double  abs_error,
+                                 double  rel_error,
+                                 double  v_min,
+                                 double  v_max);
+
+/*----------------------------------------------------------------------------
+ * Compress a block of values of a given component into a chunk.
+ *
+ * If the range of values is too large for the requested quantization step
+ * (quantized values must fit in the mantissa of a double), the step is
+ * increased and a warning is printed (once).
+ *
+ * parameters:
+ *   component_id <-- component id
+ *   section_id   <-- mesh section id, or -1 for vertices
+ *   start_num    <-- global number of first value
+ *   dq           <-- quantization step (twice the error bound)
+ *   n_vals       <-- number of values
+ *   vals         <-- values
+ *   chunk        --> pointer to allocated chunk (header and payload),
+ *                    or NULL if n_vals = 0
+ *
+ * returns:
+ *   size of chunk, in bytes
+ *----------------------------------------------------------------------------*/
+
+size_t
+fvm_to_reduced_encode_chunk(int              component_id,
+                            int              section_id,
+                            cs_gnum_t        start_num,
+                            double           dq,
+                            size_t           n_vals,
+                            const double     vals[],
+                            unsigned char  **chunk);
+
+/*----------------------------------------------------------------------------
+ * Decode a chunk built by fvm_to_reduced_encode_chunk.
+ *
+ * Decoded values v' are such that |v - v'| <= dq/2 for the original
+ * values v (up to rounding of the final multiply-add).
+ *
+ * parameters:
+ *   chunk        <-- pointer to chunk (header and payload)
+ *   component_id --> component id
+ *   section_id   --> mesh section id, or -1 for vertices
+ *   start_num    --> global number of first value
+ *   n_vals       --> number of values
+ *   vals         --> pointer to decoded values (allocated here, to be
+ *                    freed by the caller)
+ *
+ * returns:
+ *   size of chunk, in bytes
+ *----------------------------------------------------------------------------*/
+
+size_t
+fvm_to_reduced_decode_chunk(const unsigned char   *chunk,
+                            int                   *component_id,
+                            int                   *section_id,
+                            cs_gnum_t             *start_num,
+                            size_t                *n_vals,
+                            double               **vals);
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Initialize FVM to reduced (compressed) file writer.
+ *
+ * Options are:
+ *   abs_error=<e>       maximum absolute error on output values
+ *   rel_error=<e>       maximum error relative to the value range of each
+ *                       field component over the mesh (default: 1e-4)
+ *   sample_step=<n>     only output one value out of n (based on the
+ *                       global element or vertex numbering)
+ *
+ * parameters:
+ *   name           <-- base output case name.
+ *   options        <-- whitespace separated, lowercase options list
+ *   time_dependecy <-- indicates if and how meshes will change with time
+ *   comm           <-- associated MPI communicator.
+ *
+ * returns:
+ *   pointer to opaque reduced writer structure.
+ *----------------------------------------------------------------------------*/
+
+#if defined(HAVE_MPI)
+void *
+fvm_to_reduced_init_writer(const char             *name,
+                           const char             *path,
+                           const char             *options,
+                           fvm_writer_time_dep_t   time_dependency,
+                           MPI_Comm                comm);
+#else
+void *
+fvm_to_reduced_init_writer(const char             *name,
+                           const char             *path,
+                           const char             *options,
+                           fvm_writer_time_dep_t   time_dependency);
+#endif
+
+/*----------------------------------------------------------------------------
+ * Finalize FVM to reduced file writer.
+ *
+ * parameters:
+ *   writer <-- pointer to opaque reduced writer structure.
+ *
+ * returns:
+ *   NULL pointer
+ *----------------------------------------------------------------------------*/
+
+void *
+fvm_to_reduced_finalize_writer(void  *writer);
+
+/*----------------------------------------------------------------------------
+ * Associate new time step with a reduced writer.
+ *
+ * parameters:
+ *   writer     <-- pointer to associated writer
+ *   time_step  <-- time step number
+ *   time_value <-- time_value number
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_to_reduced_set_mesh_time(void    *writer,
+                             int      time_step,
+                             double   time_value);
+
+/*----------------------------------------------------------------------------
+ * Write field associated with a nodal mesh to a reduced file.
+ *
+ * Assigning a negative value to the time step indicates a time-independent
+ * field (in which case the time_value argument is unused).
+ *
+ * parameters:
+ *   writer           <-- pointer to associated writer
+ *   mesh             <-- pointer to associated nodal mesh structure
+ *   name             <-- variable name
+ *   location         <-- variable definition location (nodes or elements)
+ *   dimension        <-- variable dimension (0: constant, 1: scalar,
+ *                        3: vector, 6: sym. tensor, 9: asym. tensor)
+ *   interlace        <-- indicates if variable in memory is interlaced
+ *   n_parent_lists   <-- indicates if variable values are to be obtained
+ *                        directly through the local entity index (when 0) or
+ *                        through the parent entity numbers (when 1 or more)
+ *   parent_num_shift <-- parent number to value array index shifts;
+ *                        size: n_parent_lists
+ *   datatype         <-- indicates the data type of (source) field values
+ *   time_step        <-- number of the current time step
+ *   time_value       <-- associated time value
+ *   field_values     <-- array of associated field value arrays
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_to_reduced_export_field(void                  *writer,
+                            const fvm_nodal_t     *mesh,
+                            const char            *name,
+                            fvm_writer_var_loc_t   location,
+                            int                    dimension,
+                            cs_interlace_t         interlace,
+                            int                    n_parent_lists,
+                            const cs_lnum_t        parent_num_shift[],
+                            cs_datatype_t          datatype,
+                            int                    time_step,
+                            double                 time_value,
+                            const void      *const field_values[]);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __FVM_TO_REDUCED_H__ */
@@ -182,9 +182,11 @@ _coords_output(void           *context,
 
   BFT_MALLOC(file_name, l, char);
 
+  /* Coordinates are output as CSV for the binary format */
+
   if (w->format == CS_TIME_PLOT_DAT)
     sprintf(file_name, "%scoords%s.dat", w->prefix, t_stamp);
-  else if (w->format == CS_TIME_PLOT_CSV)
+  else
     sprintf(file_name, "%scoords%s.csv", w->prefix, t_stamp);
 
   _f = fopen(file_name, "w");
@@ -239,7 +241,7 @@ _coords_output(void           *context,
 
   /* CSV format */
 
-  else if (w->format == CS_TIME_PLOT_CSV) {
+  else {
 
     switch(dimension) {
     case 3:
@@ -400,6 +402,8 @@ _field_output(void           *context,
  * Options are:
  *   csv                 output CSV (comma-separated-values) files
  *   dat                 output dat (space-separated) files
+ *   bin                 output binary files (values buffered in memory
+ *                       and written by blocks of columns)
  *   use_iteration       use time step id instead of time value for
  *                       first column
  *   flush_wtime=<wt>    flush output file every 'wt' seconds
@@ -501,6 +505,8 @@ fvm_to_time_plot_init_writer(const char             *name,
         w->format = CS_TIME_PLOT_CSV;
       else if ((l_opt == 3) && (strncmp(options + i1, "dat", l_opt) == 0))
         w->format = CS_TIME_PLOT_DAT;
+      else if ((l_opt == 3) && (strncmp(options + i1, "bin", l_opt) == 0))
+        w->format = CS_TIME_PLOT_BIN;
       else if ((l_opt == 13) && (strcmp(options + i1, "use_iteration") == 0))
         w->use_iteration = true;
       else if (strncmp(options + i1, "n_buf_steps=", 12) == 0) {
@@ -60,6 +60,8 @@ BEGIN_C_DECLS
  * Options are:
  *   csv                 output CSV (comma-separated-values) files
  *   dat                 output dat (space-separated) files
+ *   bin                 output binary files (values buffered in memory
+ *                       and written by blocks of columns)
  *   use_iteration       use time step id instead of time value for
  *                       first column
  *   flush_wtime=<wt>    flush output file every 'wt' seconds
@@ -71,6 +71,7 @@
 #include "fvm_to_ensight.h"
 #include "fvm_to_histogram.h"
 #include "fvm_to_plot.h"
+#include "fvm_to_reduced.h"
 #include "fvm_to_time_plot.h"
 
 #if defined(HAVE_CATALYST) && !defined(HAVE_PLUGIN_CATALYST)
@@ -107,9 +108,9 @@ BEGIN_C_DECLS
 
 /* Number and status of defined formats */
 
-static const int _fvm_writer_n_formats = 10;
+static const int _fvm_writer_n_formats = 11;
 
-static fvm_writer_format_t _fvm_writer_format_list[10] = {
+static fvm_writer_format_t _fvm_writer_format_list[11] = {
 
   /* Built-in EnSight Gold writer */
   {
@@ -413,6 +414,30 @@ static fvm_writer_format_t _fvm_writer_format_list[10] = {
     NULL                               /* flush_func */
   },
 
+  /* Built-in reduced (compressed) data writer */
+  {
+    "reduced",
+    "",
+    (  FVM_WRITER_FORMAT_HAS_POLYGON
+     | FVM_WRITER_FORMAT_HAS_POLYHEDRON
+     | FVM_WRITER_FORMAT_SEPARATE_MESHES),
+    FVM_WRITER_TRANSIENT_CONNECT,
+    0,                                 /* dynamic library count */
+    0,                                 /* dynamic library flags */
+    NULL,                              /* dynamic library */
+    NULL,                              /* dynamic library name */
+    NULL,                              /* dynamic library prefix */
+    NULL,                              /* n_version_strings_func */
+    NULL,                              /* version_string_func */
+    fvm_to_reduced_init_writer,        /* init_func */
+    fvm_to_reduced_finalize_writer,    /* finalize_func */
+    fvm_to_reduced_set_mesh_time,      /* set_mesh_time_func */
+    NULL,                              /* needs_tesselation_func */
+    NULL,                              /* export_nodal_func */
+    fvm_to_reduced_export_field,       /* export_field_func */
+    NULL                               /* flush_func */
+  },
+
   /* CCM-IO writer */
   {
     "CCM-IO",
@@ -1109,6 +1134,7 @@ fvm_writer_filter_option(char        *format_options,
  *   divide_polyhedra    tesselate polyhedra with tetrahedra and pyramids
  *                       (adding a vertex near each polyhedron's center)
  *   separate_meshes     use a different writer for each mesh
+ *   rank_files          each rank writes its own case (EnSight)
  *
  * parameters:
  *   name            <-- base name of output
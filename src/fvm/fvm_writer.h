@@ -219,6 +219,7 @@ fvm_writer_filter_option(char        *format_options,
  *   divide_polyhedra    tesselate polyhedra with tetrahedra and pyramids
  *                       (adding a vertex near each polyhedron's center)
  *   separate_meshes     use a different writer for each mesh
+ *   rank_files          each rank writes its own case (EnSight)
  *
  * parameters:
  *   name            <-- base name of output
@@ -67,6 +67,7 @@
 #include "cs_parameters.h"
 #include "cs_prototypes.h"
 #include "cs_time_step.h"
+#include "cs_timer.h"
 #include "cs_physical_constants.h"
 #include "cs_thermal_model.h"
 #include "cs_turbulence_model.h"
@@ -88,8 +89,10 @@
 #include "cs_lagr_clogging.h"
 #include "cs_lagr_injection.h"
 #include "cs_lagr_aux_mean_fluid_quantities.h"
+#include "cs_lagr_balance.h"
 #include "cs_lagr_car.h"
 #include "cs_lagr_coupling.h"
+#include "cs_lagr_locate.h"
 #include "cs_lagr_new.h"
 #include "cs_lagr_particle.h"
 #include "cs_lagr_resuspension.h"
@@ -1197,6 +1200,14 @@ cs_lagr_finalize(void)
 
   cs_lagr_stat_finalize();
 
+  /* Load balance estimation */
+
+  cs_lagr_balance_finalize();
+
+  /* Point location structures */
+
+  cs_lagr_locate_finalize();
+
   /* Also close log file (TODO move this) */
 
   cs_lagr_print_finalize();
@@ -1863,6 +1874,8 @@ cs_lagr_solve_time_step(const int         itypfb[],
   cs_lagr_extra_module_t *extra = cs_glob_lagr_extra_module;
   cs_lagr_particle_counter_t *part_c = cs_lagr_get_particle_counter();
 
+  double t_start = cs_timer_wtime();
+
   cs_lnum_t n_b_faces = mesh->n_b_faces;
 
   cs_lnum_t *ifabor = mesh->b_face_cells;
@@ -2331,6 +2344,14 @@ cs_lagr_solve_time_step(const int         itypfb[],
 
       /* Integration of SDEs: position, fluid and particle velocity */
 
+      bool sde_soa = (   cs_lagr_get_integration_layout()
+                      == CS_LAGR_PARTICLE_SOA
+                      && (   lagr_model->deposition <= 0
+                          || cs_glob_lagr_time_scheme->t_order > 1));
+
+      if (sde_soa)
+        cs_lagr_particle_set_layout(p_set, CS_LAGR_PARTICLE_SOA);
+
       cs_lagr_sde(cs_glob_lagr_time_step->dtp,
                   (const cs_real_t *)taup,
                   (const cs_real_3_t *)tlag,
@@ -2344,6 +2365,9 @@ cs_lagr_solve_time_step(const int         itypfb[],
                   beta,
                   &nresnew);
 
+      if (sde_soa)
+        cs_lagr_particle_set_layout(p_set, CS_LAGR_PARTICLE_AOS);
+
       /* Integration of SDEs for orientation of spheroids without inertia */
       if (lagr_model->shape == CS_LAGR_SHAPE_SPHEROID_STOC_MODEL) {
         cs_lagr_orientation_dyn_spheroids(iprev,
@@ -2664,8 +2688,11 @@ cs_lagr_solve_time_step(const int         itypfb[],
       }
 
       if (   cs_glob_lagr_time_step->nor == cs_glob_lagr_time_scheme->t_order
-          && cs_glob_time_step->nt_cur >= cs_glob_lagr_stat_options->idstnt)
+          && cs_glob_time_step->nt_cur >= cs_glob_lagr_stat_options->idstnt) {
+        cs_lagr_particle_set_layout(p_set, cs_lagr_get_integration_layout());
         cs_lagr_stat_update();
+        cs_lagr_particle_set_layout(p_set, CS_LAGR_PARTICLE_AOS);
+      }
 
       /* Statistics for clogging */
 
@@ -2766,6 +2793,10 @@ cs_lagr_solve_time_step(const int         itypfb[],
   part_c->n_g_cumulative_total += part_c->n_g_new;
   part_c->n_g_cumulative_failed += part_c->n_g_failed;
 
+  /* Particle load measurement for partitioning */
+
+  cs_lagr_balance_update(p_set, t_start);
+
   /* Logging
      ------- */
 
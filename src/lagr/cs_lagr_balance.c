@@ -0,0 +1,279 @@
+/*============================================================================
+ * Lagrangian particle load balance estimation
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+
+#include "cs_base.h"
+#include "cs_log.h"
+#include "cs_mesh.h"
+#include "cs_parall.h"
+#include "cs_partition.h"
+#include "cs_timer.h"
+
+#include "cs_lagr_particle.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_balance.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_balance.c
+        Lagrangian particle load balance estimation.
+
+When particles are concentrated in a small part of the domain (for example
+near injection zones), partitioning the mesh based only on the number of
+cells leads to a Lagrangian time step limited by the most loaded ranks.
+
+Cells may not be migrated during a computation, so this module measures
+the per-cell particle load and the relative cost of particles over a
+computation, and provides matching cell weights for the partitioning
+of a subsequent (restart) computation.
+
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static bool        _active = false;
+
+static int         _n_samples = 0;      /* number of sampled time steps */
+static cs_lnum_t   _n_cells = 0;        /* number of cells for counts */
+static cs_real_t  *_cell_count = NULL;  /* cumulative particle count
+                                           per cell */
+
+static double      _t_lagr = 0.;        /* cumulative Lagrangian step time */
+static double      _t_total = 0.;       /* cumulative time step time */
+static double      _t_prev = -1.;       /* end of previous Lagrangian step */
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or deactivate particle load balance estimation.
+ *
+ * When active, per-cell particle counts and the time spent in the
+ * Lagrangian time step are accumulated at each time step, and cell
+ * weights for subsequent partitionings are written with each Lagrangian
+ * checkpoint (see \ref cs_partition_write_cell_weights).
+ *
+ * \param[in]  active  true to activate, false to deactivate
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_set_active(bool  active)
+{
+  _active = active;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Indicate if particle load balance estimation is active.
+ *
+ * \return true if active, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_balance_is_active(void)
+{
+  return _active;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Accumulate particle load data for the current time step.
+ *
+ * This function should be called at the end of each Lagrangian time step.
+ *
+ * \param[in]  p_set         pointer to particle set
+ * \param[in]  t_lagr_start  wall-clock time at start of Lagrangian step
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_update(const cs_lagr_particle_set_t  *p_set,
+                       double                         t_lagr_start)
+{
+  if (_active == false)
+    return;
+
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+
+  if (_cell_count == NULL) {
+    _n_cells = n_cells;
+    BFT_MALLOC(_cell_count, n_cells, cs_real_t);
+    for (cs_lnum_t i = 0; i < n_cells; i++)
+      _cell_count[i] = 0.;
+  }
+
+  assert(_n_cells == n_cells);
+
+  for (cs_lnum_t i = 0; i < p_set->n_particles; i++) {
+    cs_lnum_t c_id = cs_lagr_particles_get_lnum(p_set, i, CS_LAGR_CELL_ID);
+    if (c_id > -1 && c_id < n_cells)
+      _cell_count[c_id] += 1.;
+  }
+
+  _n_samples += 1;
+
+  /* The first time step is used only to start timing, as it
+     includes initialization costs and its start time is unknown */
+
+  double t_end = cs_timer_wtime();
+
+  if (_t_prev >= 0) {
+    _t_lagr += t_end - t_lagr_start;
+    _t_total += t_end - _t_prev;
+  }
+
+  _t_prev = t_end;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log load imbalance and write particle-based cell weights.
+ *
+ * Cell weights are based on a cost model where a cell's weight is 1
+ * plus its mean number of particles times the measured ratio of the
+ * cost of a particle to that of a cell.
+ *
+ * This function is collective over all ranks.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_write_cell_weights(void)
+{
+  if (_active == false || _n_samples == 0)
+    return;
+
+  const cs_mesh_t *mesh = cs_glob_mesh;
+  const cs_lnum_t n_cells = mesh->n_cells;
+
+  /* Global timings and particle counts */
+
+  double n_part = 0;
+  for (cs_lnum_t i = 0; i < _n_cells; i++)
+    n_part += _cell_count[i];
+  n_part /= _n_samples;
+
+  double g_sum[3] = {_t_lagr, _t_total, n_part};
+  double t_lagr_max = _t_lagr;
+
+  cs_parall_sum(3, CS_DOUBLE, g_sum);
+  cs_parall_max(1, CS_DOUBLE, &t_lagr_max);
+
+  double t_lagr = g_sum[0], t_fluid = g_sum[1] - g_sum[0];
+  double n_g_part = g_sum[2];
+
+  /* Ratio of the cost of a particle to that of a cell */
+
+  double p_cost = 0.;
+  if (n_g_part > 0 && t_fluid > 0)
+    p_cost = (t_lagr / t_fluid) * ((double)(mesh->n_g_cells) / n_g_part);
+
+  double t_lagr_mean = t_lagr / cs_glob_n_ranks;
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("\nLagrangian load balance:\n\n"
+                  "  mean number of particles:         %12.5g\n"
+                  "  Lagrangian time fraction:         %12.5g\n"
+                  "  Lagrangian time max/mean:         %12.5g\n"
+                  "  particle/cell relative cost:      %12.5g\n"),
+                n_g_part,
+                (g_sum[1] > 0) ? t_lagr / g_sum[1] : 0.,
+                (t_lagr_mean > 0) ? t_lagr_max / t_lagr_mean : 1.,
+                p_cost);
+  cs_log_separator(CS_LOG_PERFORMANCE);
+
+  /* Cell weights */
+
+  cs_real_t *cell_weight;
+  BFT_MALLOC(cell_weight, n_cells, cs_real_t);
+
+  const double w_mult = p_cost / _n_samples;
+
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    cell_weight[i] = 1. + w_mult*_cell_count[i];
+
+  cs_partition_write_cell_weights(mesh, cell_weight);
+
+  BFT_FREE(cell_weight);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free particle load balance estimation data.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_finalize(void)
+{
+  BFT_FREE(_cell_count);
+
+  _n_cells = 0;
+  _n_samples = 0;
+  _t_lagr = 0.;
+  _t_total = 0.;
+  _t_prev = -1.;
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
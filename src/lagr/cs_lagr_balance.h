@@ -0,0 +1,116 @@
+#ifndef __CS_LAGR_BALANCE_H__
+#define __CS_LAGR_BALANCE_H__
+
+/*============================================================================
+ * Lagrangian particle load balance estimation
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include "cs_lagr_particle.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or deactivate particle load balance estimation.
+ *
+ * When active, per-cell particle counts and the time spent in the
+ * Lagrangian time step are accumulated at each time step, and cell
+ * weights for subsequent partitionings are written with each Lagrangian
+ * checkpoint (see \ref cs_partition_write_cell_weights).
+ *
+ * \param[in]  active  true to activate, false to deactivate
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_set_active(bool  active);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Indicate if particle load balance estimation is active.
+ *
+ * \return true if active, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_balance_is_active(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Accumulate particle load data for the current time step.
+ *
+ * This function should be called at the end of each Lagrangian time step.
+ *
+ * \param[in]  p_set         pointer to particle set
+ * \param[in]  t_lagr_start  wall-clock time at start of Lagrangian step
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_update(const cs_lagr_particle_set_t  *p_set,
+                       double                         t_lagr_start);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log load imbalance and write particle-based cell weights.
+ *
+ * Cell weights are based on a cost model where a cell's weight is 1
+ * plus its mean number of particles times the measured ratio of the
+ * cost of a particle to that of a cell.
+ *
+ * This function is collective over all ranks.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_write_cell_weights(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free particle load balance estimation data.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_balance_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_BALANCE_H__ */
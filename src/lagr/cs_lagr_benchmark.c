@@ -0,0 +1,1025 @@
+/*============================================================================
+ * Lagrangian particle tracking benchmarking
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_base.h"
+#include "cs_boundary_zone.h"
+#include "cs_field.h"
+#include "cs_file.h"
+#include "cs_log.h"
+#include "cs_math.h"
+#include "cs_mesh.h"
+#include "cs_mesh_adjacencies.h"
+#include "cs_mesh_cartesian.h"
+#include "cs_mesh_quantities.h"
+#include "cs_parall.h"
+#include "cs_random.h"
+#include "cs_time_step.h"
+#include "cs_timer.h"
+
+#include "cs_lagr.h"
+#include "cs_lagr_event.h"
+#include "cs_lagr_particle.h"
+#include "cs_lagr_sde.h"
+#include "cs_lagr_stat.h"
+#include "cs_lagr_tracking.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_benchmark.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_benchmark.c
+        Lagrangian particle tracking benchmarking.
+
+This benchmark is run by the solver when the \c --benchmark-lagr command-line
+option is given. Unless a mesh input is present, a Cartesian mesh is
+generated for this purpose.
+
+Particles are seeded in the mesh either with the same number of particles
+in each cell, or following a gaussian cluster centered on the domain (which
+leads to high load imbalance in parallel), and are then moved in a synthetic
+rotating flow with turbulent dispersion, with symmetry conditions
+on all boundaries. For each distribution, the following stages are timed,
+and their throughput is logged as particles per second per core
+(i.e. per thread of each MPI rank):
+
+- integration of the stochastic differential equations (\ref cs_lagr_sde);
+- tracking, including exchange of particles between ranks
+  (\ref cs_lagr_tracking_particle_movement);
+- accumulation of the mean particle velocity and cumulative weight
+  statistics (\ref cs_lagr_stat_update).
+
+Conversions of the particle data layout are not included in timings.
+
+In parallel, the "Total" throughput is based on the slowest rank, so
+its ratio to the mean throughput measures the effect of load imbalance.
+
+The following options may follow \c --benchmark-lagr to modify the
+benchmark settings:
+
+- \c --mesh-cells \<n\>: number of cells in each direction of
+  the default Cartesian mesh (default: 32);
+- \c --particles-per-cell \<n\>: mean number of particles per
+  cell (default: 8);
+- \c --cfl \<x\>: mean particle displacement per time step
+  relative to the mean cell size (default: 0.5);
+- \c --layout \<aos|soa\>: particle data layout used for the
+  integration and statistics stages (default: aos).
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local macro definitions
+ *============================================================================*/
+
+#define CS_LAGR_BENCHMARK_MESH_NAME "lagr_benchmark"
+
+/*=============================================================================
+ * Local type definitions
+ *============================================================================*/
+
+/* Particle seeding distributions */
+
+typedef enum {
+
+  CS_LAGR_BENCHMARK_UNIFORM,      /* same number of particles in each cell */
+  CS_LAGR_BENCHMARK_CLUSTERED,    /* gaussian cluster at domain center */
+
+  CS_LAGR_BENCHMARK_N_DISTRIBUTIONS
+
+} cs_lagr_benchmark_distribution_t;
+
+/* Synthetic flow definition */
+
+typedef struct {
+
+  cs_real_t  center[3];   /* domain center */
+  cs_real_t  length;      /* domain size */
+
+  cs_real_t  dt;          /* time step */
+  cs_real_t  tau;         /* particle relaxation time */
+  cs_real_t  t_lag;       /* fluid Lagrangian integral time */
+  cs_real_t  sigma;       /* velocity fluctuation amplitude */
+
+} cs_lagr_benchmark_flow_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static const char *_distribution_name[] = {N_("uniform"),
+                                           N_("clustered")};
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Return the random stream key associated with a cell.
+ *
+ * The global cell number is used, so that seeded particles do not depend
+ * on the mesh partitioning.
+ *
+ * parameters:
+ *   m       <-- pointer to mesh
+ *   cell_id <-- cell id
+ *
+ * returns:
+ *   random stream key
+ *----------------------------------------------------------------------------*/
+
+static inline uint64_t
+_cell_key(const cs_mesh_t  *m,
+          cs_lnum_t         cell_id)
+{
+  if (m->global_cell_num != NULL)
+    return (uint64_t)(m->global_cell_num[cell_id]);
+  else
+    return (uint64_t)(cell_id + 1);
+}
+
+/*----------------------------------------------------------------------------
+ * Compute the synthetic fluid velocity at a given point.
+ *
+ * This is a solid body rotation around the domain's z axis, with unit
+ * velocity at a distance of half the domain size.
+ *
+ * parameters:
+ *   flow <-- synthetic flow definition
+ *   x    <-- point coordinates
+ *   u    --> fluid velocity
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_fluid_velocity(const cs_lagr_benchmark_flow_t  *flow,
+                const cs_real_t                  x[3],
+                cs_real_t                        u[3])
+{
+  const cs_real_t f = 2. / flow->length;
+
+  u[0] = - f * (x[1] - flow->center[1]);
+  u[1] =   f * (x[0] - flow->center[0]);
+  u[2] = 0.;
+}
+
+/*----------------------------------------------------------------------------
+ * Define the synthetic flow based on the mesh extents.
+ *
+ * parameters:
+ *   cfl  <-- mean particle displacement per time step relative
+ *            to mean cell size
+ *   flow --> synthetic flow definition
+ *----------------------------------------------------------------------------*/
+
+static void
+_define_flow(cs_real_t                  cfl,
+             cs_lagr_benchmark_flow_t  *flow)
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+
+  cs_real_t extents[6] = {HUGE_VAL, HUGE_VAL, HUGE_VAL,
+                          -HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+
+  for (cs_lnum_t i = 0; i < m->n_vertices; i++) {
+    for (int j = 0; j < 3; j++) {
+      extents[j] = CS_MIN(extents[j], m->vtx_coord[i*3 + j]);
+      extents[j+3] = CS_MAX(extents[j+3], m->vtx_coord[i*3 + j]);
+    }
+  }
+
+  cs_parall_min(3, CS_REAL_TYPE, extents);
+  cs_parall_max(3, CS_REAL_TYPE, extents + 3);
+
+  cs_real_t tot_vol = 0.;
+  for (cs_lnum_t i = 0; i < m->n_cells; i++)
+    tot_vol += mq->cell_vol[i];
+
+  cs_parall_sum(1, CS_REAL_TYPE, &tot_vol);
+
+  flow->length = 0.;
+  for (int j = 0; j < 3; j++) {
+    flow->center[j] = 0.5*(extents[j] + extents[j+3]);
+    flow->length = CS_MAX(flow->length, extents[j+3] - extents[j]);
+  }
+
+  /* Velocity scale is 1, so the time step is based on the mean cell size */
+
+  cs_real_t h = cbrt(tot_vol / m->n_g_cells);
+
+  flow->dt = cfl * h;
+  flow->tau = 0.1 * flow->length;
+  flow->t_lag = 0.5 * flow->tau;
+  flow->sigma = 0.2;
+}
+
+/*----------------------------------------------------------------------------
+ * Define minimal Lagrangian structures required for the benchmark stages.
+ *
+ * A first-order scheme with turbulent dispersion is used, without
+ * change of reference frame (which would require the mean particle
+ * velocity). The synthetic fluid velocity is stored in a cell-based
+ * field, with its constant gradient, and the mean particle velocity and
+ * cumulative weight statistics are activated.
+ *
+ * All boundary faces are handled as symmetries.
+ *
+ * parameters:
+ *   flow <-- synthetic flow definition
+ *----------------------------------------------------------------------------*/
+
+static void
+_setup_lagr(const cs_lagr_benchmark_flow_t  *flow)
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_lnum_t n_cells = m->n_cells;
+  const cs_lnum_t n_cells_ext = m->n_cells_with_ghosts;
+  const cs_real_3_t *cell_cen
+    = (const cs_real_3_t *)cs_glob_mesh_quantities->cell_cen;
+
+  cs_glob_lagr_time_scheme->t_order = 1;
+  cs_glob_lagr_time_scheme->interpol_field = 1;
+  cs_glob_lagr_time_scheme->isttio = 1;
+
+  cs_glob_lagr_model->idistu = 1;
+  cs_glob_lagr_model->modcpl = 0;
+  cs_glob_lagr_model->deposition = 0;
+
+  cs_glob_lagr_time_step->nor = 1;
+  cs_glob_lagr_time_step->dtp = flow->dt;
+
+  cs_lagr_particle_attr_initialize();
+  cs_lagr_event_initialize();
+
+  cs_lagr_zone_data_t *bcs = cs_lagr_get_boundary_conditions();
+
+  for (int z_id = 0; z_id < bcs->n_zones; z_id++)
+    bcs->zone_type[z_id] = CS_LAGR_SYM;
+
+  BFT_REALLOC(bcs->elt_type, m->n_b_faces, char);
+
+  for (cs_lnum_t i = 0; i < m->n_b_faces; i++)
+    bcs->elt_type[i] = CS_LAGR_SYM;
+
+  cs_lagr_tracking_initialize();
+
+  /* Fluid velocity and statistics fields; as in the main setup,
+     all fields are allocated and zeroed together. */
+
+  cs_lagr_extra_module_t *extra = cs_get_lagr_extra_module();
+
+  extra->vel = cs_field_create("lagr_benchmark_velocity",
+                               CS_FIELD_INTENSIVE,
+                               CS_MESH_LOCATION_CELLS,
+                               3,
+                               false);
+
+  cs_lagr_stat_activate(CS_LAGR_STAT_CUMULATIVE_WEIGHT);
+  cs_lagr_stat_activate_attr(CS_LAGR_VELOCITY);
+
+  cs_lagr_stat_initialize();
+
+  cs_field_allocate_or_map_all();
+
+  for (int f_id = 0; f_id < cs_field_n_fields(); f_id++)
+    cs_field_set_values(cs_field_by_id(f_id), 0.);
+
+  cs_real_3_t *vel = (cs_real_3_t *)extra->vel->val;
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    _fluid_velocity(flow, cell_cen[c_id], vel[c_id]);
+
+  const cs_real_t f = 2. / flow->length;
+
+  BFT_MALLOC(extra->grad_pr, n_cells_ext, cs_real_3_t);
+  BFT_MALLOC(extra->grad_vel, n_cells_ext, cs_real_33_t);
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells_ext; c_id++) {
+    for (int i = 0; i < 3; i++) {
+      extra->grad_pr[c_id][i] = 0.;
+      for (int j = 0; j < 3; j++)
+        extra->grad_vel[c_id][i][j] = 0.;
+    }
+    extra->grad_vel[c_id][0][1] = -f;
+    extra->grad_vel[c_id][1][0] = f;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Seed particles in the local mesh.
+ *
+ * Each particle is placed at a random point of a random sub-tetrahedron
+ * of its cell, defined by the cell center, the center of an adjacent face,
+ * and one of this face's edges.
+ *
+ * parameters:
+ *   p_set        <-> particle set
+ *   distribution <-- particle distribution type
+ *   flow         <-- synthetic flow definition
+ *   c2f          <-- cells to faces adjacency (boundary faces first)
+ *   n_per_cell   <-- mean number of particles per cell
+ *----------------------------------------------------------------------------*/
+
+static void
+_seed_particles(cs_lagr_particle_set_t            *p_set,
+                cs_lagr_benchmark_distribution_t   distribution,
+                const cs_lagr_benchmark_flow_t    *flow,
+                const cs_adjacency_t              *c2f,
+                int                                n_per_cell)
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+
+  const cs_lnum_t n_cells = m->n_cells;
+  const cs_lnum_t n_b_faces = m->n_b_faces;
+  const cs_real_3_t *cell_cen = (const cs_real_3_t *)mq->cell_cen;
+  const cs_real_3_t *vtx_coord = (const cs_real_3_t *)m->vtx_coord;
+
+  /* Number of particles per cell */
+
+  cs_lnum_t *cell_p_idx;
+  BFT_MALLOC(cell_p_idx, n_cells + 1, cs_lnum_t);
+
+  cell_p_idx[0] = 0;
+
+  if (distribution == CS_LAGR_BENCHMARK_UNIFORM) {
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+      cell_p_idx[c_id + 1] = n_per_cell;
+  }
+
+  else {
+
+    /* Gaussian density, with a standard deviation of 1/10th
+       of the domain size; counts are rounded stochastically so
+       that the global number of particles is preserved on average. */
+
+    const cs_real_t s = 0.1 * flow->length;
+    const cs_real_t c_exp = -0.5 / (s*s);
+    const cs_real_t n_target = (cs_real_t)n_per_cell * m->n_g_cells;
+
+    cs_real_t *w;
+    BFT_MALLOC(w, n_cells, cs_real_t);
+
+    cs_real_t w_sum = 0.;
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      cs_real_t d2 = cs_math_3_square_distance(cell_cen[c_id], flow->center);
+      w[c_id] = exp(c_exp * d2) * mq->cell_vol[c_id];
+      w_sum += w[c_id];
+    }
+
+    cs_parall_sum(1, CS_REAL_TYPE, &w_sum);
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      cs_real_t r;
+      cs_random_counter_uniform(_cell_key(m, c_id), 0, 1, &r);
+      cell_p_idx[c_id + 1] = (cs_lnum_t)(n_target * w[c_id] / w_sum + r);
+    }
+
+    BFT_FREE(w);
+
+  }
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    cell_p_idx[c_id + 1] += cell_p_idx[c_id];
+
+  const cs_lnum_t n_particles = cell_p_idx[n_cells];
+
+  p_set->n_particles = 0;
+  p_set->weight = 0.;
+
+  cs_lagr_particle_set_resize(n_particles);
+
+  p_set->n_particles = n_particles;
+  p_set->n_part_new = 0;
+  p_set->weight = n_particles;
+
+  /* Initialize particles */
+
+  const cs_lagr_attribute_map_t *p_am = p_set->p_am;
+
+  const cs_real_t d_p = 1e-5;
+  const cs_real_t m_p = 1000. * cs_math_pi / 6. * d_p*d_p*d_p;
+
+  assert(p_set->layout == CS_LAGR_PARTICLE_AOS);
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+
+    const uint64_t key = _cell_key(m, c_id);
+    const cs_lnum_t s_id = c2f->idx[c_id];
+    const cs_lnum_t n_c_faces = c2f->idx[c_id + 1] - s_id;
+
+    for (cs_lnum_t p_id = cell_p_idx[c_id];
+         p_id < cell_p_idx[c_id + 1];
+         p_id++) {
+
+      cs_real_t r[5];
+      cs_random_counter_uniform(key, p_id - cell_p_idx[c_id] + 1, 5, r);
+
+      /* Select sub-tetrahedron */
+
+      cs_lnum_t f_id
+        = c2f->ids[s_id + CS_MIN((cs_lnum_t)(r[0]*n_c_faces), n_c_faces - 1)];
+
+      const cs_real_t *f_cog;
+      const cs_lnum_t *f_vtx;
+      cs_lnum_t n_f_vtx;
+
+      if (f_id < n_b_faces) {
+        f_cog = mq->b_face_cog + f_id*3;
+        f_vtx = m->b_face_vtx_lst + m->b_face_vtx_idx[f_id];
+        n_f_vtx = m->b_face_vtx_idx[f_id + 1] - m->b_face_vtx_idx[f_id];
+      }
+      else {
+        f_id -= n_b_faces;
+        f_cog = mq->i_face_cog + f_id*3;
+        f_vtx = m->i_face_vtx_lst + m->i_face_vtx_idx[f_id];
+        n_f_vtx = m->i_face_vtx_idx[f_id + 1] - m->i_face_vtx_idx[f_id];
+      }
+
+      cs_lnum_t e_id = CS_MIN((cs_lnum_t)(r[1]*n_f_vtx), n_f_vtx - 1);
+      const cs_real_t *v0 = vtx_coord[f_vtx[e_id]];
+      const cs_real_t *v1 = vtx_coord[f_vtx[(e_id + 1) % n_f_vtx]];
+
+      /* Uniform sampling of tetrahedron by folding of the unit cube */
+
+      cs_real_t s = r[2], t = r[3], u = r[4];
+
+      if (s + t > 1.) {
+        s = 1. - s;
+        t = 1. - t;
+      }
+      if (t + u > 1.) {
+        cs_real_t tmp = u;
+        u = 1. - s - t;
+        t = 1. - tmp;
+      }
+      else if (s + t + u > 1.) {
+        cs_real_t tmp = u;
+        u = s + t + u - 1.;
+        s = 1. - t - tmp;
+      }
+
+      const cs_real_t a = 1. - s - t - u;
+
+      unsigned char *particle = p_set->p_buffer + p_am->extents * p_id;
+
+      memset(particle, 0, p_am->extents);
+
+      cs_real_t *x = cs_lagr_particle_attr(particle, p_am, CS_LAGR_COORDS);
+      for (int j = 0; j < 3; j++)
+        x[j] = a*cell_cen[c_id][j] + s*f_cog[j] + t*v0[j] + u*v1[j];
+
+      cs_real_t *v = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY);
+      cs_real_t *v_s
+        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY_SEEN);
+
+      _fluid_velocity(flow, x, v);
+      for (int j = 0; j < 3; j++)
+        v_s[j] = v[j];
+
+      cs_lagr_particle_set_lnum(particle, p_am, CS_LAGR_CELL_ID, c_id);
+
+      cs_lagr_particle_set_real(particle, p_am, CS_LAGR_STAT_WEIGHT, 1.);
+      cs_lagr_particle_set_real(particle, p_am, CS_LAGR_DIAMETER, d_p);
+      cs_lagr_particle_set_real(particle, p_am, CS_LAGR_MASS, m_p);
+
+      /* Also sets the previous rank id */
+
+      cs_lagr_particles_current_to_previous(p_set, p_id);
+
+    }
+
+  }
+
+  BFT_FREE(cell_p_idx);
+}
+
+/*----------------------------------------------------------------------------
+ * Compute particle characteristic times and turbulence characteristics
+ * for the synthetic flow.
+ *
+ * In the main time step, these values are computed by cs_lagr_car.
+ * Here, the diffusion coefficient is such that the variance of the
+ * velocity seen by particles is sigma^2.
+ *
+ * parameters:
+ *   p_set <-- particle set
+ *   flow  <-- synthetic flow definition
+ *   taup  --> particle relaxation time
+ *   tlag  --> fluid Lagrangian integral time
+ *   bx    --> turbulence characteristics
+ *----------------------------------------------------------------------------*/
+
+static void
+_sde_coefficients(const cs_lagr_particle_set_t    *p_set,
+                  const cs_lagr_benchmark_flow_t  *flow,
+                  cs_real_t                        taup[],
+                  cs_real_3_t                      tlag[],
+                  cs_real_33_t                     bx[])
+{
+  const cs_lnum_t n_particles = p_set->n_particles;
+
+  const cs_real_t b = flow->sigma * sqrt(2. / flow->t_lag);
+
+# pragma omp parallel for if (n_particles > CS_THR_MIN)
+  for (cs_lnum_t p_id = 0; p_id < n_particles; p_id++) {
+    taup[p_id] = flow->tau;
+    for (int j = 0; j < 3; j++) {
+      tlag[p_id][j] = flow->t_lag;
+      for (int k = 0; k < 3; k++)
+        bx[p_id][j][k] = b;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Integrate particle stochastic differential equations over one time step.
+ *
+ * As in the main time step, current values are first copied to previous
+ * values.
+ *
+ * parameters:
+ *   p_set <-> particle set
+ *   flow  <-- synthetic flow definition
+ *   taup  <-- particle relaxation time
+ *   tlag  <-- fluid Lagrangian integral time
+ *   piil  <-- term in integration of velocity seen (per cell)
+ *   bx    <-- turbulence characteristics
+ *----------------------------------------------------------------------------*/
+
+static void
+_integrate_step(cs_lagr_particle_set_t          *p_set,
+                const cs_lagr_benchmark_flow_t  *flow,
+                const cs_real_t                  taup[],
+                const cs_real_3_t                tlag[],
+                const cs_real_3_t                piil[],
+                const cs_real_33_t               bx[])
+{
+  const cs_lnum_t n_particles = p_set->n_particles;
+
+  const cs_lagr_extra_module_t *extra = cs_glob_lagr_extra_module;
+
+# pragma omp parallel for if (n_particles > CS_THR_MIN)
+  for (cs_lnum_t p_id = 0; p_id < n_particles; p_id++)
+    cs_lagr_particles_current_to_previous(p_set, p_id);
+
+  cs_lnum_t nresnew = 0;
+
+  cs_lagr_sde(flow->dt,
+              taup,
+              tlag,
+              piil,
+              bx,
+              NULL,    /* tsfext */
+              (const cs_real_3_t *)extra->grad_pr,
+              (const cs_real_33_t *)extra->grad_vel,
+              NULL,    /* terbru */
+              NULL,    /* vislen */
+              NULL,    /* beta */
+              &nresnew);
+}
+
+/*----------------------------------------------------------------------------
+ * Count particles received from other ranks during the last tracking stage.
+ *
+ * parameters:
+ *   p_set <-- particle set
+ *
+ * returns:
+ *   number of local particles whose previous rank is another rank
+ *----------------------------------------------------------------------------*/
+
+static cs_gnum_t
+_count_migrated(const cs_lagr_particle_set_t  *p_set)
+{
+  cs_gnum_t n_migrated = 0;
+
+  if (cs_glob_n_ranks > 1) {
+    for (cs_lnum_t p_id = 0; p_id < p_set->n_particles; p_id++) {
+      if (   cs_lagr_particles_get_lnum_n(p_set, p_id, 1, CS_LAGR_RANK_ID)
+          != cs_glob_rank_id)
+        n_migrated++;
+    }
+  }
+
+  return n_migrated;
+}
+
+/*----------------------------------------------------------------------------
+ * Print throughput statistics for a given stage.
+ *
+ * parameters:
+ *   name    <-- stage name
+ *   n_runs  <-- number of runs
+ *   n_p_ops <-- local number of particles handled, summed over runs
+ *   wt      <-- local wall-clock time, summed over runs
+ *----------------------------------------------------------------------------*/
+
+static void
+_print_stats(const char  *name,
+             int          n_runs,
+             long         n_p_ops,
+             double       wt)
+{
+  const int n_threads = cs_glob_n_threads;
+
+  double tp = n_p_ops / (CS_MAX(wt, 1e-12) * n_threads);
+
+  cs_log_printf(CS_LOG_PERFORMANCE, "\n  %s\n", name);
+
+  if (cs_glob_n_ranks == 1)
+    cs_log_printf(CS_LOG_PERFORMANCE,
+                  "    Particles:         %12ld\n"
+                  "    Wall clock:        %12.5e\n"
+                  "    Particles/s/core:  %12.5e\n",
+                  n_p_ops/n_runs, wt/n_runs, tp);
+
+#if defined(HAVE_MPI)
+
+  else {
+
+    long n_ops_min, n_ops_max, n_ops_tot;
+    double loc_count[2], glob_sum[2], glob_min[2], glob_max[2];
+
+    loc_count[0] = wt;
+    loc_count[1] = tp;
+
+    MPI_Allreduce(&n_p_ops, &n_ops_min, 1, MPI_LONG, MPI_MIN,
+                  cs_glob_mpi_comm);
+    MPI_Allreduce(&n_p_ops, &n_ops_max, 1, MPI_LONG, MPI_MAX,
+                  cs_glob_mpi_comm);
+    MPI_Allreduce(&n_p_ops, &n_ops_tot, 1, MPI_LONG, MPI_SUM,
+                  cs_glob_mpi_comm);
+
+    MPI_Allreduce(loc_count, glob_min, 2, MPI_DOUBLE, MPI_MIN,
+                  cs_glob_mpi_comm);
+    MPI_Allreduce(loc_count, glob_max, 2, MPI_DOUBLE, MPI_MAX,
+                  cs_glob_mpi_comm);
+    MPI_Allreduce(loc_count, glob_sum, 2, MPI_DOUBLE, MPI_SUM,
+                  cs_glob_mpi_comm);
+
+    /* Global throughput, based on slowest rank */
+
+    double tpg =   n_ops_tot
+                 / (  CS_MAX(glob_max[0], 1e-12)
+                    * n_threads * cs_glob_n_ranks);
+
+    cs_log_printf
+      (CS_LOG_PERFORMANCE,
+       "                         Mean         Min          Max          Total\n"
+       "    Particles:         %12ld %12ld %12ld %12ld\n"
+       "    Wall clock:        %12.5e %12.5e %12.5e\n"
+       "    Particles/s/core:  %12.5e %12.5e %12.5e %12.5e\n",
+       n_ops_tot/cs_glob_n_ranks/n_runs, n_ops_min/n_runs, n_ops_max/n_runs,
+       n_ops_tot/n_runs,
+       glob_sum[0]/cs_glob_n_ranks/n_runs, glob_min[0]/n_runs,
+       glob_max[0]/n_runs,
+       glob_sum[1]/cs_glob_n_ranks, glob_min[1], glob_max[1], tpg);
+
+  }
+
+#endif
+
+  cs_log_printf_flush(CS_LOG_PERFORMANCE);
+}
+
+/*----------------------------------------------------------------------------
+ * Run benchmark stages for a given particle distribution.
+ *
+ * parameters:
+ *   distribution <-- particle distribution type
+ *   flow         <-- synthetic flow definition
+ *   c2f          <-- cells to faces adjacency (boundary faces first)
+ *   n_per_cell   <-- mean number of particles per cell
+ *   layout       <-- particle layout for integration and statistics
+ *   t_measure    <-- minimum measurement time, or < 0 for single run
+ *----------------------------------------------------------------------------*/
+
+static void
+_run_distribution(cs_lagr_benchmark_distribution_t   distribution,
+                  const cs_lagr_benchmark_flow_t    *flow,
+                  const cs_adjacency_t              *c2f,
+                  int                                n_per_cell,
+                  cs_lagr_particle_layout_t          layout,
+                  double                             t_measure)
+{
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+
+  cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
+
+  {
+    char title[81];
+    snprintf(title, 80, _("Particle distribution: %s"),
+             _(_distribution_name[distribution]));
+    title[80] = '\0';
+
+    size_t l = strlen(title);
+    char underline[81];
+    memset(underline, '-', l);
+    underline[l] = '\0';
+
+    cs_log_printf(CS_LOG_PERFORMANCE, "\n%s\n%s\n", title, underline);
+  }
+
+  _seed_particles(p_set, distribution, flow, c2f, n_per_cell);
+
+  cs_gnum_t n_g_particles[2] = {p_set->n_particles, 0};
+
+  cs_real_t *taup = NULL;
+  cs_real_3_t *tlag = NULL, *piil = NULL;
+  cs_real_33_t *bx = NULL;
+
+  BFT_MALLOC(piil, n_cells, cs_real_3_t);
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    for (int j = 0; j < 3; j++)
+      piil[c_id][j] = 0.;
+  }
+
+  /* Time stages; the number of runs must be the same on all ranks,
+     as the tracking stage involves communication. */
+
+  long n_p_ops[3] = {0, 0, 0};
+  double wt[3] = {0., 0., 0.};
+  cs_gnum_t n_migrated = 0;
+
+  int run_id = 0;
+  int n_runs = (t_measure > 0) ? 4 : 1;
+
+  double wt0 = cs_timer_wtime();
+
+  while (run_id < n_runs) {
+
+    while (run_id < n_runs) {
+
+      cs_time_step_increment(flow->dt);
+
+      const cs_lnum_t n_particles = p_set->n_particles;
+
+      BFT_REALLOC(taup, n_particles, cs_real_t);
+      BFT_REALLOC(tlag, n_particles, cs_real_3_t);
+      BFT_REALLOC(bx, n_particles, cs_real_33_t);
+
+      _sde_coefficients(p_set, flow, taup, tlag, bx);
+
+      cs_lagr_particle_set_layout(p_set, layout);
+
+      double t0 = cs_timer_wtime();
+
+      n_p_ops[0] += n_particles;
+
+      _integrate_step(p_set, flow,
+                      taup,
+                      (const cs_real_3_t *)tlag,
+                      (const cs_real_3_t *)piil,
+                      (const cs_real_33_t *)bx);
+
+      double t1 = cs_timer_wtime();
+
+      cs_lagr_particle_set_layout(p_set, CS_LAGR_PARTICLE_AOS);
+
+      double t2 = cs_timer_wtime();
+
+      n_p_ops[1] += p_set->n_particles;
+
+      cs_lagr_tracking_particle_movement(NULL);
+
+      double t3 = cs_timer_wtime();
+
+      n_migrated += _count_migrated(p_set);
+
+      cs_lagr_particle_set_layout(p_set, layout);
+
+      double t4 = cs_timer_wtime();
+
+      n_p_ops[2] += p_set->n_particles;
+
+      cs_lagr_stat_prepare();
+      cs_lagr_stat_update();
+
+      double t5 = cs_timer_wtime();
+
+      cs_lagr_particle_set_layout(p_set, CS_LAGR_PARTICLE_AOS);
+
+      wt[0] += t1 - t0;
+      wt[1] += t3 - t2;
+      wt[2] += t5 - t4;
+
+      run_id++;
+    }
+
+    double wt1 = cs_timer_wtime() - wt0;
+    cs_parall_max(1, CS_DOUBLE, &wt1);
+
+    if (wt1 < t_measure)
+      n_runs *= 2;
+  }
+
+  BFT_FREE(bx);
+  BFT_FREE(tlag);
+  BFT_FREE(taup);
+  BFT_FREE(piil);
+
+  /* Log results */
+
+  n_g_particles[1] = p_set->n_particles;
+  cs_parall_counter(n_g_particles, 2);
+  cs_parall_counter(&n_migrated, 1);
+
+  const int stat_type = cs_lagr_stat_type_from_attr_id(CS_LAGR_VELOCITY);
+
+  const cs_field_t *f_w = cs_lagr_stat_get_stat_weight(0);
+  const cs_field_t *f_v
+    = cs_lagr_stat_get_moment(stat_type,
+                              CS_LAGR_STAT_GROUP_PARTICLE,
+                              CS_LAGR_MOMENT_MEAN,
+                              0,
+                              -1);
+
+  cs_real_t test_sum = 0.;
+  if (f_w != NULL && f_v != NULL) {
+    const cs_real_3_t *c_v = (const cs_real_3_t *)f_v->val;
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+      test_sum += f_w->val[c_id] * cs_math_3_norm(c_v[c_id]);
+  }
+  cs_parall_sum(1, CS_REAL_TYPE, &test_sum);
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                "\n"
+                "  Particles (initial/final): %llu / %llu\n"
+                "  Time steps:                %d\n"
+                "  Migrated particles/step:   %12.5e\n"
+                "  (test sum: %12.5e)\n",
+                (unsigned long long)n_g_particles[0],
+                (unsigned long long)n_g_particles[1],
+                n_runs,
+                (double)n_migrated / n_runs,
+                test_sum);
+
+  _print_stats(_("Stochastic integration"), n_runs, n_p_ops[0], wt[0]);
+  _print_stats(_("Tracking and exchange"), n_runs, n_p_ops[1], wt[1]);
+  _print_stats(_("Cell statistics"), n_runs, n_p_ops[2], wt[2]);
+
+  p_set->n_particles = 0;
+  p_set->weight = 0.;
+
+  cs_lagr_particle_set_shrink();
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define a default Cartesian mesh for the Lagrangian benchmark.
+ *
+ * The mesh is only defined if no "mesh_input.csm" or "mesh_input" file
+ * or directory is present, so that the benchmark may also be run on
+ * an existing mesh.
+ *
+ * This function must be called before mesh definitions are finalized.
+ *
+ * \param[in]  n_cells  number of cells in each direction
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_benchmark_define_mesh(int  n_cells)
+{
+  if (   cs_file_isreg("mesh_input.csm")
+      || cs_file_isreg("mesh_input")
+      || cs_file_isdir("mesh_input"))
+    return;
+
+  int n_cells_dir[3] = {n_cells, n_cells, n_cells};
+  cs_real_t xyz[6] = {0., 0., 0., 1., 1., 1.};
+
+  cs_mesh_cartesian_define_simple(CS_LAGR_BENCHMARK_MESH_NAME,
+                                  n_cells_dir,
+                                  xyz);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Run Lagrangian particle stage benchmarks.
+ *
+ * Particles are seeded in the mesh using several distributions, and
+ * the throughput of stochastic integration, tracking (including exchange
+ * between ranks), and cell statistics stages is logged.
+ *
+ * \param[in]  mpi_trace_mode  indicates if timing mode (0) or MPI
+ *                             trace-friendly mode (1) is to be used
+ * \param[in]  n_per_cell      mean number of particles per cell
+ * \param[in]  cfl             mean particle displacement per time step
+ *                             relative to the mean cell size
+ * \param[in]  layout          particle data layout used for the
+ *                             integration and statistics stages
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_benchmark(int                        mpi_trace_mode,
+                  int                        n_per_cell,
+                  double                     cfl,
+                  cs_lagr_particle_layout_t  layout)
+{
+  double t_measure = (mpi_trace_mode) ? -1.0 : 2.0;
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                "\n"
+                "Lagrangian benchmark mode activated\n"
+                "===================================\n\n"
+                "  MPI ranks:                 %d\n"
+                "  Threads per rank:          %d\n"
+                "  Cells:                     %llu\n"
+                "  Particles per cell:        %d\n"
+                "  Particle CFL:              %g\n"
+                "  Integration layout:        %s\n",
+                cs_glob_n_ranks, cs_glob_n_threads,
+                (unsigned long long)cs_glob_mesh->n_g_cells,
+                n_per_cell, cfl,
+                (layout == CS_LAGR_PARTICLE_SOA) ? "SoA" : "AoS");
+
+  cs_lagr_benchmark_flow_t flow;
+  _define_flow(cfl, &flow);
+
+  _setup_lagr(&flow);
+
+  cs_adjacency_t *c2f = cs_mesh_adjacency_c2f(cs_glob_mesh, 0);
+
+  for (int d = 0; d < CS_LAGR_BENCHMARK_N_DISTRIBUTIONS; d++)
+    _run_distribution(d, &flow, c2f, n_per_cell, layout, t_measure);
+
+  cs_adjacency_destroy(&c2f);
+
+  /* Particle set and tracking structures are freed with other
+     Lagrangian structures. */
+
+  cs_log_separator(CS_LOG_PERFORMANCE);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
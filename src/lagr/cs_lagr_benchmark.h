@@ -0,0 +1,91 @@
+#ifndef __CS_LAGR_BENCHMARK_H__
+#define __CS_LAGR_BENCHMARK_H__
+
+/*============================================================================
+ * Lagrangian particle tracking benchmarking
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include "cs_lagr_particle.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define a default Cartesian mesh for the Lagrangian benchmark.
+ *
+ * The mesh is only defined if no "mesh_input.csm" or "mesh_input" file
+ * or directory is present, so that the benchmark may also be run on
+ * an existing mesh.
+ *
+ * This function must be called before mesh definitions are finalized.
+ *
+ * \param[in]  n_cells  number of cells in each direction
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_benchmark_define_mesh(int  n_cells);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Run Lagrangian particle stage benchmarks.
+ *
+ * Particles are seeded in the mesh using several distributions, and
+ * the throughput of stochastic integration, tracking (including exchange
+ * between ranks), and cell statistics stages is logged.
+ *
+ * \param[in]  mpi_trace_mode  indicates if timing mode (0) or MPI
+ *                             trace-friendly mode (1) is to be used
+ * \param[in]  n_per_cell      mean number of particles per cell
+ * \param[in]  cfl             mean particle displacement per time step
+ *                             relative to the mean cell size
+ * \param[in]  layout          particle data layout used for the
+ *                             integration and statistics stages
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_benchmark(int                        mpi_trace_mode,
+                  int                        n_per_cell,
+                  double                     cfl,
+                  cs_lagr_particle_layout_t  layout);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_BENCHMARK_H__ */
@@ -62,6 +62,7 @@
 
 #include "cs_lagr.h"
 #include "cs_lagr_particle.h"
+#include "cs_lagr_tracking.h"
 
 /*----------------------------------------------------------------------------
  *  Header for the current file
@@ -85,6 +86,81 @@ static const cs_real_t  _c_stephan = 5.6703e-8;
 
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the particle range handled by the current thread for
+ *        cell-based accumulations.
+ *
+ * Particles indexed by cell (i.e. sorted by the last displacement step)
+ * are split in contiguous chunks aligned on cell boundaries in a first
+ * pass, so that threads update disjoint sets of cells. Particles appended
+ * since are handled by the first thread only in a second pass; the caller
+ * must synchronize threads between both passes.
+ *
+ * Each cell value is thus accumulated in the same order as with a serial
+ * loop on particles, so results do not depend on the number of threads.
+ *
+ * \param[in]   cell_idx     index of particles by cell, or NULL
+ * \param[in]   n_cells      number of cells
+ * \param[in]   n_particles  number of particles
+ * \param[in]   pass_id      0 for indexed particles, 1 for others
+ * \param[out]  s_id         start id of particle range
+ * \param[out]  e_id         past-the-end id of particle range
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_thread_particle_range(const cs_lnum_t   cell_idx[],
+                       cs_lnum_t         n_cells,
+                       cs_lnum_t         n_particles,
+                       int               pass_id,
+                       cs_lnum_t        *s_id,
+                       cs_lnum_t        *e_id)
+{
+  const cs_lnum_t n_sorted = (cell_idx != NULL) ? cell_idx[n_cells] : 0;
+
+  int t_id = 0, n_t = 1;
+
+#if defined(HAVE_OPENMP)
+  t_id = omp_get_thread_num();
+  n_t = omp_get_num_threads();
+#endif
+
+  if (pass_id == 1) {
+    *s_id = n_sorted;
+    *e_id = (t_id == 0) ? n_particles : n_sorted;
+    return;
+  }
+
+  cs_lnum_t b_id[2] = {0, 0};
+
+  for (int i = 0; i < 2 && n_sorted > 0; i++) {
+
+    /* Move bound to the start of the first cell beyond it */
+
+    cs_lnum_t bound = ((int64_t)n_sorted * (t_id + i)) / n_t;
+    cs_lnum_t c_s = 0, c_e = n_cells;
+
+    while (c_s < c_e) {
+      cs_lnum_t c_mid = (c_s + c_e) / 2;
+      if (cell_idx[c_mid] < bound)
+        c_s = c_mid + 1;
+      else
+        c_e = c_mid;
+    }
+
+    b_id[i] = cell_idx[c_s];
+
+  }
+
+  *s_id = b_id[0];
+  *e_id = b_id[1];
+}
+
 /*============================================================================
  * Public function definitions
  *============================================================================*/
@@ -149,6 +225,11 @@ cs_lagr_coupling(const cs_real_t  taup[],
   cs_lnum_t ncel = cs_glob_mesh->n_cells;
   cs_lnum_t nbpart = p_set->n_particles;
 
+  /* Particles sorted by cell by the last displacement step allow
+     threaded accumulation of cell-based source terms */
+
+  const cs_lnum_t *cell_idx = cs_lagr_tracking_get_cell_particle_index(ncel);
+
   cs_real_t dtp = cs_glob_lagr_time_step->dtp;
 
   cs_lnum_t ntersl = cs_glob_lagr_dim->ntersl;
@@ -240,33 +321,44 @@ cs_lagr_coupling(const cs_real_t  taup[],
         t_st_vel[i][j] = 0;
     }
 
-    for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+    #pragma omp parallel if (nbpart > CS_THR_MIN)
+    for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+      cs_lnum_t s_id, e_id;
+      _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                             &s_id, &e_id);
 
-      cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
-                                                      CS_LAGR_STAT_WEIGHT);
+      for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
 
-      cs_real_t  prev_p_diam = cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                           CS_LAGR_DIAMETER);
-      cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                           CS_LAGR_MASS);
-      cs_real_t  p_mass = cs_lagr_particle_get_real(particle, p_am,
-                                                    CS_LAGR_MASS);
+        unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+
+        cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
+                                                        CS_LAGR_STAT_WEIGHT);
+
+        cs_real_t  prev_p_diam = cs_lagr_particle_get_real_n(particle, p_am, 1,
+                                                             CS_LAGR_DIAMETER);
+        cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n(particle, p_am, 1,
+                                                             CS_LAGR_MASS);
+        cs_real_t  p_mass = cs_lagr_particle_get_real(particle, p_am,
+                                                      CS_LAGR_MASS);
 
-      cs_lnum_t iel = cs_lagr_particle_get_lnum(particle, p_am, CS_LAGR_CELL_ID);
+        cs_lnum_t iel = cs_lagr_particle_get_lnum(particle, p_am,
+                                                  CS_LAGR_CELL_ID);
 
-      /* Volume and mass of particles in cell */
-      volp[iel] += p_stat_w * cs_math_pi * pow(prev_p_diam, 3) / 6.0;
-      volm[iel] += p_stat_w * prev_p_mass;
+        /* Volume and mass of particles in cell */
+        volp[iel] += p_stat_w * cs_math_pi * pow(prev_p_diam, 3) / 6.0;
+        volm[iel] += p_stat_w * prev_p_mass;
 
-      /* Momentum source term */
-      t_st_vel[iel][0] += - auxl1[npt];
-      t_st_vel[iel][1] += - auxl2[npt];
-      t_st_vel[iel][2] += - auxl3[npt];
-      tslag[iel + (lag_st->itsli-1) * ncelet]
-        += - 2.0 * p_stat_w * p_mass / taup[npt];
+        /* Momentum source term */
+        t_st_vel[iel][0] += - auxl1[npt];
+        t_st_vel[iel][1] += - auxl2[npt];
+        t_st_vel[iel][2] += - auxl3[npt];
+        tslag[iel + (lag_st->itsli-1) * ncelet]
+          += - 2.0 * p_stat_w * p_mass / taup[npt];
 
+      }
+
+      #pragma omp barrier
     }
 
   /* Turbulence source terms
@@ -279,25 +371,36 @@ cs_lagr_coupling(const cs_real_t  taup[],
          (difficult to write something for v2, which loses its meaning as
          "Rij comonent") */
 
-      for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+      #pragma omp parallel if (nbpart > CS_THR_MIN)
+      for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-        unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+        cs_lnum_t s_id, e_id;
+        _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                               &s_id, &e_id);
+
+        for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
+
+          unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
 
-        cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
-                                                           CS_LAGR_CELL_ID);
-        cs_real_t *prev_f_vel  = cs_lagr_particle_attr_n(particle, p_am, 1,
+          cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
+                                                             CS_LAGR_CELL_ID);
+          cs_real_t *prev_f_vel
+            = cs_lagr_particle_attr_n(particle, p_am, 1,
+                                      CS_LAGR_VELOCITY_SEEN);
+          cs_real_t *f_vel       = cs_lagr_particle_attr(particle, p_am,
                                                          CS_LAGR_VELOCITY_SEEN);
-        cs_real_t *f_vel       = cs_lagr_particle_attr(particle, p_am,
-                                                       CS_LAGR_VELOCITY_SEEN);
 
-        cs_real_t uuf = 0.5 * (prev_f_vel[0] + f_vel[0]);
-        cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
-        cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
+          cs_real_t uuf = 0.5 * (prev_f_vel[0] + f_vel[0]);
+          cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
+          cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
 
-        tslag[iel + (lag_st->itske-1) * ncelet] += - uuf * auxl1[npt]
-                                                   - vvf * auxl2[npt]
-                                                   - wwf * auxl3[npt];
+          tslag[iel + (lag_st->itske-1) * ncelet] += - uuf * auxl1[npt]
+                                                     - vvf * auxl2[npt]
+                                                     - wwf * auxl3[npt];
 
+        }
+
+        #pragma omp barrier
       }
 
       for (cs_lnum_t iel = 0; iel < ncel; iel++)
@@ -319,29 +422,40 @@ cs_lagr_coupling(const cs_real_t  taup[],
           t_st_rij[i][j] = 0;
       }
 
-      for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+      #pragma omp parallel if (nbpart > CS_THR_MIN)
+      for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-        unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+        cs_lnum_t s_id, e_id;
+        _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                               &s_id, &e_id);
+
+        for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
+
+          unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
 
-        cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
-                                                           CS_LAGR_CELL_ID);
+          cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
+                                                             CS_LAGR_CELL_ID);
 
-        cs_real_t *prev_f_vel  = cs_lagr_particle_attr_n(particle, p_am, 1,
+          cs_real_t *prev_f_vel
+            = cs_lagr_particle_attr_n(particle, p_am, 1,
+                                      CS_LAGR_VELOCITY_SEEN);
+          cs_real_t *f_vel       = cs_lagr_particle_attr(particle, p_am,
                                                          CS_LAGR_VELOCITY_SEEN);
-        cs_real_t *f_vel       = cs_lagr_particle_attr(particle, p_am,
-                                                       CS_LAGR_VELOCITY_SEEN);
 
-        cs_real_t uuf = 0.5 * (prev_f_vel[0] + f_vel[0]);
-        cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
-        cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
+          cs_real_t uuf = 0.5 * (prev_f_vel[0] + f_vel[0]);
+          cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
+          cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
 
-        t_st_rij[iel][0] += - 2.0 * uuf * auxl1[npt];
-        t_st_rij[iel][1] += - 2.0 * vvf * auxl2[npt];
-        t_st_rij[iel][2] += - 2.0 * wwf * auxl3[npt];
-        t_st_rij[iel][3] += - uuf * auxl2[npt] - vvf * auxl1[npt];
-        t_st_rij[iel][4] += - vvf * auxl3[npt] - wwf * auxl2[npt];
-        t_st_rij[iel][5] += - uuf * auxl3[npt] - wwf * auxl1[npt];
+          t_st_rij[iel][0] += - 2.0 * uuf * auxl1[npt];
+          t_st_rij[iel][1] += - 2.0 * vvf * auxl2[npt];
+          t_st_rij[iel][2] += - 2.0 * wwf * auxl3[npt];
+          t_st_rij[iel][3] += - uuf * auxl2[npt] - vvf * auxl1[npt];
+          t_st_rij[iel][4] += - vvf * auxl3[npt] - wwf * auxl2[npt];
+          t_st_rij[iel][5] += - uuf * auxl3[npt] - wwf * auxl1[npt];
 
+        }
+
+        #pragma omp barrier
       }
       for (cs_lnum_t iel = 0; iel < ncel; iel++) {
 
@@ -376,24 +490,34 @@ cs_lagr_coupling(const cs_real_t  taup[],
       && (   cs_glob_lagr_specific_physics->impvar == 1
           || cs_glob_lagr_specific_physics->idpvar == 1)) {
 
-    for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+    #pragma omp parallel if (nbpart > CS_THR_MIN)
+    for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+      cs_lnum_t s_id, e_id;
+      _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                             &s_id, &e_id);
 
-      cs_real_t  p_stat_w
-        = cs_lagr_particle_get_real(particle, p_am, CS_LAGR_STAT_WEIGHT);
-      cs_real_t  prev_p_mass
-        = cs_lagr_particle_get_real_n(particle, p_am, 1, CS_LAGR_MASS);
-      cs_real_t  p_mass
-        = cs_lagr_particle_get_real_n(particle, p_am, 0, CS_LAGR_MASS);
+      for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
+
+        unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
 
-      /* Fluid mass source term > 0 -> add mass to fluid */
-      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
-                                                    CS_LAGR_CELL_ID);
+        cs_real_t  p_stat_w
+          = cs_lagr_particle_get_real(particle, p_am, CS_LAGR_STAT_WEIGHT);
+        cs_real_t  prev_p_mass
+          = cs_lagr_particle_get_real_n(particle, p_am, 1, CS_LAGR_MASS);
+        cs_real_t  p_mass
+          = cs_lagr_particle_get_real_n(particle, p_am, 0, CS_LAGR_MASS);
 
-      tslag[cell_id + (lag_st->itsmas-1) * ncelet]
-        += - p_stat_w * (p_mass - prev_p_mass) / dtp;
+        /* Fluid mass source term > 0 -> add mass to fluid */
+        cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
+                                                      CS_LAGR_CELL_ID);
+
+        tslag[cell_id + (lag_st->itsmas-1) * ncelet]
+          += - p_stat_w * (p_mass - prev_p_mass) / dtp;
+
+      }
 
+      #pragma omp barrier
     }
 
   }
@@ -406,55 +530,77 @@ cs_lagr_coupling(const cs_real_t  taup[],
     if (   cs_glob_lagr_model->physical_model == CS_LAGR_PHYS_HEAT
         && cs_glob_lagr_specific_physics->itpvar == 1) {
 
-      for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+      #pragma omp parallel if (nbpart > CS_THR_MIN)
+      for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-        unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
-        cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
-                                                   CS_LAGR_CELL_ID);
-        cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                        CS_LAGR_MASS);
-        cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                             CS_LAGR_MASS);
-        cs_real_t  p_cp = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                      CS_LAGR_CP);
-        cs_real_t  prev_p_cp = cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                           CS_LAGR_CP);
-        cs_real_t  p_tmp = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                       CS_LAGR_TEMPERATURE);
-        cs_real_t  prev_p_tmp = cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                            CS_LAGR_TEMPERATURE);
-        cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
-                                                        CS_LAGR_STAT_WEIGHT);
+        cs_lnum_t s_id, e_id;
+        _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                               &s_id, &e_id);
 
-        tslag[iel + (lag_st->itste-1) * ncelet]
-          += - (p_mass * p_tmp * p_cp
-             - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
-        tslag[iel + (lag_st->itsti-1) * ncelet]
-          += tempct[nbpart + npt] * p_stat_w;
-
-      }
-      if (extra->radiative_model > 0) {
-
-        for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
+        for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
 
           unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
           cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
                                                      CS_LAGR_CELL_ID);
-          cs_real_t  p_diam = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                          CS_LAGR_DIAMETER);
-          cs_real_t  p_eps = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                         CS_LAGR_EMISSIVITY);
+          cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                          CS_LAGR_MASS);
+          cs_real_t  prev_p_mass
+            = cs_lagr_particle_get_real_n(particle, p_am, 1, CS_LAGR_MASS);
+          cs_real_t  p_cp = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                        CS_LAGR_CP);
+          cs_real_t  prev_p_cp = cs_lagr_particle_get_real_n(particle, p_am, 1,
+                                                             CS_LAGR_CP);
           cs_real_t  p_tmp = cs_lagr_particle_get_real_n(particle, p_am, 0,
                                                          CS_LAGR_TEMPERATURE);
+          cs_real_t  prev_p_tmp
+            = cs_lagr_particle_get_real_n(particle, p_am, 1,
+                                          CS_LAGR_TEMPERATURE);
           cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
                                                           CS_LAGR_STAT_WEIGHT);
 
-          cs_real_t aux1 = cs_math_pi * p_diam * p_diam * p_eps
-                          * (extra->luminance->val[iel]
-                             - 4.0 * _c_stephan * cs_math_pow4(p_tmp));
+          tslag[iel + (lag_st->itste-1) * ncelet]
+            += - (p_mass * p_tmp * p_cp
+               - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
+          tslag[iel + (lag_st->itsti-1) * ncelet]
+            += tempct[nbpart + npt] * p_stat_w;
 
-          tslag[iel + (lag_st->itste-1) * ncelet] += aux1 * p_stat_w;
+        }
 
+        #pragma omp barrier
+      }
+      if (extra->radiative_model > 0) {
+
+        #pragma omp parallel if (nbpart > CS_THR_MIN)
+        for (int pass_id = 0; pass_id < 2; pass_id++) {
+
+          cs_lnum_t s_id, e_id;
+          _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                                 &s_id, &e_id);
+
+          for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
+
+            unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+            cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
+                                                       CS_LAGR_CELL_ID);
+            cs_real_t  p_diam = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                            CS_LAGR_DIAMETER);
+            cs_real_t  p_eps = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                           CS_LAGR_EMISSIVITY);
+            cs_real_t  p_tmp = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                           CS_LAGR_TEMPERATURE);
+            cs_real_t  p_stat_w
+              = cs_lagr_particle_get_real(particle, p_am,
+                                          CS_LAGR_STAT_WEIGHT);
+
+            cs_real_t aux1 = cs_math_pi * p_diam * p_diam * p_eps
+                            * (extra->luminance->val[iel]
+                               - 4.0 * _c_stephan * cs_math_pow4(p_tmp));
+
+            tslag[iel + (lag_st->itste-1) * ncelet] += aux1 * p_stat_w;
+
+          }
+
+          #pragma omp barrier
         }
 
       }
@@ -467,45 +613,55 @@ cs_lagr_coupling(const cs_real_t  taup[],
 
       else {
 
-        for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
-
-          unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
-
-          cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
-                                                     CS_LAGR_CELL_ID);
-          cs_lnum_t icha = cs_lagr_particle_get_lnum(particle, p_am,
-                                                     CS_LAGR_COAL_ID);
+        #pragma omp parallel if (nbpart > CS_THR_MIN)
+        for (int pass_id = 0; pass_id < 2; pass_id++) {
 
-          cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                          CS_LAGR_MASS);
-          cs_real_t  p_tmp = cs_lagr_particle_get_real(particle, p_am,
-                                                       CS_LAGR_TEMPERATURE);
-          cs_real_t  p_cp = cs_lagr_particle_get_real_n(particle, p_am, 0,
-                                                        CS_LAGR_CP);
+          cs_lnum_t s_id, e_id;
+          _thread_particle_range(cell_idx, ncel, nbpart, pass_id,
+                                 &s_id, &e_id);
 
-          cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n
-                                     (particle, p_am, 1, CS_LAGR_MASS);
-          cs_real_t  prev_p_tmp  = cs_lagr_particle_get_real_n
-                                     (particle, p_am, 1, CS_LAGR_TEMPERATURE);
-          cs_real_t  prev_p_cp   = cs_lagr_particle_get_real_n
-                                     (particle, p_am, 1, CS_LAGR_CP);
+          for (cs_lnum_t npt = s_id; npt < e_id; npt++) {
 
-          cs_real_t  p_stat_w = cs_lagr_particle_get_real
-                                  (particle, p_am, CS_LAGR_STAT_WEIGHT);
+            unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
 
-          tslag[iel + (lag_st->itste-1) * ncelet]
-            += - (  p_mass * p_tmp * p_cp
-               - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
-          tslag[iel + (lag_st->itsti-1) * ncelet]
-            += tempct[nbpart + npt] * p_stat_w;
-          tslag[iel + (lag_st->itsmv1[icha]-1) * ncelet]
-            += p_stat_w * cpgd1[npt];
-          tslag[iel + (lag_st->itsmv2[icha]-1) * ncelet]
-            += p_stat_w * cpgd2[npt];
-          tslag[iel + (lag_st->itsco-1) * ncelet]
-            += p_stat_w * cpght[npt];
-          tslag[iel + (lag_st->itsfp4-1) * ncelet] = 0.0;
+            cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
+                                                       CS_LAGR_CELL_ID);
+            cs_lnum_t icha = cs_lagr_particle_get_lnum(particle, p_am,
+                                                       CS_LAGR_COAL_ID);
 
+            cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                            CS_LAGR_MASS);
+            cs_real_t  p_tmp = cs_lagr_particle_get_real(particle, p_am,
+                                                         CS_LAGR_TEMPERATURE);
+            cs_real_t  p_cp = cs_lagr_particle_get_real_n(particle, p_am, 0,
+                                                          CS_LAGR_CP);
+
+            cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n
+                                       (particle, p_am, 1, CS_LAGR_MASS);
+            cs_real_t  prev_p_tmp  = cs_lagr_particle_get_real_n
+                                       (particle, p_am, 1, CS_LAGR_TEMPERATURE);
+            cs_real_t  prev_p_cp   = cs_lagr_particle_get_real_n
+                                       (particle, p_am, 1, CS_LAGR_CP);
+
+            cs_real_t  p_stat_w = cs_lagr_particle_get_real
+                                    (particle, p_am, CS_LAGR_STAT_WEIGHT);
+
+            tslag[iel + (lag_st->itste-1) * ncelet]
+              += - (  p_mass * p_tmp * p_cp
+                 - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
+            tslag[iel + (lag_st->itsti-1) * ncelet]
+              += tempct[nbpart + npt] * p_stat_w;
+            tslag[iel + (lag_st->itsmv1[icha]-1) * ncelet]
+              += p_stat_w * cpgd1[npt];
+            tslag[iel + (lag_st->itsmv2[icha]-1) * ncelet]
+              += p_stat_w * cpgd2[npt];
+            tslag[iel + (lag_st->itsco-1) * ncelet]
+              += p_stat_w * cpght[npt];
+            tslag[iel + (lag_st->itsfp4-1) * ncelet] = 0.0;
+
+          }
+
+          #pragma omp barrier
         }
 
       }
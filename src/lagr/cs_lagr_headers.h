@@ -31,6 +31,7 @@
 
 #include "cs_lagr.h"
 #include "cs_lagr_adh.h"
+#include "cs_lagr_balance.h"
 #include "cs_lagr_car.h"
 #include "cs_lagr_clogging.h"
 #include "cs_lagr_coupling.h"
@@ -42,6 +43,7 @@
 #include "cs_lagr_head_losses.h"
 #include "cs_lagr_injection.h"
 #include "cs_lagr_lec.h"
+#include "cs_lagr_locate.h"
 #include "cs_lagr_log.h"
 #include "cs_lagr_new.h"
 #include "cs_lagr_options.h"
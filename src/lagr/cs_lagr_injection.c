@@ -70,6 +70,7 @@
 #include "cs_random.h"
 
 #include "cs_lagr.h"
+#include "cs_lagr_locate.h"
 #include "cs_lagr_tracking.h"
 #include "cs_lagr_new.h"
 #include "cs_lagr_precipitation_model.h"
@@ -603,6 +604,73 @@ _get_particle_face_ids(cs_lnum_t         n_faces,
   return(particle_face_id);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Locate new particles whose coordinates were modified by the user.
+ *
+ * \param[in]   p_set           particle set
+ * \param[in]   particle_range  start and past-the-end ids of new particles
+ * \param[in]   saved_coords    particle coordinates before modification
+ * \param[out]  cell_id         id of local cell containing each modified
+ *                              particle, or -1 for unmodified particles
+ *                              or particles not located locally
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_locate_moved_particles(const cs_lagr_particle_set_t  *p_set,
+                        const cs_lnum_t                particle_range[2],
+                        const cs_real_3_t              saved_coords[],
+                        cs_lnum_t                      cell_id[])
+{
+  const cs_lnum_t n_new = particle_range[1] - particle_range[0];
+
+  cs_lnum_t n_moved = 0;
+  cs_lnum_t *moved_id;
+  cs_real_3_t *moved_coords;
+  BFT_MALLOC(moved_id, n_new, cs_lnum_t);
+  BFT_MALLOC(moved_coords, n_new, cs_real_3_t);
+
+  for (cs_lnum_t i = 0; i < n_new; i++) {
+
+    cell_id[i] = -1;
+
+    const cs_real_t *p_coords
+      = cs_lagr_particles_attr_const(p_set,
+                                     particle_range[0] + i,
+                                     CS_LAGR_COORDS);
+
+    if (   fabs(p_coords[0] - saved_coords[i][0]) > 0
+        || fabs(p_coords[1] - saved_coords[i][1]) > 0
+        || fabs(p_coords[2] - saved_coords[i][2]) > 0) {
+      moved_id[n_moved] = i;
+      for (cs_lnum_t j = 0; j < 3; j++)
+        moved_coords[n_moved][j] = p_coords[j];
+      n_moved++;
+    }
+
+  }
+
+  if (n_moved > 0) {
+
+    cs_lnum_t *moved_cell_id;
+    BFT_MALLOC(moved_cell_id, n_moved, cs_lnum_t);
+
+    cs_lagr_locate_points(n_moved,
+                          (const cs_real_3_t *)moved_coords,
+                          moved_cell_id);
+
+    for (cs_lnum_t i = 0; i < n_moved; i++)
+      cell_id[moved_id[i]] = moved_cell_id[i];
+
+    BFT_FREE(moved_cell_id);
+
+  }
+
+  BFT_FREE(moved_coords);
+  BFT_FREE(moved_id);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Initialize particle values
@@ -1559,6 +1627,9 @@ cs_lagr_injection(int        time_id,
            WARNING: the user may change the particle coordinates but is
            prevented from changing the previous location (otherwise, if
            the particle is not in the same cell anymore, it would be lost).
+           Particles moved to arbitrary coordinates are located, and start
+           from their new position if it is in a local cell; otherwise,
+           they are tracked from their initial position.
 
            Moreover, a precaution has to be taken when calling
            "current to previous" in the tracking stage.
@@ -1597,26 +1668,44 @@ cs_lagr_injection(int        time_id,
                           particle_face_ids,
                           visc_length);
 
-          /* For safety, build values at previous time step, but reset saved values
-             for previous cell number and particle coordinates */
+          cs_lnum_t *moved_cell_id;
+          BFT_MALLOC(moved_cell_id, n_inject, cs_lnum_t);
+
+          _locate_moved_particles(p_set,
+                                  particle_range,
+                                  (const cs_real_3_t *)saved_coords,
+                                  moved_cell_id);
+
+          /* For safety, build values at previous time step, but reset saved
+             values for previous cell number and particle coordinates
+             (except for moved particles located in a local cell) */
 
           for (cs_lnum_t i = 0; i < n_inject; i++) {
             cs_lnum_t p_id = particle_range[0] + i;
 
-            cs_lagr_particles_current_to_previous(p_set, p_id);
-
-            cs_lagr_particles_set_lnum_n(p_set,
+            if (moved_cell_id[i] > -1)
+              cs_lagr_particles_set_lnum(p_set,
                                          p_id,
-                                         1,
                                          CS_LAGR_CELL_ID,
-                                         saved_cell_id[i]);
+                                         moved_cell_id[i]);
+
+            cs_lagr_particles_current_to_previous(p_set, p_id);
+
             cs_real_t *p_coords_prev
               = cs_lagr_particles_attr_n(p_set,
                                          p_id,
                                          1,
                                          CS_LAGR_COORDS);
-            for (cs_lnum_t j = 0; j < 3; j++)
-              p_coords_prev[j] = saved_coords[i][j];
+
+            if (moved_cell_id[i] < 0) {
+              cs_lagr_particles_set_lnum_n(p_set,
+                                           p_id,
+                                           1,
+                                           CS_LAGR_CELL_ID,
+                                           saved_cell_id[i]);
+              for (cs_lnum_t j = 0; j < 3; j++)
+                p_coords_prev[j] = saved_coords[i][j];
+            }
 
             /* Just after injection, compute the next particle position with
              * a reduce integration time so as to simulate continuous injection
@@ -1641,6 +1730,7 @@ cs_lagr_injection(int        time_id,
 
           }
 
+          BFT_FREE(moved_cell_id);
           BFT_FREE(saved_coords);
           BFT_FREE(saved_cell_id);
 
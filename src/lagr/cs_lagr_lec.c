@@ -64,6 +64,7 @@
 #include "cs_turbulence_model.h"
 
 #include "cs_lagr.h"
+#include "cs_lagr_balance.h"
 #include "cs_lagr_tracking.h"
 #include "cs_lagr_post.h"
 #include "cs_lagr_stat.h"
@@ -1449,6 +1450,10 @@ cs_restart_lagrangian_checkpoint_write(void)
   }
 
   BFT_FREE(nomtsl);
+
+  /* Particle-based cell weights for subsequent partitionings */
+
+  cs_lagr_balance_write_cell_weights();
 }
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,558 @@
+/*============================================================================
+ * Location of points in cells for Lagrangian particles
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+
+#include "cs_base.h"
+#include "cs_geom.h"
+#include "cs_mesh.h"
+#include "cs_mesh_adjacencies.h"
+#include "cs_mesh_quantities.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_locate.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_locate.c
+        Location of points in cells for Lagrangian particles.
+
+Particles are usually tracked from cell to cell, so that their cell is
+always known. When particles are defined at arbitrary coordinates (for
+example by user injection functions), their containing cell must be
+determined geometrically.
+
+To avoid a search over all cells for each point, cell bounding boxes
+are binned in a uniform grid, which is built on first use and kept
+until the mesh is modified. The final test for candidate cells is based
+on the same segment/face intersection test as the particle tracking.
+
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local structure definitions
+ *============================================================================*/
+
+/* Uniform grid of cell bounding boxes */
+
+typedef struct {
+
+  cs_lnum_t    n_cells;           /* number of associated cells */
+
+  cs_real_t    extents[6];        /* global extents (min, max) */
+  cs_real_t    tolerance;         /* absolute bounding box tolerance */
+
+  cs_lnum_t    n_bins[3];         /* number of bins per direction */
+  cs_real_t    inv_step[3];       /* inverse of bin size per direction */
+
+  cs_real_t   *cell_extents;      /* cell bounding boxes (min, max) */
+
+  cs_lnum_t   *bin_idx;           /* index of cells in each bin */
+  cs_lnum_t   *bin_cell_id;       /* ids of cells intersecting each bin */
+
+} cs_lagr_locate_grid_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static cs_lagr_locate_grid_t  *_grid = NULL;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Update cell bounding box with a face's vertices.
+ *
+ * parameters:
+ *   n_vertices   <-- number of face vertices
+ *   vertex_ids   <-- face vertex ids
+ *   vtx_coord    <-- vertex coordinates
+ *   extents      <-> cell extents
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_update_extents(cs_lnum_t          n_vertices,
+                const cs_lnum_t    vertex_ids[],
+                const cs_real_3_t  vtx_coord[],
+                cs_real_t          extents[6])
+{
+  for (cs_lnum_t i = 0; i < n_vertices; i++) {
+    const cs_real_t *x = vtx_coord[vertex_ids[i]];
+    for (int j = 0; j < 3; j++) {
+      if (x[j] < extents[j])
+        extents[j] = x[j];
+      if (x[j] > extents[j+3])
+        extents[j+3] = x[j];
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Compute range of grid bins intersected by a bounding box.
+ *
+ * parameters:
+ *   g        <-- pointer to grid structure
+ *   extents  <-- bounding box extents
+ *   b_min    --> minimum bin id per direction
+ *   b_max    --> maximum bin id per direction (inclusive)
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_bin_range(const cs_lagr_locate_grid_t  *g,
+           const cs_real_t               extents[6],
+           cs_lnum_t                     b_min[3],
+           cs_lnum_t                     b_max[3])
+{
+  for (int j = 0; j < 3; j++) {
+    cs_lnum_t i0 = floor((extents[j] - g->tolerance - g->extents[j])
+                         * g->inv_step[j]);
+    cs_lnum_t i1 = floor((extents[j+3] + g->tolerance - g->extents[j])
+                         * g->inv_step[j]);
+    b_min[j] = CS_MAX(CS_MIN(i0, g->n_bins[j] - 1), 0);
+    b_max[j] = CS_MAX(CS_MIN(i1, g->n_bins[j] - 1), 0);
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Build grid of local cell bounding boxes.
+ *
+ * parameters:
+ *   mesh  <-- pointer to mesh structure
+ *
+ * returns:
+ *   pointer to new grid structure
+ *----------------------------------------------------------------------------*/
+
+static cs_lagr_locate_grid_t *
+_grid_create(const cs_mesh_t  *mesh)
+{
+  const cs_lnum_t n_cells = mesh->n_cells;
+  const cs_real_3_t *vtx_coord = (const cs_real_3_t *)mesh->vtx_coord;
+
+  cs_lagr_locate_grid_t *g;
+  BFT_MALLOC(g, 1, cs_lagr_locate_grid_t);
+
+  g->n_cells = n_cells;
+
+  /* Cell bounding boxes, based on the vertices of their faces */
+
+  BFT_MALLOC(g->cell_extents, n_cells*6, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_cells; i++) {
+    cs_real_t *c_ext = g->cell_extents + 6*i;
+    for (int j = 0; j < 3; j++) {
+      c_ext[j] = HUGE_VAL;
+      c_ext[j+3] = -HUGE_VAL;
+    }
+  }
+
+  for (cs_lnum_t f_id = 0; f_id < mesh->n_i_faces; f_id++) {
+    const cs_lnum_t s_id = mesh->i_face_vtx_idx[f_id];
+    const cs_lnum_t n_vtx = mesh->i_face_vtx_idx[f_id+1] - s_id;
+    for (int k = 0; k < 2; k++) {
+      cs_lnum_t c_id = mesh->i_face_cells[f_id][k];
+      if (c_id < n_cells)
+        _update_extents(n_vtx,
+                        mesh->i_face_vtx_lst + s_id,
+                        vtx_coord,
+                        g->cell_extents + 6*c_id);
+    }
+  }
+
+  for (cs_lnum_t f_id = 0; f_id < mesh->n_b_faces; f_id++) {
+    const cs_lnum_t s_id = mesh->b_face_vtx_idx[f_id];
+    const cs_lnum_t n_vtx = mesh->b_face_vtx_idx[f_id+1] - s_id;
+    cs_lnum_t c_id = mesh->b_face_cells[f_id];
+    _update_extents(n_vtx,
+                    mesh->b_face_vtx_lst + s_id,
+                    vtx_coord,
+                    g->cell_extents + 6*c_id);
+  }
+
+  /* Global extents */
+
+  for (int j = 0; j < 3; j++) {
+    g->extents[j] = HUGE_VAL;
+    g->extents[j+3] = -HUGE_VAL;
+  }
+
+  for (cs_lnum_t i = 0; i < n_cells; i++) {
+    const cs_real_t *c_ext = g->cell_extents + 6*i;
+    for (int j = 0; j < 3; j++) {
+      g->extents[j] = CS_MIN(g->extents[j], c_ext[j]);
+      g->extents[j+3] = CS_MAX(g->extents[j+3], c_ext[j+3]);
+    }
+  }
+
+  /* Grid dimensions: aim for about one cell per bin, avoiding
+     degenerate directions for flat or empty domains */
+
+  cs_real_t l[3] = {0., 0., 0.};
+  cs_real_t l_max = 0.;
+
+  if (n_cells > 0) {
+    for (int j = 0; j < 3; j++) {
+      l[j] = g->extents[j+3] - g->extents[j];
+      l_max = CS_MAX(l_max, l[j]);
+    }
+  }
+  else {
+    for (int j = 0; j < 3; j++) {
+      g->extents[j] = 0.;
+      g->extents[j+3] = 0.;
+    }
+  }
+
+  if (l_max <= 0.)
+    l_max = 1.;
+
+  g->tolerance = 1e-10 * l_max;
+
+  for (int j = 0; j < 3; j++)
+    l[j] = CS_MAX(l[j], 1e-3*l_max);
+
+  const double h = cbrt(l[0]*l[1]*l[2] / CS_MAX(n_cells, 1));
+
+  for (int j = 0; j < 3; j++) {
+    g->n_bins[j] = CS_MAX(1, CS_MIN((cs_lnum_t)(l[j]/h), n_cells));
+    g->inv_step[j] = g->n_bins[j] / l[j];
+  }
+
+  const cs_lnum_t n_bins = g->n_bins[0] * g->n_bins[1] * g->n_bins[2];
+  const cs_lnum_t n_b_xy = g->n_bins[0] * g->n_bins[1];
+
+  /* Count then list cells intersecting each bin */
+
+  BFT_MALLOC(g->bin_idx, n_bins + 1, cs_lnum_t);
+
+  for (cs_lnum_t i = 0; i < n_bins + 1; i++)
+    g->bin_idx[i] = 0;
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    cs_lnum_t b_min[3], b_max[3];
+    _bin_range(g, g->cell_extents + 6*c_id, b_min, b_max);
+    for (cs_lnum_t k = b_min[2]; k <= b_max[2]; k++) {
+      for (cs_lnum_t j = b_min[1]; j <= b_max[1]; j++) {
+        for (cs_lnum_t i = b_min[0]; i <= b_max[0]; i++)
+          g->bin_idx[k*n_b_xy + j*g->n_bins[0] + i + 1] += 1;
+      }
+    }
+  }
+
+  for (cs_lnum_t i = 0; i < n_bins; i++)
+    g->bin_idx[i+1] += g->bin_idx[i];
+
+  cs_lnum_t *bin_count;
+  BFT_MALLOC(bin_count, n_bins, cs_lnum_t);
+  for (cs_lnum_t i = 0; i < n_bins; i++)
+    bin_count[i] = 0;
+
+  BFT_MALLOC(g->bin_cell_id, g->bin_idx[n_bins], cs_lnum_t);
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    cs_lnum_t b_min[3], b_max[3];
+    _bin_range(g, g->cell_extents + 6*c_id, b_min, b_max);
+    for (cs_lnum_t k = b_min[2]; k <= b_max[2]; k++) {
+      for (cs_lnum_t j = b_min[1]; j <= b_max[1]; j++) {
+        for (cs_lnum_t i = b_min[0]; i <= b_max[0]; i++) {
+          cs_lnum_t b_id = k*n_b_xy + j*g->n_bins[0] + i;
+          g->bin_cell_id[g->bin_idx[b_id] + bin_count[b_id]] = c_id;
+          bin_count[b_id] += 1;
+        }
+      }
+    }
+  }
+
+  BFT_FREE(bin_count);
+
+  return g;
+}
+
+/*----------------------------------------------------------------------------
+ * Destroy grid of cell bounding boxes.
+ *
+ * parameters:
+ *   g  <-> pointer to grid structure pointer
+ *----------------------------------------------------------------------------*/
+
+static void
+_grid_destroy(cs_lagr_locate_grid_t  **g)
+{
+  cs_lagr_locate_grid_t *_g = *g;
+
+  if (_g == NULL)
+    return;
+
+  BFT_FREE(_g->bin_cell_id);
+  BFT_FREE(_g->bin_idx);
+  BFT_FREE(_g->cell_extents);
+  BFT_FREE(*g);
+}
+
+/*----------------------------------------------------------------------------
+ * Check if a point is contained in a given cell.
+ *
+ * A point is considered to be inside a cell if the segment joining
+ * the cell center to that point does not exit the cell. Points located
+ * on a face shared by 2 cells are considered to be inside both cells.
+ *
+ * parameters:
+ *   mesh     <-- pointer to mesh structure
+ *   ma       <-- pointer to mesh adjacencies structure
+ *   fvq      <-- pointer to mesh quantities structure
+ *   cell_id  <-- id of cell to check
+ *   x        <-- point coordinates
+ *
+ * returns:
+ *   true if point is inside the cell, false otherwise
+ *----------------------------------------------------------------------------*/
+
+static bool
+_point_in_cell(const cs_mesh_t             *mesh,
+               const cs_mesh_adjacencies_t *ma,
+               const cs_mesh_quantities_t  *fvq,
+               cs_lnum_t                    cell_id,
+               const cs_real_t              x[3])
+{
+  const cs_real_3_t *vtx_coord = (const cs_real_3_t *)mesh->vtx_coord;
+  const cs_real_3_t *i_face_cog = (const cs_real_3_t *)fvq->i_face_cog;
+  const cs_real_3_t *b_face_cog = (const cs_real_3_t *)fvq->b_face_cog;
+  const cs_real_t *cell_cen = fvq->cell_cen + 3*cell_id;
+
+  const cs_lnum_t n_cell_i_faces =   ma->cell_cells_idx[cell_id+1]
+                                   - ma->cell_cells_idx[cell_id];
+  const cs_lnum_t n_cell_b_faces =   ma->cell_b_faces_idx[cell_id+1]
+                                   - ma->cell_b_faces_idx[cell_id];
+
+  cs_lnum_t n_cell_faces = n_cell_i_faces + n_cell_b_faces;
+
+  if (ma->cell_hb_faces_idx != NULL) {
+    n_cell_faces +=   ma->cell_hb_faces_idx[cell_id+1]
+                    - ma->cell_hb_faces_idx[cell_id];
+  }
+
+  for (cs_lnum_t i = 0; i < n_cell_faces; i++) {
+
+    cs_lnum_t face_id, vtx_start, n_vertices;
+    const cs_lnum_t *face_connect;
+    const cs_real_t *face_cog;
+
+    int reorient_face = 1;
+
+    if (i < n_cell_i_faces) { /* Interior face */
+
+      face_id = ma->cell_i_faces[ma->cell_cells_idx[cell_id] + i];
+
+      if (cell_id == mesh->i_face_cells[face_id][1])
+        reorient_face = -1;
+      vtx_start = mesh->i_face_vtx_idx[face_id];
+      n_vertices = mesh->i_face_vtx_idx[face_id+1] - vtx_start;
+
+      face_connect = mesh->i_face_vtx_lst + vtx_start;
+      face_cog = i_face_cog[face_id];
+
+    }
+    else { /* Boundary faces */
+
+      cs_lnum_t j = i - n_cell_i_faces;
+      if (j < n_cell_b_faces)
+        face_id = ma->cell_b_faces[ma->cell_b_faces_idx[cell_id] + j];
+
+      else {
+        j -= n_cell_b_faces;
+        face_id = ma->cell_hb_faces[ma->cell_hb_faces_idx[cell_id] + j];
+      }
+
+      vtx_start = mesh->b_face_vtx_idx[face_id];
+      n_vertices = mesh->b_face_vtx_idx[face_id+1] - vtx_start;
+
+      face_connect = mesh->b_face_vtx_lst + vtx_start;
+      face_cog = b_face_cog[face_id];
+
+    }
+
+    int n_crossings[2] = {0, 0};
+
+    double t = cs_geom_segment_intersect_face(reorient_face,
+                                              n_vertices,
+                                              face_connect,
+                                              vtx_coord,
+                                              face_cog,
+                                              cell_cen,
+                                              x,
+                                              n_crossings,
+                                              NULL);
+
+    if (t >= 0 && t < 1)
+      return false;
+
+  }
+
+  return true;
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Locate points in the local mesh cells.
+ *
+ * A uniform grid of cell bounding boxes is built on first call and kept
+ * for subsequent calls, unless the mesh is deforming or modified.
+ *
+ * Location is purely local: points not contained in a local cell
+ * are assigned a cell id of -1.
+ *
+ * This function may be called from user injection functions for particles
+ * defined at arbitrary coordinates.
+ *
+ * \param[in]   n_points  number of points to locate
+ * \param[in]   coords    point coordinates
+ * \param[out]  cell_id   id of cell containing each point, or -1
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_locate_points(cs_lnum_t          n_points,
+                      const cs_real_3_t  coords[],
+                      cs_lnum_t          cell_id[])
+{
+  const cs_mesh_t *mesh = cs_glob_mesh;
+  const cs_mesh_quantities_t *fvq = cs_glob_mesh_quantities;
+
+  /* Cell bounding boxes are only valid for fixed meshes */
+
+  if (_grid != NULL) {
+    if (   mesh->time_dep > CS_MESH_FIXED
+        || _grid->n_cells != mesh->n_cells)
+      _grid_destroy(&_grid);
+  }
+
+  if (_grid == NULL)
+    _grid = _grid_create(mesh);
+
+  const cs_lagr_locate_grid_t *g = _grid;
+
+  const cs_mesh_adjacencies_t *ma = cs_glob_mesh_adjacencies;
+  if (ma->cell_i_faces == NULL)
+    cs_mesh_adjacencies_update_cell_i_faces();
+
+  const cs_lnum_t n_b_xy = g->n_bins[0] * g->n_bins[1];
+
+  #pragma omp parallel for if (n_points > CS_THR_MIN)
+  for (cs_lnum_t p_id = 0; p_id < n_points; p_id++) {
+
+    const cs_real_t *x = coords[p_id];
+
+    cell_id[p_id] = -1;
+
+    bool outside = false;
+    cs_lnum_t b_ijk[3];
+
+    for (int j = 0; j < 3; j++) {
+      if (   x[j] < g->extents[j] - g->tolerance
+          || x[j] > g->extents[j+3] + g->tolerance)
+        outside = true;
+      cs_lnum_t b = floor((x[j] - g->extents[j]) * g->inv_step[j]);
+      b_ijk[j] = CS_MAX(CS_MIN(b, g->n_bins[j] - 1), 0);
+    }
+
+    if (outside)
+      continue;
+
+    cs_lnum_t b_id = b_ijk[2]*n_b_xy + b_ijk[1]*g->n_bins[0] + b_ijk[0];
+
+    for (cs_lnum_t i = g->bin_idx[b_id]; i < g->bin_idx[b_id+1]; i++) {
+
+      cs_lnum_t c_id = g->bin_cell_id[i];
+      const cs_real_t *c_ext = g->cell_extents + 6*c_id;
+
+      bool in_box = true;
+      for (int j = 0; j < 3; j++) {
+        if (   x[j] < c_ext[j] - g->tolerance
+            || x[j] > c_ext[j+3] + g->tolerance)
+          in_box = false;
+      }
+
+      if (in_box && _point_in_cell(mesh, ma, fvq, c_id, x)) {
+        cell_id[p_id] = c_id;
+        break;
+      }
+
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free point location structures.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_locate_finalize(void)
+{
+  _grid_destroy(&_grid);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
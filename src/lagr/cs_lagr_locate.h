@@ -0,0 +1,81 @@
+#ifndef __CS_LAGR_LOCATE_H__
+#define __CS_LAGR_LOCATE_H__
+
+/*============================================================================
+ * Location of points in cells for Lagrangian particles
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Locate points in the local mesh cells.
+ *
+ * A uniform grid of cell bounding boxes is built on first call and kept
+ * for subsequent calls, unless the mesh is deforming or modified.
+ *
+ * Location is purely local: points not contained in a local cell
+ * are assigned a cell id of -1.
+ *
+ * This function may be called from user injection functions for particles
+ * defined at arbitrary coordinates.
+ *
+ * \param[in]   n_points  number of points to locate
+ * \param[in]   coords    point coordinates
+ * \param[out]  cell_id   id of cell containing each point, or -1
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_locate_points(cs_lnum_t          n_points,
+                      const cs_real_3_t  coords[],
+                      cs_lnum_t          cell_id[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free point location structures.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_locate_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_LOCATE_H__ */
@@ -91,6 +91,10 @@ BEGIN_C_DECLS
 #define  N_GEOL 13
 #define  CS_LAGR_MIN_COMM_BUF_SIZE  8
 
+/* Granularity of particle set buffer sizes (in number of particles) */
+
+#define  CS_LAGR_PARTICLE_CHUNK_SIZE  1024
+
 /*=============================================================================
  * Local Enumeration definitions
  *============================================================================*/
@@ -231,9 +235,13 @@ static cs_lagr_attribute_map_t  *_p_attr_map = NULL;
 
 /* Particle set reallocation parameters */
 
-static  double              _reallocation_factor = 2.0;
+static  double              _reallocation_factor = 1.1;
 static  unsigned long long  _n_g_max_particles = ULLONG_MAX;
 
+/* Particle set layout for integration and statistics stages */
+
+static cs_lagr_particle_layout_t  _integration_layout = CS_LAGR_PARTICLE_AOS;
+
 /*============================================================================
  * Global variables
  *============================================================================*/
@@ -517,6 +525,8 @@ _create_particle_set(cs_lnum_t                       n_particles_max,
 
   assert(n_particles_max >= 1);
 
+  new_set->layout = CS_LAGR_PARTICLE_AOS;
+
   new_set->p_am = p_am;
 
   return new_set;
@@ -541,6 +551,128 @@ _destroy_particle_set(cs_lagr_particle_set_t **set)
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Build list of data regions (tracking info, attributes at each time,
+ * and source terms) in a particle structure.
+ *
+ * parameters:
+ *   p_am    <-- particle attributes map
+ *   r_displ --> displacement of each region (size: 3*CS_LAGR_N_ATTRIBUTES+1)
+ *   r_size  --> size of each region (size: 3*CS_LAGR_N_ATTRIBUTES+1)
+ *
+ * returns:
+ *   number of data regions
+ *----------------------------------------------------------------------------*/
+
+static int
+_data_regions(const cs_lagr_attribute_map_t  *p_am,
+              ptrdiff_t                       r_displ[],
+              size_t                          r_size[])
+{
+  int n_regions = 0;
+
+  r_displ[n_regions] = 0;
+  r_size[n_regions] = p_am->lb;
+  n_regions++;
+
+  for (int time_id = 0; time_id < p_am->n_time_vals; time_id++) {
+    for (int attr = 0; attr < CS_LAGR_N_ATTRIBUTES; attr++) {
+      if (p_am->count[time_id][attr] > 0) {
+        r_displ[n_regions] = p_am->displ[time_id][attr];
+        r_size[n_regions] = p_am->size[attr];
+        n_regions++;
+      }
+    }
+  }
+
+  if (p_am->source_term_displ != NULL) {
+    for (int attr = 0; attr < CS_LAGR_N_ATTRIBUTES; attr++) {
+      if (p_am->source_term_displ[attr] >= 0) {
+        r_displ[n_regions] = p_am->source_term_displ[attr];
+        r_size[n_regions] = p_am->size[attr];
+        n_regions++;
+      }
+    }
+  }
+
+  return n_regions;
+}
+
+/*----------------------------------------------------------------------------
+ * Copy particle data from one buffer to another, with possibly different
+ * layouts and maximum number of particles.
+ *
+ * parameters:
+ *   p_am        <-- particle attributes map
+ *   n_particles <-- number of particles to copy
+ *   src_layout  <-- layout of source buffer
+ *   src_n_max   <-- maximum number of particles in source buffer
+ *   src         <-- source buffer
+ *   dest_layout <-- layout of destination buffer
+ *   dest_n_max  <-- maximum number of particles in destination buffer
+ *   dest        --> destination buffer
+ *----------------------------------------------------------------------------*/
+
+static void
+_copy_particle_data(const cs_lagr_attribute_map_t  *p_am,
+                    cs_lnum_t                       n_particles,
+                    cs_lagr_particle_layout_t       src_layout,
+                    cs_lnum_t                       src_n_max,
+                    const unsigned char            *src,
+                    cs_lagr_particle_layout_t       dest_layout,
+                    cs_lnum_t                       dest_n_max,
+                    unsigned char                  *dest)
+{
+  const size_t extents = p_am->extents;
+
+  if (src_layout == CS_LAGR_PARTICLE_AOS && dest_layout == src_layout) {
+    memcpy(dest, src, n_particles*extents);
+    return;
+  }
+
+  ptrdiff_t r_displ[3*CS_LAGR_N_ATTRIBUTES + 1];
+  size_t r_size[3*CS_LAGR_N_ATTRIBUTES + 1];
+
+  int n_regions = _data_regions(p_am, r_displ, r_size);
+
+  if (dest_layout == src_layout) {
+    for (int r_id = 0; r_id < n_regions; r_id++)
+      memcpy(dest + r_displ[r_id]*dest_n_max,
+             src + r_displ[r_id]*src_n_max,
+             r_size[r_id]*n_particles);
+    return;
+  }
+
+  /* Transpose data by blocks of particles, so that the strided side of
+     the copy remains in cache */
+
+  const cs_lnum_t block_size = 256;
+
+  for (cs_lnum_t s_id = 0; s_id < n_particles; s_id += block_size) {
+
+    cs_lnum_t e_id = CS_MIN(s_id + block_size, n_particles);
+
+    for (int r_id = 0; r_id < n_regions; r_id++) {
+
+      const ptrdiff_t displ = r_displ[r_id];
+      const size_t size = r_size[r_id];
+
+      if (src_layout == CS_LAGR_PARTICLE_AOS) {
+        unsigned char *d = dest + displ*dest_n_max;
+        for (cs_lnum_t p_id = s_id; p_id < e_id; p_id++)
+          memcpy(d + size*p_id, src + extents*p_id + displ, size);
+      }
+      else {
+        const unsigned char *s = src + displ*src_n_max;
+        for (cs_lnum_t p_id = s_id; p_id < e_id; p_id++)
+          memcpy(dest + extents*p_id + displ, s + size*p_id, size);
+      }
+
+    }
+
+  }
+}
+
 /*----------------------------------------------------------------------------
  * Dump a particle structure
  *
@@ -553,8 +685,6 @@ static void
 _dump_particle(const cs_lagr_particle_set_t  *particles,
                cs_lnum_t                      particle_id)
 {
-  const unsigned char *p =   particles->p_buffer
-                           + particles->p_am->extents*particle_id;
   const cs_lagr_attribute_map_t *am = particles->p_am;
 
   bft_printf("  particle: %lu\n", (unsigned long)particle_id);
@@ -575,7 +705,8 @@ _dump_particle(const cs_lagr_particle_set_t  *particles,
         case CS_LNUM_TYPE:
           {
             const cs_lnum_t *v
-              = cs_lagr_particle_attr_n_const(p, particles->p_am, time_id, attr);
+              = cs_lagr_particles_attr_n_const(particles, particle_id,
+                                               time_id, attr);
             bft_printf("      %24s: %10ld\n", attr_name, (long)v[0]);
             for (int i = 1; i < am->count[time_id][attr]; i++)
               bft_printf("      %24s: %10ld\n", " ", (long)v[i]);
@@ -584,7 +715,8 @@ _dump_particle(const cs_lagr_particle_set_t  *particles,
         case CS_GNUM_TYPE:
           {
             const cs_gnum_t *v
-              = cs_lagr_particle_attr_n_const(p, particles->p_am, time_id, attr);
+              = cs_lagr_particles_attr_n_const(particles, particle_id,
+                                               time_id, attr);
             bft_printf("      %24s: %10lu\n", attr_name, (unsigned long)v[0]);
             for (int i = 1; i < am->count[time_id][attr]; i++)
               bft_printf("      %24s: %10lu\n", " ", (unsigned long)v[i]);
@@ -593,7 +725,8 @@ _dump_particle(const cs_lagr_particle_set_t  *particles,
         case CS_REAL_TYPE:
           {
             const cs_real_t *v
-              = cs_lagr_particle_attr_n_const(p, particles->p_am, time_id, attr);
+              = cs_lagr_particles_attr_n_const(particles, particle_id,
+                                               time_id, attr);
             bft_printf("      %24s: %10.3g\n", attr_name, v[0]);
             for (int i = 1; i < am->count[time_id][attr]; i++)
               bft_printf("      %24s: %10.3g\n", " ", v[i]);
@@ -608,9 +741,89 @@ _dump_particle(const cs_lagr_particle_set_t  *particles,
   bft_printf("\n");
 }
 
+/*----------------------------------------------------------------------------
+ * Compute buffer size (in number of particles) for a given number of
+ * particles, including the reallocation margin, rounded up to a
+ * multiple of the chunk size.
+ *
+ * parameters:
+ *   n_particles <-- number of particles
+ *   factor      <-- multiplier applied to the number of particles
+ *
+ * returns:
+ *   matching buffer size
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_particle_set_buffer_size(cs_lnum_t  n_particles,
+                          double     factor)
+{
+  const cs_lnum_t chunk_size = CS_LAGR_PARTICLE_CHUNK_SIZE;
+
+  cs_lnum_t n = ceil(n_particles * factor);
+  cs_lnum_t n_chunks = CS_MAX((n + chunk_size - 1) / chunk_size, 1);
+
+  return n_chunks * chunk_size;
+}
+
+/*----------------------------------------------------------------------------
+ * Reallocate the buffer of a cs_lagr_particle_set_t structure.
+ *
+ * Only the data of the first particle_set->n_particles particles
+ * is preserved.
+ *
+ * parameters:
+ *   particle_set    <-> pointer to a cs_lagr_particle_set_t structure
+ *   n_particles_max <-- new local max. number of particles
+ *----------------------------------------------------------------------------*/
+
+static void
+_particle_set_realloc(cs_lagr_particle_set_t   *particle_set,
+                      cs_lnum_t                 n_particles_max)
+{
+  cs_lnum_t n_particles_max_prev = particle_set->n_particles_max;
+  cs_lnum_t n_particles = CS_MIN(particle_set->n_particles,
+                                 CS_MIN(n_particles_max_prev, n_particles_max));
+
+  particle_set->n_particles_max = n_particles_max;
+
+  /* With AoS layout, the buffer may simply be reallocated; for large
+     buffers, this usually remaps memory pages instead of copying data. */
+
+  if (particle_set->layout == CS_LAGR_PARTICLE_AOS)
+    BFT_REALLOC(particle_set->p_buffer,
+                particle_set->n_particles_max * particle_set->p_am->extents,
+                unsigned char);
+
+  /* With SoA layout, the position of each attribute's values depends on
+     the maximum number of particles, so data must be moved. */
+
+  else {
+    unsigned char *p_buffer = NULL;
+    BFT_MALLOC(p_buffer,
+               particle_set->n_particles_max * particle_set->p_am->extents,
+               unsigned char);
+    _copy_particle_data(particle_set->p_am,
+                        n_particles,
+                        CS_LAGR_PARTICLE_SOA,
+                        n_particles_max_prev,
+                        particle_set->p_buffer,
+                        CS_LAGR_PARTICLE_SOA,
+                        particle_set->n_particles_max,
+                        p_buffer);
+    BFT_FREE(particle_set->p_buffer);
+    particle_set->p_buffer = p_buffer;
+  }
+}
+
 /*----------------------------------------------------------------------------
  * Resize a cs_lagr_particle_set_t structure.
  *
+ * The buffer size is based on the required number of particles (and not
+ * on its previous size), plus a margin based on the reallocation factor,
+ * and rounded up to a multiple of the chunk size, so the allocated size
+ * remains close to the actual number of particles.
+ *
  * parameters:
  *   particle_set        <-> pointer to a cs_lagr_particle_set_t structure
  *   n_particles_max_min <-- minimum local max. number of particles
@@ -629,15 +842,9 @@ _particle_set_resize(cs_lagr_particle_set_t   *particle_set,
 
   if (particle_set->n_particles_max < n_particles_max_min) {
 
-    if (particle_set->n_particles_max == 0)
-      particle_set->n_particles_max = 1;
-
-    while (particle_set->n_particles_max < n_particles_max_min)
-      particle_set->n_particles_max *= _reallocation_factor;
-
-    BFT_REALLOC(particle_set->p_buffer,
-                particle_set->n_particles_max * particle_set->p_am->extents,
-                unsigned char);
+    _particle_set_realloc(particle_set,
+                          _particle_set_buffer_size(n_particles_max_min,
+                                                    _reallocation_factor));
 
     retval = 1;
   }
@@ -1000,9 +1207,26 @@ cs_lagr_part_copy(cs_lnum_t  dest,
                   cs_lnum_t  src)
 {
   cs_lagr_particle_set_t  *particles = cs_glob_lagr_particle_set;
-  memcpy(particles->p_buffer + particles->p_am->extents*(dest),
-         particles->p_buffer + particles->p_am->extents*(src),
-         particles->p_am->extents);
+  const cs_lagr_attribute_map_t  *p_am = particles->p_am;
+
+  if (particles->layout == CS_LAGR_PARTICLE_AOS)
+    memcpy(particles->p_buffer + p_am->extents*(dest),
+           particles->p_buffer + p_am->extents*(src),
+           p_am->extents);
+
+  else {
+    ptrdiff_t r_displ[3*CS_LAGR_N_ATTRIBUTES + 1];
+    size_t r_size[3*CS_LAGR_N_ATTRIBUTES + 1];
+
+    int n_regions = _data_regions(p_am, r_displ, r_size);
+    unsigned char *p_buf = particles->p_buffer;
+    cs_lnum_t n_max = particles->n_particles_max;
+
+    for (int r_id = 0; r_id < n_regions; r_id++)
+      memcpy(p_buf + r_displ[r_id]*n_max + r_size[r_id]*dest,
+             p_buf + r_displ[r_id]*n_max + r_size[r_id]*src,
+             r_size[r_id]);
+  }
   cs_real_t random = -1;
   cs_random_uniform(1, &random);
   cs_lagr_particles_set_real(particles, (dest-1), CS_LAGR_RANDOM_VALUE,
@@ -1155,6 +1379,84 @@ cs_lagr_get_particle_set(void)
   return cs_glob_lagr_particle_set;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Convert the data layout of a particle set.
+ *
+ * Functions accessing particles through the particle set (such as
+ * \ref cs_lagr_particles_attr or \ref cs_lagr_particles_get_real)
+ * handle both layouts, but functions accessing particle data directly
+ * through a pointer to a particle's data (such as \ref cs_lagr_particle_attr),
+ * or accessing \c p_buffer otherwise, require the
+ * \ref CS_LAGR_PARTICLE_AOS layout.
+ *
+ * \param[in, out]  particles  associated particle set
+ * \param[in]       layout     requested data layout
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_particle_set_layout(cs_lagr_particle_set_t     *particles,
+                            cs_lagr_particle_layout_t   layout)
+{
+  if (particles == NULL || particles->layout == layout)
+    return;
+
+  unsigned char *p_buffer = NULL;
+  BFT_MALLOC(p_buffer,
+             particles->n_particles_max * particles->p_am->extents,
+             unsigned char);
+
+  _copy_particle_data(particles->p_am,
+                      particles->n_particles,
+                      particles->layout,
+                      particles->n_particles_max,
+                      particles->p_buffer,
+                      layout,
+                      particles->n_particles_max,
+                      p_buffer);
+
+  BFT_FREE(particles->p_buffer);
+  particles->p_buffer = p_buffer;
+  particles->layout = layout;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get data layout used for particle integration and statistics.
+ *
+ * \return  particle set layout used for integration and statistics stages
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_particle_layout_t
+cs_lagr_get_integration_layout(void)
+{
+  return _integration_layout;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set data layout used for particle integration and statistics.
+ *
+ * By default, the \ref CS_LAGR_PARTICLE_AOS layout is used throughout.
+ * With the \ref CS_LAGR_PARTICLE_SOA layout, the main particle set is
+ * converted to that layout for the integration of the stochastic
+ * differential equations (without deposition model) and the update of
+ * statistics, which access a few attributes of all particles, then
+ * converted back. User-defined external forces and mesh-based moment
+ * data functions must then access particles through the particle set.
+ *
+ * \param[in]  layout  particle set layout for integration and statistics
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_set_integration_layout(cs_lagr_particle_layout_t  layout)
+{
+  _integration_layout = layout;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Resize particle set buffers if needed.
@@ -1188,13 +1490,63 @@ cs_lagr_particle_set_resize(cs_lnum_t  n_min_particles)
   return retval;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Release unused particle set buffer memory.
+ *
+ * This function should be called once particles which left the domain
+ * have been removed from the set. The buffer is reduced (to the size
+ * which would be used for growth) as soon as it exceeds the size required
+ * for the current number of particles by more than the square of the
+ * reallocation factor. As growth uses the reallocation factor itself,
+ * the number of particles must vary by about that factor between
+ * successive reallocations, which avoids alternating reallocations when
+ * it oscillates.
+ *
+ * \return  1 if resizing was done, 0 otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_lagr_particle_set_shrink(void)
+{
+  cs_lagr_particle_set_t *particle_set = cs_glob_lagr_particle_set;
+
+  if (particle_set == NULL)
+    return 0;
+
+  const cs_lnum_t n_particles = particle_set->n_particles;
+  const double f = _reallocation_factor;
+
+  if (  particle_set->n_particles_max
+      <= _particle_set_buffer_size(n_particles, f*f))
+    return 0;
+
+  _particle_set_realloc(particle_set,
+                        _particle_set_buffer_size(n_particles, f));
+
+  return 1;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Set reallocation factor for particle sets.
  *
- * This factor determines the multiplier used for reallocations when
+ * This factor determines the margin used for reallocations when
  * the particle set's buffers are too small to handle the new number of
- * particles.
+ * particles: the buffer size is then the required number of particles
+ * times this factor, rounded up to a multiple of a fixed chunk size
+ * (1024 particles). The default value is 1.1.
+ *
+ * Once \ref cs_lagr_particle_set_shrink has been called, the buffer
+ * holds at most f^2 times the number of particles (plus one chunk).
+ * The buffer is a single allocation, so during a reallocation, the
+ * previous and new buffers coexist, and memory use may temporarily reach
+ * (1 + f) times the required number of particles (plus one chunk).
+ * With the default AoS layout, large buffers are usually reallocated by
+ * remapping memory pages, which avoids this. Conversions to and from
+ * the SoA layout (see \ref cs_lagr_set_integration_layout) also
+ * temporarily require a second buffer of the same size.
  *
  * \param[in]  f  reallocation size multiplier
  */
@@ -1241,6 +1593,48 @@ cs_lagr_set_n_g_particles_max(unsigned long long  n_g_particles_max)
   _n_g_max_particles = n_g_particles_max;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get pointer to contiguous data of a given particle in a set.
+ *
+ * With the \ref CS_LAGR_PARTICLE_AOS layout, this is a pointer to the
+ * particle's data in the set. Otherwise, the particle's data is copied
+ * to the given buffer, so that it may be accessed using functions
+ * such as \ref cs_lagr_particle_attr_const (but not modified).
+ *
+ * \param[in]   particles    associated particle set
+ * \param[in]   particle_id  id of particle
+ * \param[out]  buf          work buffer, of size p_am->extents
+ *
+ * \return  pointer to particle data
+ */
+/*----------------------------------------------------------------------------*/
+
+const void *
+cs_lagr_particles_record(const cs_lagr_particle_set_t  *particles,
+                         cs_lnum_t                      particle_id,
+                         unsigned char                  buf[])
+{
+  const cs_lagr_attribute_map_t  *p_am = particles->p_am;
+
+  if (particles->layout == CS_LAGR_PARTICLE_AOS)
+    return particles->p_buffer + p_am->extents*particle_id;
+
+  ptrdiff_t r_displ[3*CS_LAGR_N_ATTRIBUTES + 1];
+  size_t r_size[3*CS_LAGR_N_ATTRIBUTES + 1];
+
+  int n_regions = _data_regions(p_am, r_displ, r_size);
+  const unsigned char *p_buf = particles->p_buffer;
+  cs_lnum_t n_max = particles->n_particles_max;
+
+  for (int r_id = 0; r_id < n_regions; r_id++)
+    memcpy(buf + r_displ[r_id],
+           p_buf + r_displ[r_id]*n_max + r_size[r_id]*particle_id,
+           r_size[r_id]);
+
+  return buf;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Copy current attributes to previous attributes.
@@ -1255,18 +1649,18 @@ cs_lagr_particles_current_to_previous(cs_lagr_particle_set_t  *particles,
                                       cs_lnum_t                particle_id)
 {
   const cs_lagr_attribute_map_t  *p_am = particles->p_am;
-  unsigned char *p_buf = particles->p_buffer + p_am->extents*(particle_id);
 
   for (cs_lagr_attribute_t attr = 0;
        attr < CS_LAGR_N_ATTRIBUTES;
        attr++) {
     if (p_am->count[1][attr] > 0 && p_am->count[0][attr] > 0) {
-      memcpy(p_buf + p_am->displ[1][attr],
-             p_buf + p_am->displ[0][attr],
+      memcpy(cs_lagr_particles_attr_n(particles, particle_id, 1, attr),
+             cs_lagr_particles_attr_n(particles, particle_id, 0, attr),
              p_am->size[attr]);
     }
   }
-  *((cs_lnum_t *)(p_buf + p_am->displ[1][CS_LAGR_RANK_ID])) = cs_glob_rank_id;
+  cs_lagr_particles_set_lnum_n(particles, particle_id, 1, CS_LAGR_RANK_ID,
+                               cs_glob_rank_id);
 }
 
 /*----------------------------------------------------------------------------*/
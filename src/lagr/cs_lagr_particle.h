@@ -182,6 +182,19 @@ typedef enum {
 
 } cs_lagr_attribute_t;
 
+/*! Particle set data layout */
+/* ------------------------- */
+
+typedef enum {
+
+  CS_LAGR_PARTICLE_AOS,       /*!< array of structures: all attributes of
+                                   a given particle are contiguous */
+  CS_LAGR_PARTICLE_SOA        /*!< structure of arrays: values of a given
+                                   attribute are contiguous for all
+                                   particles */
+
+} cs_lagr_particle_layout_t;
+
 /*! Particle attribute structure mapping */
 /* ------------------------------------- */
 
@@ -241,6 +254,8 @@ typedef struct {
 
   cs_lnum_t  n_particles_max;
 
+  cs_lagr_particle_layout_t       layout;     /*!< data layout of p_buffer */
+
   const cs_lagr_attribute_map_t  *p_am;       /*!< particle attributes maps
                                                    (p_am + i for time n-i) */
   unsigned char                  *p_buffer;   /*!< Particles data buffer */
@@ -396,6 +411,92 @@ cs_lagr_particle_attr_in_range(int  attr);
 cs_lagr_particle_set_t  *
 cs_lagr_get_particle_set(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Convert the data layout of a particle set.
+ *
+ * Functions accessing particles through the particle set (such as
+ * \ref cs_lagr_particles_attr or \ref cs_lagr_particles_get_real)
+ * handle both layouts, but functions accessing particle data directly
+ * through a pointer to a particle's data (such as \ref cs_lagr_particle_attr),
+ * or accessing \c p_buffer otherwise, require the
+ * \ref CS_LAGR_PARTICLE_AOS layout.
+ *
+ * \param[in, out]  particles  associated particle set
+ * \param[in]       layout     requested data layout
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_particle_set_layout(cs_lagr_particle_set_t     *particles,
+                            cs_lagr_particle_layout_t   layout);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get data layout used for particle integration and statistics.
+ *
+ * \return  particle set layout used for integration and statistics stages
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_particle_layout_t
+cs_lagr_get_integration_layout(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set data layout used for particle integration and statistics.
+ *
+ * By default, the \ref CS_LAGR_PARTICLE_AOS layout is used throughout.
+ * With the \ref CS_LAGR_PARTICLE_SOA layout, the main particle set is
+ * converted to that layout for the integration of the stochastic
+ * differential equations (without deposition model) and the update of
+ * statistics, which access a few attributes of all particles, then
+ * converted back. User-defined external forces and mesh-based moment
+ * data functions must then access particles through the particle set.
+ *
+ * \param[in]  layout  particle set layout for integration and statistics
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_set_integration_layout(cs_lagr_particle_layout_t  layout);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get pointer to data of a given particle in a set.
+ *
+ * With the \ref CS_LAGR_PARTICLE_SOA layout, data located at a given
+ * displacement in the particle structure are stored contiguously for
+ * all particles, starting at this displacement multiplied by the maximum
+ * number of particles of the set.
+ *
+ * \param[in]  particle_set  pointer to particle set
+ * \param[in]  particle_id   particle id
+ * \param[in]  time_id       0 for current, 1 for previous
+ * \param[in]  attr          requested attribute id
+ *
+ * \return    pointer to attribute data
+ */
+/*----------------------------------------------------------------------------*/
+
+inline static unsigned char *
+cs_lagr_particles_data_ptr(const cs_lagr_particle_set_t  *particle_set,
+                           cs_lnum_t                      particle_id,
+                           int                            time_id,
+                           cs_lagr_attribute_t            attr)
+{
+  const cs_lagr_attribute_map_t *p_am = particle_set->p_am;
+
+  if (particle_set->layout == CS_LAGR_PARTICLE_AOS)
+    return   particle_set->p_buffer
+           + p_am->extents*particle_id
+           + p_am->displ[time_id][attr];
+  else
+    return   particle_set->p_buffer
+           + p_am->displ[time_id][attr]*particle_set->n_particles_max
+           + p_am->size[attr]*particle_id;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Get pointer to a current attribute of a given particle in a set.
@@ -415,9 +516,7 @@ cs_lagr_particles_attr(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  return   (unsigned char *)particle_set->p_buffer
-         + particle_set->p_am->extents*particle_id
-         + particle_set->p_am->displ[0][attr];
+  return cs_lagr_particles_data_ptr(particle_set, particle_id, 0, attr);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -440,9 +539,7 @@ cs_lagr_particles_attr_const(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  return   particle_set->p_buffer
-         + particle_set->p_am->extents*particle_id
-         + particle_set->p_am->displ[0][attr];
+  return cs_lagr_particles_data_ptr(particle_set, particle_id, 0, attr);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -467,9 +564,7 @@ cs_lagr_particles_attr_n(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  return   particle_set->p_buffer
-         + particle_set->p_am->extents*particle_id
-         + particle_set->p_am->displ[time_id][attr];
+  return cs_lagr_particles_data_ptr(particle_set, particle_id, time_id, attr);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -494,9 +589,7 @@ cs_lagr_particles_attr_n_const(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  return   particle_set->p_buffer
-         + particle_set->p_am->extents*particle_id
-         + particle_set->p_am->displ[time_id][attr];
+  return cs_lagr_particles_data_ptr(particle_set, particle_id, time_id, attr);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -517,9 +610,8 @@ cs_lagr_particles_get_flag(const cs_lagr_particle_set_t  *particle_set,
                            int                            mask)
 {
   int flag
-    = *((const cs_lnum_t *)(  particle_set->p_buffer
-                            + particle_set->p_am->extents*particle_id
-                            + particle_set->p_am->displ[0][CS_LAGR_P_FLAG]));
+    = *((const cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id,
+                                                      0, CS_LAGR_P_FLAG));
 
   return (flag & mask);
 }
@@ -540,15 +632,13 @@ cs_lagr_particles_set_flag(const cs_lagr_particle_set_t  *particle_set,
                            int                            mask)
 {
   int flag
-    = *((const cs_lnum_t *)(  particle_set->p_buffer
-                            + particle_set->p_am->extents*particle_id
-                            + particle_set->p_am->displ[0][CS_LAGR_P_FLAG]));
+    = *((const cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id,
+                                                      0, CS_LAGR_P_FLAG));
 
   flag = flag | mask;
 
-  *((cs_lnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[0][CS_LAGR_P_FLAG])) = flag;
+  *((cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, 0,
+                                            CS_LAGR_P_FLAG)) = flag;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -567,15 +657,13 @@ cs_lagr_particles_unset_flag(const cs_lagr_particle_set_t  *particle_set,
                              int                            mask)
 {
   int flag
-    = *((const cs_lnum_t *)(  particle_set->p_buffer
-                            + particle_set->p_am->extents*particle_id
-                            + particle_set->p_am->displ[0][CS_LAGR_P_FLAG]));
+    = *((const cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id,
+                                                      0, CS_LAGR_P_FLAG));
 
   flag = (flag | mask) - mask;
 
-  *((cs_lnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[0][CS_LAGR_P_FLAG])) = flag;
+  *((cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, 0,
+                                            CS_LAGR_P_FLAG)) = flag;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -597,9 +685,8 @@ cs_lagr_particles_get_lnum(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  return *((const cs_lnum_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[0][attr]));
+  return *((const cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, 0, attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -624,9 +711,9 @@ cs_lagr_particles_get_lnum_n(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  return *((const cs_lnum_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[time_id][attr]));
+  return *((const cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, time_id,
+                                                         attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -648,9 +735,8 @@ cs_lagr_particles_set_lnum(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  *((cs_lnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[0][attr])) = value;
+  *((cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, 0,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -675,9 +761,8 @@ cs_lagr_particles_set_lnum_n(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  *((cs_lnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[time_id][attr])) = value;
+  *((cs_lnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, time_id,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -699,9 +784,8 @@ cs_lagr_particles_get_gnum(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  return *((const cs_gnum_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[0][attr]));
+  return *((const cs_gnum_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, 0, attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -726,9 +810,9 @@ cs_lagr_particles_get_gnum_n(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  return *((const cs_gnum_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[time_id][attr]));
+  return *((const cs_gnum_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, time_id,
+                                                         attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -750,9 +834,8 @@ cs_lagr_particles_set_gnum(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  *((cs_gnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[0][attr])) = value;
+  *((cs_gnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, 0,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -777,9 +860,8 @@ cs_lagr_particles_set_gnum_n(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  *((cs_gnum_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[time_id][attr])) = value;
+  *((cs_gnum_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, time_id,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -801,9 +883,8 @@ cs_lagr_particles_get_real(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  return *((const cs_real_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[0][attr]));
+  return *((const cs_real_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, 0, attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -828,9 +909,9 @@ cs_lagr_particles_get_real_n(const cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  return *((const cs_real_t *)(  particle_set->p_buffer
-                               + particle_set->p_am->extents*particle_id
-                               + particle_set->p_am->displ[time_id][attr]));
+  return *((const cs_real_t *)cs_lagr_particles_data_ptr(particle_set,
+                                                         particle_id, time_id,
+                                                         attr));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -852,9 +933,8 @@ cs_lagr_particles_set_real(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[0][attr] > 0);
 
-  *((cs_real_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[0][attr])) = value;
+  *((cs_real_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, 0,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -879,9 +959,8 @@ cs_lagr_particles_set_real_n(cs_lagr_particle_set_t  *particle_set,
 {
   assert(particle_set->p_am->count[time_id][attr] > 0);
 
-  *((cs_real_t *)(  particle_set->p_buffer
-                  + particle_set->p_am->extents*particle_id
-                  + particle_set->p_am->displ[time_id][attr])) = value;
+  *((cs_real_t *)cs_lagr_particles_data_ptr(particle_set, particle_id, time_id,
+                                            attr)) = value;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -905,9 +984,17 @@ cs_lagr_particles_source_terms(cs_lagr_particle_set_t  *particle_set,
   assert(particle_set->p_am->source_term_displ != NULL);
   assert(particle_set->p_am->source_term_displ[attr] >= 0);
 
-  return (cs_real_t *)(  (unsigned char *)particle_set->p_buffer
-                       + particle_set->p_am->extents*particle_id
-                       + particle_set->p_am->source_term_displ[attr]);
+  const cs_lagr_attribute_map_t *p_am = particle_set->p_am;
+
+  if (particle_set->layout == CS_LAGR_PARTICLE_AOS)
+    return (cs_real_t *)(  particle_set->p_buffer
+                         + p_am->extents*particle_id
+                         + p_am->source_term_displ[attr]);
+  else
+    return (cs_real_t *)(  particle_set->p_buffer
+                         + p_am->source_term_displ[attr]
+                           *particle_set->n_particles_max
+                         + p_am->size[attr]*particle_id);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -931,9 +1018,17 @@ cs_lagr_particles_source_terms_const(cs_lagr_particle_set_t  *particle_set,
   assert(particle_set->p_am->source_term_displ != NULL);
   assert(particle_set->p_am->source_term_displ[attr] >= 0);
 
-  return (const cs_real_t *)(  (unsigned char *)particle_set->p_buffer
-                             + particle_set->p_am->extents*particle_id
-                             + particle_set->p_am->source_term_displ[attr]);
+  const cs_lagr_attribute_map_t *p_am = particle_set->p_am;
+
+  if (particle_set->layout == CS_LAGR_PARTICLE_AOS)
+    return (const cs_real_t *)(  particle_set->p_buffer
+                               + p_am->extents*particle_id
+                               + p_am->source_term_displ[attr]);
+  else
+    return (const cs_real_t *)(  particle_set->p_buffer
+                               + p_am->source_term_displ[attr]
+                                 *particle_set->n_particles_max
+                               + p_am->size[attr]*particle_id);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1385,12 +1480,35 @@ cs_lagr_particle_source_term_const(void                           *particle,
 int
 cs_lagr_particle_set_resize(cs_lnum_t  n_min_particles);
 
+/*----------------------------------------------------------------------------
+ * Release unused particle set buffer memory.
+ *
+ * This function should be called once particles which left the domain
+ * have been removed from the set. The buffer is reduced (to the size
+ * which would be used for growth) as soon as it exceeds the size required
+ * for the current number of particles by more than the square of the
+ * reallocation factor.
+ *
+ * returns:
+ *   1 if resizing was done, 0 otherwise
+ *----------------------------------------------------------------------------*/
+
+int
+cs_lagr_particle_set_shrink(void);
+
 /*----------------------------------------------------------------------------
  * Set reallocation factor for particle sets.
  *
- * This factor determines the multiplier used for reallocations when
+ * This factor determines the margin used for reallocations when
  * the particle set's buffers are too small to handle the new number of
- * particles.
+ * particles: the buffer size is then the required number of particles
+ * times this factor, rounded up to a multiple of a fixed chunk size
+ * (1024 particles). The default value is 1.1.
+ *
+ * Once cs_lagr_particle_set_shrink() has been called, the buffer holds
+ * at most f^2 times the number of particles (plus one chunk). During a
+ * reallocation, the previous and new buffers coexist, so memory use may
+ * temporarily reach (1 + f) times the required number of particles.
  *
  * parameters:
  *  f <-- reallocation size multiplier
@@ -1427,6 +1545,28 @@ cs_lagr_get_n_g_particles_max(void);
 void
 cs_lagr_set_n_g_particles_max(unsigned long long  n_g_particles_max);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get pointer to contiguous data of a given particle in a set.
+ *
+ * With the \ref CS_LAGR_PARTICLE_AOS layout, this is a pointer to the
+ * particle's data in the set. Otherwise, the particle's data is copied
+ * to the given buffer, so that it may be accessed using functions
+ * such as \ref cs_lagr_particle_attr_const (but not modified).
+ *
+ * \param[in]   particles    associated particle set
+ * \param[in]   particle_id  id of particle
+ * \param[out]  buf          work buffer, of size p_am->extents
+ *
+ * \return  pointer to particle data
+ */
+/*----------------------------------------------------------------------------*/
+
+const void *
+cs_lagr_particles_record(const cs_lagr_particle_set_t  *particles,
+                         cs_lnum_t                      particle_id,
+                         unsigned char                  buf[]);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Copy current attributes to previous attributes.
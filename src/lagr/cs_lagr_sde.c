@@ -36,6 +36,7 @@
  *----------------------------------------------------------------------------*/
 
 #include <math.h>
+#include <string.h>
 
 /*----------------------------------------------------------------------------
  *  Local headers
@@ -52,6 +53,7 @@
 #include "cs_prototypes.h"
 #include "cs_random.h"
 #include "cs_thermal_model.h"
+#include "cs_time_step.h"
 #include "cs_turbulence_model.h"
 
 #include "cs_lagr.h"
@@ -81,6 +83,10 @@ BEGIN_C_DECLS
 /* Boltzmann constant */
 static const double _k_boltz = 1.38e-23;
 
+/* Use counter-based random number generation for Gaussian variables */
+
+static bool _counter_based_random = false;
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -175,7 +181,6 @@ _lages1(cs_real_t           dtp,
 {
   /* Particles management */
   cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
-  const cs_lagr_attribute_map_t  *p_am = p_set->p_am;
 
   cs_lagr_extra_module_t *extra = cs_get_lagr_extra_module();
 
@@ -230,13 +235,10 @@ _lages1(cs_real_t           dtp,
   cs_lnum_t n_particles_prev = p_set->n_particles - p_set->n_part_new;
   for (cs_lnum_t ip = 0; ip < n_particles_prev; ip++) {
 
-    unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
     if (cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED))
         continue;
 
-    cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
-                                                  CS_LAGR_CELL_ID);
+    cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, ip, CS_LAGR_CELL_ID);
 
     cs_real_t *cell_cen = cs_glob_mesh_quantities->cell_cen + (3*cell_id);
 
@@ -245,18 +247,18 @@ _lages1(cs_real_t           dtp,
 
     /* Get particle coordinates, velocity and velocity seen*/
 
-    cs_real_t *old_part_vel      = cs_lagr_particle_attr_n(particle, p_am, 1,
-                                                           CS_LAGR_VELOCITY);
-    cs_real_t *old_part_vel_seen = cs_lagr_particle_attr_n(particle, p_am, 1,
-                                                           CS_LAGR_VELOCITY_SEEN);
-    cs_real_t *old_part_coords   = cs_lagr_particle_attr_n(particle, p_am, 1,
-                                                           CS_LAGR_COORDS);
-    cs_real_t *part_vel          = cs_lagr_particle_attr(particle, p_am,
-                                                         CS_LAGR_VELOCITY);
-    cs_real_t *part_vel_seen     = cs_lagr_particle_attr(particle, p_am,
-                                                         CS_LAGR_VELOCITY_SEEN);
-    cs_real_t *part_coords       = cs_lagr_particle_attr(particle, p_am,
-                                                         CS_LAGR_COORDS);
+    cs_real_t *old_part_vel      = cs_lagr_particles_attr_n(p_set, ip, 1,
+                                                            CS_LAGR_VELOCITY);
+    cs_real_t *old_part_vel_seen = cs_lagr_particles_attr_n(p_set, ip, 1,
+                                                            CS_LAGR_VELOCITY_SEEN);
+    cs_real_t *old_part_coords   = cs_lagr_particles_attr_n(p_set, ip, 1,
+                                                            CS_LAGR_COORDS);
+    cs_real_t *part_vel          = cs_lagr_particles_attr(p_set, ip,
+                                                          CS_LAGR_VELOCITY);
+    cs_real_t *part_vel_seen     = cs_lagr_particles_attr(p_set, ip,
+                                                          CS_LAGR_VELOCITY_SEEN);
+    cs_real_t *part_coords       = cs_lagr_particles_attr(p_set, ip,
+                                                          CS_LAGR_COORDS);
 
     cs_real_3_t loc_fluid_vel ;
     if (cs_glob_lagr_time_scheme->interpol_field == 1) {
@@ -369,8 +371,8 @@ _lages1(cs_real_t           dtp,
       case CS_LAGR_SHAPE_SPHEROID_JEFFERY_MODEL:
         {
           // Use Euler angles for spheroids (Jeffery)
-          const cs_real_t *euler = cs_lagr_particle_attr(particle, p_am,
-                                                         CS_LAGR_EULER);
+          const cs_real_t *euler = cs_lagr_particles_attr(p_set, ip,
+                                                          CS_LAGR_EULER);
 
           trans_m[0][0] = 2.*(euler[0]*euler[0]+euler[1]*euler[1]-0.5);
           trans_m[0][1] = 2.*(euler[1]*euler[2]+euler[0]*euler[3]);
@@ -387,8 +389,8 @@ _lages1(cs_real_t           dtp,
       case CS_LAGR_SHAPE_SPHEROID_STOC_MODEL:
         {
           // Use rotation matrix for stochastic model
-          cs_real_t *orient_loc  = cs_lagr_particle_attr(particle, p_am,
-                                                         CS_LAGR_ORIENTATION);
+          cs_real_t *orient_loc  = cs_lagr_particles_attr(p_set, ip,
+                                                          CS_LAGR_ORIENTATION);
           cs_real_t singularity_axis[3] = {1.0, 0.0, 0.0};
           // Get vector for rotation
           cs_real_t n_rot[3];
@@ -444,10 +446,9 @@ _lages1(cs_real_t           dtp,
       if (   cs_glob_lagr_model->shape == CS_LAGR_SHAPE_SPHEROID_STOC_MODEL
           || cs_glob_lagr_model->shape == CS_LAGR_SHAPE_SPHEROID_JEFFERY_MODEL) {
 
-        cs_real_t *radii = cs_lagr_particle_attr(particle, p_am, CS_LAGR_RADII);
+        cs_real_t *radii = cs_lagr_particles_attr(p_set, ip, CS_LAGR_RADII);
 
-        cs_real_t *s_p = cs_lagr_particle_attr(particle, p_am,
-                                               CS_LAGR_SHAPE_PARAM);
+        cs_real_t *s_p = cs_lagr_particles_attr(p_set, ip, CS_LAGR_SHAPE_PARAM);
 
         taup_r[0] = 3.0 / 8.0 * taup[ip] * (radii[0]*radii[0]*s_p[0] + s_p[3])
                     / pow(radii[0]*radii[1]*radii[2], 2.0 / 3.0);
@@ -620,8 +621,7 @@ _lages1(cs_real_t           dtp,
             tempf += tkelvi;
         }
 
-        cs_real_t p_mass = cs_lagr_particle_get_real(particle, p_am,
-                                                     CS_LAGR_MASS);
+        cs_real_t p_mass = cs_lagr_particles_get_real(p_set, ip, CS_LAGR_MASS);
 
         cs_real_t ddbr = sqrt(2.0 * _k_boltz * tempf / (p_mass * taup_r[id]));
 
@@ -746,7 +746,6 @@ _lages2(cs_real_t           dtp,
 
   /* Particles management */
   cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
-  const cs_lagr_attribute_map_t  *p_am = p_set->p_am;
 
   cs_lagr_extra_module_t *extra = cs_get_lagr_extra_module();
 
@@ -810,15 +809,13 @@ _lages2(cs_real_t           dtp,
 
       for (cs_lnum_t ip = 0; ip < n_particles_prev; ip++) {
 
-        unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
         if (cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED))
           continue;
 
         aux0     = -dtp / taup[ip];
         aux1     =  exp(aux0);
         tsfext[ip] =   taup[ip]
-                     * cs_lagr_particle_get_real(particle, p_am, CS_LAGR_MASS)
+                     * cs_lagr_particles_get_real(p_set, ip, CS_LAGR_MASS)
                      * (-aux1 + (aux1 - 1.0) / aux0);
 
       }
@@ -828,19 +825,17 @@ _lages2(cs_real_t           dtp,
     /* Load terms at t = t_n : */
     for (cs_lnum_t ip = 0; ip < n_particles_prev; ip++) {
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
       if (cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED))
         continue;
 
-      cs_real_t *old_part_vel      = cs_lagr_particle_attr_n(particle, p_am,
-                                                             1, CS_LAGR_VELOCITY);
-      cs_real_t *old_part_vel_seen = cs_lagr_particle_attr_n(particle, p_am,
-                                                             1, CS_LAGR_VELOCITY_SEEN);
-      cs_real_t *pred_part_vel_seen = cs_lagr_particle_attr(particle, p_am,
-                                                            CS_LAGR_PRED_VELOCITY_SEEN);
-      cs_real_t *pred_part_vel = cs_lagr_particle_attr(particle, p_am,
-                                                       CS_LAGR_PRED_VELOCITY);
+      cs_real_t *old_part_vel      = cs_lagr_particles_attr_n(p_set, ip,
+                                                              1, CS_LAGR_VELOCITY);
+      cs_real_t *old_part_vel_seen = cs_lagr_particles_attr_n(p_set, ip,
+                                                              1, CS_LAGR_VELOCITY_SEEN);
+      cs_real_t *pred_part_vel_seen = cs_lagr_particles_attr(p_set, ip,
+                                                             CS_LAGR_PRED_VELOCITY_SEEN);
+      cs_real_t *pred_part_vel = cs_lagr_particles_attr(p_set, ip,
+                                                        CS_LAGR_PRED_VELOCITY);
 
       for (cs_lnum_t id = 0; id < 3; id++) {
 
@@ -890,24 +885,22 @@ _lages2(cs_real_t           dtp,
 
     for (cs_lnum_t ip = 0; ip < n_particles_prev; ip++) {
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
       if (   cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED)
-          || cs_lagr_particle_get_lnum(particle, p_am, CS_LAGR_REBOUND_ID) != 0)
+          || cs_lagr_particles_get_lnum(p_set, ip, CS_LAGR_REBOUND_ID) != 0)
         continue;
 
       cs_real_t *part_vel
-        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY);
+        = cs_lagr_particles_attr(p_set, ip, CS_LAGR_VELOCITY);
       cs_real_t *part_vel_seen
-        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY_SEEN);
+        = cs_lagr_particles_attr(p_set, ip, CS_LAGR_VELOCITY_SEEN);
       cs_real_t *old_part_vel
-        = cs_lagr_particle_attr_n(particle, p_am, 1, CS_LAGR_VELOCITY);
+        = cs_lagr_particles_attr_n(p_set, ip, 1, CS_LAGR_VELOCITY);
       cs_real_t *old_part_vel_seen
-        = cs_lagr_particle_attr_n(particle, p_am, 1, CS_LAGR_VELOCITY_SEEN);
+        = cs_lagr_particles_attr_n(p_set, ip, 1, CS_LAGR_VELOCITY_SEEN);
       cs_real_t *pred_part_vel_seen
-        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_PRED_VELOCITY_SEEN);
+        = cs_lagr_particles_attr(p_set, ip, CS_LAGR_PRED_VELOCITY_SEEN);
       cs_real_t *pred_part_vel
-        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_PRED_VELOCITY);
+        = cs_lagr_particles_attr(p_set, ip, CS_LAGR_PRED_VELOCITY);
 
       for (cs_lnum_t id = 0; id < 3; id++) {
 
@@ -941,7 +934,7 @@ _lages2(cs_real_t           dtp,
                      + (tlag[ip][id] / dtp) * aux4 * aux5)
           + auxl[ip * 6 + id] * (1.0 - (aux2 - 1.0) / aux0);
 
-        tapn    = cs_lagr_particle_get_real(particle, p_am, CS_LAGR_TAUP_AUX);
+        tapn    = cs_lagr_particles_get_real(p_set, ip, CS_LAGR_TAUP_AUX);
 
         aux7    = exp(-dtp / tapn);
         aux8    = 1.0 - aux3 * aux7;
@@ -2680,10 +2673,89 @@ _lagdep(cs_real_t           dtp,
 
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Generate Gaussian random values for each particle using
+ *        a counter-based generator.
+ *
+ * The random value associated with each particle at its creation
+ * (CS_LAGR_RANDOM_VALUE) is used as a stream key, and the time step
+ * number and stream id as the counter, so values drawn for a given
+ * particle do not depend on particle ordering or distribution among
+ * threads and ranks.
+ *
+ * \param[in]   p_set      pointer to particle set
+ * \param[in]   stream_id  stream id (to distinguish separate uses)
+ * \param[in]   n_vals     number of values per particle
+ * \param[out]  vals       random values (size: n_particles*n_vals)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_counter_based_normal(const cs_lagr_particle_set_t  *p_set,
+                      int                            stream_id,
+                      cs_lnum_t                      n_vals,
+                      cs_real_t                      vals[])
+{
+  const uint64_t counter
+    = ((uint64_t)cs_glob_time_step->nt_cur << 8) + (uint64_t)stream_id;
+
+  #pragma omp parallel for if (p_set->n_particles > CS_THR_MIN)
+  for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
+
+    cs_real_t p_random = cs_lagr_particles_get_real(p_set, ip,
+                                                    CS_LAGR_RANDOM_VALUE);
+    uint64_t key = 0;
+    memcpy(&key, &p_random, sizeof(cs_real_t));
+
+    cs_random_counter_normal(key, counter, n_vals, vals + ip*n_vals);
+
+  }
+}
+
 /*============================================================================
  * Public function definitions
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Indicate whether Gaussian variables of particle SDEs are drawn
+ *        with a counter-based random number generator.
+ *
+ * \return  true if counter-based generation is used, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_sde_get_counter_based_random(void)
+{
+  return _counter_based_random;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Choose whether Gaussian variables of particle SDEs are drawn
+ *        with a counter-based random number generator.
+ *
+ * By default, values are drawn in a single sequence from the main
+ * (lagged Fibonacci) generator, so they depend on the order of particles
+ * and their distribution among ranks. With the counter-based generator,
+ * values drawn for a given particle depend only on that particle and the
+ * time step number, and may be generated by multiple threads.
+ *
+ * This is not the default, as it changes results relative to previous
+ * versions.
+ *
+ * \param[in]  counter_based  use counter-based generation if true
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_sde_set_counter_based_random(bool  counter_based)
+{
+  _counter_based_random = counter_based;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Integration of particle equations of motion:
@@ -2723,7 +2795,6 @@ cs_lagr_sde(cs_real_t           dt_p,
   cs_real_t *romp;
 
   cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
-  const cs_lagr_attribute_map_t *p_am = p_set->p_am;
 
   BFT_MALLOC(romp, p_set->n_particles, cs_real_t);
 
@@ -2736,19 +2807,18 @@ cs_lagr_sde(cs_real_t           dt_p,
   if (cs_glob_lagr_model->idistu == 1) {
     if (cs_glob_lagr_time_step->nor > 1) {
       for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
-        unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-        cs_real_t *_v_gauss = cs_lagr_particle_attr(particle, p_am,
-                                                    CS_LAGR_V_GAUSS);
+        cs_real_t *_v_gauss = cs_lagr_particles_attr(p_set, ip,
+                                                     CS_LAGR_V_GAUSS);
         for (cs_lnum_t id = 0; id < 3; id++) {
           for (cs_lnum_t ivf = 0; ivf < 3; ivf++)
             vagaus[ip][id][ivf] = _v_gauss[id*3 + ivf];
         }
       }
     }
-    else {
-      for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++)
-        cs_random_normal(9, &(vagaus[ip][0][0]));
-    }
+    else if (_counter_based_random)
+      _counter_based_normal(p_set, 0, 9, (cs_real_t *)vagaus);
+    else /* single batch, equivalent to successive per-particle calls */
+      cs_random_normal(9*p_set->n_particles, (cs_real_t *)vagaus);
   }
 
   else {
@@ -2767,17 +2837,16 @@ cs_lagr_sde(cs_real_t           dt_p,
     BFT_MALLOC(brgaus, p_set->n_particles*6, cs_real_t);
     if (cs_glob_lagr_time_step->nor > 1) {
       for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
-        unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-        cs_real_t *_br_gauss = cs_lagr_particle_attr(particle, p_am,
-                                                     CS_LAGR_BR_GAUSS);
+        cs_real_t *_br_gauss = cs_lagr_particles_attr(p_set, ip,
+                                                      CS_LAGR_BR_GAUSS);
         for (cs_lnum_t id = 0; id < 6; id++)
           brgaus[ip*6 + id] = _br_gauss[id];
       }
     }
-    else {
-      for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++)
-        cs_random_normal(6, &(brgaus[6 * ip]));
-    }
+    else if (_counter_based_random)
+      _counter_based_normal(p_set, 1, 6, brgaus);
+    else
+      cs_random_normal(6*p_set->n_particles, brgaus);
   }
 
   /* Computation of particle density */
@@ -2826,9 +2895,8 @@ cs_lagr_sde(cs_real_t           dt_p,
    * */
   if (cs_glob_lagr_time_scheme->iadded_mass == 0) {
     for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
-                                                    CS_LAGR_CELL_ID);
+      cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, ip,
+                                                     CS_LAGR_CELL_ID);
       for (int id = 0; id < 3; id++) {
         force_p[ip][id] = (- gradpr[cell_id][id] / romp[ip]
           + grav[id] + force_p[ip][id]) * taup[ip];
@@ -2839,9 +2907,8 @@ cs_lagr_sde(cs_real_t           dt_p,
   /* Added-mass term?     */
   else {
     for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
-                                                    CS_LAGR_CELL_ID);
+      cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, ip,
+                                                     CS_LAGR_CELL_ID);
       cs_real_t romf = extra->cromf->val[cell_id];
       for (int id = 0; id < 3; id++) {
         force_p[ip][id] = (- gradpr[cell_id][id] / romp[ip]
@@ -2908,10 +2975,9 @@ cs_lagr_sde(cs_real_t           dt_p,
     if (cs_glob_lagr_time_step->nor == 1) {
 
       for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
-        unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
         if (cs_glob_lagr_model->idistu == 1) {
           cs_real_t *_v_gauss
-            = cs_lagr_particle_attr(particle, p_am, CS_LAGR_V_GAUSS);
+            = cs_lagr_particles_attr(p_set, ip, CS_LAGR_V_GAUSS);
           for (cs_lnum_t id = 0; id < 3; id++) {
             for (cs_lnum_t ivf = 0; ivf < 3; ivf++)
               _v_gauss[id*3 + ivf] = vagaus[ip][id][ivf];
@@ -2919,7 +2985,7 @@ cs_lagr_sde(cs_real_t           dt_p,
         }
         if (cs_glob_lagr_brownian->lamvbr == 1) {
           cs_real_t *_br_gauss
-            = cs_lagr_particle_attr(particle, p_am, CS_LAGR_BR_GAUSS);
+            = cs_lagr_particles_attr(p_set, ip, CS_LAGR_BR_GAUSS);
           for (cs_lnum_t id = 0; id < 6; id++)
             _br_gauss[id] = brgaus[ip*6 + id];
         }
@@ -2960,8 +3026,7 @@ cs_lagr_sde_attr(cs_lagr_attribute_t   attr,
                  cs_real_t            *pip)
 {
   /* Particles management */
-  cs_lagr_particle_set_t         *p_set = cs_glob_lagr_particle_set;
-  const cs_lagr_attribute_map_t  *p_am  = p_set->p_am;
+  cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
 
   int ltsvar = 0;
 
@@ -2978,8 +3043,6 @@ cs_lagr_sde_attr(cs_lagr_attribute_t   attr,
 
     for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
       if (cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED))
         continue;
 
@@ -2993,12 +3056,12 @@ cs_lagr_sde_attr(cs_lagr_attribute_t   attr,
 
       cs_real_t aux1 = cs_glob_lagr_time_step->dtp/tcarac[ip];
       cs_real_t aux2 = exp(-aux1);
-      cs_real_t ter1 = cs_lagr_particle_get_real_n(particle, p_am, 1, attr)*aux2;
+      cs_real_t ter1 = cs_lagr_particles_get_real_n(p_set, ip, 1, attr)*aux2;
       cs_real_t ter2 = pip[ip] * (1.0 - aux2);
 
       /* Pour le cas NORDRE= 1 ou s'il y a rebond,     */
       /* le ETTP suivant est le resultat final    */
-      cs_lagr_particle_set_real(particle, p_am, attr, ter1 + ter2);
+      cs_lagr_particles_set_real(p_set, ip, attr, ter1 + ter2);
 
       /* Pour le cas NORDRE= 2, on calcule en plus TSVAR pour NOR= 2  */
       if (ltsvar) {
@@ -3019,8 +3082,6 @@ cs_lagr_sde_attr(cs_lagr_attribute_t   attr,
           || cs_lagr_particles_get_lnum(p_set, ip, CS_LAGR_REBOUND_ID) > 0)
       continue;
 
-      unsigned char *particle = p_set->p_buffer + p_am->extents * ip;
-
       if (tcarac [ip] <= 0.0)
         bft_error
           (__FILE__, __LINE__, 0,
@@ -3031,14 +3092,14 @@ cs_lagr_sde_attr(cs_lagr_attribute_t   attr,
 
       cs_real_t aux1   = cs_glob_lagr_time_step->dtp / tcarac [ip];
       cs_real_t aux2   = exp(-aux1);
-      cs_real_t ter1   = 0.5 * cs_lagr_particle_get_real_n(particle, p_am, 1,
-                                                           attr) * aux2;
+      cs_real_t ter1   = 0.5 * cs_lagr_particles_get_real_n(p_set, ip, 1,
+                                                            attr) * aux2;
       cs_real_t ter2   = pip [ip] * (1.0 - (1.0 - aux2) / aux1);
 
       /* Pour le cas NORDRE= 2, le ETTP suivant est le resultat final */
       cs_real_t *part_ptsvar = cs_lagr_particles_source_terms(p_set, ip, attr);
-      cs_lagr_particle_set_real(particle, p_am, attr,
-                                *part_ptsvar + ter1 + ter2);
+      cs_lagr_particles_set_real(p_set, ip, attr,
+                                 *part_ptsvar + ter1 + ter2);
 
     }
 
@@ -37,6 +37,39 @@ BEGIN_C_DECLS
  * Public function prototypes
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Indicate whether Gaussian variables of particle SDEs are drawn
+ *        with a counter-based random number generator.
+ *
+ * \return  true if counter-based generation is used, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_sde_get_counter_based_random(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Choose whether Gaussian variables of particle SDEs are drawn
+ *        with a counter-based random number generator.
+ *
+ * By default, values are drawn in a single sequence from the main
+ * (lagged Fibonacci) generator, so they depend on the order of particles
+ * and their distribution among ranks. With the counter-based generator,
+ * values drawn for a given particle depend only on that particle and the
+ * time step number, and may be generated by multiple threads.
+ *
+ * This is not the default, as it changes results relative to previous
+ * versions.
+ *
+ * \param[in]  counter_based  use counter-based generation if true
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_sde_set_counter_based_random(bool  counter_based);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Integration of particle equations of motion:
@@ -261,6 +261,7 @@ typedef struct {
  *============================================================================*/
 
 static  char *_base_stat_activate = NULL;
+static  char *_base_stat_max_level = NULL;
 
 static  bool _restart_info_checked = false;
 static  cs_lagr_moment_restart_info_t *_restart_info = NULL;
@@ -506,17 +507,14 @@ _vol_fraction(const void                 *input,
 
     for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
 
-      unsigned char *particle
-        = p_set->p_buffer + p_set->p_am->extents * part;
+      cs_real_t diam = cs_lagr_particles_get_real(p_set, part,
+                                                  CS_LAGR_DIAMETER);
 
-      cs_real_t diam = cs_lagr_particle_get_real(particle, p_set->p_am,
-                                                 CS_LAGR_DIAMETER);
+      cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, part,
+                                                     CS_LAGR_CELL_ID);
 
-      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                    CS_LAGR_CELL_ID);
-
-      cs_real_t p_weight = cs_lagr_particle_get_real(particle, p_set->p_am,
-                                                     CS_LAGR_STAT_WEIGHT);
+      cs_real_t p_weight = cs_lagr_particles_get_real(p_set, part,
+                                                      CS_LAGR_STAT_WEIGHT);
 
       cs_real_t vol = cs_glob_mesh_quantities->cell_vol[cell_id];
 
@@ -530,22 +528,18 @@ _vol_fraction(const void                 *input,
 
     for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
 
-      unsigned char *particle
-        = p_set->p_buffer + p_set->p_am->extents * part;
-
-      int p_class = cs_lagr_particle_get_lnum(particle,
-                                              p_set->p_am,
-                                              CS_LAGR_STAT_CLASS);
+      int p_class = cs_lagr_particles_get_lnum(p_set, part,
+                                               CS_LAGR_STAT_CLASS);
 
       if (p_class == class_id) {
-        cs_real_t diam = cs_lagr_particle_get_real(particle, p_set->p_am,
-                                                   CS_LAGR_DIAMETER);
+        cs_real_t diam = cs_lagr_particles_get_real(p_set, part,
+                                                    CS_LAGR_DIAMETER);
 
-        cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                      CS_LAGR_CELL_ID);
+        cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, part,
+                                                       CS_LAGR_CELL_ID);
 
-        cs_real_t p_weight = cs_lagr_particle_get_real(particle, p_set->p_am,
-                                                       CS_LAGR_STAT_WEIGHT);
+        cs_real_t p_weight = cs_lagr_particles_get_real(p_set, part,
+                                                        CS_LAGR_STAT_WEIGHT);
 
         cs_real_t vol = cs_glob_mesh_quantities->cell_vol[cell_id];
 
@@ -1654,6 +1648,123 @@ _check_restart(const char                     *name,
   return prev_id;
 }
 
+/*----------------------------------------------------------------------------
+ * Write values defined on a statistics location to a restart file.
+ *
+ * Restart files only handle the main mesh locations, so values defined
+ * on a cell subset (such as a volume zone) are scattered to all cells,
+ * with zero values outside the subset.
+ *
+ * parameters:
+ *   r           <-> pointer to restart file
+ *   sec_name    <-- section name
+ *   location_id <-- associated mesh location id
+ *   dim         <-- values dimension
+ *   vals        <-- values
+ *----------------------------------------------------------------------------*/
+
+static void
+_restart_write_location_values(cs_restart_t     *r,
+                               const char       *sec_name,
+                               int               location_id,
+                               int               dim,
+                               const cs_real_t  *vals)
+{
+  if (location_id <= CS_MESH_LOCATION_VERTICES) {
+    cs_restart_write_section(r,
+                             sec_name,
+                             location_id,
+                             dim,
+                             CS_TYPE_cs_real_t,
+                             vals);
+    return;
+  }
+
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+  const cs_lnum_t n_elts = cs_mesh_location_get_n_elts(location_id)[0];
+  const cs_lnum_t *elt_ids = cs_mesh_location_get_elt_ids_try(location_id);
+
+  cs_real_t *c_vals;
+  BFT_MALLOC(c_vals, n_cells*dim, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_cells*dim; i++)
+    c_vals[i] = 0.;
+
+  for (cs_lnum_t e_id = 0; e_id < n_elts; e_id++) {
+    cs_lnum_t c_id = (elt_ids != NULL) ? elt_ids[e_id] : e_id;
+    for (cs_lnum_t k = 0; k < dim; k++)
+      c_vals[c_id*dim + k] = vals[e_id*dim + k];
+  }
+
+  cs_restart_write_section(r,
+                           sec_name,
+                           CS_MESH_LOCATION_CELLS,
+                           dim,
+                           CS_TYPE_cs_real_t,
+                           c_vals);
+
+  BFT_FREE(c_vals);
+}
+
+/*----------------------------------------------------------------------------
+ * Read values defined on a statistics location from a restart file.
+ *
+ * Values defined on a cell subset are read on all cells, then gathered,
+ * matching _restart_write_location_values.
+ *
+ * parameters:
+ *   r           <-> pointer to restart file
+ *   sec_name    <-- section name
+ *   location_id <-- associated mesh location id
+ *   dim         <-- values dimension
+ *   vals        --> values
+ *
+ * returns:
+ *   CS_RESTART_SUCCESS in case of success, or error code
+ *----------------------------------------------------------------------------*/
+
+static int
+_restart_read_location_values(cs_restart_t  *r,
+                              const char    *sec_name,
+                              int            location_id,
+                              int            dim,
+                              cs_real_t     *vals)
+{
+  if (location_id <= CS_MESH_LOCATION_VERTICES)
+    return cs_restart_read_section(r,
+                                   sec_name,
+                                   location_id,
+                                   dim,
+                                   CS_TYPE_cs_real_t,
+                                   vals);
+
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+  const cs_lnum_t n_elts = cs_mesh_location_get_n_elts(location_id)[0];
+  const cs_lnum_t *elt_ids = cs_mesh_location_get_elt_ids_try(location_id);
+
+  cs_real_t *c_vals;
+  BFT_MALLOC(c_vals, n_cells*dim, cs_real_t);
+
+  int retcode = cs_restart_read_section(r,
+                                        sec_name,
+                                        CS_MESH_LOCATION_CELLS,
+                                        dim,
+                                        CS_TYPE_cs_real_t,
+                                        c_vals);
+
+  if (retcode == CS_RESTART_SUCCESS) {
+    for (cs_lnum_t e_id = 0; e_id < n_elts; e_id++) {
+      cs_lnum_t c_id = (elt_ids != NULL) ? elt_ids[e_id] : e_id;
+      for (cs_lnum_t k = 0; k < dim; k++)
+        vals[e_id*dim + k] = c_vals[c_id*dim + k];
+    }
+  }
+
+  BFT_FREE(c_vals);
+
+  return retcode;
+}
+
 /*----------------------------------------------------------------------------
  * Read restart metadata.
  *
@@ -1947,12 +2058,11 @@ _cs_lagr_moment_restart_read(void)
       char s[64];
       snprintf(s, 64, "lagr_stats:wa:%02d:val", mwa->restart_id);
       _ensure_init_wa(mwa);
-      retcode = cs_restart_read_section(cs_lag_stat_restart,
-                                        s,
-                                        mwa->location_id,
-                                        1,
-                                        CS_TYPE_cs_real_t,
-                                        _mwa_val(mwa));
+      retcode = _restart_read_location_values(cs_lag_stat_restart,
+                                              s,
+                                              mwa->location_id,
+                                              1,
+                                              _mwa_val(mwa));
       _assert_restart_success(retcode);
     }
   }
@@ -1962,12 +2072,11 @@ _cs_lagr_moment_restart_read(void)
     if (mt->restart_id > -1) {
       _ensure_init_moment(mt);
       cs_field_t *f = cs_field_by_id(mt->f_id);
-      retcode = cs_restart_read_section(cs_lag_stat_restart,
-                                        ri->name[mt->restart_id],
-                                        f->location_id,
-                                        f->dim,
-                                        CS_TYPE_cs_real_t,
-                                        f->val);
+      retcode = _restart_read_location_values(cs_lag_stat_restart,
+                                              ri->name[mt->restart_id],
+                                              f->location_id,
+                                              f->dim,
+                                              f->val);
       _assert_restart_success(retcode);
     }
   }
@@ -2820,323 +2929,482 @@ _location_attr(int location_id)
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Update all particle-based moment and time moment accumulators.
+ * \brief Build an index of particles by cell.
+ *
+ * This allows updating statistics element by element, so that each
+ * statistics value is updated only once per time step, and different
+ * elements may be handled by different threads.
+ *
+ * The caller is responsible for freeing the returned arrays.
+ *
+ * \param[in]   p_set     pointer to particle set
+ * \param[in]   n_cells   number of cells
+ * \param[out]  cell_idx  index of particles in each cell (size: n_cells+1)
+ * \param[out]  p_ids     ids of particles in each cell
  */
 /*----------------------------------------------------------------------------*/
 
 static void
-_cs_lagr_stat_update_all(void)
+_particles_by_cell(const cs_lagr_particle_set_t  *p_set,
+                   cs_lnum_t                      n_cells,
+                   cs_lnum_t                    **cell_idx,
+                   cs_lnum_t                    **p_ids)
 {
-  const cs_time_step_t  *ts = cs_glob_time_step;
-  cs_lagr_particle_set_t *p_set = cs_lagr_get_particle_set();
-  const cs_real_t *dt_val = _dt_val();
-  cs_lnum_t dt_mult = (cs_glob_time_step->is_local) ? 1 : 0;
+  const cs_lnum_t n_particles = p_set->n_particles;
 
-  /* First, update mesh-based statistics */
+  cs_lnum_t *_cell_idx, *_p_ids;
+  BFT_MALLOC(_cell_idx, n_cells + 1, cs_lnum_t);
+  BFT_MALLOC(_p_ids, n_particles, cs_lnum_t);
 
-  _cs_lagr_stat_update_mesh_stats(ts);
+  for (cs_lnum_t i = 0; i < n_cells + 1; i++)
+    _cell_idx[i] = 0;
 
-  /* Outer loop in weight accumulators, to avoid recomputing weights
-     too many times */
+  for (cs_lnum_t p_id = 0; p_id < n_particles; p_id++) {
+    cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, p_id,
+                                                   CS_LAGR_CELL_ID);
+    if (cell_id >= 0 && cell_id < n_cells)
+      _cell_idx[cell_id + 1] += 1;
+  }
 
-  for (int wa_id = 0; wa_id < _n_lagr_moments_wa; wa_id++) {
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    _cell_idx[i+1] += _cell_idx[i];
 
-    cs_lagr_moment_wa_t *mwa = _lagr_moments_wa + wa_id;
+  for (cs_lnum_t p_id = 0; p_id < n_particles; p_id++) {
+    cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, p_id,
+                                                   CS_LAGR_CELL_ID);
+    if (cell_id >= 0 && cell_id < n_cells) {
+      _p_ids[_cell_idx[cell_id]] = p_id;
+      _cell_idx[cell_id] += 1;
+    }
+  }
 
-    /* Check if accumulator and associated moments are active here */
+  for (cs_lnum_t i = n_cells; i > 0; i--)
+    _cell_idx[i] = _cell_idx[i-1];
+  _cell_idx[0] = 0;
 
-    if (   mwa->group != CS_LAGR_STAT_GROUP_PARTICLE
-        || mwa->nt_start > ts->nt_cur)
-      continue;
+  *cell_idx = _cell_idx;
+  *p_ids = _p_ids;
+}
 
-    /* Here, only active accumulators are considered */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the current statistical weight of a particle.
+ *
+ * \param[in]       mwa       moment weight accumulator
+ * \param[in]       p_set     pointer to particle set
+ * \param[in]       p_id      particle id
+ * \param[in]       cell_id   particle's cell id
+ * \param[in]       dt        cell time step values
+ * \param[in]       dt_mult   1 for local time step, 0 otherwise
+ * \param[in, out]  p_record  work buffer for particle data functions
+ *
+ * \return  particle weight multiplied by the time step
+ */
+/*----------------------------------------------------------------------------*/
 
-    _ensure_init_wa(mwa);
-    cs_real_t *g_wa_sum = _mwa_val(mwa);
+static inline cs_real_t
+_particle_weight(const cs_lagr_moment_wa_t     *mwa,
+                 const cs_lagr_particle_set_t  *p_set,
+                 cs_lnum_t                      p_id,
+                 cs_lnum_t                      cell_id,
+                 const cs_real_t                dt[],
+                 cs_lnum_t                      dt_mult,
+                 unsigned char                 *p_record)
+{
+  cs_real_t p_weight;
 
-    const cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+  if (mwa->p_data_func == NULL)
+    p_weight = cs_lagr_particles_get_real(p_set, p_id, CS_LAGR_STAT_WEIGHT);
+  else
+    mwa->p_data_func(mwa->data_input,
+                     cs_lagr_particles_record(p_set, p_id, p_record),
+                     p_set->p_am,
+                     &p_weight);
 
-    /* Local weight array allocation */
+  return p_weight * dt[cell_id*dt_mult];
+}
 
-    cs_real_t *restrict l_wa_sum = NULL;
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check if a particle belongs to a given statistical class.
+ *
+ * \param[in]  p_set     pointer to particle set
+ * \param[in]  p_id      particle id
+ * \param[in]  class_id  statistical class id, or 0 for all
+ *
+ * \return  true if the particle is in the given class
+ */
+/*----------------------------------------------------------------------------*/
 
-    /* Compute mesh-based weight now if applicable
-       (possibly sharing it across moments) */
+static inline bool
+_particle_in_class(const cs_lagr_particle_set_t  *p_set,
+                   cs_lnum_t                      p_id,
+                   int                            class_id)
+{
+  if (class_id == 0 || p_set->p_am->displ[0][CS_LAGR_STAT_CLASS] <= 0)
+    return (class_id == 0);
 
-    cs_real_t m_w0[1];
-    cs_real_t *restrict m_weight = _compute_current_weight_m(mwa, dt_val, m_w0);
+  return (   cs_lagr_particles_get_lnum(p_set, p_id, CS_LAGR_STAT_CLASS)
+          == class_id);
+}
 
-    /* Loop on variances first, then means */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update weight accumulator for particle-based weights.
+ *
+ * \param[in, out]  mwa       moment weight accumulator
+ * \param[in]       p_set     pointer to particle set
+ * \param[in]       cell_idx  index of particles in each cell
+ * \param[in]       p_ids     ids of particles in each cell, or NULL
+ *                            if particles are sorted by cell
+ * \param[in]       dt        cell time step values
+ * \param[in]       dt_mult   1 for local time step, 0 otherwise
+ */
+/*----------------------------------------------------------------------------*/
 
-    for (int m_type = CS_LAGR_MOMENT_VARIANCE;
-         m_type >= (int)CS_LAGR_MOMENT_MEAN;
-         m_type--) {
+static void
+_update_wa_p(cs_lagr_moment_wa_t           *mwa,
+             const cs_lagr_particle_set_t  *p_set,
+             const cs_lnum_t                cell_idx[],
+             const cs_lnum_t                p_ids[],
+             const cs_real_t                dt[],
+             cs_lnum_t                      dt_mult)
+{
+  const cs_lnum_t n_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+  const cs_lnum_t *elt_ids = cs_mesh_location_get_elt_ids_try(mwa->location_id);
 
-      for (int i = 0; i < _n_lagr_moments; i++) {
+  cs_real_t *restrict wa_sum = _mwa_val(mwa);
 
-        cs_lagr_moment_t *mt = _lagr_moments + i;
+  const bool use_threads = (mwa->p_data_func == NULL);
 
-        if (   (int)mt->m_type == m_type
-            && mt->wa_id == wa_id
-            && mwa->nt_start > -1
-            && mwa->nt_start <= ts->nt_cur
-            && mt->nt_cur < ts->nt_cur) {
+  unsigned char *p_record = NULL;
+  if (use_threads == false)
+    BFT_MALLOC(p_record, p_set->p_am->extents, unsigned char);
 
-          int attr_id = cs_lagr_stat_type_to_attr_id(mt->stat_type);
+  #pragma omp parallel for if (use_threads && n_elts > CS_THR_MIN)
+  for (cs_lnum_t e_id = 0; e_id < n_elts; e_id++) {
 
-          _ensure_init_moment(mt);
+    const cs_lnum_t cell_id = (elt_ids != NULL) ? elt_ids[e_id] : e_id;
 
-          /* Copy weight sum content to a local array
-             for every new moment inside the current class */
+    cs_real_t w_sum = 0;
 
-          if (m_weight == NULL && l_wa_sum == NULL)
-            BFT_MALLOC(l_wa_sum, n_w_elts, cs_real_t);
+    for (cs_lnum_t i = cell_idx[cell_id]; i < cell_idx[cell_id+1]; i++) {
+      const cs_lnum_t p_id = (p_ids != NULL) ? p_ids[i] : i;
+      if (_particle_in_class(p_set, p_id, mwa->class)) {
+        cs_real_t p_weight = _particle_weight(mwa, p_set, p_id, cell_id,
+                                              dt, dt_mult, p_record);
+        if (p_weight > 1e-100)
+          w_sum += p_weight;
+      }
+    }
 
-          for (cs_lnum_t j = 0; j < n_w_elts; j++)
-            l_wa_sum[j] = g_wa_sum[j];
+    wa_sum[e_id] += w_sum;
 
-          /* Case where data is particle-based */
-          /*-----------------------------------*/
+  }
 
-          if (mt->m_data_func == NULL) {
+  BFT_FREE(p_record);
+}
 
-            cs_field_t *f = cs_field_by_id(mt->f_id);
-            cs_real_t *restrict val = f->val;
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update a given particle-based moment.
+ *
+ * Contributions of the particles in each element are first summed
+ * relative to the previous mean (so as to limit cancellation errors),
+ * and the resulting partial moments are then merged with the previous
+ * moment values, so each moment value is updated only once per time step.
+ *
+ * For a variance, the associated mean is also updated.
+ *
+ * The associated weight accumulator is not updated here, as it is shared
+ * by several moments.
+ *
+ * \param[in, out]  mt        pointer to associated moment
+ * \param[in]       mwa       pointer to associated weight accumulator
+ * \param[in]       p_set     pointer to particle set
+ * \param[in]       cell_idx  index of particles in each cell
+ * \param[in]       p_ids     ids of particles in each cell, or NULL
+ *                            if particles are sorted by cell
+ * \param[in]       dt        cell time step values
+ * \param[in]       dt_mult   1 for local time step, 0 otherwise
+ * \param[in]       nt_cur    current time step number
+ */
+/*----------------------------------------------------------------------------*/
 
-            /* prepare submoment definition */
+static void
+_update_particle_moment(cs_lagr_moment_t              *mt,
+                        const cs_lagr_moment_wa_t     *mwa,
+                        const cs_lagr_particle_set_t  *p_set,
+                        const cs_lnum_t                cell_idx[],
+                        const cs_lnum_t                p_ids[],
+                        const cs_real_t                dt[],
+                        cs_lnum_t                      dt_mult,
+                        int                            nt_cur)
+{
+  const cs_lnum_t n_elts = cs_mesh_location_get_n_elts(mt->location_id)[0];
+  const cs_lnum_t *elt_ids = cs_mesh_location_get_elt_ids_try(mt->location_id);
 
-            cs_lagr_moment_t *mt_mean = NULL;
-            cs_real_t *restrict mean_val = NULL;
+  const int attr_id = cs_lagr_stat_type_to_attr_id(mt->stat_type);
+  const int c_shift = (mt->component_id > 0) ? mt->component_id : 0;
 
-            /* Check if lower moment is defined and attached */
+  const cs_lnum_t dim = mt->dim;
+  const cs_lnum_t data_dim = mt->data_dim;
 
-            if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
-              assert(mt->l_id > -1);
-              mt_mean = _lagr_moments + mt->l_id;
-              _ensure_init_moment(mt_mean);
+  const cs_real_t *restrict wa_sum = _mwa_const_val(mwa);
 
-              cs_field_t *f_mean = cs_field_by_id(mt_mean->f_id);
-              mean_val = f_mean->val;
-            }
+  cs_field_t *f = cs_field_by_id(mt->f_id);
+  cs_real_t *restrict val = f->val;
 
-            cs_real_t *pval = NULL;
-            if (mt->p_data_func != NULL)
-              BFT_MALLOC(pval, mt->data_dim, cs_real_t);
+  /* Mean values are updated with variances */
 
-            for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
+  cs_lagr_moment_t *mt_mean = NULL;
+  cs_real_t *restrict mean_val = val;
 
-              unsigned char *particle
-                = p_set->p_buffer + p_set->p_am->extents * part;
+  if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
+    assert(mt->l_id > -1);
+    mt_mean = _lagr_moments + mt->l_id;
+    _ensure_init_moment(mt_mean);
+    mean_val = cs_field_by_id(mt_mean->f_id)->val;
+  }
 
-              cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                            CS_LAGR_CELL_ID);
+  assert(data_dim <= 4 && dim <= 6);
 
-              int p_class = 0;
-              if (p_set->p_am->displ[0][CS_LAGR_STAT_CLASS] > 0)
-                p_class = cs_lagr_particle_get_lnum(particle,
-                                                    p_set->p_am,
-                                                    CS_LAGR_STAT_CLASS);
+  /* Particle data functions require contiguous data, and are not
+     assumed to be thread-safe */
 
-              if (cell_id >= 0 && (p_class == mt->class || mt->class == 0)) {
+  const bool use_threads = (   mt->p_data_func == NULL
+                            && mwa->p_data_func == NULL);
 
-                /* weight associated to current particle */
+  unsigned char *p_record = NULL;
+  if (use_threads == false)
+    BFT_MALLOC(p_record, p_set->p_am->extents, unsigned char);
 
-                cs_real_t p_weight;
+  #pragma omp parallel for if (use_threads && n_elts > CS_THR_MIN)
+  for (cs_lnum_t e_id = 0; e_id < n_elts; e_id++) {
 
-                if (mwa->p_data_func == NULL)
-                  p_weight = cs_lagr_particle_get_real(particle,
-                                                       p_set->p_am,
-                                                       CS_LAGR_STAT_WEIGHT);
-                else
-                  mwa->p_data_func(mwa->data_input,
-                                   particle,
-                                   p_set->p_am,
-                                   &p_weight);
-                p_weight *= dt_val[cell_id*dt_mult];
-
-                if (mt->p_data_func == NULL)
-                  pval = cs_lagr_particle_attr(particle, p_set->p_am, attr_id);
-                else
-                  mt->p_data_func(mt->data_input, particle, p_set->p_am, pval);
-
-                /* update weight sum with new particle weight */
-                const cs_real_t wa_sum_n = CS_MAX(p_weight + l_wa_sum[cell_id],
-                                                  1e-100);
-
-                if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
-
-                  if (mt->dim == 6) { /* variance-covariance matrix */
-
-                    assert(mt->data_dim == 3);
-
-                    double delta[3], delta_n[3], r[3], m_n[3];
-
-                    for (int l = 0; l < 3; l++) {
-
-                      cs_lnum_t jl = cell_id*6 + l;
-                      cs_lnum_t jml = cell_id*3 + l;
-                      delta[l]   = pval[l] - mean_val[jml];
-                      r[l] = delta[l] * (p_weight / wa_sum_n);
-                      m_n[l] = mean_val[jml] + r[l];
-                      delta_n[l] = pval[l] - m_n[l];
-                      val[jl] = (  val[jl]*l_wa_sum[cell_id]
-                                 + p_weight*delta[l]*delta_n[l]) / wa_sum_n;
-
-                    }
-
-                    /* Covariance terms.
-                       Note we could have a symmetric formula using
-                       0.5*(delta[i]*delta_n[j] + delta[j]*delta_n[i])
-                       instead of
-                       delta[i]*delta_n[j]
-                       but unit tests in cs_moment_test.c do not seem to favor
-                       one variant over the other; we use the simplest one.  */
-
-                    cs_lnum_t j3 = cell_id*6 + 3,
-                              j4 = cell_id*6 + 4,
-                              j5 = cell_id*6 + 5;
-
-                    val[j3] = (  val[j3]*l_wa_sum[cell_id]
-                               + p_weight*delta[0]*delta_n[1]) / wa_sum_n;
-                    val[j4] = (  val[j4]*l_wa_sum[cell_id]
-                               + p_weight*delta[1]*delta_n[2]) / wa_sum_n;
-                    val[j5] = (  val[j5]*l_wa_sum[cell_id]
-                               + p_weight*delta[0]*delta_n[2]) / wa_sum_n;
+    const cs_lnum_t cell_id = (elt_ids != NULL) ? elt_ids[e_id] : e_id;
 
-                    /* update mean value */
+    cs_real_t *restrict m = mean_val + e_id*data_dim;
 
-                    for (cs_lnum_t l = 0; l < 3; l++)
-                      mean_val[cell_id*3 + l] += r[l];
+    /* Partial sums for the current time step,
+       relative to the previous mean */
 
-                  }
+    double w_b = 0;
+    double s1[4] = {0, 0, 0, 0};
+    double s2[6] = {0, 0, 0, 0, 0, 0};
 
-                  else { /* simple variance */
+    for (cs_lnum_t i = cell_idx[cell_id]; i < cell_idx[cell_id+1]; i++) {
 
-                    /* new weight for the cell: weight attached to
-                       current particle (=dt*weight) plus old weight */
+      const cs_lnum_t p_id = (p_ids != NULL) ? p_ids[i] : i;
 
-                    const cs_lnum_t dim = mt->dim;
+      if (_particle_in_class(p_set, p_id, mt->class) == false)
+        continue;
 
-                    for (cs_lnum_t l = 0; l < dim; l++) {
+      cs_real_t p_weight = _particle_weight(mwa, p_set, p_id, cell_id,
+                                            dt, dt_mult, p_record);
 
-                      double delta = pval[l] - mean_val[cell_id*dim+l];
-                      double r = delta * (p_weight / wa_sum_n);
-                      double m_n = mean_val[cell_id*dim+l] + r;
+      /* Same filter as for the weight accumulator */
 
-                      val[cell_id*dim+l]
-                        = (  val[cell_id*dim+l]*l_wa_sum[cell_id]
-                           + (p_weight*delta*(pval[l]-m_n))) / wa_sum_n;
+      if (p_weight <= 1e-100)
+        continue;
 
-                      /* update mean value */
+      cs_real_t _pval[4];
+      const cs_real_t *pval = _pval;
 
-                      mean_val[cell_id*dim+l] += r;
+      if (mt->p_data_func == NULL)
+        pval = (const cs_real_t *)cs_lagr_particles_attr_const(p_set, p_id,
+                                                               attr_id)
+               + c_shift;
+      else
+        mt->p_data_func(mt->data_input,
+                        cs_lagr_particles_record(p_set, p_id, p_record),
+                        p_set->p_am,
+                        _pval);
+
+      double dx[4];
+      for (cs_lnum_t l = 0; l < data_dim; l++) {
+        dx[l] = pval[l] - m[l];
+        s1[l] += p_weight*dx[l];
+      }
 
-                    }
+      if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
+        if (dim == 6) {
+          s2[0] += p_weight*dx[0]*dx[0];
+          s2[1] += p_weight*dx[1]*dx[1];
+          s2[2] += p_weight*dx[2]*dx[2];
+          s2[3] += p_weight*dx[0]*dx[1];
+          s2[4] += p_weight*dx[1]*dx[2];
+          s2[5] += p_weight*dx[0]*dx[2];
+        }
+        else {
+          for (cs_lnum_t l = 0; l < dim; l++)
+            s2[l] += p_weight*dx[l]*dx[l];
+        }
+      }
 
-                  }
+      w_b += p_weight;
 
-                }
+    }
 
-                else if (mt->m_type == CS_LAGR_MOMENT_MEAN) {
+    /* Merge with previous values */
 
-                  const cs_lnum_t dim = mt->dim;
+    const double w_a = wa_sum[e_id];
+    const double w_n = CS_MAX(w_a + w_b, 1e-100);
 
-                  for (cs_lnum_t l = 0; l < dim; l++)
-                    val[cell_id*dim+l] +=   (pval[l] - val[cell_id*dim+l])
-                                          * p_weight / wa_sum_n;
+    if (w_b <= 0)
+      continue;
 
-                } /* End of test if moment is a variance or a mean */
+    double d[4];
+    for (cs_lnum_t l = 0; l < data_dim; l++)
+      d[l] = s1[l] / w_b;
 
-                /* update local weight associated to current moment and class */
+    if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
 
-                l_wa_sum[cell_id] += p_weight;
+      cs_real_t *restrict v = val + e_id*dim;
+      const double c = w_b*w_b / w_n;
 
-              } /* End of test if particle is in a cell
-                   and if particle class corresponds to moment class */
+      if (dim == 6) {
+        const int l0[6] = {0, 1, 2, 0, 1, 0};
+        const int l1[6] = {0, 1, 2, 1, 2, 2};
+        for (int l = 0; l < 6; l++)
+          v[l] = (v[l]*w_a + s2[l] - c*d[l0[l]]*d[l1[l]]) / w_n;
+      }
+      else {
+        for (cs_lnum_t l = 0; l < dim; l++)
+          v[l] = (v[l]*w_a + s2[l] - c*d[l]*d[l]) / w_n;
+      }
 
-            } /* end of loop on particles */
+    }
 
-            if (mt->p_data_func != NULL)
-              BFT_FREE(pval);
+    for (cs_lnum_t l = 0; l < data_dim; l++)
+      m[l] += d[l] * (w_b / w_n);
 
-            mt->nt_cur = ts->nt_cur;
-            if (mt->m_type == CS_LAGR_MOMENT_VARIANCE)
-              mt_mean->nt_cur = ts->nt_cur;
-          }
+  }
 
-          /* Case where data is mesh-based */
-          /*-------------------------------*/
+  BFT_FREE(p_record);
 
-          else
-            _cs_lagr_stat_update_mesh_moment(mt,
-                                             mwa,
-                                             m_weight,
-                                             ts->nt_cur);
+  mt->nt_cur = nt_cur;
+  if (mt_mean != NULL)
+    mt_mean->nt_cur = nt_cur;
+}
 
-        } /* end of test if moment is for the current class */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update all particle-based moment and time moment accumulators.
+ */
+/*----------------------------------------------------------------------------*/
 
-      } /* End of loop on moment types */
+static void
+_cs_lagr_stat_update_all(void)
+{
+  const cs_time_step_t  *ts = cs_glob_time_step;
+  cs_lagr_particle_set_t *p_set = cs_lagr_get_particle_set();
+  const cs_real_t *dt_val = _dt_val();
+  cs_lnum_t dt_mult = (cs_glob_time_step->is_local) ? 1 : 0;
 
-    } /* End of loop on moments */
+  /* Index of particles by cell, built when first needed unless
+     the one from the last displacement step covers all particles */
 
-    /* At end of loop on moments inside a class, update
-       global class weight array */
+  const cs_lnum_t *cell_idx = NULL;
+  cs_lnum_t *_cell_idx = NULL, *p_ids = NULL;
 
-    if (l_wa_sum != NULL) {
-      for (cs_lnum_t i = 0; i < n_w_elts; i++)
-        g_wa_sum[i] = l_wa_sum[i];
-      BFT_FREE(l_wa_sum);
-    }
-    else if (m_weight != NULL) {
-      _update_wa_m(mwa, m_weight);
-      if (m_weight != m_w0)
-        BFT_FREE(m_weight);
+  /* First, update mesh-based statistics */
+
+  _cs_lagr_stat_update_mesh_stats(ts);
+
+  /* Outer loop in weight accumulators, to avoid recomputing weights
+     too many times */
+
+  for (int wa_id = 0; wa_id < _n_lagr_moments_wa; wa_id++) {
+
+    cs_lagr_moment_wa_t *mwa = _lagr_moments_wa + wa_id;
+
+    /* Check if accumulator and associated moments are active here */
+
+    if (   mwa->group != CS_LAGR_STAT_GROUP_PARTICLE
+        || mwa->nt_start > ts->nt_cur)
+      continue;
+
+    /* Here, only active accumulators are considered */
+
+    _ensure_init_wa(mwa);
+
+    const cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+
+    /* Compute mesh-based weight now if applicable
+       (possibly sharing it across moments) */
+
+    cs_real_t m_w0[1];
+    cs_real_t *restrict m_weight = _compute_current_weight_m(mwa, dt_val, m_w0);
+
+    if (m_weight == NULL && cell_idx == NULL) {
+      const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+      cell_idx = cs_lagr_tracking_get_cell_particle_index(n_cells);
+      if (cell_idx == NULL || cell_idx[n_cells] != p_set->n_particles) {
+        _particles_by_cell(p_set, n_cells, &_cell_idx, &p_ids);
+        cell_idx = _cell_idx;
+      }
     }
-    else if (n_w_elts > 0) { /* Case where accumulator has no moments */
 
-      for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
+    /* Loop on variances first, then means */
 
-        unsigned char *particle
-          = p_set->p_buffer + p_set->p_am->extents * part;
+    for (int m_type = CS_LAGR_MOMENT_VARIANCE;
+         m_type >= (int)CS_LAGR_MOMENT_MEAN;
+         m_type--) {
 
-        cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                      CS_LAGR_CELL_ID);
+      for (int i = 0; i < _n_lagr_moments; i++) {
 
-        int p_class = 0;
-        if (p_set->p_am->displ[0][CS_LAGR_STAT_CLASS] > 0)
-          p_class = cs_lagr_particle_get_lnum(particle,
-                                              p_set->p_am,
-                                              CS_LAGR_STAT_CLASS);
+        cs_lagr_moment_t *mt = _lagr_moments + i;
 
-        if (cell_id >= 0 && (p_class == mwa->class || mwa->class == 0)) {
+        if (   (int)mt->m_type == m_type
+            && mt->wa_id == wa_id
+            && mwa->nt_start > -1
+            && mwa->nt_start <= ts->nt_cur
+            && mt->nt_cur < ts->nt_cur) {
 
-          /* weight associated to current particle */
+          _ensure_init_moment(mt);
 
-          cs_real_t p_weight;
+          /* Case where data is particle-based */
+
+          if (mt->m_data_func == NULL)
+            _update_particle_moment(mt,
+                                    mwa,
+                                    p_set,
+                                    cell_idx,
+                                    p_ids,
+                                    dt_val,
+                                    dt_mult,
+                                    ts->nt_cur);
+
+          /* Case where data is mesh-based */
 
-          if (mwa->p_data_func == NULL)
-            p_weight = cs_lagr_particle_get_real(particle,
-                                                 p_set->p_am,
-                                                 CS_LAGR_STAT_WEIGHT);
           else
-            mwa->p_data_func(mwa->data_input,
-                             particle,
-                             p_set->p_am,
-                             &p_weight);
-          p_weight *= dt_val[cell_id*dt_mult];
+            _cs_lagr_stat_update_mesh_moment(mt,
+                                             mwa,
+                                             m_weight,
+                                             ts->nt_cur);
 
-          /* update accumulator weight */
+        } /* end of test if moment is for the current class */
 
-          if (p_weight > 1e-100)
-            g_wa_sum[cell_id] += p_weight;
+      } /* End of loop on moment types */
 
-        }
+    } /* End of loop on moments */
 
-      } /* end of loop on particles */
+    /* At end of loop on moments inside a class, update
+       global class weight array */
 
+    if (m_weight != NULL) {
+      _update_wa_m(mwa, m_weight);
+      if (m_weight != m_w0)
+        BFT_FREE(m_weight);
     }
+    else if (n_w_elts > 0)
+      _update_wa_p(mwa, p_set, cell_idx, p_ids, dt_val, dt_mult);
 
   } /* End of loop on active weight accumulators */
+
+  BFT_FREE(p_ids);
+  BFT_FREE(_cell_idx);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -3304,6 +3572,18 @@ _stat_moment_define(const char                *name,
 
   cs_lagr_moment_t *mt = NULL;
 
+  /* Particle-based statistics may be restricted to a subset of cells
+     (such as a volume zone), but are always cell-based */
+
+  if (   stat_group == CS_LAGR_STAT_GROUP_PARTICLE
+      && m_data_func == NULL
+      && cs_mesh_location_get_type(location_id) != CS_MESH_LOCATION_CELLS)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Lagrangian statistics definition for \"%s\":\n"
+                " particle-based statistics require a cell-based"
+                " mesh location."),
+              name);
+
   int moment_dim = (dim == 3 && m_type == CS_LAGR_MOMENT_VARIANCE) ? 6 : dim;
   int moment_id = -1;
   int prev_id = -1, prev_wa_id = -1;
@@ -3728,7 +4008,8 @@ _event_stat_initialize(void)
  * If dimension > 1, the val array is interleaved
  *
  * \param[in]  name           statistics base name
- * \param[in]  location_id    id of associated mesh location
+ * \param[in]  location_id    id of associated mesh location (all cells,
+ *                            or a cell subset such as a volume zone)
  * \param[in]  stat_type      predefined statistics type, or -1
  * \param[in]  m_type         moment type
  * \param[in]  class_id       particle class id, or 0 for all
@@ -4206,6 +4487,47 @@ cs_lagr_stat_activate_time_moment(int                    stat_type,
                                           level);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Limit the highest time moment computed for a predefined Lagrangian
+ *        statistics type.
+ *
+ * By default, activating statistics for a particle attribute defines both
+ * its mean and variance (with 6 components for vector attributes). When
+ * only the mean is needed, limiting the moment order avoids defining and
+ * allocating the variance.
+ *
+ * This limit also applies to statistics activated automatically based on
+ * physical model options. It is ignored if called after
+ * \ref cs_lagr_stat_initialize.
+ *
+ * \param[in]  stat_type   particle statistics type
+ * \param[in]  moment      highest time moment to compute
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stat_set_max_moment(int                    stat_type,
+                            cs_lagr_stat_moment_t  moment)
+{
+  const int n_stat_types = _n_stat_types();
+
+  const int attr_id = cs_lagr_stat_type_to_attr_id(stat_type);
+
+  if (attr_id > -1)
+    cs_lagr_particle_attr_in_range(attr_id);
+  else if (stat_type < 0 || stat_type >= n_stat_types)
+    return;
+
+  if (_base_stat_max_level == NULL) {
+    BFT_MALLOC(_base_stat_max_level, n_stat_types, char);
+    for (int i = 0; i < n_stat_types; i++)
+      _base_stat_max_level[i] = 3;
+  }
+
+  _base_stat_max_level[stat_type] = (moment >= CS_LAGR_MOMENT_VARIANCE) ? 3 : 2;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Deactivate Lagrangian statistics for a given statistics type.
@@ -4415,6 +4737,17 @@ cs_lagr_stat_initialize(void)
 
   _init_vars_attribute();
 
+  /* Limit moment orders where requested, so that unneeded higher order
+     moments are not defined (and their fields not allocated) */
+
+  if (_base_stat_activate != NULL && _base_stat_max_level != NULL) {
+    for (int i = 0; i < _n_stat_types(); i++)
+      _base_stat_activate[i] = CS_MIN(_base_stat_activate[i],
+                                      _base_stat_max_level[i]);
+  }
+
+  BFT_FREE(_base_stat_max_level);
+
   /* init moments */
   char name[64];
 
@@ -5555,12 +5888,11 @@ cs_lagr_stat_restart_write(cs_restart_t  *restart)
                                  f->name);
       }
       snprintf(s, 64, "lagr_stats:wa:%02d:val", i);
-      cs_restart_write_section(restart,
-                               s,
-                               mwa->location_id,
-                               1,
-                               CS_TYPE_cs_real_t,
-                               _mwa_val(mwa));
+      _restart_write_location_values(restart,
+                                     s,
+                                     mwa->location_id,
+                                     1,
+                                     _mwa_val(mwa));
     }
   }
 
@@ -5684,12 +6016,11 @@ cs_lagr_stat_restart_write(cs_restart_t  *restart)
 
       cs_lagr_moment_t *mt = _lagr_moments + i;
       const cs_field_t *f = cs_field_by_id(mt->f_id);
-      cs_restart_write_section(restart,
-                               f->name,
-                               f->location_id,
-                               f->dim,
-                               CS_TYPE_cs_real_t,
-                               f->val);
+      _restart_write_location_values(restart,
+                                     f->name,
+                                     f->location_id,
+                                     f->dim,
+                                     f->val);
 
     }
 
@@ -237,7 +237,8 @@ extern cs_lagr_stat_options_t   *cs_glob_lagr_stat_options;
  * If dimension > 1, the val array is interleaved
  *
  * \param[in]  name           statistics base name
- * \param[in]  location_id    id of associated mesh location
+ * \param[in]  location_id    id of associated mesh location (all cells,
+ *                            or a cell subset such as a volume zone)
  * \param[in]  stat_type      predefined statistics type, or -1
  * \param[in]  stat_group     statistics group (particle or event)
  * \param[in]  m_type         moment type
@@ -484,6 +485,29 @@ void
 cs_lagr_stat_activate_time_moment(int                    stat_type,
                                   cs_lagr_stat_moment_t  moment);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Limit the highest time moment computed for a predefined Lagrangian
+ *        statistics type.
+ *
+ * By default, activating statistics for a particle attribute defines both
+ * its mean and variance (with 6 components for vector attributes). When
+ * only the mean is needed, limiting the moment order avoids defining and
+ * allocating the variance.
+ *
+ * This limit also applies to statistics activated automatically based on
+ * physical model options. It is ignored if called after
+ * \ref cs_lagr_stat_initialize.
+ *
+ * \param[in]  stat_type   particle statistics type
+ * \param[in]  moment      highest time moment to compute
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stat_set_max_moment(int                    stat_type,
+                            cs_lagr_stat_moment_t  moment);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Deactivate Lagrangian statistics for a given statistics type.
@@ -68,6 +68,7 @@
 #include "cs_parall.h"
 #include "cs_porous_model.h"
 #include "cs_random.h"
+#include "cs_rank_neighbors.h"
 #include "cs_rotation.h"
 #include "cs_search.h"
 #include "cs_timer_stats.h"
@@ -170,26 +171,21 @@ typedef struct {
   cs_lnum_t  *transform_id;   /* In case of periodicity, transformation
                                  associated to a given halo cell */
 
-  /* Buffer used to exchange particle between communicating ranks */
+  /* Buffer used to send particles to communicating ranks; it is sized
+     based on the number of particles actually leaving the local domain,
+     and receive counts are determined only when exchanging particles */
 
   size_t      send_buf_size;  /* Current maximum send buffer size */
   size_t      extents;        /* Extents for particle set */
 
   cs_lnum_t  *send_count;     /* number of particles to send to
                                  each communicating rank */
-  cs_lnum_t  *recv_count;     /* number of particles to receive from
-                                 each communicating rank */
-
-  cs_lnum_t  *send_shift;
-  cs_lnum_t  *recv_shift;
+  cs_lnum_t  *send_shift;     /* start of particles to send to each
+                                 communicating rank in send_buf
+                                 (size: n_c_domains + 1) */
 
   unsigned char  *send_buf;
 
-#if defined(HAVE_MPI)
-  MPI_Request  *request;
-  MPI_Status   *status;
-#endif
-
 } cs_lagr_halo_t;
 
 /* Structures useful to build and manage the Lagrangian computation:
@@ -206,6 +202,22 @@ typedef struct {
 
 } cs_lagr_track_builder_t;
 
+/* Thread-local accumulators used during threaded local propagation */
+
+typedef struct {
+
+  cs_lagr_event_set_t  *events;          /* boundary interaction events,
+                                            or NULL */
+  cs_real_t            *b_stat;          /* boundary statistics increments,
+                                            or NULL */
+  cs_real_t            *zone_flow_rate;  /* per-zone particle flow rate
+                                            increments */
+
+  cs_lagr_particle_set_t  counters;      /* particle set with thread-local
+                                            counters */
+
+} _propagation_acc_t;
+
 /*============================================================================
  * Static global variables
  *============================================================================*/
@@ -216,6 +228,16 @@ static  cs_lagr_track_builder_t  *_particle_track_builder = NULL;
 
 static  int            _max_propagation_loops = 100;
 
+/* Status of threaded propagation, and associated time step */
+
+static  bool           _thread_safe_propagation = false;
+static  int            _thread_safe_propagation_nt = -1;
+
+/* Index of particles by cell, built by the last displacement step */
+
+static  cs_lnum_t      _n_cell_particle_idx_cells = 0;
+static  cs_lnum_t     *_cell_particle_idx = NULL;
+
 /* MPI datatype associated to each particle "structure" */
 
 #if defined(HAVE_MPI)
@@ -485,10 +507,8 @@ _create_lagr_halo(size_t  extents)
 
   /* Allocate buffers to enable the exchange between communicating ranks */
 
-  BFT_MALLOC(lagr_halo->send_shift, halo->n_c_domains, cs_lnum_t);
+  BFT_MALLOC(lagr_halo->send_shift, halo->n_c_domains + 1, cs_lnum_t);
   BFT_MALLOC(lagr_halo->send_count, halo->n_c_domains, cs_lnum_t);
-  BFT_MALLOC(lagr_halo->recv_shift, halo->n_c_domains, cs_lnum_t);
-  BFT_MALLOC(lagr_halo->recv_count, halo->n_c_domains, cs_lnum_t);
 
   lagr_halo->send_buf_size = CS_LAGR_MIN_COMM_BUF_SIZE;
 
@@ -496,17 +516,6 @@ _create_lagr_halo(size_t  extents)
              lagr_halo->send_buf_size * extents,
              unsigned char);
 
-#if defined(HAVE_MPI)
-  if (cs_glob_n_ranks > 1) {
-
-    cs_lnum_t  request_size = 2 * halo->n_c_domains;
-
-    BFT_MALLOC(lagr_halo->request, request_size, MPI_Request);
-    BFT_MALLOC(lagr_halo->status,  request_size, MPI_Status);
-
-  }
-#endif
-
   /* Fill rank */
 
   BFT_MALLOC(lagr_halo->rank, n_halo_cells, cs_lnum_t);
@@ -598,15 +607,6 @@ _delete_lagr_halo(cs_lagr_halo_t   **halo)
 
     BFT_FREE(h->send_shift);
     BFT_FREE(h->send_count);
-    BFT_FREE(h->recv_shift);
-    BFT_FREE(h->recv_count);
-
-#if defined(HAVE_MPI)
-    if (cs_glob_n_ranks > 1) {
-      BFT_FREE(h->request);
-      BFT_FREE(h->status);
-    }
-#endif
 
     BFT_FREE(h->send_buf);
 
@@ -946,6 +946,26 @@ _internal_treatment(cs_lagr_particle_set_t  *particles,
   return particle_state;
 }
 
+/*----------------------------------------------------------------------------
+ * Flush boundary interaction events to tracking event statistics.
+ *
+ * Events may be accumulated in thread-local sets during threaded
+ * propagation, so the (shared) statistics update is serialized.
+ *
+ * parameters:
+ *   events  <-> events structure
+ *----------------------------------------------------------------------------*/
+
+static void
+_flush_events(cs_lagr_event_set_t  *events)
+{
+# pragma omp critical (lagr_tracking_events)
+  cs_lagr_stat_update_event(events,
+                            CS_LAGR_STAT_GROUP_TRACKING_EVENT);
+
+  events->n_events = 0;
+}
+
 /*----------------------------------------------------------------------------
  * Add event when particle rolls off an interior face
  *
@@ -966,9 +986,7 @@ _roll_off_event(cs_lagr_particle_set_t    *particles,
 
   cs_lnum_t event_id = events->n_events;
   if (event_id >= events->n_events_max) {
-    cs_lagr_stat_update_event(events,
-                              CS_LAGR_STAT_GROUP_TRACKING_EVENT);
-    events->n_events = 0;
+    _flush_events(events);
     event_id = 0;
   }
   events->n_events += 1;
@@ -1010,6 +1028,8 @@ _roll_off_event(cs_lagr_particle_set_t    *particles,
  *                       point with the face relative to the initial
  *                       trajectory segment
  *   b_z_id          <-- boundary zone id of the matching face
+ *   b_stat          <-> boundary statistics accumulator
+ *   zone_flow_rate  <-> per-zone particle flow rate accumulator
  *
  * returns:
  *   particle state
@@ -1022,7 +1042,9 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
                     cs_lnum_t                  face_id,
                     cs_real_t                 *face_norm,
                     double                     t_intersect,
-                    int                        b_z_id)
+                    int                        b_z_id,
+                    cs_real_t                  b_stat[],
+                    cs_real_t                  zone_flow_rate[])
 {
   const cs_mesh_t  *mesh = cs_glob_mesh;
   const double pi = cs_math_pi;
@@ -1041,8 +1063,6 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
 
   cs_lagr_tracking_state_t  particle_state = CS_LAGR_PART_TO_SYNC;
 
-  cs_lagr_zone_data_t  *bdy_conditions = cs_lagr_get_boundary_conditions();
-
   cs_real_t  energt = 0.;
   cs_lnum_t  contact_number = 0;
   cs_real_t  *surface_coverage = NULL;
@@ -1068,8 +1088,6 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
 
   const char b_type = cs_glob_lagr_boundary_conditions->elt_type[face_id];
 
-  assert(bdy_conditions != NULL);
-
   for (int k = 0; k < 3; k++)
     disp[k] = particle_coord[k] - p_info->start_coords[k];
 
@@ -1099,10 +1117,7 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
 
     event_id = events->n_events;
     if (event_id >= events->n_events_max) {
-      /* flush events */
-      cs_lagr_stat_update_event(events,
-                                CS_LAGR_STAT_GROUP_TRACKING_EVENT);
-      events->n_events = 0;
+      _flush_events(events);
       event_id = 0;
     }
 
@@ -1194,11 +1209,11 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
       /* computation of the number of particles in contact with */
       /* the depositing particle                                */
 
-      surface_coverage = &bound_stat[cs_glob_lagr_boundary_interactions->iscovc * n_b_faces + face_id];
-      deposit_height_mean = &bound_stat[cs_glob_lagr_boundary_interactions->ihdepm * n_b_faces + face_id];
-      deposit_height_var = &bound_stat[cs_glob_lagr_boundary_interactions->ihdepv * n_b_faces + face_id];
+      surface_coverage = &b_stat[cs_glob_lagr_boundary_interactions->iscovc * n_b_faces + face_id];
+      deposit_height_mean = &b_stat[cs_glob_lagr_boundary_interactions->ihdepm * n_b_faces + face_id];
+      deposit_height_var = &b_stat[cs_glob_lagr_boundary_interactions->ihdepv * n_b_faces + face_id];
 
-      deposit_diameter_sum = &bound_stat[cs_glob_lagr_boundary_interactions->ihsum * n_b_faces + face_id];
+      deposit_diameter_sum = &b_stat[cs_glob_lagr_boundary_interactions->ihsum * n_b_faces + face_id];
 
       contact_number = cs_lagr_clogging_barrier(particle,
                                                 p_am,
@@ -1271,7 +1286,7 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
 
       if (cs_glob_lagr_model->clogging) {
 
-        bound_stat[cs_glob_lagr_boundary_interactions->inclgt
+        b_stat[cs_glob_lagr_boundary_interactions->inclgt
                    * n_b_faces + face_id] += particle_stat_weight;
         *deposit_diameter_sum += particle_diameter;
 
@@ -1294,7 +1309,7 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
                                  * particle_stat_weight / face_area, 2)
                                  * pow(depositing_radius,4);
 
-          bound_stat[cs_glob_lagr_boundary_interactions->inclg
+          b_stat[cs_glob_lagr_boundary_interactions->inclg
                      * n_b_faces + face_id] += particle_stat_weight;
 
           /* The particle is replaced towards the cell center
@@ -1777,14 +1792,13 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
     cs_real_t fr =   particle_stat_weight
                    * cs_lagr_particle_get_real(particle, p_am, CS_LAGR_MASS);
 
-    bdy_conditions->particle_flow_rate[b_z_id*n_stats] -= fr;
+    zone_flow_rate[b_z_id*n_stats] -= fr;
 
     if (n_stats > 1) {
       int class_id
         = cs_lagr_particle_get_lnum(particle, p_am, CS_LAGR_STAT_CLASS);
       if (class_id > 0 && class_id < n_stats)
-        bdy_conditions->particle_flow_rate[  b_z_id*n_stats
-                                           + class_id] -= fr;
+        zone_flow_rate[b_z_id*n_stats + class_id] -= fr;
     }
   }
 
@@ -1796,7 +1810,7 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
 
     /* Number of particle-boundary interactions  */
     if (cs_glob_lagr_boundary_interactions->has_part_impact_nbr > 0)
-      bound_stat[cs_glob_lagr_boundary_interactions->inbr * n_b_faces + face_id]
+      b_stat[cs_glob_lagr_boundary_interactions->inbr * n_b_faces + face_id]
         += particle_stat_weight;
 
   }
@@ -1815,6 +1829,9 @@ _boundary_treatment(cs_lagr_particle_set_t    *particles,
  *   failsafe_mode            <-- with (0) / without (1) failure capability
  *   b_face_zone_id           <-- boundary face zone id
  *   visc_length              <-- viscous layer thickness
+ *   u                        <-- fluid velocity field
+ *   b_stat                   <-> boundary statistics accumulator
+ *   zone_flow_rate           <-> per-zone particle flow rate accumulator
  *
  * returns:
  *   a state associated to the status of the particle (treated, to be deleted,
@@ -1829,7 +1846,9 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
                    int                             failsafe_mode,
                    const int                       b_face_zone_id[],
                    const cs_real_t                 visc_length[],
-                   const cs_field_t               *u)
+                   const cs_field_t               *u,
+                   cs_real_t                       b_stat[],
+                   cs_real_t                       zone_flow_rate[])
 {
   cs_real_t  disp[3];
 
@@ -2148,7 +2167,7 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
       */
 
       particle_state
-        = _internal_treatment(cs_glob_lagr_particle_set,
+        = _internal_treatment(particles,
                               p_id,
                               face_id,
                               t_intersect);
@@ -2238,7 +2257,9 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
                               face_id,
                               face_norm,
                               t_intersect,
-                              b_face_zone_id[face_id]);
+                              b_face_zone_id[face_id],
+                              b_stat,
+                              zone_flow_rate);
 
       if (cs_glob_lagr_time_scheme->t_order == 2)
         cs_lagr_particle_set_lnum(particle, p_am, CS_LAGR_REBOUND_ID, 0);
@@ -2255,84 +2276,340 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
 }
 
 /*----------------------------------------------------------------------------
- * Exchange counters on the number of particles to send and to receive
+ * Check if the local propagation of distinct particles may be run
+ * concurrently.
+ *
+ * Clogging and roughness models rely on shared deposit statistics and
+ * random number generation, as does fouling, and user-defined interactions
+ * may modify any data, so propagation remains serial when those are active.
+ *
+ * Boundary conditions are checked based on zone types, while internal
+ * conditions (defined per face) are scanned only once per time step.
+ *
+ * returns:
+ *   true if particles may be propagated by concurrent threads
+ *----------------------------------------------------------------------------*/
+
+static bool
+_propagation_is_thread_safe(void)
+{
+  const int nt_cur = cs_glob_time_step->nt_cur;
+
+  if (_thread_safe_propagation_nt == nt_cur)
+    return _thread_safe_propagation;
+
+  const cs_mesh_t  *mesh = cs_glob_mesh;
+  const cs_lagr_model_t  *lagr_model = cs_glob_lagr_model;
+
+  bool thread_safe = true;
+
+  if (lagr_model->clogging || lagr_model->roughness > 0)
+    thread_safe = false;
+
+  const cs_lagr_zone_data_t  *bdy_cond = cs_glob_lagr_boundary_conditions;
+
+  if (bdy_cond != NULL && bdy_cond->zone_type != NULL) {
+    for (int z_id = 0; z_id < bdy_cond->n_zones; z_id++) {
+      if (   bdy_cond->zone_type[z_id] == CS_LAGR_BC_USER
+          || bdy_cond->zone_type[z_id] == CS_LAGR_FOULING)
+        thread_safe = false;
+    }
+  }
+
+  const cs_lagr_internal_condition_t  *internal_conditions
+    = cs_glob_lagr_internal_conditions;
+
+  if (thread_safe && internal_conditions != NULL) {
+    for (cs_lnum_t i = 0; i < mesh->n_i_faces; i++) {
+      if (internal_conditions->i_face_zone_id[i] == CS_LAGR_BC_USER) {
+        thread_safe = false;
+        break;
+      }
+    }
+  }
+
+  _thread_safe_propagation = thread_safe;
+  _thread_safe_propagation_nt = nt_cur;
+
+  return thread_safe;
+}
+
+/*----------------------------------------------------------------------------
+ * Create thread-local accumulators for threaded local propagation.
  *
  * parameters:
- *  halo        <--  pointer to a cs_halo_t structure
- *  lag_halo    <--  pointer to a cs_lagr_halo_t structure
+ *   n_threads <-- number of threads
+ *   events    <-- shared events structure, or NULL
+ *
+ * returns:
+ *   array of thread-local accumulators
  *----------------------------------------------------------------------------*/
 
-static void
-_exchange_counter(const cs_halo_t  *halo,
-                  cs_lagr_halo_t   *lag_halo)
+static _propagation_acc_t *
+_propagation_acc_create(int                   n_threads,
+                        cs_lagr_event_set_t  *events)
 {
-  int local_rank_id = (cs_glob_n_ranks == 1) ? 0 : -1;
+  const cs_lnum_t n_b_stat_vals
+    = cs_glob_mesh->n_b_faces * cs_glob_lagr_dim->n_boundary_stats;
 
-#if defined(HAVE_MPI)
-  if (cs_glob_n_ranks > 1) {
+  const cs_lagr_zone_data_t  *bdy_cond = cs_glob_lagr_boundary_conditions;
+  const cs_lnum_t n_fr_vals
+    = bdy_cond->n_zones * (cs_glob_lagr_model->n_stat_classes + 1);
 
-    int  rank;
-    int  request_count = 0;
-    const int  local_rank = cs_glob_rank_id;
+  _propagation_acc_t  *t_acc;
+  BFT_MALLOC(t_acc, n_threads, _propagation_acc_t);
 
-    /* Receive data from distant ranks */
+  for (int t_id = 0; t_id < n_threads; t_id++) {
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    _propagation_acc_t  *acc = t_acc + t_id;
 
-      if (halo->c_domain_rank[rank] != local_rank)
-        MPI_Irecv(&(lag_halo->recv_count[rank]),
-                  1,
-                  CS_MPI_LNUM,
-                  halo->c_domain_rank[rank],
-                  halo->c_domain_rank[rank],
-                  cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
-      else
-        local_rank_id = rank;
+    acc->events = NULL;
+    acc->b_stat = NULL;
 
+    if (events != NULL) {
+      acc->events = cs_lagr_event_set_create();
+      cs_lnum_t n_events_max = events->n_events_max / n_threads;
+      if (n_events_max > acc->events->n_events_max)
+        cs_lagr_event_set_resize(acc->events, n_events_max);
     }
 
-    /* We wait for posting all receives
-       (often recommended in the past, apparently not anymore) */
+    if (n_b_stat_vals > 0) {
+      BFT_MALLOC(acc->b_stat, n_b_stat_vals, cs_real_t);
+      for (cs_lnum_t i = 0; i < n_b_stat_vals; i++)
+        acc->b_stat[i] = 0.;
+    }
 
-#if 0
-    MPI_Barrier(cs_glob_mpi_comm)
-#endif
+    BFT_MALLOC(acc->zone_flow_rate, n_fr_vals, cs_real_t);
+    for (cs_lnum_t i = 0; i < n_fr_vals; i++)
+      acc->zone_flow_rate[i] = 0.;
+
+    memset(&(acc->counters), 0, sizeof(cs_lagr_particle_set_t));
 
-    /* Send data to distant ranks */
+  }
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+  return t_acc;
+}
 
-      /* If this is not the local rank */
+/*----------------------------------------------------------------------------
+ * Reduce and destroy thread-local accumulators.
+ *
+ * Boundary statistics and flow rate increments are added to the
+ * shared arrays, and remaining events are flushed to statistics.
+ *
+ * parameters:
+ *   n_threads <-- number of threads
+ *   t_acc     <-> pointer to array of thread-local accumulators
+ *----------------------------------------------------------------------------*/
 
-      if (halo->c_domain_rank[rank] != local_rank)
-        MPI_Isend(&(lag_halo->send_count[rank]),
-                  1,
-                  CS_MPI_LNUM,
-                  halo->c_domain_rank[rank],
-                  local_rank,
-                  cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
+static void
+_propagation_acc_reduce(int                  n_threads,
+                        _propagation_acc_t **t_acc)
+{
+  _propagation_acc_t  *_t_acc = *t_acc;
 
+  if (_t_acc == NULL)
+    return;
+
+  const cs_lnum_t n_b_stat_vals
+    = cs_glob_mesh->n_b_faces * cs_glob_lagr_dim->n_boundary_stats;
+
+  cs_lagr_zone_data_t  *bdy_cond = cs_lagr_get_boundary_conditions();
+  const cs_lnum_t n_fr_vals
+    = bdy_cond->n_zones * (cs_glob_lagr_model->n_stat_classes + 1);
+
+  for (int t_id = 0; t_id < n_threads; t_id++) {
+
+    _propagation_acc_t  *acc = _t_acc + t_id;
+
+    if (acc->events != NULL) {
+      if (acc->events->n_events > 0)
+        _flush_events(acc->events);
+      cs_lagr_event_set_destroy(&(acc->events));
     }
 
-    /* Wait for all exchanges */
+    if (acc->b_stat != NULL) {
+#     pragma omp parallel for if (n_b_stat_vals > CS_THR_MIN)
+      for (cs_lnum_t i = 0; i < n_b_stat_vals; i++)
+        bound_stat[i] += acc->b_stat[i];
+      BFT_FREE(acc->b_stat);
+    }
 
-    MPI_Waitall(request_count, lag_halo->request, lag_halo->status);
+    for (cs_lnum_t i = 0; i < n_fr_vals; i++)
+      bdy_cond->particle_flow_rate[i] += acc->zone_flow_rate[i];
+    BFT_FREE(acc->zone_flow_rate);
 
   }
-#endif /* defined(HAVE_MPI) */
 
-  /* Copy local values in case of periodicity */
+  BFT_FREE(*t_acc);
+}
 
-  if (halo->n_transforms > 0)
-    if (local_rank_id > -1)
-      lag_halo->recv_count[local_rank_id] = lag_halo->send_count[local_rank_id];
+/*----------------------------------------------------------------------------
+ * Add particle set counter increments relative to a reference state.
+ *
+ * parameters:
+ *   particles <-> pointer to particle set to update
+ *   p_cur     <-- particle set with updated counters
+ *   p_ref     <-- particle set with reference counters
+ *----------------------------------------------------------------------------*/
 
+static void
+_add_counter_increments(cs_lagr_particle_set_t        *particles,
+                        const cs_lagr_particle_set_t  *p_cur,
+                        const cs_lagr_particle_set_t  *p_ref)
+{
+  particles->n_part_new += p_cur->n_part_new - p_ref->n_part_new;
+  particles->n_part_out += p_cur->n_part_out - p_ref->n_part_out;
+  particles->n_part_merged += p_cur->n_part_merged - p_ref->n_part_merged;
+  particles->n_part_dep += p_cur->n_part_dep - p_ref->n_part_dep;
+  particles->n_part_fou += p_cur->n_part_fou - p_ref->n_part_fou;
+  particles->n_part_resusp += p_cur->n_part_resusp - p_ref->n_part_resusp;
+  particles->n_failed_part += p_cur->n_failed_part - p_ref->n_failed_part;
+
+  particles->weight_new += p_cur->weight_new - p_ref->weight_new;
+  particles->weight_out += p_cur->weight_out - p_ref->weight_out;
+  particles->weight_merged += p_cur->weight_merged - p_ref->weight_merged;
+  particles->weight_dep += p_cur->weight_dep - p_ref->weight_dep;
+  particles->weight_fou += p_cur->weight_fou - p_ref->weight_fou;
+  particles->weight_resusp += p_cur->weight_resusp - p_ref->weight_resusp;
+  particles->weight_failed += p_cur->weight_failed - p_ref->weight_failed;
 }
 
 /*----------------------------------------------------------------------------
- * Exchange particles
+ * Apply local propagation to all particles which need to be synchronized.
+ *
+ * If thread-local accumulators are given, particles are distributed among
+ * threads. Each thread then uses its own events, boundary statistics and
+ * flow rate accumulators, and its own copy of the particle set counters,
+ * which are reduced afterwards. Particle data itself is only accessed
+ * for the particle being propagated, so it is not shared.
+ *
+ * Particles are distributed statically and thread contributions are
+ * reduced in thread order, so that results are reproducible for a given
+ * number of threads (though summation order differs from the serial case).
+ * The only exception is tracking event statistics when a thread-local
+ * event set fills up and is flushed during propagation, in which case
+ * the order of event statistics updates depends on thread scheduling.
+ *
+ * parameters:
+ *   particles             <-> pointer to particle set
+ *   events                <-> events structure, or NULL
+ *   n_threads             <-- number of threads for threaded propagation
+ *   t_acc                 <-> thread-local accumulators, or NULL
+ *   displacement_step_id  <-- id of displacement step
+ *   failsafe_mode         <-- with (0) / without (1) failure capability
+ *   b_face_zone_id        <-- boundary face zone id
+ *   visc_length           <-- viscous layer thickness
+ *   u                     <-- fluid velocity field
+ *----------------------------------------------------------------------------*/
+
+static void
+_local_propagation_all(cs_lagr_particle_set_t  *particles,
+                       cs_lagr_event_set_t     *events,
+                       int                      n_threads,
+                       _propagation_acc_t      *t_acc,
+                       int                      displacement_step_id,
+                       int                      failsafe_mode,
+                       const int                b_face_zone_id[],
+                       const cs_real_t          visc_length[],
+                       const cs_field_t        *u)
+{
+  const cs_lnum_t n_particles = particles->n_particles;
+
+  /* Serial propagation */
+
+  if (t_acc == NULL || n_particles < CS_THR_MIN) {
+
+    cs_lagr_zone_data_t  *bdy_cond = cs_lagr_get_boundary_conditions();
+
+    for (cs_lnum_t i = 0; i < n_particles; i++) {
+
+      cs_lagr_tracking_state_t cur_part_state
+        = _get_tracking_info(particles, i)->state;
+
+      if (cur_part_state == CS_LAGR_PART_TO_SYNC) {
+
+        /* Main particle displacement stage */
+
+        cur_part_state = _local_propagation(particles,
+                                            events,
+                                            i,
+                                            displacement_step_id,
+                                            failsafe_mode,
+                                            b_face_zone_id,
+                                            visc_length,
+                                            u,
+                                            bound_stat,
+                                            bdy_cond->particle_flow_rate);
+
+        _tracking_info(particles, i)->state = cur_part_state;
+
+      }
+
+    }
+
+    return;
+  }
+
+  /* Threaded propagation */
+
+  const cs_lagr_particle_set_t  p_ref = *particles;
+
+# pragma omp parallel num_threads(n_threads)
+  {
+    int t_id = 0;
+#if defined(HAVE_OPENMP)
+    t_id = omp_get_thread_num();
+#endif
+
+    _propagation_acc_t  *acc = t_acc + t_id;
+
+    /* Particle data is shared, but counters are thread-local */
+
+    cs_lagr_particle_set_t  t_particles = p_ref;
+
+#   pragma omp for schedule(static, CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n_particles; i++) {
+
+      cs_lagr_tracking_state_t cur_part_state
+        = _get_tracking_info(&t_particles, i)->state;
+
+      if (cur_part_state == CS_LAGR_PART_TO_SYNC) {
+
+        cur_part_state = _local_propagation(&t_particles,
+                                            acc->events,
+                                            i,
+                                            displacement_step_id,
+                                            failsafe_mode,
+                                            b_face_zone_id,
+                                            visc_length,
+                                            u,
+                                            acc->b_stat,
+                                            acc->zone_flow_rate);
+
+        _tracking_info(&t_particles, i)->state = cur_part_state;
+
+      }
+
+    }
+
+    acc->counters = t_particles;
+  }
+
+  for (int t_id = 0; t_id < n_threads; t_id++)
+    _add_counter_increments(particles, &(t_acc[t_id].counters), &p_ref);
+}
+
+/*----------------------------------------------------------------------------
+ * Exchange particles with communicating ranks.
+ *
+ * Only ranks to which particles are sent are involved in the exchange of
+ * counts (using a sparse rank neighbors exchange), and messages are only
+ * posted for non-empty exchanges, so the cost of an exchange step depends
+ * on the number of particles actually leaving the local domain rather
+ * than on the size of the halo.
+ *
+ * Particles to send must have been copied to the halo's send buffer,
+ * based on the counts and shifts determined by _lagr_halo_count.
  *
  * parameters:
  *  halo      <-- pointer to a cs_halo_t structure
@@ -2351,103 +2628,161 @@ _exchange_particles(const cs_halo_t         *halo,
                     cs_lagr_halo_t          *lag_halo,
                     cs_lagr_particle_set_t  *particles)
 {
-  int local_rank_id = (cs_glob_n_ranks == 1) ? 0 : -1;
-
   const size_t tot_extents = lag_halo->extents;
+  const int local_rank = CS_MAX(cs_glob_rank_id, 0);
 
   cs_lnum_t  n_recv_particles = 0;
 
+  /* Particles remaining on the local rank (periodicity) */
+
+  int local_rank_id = -1;
+  cs_lnum_t n_local_particles = 0;
+
+  for (int i = 0; i < halo->n_c_domains; i++) {
+    if (halo->c_domain_rank[i] == local_rank) {
+      local_rank_id = i;
+      n_local_particles = lag_halo->send_count[i];
+    }
+  }
+
 #if defined(HAVE_MPI)
 
   if (cs_glob_n_ranks > 1) {
 
-    int  rank;
-    int  request_count = 0;
-    const int  local_rank = cs_glob_rank_id;
+    /* Message tag, distinct from that used for counts by
+       the rank neighbors exchange */
 
-    /* Receive data from distant ranks */
+    const int tag = 1;
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    /* Ranks to which particles are sent */
 
-      cs_lnum_t shift =   particles->n_particles
-                        + lag_halo->recv_shift[rank];
+    int n_send_domains = 0;
+    int *domain_id, *domain_rank, *domain_index;
 
-      if (lag_halo->recv_count[rank] > 0) {
-
-        if (halo->c_domain_rank[rank] != local_rank) {
-          void  *recv_buf = particles->p_buffer + tot_extents*shift;
-          n_recv_particles += lag_halo->recv_count[rank];
-          MPI_Irecv(recv_buf,
-                    lag_halo->recv_count[rank],
-                    _cs_mpi_particle_type,
-                    halo->c_domain_rank[rank],
-                    halo->c_domain_rank[rank],
-                    cs_glob_mpi_comm,
-                    &(lag_halo->request[request_count++]));
-        }
-        else
-          local_rank_id = rank;
+    BFT_MALLOC(domain_id, halo->n_c_domains, int);
+    BFT_MALLOC(domain_rank, halo->n_c_domains, int);
+    BFT_MALLOC(domain_index, halo->n_c_domains, int);
 
+    for (int i = 0; i < halo->n_c_domains; i++) {
+      if (i != local_rank_id && lag_halo->send_count[i] > 0) {
+        domain_id[n_send_domains] = i;
+        domain_rank[n_send_domains] = halo->c_domain_rank[i];
+        n_send_domains++;
       }
+    }
+
+    cs_rank_neighbors_t *n_send
+      = cs_rank_neighbors_create(n_send_domains, domain_rank);
 
+    cs_rank_neighbors_to_index(n_send,
+                               n_send_domains,
+                               domain_rank,
+                               domain_index);
+
+    /* Counts and halo domain ids, in neighbor rank order */
+
+    int *send_domain_id;
+    cs_lnum_t *send_count;
+    BFT_MALLOC(send_domain_id, n_send->size, int);
+    BFT_MALLOC(send_count, n_send->size, cs_lnum_t);
+
+    for (int i = 0; i < n_send_domains; i++) {
+      int j = domain_index[i];
+      send_domain_id[j] = domain_id[i];
+      send_count[j] = lag_halo->send_count[domain_id[i]];
     }
 
-    /* We wait for posting all receives
-       (often recommended in the past, apparently not anymore) */
+    BFT_FREE(domain_index);
+    BFT_FREE(domain_rank);
+    BFT_FREE(domain_id);
 
-#if 0
-    MPI_Barrier(cs_glob_mpi_comm);
+    /* Exchange counts with neighbors actually involved */
+
+#if defined(HAVE_MPI_IBARRIER)
+    const cs_rank_neighbors_exchange_t ex_type = CS_RANK_NEIGHBORS_NBX;
+#else
+    const cs_rank_neighbors_exchange_t ex_type
+      = CS_RANK_NEIGHBORS_CRYSTAL_ROUTER;
 #endif
 
-    /* Send data to distant ranks */
+    cs_rank_neighbors_t *n_recv = NULL;
+    cs_lnum_t *recv_count = NULL;
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    cs_rank_neighbors_sync_count_m(n_send,
+                                   &n_recv,
+                                   send_count,
+                                   &recv_count,
+                                   ex_type,
+                                   cs_glob_mpi_comm);
 
-      /* If this is not the local rank */
+    for (int i = 0; i < n_recv->size; i++)
+      n_recv_particles += recv_count[i];
 
-      if (   halo->c_domain_rank[rank] != local_rank
-          && lag_halo->send_count[rank] > 0) {
-        cs_lnum_t shift = lag_halo->send_shift[rank];
-        void  *send_buf = lag_halo->send_buf + tot_extents*shift;
-        MPI_Isend(send_buf,
-                  lag_halo->send_count[rank],
-                  _cs_mpi_particle_type,
-                  halo->c_domain_rank[rank],
-                  local_rank,
-                  cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
+    cs_lagr_particle_set_resize(  particles->n_particles
+                                + n_recv_particles + n_local_particles);
 
-      }
+    /* Exchange particles */
+
+    int  request_count = 0;
+    MPI_Request  *request;
+    BFT_MALLOC(request, n_recv->size + n_send->size, MPI_Request);
+
+    cs_lnum_t recv_shift = particles->n_particles;
+
+    for (int i = 0; i < n_recv->size; i++) {
+      void  *recv_buf = particles->p_buffer + tot_extents*recv_shift;
+      MPI_Irecv(recv_buf,
+                recv_count[i],
+                _cs_mpi_particle_type,
+                n_recv->rank[i],
+                tag,
+                cs_glob_mpi_comm,
+                &(request[request_count++]));
+      recv_shift += recv_count[i];
+    }
 
+    for (int i = 0; i < n_send->size; i++) {
+      cs_lnum_t send_shift = lag_halo->send_shift[send_domain_id[i]];
+      void  *send_buf = lag_halo->send_buf + tot_extents*send_shift;
+      MPI_Isend(send_buf,
+                send_count[i],
+                _cs_mpi_particle_type,
+                n_send->rank[i],
+                tag,
+                cs_glob_mpi_comm,
+                &(request[request_count++]));
     }
 
-    /* Wait for all exchanges */
+    MPI_Waitall(request_count, request, MPI_STATUSES_IGNORE);
 
-    MPI_Waitall(request_count, lag_halo->request, lag_halo->status);
+    BFT_FREE(request);
+
+    BFT_FREE(recv_count);
+    cs_rank_neighbors_destroy(&n_recv);
+    BFT_FREE(send_count);
+    BFT_FREE(send_domain_id);
+    cs_rank_neighbors_destroy(&n_send);
 
   }
+
 #endif /* defined(HAVE_MPI) */
 
   /* Copy local values in case of periodicity */
 
-  if (halo->n_transforms > 0) {
-    if (local_rank_id > -1) {
+  if (n_local_particles > 0) {
 
-      cs_lnum_t  recv_shift =   particles->n_particles
-                              + lag_halo->recv_shift[local_rank_id];
-      cs_lnum_t  send_shift = lag_halo->send_shift[local_rank_id];
+    if (cs_glob_n_ranks < 2)
+      cs_lagr_particle_set_resize(particles->n_particles + n_local_particles);
 
-      assert(   lag_halo->recv_count[local_rank_id]
-             == lag_halo->send_count[local_rank_id]);
+    cs_lnum_t  recv_shift = particles->n_particles + n_recv_particles;
+    cs_lnum_t  send_shift = lag_halo->send_shift[local_rank_id];
 
-      n_recv_particles += lag_halo->send_count[local_rank_id];
+    memcpy(particles->p_buffer + tot_extents*recv_shift,
+           lag_halo->send_buf + tot_extents*send_shift,
+           tot_extents*n_local_particles);
+
+    n_recv_particles += n_local_particles;
 
-      for (cs_lnum_t i = 0; i < lag_halo->send_count[local_rank_id]; i++) {
-        memcpy(particles->p_buffer + tot_extents*(recv_shift + i),
-               lag_halo->send_buf + tot_extents*(send_shift + i),
-               tot_extents);
-      }
-    }
   }
 
   /* Update particle count and weight */
@@ -2472,7 +2807,10 @@ _exchange_particles(const cs_halo_t         *halo,
 }
 
 /*----------------------------------------------------------------------------
- * Determine particle halo sizes
+ * Determine number of particles to send to each communicating rank.
+ *
+ * Particle counts are not exchanged here, so as to involve only ranks
+ * to which particles are actually sent in the exchange.
  *
  * parameters:
  *   mesh      <-- pointer to associated mesh
@@ -2485,27 +2823,22 @@ _lagr_halo_count(const cs_mesh_t               *mesh,
                  cs_lagr_halo_t                *lag_halo,
                  const cs_lagr_particle_set_t  *particles)
 {
-  cs_lnum_t  i, ghost_id;
-
-  cs_lnum_t  n_recv_particles = 0, n_send_particles = 0;
-
   const cs_halo_t  *halo = mesh->halo;
 
   /* Initialization */
 
-  for (i = 0; i < halo->n_c_domains; i++) {
+  for (int i = 0; i < halo->n_c_domains; i++)
     lag_halo->send_count[i] = 0;
-    lag_halo->recv_count[i] = 0;
-  }
 
   /* Loop on particles to count number of particles to send on each rank */
 
-  for (i = 0; i < particles->n_particles; i++) {
+  for (cs_lnum_t i = 0; i < particles->n_particles; i++) {
 
     if (_get_tracking_info(particles, i)->state == CS_LAGR_PART_TO_SYNC_NEXT) {
 
-      ghost_id =   cs_lagr_particles_get_lnum(particles, i, CS_LAGR_CELL_ID)
-                 - mesh->n_cells;
+      cs_lnum_t ghost_id
+        =   cs_lagr_particles_get_lnum(particles, i, CS_LAGR_CELL_ID)
+          - mesh->n_cells;
 
       assert(ghost_id >= 0);
       lag_halo->send_count[lag_halo->rank[ghost_id]] += 1;
@@ -2514,32 +2847,15 @@ _lagr_halo_count(const cs_mesh_t               *mesh,
 
   } /* End of loop on particles */
 
-  /* Exchange counters */
-
-  _exchange_counter(halo, lag_halo);
-
-  for (i = 0; i < halo->n_c_domains; i++) {
-    n_recv_particles += lag_halo->recv_count[i];
-    n_send_particles += lag_halo->send_count[i];
-  }
-
   lag_halo->send_shift[0] = 0;
-  lag_halo->recv_shift[0] = 0;
-
-  for (i = 1; i < halo->n_c_domains; i++) {
 
-    lag_halo->send_shift[i] =  lag_halo->send_shift[i-1]
-                             + lag_halo->send_count[i-1];
+  for (int i = 0; i < halo->n_c_domains; i++)
+    lag_halo->send_shift[i+1] =   lag_halo->send_shift[i]
+                                + lag_halo->send_count[i];
 
-    lag_halo->recv_shift[i] =  lag_halo->recv_shift[i-1]
-                             + lag_halo->recv_count[i-1];
+  /* Resize send buffer only if needed */
 
-  }
-
-  /* Resize particle set and/or halo only if needed */
-
-  cs_lagr_particle_set_resize(particles->n_particles + n_recv_particles);
-  _resize_lagr_halo(lag_halo, n_send_particles);
+  _resize_lagr_halo(lag_halo, lag_halo->send_shift[halo->n_c_domains]);
 }
 
 /*----------------------------------------------------------------------------
@@ -2558,7 +2874,6 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
   cs_lnum_t  i, k, tr_id, rank, shift, ghost_id;
   cs_real_t matrix[3][4];
 
-  cs_lnum_t  n_recv_particles = 0;
   cs_lnum_t  particle_count = 0;
 
   cs_lnum_t  n_merged_particles = 0;
@@ -2588,10 +2903,8 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
 
     _lagr_halo_count(mesh, lag_halo, particles);
 
-    for (i = 0; i < halo->n_c_domains; i++) {
-      n_recv_particles += lag_halo->recv_count[i];
+    for (i = 0; i < halo->n_c_domains; i++)
       lag_halo->send_count[i] = 0;
-    }
   }
 
   /* Loop on particles, transferring particles to synchronize to send_buf
@@ -2907,11 +3220,14 @@ _initialize_displacement(cs_lagr_particle_set_t  *particles)
 }
 
 /*----------------------------------------------------------------------------
- * Update particle set structures: compact array.
+ * Update particle set structures: sort particles by cell and release
+ * unused memory.
+ *
+ * Particles are permuted in place, so that no copy of the particle set
+ * is needed.
  *
  * parameters:
  *   particles        <-> pointer to particle set structure
- *   part_b_mass_flux <-> particle mass flux array, or NULL
  *----------------------------------------------------------------------------*/
 
 static void
@@ -2921,35 +3237,31 @@ _finalize_displacement(cs_lagr_particle_set_t  *particles)
   const cs_lnum_t  n_cells = cs_glob_mesh->n_cells;
 
   const cs_lnum_t n_particles = particles->n_particles;
+  const size_t p_extents = p_am->extents;
 
-  cs_lnum_t *cell_idx;
+  cs_lnum_t *cell_idx, *dest_id;
   unsigned char *swap_buffer;
-  size_t swap_buffer_size = p_am->extents * ((size_t)n_particles);
 
   BFT_MALLOC(cell_idx, n_cells+1, cs_lnum_t);
-  BFT_MALLOC(swap_buffer, swap_buffer_size, unsigned char);
+  BFT_MALLOC(dest_id, n_particles, cs_lnum_t);
+  BFT_MALLOC(swap_buffer, p_extents, unsigned char);
 
   /* Cell index (count first) */
 
   for (cs_lnum_t i = 0; i < n_cells+1; i++)
     cell_idx[i] = 0;
 
-  /* Copy unordered particle data to buffer */
-
   for (cs_lnum_t i = 0; i < n_particles; i++) {
 
     cs_lnum_t cur_part_state = _get_tracking_info(particles, i)->state;
 
     assert(   cur_part_state < CS_LAGR_PART_OUT
            && cur_part_state != CS_LAGR_PART_TO_SYNC);
+    CS_UNUSED(cur_part_state);
 
     cs_lnum_t cell_id = cs_lagr_particles_get_lnum(particles, i,
                                                    CS_LAGR_CELL_ID);
 
-    memcpy(swap_buffer + p_am->extents*i,
-           particles->p_buffer + p_am->extents*i,
-           p_am->extents);
-
     cell_idx[cell_id+1] += 1;
 
   }
@@ -2961,31 +3273,63 @@ _finalize_displacement(cs_lagr_particle_set_t  *particles)
 
   assert(n_particles == cell_idx[n_cells]);
 
-  /* Now copy particle data and update some statistics */
+  /* Keep a copy of the index, valid as long as particles do not move */
+
+  BFT_REALLOC(_cell_particle_idx, n_cells+1, cs_lnum_t);
+  memcpy(_cell_particle_idx, cell_idx, (n_cells+1)*sizeof(cs_lnum_t));
+  _n_cell_particle_idx_cells = n_cells;
+
+  /* Determine destination of each particle */
 
-  const cs_lnum_t p_extents = particles->p_am->extents;
   const cs_lnum_t cell_num_displ = particles->p_am->displ[0][CS_LAGR_CELL_ID];
 
   for (cs_lnum_t i = 0; i < n_particles; i++) {
 
     cs_lnum_t cell_id
-      = *((const cs_lnum_t *)(swap_buffer + p_extents*i + cell_num_displ));
+      = *((const cs_lnum_t *)(  particles->p_buffer + p_extents*i
+                              + cell_num_displ));
 
     assert(cell_id > -1);
 
-    cs_lnum_t particle_id = cell_idx[cell_id];
-
+    dest_id[i] = cell_idx[cell_id];
     cell_idx[cell_id] += 1;
 
-    memcpy(particles->p_buffer + p_am->extents*particle_id,
-           swap_buffer + p_am->extents*i,
-           p_am->extents);
+  }
+
+  /* Apply permutation in place, following its cycles; each swap
+     moves one particle to its final position */
+
+  for (cs_lnum_t i = 0; i < n_particles; i++) {
+
+    while (dest_id[i] != i) {
+
+      cs_lnum_t j = dest_id[i];
+
+      memcpy(swap_buffer,
+             particles->p_buffer + p_extents*j,
+             p_extents);
+      memcpy(particles->p_buffer + p_extents*j,
+             particles->p_buffer + p_extents*i,
+             p_extents);
+      memcpy(particles->p_buffer + p_extents*i,
+             swap_buffer,
+             p_extents);
+
+      dest_id[i] = dest_id[j];
+      dest_id[j] = j;
+
+    }
 
   }
 
   BFT_FREE(swap_buffer);
+  BFT_FREE(dest_id);
   BFT_FREE(cell_idx);
 
+  /* Release memory freed by particles which left the local domain */
+
+  cs_lagr_particle_set_shrink();
+
 #if 0 && defined(DEBUG) && !defined(NDEBUG)
   bft_printf("\n Particle set after %s\n", __func__);
   cs_lagr_particle_set_dump(particles);
@@ -3081,38 +3425,33 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[])
 
   _initialize_displacement(particles);
 
-  /* Main loop on particles: global propagation */
-
-  while (continue_displacement) {
+  /* Thread-local accumulators for threaded propagation */
 
-    /* Local propagation */
-
-    for (cs_lnum_t i = 0; i < particles->n_particles; i++) {
-
-      /* Local copies of the current and previous particles state vectors
-         to be used in case of the first pass of _local_propagation fails */
-
-      cs_lagr_tracking_state_t cur_part_state
-        = _get_tracking_info(particles, i)->state;
-
-      if (cur_part_state == CS_LAGR_PART_TO_SYNC) {
+  int n_threads = 1;
+  _propagation_acc_t  *t_acc = NULL;
 
-        /* Main particle displacement stage */
+#if defined(HAVE_OPENMP)
+  if (cs_glob_n_threads > 1 && _propagation_is_thread_safe()) {
+    n_threads = cs_glob_n_threads;
+    t_acc = _propagation_acc_create(n_threads, events);
+  }
+#endif
 
-        cur_part_state = _local_propagation(particles,
-                                            events,
-                                            i,
-                                            displacement_step_id,
-                                            failsafe_mode,
-                                            b_face_zone_id,
-                                            visc_length,
-                                            u);
+  /* Main loop on particles: global propagation */
 
-        _tracking_info(particles, i)->state = cur_part_state;
+  while (continue_displacement) {
 
-      }
+    /* Local propagation */
 
-    } /* End of loop on particles */
+    _local_propagation_all(particles,
+                           events,
+                           n_threads,
+                           t_acc,
+                           displacement_step_id,
+                           failsafe_mode,
+                           b_face_zone_id,
+                           visc_length,
+                           u);
 
     /* Update of the particle set structure. Delete exited particles,
        update for particles which change domain. */
@@ -3131,6 +3470,8 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[])
 
   } /* End of while (global displacement) */
 
+  _propagation_acc_reduce(n_threads, &t_acc);
+
   /* Deposition sub-model additional loop */
 
   if (lagr_model->deposition > 0) {
@@ -3226,6 +3567,9 @@ cs_lagr_tracking_finalize(void)
   /* Destroy builder */
   _particle_track_builder = _destroy_track_builder(_particle_track_builder);
 
+  BFT_FREE(_cell_particle_idx);
+  _n_cell_particle_idx_cells = 0;
+
   /* Destroy internal condition structure*/
 
   cs_lagr_finalize_internal_cond();
@@ -3252,6 +3596,41 @@ cs_lagr_tracking_finalize(void)
 #endif
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the index of particles by cell built by the last
+ *        displacement step.
+ *
+ * Particles are sorted by cell at the end of each displacement step, so
+ * that particles with ids in [idx[c], idx[c+1]) are located in cell c.
+ * Particles added since (by injection or agglomeration) are appended,
+ * and have ids greater or equal to idx[n_cells]; they are not indexed.
+ *
+ * The index is invalidated by the next displacement step, and is not
+ * available before the first one (in which case NULL is returned).
+ *
+ * \param[in]  n_cells  number of cells for which the index is expected
+ *
+ * \return  pointer to index (size: n_cells + 1), or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_lnum_t *
+cs_lagr_tracking_get_cell_particle_index(cs_lnum_t  n_cells)
+{
+  const cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
+
+  if (   _cell_particle_idx == NULL
+      || p_set == NULL
+      || _n_cell_particle_idx_cells != n_cells)
+    return NULL;
+
+  if (_cell_particle_idx[n_cells] > p_set->n_particles)
+    return NULL;
+
+  return _cell_particle_idx;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Determine the number of the closest wall face from the particle
@@ -98,6 +98,28 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[]);
 void
 cs_lagr_tracking_finalize(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the index of particles by cell built by the last
+ *        displacement step.
+ *
+ * Particles are sorted by cell at the end of each displacement step, so
+ * that particles with ids in [idx[c], idx[c+1]) are located in cell c.
+ * Particles added since (by injection or agglomeration) are appended,
+ * and have ids greater or equal to idx[n_cells]; they are not indexed.
+ *
+ * The index is invalidated by the next displacement step, and is not
+ * available before the first one (in which case NULL is returned).
+ *
+ * \param[in]  n_cells  number of cells for which the index is expected
+ *
+ * \return  pointer to index (size: n_cells + 1), or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_lnum_t *
+cs_lagr_tracking_get_cell_particle_index(cs_lnum_t  n_cells);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Determine the number of the closest wall face from the particle
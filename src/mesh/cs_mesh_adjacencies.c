@@ -54,6 +54,7 @@
 #include "cs_halo.h"
 #include "cs_log.h"
 #include "cs_mesh.h"
+#include "cs_parall.h"
 #include "cs_sort.h"
 
 /*----------------------------------------------------------------------------
@@ -631,6 +632,169 @@ _update_cell_vertices(cs_mesh_adjacencies_t  *ma,
   BFT_REALLOC(c2v->ids, c2v->idx[n_cells], cs_lnum_t);
 }
 
+/*----------------------------------------------------------------------------
+ * Transform a count stored in idx[i+1] for each element i into an index
+ * (idx[0] is assumed to be equal to 0). A parallel prefix sum is used when
+ * several threads are available.
+ *
+ * parameters:
+ *   n   <-- number of elements
+ *   idx <-> count (in) or index (out), size n + 1
+ *----------------------------------------------------------------------------*/
+
+static void
+_count_to_index(cs_lnum_t   n,
+                cs_lnum_t   idx[])
+{
+  assert(idx[0] == 0);
+
+#if defined(HAVE_OPENMP)
+  if (cs_glob_n_threads > 1 && n > CS_THR_MIN) {
+
+    cs_lnum_t  *t_shift = NULL;
+    BFT_MALLOC(t_shift, cs_glob_n_threads + 1, cs_lnum_t);
+
+#   pragma omp parallel num_threads(cs_glob_n_threads)
+    {
+      const int  t_id = omp_get_thread_num();
+      const int  n_t = omp_get_num_threads();
+
+      cs_lnum_t  s_id, e_id;
+      cs_parall_thread_range(n, sizeof(cs_lnum_t), &s_id, &e_id);
+
+      /* Local sum for the range of elements related to this thread */
+
+      cs_lnum_t  t_sum = 0;
+      for (cs_lnum_t i = s_id; i < e_id; i++)
+        t_sum += idx[i+1];
+      t_shift[t_id+1] = t_sum;
+
+#     pragma omp barrier
+#     pragma omp single
+      {
+        t_shift[0] = 0;
+        for (int t = 0; t < n_t; t++)
+          t_shift[t+1] += t_shift[t];
+      }
+
+      /* Local prefix sum starting from the shift related to this thread */
+
+      cs_lnum_t  shift = t_shift[t_id];
+      for (cs_lnum_t i = s_id; i < e_id; i++) {
+        shift += idx[i+1];
+        idx[i+1] = shift;
+      }
+
+    } /* OpenMP block */
+
+    BFT_FREE(t_shift);
+    return;
+
+  }
+#endif
+
+  for (cs_lnum_t i = 0; i < n; i++)
+    idx[i+1] += idx[i];
+}
+
+/*----------------------------------------------------------------------------
+ * Retrieve the list of entities related to an element in an adjacency
+ * (indexed or with a stride)
+ *
+ * parameters:
+ *   adj  <-- pointer to a cs_adjacency_t structure
+ *   id   <-- element id
+ *   ids  --> pointer to the list of related entities
+ *
+ * returns:
+ *   the number of related entities
+ *----------------------------------------------------------------------------*/
+
+static inline cs_lnum_t
+_adjacency_entries(const cs_adjacency_t   *adj,
+                   cs_lnum_t               id,
+                   const cs_lnum_t       **ids)
+{
+  if (adj->stride > 0) {
+    *ids = adj->ids + adj->stride*id;
+    return adj->stride;
+  }
+  else {
+    *ids = adj->ids + adj->idx[id];
+    return adj->idx[id+1] - adj->idx[id];
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Count or store the distinct C elements related to an A element through
+ * the composition of A -> B and B -> C adjacencies. The related C elements
+ * are gathered in a work buffer local to the calling thread, then sorted
+ * and made unique, so that scratch memory only depends on the number of
+ * entries of the row and not on the size of the C set. Entries are stored
+ * in increasing order.
+ *
+ * parameters:
+ *   a_id     <-- id of the A element
+ *   a2b      <-- adjacency A -> B
+ *   b2c      <-- adjacency B -> C
+ *   buf_size <-> allocated size of the work buffer
+ *   buf      <-> work buffer (reallocated if needed)
+ *   c_ids    --> list of C elements to fill or NULL (count only)
+ *
+ * returns:
+ *   the number of distinct C elements
+ *----------------------------------------------------------------------------*/
+
+static inline cs_lnum_t
+_compose_entry(cs_lnum_t                a_id,
+               const cs_adjacency_t    *a2b,
+               const cs_adjacency_t    *b2c,
+               cs_lnum_t               *buf_size,
+               cs_lnum_t              **buf,
+               cs_lnum_t               *c_ids)
+{
+  const cs_lnum_t  *b_ids = NULL, *bc_ids = NULL;
+  const cs_lnum_t  n_b = _adjacency_entries(a2b, a_id, &b_ids);
+
+  /* Gather (with duplicates) the C elements related to a_id */
+
+  cs_lnum_t  n_g = 0;
+  for (cs_lnum_t jb = 0; jb < n_b; jb++)
+    n_g += _adjacency_entries(b2c, b_ids[jb], &bc_ids);
+
+  if (n_g > *buf_size) {
+    *buf_size = CS_MAX(2*(*buf_size), n_g);
+    BFT_REALLOC(*buf, *buf_size, cs_lnum_t);
+  }
+
+  cs_lnum_t  *g_ids = *buf;
+
+  n_g = 0;
+  for (cs_lnum_t jb = 0; jb < n_b; jb++) {
+    const cs_lnum_t  n_bc = _adjacency_entries(b2c, b_ids[jb], &bc_ids);
+    for (cs_lnum_t jc = 0; jc < n_bc; jc++)
+      g_ids[n_g++] = bc_ids[jc];
+  }
+
+  if (n_g == 0)
+    return 0;
+
+  /* Sort and remove duplicates */
+
+  cs_sort_shell(0, n_g, g_ids);
+
+  cs_lnum_t  n_c = 1;
+  for (cs_lnum_t i = 1; i < n_g; i++) {
+    if (g_ids[i] != g_ids[n_c-1])
+      g_ids[n_c++] = g_ids[i];
+  }
+
+  if (c_ids != NULL)
+    memcpy(c_ids, g_ids, n_c*sizeof(cs_lnum_t));
+
+  return n_c;
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -1066,9 +1230,10 @@ cs_adjacency_destroy(cs_adjacency_t   **p_adj)
  * \brief   Create a new cs_adjacency_t structure from the composition of
  *          two cs_adjacency_t structures: (1) A -> B and (2) B -> C
  *          The resulting structure describes A -> C. It does not rely on a
- *          stride and has no sgn member.
+ *          stride and has no sgn member. The entries of each list are
+ *          sorted.
  *
- * \param[in]  n_c_elts  number of elements in C set
+ * \param[in]  n_c_elts  number of elements in C set (unused)
  * \param[in]  a2b       adjacency A -> B
  * \param[in]  b2c       adjacency B -> C
  *
@@ -1081,199 +1246,58 @@ cs_adjacency_compose(int                      n_c_elts,
                      const cs_adjacency_t    *a2b,
                      const cs_adjacency_t    *b2c)
 {
-  cs_lnum_t  *ctag = NULL;
-  cs_adjacency_t  *a2c = cs_adjacency_create(0, -1, a2b->n_elts);
-
-  BFT_MALLOC(ctag, n_c_elts, cs_lnum_t);
-# pragma omp parallel for if (n_c_elts > CS_THR_MIN)
-  for (cs_lnum_t i = 0; i < n_c_elts; i++) ctag[i] = -1;
-
-  /* Build index */
-  /* ----------- */
-
-  if (a2b->stride < 1 && b2c->stride < 1) {
-
-    /* The two adjacencies rely on an indexed array */
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (cs_lnum_t ja = a2b->idx[a_id]; ja < a2b->idx[a_id+1]; ja++) {
-
-        const cs_lnum_t  b_id = a2b->ids[ja];
-        for (cs_lnum_t jb = b2c->idx[b_id]; jb < b2c->idx[b_id+1]; jb++) {
-
-          const cs_lnum_t  c_id = b2c->ids[jb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->idx[a_id+1] += 1;
-          }
-
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
-
-  }
-  else if (a2b->stride > 0 && b2c->stride < 1) {
-
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (int ka = 0; ka < a2b->stride; ka++) {
+  const cs_lnum_t  n_a_elts = a2b->n_elts;
 
-        const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + ka];
-        for (cs_lnum_t jb = b2c->idx[b_id]; jb < b2c->idx[b_id+1]; jb++) {
+  CS_UNUSED(n_c_elts);
 
-          const cs_lnum_t  c_id = b2c->ids[jb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->idx[a_id+1] += 1;
-          }
+  cs_adjacency_t  *a2c = cs_adjacency_create(0, -1, n_a_elts);
 
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
+  /* Each thread relies on its own work buffer, sized to the largest row
+     it has met (before removing duplicates) */
 
-  }
-  else if (a2b->stride < 1 && b2c->stride > 0) {
-
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (cs_lnum_t ja = a2b->idx[a_id]; ja < a2b->idx[a_id+1]; ja++) {
-
-        const cs_lnum_t  b_id = a2b->ids[ja];
-        for (int kb = 0; kb < b2c->stride; kb++) {
-
-          const cs_lnum_t  c_id = b2c->ids[b2c->stride*b_id + kb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->idx[a_id+1] += 1;
-          }
-
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
-
-  }
-  else {
-
-    assert(a2b->stride > 0 && b2c->stride > 0);
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (int ka = 0; ka < a2b->stride; ka++) {
-
-        const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + ka];
-        for (int kb = 0; kb < b2c->stride; kb++) {
+  /* Build index */
+  /* ----------- */
 
-          const cs_lnum_t  c_id = b2c->ids[b2c->stride*b_id + kb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->idx[a_id+1] += 1;
-          }
+# pragma omp parallel if (n_a_elts > CS_THR_MIN)
+  {
+    cs_lnum_t  buf_size = 0;
+    cs_lnum_t  *buf = NULL;
 
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
+#   pragma omp for
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++)
+      a2c->idx[a_id+1] = _compose_entry(a_id, a2b, b2c, &buf_size, &buf,
+                                        NULL);
 
+    BFT_FREE(buf);
   }
 
-  for (cs_lnum_t i = 0; i < a2c->n_elts; i++)
-    a2c->idx[i+1] += a2c->idx[i];
+  _count_to_index(n_a_elts, a2c->idx);
 
-  BFT_MALLOC(a2c->ids, a2c->idx[a2c->n_elts], cs_lnum_t);
-
-  /* Reset ctag */
-# pragma omp parallel for if (n_c_elts > CS_THR_MIN)
-  for (cs_lnum_t i = 0; i < n_c_elts; i++) ctag[i] = -1;
+  BFT_MALLOC(a2c->ids, a2c->idx[n_a_elts], cs_lnum_t);
 
   /* Fill ids */
   /* -------- */
 
-  cs_lnum_t  shift = 0;
-  if (a2b->stride < 1 && b2c->stride < 1) {
-
-    /* The two adjacencies rely on an indexed array */
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (cs_lnum_t ja = a2b->idx[a_id]; ja < a2b->idx[a_id+1]; ja++) {
-
-        const cs_lnum_t  b_id = a2b->ids[ja];
-        for (cs_lnum_t jb = b2c->idx[b_id]; jb < b2c->idx[b_id+1]; jb++) {
-
-          const cs_lnum_t  c_id = b2c->ids[jb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->ids[shift++] = c_id;
-          }
-
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
-
-  }
-  else if (a2b->stride > 0 && b2c->stride < 1) {
-
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (int ka = 0; ka < a2b->stride; ka++) {
-
-        const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + ka];
-        for (cs_lnum_t jb = b2c->idx[b_id]; jb < b2c->idx[b_id+1]; jb++) {
-
-          const cs_lnum_t  c_id = b2c->ids[jb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->ids[shift++] = c_id;
-          }
-
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
-
-  }
-  else if (a2b->stride < 1 && b2c->stride > 0) {
-
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-
-      for (cs_lnum_t ja = a2b->idx[a_id]; ja < a2b->idx[a_id+1]; ja++) {
-
-        const cs_lnum_t  b_id = a2b->ids[ja];
-        for (int kb = 0; kb < b2c->stride; kb++) {
-
-          const cs_lnum_t  c_id = b2c->ids[b2c->stride*b_id + kb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->ids[shift++] = c_id;
-          }
-
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
-
-  }
-  else {
-
-    assert(a2b->stride > 0 && b2c->stride > 0);
-    for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
+# pragma omp parallel if (n_a_elts > CS_THR_MIN)
+  {
+    cs_lnum_t  buf_size = 0;
+    cs_lnum_t  *buf = NULL;
 
-      for (int ka = 0; ka < a2b->stride; ka++) {
+#   pragma omp for
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++) {
 
-        const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + ka];
-        for (int kb = 0; kb < b2c->stride; kb++) {
+      cs_lnum_t  *c_ids = a2c->ids + a2c->idx[a_id];
+      cs_lnum_t  n_c = _compose_entry(a_id, a2b, b2c, &buf_size, &buf,
+                                      c_ids);
 
-          const cs_lnum_t  c_id = b2c->ids[b2c->stride*b_id + kb];
-          if (ctag[c_id] != a_id) { /* Not tagged yet */
-            ctag[c_id] = a_id;
-            a2c->ids[shift++] = c_id;
-          }
+      assert(n_c == a2c->idx[a_id+1] - a2c->idx[a_id]);
+      CS_UNUSED(n_c);
 
-        } /* End of loop on C elements */
-      } /* End of loop on B elements */
-    } /* End of loop on A elements */
+    }
 
+    BFT_FREE(buf);
   }
 
-  assert(shift == a2c->idx[a2c->n_elts]);
-
-  BFT_FREE(ctag);
-
   return a2c;
 }
 
@@ -1304,32 +1328,54 @@ cs_adjacency_transpose(int                     n_b_elts,
   if (n_b_elts == 0)
     return b2a;
 
+  /* With several threads, entries are added concurrently to the list of
+     a B element so that each list is sorted afterwards. This yields the
+     same result as a loop on A elements in increasing order. */
+
+  const cs_lnum_t  n_a_elts = a2b->n_elts;
+  const bool  threaded = (cs_glob_n_threads > 1 && n_a_elts > CS_THR_MIN);
+  const int  a_stride = (a2b->flag & CS_ADJACENCY_STRIDE) ? a2b->stride : 0;
+
   /* Build idx */
   /* --------- */
 
-  if (a2b->flag & CS_ADJACENCY_STRIDE) {
+  if (threaded) {
 
-    for (cs_lnum_t i = 0; i < a2b->n_elts; i++)
-      for (int j = 0; j < a2b->stride; j++)
-        b2a->idx[a2b->ids[a2b->stride*i + j]+1] += 1;
+#   pragma omp parallel for
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++) {
+
+      const cs_lnum_t  s = (a_stride > 0) ? a_stride*a_id : a2b->idx[a_id];
+      const cs_lnum_t  e = (a_stride > 0) ? s + a_stride : a2b->idx[a_id+1];
+
+      for (cs_lnum_t j = s; j < e; j++) {
+#       pragma omp atomic
+        b2a->idx[a2b->ids[j]+1] += 1;
+      }
+
+    }
 
   }
   else {
 
-    for (cs_lnum_t i = 0; i < a2b->n_elts; i++)
-      for (cs_lnum_t j = a2b->idx[i]; j < a2b->idx[i+1]; j++)
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++) {
+
+      const cs_lnum_t  s = (a_stride > 0) ? a_stride*a_id : a2b->idx[a_id];
+      const cs_lnum_t  e = (a_stride > 0) ? s + a_stride : a2b->idx[a_id+1];
+
+      for (cs_lnum_t j = s; j < e; j++)
         b2a->idx[a2b->ids[j]+1] += 1;
 
+    }
+
   }
 
-  for (cs_lnum_t i = 0; i < b2a->n_elts; i++)
-    b2a->idx[i+1] += b2a->idx[i];
+  _count_to_index(n_b_elts, b2a->idx);
 
   /* Allocate and initialize temporary buffer */
-  int  *count = NULL;
-  BFT_MALLOC(count, n_b_elts, int);
-# pragma omp parallel for if (n_b_elts > CS_THR_MIN)
-  for (cs_lnum_t i = 0; i < n_b_elts; i++) count[i] = 0;
+
+  cs_lnum_t  *count = NULL;
+  BFT_MALLOC(count, n_b_elts, cs_lnum_t);
+  cs_array_lnum_fill_zero(n_b_elts, count);
 
   /* Build ids */
   /* --------- */
@@ -1338,74 +1384,63 @@ cs_adjacency_transpose(int                     n_b_elts,
   if (b2a->flag & CS_ADJACENCY_SIGNED)
     BFT_MALLOC(b2a->sgn, b2a->idx[b2a->n_elts], short int);
 
-  if (a2b->flag & CS_ADJACENCY_STRIDE) {
-    if (b2a->flag & CS_ADJACENCY_SIGNED) {
+  if (threaded) {
 
-      for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-        for (int j = 0; j < a2b->stride; j++) {
+#   pragma omp parallel for
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++) {
 
-          const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + j];
-          const cs_lnum_t  shift = count[b_id] + b2a->idx[b_id];
+      const cs_lnum_t  s = (a_stride > 0) ? a_stride*a_id : a2b->idx[a_id];
+      const cs_lnum_t  e = (a_stride > 0) ? s + a_stride : a2b->idx[a_id+1];
 
-          b2a->ids[shift] = a_id;
-          b2a->sgn[shift] = a2b->sgn[a2b->stride*a_id + j];
-          count[b_id] += 1;
+      for (cs_lnum_t j = s; j < e; j++) {
 
-        }
-      }
+        const cs_lnum_t  b_id = a2b->ids[j];
 
-    }
-    else { /* Do not build sgn */
+        cs_lnum_t  shift;
+#       pragma omp atomic capture
+        shift = count[b_id]++;
 
-      for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-        for (int j = 0; j < a2b->stride; j++) {
+        shift += b2a->idx[b_id];
 
-          const cs_lnum_t  b_id = a2b->ids[a2b->stride*a_id + j];
-
-          b2a->ids[count[b_id] + b2a->idx[b_id]] = a_id;
-          count[b_id] += 1;
+        b2a->ids[shift] = a_id;
+        if (b2a->sgn != NULL)
+          b2a->sgn[shift] = a2b->sgn[j];
 
-        }
       }
 
     }
+
   }
   else {
-    if (b2a->flag & CS_ADJACENCY_SIGNED) {
 
-      for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-        for (cs_lnum_t j = a2b->idx[a_id]; j < a2b->idx[a_id+1]; j++) {
+    for (cs_lnum_t a_id = 0; a_id < n_a_elts; a_id++) {
 
-          const cs_lnum_t  b_id = a2b->ids[j];
-          const cs_lnum_t  shift = count[b_id] + b2a->idx[b_id];
+      const cs_lnum_t  s = (a_stride > 0) ? a_stride*a_id : a2b->idx[a_id];
+      const cs_lnum_t  e = (a_stride > 0) ? s + a_stride : a2b->idx[a_id+1];
 
-          b2a->ids[shift] = a_id;
-          b2a->sgn[shift] = a2b->sgn[j];
-          count[b_id] += 1;
+      for (cs_lnum_t j = s; j < e; j++) {
 
-        }
-      }
+        const cs_lnum_t  b_id = a2b->ids[j];
+        const cs_lnum_t  shift = count[b_id] + b2a->idx[b_id];
 
-    }
-    else { /* Do not build sgn */
-
-      for (cs_lnum_t a_id = 0; a_id < a2b->n_elts; a_id++) {
-        for (cs_lnum_t j = a2b->idx[a_id]; j < a2b->idx[a_id+1]; j++) {
-
-          const cs_lnum_t  b_id = a2b->ids[j];
-
-          b2a->ids[count[b_id] + b2a->idx[b_id]] = a_id;
-          count[b_id] += 1;
+        b2a->ids[shift] = a_id;
+        if (b2a->sgn != NULL)
+          b2a->sgn[shift] = a2b->sgn[j];
+        count[b_id] += 1;
 
-        }
       }
 
     }
+
   }
 
   /* Free temporary buffer */
+
   BFT_FREE(count);
 
+  if (threaded)
+    cs_adjacency_sort(b2a);
+
   return b2a;
 }
 
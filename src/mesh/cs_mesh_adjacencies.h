@@ -315,9 +315,10 @@ cs_adjacency_destroy(cs_adjacency_t   **p_adj);
  * \brief   Create a new cs_adjacency_t structure from the composition of
  *          two cs_adjacency_t structures: (1) A -> B and (2) B -> C
  *          The resulting structure describes A -> C. It does not rely on a
- *          stride and has no sgn member.
+ *          stride and has no sgn member. The entries of each list are
+ *          sorted.
  *
- * \param[in]  n_c_elts  number of elements in C set
+ * \param[in]  n_c_elts  number of elements in C set (unused)
  * \param[in]  a2b       adjacency A -> B
  * \param[in]  b2c       adjacency B -> C
  *
@@ -185,6 +185,11 @@ cs_mesh_builder_create(void)
   memset(&(mb->vertex_bi), 0, sizeof(cs_block_dist_info_t));
   mb->per_face_bi = NULL;
 
+  /* Optional pending input */
+
+  mb->input = NULL;
+  mb->input_wait = NULL;
+
   return mb;
 }
 
@@ -243,6 +248,27 @@ cs_mesh_builder_destroy(cs_mesh_builder_t  **mb)
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Complete pending input of mesh builder data if necessary.
+ *
+ * Mesh readers may defer completion of some data arrays so that reading
+ * overlaps partitioning and redistribution of other arrays; this function
+ * must be called before accessing such arrays.
+ *
+ * \param[in]  mb    pointer to mesh builder
+ * \param[in]  data  data array which must be complete, or NULL for all arrays
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_mesh_builder_wait_input(const cs_mesh_builder_t  *mb,
+                           const void               *data)
+{
+  if (mb->input_wait != NULL)
+    mb->input_wait(mb->input, data);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Define block distribution sizes for mesh builder.
@@ -51,6 +51,13 @@ BEGIN_C_DECLS
  * Type definitions
  *============================================================================*/
 
+/* Function completing pending input of mesh builder data
+ * (data is the array which must be complete, or NULL for all arrays) */
+
+typedef void
+(cs_mesh_builder_input_wait_t)(void        *input,
+                               const void  *data);
+
 /* Auxiliary and temporary structure used to build or distribute mesh */
 /* ------------------------------------------------------------------ */
 
@@ -100,6 +107,12 @@ typedef struct {
   cs_block_dist_info_t  *per_face_bi;    /* Block info for parallel face
                                             couples */
 
+  /* Optional pending (nonblocking) input */
+
+  void                          *input;       /* Pending input context */
+  cs_mesh_builder_input_wait_t  *input_wait;  /* Associated completion
+                                                 function, or NULL */
+
 } cs_mesh_builder_t;
 
 /*============================================================================
@@ -133,6 +146,22 @@ cs_mesh_builder_create(void);
 void
 cs_mesh_builder_destroy(cs_mesh_builder_t  **mb);
 
+/*----------------------------------------------------------------------------
+ * Complete pending input of mesh builder data if necessary.
+ *
+ * Mesh readers may defer completion of some data arrays so that reading
+ * overlaps partitioning and redistribution of other arrays; this function
+ * must be called before accessing such arrays.
+ *
+ * parameters:
+ *   mb   <-- mesh builder
+ *   data <-- data array which must be complete, or NULL for all arrays
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_builder_wait_input(const cs_mesh_builder_t  *mb,
+                           const void               *data);
+
 /*----------------------------------------------------------------------------
  * Define block distribution sizes for mesh builder.
  *
@@ -0,0 +1,1097 @@
+/*============================================================================
+ * Cache of partitioned, preprocessed mesh (per rank count)
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(HAVE_SYS_TYPES_H) && defined(HAVE_SYS_STAT_H)
+# include <sys/stat.h>
+# include <sys/types.h>
+#endif
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_base.h"
+#include "cs_file.h"
+#include "cs_halo.h"
+#include "cs_interface.h"
+#include "cs_internal_coupling.h"
+#include "cs_io.h"
+#include "cs_join.h"
+#include "cs_join_util.h"
+#include "cs_mesh.h"
+#include "cs_mesh_warping.h"
+#include "cs_numbering.h"
+#include "cs_parall.h"
+#include "cs_parameters.h"
+#include "cs_preprocessor_data.h"
+#include "cs_timer.h"
+#include "cs_tree.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_mesh_cache.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local Type Definitions
+ *============================================================================*/
+
+/* Directory name separator
+   (historically, '/' for Unix/Linux, '\' for Windows, ':' for Mac
+   but '/' should work for all on modern systems) */
+
+#define DIR_SEPARATOR '/'
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static const char _magic_string[] = "Partitioned mesh cache, R1";
+
+static bool  _cache_path_set = false;
+static char *_cache_path = NULL;
+
+/* Checksum of mesh modification settings, computed before they are
+   applied (joinings are destroyed once applied) */
+
+static uint64_t  _settings_cs = 0;
+
+/*=============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Build the name of the cache file associated with the local rank.
+ *
+ * parameters:
+ *   path <-- cache directory path
+ *
+ * returns:
+ *   newly allocated file name
+ *----------------------------------------------------------------------------*/
+
+static char *
+_cache_file_name(const char  *path)
+{
+  char *name = NULL;
+
+  BFT_MALLOC(name, strlen(path) + 64, char);
+  sprintf(name, "%s%cmesh_n%d_r%d.csc",
+          path, DIR_SEPARATOR, cs_glob_n_ranks, CS_MAX(cs_glob_rank_id, 0));
+
+  return name;
+}
+
+/*----------------------------------------------------------------------------
+ * Build cache compatibility info for the local rank.
+ *
+ * parameters:
+ *   halo_type <-- halo type
+ *   info      --> compatibility info
+ *----------------------------------------------------------------------------*/
+
+static void
+_cache_info(cs_halo_type_t  halo_type,
+            int             info[6])
+{
+  info[0] = cs_glob_n_ranks;
+  info[1] = CS_MAX(cs_glob_rank_id, 0);
+  info[2] = cs_glob_n_threads;
+  info[3] = halo_type;
+  info[4] = sizeof(cs_lnum_t);
+  info[5] = sizeof(cs_gnum_t);
+}
+
+/*----------------------------------------------------------------------------
+ * Write a section to a cache file.
+ *
+ * An empty section is written for NULL arrays.
+ *
+ * parameters:
+ *   outp   <-> output file
+ *   name   <-- section name
+ *   type   <-- datatype
+ *   n_vals <-- number of values
+ *   vals   <-- values, or NULL
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_section(cs_io_t        *outp,
+               const char     *name,
+               cs_datatype_t   type,
+               size_t          n_vals,
+               const void     *vals)
+{
+  if (vals == NULL)
+    n_vals = 0;
+
+  cs_io_write_global(name, n_vals, 0, 0, 0, type, vals, outp);
+}
+
+/*----------------------------------------------------------------------------
+ * Read a section of a cache file into an existing array.
+ *
+ * parameters:
+ *   inp    <-> input file
+ *   name   <-- expected section name
+ *   type   <-- expected datatype
+ *   n_vals <-- expected number of values
+ *   vals   --> values
+ *
+ * returns:
+ *   true if the section matches expectations and was read, false otherwise
+ *----------------------------------------------------------------------------*/
+
+static bool
+_read_section(cs_io_t        *inp,
+              const char     *name,
+              cs_datatype_t   type,
+              size_t          n_vals,
+              void           *vals)
+{
+  cs_io_sec_header_t  header;
+
+  cs_io_read_header(inp, &header);
+
+  if (   strcmp(header.sec_name, name) != 0
+      || header.type_read != type
+      || (size_t)(header.n_vals) != n_vals)
+    return false;
+
+  header.elt_type = type;
+  cs_io_read_global(&header, vals, inp);
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------
+ * Read a section of a cache file into a newly allocated array.
+ *
+ * Sections are expected to be either empty or contain the given number
+ * of values; other cases lead to an error.
+ *
+ * parameters:
+ *   inp    <-> input file
+ *   name   <-- expected section name
+ *   type   <-- expected datatype
+ *   n_vals <-- expected number of values
+ *
+ * returns:
+ *   pointer to allocated array, or NULL for an empty section
+ *----------------------------------------------------------------------------*/
+
+static void *
+_read_array(cs_io_t        *inp,
+            const char     *name,
+            cs_datatype_t   type,
+            size_t          n_vals)
+{
+  cs_io_sec_header_t  header;
+  unsigned char *vals = NULL;
+
+  cs_io_read_header(inp, &header);
+
+  if (   strcmp(header.sec_name, name) != 0
+      || (header.n_vals > 0 && header.type_read != type)
+      || (header.n_vals > 0 && (size_t)(header.n_vals) != n_vals))
+    bft_error(__FILE__, __LINE__, 0,
+              _("Section \"%s\" of mesh cache file \"%s\"\n"
+                "does not match the expected \"%s\" section\n"
+                "(%llu values expected)."),
+              header.sec_name, cs_io_get_name(inp), name,
+              (unsigned long long)n_vals);
+
+  if (header.n_vals > 0) {
+    BFT_MALLOC(vals, n_vals*cs_datatype_size[type], unsigned char);
+    header.elt_type = type;
+    cs_io_read_global(&header, vals, inp);
+  }
+
+  return vals;
+}
+
+/*----------------------------------------------------------------------------
+ * Write a numbering structure to a cache file.
+ *
+ * parameters:
+ *   outp      <-> output file
+ *   name      <-- associated section base name
+ *   numbering <-- pointer to numbering structure, or NULL
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_numbering(cs_io_t               *outp,
+                 const char            *name,
+                 const cs_numbering_t  *numbering)
+{
+  char sec_name[64];
+  cs_lnum_t info[6] = {0, 0, 0, 0, 0, 0};
+  const cs_lnum_t *group_index = NULL;
+
+  if (numbering != NULL) {
+    info[0] = numbering->type;
+    info[1] = numbering->vector_size;
+    info[2] = numbering->n_threads;
+    info[3] = numbering->n_groups;
+    info[4] = numbering->n_no_adj_halo_groups;
+    info[5] = numbering->n_no_adj_halo_elts;
+    group_index = numbering->group_index;
+  }
+
+  snprintf(sec_name, 63, "%s_numbering", name);
+  _write_section(outp, sec_name, CS_LNUM_TYPE, 6, info);
+
+  snprintf(sec_name, 63, "%s_numbering_index", name);
+  _write_section(outp, sec_name, CS_LNUM_TYPE,
+                 info[2]*info[3]*2, group_index);
+}
+
+/*----------------------------------------------------------------------------
+ * Read a numbering structure from a cache file.
+ *
+ * parameters:
+ *   inp  <-> input file
+ *   name <-- associated section base name
+ *
+ * returns:
+ *   pointer to created numbering structure, or NULL
+ *----------------------------------------------------------------------------*/
+
+static cs_numbering_t *
+_read_numbering(cs_io_t     *inp,
+                const char  *name)
+{
+  char sec_name[64];
+  cs_lnum_t info[6];
+  cs_numbering_t *numbering = NULL;
+
+  snprintf(sec_name, 63, "%s_numbering", name);
+  if (_read_section(inp, sec_name, CS_LNUM_TYPE, 6, info) == false)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Mesh cache file \"%s\":\n"
+                "missing or inconsistent \"%s\" section."),
+              cs_io_get_name(inp), sec_name);
+
+  snprintf(sec_name, 63, "%s_numbering_index", name);
+  cs_lnum_t *group_index = _read_array(inp, sec_name, CS_LNUM_TYPE,
+                                       info[2]*info[3]*2);
+
+  if (group_index != NULL) {
+    BFT_MALLOC(numbering, 1, cs_numbering_t);
+    numbering->type = info[0];
+    numbering->vector_size = info[1];
+    numbering->n_threads = info[2];
+    numbering->n_groups = info[3];
+    numbering->n_no_adj_halo_groups = info[4];
+    numbering->n_no_adj_halo_elts = info[5];
+    numbering->group_index = group_index;
+  }
+
+  return numbering;
+}
+
+/*----------------------------------------------------------------------------
+ * Update a 64-bit FNV-1a hash with given data.
+ *
+ * parameters:
+ *   h    <-- initial hash value
+ *   data <-- data to hash
+ *   size <-- data size, in bytes
+ *
+ * returns:
+ *   updated hash value
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_fnv1a_update(uint64_t     h,
+              const void  *data,
+              size_t       size)
+{
+  const unsigned char *p = data;
+
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+
+  return h;
+}
+
+/*----------------------------------------------------------------------------
+ * Update a hash with a character string (NULL strings are allowed).
+ *
+ * parameters:
+ *   h <-- initial hash value
+ *   s <-- string, or NULL
+ *
+ * returns:
+ *   updated hash value
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_fnv1a_update_str(uint64_t     h,
+                  const char  *s)
+{
+  if (s != NULL)
+    h = _fnv1a_update(h, s, strlen(s) + 1);
+  else
+    h = _fnv1a_update(h, "", 1);
+
+  return h;
+}
+
+/*----------------------------------------------------------------------------
+ * Update a hash with a tree node and its descendants (names and values).
+ *
+ * parameters:
+ *   h    <-- initial hash value
+ *   node <-- tree node, or NULL
+ *
+ * returns:
+ *   updated hash value
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_tree_checksum(uint64_t               h,
+               const cs_tree_node_t  *node)
+{
+  for (const cs_tree_node_t *tn = node; tn != NULL; tn = tn->next) {
+
+    h = _fnv1a_update_str(h, tn->name);
+    h = _fnv1a_update(h, &(tn->size), sizeof(int));
+
+    if (tn->value != NULL) {
+      if (tn->flag & CS_TREE_NODE_CHAR)
+        h = _fnv1a_update_str(h, tn->value);
+      else if (tn->flag & CS_TREE_NODE_INT)
+        h = _fnv1a_update(h, tn->value, tn->size*sizeof(int));
+      else if (tn->flag & CS_TREE_NODE_REAL)
+        h = _fnv1a_update(h, tn->value, tn->size*sizeof(cs_real_t));
+      else if (tn->flag & CS_TREE_NODE_BOOL)
+        h = _fnv1a_update(h, tn->value, tn->size*sizeof(bool));
+    }
+
+    h = _tree_checksum(h, tn->children);
+
+  }
+
+  return h;
+}
+
+/*----------------------------------------------------------------------------
+ * Compute a checksum of preprocessing settings which modify the mesh
+ * after it is read.
+ *
+ * User-defined mesh functions are part of the executable, so its size
+ * and modification time are used to detect their changes.
+ *
+ * returns:
+ *   checksum of mesh modification settings
+ *----------------------------------------------------------------------------*/
+
+static uint64_t
+_settings_checksum(void)
+{
+  uint64_t h = 14695981039346656037ULL;
+
+  int restart_mode = cs_preprocessor_data_get_restart_mode();
+  h = _fnv1a_update(h, &restart_mode, sizeof(int));
+
+  /* Joinings and periodicities */
+
+  h = _fnv1a_update(h, &cs_glob_n_joinings, sizeof(int));
+
+  for (int j_id = 0; j_id < cs_glob_n_joinings; j_id++) {
+    const cs_join_t *j = cs_glob_join_array[j_id];
+    const cs_join_param_t *p = &(j->param);
+    h = _fnv1a_update_str(h, j->criteria);
+    h = _fnv1a_update(h, &(p->perio_type), sizeof(int));
+    h = _fnv1a_update(h, p->perio_matrix, 12*sizeof(double));
+    h = _fnv1a_update(h, &(p->fraction), sizeof(float));
+    h = _fnv1a_update(h, &(p->plane), sizeof(float));
+    h = _fnv1a_update(h, &(p->merge_tol_coef), sizeof(float));
+    h = _fnv1a_update(h, &(p->pre_merge_factor), sizeof(float));
+    h = _fnv1a_update(h, &(p->n_max_equiv_breaks), sizeof(int));
+    h = _fnv1a_update(h, &(p->tcm), sizeof(int));
+    h = _fnv1a_update(h, &(p->icm), sizeof(int));
+    h = _fnv1a_update(h, &(p->max_sub_faces), sizeof(int));
+  }
+
+  /* Cutting of warped faces */
+
+  double cwf_threshold = -1.0;
+  cs_mesh_warping_get_defaults(&cwf_threshold, NULL);
+  h = _fnv1a_update(h, &cwf_threshold, sizeof(double));
+
+  /* Internal coupling */
+
+  int n_ic = cs_internal_coupling_n_couplings();
+  h = _fnv1a_update(h, &n_ic, sizeof(int));
+
+  for (int ic_id = 0; ic_id < n_ic; ic_id++) {
+    const cs_internal_coupling_t *ic = cs_internal_coupling_by_id(ic_id);
+    h = _fnv1a_update_str(h, ic->cells_criteria);
+    h = _fnv1a_update_str(h, ic->faces_criteria);
+    h = _fnv1a_update(h, &(ic->n_volume_zones), sizeof(int));
+    if (ic->n_volume_zones > 0)
+      h = _fnv1a_update(h, ic->volume_zone_ids,
+                        ic->n_volume_zones*sizeof(int));
+  }
+
+  /* Mesh settings from the GUI */
+
+  if (cs_glob_tree != NULL)
+    h = _tree_checksum(h, cs_tree_get_node(cs_glob_tree, "solution_domain"));
+
+  /* Executable (including user-defined functions) */
+
+  uint64_t exe_info[2] = {0, 0};
+
+#if defined(HAVE_SYS_STAT_H)
+  if (cs_glob_rank_id < 1) {
+    struct stat st;
+    if (stat("/proc/self/exe", &st) == 0) {
+      exe_info[0] = st.st_size;
+      exe_info[1] = st.st_mtime;
+    }
+  }
+  cs_parall_bcast(0, 2, CS_UINT64, exe_info);
+#endif
+
+  h = _fnv1a_update(h, exe_info, 2*sizeof(uint64_t));
+
+  if (h == 0)
+    h = 1;
+
+  return h;
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Define the directory used for the partitioned mesh cache.
+ *
+ * When a cache directory is defined, each rank saves its local mesh
+ * (after partitioning, halo construction and renumbering) to a separate
+ * file in this directory, and subsequent runs using the same mesh input
+ * and the same number of ranks read the local mesh from that file
+ * instead of repeating those operations.
+ *
+ * The cached mesh includes the effects of all preprocessing operations
+ * (joining, user modifications, ...), so it is only used if the settings
+ * of those operations (joinings, warped faces cutting, internal coupling,
+ * and GUI mesh settings) and the executable (which contains user-defined
+ * mesh functions) are unchanged. Mesh modifications depending on other
+ * data (such as files read by user functions) are not detected, so the
+ * cache directory should be cleaned in that case. Meshes with periodicity
+ * are not cached.
+ *
+ * If this function is not called, the CS_MESH_CACHE_DIR environment
+ * variable is used, if defined.
+ *
+ * parameters:
+ *   path <-- cache directory path, or NULL to disable the cache
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_set_path(const char  *path)
+{
+  BFT_FREE(_cache_path);
+
+  if (path != NULL) {
+    if (strlen(path) > 0) {
+      BFT_MALLOC(_cache_path, strlen(path) + 1, char);
+      strcpy(_cache_path, path);
+    }
+  }
+
+  _cache_path_set = true;
+}
+
+/*----------------------------------------------------------------------------
+ * Return the directory used for the partitioned mesh cache.
+ *
+ * returns:
+ *   cache directory path, or NULL if the cache is not active
+ *----------------------------------------------------------------------------*/
+
+const char *
+cs_mesh_cache_get_path(void)
+{
+  if (_cache_path_set == false)
+    cs_mesh_cache_set_path(getenv("CS_MESH_CACHE_DIR"));
+
+  return _cache_path;
+}
+
+/*----------------------------------------------------------------------------
+ * Free partitioned mesh cache settings.
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_finalize(void)
+{
+  BFT_FREE(_cache_path);
+  _cache_path_set = false;
+}
+
+/*----------------------------------------------------------------------------
+ * Load a mesh from the partitioned mesh cache if a matching cache exists.
+ *
+ * The cache is used only if files for all ranks are present, and match
+ * the given mesh input checksum, mesh modification settings, halo type,
+ * and the current number of ranks and threads. In this case, the mesh
+ * structure is reinitialized and replaced by the cached mesh, including
+ * halo and numbering information.
+ *
+ * This function is collective over all ranks.
+ *
+ * parameters:
+ *   mesh      <-> pointer to mesh structure
+ *   halo_type <-- expected halo type
+ *   checksum  <-- mesh input checksum
+ *
+ * returns:
+ *   true if the mesh was read from the cache, false otherwise
+ *----------------------------------------------------------------------------*/
+
+bool
+cs_mesh_cache_load(cs_mesh_t       *mesh,
+                   cs_halo_type_t   halo_type,
+                   uint64_t         checksum)
+{
+  const char *path = cs_mesh_cache_get_path();
+
+  if (path == NULL || checksum == 0)
+    return false;
+
+  double t0 = cs_timer_wtime();
+
+  _settings_cs = _settings_checksum();
+
+  char *name = _cache_file_name(path);
+  cs_io_t *inp = NULL;
+
+  /* Check that cache files are present and compatible on all ranks */
+
+  int is_valid = 0;
+
+  if (cs_file_isreg(name)) {
+
+#if defined(HAVE_MPI)
+    inp = cs_io_initialize(name,
+                           _magic_string,
+                           CS_IO_MODE_READ,
+                           CS_FILE_STDIO_SERIAL,
+                           CS_IO_ECHO_NONE,
+                           MPI_INFO_NULL,
+                           MPI_COMM_NULL,
+                           MPI_COMM_NULL);
+#else
+    inp = cs_io_initialize(name,
+                           _magic_string,
+                           CS_IO_MODE_READ,
+                           CS_FILE_STDIO_SERIAL,
+                           CS_IO_ECHO_NONE);
+#endif
+
+    uint64_t c_checksum = 0, c_settings_cs = 0;
+    int info[6], c_info[6];
+
+    _cache_info(halo_type, info);
+
+    if (   _read_section(inp, "checksum", CS_UINT64, 1, &c_checksum)
+        && _read_section(inp, "settings_checksum", CS_UINT64, 1,
+                         &c_settings_cs)
+        && _read_section(inp, "cache_info", CS_INT_TYPE, 6, c_info)) {
+      if (   c_checksum == checksum
+          && c_settings_cs == _settings_cs
+          && memcmp(info, c_info, 6*sizeof(int)) == 0)
+        is_valid = 1;
+    }
+
+  }
+
+  cs_parall_min(1, CS_INT_TYPE, &is_valid);
+
+  if (is_valid == 0) {
+    if (inp != NULL)
+      cs_io_finalize(&inp);
+    BFT_FREE(name);
+    bft_printf(_("\n No matching partitioned mesh cache in \"%s\".\n"),
+               path);
+    return false;
+  }
+
+  /* Replace current mesh definitions */
+
+  cs_mesh_reinit(mesh);
+
+  cs_lnum_t n_elts[8];
+  cs_gnum_t n_g_elts[7];
+  int flags[6];
+
+  if (   _read_section(inp, "n_elts", CS_LNUM_TYPE, 8, n_elts) == false
+      || _read_section(inp, "n_g_elts", CS_GNUM_TYPE, 7, n_g_elts) == false
+      || _read_section(inp, "mesh_flags", CS_INT_TYPE, 6, flags) == false)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Mesh cache file \"%s\":\n"
+                "missing or inconsistent dimensions."), name);
+
+  mesh->dim = 3;
+  mesh->domain_num = cs_glob_rank_id + 1;
+  mesh->n_domains = cs_glob_n_ranks;
+
+  mesh->n_cells = n_elts[0];
+  mesh->n_i_faces = n_elts[1];
+  mesh->n_b_faces = n_elts[2];
+  mesh->n_vertices = n_elts[3];
+  mesh->i_face_vtx_connect_size = n_elts[4];
+  mesh->b_face_vtx_connect_size = n_elts[5];
+  mesh->n_ghost_cells = n_elts[6];
+  mesh->n_b_faces_all = n_elts[7];
+
+  mesh->n_cells_with_ghosts = mesh->n_cells + mesh->n_ghost_cells;
+
+  mesh->n_g_cells = n_g_elts[0];
+  mesh->n_g_i_faces = n_g_elts[1];
+  mesh->n_g_b_faces = n_g_elts[2];
+  mesh->n_g_vertices = n_g_elts[3];
+  mesh->n_g_i_c_faces = n_g_elts[4];
+  mesh->n_g_free_faces = n_g_elts[5];
+  mesh->n_g_b_faces_all = n_g_elts[6];
+
+  mesh->time_dep = flags[0];
+  mesh->modified = flags[1];
+  mesh->save_if_modified = flags[2];
+  mesh->have_r_gen = (flags[3] != 0) ? true : false;
+  mesh->n_groups = flags[4];
+  mesh->n_families = flags[5];
+
+  mesh->n_init_perio = 0;
+  mesh->n_transforms = 0;
+  mesh->have_rotation_perio = 0;
+  mesh->halo_type = halo_type;
+
+  const cs_lnum_t n_cells = mesh->n_cells;
+  const cs_lnum_t n_i_faces = mesh->n_i_faces;
+  const cs_lnum_t n_b_faces = mesh->n_b_faces;
+  const cs_lnum_t n_vertices = mesh->n_vertices;
+
+  /* Connectivity and coordinates */
+
+  mesh->vtx_coord = _read_array(inp, "vertex_coords", CS_REAL_TYPE,
+                                n_vertices*3);
+  mesh->i_face_cells = _read_array(inp, "i_face_cells", CS_LNUM_TYPE,
+                                   n_i_faces*2);
+  mesh->b_face_cells = _read_array(inp, "b_face_cells", CS_LNUM_TYPE,
+                                   n_b_faces);
+  mesh->i_face_vtx_idx = _read_array(inp, "i_face_vertices_index",
+                                     CS_LNUM_TYPE, n_i_faces + 1);
+  mesh->i_face_vtx_lst = _read_array(inp, "i_face_vertices", CS_LNUM_TYPE,
+                                     mesh->i_face_vtx_connect_size);
+  mesh->b_face_vtx_idx = _read_array(inp, "b_face_vertices_index",
+                                     CS_LNUM_TYPE, n_b_faces + 1);
+  mesh->b_face_vtx_lst = _read_array(inp, "b_face_vertices", CS_LNUM_TYPE,
+                                     mesh->b_face_vtx_connect_size);
+
+  /* Global numbering */
+
+  mesh->global_cell_num = _read_array(inp, "cell_gnum", CS_GNUM_TYPE,
+                                      n_cells);
+  mesh->global_i_face_num = _read_array(inp, "i_face_gnum", CS_GNUM_TYPE,
+                                        n_i_faces);
+  mesh->global_b_face_num = _read_array(inp, "b_face_gnum", CS_GNUM_TYPE,
+                                        n_b_faces);
+  mesh->global_vtx_num = _read_array(inp, "vertex_gnum", CS_GNUM_TYPE,
+                                     n_vertices);
+
+  /* Groups and families */
+
+  mesh->group_idx = _read_array(inp, "group_index", CS_INT_TYPE,
+                                mesh->n_groups + 1);
+  mesh->group = _read_array(inp, "group_names", CS_CHAR,
+                            (mesh->group_idx != NULL) ?
+                            mesh->group_idx[mesh->n_groups] : 0);
+
+  if (_read_section(inp, "n_max_family_items", CS_INT_TYPE, 1,
+                    &(mesh->n_max_family_items)) == false)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Mesh cache file \"%s\":\n"
+                "missing or inconsistent family definitions."), name);
+
+  mesh->family_item = _read_array(inp, "family_items", CS_INT_TYPE,
+                                  mesh->n_families*mesh->n_max_family_items);
+  mesh->cell_family = _read_array(inp, "cell_family", CS_INT_TYPE,
+                                  mesh->n_cells_with_ghosts);
+  mesh->i_face_family = _read_array(inp, "i_face_family", CS_INT_TYPE,
+                                    n_i_faces);
+  mesh->b_face_family = _read_array(inp, "b_face_family", CS_INT_TYPE,
+                                    n_b_faces);
+
+  /* Refinement generation */
+
+  mesh->i_face_r_gen = _read_array(inp, "i_face_r_gen", CS_CHAR, n_i_faces);
+  mesh->vtx_r_gen = _read_array(inp, "vertex_r_gen", CS_CHAR, n_vertices);
+
+  /* Halo */
+
+  cs_lnum_t halo_info[2] = {0, 0};
+  if (_read_section(inp, "halo_info", CS_LNUM_TYPE, 2, halo_info) == false)
+    bft_error(__FILE__, __LINE__, 0,
+              _("Mesh cache file \"%s\":\n"
+                "missing or inconsistent halo definitions."), name);
+
+  {
+    int n_c_domains = halo_info[0];
+
+    int *c_domain_rank
+      = _read_array(inp, "halo_ranks", CS_INT_TYPE, n_c_domains);
+    cs_lnum_t *send_index
+      = _read_array(inp, "halo_send_index", CS_LNUM_TYPE, 2*n_c_domains + 1);
+    cs_lnum_t *send_list
+      = _read_array(inp, "halo_send_list", CS_LNUM_TYPE,
+                    (send_index != NULL) ? send_index[2*n_c_domains] : 0);
+    cs_lnum_t *index
+      = _read_array(inp, "halo_index", CS_LNUM_TYPE, 2*n_c_domains + 1);
+
+    if (send_index != NULL)
+      mesh->halo = cs_halo_create_from_lists(n_c_domains,
+                                             c_domain_rank,
+                                             halo_info[1],
+                                             send_index,
+                                             send_list,
+                                             index);
+
+    BFT_FREE(c_domain_rank);
+    BFT_FREE(send_index);
+    BFT_FREE(send_list);
+    BFT_FREE(index);
+  }
+
+  /* Extended neighborhood */
+
+  mesh->cell_cells_idx = _read_array(inp, "cell_cells_index", CS_LNUM_TYPE,
+                                     n_cells + 1);
+  mesh->cell_cells_lst
+    = _read_array(inp, "cell_cells", CS_LNUM_TYPE,
+                  (mesh->cell_cells_idx != NULL) ?
+                  mesh->cell_cells_idx[n_cells] : 0);
+
+  mesh->gcell_vtx_idx = _read_array(inp, "gcell_vertices_index",
+                                    CS_LNUM_TYPE, mesh->n_ghost_cells + 1);
+  mesh->gcell_vtx_lst
+    = _read_array(inp, "gcell_vertices", CS_LNUM_TYPE,
+                  (mesh->gcell_vtx_idx != NULL) ?
+                  mesh->gcell_vtx_idx[mesh->n_ghost_cells] : 0);
+
+  /* Numbering */
+
+  mesh->cell_numbering = _read_numbering(inp, "cell");
+  mesh->i_face_numbering = _read_numbering(inp, "i_face");
+  mesh->b_face_numbering = _read_numbering(inp, "b_face");
+  mesh->vtx_numbering = _read_numbering(inp, "vertex");
+
+  cs_io_finalize(&inp);
+
+  /* Vertex interfaces are rebuilt from the (cached) global numbering */
+
+  if (mesh->n_domains > 1)
+    mesh->vtx_interfaces = cs_interface_set_create(n_vertices,
+                                                   NULL,
+                                                   mesh->global_vtx_num,
+                                                   NULL,
+                                                   0,
+                                                   NULL,
+                                                   NULL,
+                                                   NULL);
+
+  cs_mesh_update_auxiliary(mesh);
+
+  double t1 = cs_timer_wtime();
+
+  bft_printf(_("\n Mesh read from partitioned mesh cache \"%s\" (%.3g s)\n"),
+             path, t1-t0);
+
+  BFT_FREE(name);
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------
+ * Save a preprocessed mesh to the partitioned mesh cache.
+ *
+ * Nothing is done if the cache is not active, or if the mesh
+ * has periodicity. This function should be called after
+ * cs_mesh_cache_load(), which determines the mesh modification
+ * settings before they are applied.
+ *
+ * This function is collective over all ranks.
+ *
+ * parameters:
+ *   mesh     <-- pointer to mesh structure
+ *   checksum <-- mesh input checksum
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_save(const cs_mesh_t  *mesh,
+                   uint64_t          checksum)
+{
+  const char *path = cs_mesh_cache_get_path();
+
+  if (   path == NULL || checksum == 0 || _settings_cs == 0
+      || mesh->n_init_perio > 0)
+    return;
+
+  double t0 = cs_timer_wtime();
+
+  if (cs_glob_rank_id < 1) {
+    if (cs_file_mkdir_default(path) != 0)
+      bft_error(__FILE__, __LINE__, 0,
+                _("The %s directory cannot be created"), path);
+  }
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Barrier(cs_glob_mpi_comm);
+#endif
+
+  char *name = _cache_file_name(path);
+
+#if defined(HAVE_MPI)
+  cs_io_t *outp = cs_io_initialize(name,
+                                   _magic_string,
+                                   CS_IO_MODE_WRITE,
+                                   CS_FILE_STDIO_SERIAL,
+                                   CS_IO_ECHO_NONE,
+                                   MPI_INFO_NULL,
+                                   MPI_COMM_NULL,
+                                   MPI_COMM_NULL);
+#else
+  cs_io_t *outp = cs_io_initialize(name,
+                                   _magic_string,
+                                   CS_IO_MODE_WRITE,
+                                   CS_FILE_STDIO_SERIAL,
+                                   CS_IO_ECHO_NONE);
+#endif
+
+  BFT_FREE(name);
+
+  const cs_lnum_t n_cells = mesh->n_cells;
+  const cs_lnum_t n_i_faces = mesh->n_i_faces;
+  const cs_lnum_t n_b_faces = mesh->n_b_faces;
+  const cs_lnum_t n_vertices = mesh->n_vertices;
+
+  /* Compatibility info */
+
+  {
+    int info[6];
+    _cache_info(mesh->halo_type, info);
+
+    _write_section(outp, "checksum", CS_UINT64, 1, &checksum);
+    _write_section(outp, "settings_checksum", CS_UINT64, 1, &_settings_cs);
+    _write_section(outp, "cache_info", CS_INT_TYPE, 6, info);
+  }
+
+  /* Dimensions */
+
+  {
+    cs_lnum_t n_elts[8] = {n_cells,
+                           n_i_faces,
+                           n_b_faces,
+                           n_vertices,
+                           mesh->i_face_vtx_connect_size,
+                           mesh->b_face_vtx_connect_size,
+                           mesh->n_ghost_cells,
+                           mesh->n_b_faces_all};
+    cs_gnum_t n_g_elts[7] = {mesh->n_g_cells,
+                             mesh->n_g_i_faces,
+                             mesh->n_g_b_faces,
+                             mesh->n_g_vertices,
+                             mesh->n_g_i_c_faces,
+                             mesh->n_g_free_faces,
+                             mesh->n_g_b_faces_all};
+    int flags[6] = {mesh->time_dep,
+                    mesh->modified,
+                    mesh->save_if_modified,
+                    (mesh->have_r_gen) ? 1 : 0,
+                    mesh->n_groups,
+                    mesh->n_families};
+
+    _write_section(outp, "n_elts", CS_LNUM_TYPE, 8, n_elts);
+    _write_section(outp, "n_g_elts", CS_GNUM_TYPE, 7, n_g_elts);
+    _write_section(outp, "mesh_flags", CS_INT_TYPE, 6, flags);
+  }
+
+  /* Connectivity and coordinates */
+
+  _write_section(outp, "vertex_coords", CS_REAL_TYPE, n_vertices*3,
+                 mesh->vtx_coord);
+  _write_section(outp, "i_face_cells", CS_LNUM_TYPE, n_i_faces*2,
+                 mesh->i_face_cells);
+  _write_section(outp, "b_face_cells", CS_LNUM_TYPE, n_b_faces,
+                 mesh->b_face_cells);
+  _write_section(outp, "i_face_vertices_index", CS_LNUM_TYPE, n_i_faces + 1,
+                 mesh->i_face_vtx_idx);
+  _write_section(outp, "i_face_vertices", CS_LNUM_TYPE,
+                 mesh->i_face_vtx_connect_size, mesh->i_face_vtx_lst);
+  _write_section(outp, "b_face_vertices_index", CS_LNUM_TYPE, n_b_faces + 1,
+                 mesh->b_face_vtx_idx);
+  _write_section(outp, "b_face_vertices", CS_LNUM_TYPE,
+                 mesh->b_face_vtx_connect_size, mesh->b_face_vtx_lst);
+
+  /* Global numbering */
+
+  _write_section(outp, "cell_gnum", CS_GNUM_TYPE, n_cells,
+                 mesh->global_cell_num);
+  _write_section(outp, "i_face_gnum", CS_GNUM_TYPE, n_i_faces,
+                 mesh->global_i_face_num);
+  _write_section(outp, "b_face_gnum", CS_GNUM_TYPE, n_b_faces,
+                 mesh->global_b_face_num);
+  _write_section(outp, "vertex_gnum", CS_GNUM_TYPE, n_vertices,
+                 mesh->global_vtx_num);
+
+  /* Groups and families */
+
+  _write_section(outp, "group_index", CS_INT_TYPE, mesh->n_groups + 1,
+                 mesh->group_idx);
+  _write_section(outp, "group_names", CS_CHAR,
+                 (mesh->group_idx != NULL) ?
+                 mesh->group_idx[mesh->n_groups] : 0,
+                 mesh->group);
+  _write_section(outp, "n_max_family_items", CS_INT_TYPE, 1,
+                 &(mesh->n_max_family_items));
+  _write_section(outp, "family_items", CS_INT_TYPE,
+                 mesh->n_families*mesh->n_max_family_items,
+                 mesh->family_item);
+  _write_section(outp, "cell_family", CS_INT_TYPE,
+                 mesh->n_cells_with_ghosts, mesh->cell_family);
+  _write_section(outp, "i_face_family", CS_INT_TYPE, n_i_faces,
+                 mesh->i_face_family);
+  _write_section(outp, "b_face_family", CS_INT_TYPE, n_b_faces,
+                 mesh->b_face_family);
+
+  /* Refinement generation */
+
+  _write_section(outp, "i_face_r_gen", CS_CHAR, n_i_faces,
+                 mesh->i_face_r_gen);
+  _write_section(outp, "vertex_r_gen", CS_CHAR, n_vertices,
+                 mesh->vtx_r_gen);
+
+  /* Halo */
+
+  {
+    const cs_halo_t *halo = mesh->halo;
+
+    cs_lnum_t halo_info[2] = {0, 0};
+    const int *c_domain_rank = NULL;
+    const cs_lnum_t *send_index = NULL, *send_list = NULL, *index = NULL;
+    cs_lnum_t n_send = 0;
+
+    if (halo != NULL) {
+      halo_info[0] = halo->n_c_domains;
+      halo_info[1] = halo->n_local_elts;
+      c_domain_rank = halo->c_domain_rank;
+      send_index = halo->send_index;
+      send_list = halo->send_list;
+      index = halo->index;
+      n_send = halo->send_index[2*halo->n_c_domains];
+    }
+
+    _write_section(outp, "halo_info", CS_LNUM_TYPE, 2, halo_info);
+    _write_section(outp, "halo_ranks", CS_INT_TYPE, halo_info[0],
+                   c_domain_rank);
+    _write_section(outp, "halo_send_index", CS_LNUM_TYPE, 2*halo_info[0] + 1,
+                   send_index);
+    _write_section(outp, "halo_send_list", CS_LNUM_TYPE, n_send,
+                   send_list);
+    _write_section(outp, "halo_index", CS_LNUM_TYPE, 2*halo_info[0] + 1,
+                   index);
+  }
+
+  /* Extended neighborhood */
+
+  _write_section(outp, "cell_cells_index", CS_LNUM_TYPE, n_cells + 1,
+                 mesh->cell_cells_idx);
+  _write_section(outp, "cell_cells", CS_LNUM_TYPE,
+                 (mesh->cell_cells_idx != NULL) ?
+                 mesh->cell_cells_idx[n_cells] : 0,
+                 mesh->cell_cells_lst);
+  _write_section(outp, "gcell_vertices_index", CS_LNUM_TYPE,
+                 mesh->n_ghost_cells + 1, mesh->gcell_vtx_idx);
+  _write_section(outp, "gcell_vertices", CS_LNUM_TYPE,
+                 (mesh->gcell_vtx_idx != NULL) ?
+                 mesh->gcell_vtx_idx[mesh->n_ghost_cells] : 0,
+                 mesh->gcell_vtx_lst);
+
+  /* Numbering */
+
+  _write_numbering(outp, "cell", mesh->cell_numbering);
+  _write_numbering(outp, "i_face", mesh->i_face_numbering);
+  _write_numbering(outp, "b_face", mesh->b_face_numbering);
+  _write_numbering(outp, "vertex", mesh->vtx_numbering);
+
+  cs_io_finalize(&outp);
+
+  double t1 = cs_timer_wtime();
+
+  bft_printf(_("\n Mesh saved to partitioned mesh cache \"%s\" (%.3g s)\n"),
+             path, t1-t0);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
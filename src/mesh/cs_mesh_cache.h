@@ -0,0 +1,139 @@
+#ifndef __CS_MESH_CACHE_H__
+#define __CS_MESH_CACHE_H__
+
+/*============================================================================
+ * Cache of partitioned, preprocessed mesh (per rank count)
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_base.h"
+#include "cs_halo.h"
+#include "cs_mesh.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ *  Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Define the directory used for the partitioned mesh cache.
+ *
+ * When a cache directory is defined, each rank saves its local mesh
+ * (after partitioning, halo construction and renumbering) to a separate
+ * file in this directory, and subsequent runs using the same mesh input
+ * and the same number of ranks read the local mesh from that file
+ * instead of repeating those operations.
+ *
+ * The cached mesh includes the effects of all preprocessing operations
+ * (joining, user modifications, ...), so it is only used if the settings
+ * of those operations (joinings, warped faces cutting, internal coupling,
+ * and GUI mesh settings) and the executable (which contains user-defined
+ * mesh functions) are unchanged. Mesh modifications depending on other
+ * data (such as files read by user functions) are not detected, so the
+ * cache directory should be cleaned in that case. Meshes with periodicity
+ * are not cached.
+ *
+ * If this function is not called, the CS_MESH_CACHE_DIR environment
+ * variable is used, if defined.
+ *
+ * parameters:
+ *   path <-- cache directory path, or NULL to disable the cache
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_set_path(const char  *path);
+
+/*----------------------------------------------------------------------------
+ * Return the directory used for the partitioned mesh cache.
+ *
+ * returns:
+ *   cache directory path, or NULL if the cache is not active
+ *----------------------------------------------------------------------------*/
+
+const char *
+cs_mesh_cache_get_path(void);
+
+/*----------------------------------------------------------------------------
+ * Free partitioned mesh cache settings.
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_finalize(void);
+
+/*----------------------------------------------------------------------------
+ * Load a mesh from the partitioned mesh cache if a matching cache exists.
+ *
+ * The cache is used only if files for all ranks are present, and match
+ * the given mesh input checksum, mesh modification settings, halo type,
+ * and the current number of ranks and threads. In this case, the mesh
+ * structure is reinitialized and replaced by the cached mesh, including
+ * halo and numbering information.
+ *
+ * This function is collective over all ranks.
+ *
+ * parameters:
+ *   mesh      <-> pointer to mesh structure
+ *   halo_type <-- expected halo type
+ *   checksum  <-- mesh input checksum
+ *
+ * returns:
+ *   true if the mesh was read from the cache, false otherwise
+ *----------------------------------------------------------------------------*/
+
+bool
+cs_mesh_cache_load(cs_mesh_t       *mesh,
+                   cs_halo_type_t   halo_type,
+                   uint64_t         checksum);
+
+/*----------------------------------------------------------------------------
+ * Save a preprocessed mesh to the partitioned mesh cache.
+ *
+ * Nothing is done if the cache is not active, or if the mesh
+ * has periodicity. This function should be called after
+ * cs_mesh_cache_load(), which determines the mesh modification
+ * settings before they are applied.
+ *
+ * This function is collective over all ranks.
+ *
+ * parameters:
+ *   mesh     <-- pointer to mesh structure
+ *   checksum <-- mesh input checksum
+ *----------------------------------------------------------------------------*/
+
+void
+cs_mesh_cache_save(const cs_mesh_t  *mesh,
+                   uint64_t          checksum);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_MESH_CACHE_H__ */
@@ -974,6 +974,10 @@ _default_face_rank(const cs_mesh_builder_t  *mb,
   if (n_g_free_faces == 0)
     return NULL;
 
+  /* Face centers require vertex data */
+
+  cs_mesh_builder_wait_input(mb, NULL);
+
   /* Initialize rank info */
 
   MPI_Comm_size(comm, &n_ranks);
@@ -1217,7 +1221,9 @@ _decompose_data_g(cs_mesh_t          *mesh,
 
   BFT_FREE(mb->face_r_gen);
 
-  /* Face connectivity */
+  /* Face connectivity (input of which may have overlapped previous steps) */
+
+  cs_mesh_builder_wait_input(mb, mb->face_vertices);
 
   BFT_MALLOC(_face_vertices_idx, _n_faces + 1, cs_lnum_t);
 
@@ -1253,6 +1259,8 @@ _decompose_data_g(cs_mesh_t          *mesh,
 
   mesh->n_vertices = _n_vertices;
 
+  cs_mesh_builder_wait_input(mb, mb->vertex_coords);
+
   cs_all_to_all_t *dv
     = cs_all_to_all_create_from_block(mesh->n_vertices,
                                       CS_ALL_TO_ALL_USE_DEST_ID,
@@ -1421,6 +1429,8 @@ _decompose_data_l(cs_mesh_t          *mesh,
 
   assert((sizeof(cs_lnum_t) == 4) || (sizeof(cs_lnum_t) == 8));
 
+  cs_mesh_builder_wait_input(mb, NULL);
+
   mesh->n_cells = mb->cell_bi.gnum_range[1] - 1;
   mesh->n_cells_with_ghosts = mesh->n_cells; /* may be increased later */
 
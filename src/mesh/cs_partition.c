@@ -936,6 +936,131 @@ _precompute_cell_center_l(const cs_mesh_builder_t  *mb,
   BFT_FREE(weight);
 }
 
+/*----------------------------------------------------------------------------
+ * Define cell ranks from a global ordering, balancing cell weights.
+ *
+ * Cells are assigned to ranks in the given order, so that the sum of
+ * cell weights is similar for each rank.
+ *
+ * parameters:
+ *   n_g_cells   <-- global number of cells
+ *   n_ranks     <-- number of ranks in partition
+ *   n_cells     <-- local number of cells
+ *   cell_num    <-- global cell number in ordering (1 to n)
+ *   cell_weight <-- cell weight
+ *   cell_rank   --> cell rank (0 to n-1 numbering)
+ *----------------------------------------------------------------------------*/
+
+static void
+_cell_rank_by_weight(cs_gnum_t        n_g_cells,
+                     int              n_ranks,
+                     cs_lnum_t        n_cells,
+                     const cs_gnum_t  cell_num[],
+                     const cs_real_t  cell_weight[],
+                     int              cell_rank[])
+{
+  cs_lnum_t n_o_cells = n_cells;
+  cs_real_t *o_weight = NULL;
+  int *o_rank = NULL;
+
+  /* Distribute weights by blocks of ordered cells */
+
+#if defined(HAVE_MPI)
+
+  cs_all_to_all_t *d = NULL;
+
+  if (cs_glob_n_ranks > 1) {
+
+    cs_block_dist_info_t bi
+      = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                    cs_glob_n_ranks,
+                                    1,
+                                    0,
+                                    n_g_cells);
+
+    d = cs_all_to_all_create_from_block(n_cells,
+                                        CS_ALL_TO_ALL_USE_DEST_ID,
+                                        cell_num,
+                                        bi,
+                                        cs_glob_mpi_comm);
+
+    o_weight = cs_all_to_all_copy_array(d,
+                                        CS_REAL_TYPE,
+                                        1,
+                                        false, /* reverse */
+                                        cell_weight,
+                                        NULL);
+
+    n_o_cells = cs_all_to_all_n_elts_dest(d);
+
+  }
+
+#endif
+
+  if (o_weight == NULL) {
+    BFT_MALLOC(o_weight, n_cells, cs_real_t);
+    for (cs_lnum_t i = 0; i < n_cells; i++)
+      o_weight[cell_num[i] - 1] = cell_weight[i];
+  }
+
+  /* Cumulative weights */
+
+  double w_sum[2] = {0, 0}; /* local weight shift, total weight */
+
+  for (cs_lnum_t i = 0; i < n_o_cells; i++)
+    w_sum[1] += o_weight[i];
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    double l_sum = w_sum[1];
+    MPI_Exscan(&l_sum, w_sum, 1, MPI_DOUBLE, MPI_SUM, cs_glob_mpi_comm);
+    if (cs_glob_rank_id == 0)
+      w_sum[0] = 0;
+    MPI_Allreduce(&l_sum, w_sum + 1, 1, MPI_DOUBLE, MPI_SUM,
+                  cs_glob_mpi_comm);
+  }
+#endif
+
+  BFT_MALLOC(o_rank, n_o_cells, int);
+
+  double w_shift = w_sum[0];
+  double w_mult = (w_sum[1] > 0) ? n_ranks / w_sum[1] : 0;
+
+  for (cs_lnum_t i = 0; i < n_o_cells; i++) {
+    int r_id = (w_shift + 0.5*o_weight[i]) * w_mult;
+    o_rank[i] = CS_MAX(CS_MIN(r_id, n_ranks - 1), 0);
+    w_shift += o_weight[i];
+  }
+
+  BFT_FREE(o_weight);
+
+  /* Return rank to initial distribution */
+
+#if defined(HAVE_MPI)
+
+  if (d != NULL) {
+
+    cs_all_to_all_copy_array(d,
+                             CS_INT_TYPE,
+                             1,
+                             true, /* reverse */
+                             o_rank,
+                             cell_rank);
+
+    cs_all_to_all_destroy(&d);
+
+  }
+
+#endif
+
+  if (cs_glob_n_ranks < 2) {
+    for (cs_lnum_t i = 0; i < n_cells; i++)
+      cell_rank[i] = o_rank[cell_num[i] - 1];
+  }
+
+  BFT_FREE(o_rank);
+}
+
 /*----------------------------------------------------------------------------
  * Define cell ranks using a space-filling curve.
  *
@@ -944,6 +1069,7 @@ _precompute_cell_center_l(const cs_mesh_builder_t  *mb,
  *   n_ranks     <-- number of ranks in partition
  *   mb          <-- pointer to mesh builder helper structure
  *   sfc_type    <-- type of space-filling curve
+ *   cell_weight <-- optional cell weights (block distribution), or NULL
  *   cell_rank   --> cell rank (1 to n numbering)
  *   comm        <-- associated MPI communicator
  *----------------------------------------------------------------------------*/
@@ -955,6 +1081,7 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
                   int                       n_ranks,
                   const cs_mesh_builder_t  *mb,
                   fvm_io_num_sfc_t          sfc_type,
+                  const cs_real_t           cell_weight[],
                   int                       cell_rank[],
                   MPI_Comm                  comm)
 
@@ -965,6 +1092,7 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
                   int                       n_ranks,
                   const cs_mesh_builder_t  *mb,
                   fvm_io_num_sfc_t          sfc_type,
+                  const cs_real_t           cell_weight[],
                   int                       cell_rank[])
 
 #endif
@@ -989,6 +1117,8 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
 
   BFT_MALLOC(cell_center, n_cells*3, cs_coord_t);
 
+  cs_mesh_builder_wait_input(mb, NULL);
+
 #if defined(HAVE_MPI)
   if (n_ranks > 1)
     _precompute_cell_center_g(mb, cell_center, comm);
@@ -1019,7 +1149,15 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
 
   /* Determine rank based on global numbering with SFC ordering; */
 
-  if (_part_uniform_sfc_block_size == false) {
+  if (cell_weight != NULL)
+    _cell_rank_by_weight(n_g_cells,
+                         n_ranks,
+                         n_cells,
+                         cell_num,
+                         cell_weight,
+                         cell_rank);
+
+  else if (_part_uniform_sfc_block_size == false) {
 
     cs_gnum_t cells_per_rank = n_g_cells / n_ranks;
     cs_lnum_t rmdr = n_g_cells - cells_per_rank * (cs_gnum_t)n_ranks;
@@ -2671,6 +2809,132 @@ _read_cell_rank(cs_mesh_t          *mesh,
     cs_io_finalize(&rank_pp_in);
 }
 
+/*----------------------------------------------------------------------------
+ * Read cell weights if available
+ *
+ * parameters:
+ *   mesh <-- pointer to mesh structure
+ *   mb   <-- pointer to mesh builder helper structure
+ *   echo <-- echo (verbosity) level
+ *
+ * returns:
+ *   cell weights in block distribution, or NULL if not available
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t *
+_read_cell_weights(cs_mesh_t                *mesh,
+                   const cs_mesh_builder_t  *mb,
+                   long                      echo)
+{
+  char file_name[64];
+  cs_file_access_t  method;
+  cs_io_sec_header_t  header;
+
+  cs_io_t  *w_pp_in = NULL;
+  cs_gnum_t   n_g_cells = 0;
+  cs_real_t  *cell_weight = NULL;
+
+  const char magic_string[] = "Cell weights, R0";
+  const char  *unexpected_msg = N_("Section of type <%s> on <%s>\n"
+                                   "unexpected or of incorrect size");
+
+  snprintf(file_name, 64, "partition_input%ccell_weights", _dir_separator);
+  file_name[63] = '\0';
+
+  if (! cs_file_isreg(file_name))
+    return NULL;
+
+  /* Open file */
+
+#if defined(HAVE_MPI)
+  {
+    MPI_Info           hints;
+    MPI_Comm           block_comm, comm;
+    cs_file_get_default_access(CS_FILE_MODE_READ, &method, &hints);
+    cs_file_get_default_comm(NULL, &block_comm, &comm);
+    assert(comm == cs_glob_mpi_comm || comm == MPI_COMM_NULL);
+    w_pp_in = cs_io_initialize(file_name,
+                               magic_string,
+                               CS_IO_MODE_READ,
+                               method,
+                               echo,
+                               hints,
+                               block_comm,
+                               comm);
+  }
+#else
+  {
+    cs_file_get_default_access(CS_FILE_MODE_READ, &method);
+    w_pp_in = cs_io_initialize(file_name,
+                               magic_string,
+                               CS_IO_MODE_READ,
+                               method,
+                               echo);
+  }
+#endif
+
+  if (echo > 0)
+    bft_printf("\n");
+
+  /* Loop on read sections */
+
+  while (w_pp_in != NULL) {
+
+    cs_io_read_header(w_pp_in, &header);
+
+    if (strncmp(header.sec_name, "n_cells",
+                CS_IO_NAME_LEN) == 0) {
+
+      if (header.n_vals != 1)
+        bft_error(__FILE__, __LINE__, 0,
+                  _(unexpected_msg), header.sec_name,
+                  cs_io_get_name(w_pp_in));
+      else {
+        cs_io_set_cs_gnum(&header, w_pp_in);
+        cs_io_read_global(&header, &n_g_cells, w_pp_in);
+        if (n_g_cells != mesh->n_g_cells) {
+          bft_printf(_(" Cell weights from \"%s\" ignored:\n"
+                       " %llu cells, while the mesh has %llu cells.\n"),
+                     cs_io_get_name(w_pp_in),
+                     (unsigned long long)(n_g_cells),
+                     (unsigned long long)(mesh->n_g_cells));
+          cs_io_finalize(&w_pp_in);
+        }
+      }
+
+    }
+    else if (strncmp(header.sec_name, "cell:weight",
+                     CS_IO_NAME_LEN) == 0) {
+
+      if (header.n_vals != (cs_file_off_t)(mesh->n_g_cells))
+        bft_error(__FILE__, __LINE__, 0,
+                  _(unexpected_msg), header.sec_name,
+                  cs_io_get_name(w_pp_in));
+      else {
+        cs_lnum_t n_cells =   mb->cell_bi.gnum_range[1]
+                            - mb->cell_bi.gnum_range[0];
+        cs_io_assert_cs_real(&header, w_pp_in);
+        /* Ensure non-NULL array even for empty blocks, so that all
+           ranks handle weights in the same manner */
+        BFT_MALLOC(cell_weight, CS_MAX(n_cells, 1), cs_real_t);
+        cs_io_read_block(&header,
+                         mb->cell_bi.gnum_range[0],
+                         mb->cell_bi.gnum_range[1],
+                         cell_weight, w_pp_in);
+      }
+      cs_io_finalize(&w_pp_in);
+
+    }
+
+    else
+      bft_error(__FILE__, __LINE__, 0,
+                _("Section of type <%s> on <%s> is unexpected."),
+                header.sec_name, cs_io_get_name(w_pp_in));
+  }
+
+  return cell_weight;
+}
+
 /*----------------------------------------------------------------------------*
  * Define a naive partitioning by blocks.
  *
@@ -3188,6 +3452,21 @@ cs_partition(cs_mesh_t             *mesh,
 
   t0 = cs_timer_time();
 
+  /* Read optional cell weights (used by space-filling curves only) */
+
+  cs_real_t *cell_weight = NULL;
+
+  if (stage == CS_PARTITION_MAIN) {
+    cell_weight = _read_cell_weights(mesh, mb, CS_IO_ECHO_OPEN_CLOSE);
+    if (   cell_weight != NULL
+        && (   _algorithm < CS_PARTITION_SFC_MORTON_BOX
+            || _algorithm > CS_PARTITION_SFC_HILBERT_CUBE)) {
+      bft_printf(_("\n Cell weights are only used by space-filling curve"
+                   " partitioning;\n they are ignored here.\n"));
+      BFT_FREE(cell_weight);
+    }
+  }
+
   /* Adapt builder data for partitioning */
 
   if (_algorithm == CS_PARTITION_METIS || _algorithm == CS_PARTITION_SCOTCH) {
@@ -3494,10 +3773,12 @@ cs_partition(cs_mesh_t             *mesh,
                         n_ranks,
                         mb,
                         sfc_type,
+                        cell_weight,
                         cell_part,
                         cs_glob_mpi_comm);
 #else
-      _cell_rank_by_sfc(mesh->n_g_cells, n_ranks, mb, sfc_type, cell_part);
+      _cell_rank_by_sfc(mesh->n_g_cells, n_ranks, mb, sfc_type, cell_weight,
+                        cell_part);
 #endif
 
       _cell_part_histogram(mb->cell_bi.gnum_range, n_ranks, cell_part);
@@ -3509,6 +3790,8 @@ cs_partition(cs_mesh_t             *mesh,
                       cell_part);
     }
 
+    BFT_FREE(cell_weight);
+
   }
 
   /* Naive partitioner */
@@ -3553,6 +3836,146 @@ cs_partition(cs_mesh_t             *mesh,
   cs_log_separator(CS_LOG_PERFORMANCE);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Write cell weights for subsequent partitionings.
+ *
+ * Weights are written to the "partition_output/cell_weights" file,
+ * using the global cell numbering. When copied or linked as
+ * "partition_input/cell_weights" for a subsequent computation, they
+ * are used by space-filling curve partitionings of the main stage,
+ * so that the sum of cell weights is balanced over ranks (rather
+ * than the number of cells).
+ *
+ * This function is collective over all ranks.
+ *
+ * \param[in]  mesh         pointer to mesh structure
+ * \param[in]  cell_weight  weight associated with each local cell
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_partition_write_cell_weights(const cs_mesh_t  *mesh,
+                                const cs_real_t   cell_weight[])
+{
+  cs_file_access_t method;
+  cs_io_t *fh = NULL;
+  cs_datatype_t datatype_gnum
+    = (sizeof(cs_gnum_t) == 8) ? CS_UINT64 : CS_UINT32;
+
+  const char dir[] = "partition_output";
+  const char magic_string[] = "Cell weights, R0";
+  const cs_lnum_t n_cells = mesh->n_cells;
+
+  cs_block_dist_info_t bi
+    = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                  cs_glob_n_ranks,
+                                  1,
+                                  0,
+                                  mesh->n_g_cells);
+
+  cs_lnum_t n_b_cells = bi.gnum_range[1] - bi.gnum_range[0];
+
+  /* Distribute weights by blocks of global cell numbers */
+
+  cs_real_t *b_weight;
+  BFT_MALLOC(b_weight, n_b_cells, cs_real_t);
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    cs_part_to_block_t *d
+      = cs_part_to_block_create_by_gnum(cs_glob_mpi_comm,
+                                        bi,
+                                        n_cells,
+                                        mesh->global_cell_num);
+    cs_part_to_block_copy_array(d, CS_REAL_TYPE, 1, cell_weight, b_weight);
+    cs_part_to_block_destroy(&d);
+  }
+#endif
+
+  if (cs_glob_n_ranks < 2) {
+    if (mesh->global_cell_num != NULL) {
+      for (cs_lnum_t i = 0; i < n_cells; i++)
+        b_weight[mesh->global_cell_num[i] - 1] = cell_weight[i];
+    }
+    else
+      memcpy(b_weight, cell_weight, n_cells*sizeof(cs_real_t));
+  }
+
+  /* Create directory if required */
+
+  if (cs_glob_rank_id < 1) {
+    if (cs_file_isdir(dir) != 1) {
+      if (cs_file_mkdir_default(dir) != 0)
+        bft_error(__FILE__, __LINE__, errno,
+                  _("The partitioning directory cannot be created"));
+    }
+  }
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Barrier(cs_glob_mpi_comm);
+#endif
+
+  /* Open file */
+
+  char filename[64];
+  snprintf(filename, 64, "%s%ccell_weights", dir, _dir_separator);
+  filename[63] = '\0';
+
+#if defined(HAVE_MPI)
+  {
+    MPI_Info  hints;
+    MPI_Comm  block_comm, comm;
+    cs_file_get_default_access(CS_FILE_MODE_WRITE, &method, &hints);
+    cs_file_get_default_comm(NULL, &block_comm, &comm);
+    assert(comm == cs_glob_mpi_comm || comm == MPI_COMM_NULL);
+    fh = cs_io_initialize(filename,
+                          magic_string,
+                          CS_IO_MODE_WRITE,
+                          method,
+                          CS_IO_ECHO_OPEN_CLOSE,
+                          hints,
+                          block_comm,
+                          comm);
+  }
+#else
+  {
+    cs_file_get_default_access(CS_FILE_MODE_WRITE, &method);
+    fh = cs_io_initialize(filename,
+                          magic_string,
+                          CS_IO_MODE_WRITE,
+                          method,
+                          CS_IO_ECHO_OPEN_CLOSE);
+  }
+#endif
+
+  cs_gnum_t n_g_cells = mesh->n_g_cells;
+
+  cs_io_write_global("n_cells",
+                     1,
+                     1,
+                     0,
+                     1,
+                     datatype_gnum,
+                     &n_g_cells,
+                     fh);
+
+  cs_io_write_block_buffer("cell:weight",
+                           mesh->n_g_cells,
+                           bi.gnum_range[0],
+                           bi.gnum_range[1],
+                           1,
+                           0,
+                           1,
+                           CS_REAL_TYPE,
+                           b_weight,
+                           fh);
+
+  cs_io_finalize(&fh);
+
+  BFT_FREE(b_weight);
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -242,6 +242,27 @@ cs_partition(cs_mesh_t             *mesh,
              cs_mesh_builder_t     *mesh_builder,
              cs_partition_stage_t   stage);
 
+/*----------------------------------------------------------------------------
+ * Write cell weights for subsequent partitionings.
+ *
+ * Weights are written to the "partition_output/cell_weights" file,
+ * using the global cell numbering. When copied or linked as
+ * "partition_input/cell_weights" for a subsequent computation, they
+ * are used by space-filling curve partitionings of the main stage,
+ * so that the sum of cell weights is balanced over ranks (rather
+ * than the number of cells).
+ *
+ * This function is collective over all ranks.
+ *
+ * parameters:
+ *   mesh        <-- pointer to mesh structure
+ *   cell_weight <-- weight associated with each local cell
+ *----------------------------------------------------------------------------*/
+
+void
+cs_partition_write_cell_weights(const cs_mesh_t  *mesh,
+                                const cs_real_t   cell_weight[]);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -0,0 +1,144 @@
+/*============================================================================
+ * Share the matrix of a CDO equation with another equation
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_headers.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \file cs_user_extra_operations-cdo_shared_matrix.c
+ *
+ * \brief Share the matrix of a CDO equation with another equation and check
+ *        that two identical tracers lead to identical solutions
+ */
+/*----------------------------------------------------------------------------*/
+
+/*============================================================================
+ * User function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Initialize variables.
+ *         The equations are initialized at this stage so that the matrix of
+ *         an equation can be shared with another one.
+ *
+ * \param[in, out]  domain   pointer to a cs_domain_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_user_extra_operations_initialize(cs_domain_t     *domain)
+{
+  CS_UNUSED(domain);
+
+  /*! [extra_cdo_shared_matrix_init] */
+  {
+    /* The scalar-valued CDO-Vb equations "Tracer1" and "Tracer2" have been
+       added in cs_user_model(). They share the same numerical settings (linear
+       solver included), the same properties and the same boundary
+       conditions. Only their source terms or their initial conditions may
+       differ. */
+
+    cs_equation_t  *eq1 = cs_equation_by_name("Tracer1");
+    cs_equation_t  *eq2 = cs_equation_by_name("Tracer2");
+
+    /* Tracer2 uses the matrix of Tracer1 and the setup of its linear solver.
+       Tracer1 has to be solved first. User-defined equations are solved in
+       the order of their creation. */
+
+    cs_equation_share_matrix(eq2, eq1);
+  }
+  /*! [extra_cdo_shared_matrix_init] */
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Additional operations on results produced by CDO schemes.
+ *         Check that two tracers with the same settings and the same source
+ *         terms lead to the same solution.
+ *
+ * \param[in, out]  domain   pointer to a cs_domain_t structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_user_extra_operations(cs_domain_t          *domain)
+{
+  /*! [extra_cdo_shared_matrix_check] */
+  {
+    const cs_cdo_quantities_t  *cdoq = domain->cdo_quantities;
+
+    const cs_real_t  *v1 =
+      cs_equation_get_vertex_values(cs_equation_by_name("Tracer1"), false);
+    const cs_real_t  *v2 =
+      cs_equation_get_vertex_values(cs_equation_by_name("Tracer2"), false);
+
+    cs_real_t  max_diff = 0.;
+    for (cs_lnum_t i = 0; i < cdoq->n_vertices; i++)
+      max_diff = fmax(max_diff, fabs(v1[i] - v2[i]));
+
+    cs_parall_max(1, CS_REAL_TYPE, &max_diff);
+
+    cs_log_printf(CS_LOG_DEFAULT,
+                  " Shared matrix: max. difference between the tracers:"
+                  " %5.3e\n", max_diff);
+
+    if (max_diff > 1e-12)
+      bft_error(__FILE__, __LINE__, 0,
+                " %s: The tracers should have the same solution.", __func__);
+  }
+  /*! [extra_cdo_shared_matrix_check] */
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -389,6 +389,19 @@ cs_user_parameters(cs_domain_t   *domain)
 
   }
   /*! [param_cdo_numerics] */
+
+  /*! [param_cdo_omp_assembly] */
+  {
+    cs_equation_param_t  *eqp = cs_equation_param_by_name("AdvDiff.Upw");
+
+    /* With CDO face-based schemes and OpenMP threads, cells can be colored
+       so that the assembly of the global system needs no critical section.
+       The coloring is shared by all the CDO face-based equations (this
+       setting has no effect with other space schemes). */
+
+    cs_equation_param_set(eqp, CS_EQKEY_OMP_ASSEMBLY_STRATEGY, "coloring");
+  }
+  /*! [param_cdo_omp_assembly] */
 }
 
 /*----------------------------------------------------------------------------*/
@@ -304,6 +304,35 @@ cs_user_parameters(cs_domain_t    *domain)
     nsp->sles_param->schur_approximation = CS_PARAM_SCHUR_MASS_SCALED;
   }
   /*! [cdo_sles_navsto_minres] */
+
+  /*! [cdo_sles_navsto_upper_schur_gcr] */
+  {
+    /* Parameters related to the Navier-Stokes settings. Block upper
+       triangular preconditioner and GCR relying only on in-house solvers.
+       General strategy. */
+
+    cs_navsto_param_t  *nsp = cs_navsto_system_get_param();
+
+    cs_navsto_param_set(nsp, CS_NSKEY_SLES_STRATEGY, "upper_schur_gcr");
+    cs_navsto_param_set(nsp, CS_NSKEY_IL_ALGO_RTOL, "1e-8");
+    cs_navsto_param_set(nsp, CS_NSKEY_IL_ALGO_ATOL, "1e-14");
+
+    /* The Schur complement is approximated by B.spai(A).Bt where spai(A) is
+       a sparse approximate inverse of the velocity block with the sparsity
+       pattern of the velocity block */
+
+    cs_navsto_param_set(nsp, CS_NSKEY_SCHUR_STRATEGY, "spai_schur");
+
+    cs_equation_param_t  *mom_eqp = cs_equation_param_by_name("momentum");
+
+    /* Set the inner solver for the velocity block (in-house multigrid) */
+
+    cs_equation_param_set(mom_eqp, CS_EQKEY_ITSOL, "fcg");
+    cs_equation_param_set(mom_eqp, CS_EQKEY_PRECOND, "amg");
+    cs_equation_param_set(mom_eqp, CS_EQKEY_AMG_TYPE, "k_cycle");
+    cs_equation_param_set(mom_eqp, CS_EQKEY_ITSOL_RTOL, "1e-2");
+  }
+  /*! [cdo_sles_navsto_upper_schur_gcr] */
 }
 
 /*----------------------------------------------------------------------------*/
@@ -45,6 +45,7 @@
 #include "cs_hho_builder.h"
 #include "cs_hho_scaleq.h"
 #include "cs_hodge.h"
+#include "cs_hodge_cache.h"
 #include "cs_log.h"
 #include "cs_param_cdo.h"
 #include "cs_scheme_geometry.h"
@@ -1173,6 +1174,32 @@ _test_cdovb_schemes(FILE                *out,
     _locmat_dump(out,"\nCDO.VB; STIFFNESS WITH HDG.EPFD.DGA; PERMEABILITY.ISO",
                  csys->dof_ids, cb->loc);
     _test_stiffness_vb(out, cm, cb->loc);
+
+    /* Same stiffness matrix stored in and then retrieved from a cache */
+
+    cs_lnum_t  c2v_idx[2] = {0, cm->n_vc};
+    cs_adjacency_t  *c2v = cs_adjacency_create_from_i_arrays(1, c2v_idx,
+                                                             cm->v_ids, NULL);
+    cs_hodge_cache_t  *cache = cs_hodge_cache_create(c2v, 0, true);
+
+    double  *ref = NULL;
+    BFT_MALLOC(ref, cm->n_vc*cm->n_vc, double);
+    memcpy(ref, cb->loc->val, cm->n_vc*cm->n_vc*sizeof(double));
+
+    double  delta = 0;
+    for (int k = 0; k < 2; k++) {
+      cs_sdm_square_init(cm->n_vc, cb->loc);
+      cs_hodge_cache_compute(cache, cs_hodge_vb_cost_get_stiffness,
+                             cm, hodge, cb, cb->loc);
+      for (int i = 0; i < cm->n_vc*cm->n_vc; i++)
+        delta = fmax(delta, fabs(cb->loc->val[i] - ref[i]));
+    }
+    fprintf(out, "\nCDO.VB; STIFFNESS CACHE; MAX.DIFF % -9.6e; SIZE %zu\n",
+            delta, cs_hodge_cache_memory_size(cache));
+
+    BFT_FREE(ref);
+    cs_hodge_cache_free(&cache);
+    cs_adjacency_destroy(&c2v);
     cs_hodge_free(&hodge);
 
     /* Anisotropic case */
@@ -186,6 +186,33 @@ _test_sdm(FILE  *out)
     fprintf(out, " Solution l.u:        % .4e % .4e % .4e % .4e % .4e % .4e\n",
             sol[0], sol[1], sol[2], sol[3], sol[4], sol[5]);
 
+    /* 6 x 6 dense matrix */
+
+    for (int i = 0; i < 6; i++)
+      for (int j = 0; j < 6; j++)
+        a[6*i+j] = (i == j) ? 6 : 1./(1 + abs(i-j));
+
+    cs_sdm_66_ldlt_compute(m, facto);
+    cs_sdm_66_ldlt_solve(facto, b, sol);
+
+    fprintf(out, "\n6x6 dense matrix\n");
+    cs_sdm_fprintf(out, NULL, cs_math_zero_threshold, m);
+
+    fprintf(out, " Solution l.d.l^T 66: % .4e % .4e % .4e % .4e % .4e % .4e\n",
+            sol[0], sol[1], sol[2], sol[3], sol[4], sol[5]);
+
+    cs_sdm_ldlt_compute(m, facto, tmp);
+    cs_sdm_ldlt_solve(6, facto, b, sol);
+
+    fprintf(out, " Solution l.d.l^T   : % .4e % .4e % .4e % .4e % .4e % .4e\n",
+            sol[0], sol[1], sol[2], sol[3], sol[4], sol[5]);
+
+    cs_sdm_square_matvec(m, sol, tmp);
+
+    fprintf(out, " Residual:            % .4e % .4e % .4e % .4e % .4e % .4e\n",
+            tmp[0] - b[0], tmp[1] - b[1], tmp[2] - b[2],
+            tmp[3] - b[3], tmp[4] - b[4], tmp[5] - b[5]);
+
     m = cs_sdm_free(m);
   }
 
@@ -284,6 +284,98 @@ _poisson_test(cs_lnum_t   n,
   }
 }
 
+static void
+_counter_test(cs_lnum_t   n,
+              cs_real_t  *x)
+{
+  int i, k;
+  double t1, t2, t3;
+  double x1, x2, x3, x4;
+  double y[128];
+  int bin[21];
+
+  int nits = 128;
+
+  /* Known answer test for Philox4x32-10 (key 0, counter 0):
+     output words 0x6627e8d5 0xe169c58d 0xbc57ac4c 0x9b00dbd8 */
+
+  double ref[2] = {((double)(0x6627e8d5U >> 5) * 67108864.0
+                    + (double)(0xe169c58dU >> 6)) / 9007199254740992.0,
+                   ((double)(0xbc57ac4cU >> 5) * 67108864.0
+                    + (double)(0x9b00dbd8U >> 6)) / 9007199254740992.0};
+
+  cs_random_counter_uniform(0, 0, 2, y);
+
+  if (fabs(y[0] - ref[0]) > 0 || fabs(y[1] - ref[1]) > 0)
+    printf("ERROR in counter-based generator known answer test\n");
+  else
+    printf("    counter-based known answer test OK\n");
+
+  /* Reproducibility: values depend only on key, counter, and position */
+
+  cs_random_counter_normal(12345, 17, n, x);
+  cs_random_counter_normal(12345, 17, 128, y);
+
+  double diff = 0.;
+  for (i = 0; i < (CS_MIN(n, 128)); ++i)
+    diff += (y[i] - x[i])*(y[i] - x[i]);
+
+  if (fabs(diff) > 0)
+    printf("ERROR in counter-based reproducibility: diff = %e\n", diff);
+  else
+    printf("    counter-based reproducibility test OK\n");
+
+  /* Moments and histogram */
+
+  x1 = 0.;
+  x2 = 0.;
+  x3 = 0.;
+  x4 = 0.;
+
+  for (i = 0; i < 21; ++i)
+    bin[i] = 0;
+
+  t1 = 100.;
+  for (k = 0; k < nits; ++k) {
+
+    t2 = cs_timer_wtime();
+    cs_random_counter_normal(k, 0, n, x);
+    t3 = cs_timer_wtime();
+    t1 = CS_MIN(t1, t3-t2);
+
+    for (i = 0; i < n; ++i) {
+      int kk = (int) ((x[i] + 5.25) * 2.);
+      if (kk >= 0 && kk < 21)
+        ++bin[kk];
+      double xx2 = x[i] * x[i];
+      x1 += x[i];
+      x2 += xx2;
+      x3 += xx2 * x[i];
+      x4 += xx2 * xx2;
+    }
+
+  }
+
+  x1 /= (double) (n * nits);
+  x2 /= (double) (n * nits);
+  x3 /= (double) (n * nits);
+  x4 /= (double) (n * nits);
+
+  t1 = t1 / ((float) n);
+  printf("\n    Time/counter-based normal = %e seconds \n",t1);
+  printf("    Moments: \n");
+  printf("      Compare to (0.0)               (1.0) \n");
+  printf("              %e       %e \n",x1,x2);
+  printf("      Compare to (0.0)               (3.0) \n");
+  printf("              %e       %e \n",x3,x4);
+  printf("\n    Histogram of counter-based gaussian distribution:\n");
+  printf("    --------- -- ------------- -------- ------------ \n");
+  for (k = 0; k < 21; ++k) {
+    if (k<9) printf("    bin[%d]  = %d \n",k+1,bin[k]);
+    else     printf("    bin[%d] = %d \n",k+1,bin[k]);
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 
 int
@@ -336,5 +428,14 @@ main (int argc, char *argv[])
   printf("Fischer distribution for %d values in %f seconds\n",
          NPTS, wt1 - wt0);
 
+  wt0 = cs_timer_wtime();
+
+  _counter_test(NPTS, a);
+
+  wt1 = cs_timer_wtime();
+
+  printf("Counter-based normal distribution for %d values in %f seconds\n",
+         NPTS, wt1 - wt0);
+
   exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,263 @@
+/*============================================================================
+ * Unit test for binary output of cs_time_plot.c;
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_time_plot.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define N_PROBES 3
+#define N_STEPS 10
+#define N_BUFFER_STEPS 3
+
+/*----------------------------------------------------------------------------
+ * Value written for a given probe and time step.
+ *----------------------------------------------------------------------------*/
+
+static double
+_val(int  probe_id,
+     int  step)
+{
+  return 100.*probe_id + 0.5*step;
+}
+
+/*----------------------------------------------------------------------------
+ * Read a string written as its 32-bit length followed by its characters.
+ *
+ * parameters:
+ *   f      <-- pointer to file
+ *   s      --> string (null-terminated)
+ *   s_size <-- size of s
+ *
+ * returns:
+ *   0 on success, 1 on error
+ *----------------------------------------------------------------------------*/
+
+static int
+_read_string(FILE    *f,
+             char    *s,
+             size_t   s_size)
+{
+  int32_t l = 0;
+  if (fread(&l, sizeof(int32_t), 1, f) != 1 || l < 0 || (size_t)l >= s_size)
+    return 1;
+  if (fread(s, 1, l, f) != (size_t)l)
+    return 1;
+  s[l] = '\0';
+  return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Read back a binary probe plot file and check its contents.
+ *
+ * parameters:
+ *   file_name   <-- name of file to read
+ *   plot_name   <-- expected plot name
+ *   coords      <-- expected probe coordinates
+ *   probe_names <-- expected probe names
+ *
+ * returns:
+ *   number of errors
+ *----------------------------------------------------------------------------*/
+
+static int
+_check_file(const char    *file_name,
+            const char    *plot_name,
+            const double   coords[],
+            const char    *probe_names[])
+{
+  int n_errors = 0;
+
+  FILE *f = fopen(file_name, "rb");
+  if (f == NULL) {
+    bft_printf("cannot open \"%s\"\n", file_name);
+    return 1;
+  }
+
+  /* Common header */
+
+  char magic[32], name[64];
+  int32_t h[4];
+
+  if (fread(magic, 1, 32, f) != 32 || fread(h, sizeof(int32_t), 4, f) != 4) {
+    fclose(f);
+    bft_printf("truncated header\n");
+    return 1;
+  }
+
+  if (strncmp(magic, "code_saturne time plot binary", 32) != 0) {
+    bft_printf("bad magic string: \"%.32s\"\n", magic);
+    n_errors++;
+  }
+  if (h[0] != 1 || h[1] != 0 || h[2] != 1 || h[3] != N_PROBES) {
+    bft_printf("bad header values: %d %d %d %d\n", h[0], h[1], h[2], h[3]);
+    n_errors++;
+  }
+  if (_read_string(f, name, 64) || strcmp(name, plot_name) != 0) {
+    bft_printf("bad plot name\n");
+    n_errors++;
+  }
+
+  /* Probe-specific header */
+
+  int32_t has_coords = 0;
+  if (fread(&has_coords, sizeof(int32_t), 1, f) != 1 || has_coords != 1) {
+    bft_printf("bad coordinates flag\n");
+    n_errors++;
+  }
+  for (int i = 0; i < N_PROBES; i++) {
+    double c[3];
+    if (fread(c, sizeof(double), 3, f) != 3) {
+      n_errors++;
+      break;
+    }
+    for (int j = 0; j < 3; j++) {
+      if (c[j] != coords[i*3 + j]) {
+        bft_printf("bad coordinate %d for probe %d\n", j, i);
+        n_errors++;
+      }
+    }
+  }
+  for (int i = 0; i < N_PROBES; i++) {
+    if (_read_string(f, name, 64) || strcmp(name, probe_names[i]) != 0) {
+      bft_printf("bad name for probe %d\n", i);
+      n_errors++;
+    }
+  }
+
+  /* Data blocks: with N_BUFFER_STEPS, each full block holds
+     N_BUFFER_STEPS + 1 rows, and the last one the remaining rows */
+
+  int n_blocks = 0, step = 0;
+  int32_t n_rows = 0;
+
+  while (fread(&n_rows, sizeof(int32_t), 1, f) == 1) {
+
+    int expected = N_BUFFER_STEPS + 1;
+    if (N_STEPS - step < expected)
+      expected = N_STEPS - step;
+    if (n_rows != expected) {
+      bft_printf("block %d: %d rows instead of %d\n",
+                 n_blocks, n_rows, expected);
+      n_errors++;
+      break;
+    }
+
+    double *cols;
+    BFT_MALLOC(cols, n_rows*(N_PROBES+1), double);
+    if (fread(cols, sizeof(double), n_rows*(N_PROBES+1), f)
+        != (size_t)(n_rows*(N_PROBES+1))) {
+      bft_printf("block %d: truncated\n", n_blocks);
+      n_errors++;
+      BFT_FREE(cols);
+      break;
+    }
+
+    for (int i = 0; i < n_rows; i++) {
+      if (cols[i] != step + i + 1)
+        n_errors++;
+      for (int j = 0; j < N_PROBES; j++) {
+        if (cols[(j+1)*n_rows + i] != _val(j, step + i + 1))
+          n_errors++;
+      }
+    }
+
+    BFT_FREE(cols);
+
+    step += n_rows;
+    n_blocks++;
+  }
+
+  if (step != N_STEPS) {
+    bft_printf("%d rows read instead of %d\n", step, N_STEPS);
+    n_errors++;
+  }
+
+  bft_printf("%d blocks, %d rows read\n", n_blocks, step);
+
+  fclose(f);
+
+  return n_errors;
+}
+
+/*============================================================================
+ * Main program
+ *============================================================================*/
+
+int
+main (int argc, char *argv[])
+{
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+  bft_mem_init(getenv("CS_MEM_LOG"));
+
+  const char *plot_name = "bin_test";
+  const char *probe_names[N_PROBES] = {"p1", "p2", "probe_3"};
+  const double coords[N_PROBES*3] = {0., 0., 0.,
+                                     1., 0.5, 0.25,
+                                     -1., 2., 1e-3};
+
+  cs_time_plot_t *p = cs_time_plot_init_probe(plot_name,
+                                              "",
+                                              CS_TIME_PLOT_BIN,
+                                              true,  /* use_iteration */
+                                              -1.,   /* flush_wtime */
+                                              N_BUFFER_STEPS,
+                                              N_PROBES,
+                                              NULL,
+                                              coords,
+                                              probe_names);
+
+  for (int step = 1; step <= N_STEPS; step++) {
+    cs_real_t vals[N_PROBES];
+    for (int j = 0; j < N_PROBES; j++)
+      vals[j] = _val(j, step);
+    cs_time_plot_vals_write(p, step, 0.1*step, N_PROBES, vals);
+  }
+
+  cs_time_plot_finalize(&p);
+
+  int n_errors = _check_file("bin_test.bin", plot_name, coords, probe_names);
+
+  remove("bin_test.bin");
+
+  bft_mem_end();
+
+  if (n_errors > 0) {
+    bft_printf("%d errors\n", n_errors);
+    exit(EXIT_FAILURE);
+  }
+
+  exit(EXIT_SUCCESS);
+}
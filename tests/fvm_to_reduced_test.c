@@ -0,0 +1,167 @@
+/*============================================================================
+ * Unit test for fvm_to_reduced.c;
+ *============================================================================*/
+
+/*
+  This file is part of code_saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2023 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "fvm_to_reduced.h"
+
+/*---------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ * Compress, decompress and check the error bound for a given set of values.
+ *
+ * parameters:
+ *   abs_error <-- absolute error bound, or <= 0
+ *   rel_error <-- relative error bound (used if abs_error <= 0)
+ *   n_vals    <-- number of values
+ *   vals      <-- values
+ *
+ * returns:
+ *   number of values exceeding the error bound
+ *----------------------------------------------------------------------------*/
+
+static size_t
+_check_round_trip(double         abs_error,
+                  double         rel_error,
+                  size_t         n_vals,
+                  const double   vals[])
+{
+  double v_min = vals[0], v_max = vals[0];
+  for (size_t i = 1; i < n_vals; i++) {
+    v_min = fmin(v_min, vals[i]);
+    v_max = fmax(v_max, vals[i]);
+  }
+
+  const double dq
+    = fvm_to_reduced_quantization_step(abs_error, rel_error, v_min, v_max);
+  const double bound = (abs_error > 0) ? abs_error : rel_error*(v_max-v_min);
+
+  /* Compress in 2 chunks, the second one with a sub-range of values */
+
+  size_t n_errors = 0;
+  const size_t s[3] = {0, n_vals/3, n_vals};
+
+  for (int c = 0; c < 2; c++) {
+
+    unsigned char *chunk = NULL;
+    size_t n_bytes = fvm_to_reduced_encode_chunk(c, -1, s[c] + 1, dq,
+                                                 s[c+1] - s[c], vals + s[c],
+                                                 &chunk);
+
+    int c_id = -2, section_id = -2;
+    cs_gnum_t start_num = 0;
+    size_t n_dec = 0;
+    double *dec = NULL;
+
+    size_t n_bytes_dec
+      = fvm_to_reduced_decode_chunk(chunk, &c_id, &section_id, &start_num,
+                                    &n_dec, &dec);
+
+    if (   n_bytes_dec != n_bytes || c_id != c || section_id != -1
+        || start_num != s[c] + 1 || n_dec != s[c+1] - s[c])
+      bft_error(__FILE__, __LINE__, 0, "Inconsistent chunk header.");
+
+    /* Allow for rounding of the reconstruction v_min + q.dq */
+
+    for (size_t i = 0; i < n_dec; i++) {
+      double v = vals[s[c] + i];
+      double tol = bound + 4*DBL_EPSILON*(fabs(v) + fabs(v_min));
+      if (fabs(v - dec[i]) > tol)
+        n_errors++;
+    }
+
+    bft_printf("  chunk %d: %d values, %d bytes (%.2f bits/value)\n",
+               c, (int)n_dec, (int)n_bytes, 8.*n_bytes/n_dec);
+
+    BFT_FREE(dec);
+    BFT_FREE(chunk);
+  }
+
+  return n_errors;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char *argv[])
+{
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+  bft_mem_init(getenv("CS_MEM_LOG"));
+
+  const size_t n_vals = 10000;
+  double *vals;
+  BFT_MALLOC(vals, n_vals, double);
+
+  /* Smooth field with noise and a few outliers */
+
+  srand(5);
+  for (size_t i = 0; i < n_vals; i++) {
+    double x = (double)i / n_vals;
+    double r = (double)(rand()) / RAND_MAX;
+    vals[i] = 100.*sin(6.*x) + 1e-3*r;
+    if (i % 1000 == 7)
+      vals[i] = -1e4*r;
+  }
+
+  const double abs_errors[3] = {1e-6, 1e-2, 10.};
+  const double rel_errors[3] = {1e-9, 1e-4, 1e-1};
+
+  size_t n_errors = 0;
+
+  for (int i = 0; i < 3; i++) {
+    bft_printf("abs_error = %g\n", abs_errors[i]);
+    n_errors += _check_round_trip(abs_errors[i], -1, n_vals, vals);
+    bft_printf("rel_error = %g\n", rel_errors[i]);
+    n_errors += _check_round_trip(-1, rel_errors[i], n_vals, vals);
+  }
+
+  /* Constant values */
+
+  for (size_t i = 0; i < n_vals; i++)
+    vals[i] = 3.;
+
+  bft_printf("constant values, rel_error = %g\n", rel_errors[1]);
+  n_errors += _check_round_trip(-1, rel_errors[1], n_vals, vals);
+
+  BFT_FREE(vals);
+
+  bft_mem_end();
+
+  if (n_errors > 0) {
+    bft_printf("%d values exceed the error bound\n", (int)n_errors);
+    exit(EXIT_FAILURE);
+  }
+
+  exit(EXIT_SUCCESS);
+}